@@ -0,0 +1,157 @@
+// Native microbenchmarks for freud's hot C++ kernels.
+//
+// The Python suite in benchmarks/ measures through the Cython API, so
+// per-call binding overhead can mask kernel-level regressions (an AABB
+// traversal slowdown is invisible behind constant Python dispatch cost).
+// These fixtures drive the kernels directly at production-like sizes.
+// Build with -DFREUD_BUILD_CPP_BENCHMARKS=ON (requires Google Benchmark)
+// and run the freud_benchmarks executable from the build tree.
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "AABBQuery.h"
+#include "Box.h"
+#include "Cluster.h"
+#include "Histogram.h"
+#include "NeighborList.h"
+#include "Steinhardt.h"
+#include "VectorMath.h"
+#include "utils.h"
+
+namespace {
+
+//! Uniform random points filling a cubic box of side length box_l.
+std::vector<vec3<float>> makePoints(unsigned int n, float box_l, unsigned int seed = 42)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> pos(-box_l / 2, box_l / 2);
+    std::vector<vec3<float>> points(n);
+    for (auto& p : points)
+    {
+        p = vec3<float>(pos(gen), pos(gen), pos(gen));
+    }
+    return points;
+}
+
+//! Box side length giving a number density of one, independent of N.
+float boxLength(unsigned int n)
+{
+    return std::cbrt(static_cast<float>(n));
+}
+
+freud::locality::QueryArgs ballArgs(float r_max)
+{
+    freud::locality::QueryArgs qargs;
+    qargs.mode = freud::locality::QueryType::ball;
+    qargs.r_max = r_max;
+    qargs.exclude_ii = true;
+    return qargs;
+}
+
+//! Ball-query traversal of the AABB tree, materialized into a NeighborList.
+void BM_AABBQueryBall(benchmark::State& state)
+{
+    const auto n = static_cast<unsigned int>(state.range(0));
+    const float l = boxLength(n);
+    const auto points = makePoints(n, l);
+    const freud::box::Box box(l, l, l, 0, 0, 0, false);
+    const freud::locality::AABBQuery nq(box, points.data(), n);
+    const auto qargs = ballArgs(1.5F);
+    for (auto _ : state)
+    {
+        const freud::locality::NeighborList* nlist = nq.query(points.data(), n, qargs)->toNeighborList();
+        benchmark::DoNotOptimize(nlist->getNumBonds());
+        delete nlist;
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_AABBQueryBall)->Arg(4096)->Arg(32768)->Arg(131072)->Unit(benchmark::kMillisecond);
+
+//! Aggregation of thread-local histogram copies into the master histogram.
+void BM_HistogramReduceOverThreads(benchmark::State& state)
+{
+    const auto bins = static_cast<size_t>(state.range(0));
+    std::vector<std::shared_ptr<freud::util::Axis>> axes {
+        std::make_shared<freud::util::RegularAxis>(bins, 0.0F, 1.0F)};
+    freud::util::Histogram<unsigned int> histogram(axes);
+    freud::util::Histogram<unsigned int>::ThreadLocalHistogram local_histograms(histogram);
+    freud::util::forLoopWrapper(0, 1U << 22U, [&local_histograms](size_t begin, size_t end) {
+        std::mt19937 gen(static_cast<unsigned int>(begin));
+        std::uniform_real_distribution<float> val(0.0F, 1.0F);
+        for (size_t i = begin; i < end; ++i)
+        {
+            local_histograms(val(gen));
+        }
+    });
+    for (auto _ : state)
+    {
+        histogram.reduceOverThreads(local_histograms);
+        benchmark::DoNotOptimize(histogram.getBinCounts());
+    }
+    state.SetItemsProcessed(state.iterations() * bins);
+}
+BENCHMARK(BM_HistogramReduceOverThreads)->Arg(1024)->Arg(65536)->Unit(benchmark::kMicrosecond);
+
+//! Steinhardt q6 over a ball neighborhood (dominated by baseCompute).
+void BM_SteinhardtQ6(benchmark::State& state)
+{
+    const auto n = static_cast<unsigned int>(state.range(0));
+    const float l = boxLength(n);
+    const auto points = makePoints(n, l);
+    const freud::box::Box box(l, l, l, 0, 0, 0, false);
+    const freud::locality::AABBQuery nq(box, points.data(), n);
+    const auto qargs = ballArgs(1.5F);
+    for (auto _ : state)
+    {
+        freud::order::Steinhardt steinhardt(6);
+        steinhardt.compute(nullptr, &nq, qargs);
+        benchmark::DoNotOptimize(steinhardt.getOrder());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SteinhardtQ6)->Arg(4096)->Arg(32768)->Unit(benchmark::kMillisecond);
+
+//! Bond-driven union-find clustering plus the labeling passes.
+void BM_ClusterCompute(benchmark::State& state)
+{
+    const auto n = static_cast<unsigned int>(state.range(0));
+    const float l = boxLength(n);
+    const auto points = makePoints(n, l);
+    const freud::box::Box box(l, l, l, 0, 0, 0, false);
+    const freud::locality::AABBQuery nq(box, points.data(), n);
+    const auto qargs = ballArgs(1.0F);
+    for (auto _ : state)
+    {
+        freud::cluster::Cluster cluster;
+        cluster.compute(&nq, nullptr, qargs);
+        benchmark::DoNotOptimize(cluster.getNumClusters());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ClusterCompute)->Arg(4096)->Arg(32768)->Arg(131072)->Unit(benchmark::kMillisecond);
+
+//! Bulk periodic wrap of out-of-box coordinates (the SoA batch path).
+void BM_BoxWrapBulk(benchmark::State& state)
+{
+    const auto n = static_cast<unsigned int>(state.range(0));
+    const float l = 10.0F;
+    // Spread the points over several images so every wrap does real work.
+    auto points = makePoints(n, 4 * l);
+    std::vector<vec3<float>> out(n);
+    const freud::box::Box box(l, l, l, 0, 0, 0, false);
+    for (auto _ : state)
+    {
+        box.wrap(points.data(), n, out.data());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_BoxWrapBulk)->Arg(65536)->Arg(1048576)->Unit(benchmark::kMicrosecond);
+
+} // namespace
+
+BENCHMARK_MAIN();
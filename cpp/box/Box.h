@@ -6,6 +6,7 @@
 
 #include "utils.h"
 #include <algorithm>
+#include <cmath>
 #include <complex>
 #include <sstream>
 #include <stdexcept>
@@ -224,6 +225,23 @@ public:
         return v;
     }
 
+    //! Double-precision overload of makeAbsolute.
+    /*! The box parameters are stored in single precision, but all arithmetic
+     *  runs in double so double-precision coordinates (e.g. long unwrapped
+     *  trajectories) are not rounded through float.
+     */
+    vec3<double> makeAbsolute(const vec3<double>& f) const
+    {
+        vec3<double> v = vec3<double>(m_lo) + f * vec3<double>(m_L);
+        v.x += double(m_xy) * v.y + double(m_xz) * v.z;
+        v.y += double(m_yz) * v.z;
+        if (m_2d)
+        {
+            v.z = 0.0;
+        }
+        return v;
+    }
+
     //! Convert fractional coordinates into absolute coordinates in place
     /*! \param vecs Vectors of fractional coordinates between 0 and 1 within
      *         parallelepipedal box
@@ -258,6 +276,21 @@ public:
         return delta;
     }
 
+    //! Double-precision overload of makeFractional (see makeAbsolute above).
+    vec3<double> makeFractional(const vec3<double>& v) const
+    {
+        vec3<double> delta = v - vec3<double>(m_lo);
+        delta.x -= (double(m_xz) - double(m_yz) * double(m_xy)) * v.z + double(m_xy) * v.y;
+        delta.y -= double(m_yz) * v.z;
+        delta = delta / vec3<double>(m_L);
+
+        if (m_2d)
+        {
+            delta.z = 0.0;
+        }
+        return delta;
+    }
+
     //! Convert point coordinates from absolute to fractional box coordinates.
     /*! \param vecs Vectors to convert
      *  \param Nvecs Number of vectors
@@ -293,13 +326,60 @@ public:
     /*! \param vecs The vectors to check
      *  \param Nvecs Number of vectors
         \param res Array to save the images
+     *
+     *  As with the bulk wrap(), the box configuration is the same for every
+     *  vector, so the dimensionality branch is hoisted out of the loop and
+     *  the vectors are processed in structure-of-arrays batches whose lane
+     *  loops the compiler vectorizes. Rounding half away from zero is done
+     *  with copysign instead of the sign branch of the scalar getImage();
+     *  both forms agree for every input, including signed zero.
      */
     void getImages(vec3<float>* vecs, unsigned int Nvecs, vec3<int>* res) const
     {
+        const float xz_coeff = m_xz - m_yz * m_xy;
         util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
+            constexpr unsigned int batch_width = 8;
+            vec3_batch<float, batch_width> batch;
+            for (size_t i = begin; i < end; i += batch_width)
             {
-                getImage(vecs[i], res[i]);
+                const auto count
+                    = static_cast<unsigned int>(std::min(static_cast<size_t>(batch_width), end - i));
+                batch.load(vecs + i, count);
+                // makeFractional shifted to center the box, overwriting
+                // components in dependency order (x reads y and z, y reads z)
+                // so the batch is updated in place.
+                for (unsigned int lane = 0; lane < count; lane++)
+                {
+                    batch.x[lane] = ((batch.x[lane] - m_lo.x)
+                                     - (xz_coeff * batch.z[lane] + m_xy * batch.y[lane]))
+                            / m_L.x
+                        - float(0.5);
+                }
+                for (unsigned int lane = 0; lane < count; lane++)
+                {
+                    batch.y[lane] = ((batch.y[lane] - m_lo.y) - m_yz * batch.z[lane]) / m_L.y - float(0.5);
+                }
+                if (m_2d)
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.z[lane] = float(0.0);
+                    }
+                }
+                else
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.z[lane] = (batch.z[lane] - m_lo.z) / m_L.z - float(0.5);
+                    }
+                }
+                for (unsigned int lane = 0; lane < count; lane++)
+                {
+                    res[i + lane]
+                        = vec3<int>((int) (batch.x[lane] + std::copysign(float(0.5), batch.x[lane])),
+                                    (int) (batch.y[lane] + std::copysign(float(0.5), batch.y[lane])),
+                                    (int) (batch.z[lane] + std::copysign(float(0.5), batch.z[lane])));
+                }
             }
         });
     }
@@ -332,21 +412,198 @@ public:
         return makeAbsolute(v_frac);
     }
 
+    //! Double-precision overload of wrap (see makeAbsolute above).
+    vec3<double> wrap(const vec3<double>& v) const
+    {
+        // Return quickly if the box is aperiodic
+        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
+        {
+            return v;
+        }
+
+        vec3<double> v_frac = makeFractional(v);
+        if (m_periodic.x)
+        {
+            v_frac.x = util::modulusPositive(v_frac.x, 1.0);
+        }
+        if (m_periodic.y)
+        {
+            v_frac.y = util::modulusPositive(v_frac.y, 1.0);
+        }
+        if (m_periodic.z)
+        {
+            v_frac.z = util::modulusPositive(v_frac.z, 1.0);
+        }
+        return makeAbsolute(v_frac);
+    }
+
     //! Wrap vectors back into the box in place
     /*! \param vecs Vectors to wrap, updated to the minimum image obeying the periodic settings
      *  \param Nvecs Number of vectors
      *  \param out The array in which to place the wrapped vectors.
+     *
+     *  The box configuration (periodicity, tilt factors, dimensionality) is
+     *  the same for every vector, so unlike the scalar wrap() all per-box
+     *  branches are hoisted out of the loop and the vectors are processed in
+     *  structure-of-arrays batches (vec3_batch in VectorMath.h) whose lane
+     *  loops the compiler vectorizes; for orthorhombic boxes the tilt terms
+     *  multiply by zero instead of branching. The per-lane arithmetic
+     *  follows makeFractional/makeAbsolute exactly, so the results match
+     *  the scalar path bit for bit.
      */
     void wrap(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
     {
+        // Aperiodic boxes pass every vector through untouched.
+        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
+        {
+            util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
+                std::copy(vecs + begin, vecs + end, out + begin);
+            });
+            return;
+        }
+        const float xz_coeff = m_xz - m_yz * m_xy;
         util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
+            constexpr unsigned int batch_width = 8;
+            vec3_batch<float, batch_width> batch;
+            for (size_t i = begin; i < end; i += batch_width)
             {
-                out[i] = wrap(vecs[i]);
+                const auto count = static_cast<unsigned int>(
+                    std::min(static_cast<size_t>(batch_width), end - i));
+                batch.load(vecs + i, count);
+                // makeFractional, overwriting components in dependency order
+                // (x reads y and z, y reads z) so the batch is updated in
+                // place.
+                for (unsigned int lane = 0; lane < count; lane++)
+                {
+                    batch.x[lane] = ((batch.x[lane] - m_lo.x)
+                                     - (xz_coeff * batch.z[lane] + m_xy * batch.y[lane]))
+                        / m_L.x;
+                }
+                for (unsigned int lane = 0; lane < count; lane++)
+                {
+                    batch.y[lane] = ((batch.y[lane] - m_lo.y) - m_yz * batch.z[lane]) / m_L.y;
+                }
+                if (m_2d)
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.z[lane] = float(0.0);
+                    }
+                }
+                else
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.z[lane] = (batch.z[lane] - m_lo.z) / m_L.z;
+                    }
+                }
+                if (m_periodic.x)
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.x[lane] = util::modulusPositive(batch.x[lane], float(1.0));
+                    }
+                }
+                if (m_periodic.y)
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.y[lane] = util::modulusPositive(batch.y[lane], float(1.0));
+                    }
+                }
+                if (m_periodic.z)
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.z[lane] = util::modulusPositive(batch.z[lane], float(1.0));
+                    }
+                }
+                // makeAbsolute
+                for (unsigned int lane = 0; lane < count; lane++)
+                {
+                    const float ax = m_lo.x + batch.x[lane] * m_L.x;
+                    const float ay = m_lo.y + batch.y[lane] * m_L.y;
+                    const float az = m_lo.z + batch.z[lane] * m_L.z;
+                    batch.x[lane] = ax + (m_xy * ay + m_xz * az);
+                    batch.y[lane] = ay + m_yz * az;
+                    batch.z[lane] = az;
+                }
+                if (m_2d)
+                {
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        batch.z[lane] = float(0.0);
+                    }
+                }
+                batch.store(out + i, count);
             }
         });
     }
 
+    //! Box shape categories for compile-time specialized wrapping.
+    /*! Orthorhombic shapes require zero tilt factors and full periodicity in
+     *  every in-plane direction; everything else (including partially
+     *  periodic boxes) falls into the generic Triclinic category, whose
+     *  kernel is the ordinary wrap().
+     */
+    enum class Shape
+    {
+        Orthorhombic2D,
+        Orthorhombic3D,
+        Triclinic
+    };
+
+    //! Classify this box's shape, e.g. once at query start.
+    Shape getShape() const
+    {
+        const bool orthorhombic
+            = m_xy == float(0.0) && m_xz == float(0.0) && m_yz == float(0.0);
+        if (orthorhombic && m_periodic.x && m_periodic.y)
+        {
+            if (m_2d)
+            {
+                return Shape::Orthorhombic2D;
+            }
+            if (m_periodic.z)
+            {
+                return Shape::Orthorhombic3D;
+            }
+        }
+        return Shape::Triclinic;
+    }
+
+    //! Wrap a vector back into the box, specialized on the box shape.
+    /*! \param v Vector to wrap
+     *  \returns Wrapped vector, identical to wrap(v)
+     *
+     *  The shape is a template parameter so the tilt arithmetic and the
+     *  periodicity and dimensionality branches of wrap() compile away in the
+     *  orthorhombic cases, leaving straight-line code in per-candidate
+     *  neighbor loops. Callers classify the box once with getShape() and
+     *  dispatch to the matching instantiation; passing a shape that does not
+     *  describe the box returns wrong results for the dropped terms, so the
+     *  generic Triclinic instantiation must be used whenever getShape()
+     *  says so.
+     */
+    template<Shape shape> vec3<float> wrapShape(const vec3<float>& v) const
+    {
+        // The shape comparisons are compile-time constants, so each
+        // instantiation keeps exactly one of these paths.
+        if (shape == Shape::Triclinic)
+        {
+            return wrap(v);
+        }
+        float fx = util::modulusPositive((v.x - m_lo.x) / m_L.x, float(1.0));
+        float fy = util::modulusPositive((v.y - m_lo.y) / m_L.y, float(1.0));
+        vec3<float> w(m_lo.x + fx * m_L.x, m_lo.y + fy * m_L.y, float(0.0));
+        if (shape == Shape::Orthorhombic3D)
+        {
+            float fz = util::modulusPositive((v.z - m_lo.z) / m_L.z, float(1.0));
+            w.z = m_lo.z + fz * m_L.z;
+        }
+        return w;
+    }
+
     //! Unwrap given positions to their absolute location in place
     /*! \param vecs Vectors of coordinates to unwrap
      *  \param images images flags for this point
@@ -355,15 +612,20 @@ public:
     */
     void unwrap(const vec3<float>* vecs, const vec3<int>* images, unsigned int Nvecs, vec3<float>* out) const
     {
+        // The lattice vectors are loop invariants; building them once here
+        // instead of per vector keeps the loop free of the range checks in
+        // getLatticeVector().
+        const vec3<float> a0 = getLatticeVector(0);
+        const vec3<float> a1 = getLatticeVector(1);
+        const vec3<float> a2 = m_2d ? vec3<float>(0, 0, 0) : getLatticeVector(2);
+        // In 2D a2 is the zero vector, so adding its term unconditionally
+        // keeps the loop a branch-free chain of fused multiply-adds without
+        // changing any component.
         util::forLoopWrapper(0, Nvecs, [=](size_t begin, size_t end) {
             for (size_t i = begin; i < end; ++i)
             {
-                out[i] = vecs[i] + getLatticeVector(0) * float(images[i].x)
-                    + getLatticeVector(1) * float(images[i].y);
-                if (!m_2d)
-                {
-                    out[i] += getLatticeVector(2) * float(images[i].z);
-                }
+                out[i] = vecs[i] + a0 * float(images[i].x) + a1 * float(images[i].y)
+                    + a2 * float(images[i].z);
             }
         });
     }
@@ -396,6 +658,28 @@ public:
                                  / constants::TWO_PI));
     }
 
+    //! Double-precision overload of centerOfMass (see makeAbsolute above).
+    vec3<double> centerOfMass(const vec3<double>* vecs, size_t Nvecs, const double* masses = nullptr) const
+    {
+        constexpr double two_pi = 2.0 * M_PI;
+        double total_mass(0);
+        vec3<std::complex<double>> xi_mean;
+
+        for (size_t i = 0; i < Nvecs; ++i)
+        {
+            vec3<double> phase(two_pi * makeFractional(vecs[i]));
+            vec3<std::complex<double>> xi(std::polar(1.0, phase.x), std::polar(1.0, phase.y),
+                                          std::polar(1.0, phase.z));
+            double mass = (masses != nullptr) ? masses[i] : 1.0;
+            total_mass += mass;
+            xi_mean += std::complex<double>(mass, 0) * xi;
+        }
+        xi_mean /= std::complex<double>(total_mass, 0);
+
+        return wrap(makeAbsolute(vec3<double>(std::arg(xi_mean.x), std::arg(xi_mean.y), std::arg(xi_mean.z))
+                                 / two_pi));
+    }
+
     //! Subtract center of mass from vectors
     /*! \param vecs Vectors to center
      *  \param Nvecs Number of vectors
@@ -2,12 +2,15 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <atomic>
 #include <numeric>
+#include <tbb/parallel_sort.h>
 
 #include "Cluster.h"
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
 #include "dset/dset.h"
+#include "utils.h"
 
 //! Finds clusters using a network of neighbors.
 namespace freud { namespace cluster {
@@ -16,9 +19,10 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
                       freud::locality::QueryArgs qargs, const unsigned int* keys)
 {
     const unsigned int num_points = nq->getNPoints();
-    m_cluster_idx.prepare(num_points);
     DisjointSets dj(num_points);
 
+    // The bond loop runs in parallel and the disjoint set supports concurrent
+    // CAS-based unite calls, so the union phase needs no serialization.
     freud::locality::loopOverNeighbors(
         nq, nq->getPoints(), num_points, qargs, nlist,
         [&dj](const freud::locality::NeighborBond& neighbor_bond) {
@@ -30,64 +34,159 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
         });
 
     // Done looping over points. All clusters are now determined.
-    // Next, we renumber clusters from zero to num_clusters-1.
+    computeClusterLabels(dj, num_points, keys);
+}
+
+void Cluster::computeClusterLabels(DisjointSets& dj, unsigned int num_points, const unsigned int* keys)
+{
+    m_cluster_idx.prepare(num_points);
+
+    // We renumber clusters from zero to num_clusters-1.
     // These new cluster indexes are then sorted by cluster size from largest
     // to smallest, with equally-sized clusters sorted based on their minimum
     // point index.
-    std::vector<size_t> cluster_label(num_points, num_points);
-    std::vector<size_t> cluster_label_count(num_points);
-    std::vector<size_t> cluster_min_id(num_points, num_points);
 
-    // Loop over every point.
-    m_num_clusters = 0;
-    for (size_t i = 0; i < num_points; i++)
+    // Parallel find-compress pass: resolve every point's root once, so the
+    // passes below are plain array lookups.
+    std::vector<size_t> roots(num_points);
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            roots[i] = dj.find(i);
+        }
+    });
+
+    // Assign consecutive labels to the cluster roots with a blocked prefix
+    // sum: count the roots per block in parallel, scan the small per-block
+    // totals serially, then fill in the labels in parallel. The intermediate
+    // label order does not matter for the final indices because the
+    // permutation computed below orders clusters by size and minimum point
+    // id, both of which are label-independent.
+    const size_t block_size = 65536;
+    const size_t num_blocks = (num_points + block_size - 1) / block_size;
+    std::vector<size_t> block_offsets(num_blocks + 1, 0);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b)
+        {
+            const size_t block_end = std::min((b + 1) * block_size, size_t(num_points));
+            size_t count = 0;
+            for (size_t i = b * block_size; i < block_end; ++i)
+            {
+                count += (roots[i] == i) ? 1 : 0;
+            }
+            block_offsets[b + 1] = count;
+        }
+    });
+    for (size_t b = 0; b < num_blocks; ++b)
     {
-        size_t s = dj.find(i);
+        block_offsets[b + 1] += block_offsets[b];
+    }
+    m_num_clusters = block_offsets[num_blocks];
 
-        // Label this cluster if we haven't seen it yet.
-        if (cluster_label[s] == num_points)
+    std::vector<size_t> cluster_label(num_points);
+    util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b)
         {
-            // Label this cluster uniquely.
-            cluster_label[s] = m_num_clusters;
-            // Track the smallest point index in this cluster.
-            cluster_min_id[cluster_label[s]] = i;
-            // Increment the count of unique clusters.
-            m_num_clusters++;
+            const size_t block_end = std::min((b + 1) * block_size, size_t(num_points));
+            size_t label = block_offsets[b];
+            for (size_t i = b * block_size; i < block_end; ++i)
+            {
+                if (roots[i] == i)
+                {
+                    cluster_label[i] = label++;
+                }
+            }
         }
+    });
 
-        // Increment the counter for this cluster label.
-        cluster_label_count[cluster_label[s]]++;
-    }
+    // Count the cluster members and track the smallest point index per
+    // cluster with lock-free updates; sums and minima are order-independent,
+    // so the results are deterministic.
+    std::vector<std::atomic<size_t>> cluster_label_count(m_num_clusters);
+    std::vector<std::atomic<size_t>> cluster_min_id(m_num_clusters);
+    util::forLoopWrapper(0, size_t(m_num_clusters), [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+            cluster_label_count[c].store(0, std::memory_order_relaxed);
+            cluster_min_id[c].store(num_points, std::memory_order_relaxed);
+        }
+    });
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const size_t label = cluster_label[roots[i]];
+            cluster_label_count[label].fetch_add(1, std::memory_order_relaxed);
+            size_t cur = cluster_min_id[label].load(std::memory_order_relaxed);
+            while (i < cur
+                   && !cluster_min_id[label].compare_exchange_weak(cur, i, std::memory_order_relaxed))
+            {}
+        }
+    });
 
-    // Resize label counts and min ids to the number of unique clusters found.
-    cluster_label_count.resize(m_num_clusters);
-    cluster_label_count.shrink_to_fit();
-    cluster_min_id.resize(m_num_clusters);
-    cluster_min_id.shrink_to_fit();
+    std::vector<size_t> counts(m_num_clusters);
+    std::vector<size_t> min_ids(m_num_clusters);
+    util::forLoopWrapper(0, size_t(m_num_clusters), [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+            counts[c] = cluster_label_count[c].load(std::memory_order_relaxed);
+            min_ids[c] = cluster_min_id[c].load(std::memory_order_relaxed);
+        }
+    });
 
     // Get a permutation that reorders clusters, largest to smallest.
-    std::vector<size_t> cluster_reindex = sort_indexes_inverse(cluster_label_count, cluster_min_id);
+    std::vector<size_t> cluster_reindex = sort_indexes_inverse(counts, min_ids);
 
-    // Clear the cluster keys
-    m_cluster_keys = std::vector<std::vector<unsigned int>>(m_num_clusters, std::vector<unsigned int>());
+    // Set the final cluster index of every point.
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_cluster_idx[i] = cluster_reindex[cluster_label[roots[i]]];
+        }
+    });
 
-    /* Loop over all points, set their cluster ids and add them to a list of
-     * sets. Each set contains all the keys that are part of that cluster. If
-     * no keys are provided, the keys use point ids. Get the computed list
-     * with getClusterKeys().
+    /* Build the list of keys that are part of each cluster. If no keys are
+     * provided, the keys use point ids. Get the computed list with
+     * getClusterKeys(). Points are ordered by cluster with a parallel sort
+     * (ascending point index within each cluster, as before), and each
+     * cluster's key list is then filled in by its own task.
      */
-    for (size_t i = 0; i < num_points; i++)
-    {
-        size_t s = dj.find(i);
-        size_t cluster_idx = cluster_reindex[cluster_label[s]];
-        m_cluster_idx[i] = cluster_idx;
-        unsigned int key = i;
-        if (keys != nullptr)
+    std::vector<size_t> sorted_counts(m_num_clusters);
+    util::forLoopWrapper(0, size_t(m_num_clusters), [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
         {
-            key = keys[i];
+            sorted_counts[cluster_reindex[c]] = counts[c];
         }
-        m_cluster_keys[cluster_idx].push_back(key);
+    });
+    std::vector<size_t> cluster_offsets(m_num_clusters + 1, 0);
+    for (size_t c = 0; c < m_num_clusters; ++c)
+    {
+        cluster_offsets[c + 1] = cluster_offsets[c] + sorted_counts[c];
     }
+
+    std::vector<unsigned int> order(num_points);
+    std::iota(order.begin(), order.end(), 0);
+    const unsigned int* cluster_idx = m_cluster_idx.get();
+    tbb::parallel_sort(order.begin(), order.end(), [cluster_idx](unsigned int i, unsigned int j) {
+        if (cluster_idx[i] != cluster_idx[j])
+        {
+            return cluster_idx[i] < cluster_idx[j];
+        }
+        return i < j;
+    });
+
+    m_cluster_keys = std::vector<std::vector<unsigned int>>(m_num_clusters, std::vector<unsigned int>());
+    util::forLoopWrapper(0, size_t(m_num_clusters), [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+            std::vector<unsigned int>& cluster_keys = m_cluster_keys[c];
+            cluster_keys.resize(sorted_counts[c]);
+            for (size_t k = 0; k < sorted_counts[c]; ++k)
+            {
+                const unsigned int i = order[cluster_offsets[c] + k];
+                cluster_keys[k] = (keys != nullptr) ? keys[i] : i;
+            }
+        }
+    });
 }
 
 // Returns inverse permutation of cluster indexes, sorted from largest to smallest.
@@ -99,8 +198,10 @@ std::vector<size_t> Cluster::sort_indexes_inverse(const std::vector<size_t>& cou
     std::vector<size_t> idx(counts.size());
     std::iota(idx.begin(), idx.end(), 0);
 
-    // Sort indexes based on comparing values in counts, min_ids.
-    std::sort(idx.begin(), idx.end(), [&counts, &min_ids](size_t i1, size_t i2) {
+    // Sort indexes based on comparing values in counts, min_ids. The
+    // comparison is a strict total order (minimum point ids are unique), so
+    // the unstable parallel sort is still deterministic.
+    tbb::parallel_sort(idx.begin(), idx.end(), [&counts, &min_ids](size_t i1, size_t i2) {
         if (counts[i1] != counts[i2])
         {
             // If the counts are unequal, return the largest cluster first.
@@ -15,6 +15,8 @@
     \brief Routines for clustering points.
 */
 
+class DisjointSets;
+
 namespace freud { namespace cluster {
 //! Finds clusters using a network of neighbors.
 /*! Given a set of points and their neighbors, freud.cluster.Cluster will
@@ -47,6 +49,15 @@ public:
     void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
                  freud::locality::QueryArgs qargs, const unsigned int* keys = nullptr);
 
+    //! Compute the cluster labels from an already-united disjoint set forest.
+    /*! Renumbers the components of \a dj into cluster indices sorted from
+     *  largest to smallest cluster and fills in the cluster keys, exactly as
+     *  compute() does after its bond loop. Exposed so that callers which
+     *  maintain their own forest (e.g. ClusterTracker, which carries the
+     *  forest between trajectory frames) can reuse the labeling passes.
+     */
+    void computeClusterLabels(DisjointSets& dj, unsigned int num_points, const unsigned int* keys = nullptr);
+
     //! Get the total number of clusters.
     unsigned int getNumClusters() const
     {
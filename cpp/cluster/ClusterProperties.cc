@@ -1,10 +1,14 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <atomic>
+#include <numeric>
+#include <tbb/parallel_sort.h>
 #include <vector>
 
 #include "ClusterProperties.h"
 #include "NeighborComputeFunctional.h"
+#include "utils.h"
 
 /*! \file ClusterProperties.cc
     \brief Routines for computing properties of point clusters.
@@ -22,9 +26,22 @@ namespace freud { namespace cluster {
 */
 
 void ClusterProperties::compute(const freud::locality::NeighborQuery* nq, const unsigned int* cluster_idx)
+{
+    computeImpl(nq->getBox(), nq->getPoints(), nq->getNPoints(), cluster_idx);
+}
+
+void ClusterProperties::compute(const box::Box& box, const vec3<double>* points, unsigned int num_points,
+                                const unsigned int* cluster_idx)
+{
+    computeImpl(box, points, num_points, cluster_idx);
+}
+
+template<typename T>
+void ClusterProperties::computeImpl(const box::Box& box, const vec3<T>* points, unsigned int num_points,
+                                    const unsigned int* cluster_idx)
 {
     // determine the number of clusters
-    const unsigned int* max_cluster_id = std::max_element(cluster_idx, cluster_idx + nq->getNPoints());
+    const unsigned int* max_cluster_id = std::max_element(cluster_idx, cluster_idx + num_points);
     const unsigned int num_clusters = *max_cluster_id + 1;
 
     // allocate memory for the cluster properties and temporary arrays
@@ -33,60 +50,94 @@ void ClusterProperties::compute(const freud::locality::NeighborQuery* nq, const
     m_cluster_gyrations.prepare({num_clusters, 3, 3});
     m_cluster_sizes.prepare(num_clusters);
 
-    // Create a vector to store cluster points, used to compute center of mass
-    std::vector<std::vector<vec3<float>>> cluster_points(num_clusters, std::vector<vec3<float>>());
+    // Count the cluster members with lock-free adds; the sums are
+    // order-independent, so the counts are deterministic.
+    std::vector<std::atomic<unsigned int>> cluster_sizes(num_clusters);
+    util::forLoopWrapper(0, num_clusters, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+            cluster_sizes[c].store(0, std::memory_order_relaxed);
+        }
+    });
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            cluster_sizes[cluster_idx[i]].fetch_add(1, std::memory_order_relaxed);
+        }
+    });
+    util::forLoopWrapper(0, num_clusters, [&](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+            m_cluster_sizes[c] = cluster_sizes[c].load(std::memory_order_relaxed);
+        }
+    });
 
-    // Start by determining the center of mass of each cluster. Since we are
-    // given an array of points, the easiest way to do this is to loop over
-    // all points and add the appropriate information to m_cluster_centers as
-    // we go.
-    for (unsigned int i = 0; i < nq->getNPoints(); i++)
+    // Group the points by cluster: sort the point indices by (cluster, index)
+    // in parallel, so each cluster occupies a contiguous range and can be
+    // processed by its own task below. Members stay in ascending point order,
+    // which keeps the accumulation order (and hence the floating point
+    // results) the same as a serial pass over all points.
+    std::vector<size_t> cluster_offsets(num_clusters + 1, 0);
+    for (size_t c = 0; c < num_clusters; ++c)
     {
-        const unsigned int c = cluster_idx[i];
-        cluster_points[c].push_back((*nq)[i]);
-        m_cluster_sizes[c]++;
+        cluster_offsets[c + 1] = cluster_offsets[c] + m_cluster_sizes[c];
     }
+    std::vector<unsigned int> order(num_points);
+    std::iota(order.begin(), order.end(), 0);
+    tbb::parallel_sort(order.begin(), order.end(), [cluster_idx](unsigned int i, unsigned int j) {
+        if (cluster_idx[i] != cluster_idx[j])
+        {
+            return cluster_idx[i] < cluster_idx[j];
+        }
+        return i < j;
+    });
 
-    // Now that we have located all of the cluster vectors, compute the centers
-    for (unsigned int c = 0; c < num_clusters; c++)
-    {
-        m_cluster_centers[c] = nq->getBox().centerOfMass(cluster_points[c].data(), m_cluster_sizes[c]);
-    }
+    // Compute the center of mass and the gyration tensor of each cluster in
+    // parallel over the clusters.
+    util::forLoopWrapper(0, num_clusters, [&](size_t begin, size_t end) {
+        std::vector<vec3<T>> cluster_points;
+        for (size_t c = begin; c < end; ++c)
+        {
+            const size_t size = m_cluster_sizes[c];
+            cluster_points.resize(size);
+            for (size_t k = 0; k < size; ++k)
+            {
+                cluster_points[k] = points[order[cluster_offsets[c] + k]];
+            }
 
-    // Now that we have determined the centers of mass for each cluster, tally
-    // up the gyration tensor. This has to be done in a loop over the points.
-    for (unsigned int i = 0; i < nq->getNPoints(); i++)
-    {
-        unsigned int c = cluster_idx[i];
-        vec3<float> pos = (*nq)[i];
-        vec3<float> delta = nq->getBox().wrap(pos - m_cluster_centers[c]);
-
-        // get the start pointer for our 3x3 matrix
-        m_cluster_gyrations(c, 0, 0) += delta.x * delta.x;
-        m_cluster_gyrations(c, 0, 1) += delta.x * delta.y;
-        m_cluster_gyrations(c, 0, 2) += delta.x * delta.z;
-        m_cluster_gyrations(c, 1, 0) += delta.y * delta.x;
-        m_cluster_gyrations(c, 1, 1) += delta.y * delta.y;
-        m_cluster_gyrations(c, 1, 2) += delta.y * delta.z;
-        m_cluster_gyrations(c, 2, 0) += delta.z * delta.x;
-        m_cluster_gyrations(c, 2, 1) += delta.z * delta.y;
-        m_cluster_gyrations(c, 2, 2) += delta.z * delta.z;
-    }
+            const vec3<T> center = box.centerOfMass(cluster_points.data(), size);
+            m_cluster_centers[c] = vec3<float>(center);
 
-    // Normalize by the cluster size.
-    for (unsigned int c = 0; c < num_clusters; c++)
-    {
-        auto s = static_cast<float>(m_cluster_sizes[c]);
-        m_cluster_gyrations(c, 0, 0) /= s;
-        m_cluster_gyrations(c, 0, 1) /= s;
-        m_cluster_gyrations(c, 0, 2) /= s;
-        m_cluster_gyrations(c, 1, 0) /= s;
-        m_cluster_gyrations(c, 1, 1) /= s;
-        m_cluster_gyrations(c, 1, 2) /= s;
-        m_cluster_gyrations(c, 2, 0) /= s;
-        m_cluster_gyrations(c, 2, 1) /= s;
-        m_cluster_gyrations(c, 2, 2) /= s;
-    }
+            // Accumulate in the input scalar type so the double path does
+            // not round partial sums through float; the results are stored
+            // in single precision either way.
+            T gyration[3][3] = {};
+            for (size_t k = 0; k < size; ++k)
+            {
+                const vec3<T> delta = box.wrap(cluster_points[k] - center);
+
+                gyration[0][0] += delta.x * delta.x;
+                gyration[0][1] += delta.x * delta.y;
+                gyration[0][2] += delta.x * delta.z;
+                gyration[1][0] += delta.y * delta.x;
+                gyration[1][1] += delta.y * delta.y;
+                gyration[1][2] += delta.y * delta.z;
+                gyration[2][0] += delta.z * delta.x;
+                gyration[2][1] += delta.z * delta.y;
+                gyration[2][2] += delta.z * delta.z;
+            }
+
+            // Normalize by the cluster size.
+            auto s = static_cast<T>(size);
+            for (unsigned int i = 0; i < 3; ++i)
+            {
+                for (unsigned int j = 0; j < 3; ++j)
+                {
+                    m_cluster_gyrations(c, i, j) = static_cast<float>(gyration[i][j] / s);
+                }
+            }
+        }
+    });
 }
 
 }; }; // end namespace freud::cluster
@@ -34,6 +34,16 @@ public:
     //! Compute properties of the point clusters
     void compute(const freud::locality::NeighborQuery* nq, const unsigned int* cluster_idx);
 
+    //! Double-precision overload of compute.
+    /*! Accepts double coordinates directly (e.g. from unwrapped trajectories
+     *  whose extent exceeds float resolution) and runs the periodic
+     *  center-of-mass and the gyration tensor accumulation entirely in
+     *  double before storing the results. Selected by input dtype at the
+     *  binding layer; the float path is unchanged.
+     */
+    void compute(const box::Box& box, const vec3<double>* points, unsigned int num_points,
+                 const unsigned int* cluster_idx);
+
     //! Get a reference to the last computed cluster centers
     const util::ManagedArray<vec3<float>>& getClusterCenters() const
     {
@@ -53,6 +63,14 @@ public:
     }
 
 private:
+    //! Shared implementation of both compute overloads.
+    /*! All intermediate arithmetic runs in the scalar type T; the results
+     *  are stored into the single-precision output arrays.
+     */
+    template<typename T>
+    void computeImpl(const box::Box& box, const vec3<T>* points, unsigned int num_points,
+                     const unsigned int* cluster_idx);
+
     util::ManagedArray<vec3<float>>
         m_cluster_centers; //!< Center of mass computed for each cluster (length: m_num_clusters)
     util::ManagedArray<float>
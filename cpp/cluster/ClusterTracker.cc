@@ -0,0 +1,266 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <tbb/parallel_sort.h>
+#include <vector>
+
+#include "ClusterTracker.h"
+#include "NeighborComputeFunctional.h"
+#include "dset/dset.h"
+#include "utils.h"
+
+/*! \file ClusterTracker.cc
+    \brief Routines for tracking clusters across trajectory frames.
+*/
+
+namespace freud { namespace cluster {
+
+// The constructor and destructor live here so that the unique_ptr member can
+// hold the DisjointSets type, which is only complete in this file.
+const unsigned int ClusterTracker::NO_SOURCE;
+
+ClusterTracker::ClusterTracker() = default;
+
+ClusterTracker::~ClusterTracker() = default;
+
+void ClusterTracker::reset()
+{
+    m_dj.reset();
+    m_bond_keys.clear();
+    m_num_points = 0;
+    m_prev_cluster_idx.clear();
+    m_prev_persistent.clear();
+    m_next_persistent_id = 0;
+    m_events.clear();
+}
+
+void ClusterTracker::compute(const freud::locality::NeighborQuery* nq,
+                             const freud::locality::NeighborList* nlist,
+                             freud::locality::QueryArgs qargs, const unsigned int* keys)
+{
+    const unsigned int num_points = nq->getNPoints();
+
+    // Materialize the current frame's bonds so they can be diffed against the
+    // previous frame and replayed on a rebuild.
+    const locality::NeighborList computed_nlist
+        = locality::makeDefaultNlist(nq, nlist, nq->getPoints(), num_points, qargs);
+    const unsigned int num_bonds = computed_nlist.getNumBonds();
+    const auto& neighbors = computed_nlist.getNeighbors();
+
+    // Canonicalize the bond list into sorted 64-bit (query point, point) keys
+    // so the frame-to-frame diff is a linear two-pointer pass.
+    std::vector<uint64_t> bond_keys(num_bonds);
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b)
+        {
+            bond_keys[b] = (uint64_t(neighbors(b, 0)) << 32) | uint64_t(neighbors(b, 1));
+        }
+    });
+    tbb::parallel_sort(bond_keys.begin(), bond_keys.end());
+
+    // Diff against the previous frame's bonds.
+    std::vector<uint64_t> appeared;
+    bool any_disappeared = false;
+    {
+        size_t p = 0;
+        size_t c = 0;
+        while (p < m_bond_keys.size() && c < bond_keys.size())
+        {
+            if (m_bond_keys[p] == bond_keys[c])
+            {
+                ++p;
+                ++c;
+            }
+            else if (m_bond_keys[p] < bond_keys[c])
+            {
+                any_disappeared = true;
+                ++p;
+            }
+            else
+            {
+                appeared.push_back(bond_keys[c]);
+                ++c;
+            }
+        }
+        any_disappeared = any_disappeared || (p < m_bond_keys.size());
+        appeared.insert(appeared.end(), bond_keys.begin() + c, bond_keys.end());
+    }
+
+    // A disjoint set can merge components but never split them, so the
+    // carried forest is only valid when no bond disappeared. Otherwise (or
+    // when the point count changed, or on the first frame) rebuild the forest
+    // from the full current bond list.
+    const bool incremental = m_dj && num_points == m_num_points && !any_disappeared;
+    const std::vector<uint64_t>& bonds_to_unite = incremental ? appeared : bond_keys;
+    if (!incremental)
+    {
+        m_dj.reset(new DisjointSets(num_points));
+    }
+    DisjointSets& dj = *m_dj;
+
+    // The disjoint set supports concurrent CAS-based unite calls, so the
+    // union phase runs in parallel just like in Cluster::compute.
+    util::forLoopWrapper(0, bonds_to_unite.size(), [&](size_t begin, size_t end) {
+        for (size_t b = begin; b < end; ++b)
+        {
+            const auto query_point_idx = uint32_t(bonds_to_unite[b] >> 32);
+            const auto point_idx = uint32_t(bonds_to_unite[b]);
+            if (!dj.same(point_idx, query_point_idx))
+            {
+                dj.unite(point_idx, query_point_idx);
+            }
+        }
+    });
+
+    // Label the frame with the shared pipeline, then carry the identities
+    // over from the previous frame.
+    m_clusters.computeClusterLabels(dj, num_points, keys);
+    matchPersistentIds(num_points);
+
+    m_bond_keys = std::move(bond_keys);
+    m_num_points = num_points;
+}
+
+void ClusterTracker::matchPersistentIds(unsigned int num_points)
+{
+    const unsigned int* cluster_idx = m_clusters.getClusterIdx().get();
+    const unsigned int num_clusters = m_clusters.getNumClusters();
+    m_persistent_idx.prepare(num_points);
+    m_events.clear();
+
+    std::vector<unsigned int> persistent(num_clusters, NO_SOURCE);
+
+    if (m_prev_cluster_idx.size() == num_points && num_points > 0)
+    {
+        const auto prev_clusters = static_cast<unsigned int>(m_prev_persistent.size());
+
+        // Tally how many points each previous cluster placed in each current
+        // cluster. The overlap lists are built serially to keep the event
+        // order deterministic; the matching is linear in the point count.
+        std::vector<std::vector<std::pair<unsigned int, unsigned int>>> overlaps(prev_clusters);
+        {
+            // Per previous cluster, the current cluster seen last and its
+            // running count, so consecutive points in the same pair of
+            // clusters do not grow the overlap list.
+            for (unsigned int i = 0; i < num_points; ++i)
+            {
+                auto& list = overlaps[m_prev_cluster_idx[i]];
+                const unsigned int curr = cluster_idx[i];
+                bool found = false;
+                for (auto& entry : list)
+                {
+                    if (entry.first == curr)
+                    {
+                        ++entry.second;
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                {
+                    list.emplace_back(curr, 1);
+                }
+            }
+        }
+
+        // The heir of a previous cluster is the current cluster holding most
+        // of its points (ties towards the smaller current cluster index). Also
+        // record the best-overlap ancestor of each current cluster for split
+        // attribution.
+        std::vector<unsigned int> heir(prev_clusters, NO_SOURCE);
+        std::vector<unsigned int> best_prev(num_clusters, NO_SOURCE);
+        std::vector<unsigned int> best_prev_count(num_clusters, 0);
+        for (unsigned int p = 0; p < prev_clusters; ++p)
+        {
+            unsigned int best = NO_SOURCE;
+            unsigned int best_count = 0;
+            for (const auto& entry : overlaps[p])
+            {
+                if (entry.second > best_count || (entry.second == best_count && entry.first < best))
+                {
+                    best = entry.first;
+                    best_count = entry.second;
+                }
+                if (entry.second > best_prev_count[entry.first]
+                    || (entry.second == best_prev_count[entry.first]
+                        && m_prev_persistent[p] < m_prev_persistent[best_prev[entry.first]]))
+                {
+                    best_prev[entry.first] = p;
+                    best_prev_count[entry.first] = entry.second;
+                }
+            }
+            heir[p] = best;
+        }
+
+        // A current cluster inherits the persistent id of the previous
+        // cluster that contributed the most points among those whose heir it
+        // is; the other contenders are reported as merges. A cluster no
+        // previous cluster names as its heir split away from its best-overlap
+        // ancestor and gets a fresh id.
+        std::vector<unsigned int> donor(num_clusters, NO_SOURCE);
+        std::vector<unsigned int> donor_count(num_clusters, 0);
+        for (unsigned int p = 0; p < prev_clusters; ++p)
+        {
+            const unsigned int c = heir[p];
+            unsigned int count = 0;
+            for (const auto& entry : overlaps[p])
+            {
+                if (entry.first == c)
+                {
+                    count = entry.second;
+                    break;
+                }
+            }
+            if (donor[c] == NO_SOURCE || count > donor_count[c]
+                || (count == donor_count[c] && m_prev_persistent[p] < m_prev_persistent[donor[c]]))
+            {
+                donor[c] = p;
+                donor_count[c] = count;
+            }
+        }
+        for (unsigned int c = 0; c < num_clusters; ++c)
+        {
+            if (donor[c] != NO_SOURCE)
+            {
+                persistent[c] = m_prev_persistent[donor[c]];
+            }
+            else
+            {
+                persistent[c] = m_next_persistent_id++;
+                const unsigned int source
+                    = (best_prev[c] != NO_SOURCE) ? m_prev_persistent[best_prev[c]] : NO_SOURCE;
+                m_events.emplace_back((source == NO_SOURCE) ? BIRTH : SPLIT, persistent[c], source);
+            }
+        }
+        for (unsigned int p = 0; p < prev_clusters; ++p)
+        {
+            if (donor[heir[p]] != p)
+            {
+                m_events.emplace_back(MERGE, persistent[heir[p]], m_prev_persistent[p]);
+            }
+        }
+    }
+    else
+    {
+        // First frame of a trajectory (or the point count changed, which
+        // breaks the point identities the matching relies on): every cluster
+        // is a birth.
+        for (unsigned int c = 0; c < num_clusters; ++c)
+        {
+            persistent[c] = m_next_persistent_id++;
+            m_events.emplace_back(BIRTH, persistent[c], NO_SOURCE);
+        }
+    }
+
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_persistent_idx[i] = persistent[cluster_idx[i]];
+        }
+    });
+
+    m_prev_persistent = std::move(persistent);
+    m_prev_cluster_idx.assign(cluster_idx, cluster_idx + num_points);
+}
+
+}; }; // end namespace freud::cluster
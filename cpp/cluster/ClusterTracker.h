@@ -0,0 +1,124 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef CLUSTER_TRACKER_H
+#define CLUSTER_TRACKER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Cluster.h"
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file ClusterTracker.h
+    \brief Routines for tracking clusters across trajectory frames.
+*/
+
+class DisjointSets;
+
+namespace freud { namespace cluster {
+
+//! Tracks clusters across the frames of a trajectory.
+/*! ClusterTracker clusters each frame the same way Cluster does, but carries
+ *  state from one call of compute() to the next. The disjoint set forest is
+ *  kept between frames: when the bond network only gained bonds since the
+ *  previous frame, only the new bonds are united into the carried forest
+ *  instead of replaying the full bond list. Because a disjoint set can merge
+ *  components but never split them, any disappeared bond forces a rebuild of
+ *  the forest from the current bonds.
+ *
+ *  On top of the per-frame cluster indices, ClusterTracker assigns each
+ *  cluster a persistent id that is stable across frames. A cluster inherits
+ *  the persistent id of the previous-frame cluster it shares the most points
+ *  with, provided that previous cluster also placed the majority of its own
+ *  points here; ties break towards the smaller persistent id. The remaining
+ *  identity changes are reported as events: a cluster with no heritage is a
+ *  BIRTH, a previous cluster absorbed into another's id is a MERGE, and a
+ *  cluster that broke away from its best-overlap ancestor is a SPLIT.
+ */
+class ClusterTracker
+{
+public:
+    //! The kinds of identity changes reported per frame.
+    enum EventType
+    {
+        BIRTH = 0, //!< A cluster appeared with no ancestor (first frame, or after reset())
+        MERGE = 1, //!< A previous cluster's points were absorbed into another persistent id
+        SPLIT = 2  //!< A cluster broke away from the ancestor holding most of its points
+    };
+
+    //! One identity change between the previous and the current frame.
+    struct Event
+    {
+        Event(EventType type, unsigned int cluster_id, unsigned int source_id)
+            : type(type), cluster_id(cluster_id), source_id(source_id)
+        {}
+
+        EventType type;          //!< The kind of change
+        unsigned int cluster_id; //!< Persistent id of the cluster the event is about
+        unsigned int source_id;  //!< Persistent id of the ancestor involved (NO_SOURCE for births)
+    };
+
+    //! Source id used for events without an ancestor.
+    static const unsigned int NO_SOURCE = 0xffffffff;
+
+    //! Constructor
+    ClusterTracker();
+
+    //! Destructor
+    ~ClusterTracker();
+
+    //! Forget all carried state; the next frame starts a new trajectory.
+    void reset();
+
+    //! Cluster the next frame of the trajectory.
+    void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
+                 freud::locality::QueryArgs qargs, const unsigned int* keys = nullptr);
+
+    //! Get the per-frame clustering of the last computed frame.
+    const Cluster& getClusters() const
+    {
+        return m_clusters;
+    }
+
+    //! Get a reference to the persistent cluster id per point.
+    const util::ManagedArray<unsigned int>& getPersistentClusterIdx() const
+    {
+        return m_persistent_idx;
+    }
+
+    //! Get the identity changes between the previous and the last frame.
+    const std::vector<Event>& getEvents() const
+    {
+        return m_events;
+    }
+
+    //! Get the number of persistent ids handed out so far.
+    unsigned int getNumPersistentClusters() const
+    {
+        return m_next_persistent_id;
+    }
+
+private:
+    //! Map the current per-frame clusters onto persistent ids and emit events.
+    void matchPersistentIds(unsigned int num_points);
+
+    Cluster m_clusters;                 //!< Per-frame clustering of the last computed frame
+    std::unique_ptr<DisjointSets> m_dj; //!< Forest carried between frames
+    std::vector<uint64_t> m_bond_keys;  //!< Sorted (query point, point) bond keys of the previous frame
+    unsigned int m_num_points {0};      //!< Number of points in the previous frame
+
+    std::vector<unsigned int> m_prev_cluster_idx; //!< Per-frame cluster index per point, previous frame
+    std::vector<unsigned int> m_prev_persistent;  //!< Persistent id per previous-frame cluster
+    unsigned int m_next_persistent_id {0};        //!< Next unused persistent id
+
+    util::ManagedArray<unsigned int> m_persistent_idx; //!< Persistent cluster id for each point
+    std::vector<Event> m_events;                       //!< Identity changes of the last frame
+};
+
+}; }; // end namespace freud::cluster
+
+#endif // CLUSTER_TRACKER_H
@@ -74,6 +74,13 @@ private:
     // Typedef thread local histogram type for use in code.
     using CFThreadHistogram = typename util::Histogram<T>::ThreadLocalHistogram;
 
+    //! \internal
+    //! Blocked binning over a precomputed NeighborList bond stream; the
+    //! complex instantiation is specialized to multiply real and imaginary
+    //! parts in separate lanes.
+    void accumulateBlocked(const freud::locality::NeighborList* nlist, const T* values,
+                           const T* query_values);
+
     util::Histogram<T> m_correlation_function;      //!< The correlation function
     CFThreadHistogram m_local_correlation_function; //!< Thread local copy of the correlation function
 };
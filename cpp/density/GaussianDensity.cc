@@ -1,9 +1,15 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
+#include <complex>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "FFT.h"
 #include "GaussianDensity.h"
 
 /*! \file GaussianDensity.cc
@@ -12,8 +18,8 @@
 
 namespace freud { namespace density {
 
-GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma)
-    : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_has_computed(false)
+GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma, Mode mode)
+    : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_mode(mode), m_has_computed(false)
 {
     if (r_max <= 0)
     {
@@ -49,8 +55,6 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
                                     "number of dimensions.");
     }
 
-    auto n_points = nq->getNPoints();
-
     // if the user gives a single number for width, but the nq box is 2D, and
     // we want a 2D calculation
     if (m_box.is2D())
@@ -59,6 +63,198 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
     }
 
     m_density_array.prepare({m_width.x, m_width.y, m_width.z});
+
+    switch (m_mode)
+    {
+    case Mode::Separable:
+        computeSeparable(nq, values);
+        break;
+    case Mode::FFT:
+        computeFFT(nq, values);
+        break;
+    default:
+        computeDirect(nq, values);
+        break;
+    }
+}
+
+/*! Runs the direct evaluation one slab of the slowest (x) dimension at a
+ *  time so that only slab_width planes of the grid are resident, and
+ *  appends each finished slab to the output file. Slabs along x are
+ *  contiguous runs of the row-major (x, y, z) array, so the file fills
+ *  with purely sequential writes. Particles are bucketed up front by the
+ *  slabs their cutoff range of x bins touches — the same bin assignment
+ *  the in-memory path uses — so each slab only visits the particles that
+ *  can reach it. The per-voxel arithmetic is identical to computeDirect;
+ *  only the storage extent changes.
+ */
+void GaussianDensity::computeToFile(const freud::locality::NeighborQuery* nq, const std::string& filename,
+                                    unsigned int slab_width, const float* values)
+{
+    if (!m_has_computed || nq->getBox().is2D() == m_box.is2D())
+    {
+        m_box = nq->getBox();
+        m_has_computed = true;
+    }
+    else
+    {
+        throw std::invalid_argument("The dimensionality of the box passed to GaussianDensity has "
+                                    "changed. A new instance must be created to handle a different "
+                                    "number of dimensions.");
+    }
+    if (slab_width == 0)
+    {
+        throw std::invalid_argument("GaussianDensity requires slab_width to be positive.");
+    }
+
+    if (m_box.is2D())
+    {
+        m_width.z = 1;
+    }
+
+    auto n_points = nq->getNPoints();
+
+    const float Lx = m_box.getLx();
+    const float Ly = m_box.getLy();
+    const float Lz = m_box.getLz();
+    const vec3<bool> periodic = m_box.getPeriodic();
+
+    const float grid_size_x = Lx / static_cast<float>(m_width.x);
+    const float grid_size_y = Ly / static_cast<float>(m_width.y);
+    const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
+
+    const int bin_cut_x = int(m_r_max / grid_size_x);
+    const int bin_cut_y = int(m_r_max / grid_size_y);
+    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    const float r_max_sq = m_r_max * m_r_max;
+    const float sigmasq = m_sigma * m_sigma;
+    const float normalization_base = float(1.0) / std::sqrt(constants::TWO_PI * sigmasq);
+    const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
+    const float normalization = std::pow(normalization_base, dimensions);
+
+    const unsigned int n_slabs = (m_width.x + slab_width - 1) / slab_width;
+
+    // Bucket particles by the slabs their cutoff range of x bins touches.
+    std::vector<std::vector<size_t>> slab_points(n_slabs);
+    std::vector<bool> touched(n_slabs);
+    for (size_t idx = 0; idx < n_points; ++idx)
+    {
+        const vec3<float> point = (*nq)[idx];
+        const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+        std::fill(touched.begin(), touched.end(), false);
+        for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+        {
+            if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+            {
+                continue;
+            }
+            touched[((i + m_width.x) % m_width.x) / slab_width] = true;
+        }
+        for (unsigned int slab = 0; slab < n_slabs; slab++)
+        {
+            if (touched[slab])
+            {
+                slab_points[slab].push_back(idx);
+            }
+        }
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("GaussianDensity could not open " + filename + " for writing.");
+    }
+
+    util::ManagedArray<float> slab_array;
+    for (unsigned int slab = 0; slab < n_slabs; slab++)
+    {
+        const unsigned int x_start = slab * slab_width;
+        const unsigned int slab_w = std::min(slab_width, m_width.x - x_start);
+        slab_array.prepare({slab_w, m_width.y, m_width.z});
+        util::ThreadStorage<float> local_bin_counts({slab_w, m_width.y, m_width.z});
+        const auto& points_in_slab = slab_points[slab];
+
+        util::forLoopWrapper(0, points_in_slab.size(), [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p)
+            {
+                const size_t idx = points_in_slab[p];
+                const vec3<float> point = (*nq)[idx];
+                const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+                int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+                int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+                int bin_z = int((point.z + Lz / float(2.0)) / grid_size_z);
+                if (m_box.is2D())
+                {
+                    bin_z = 0;
+                }
+
+                for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+                {
+                    if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                    {
+                        continue;
+                    }
+                    const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0))
+                        - point.z - (Lz / float(2.0));
+
+                    for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+                    {
+                        if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                        {
+                            continue;
+                        }
+                        const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
+                            - point.y - (Ly / float(2.0));
+
+                        for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                        {
+                            if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                            {
+                                continue;
+                            }
+                            // Skip bins outside the current slab.
+                            const unsigned int ni = (i + m_width.x) % m_width.x;
+                            if (ni < x_start || ni >= x_start + slab_w)
+                            {
+                                continue;
+                            }
+                            const float dx = (grid_size_x * static_cast<float>(i))
+                                + (grid_size_x / float(2.0)) - point.x - (Lx / float(2.0));
+
+                            const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                            const float r_sq = dot(delta, delta);
+
+                            if (r_sq < r_max_sq)
+                            {
+                                const float gaussian
+                                    = value * normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
+
+                                const unsigned int nj = (j + m_width.y) % m_width.y;
+                                const unsigned int nk = (k + m_width.z) % m_width.z;
+                                local_bin_counts.local()(ni - x_start, nj, nk) += gaussian;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        local_bin_counts.reduceInto(slab_array);
+        file.write(reinterpret_cast<const char*>(slab_array.get()),
+                   static_cast<std::streamsize>(slab_array.size() * sizeof(float)));
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("GaussianDensity failed while writing " + filename + ".");
+    }
+}
+
+void GaussianDensity::computeDirect(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    auto n_points = nq->getNPoints();
+
     util::ThreadStorage<float> local_bin_counts({m_width.x, m_width.y, m_width.z});
 
     // set up some constants first
@@ -159,4 +355,333 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
     local_bin_counts.reduceInto(m_density_array);
 }
 
+/*! The Gaussian factorizes as exp(-r^2/2s^2) = exp(-dx^2/2s^2) *
+ *  exp(-dy^2/2s^2) * exp(-dz^2/2s^2), and in an orthorhombic box the
+ *  minimum image wrap acts on each axis independently, so the weights over
+ *  the cutoff cube are an outer product of three per-axis vectors. Each
+ *  particle therefore evaluates one exp() per bin per axis instead of one
+ *  per bin of the cube, and the cube accumulation itself reduces to one
+ *  multiply-add per cell. The per-axis displacements, wrapped bin indices
+ *  and the spherical r^2 < r_max^2 support test are identical to the
+ *  direct evaluation; only the exp() factorization changes, so the result
+ *  agrees with Direct up to floating point rounding.
+ */
+void GaussianDensity::computeSeparable(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    if (m_box.getTiltFactorXY() != float(0.0) || m_box.getTiltFactorXZ() != float(0.0)
+        || m_box.getTiltFactorYZ() != float(0.0))
+    {
+        throw std::invalid_argument("GaussianDensity separable mode requires an orthorhombic box "
+                                    "because triclinic wrapping mixes the axes.");
+    }
+
+    auto n_points = nq->getNPoints();
+
+    util::ThreadStorage<float> local_bin_counts({m_width.x, m_width.y, m_width.z});
+
+    const float Lx = m_box.getLx();
+    const float Ly = m_box.getLy();
+    const float Lz = m_box.getLz();
+    const vec3<bool> periodic = m_box.getPeriodic();
+
+    const float grid_size_x = Lx / static_cast<float>(m_width.x);
+    const float grid_size_y = Ly / static_cast<float>(m_width.y);
+    const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
+
+    const int bin_cut_x = int(m_r_max / grid_size_x);
+    const int bin_cut_y = int(m_r_max / grid_size_y);
+    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    const float r_max_sq = m_r_max * m_r_max;
+    const float sigmasq = m_sigma * m_sigma;
+    const float normalization_base = float(1.0) / std::sqrt(constants::TWO_PI * sigmasq);
+    const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
+    const float normalization = std::pow(normalization_base, dimensions);
+
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        // Per-axis scratch reused across the chunk: wrapped storage bin,
+        // squared wrapped displacement, and Gaussian weight of every
+        // in-range bin along the axis.
+        std::vector<unsigned int> bins_x, bins_y, bins_z;
+        std::vector<float> d_sq_x, d_sq_y, d_sq_z;
+        std::vector<float> weight_x, weight_y, weight_z;
+
+        auto& local_counts = local_bin_counts.local();
+
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const vec3<float> point = (*nq)[idx];
+            const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+            int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+            int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+            int bin_z = int((point.z + Lz / float(2.0)) / grid_size_z);
+            if (m_box.is2D())
+            {
+                bin_z = 0;
+            }
+
+            // Build the per-axis weight vectors. The displacement formula
+            // and the per-axis wrap match the direct evaluation exactly.
+            bins_x.clear();
+            d_sq_x.clear();
+            weight_x.clear();
+            for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+            {
+                if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                {
+                    continue;
+                }
+                const float dx = (grid_size_x * static_cast<float>(i)) + (grid_size_x / float(2.0))
+                    - point.x - (Lx / float(2.0));
+                const float dx_wrapped = m_box.wrap(vec3<float>(dx, 0, 0)).x;
+                bins_x.push_back((i + m_width.x) % m_width.x);
+                d_sq_x.push_back(dx_wrapped * dx_wrapped);
+                weight_x.push_back(std::exp(-dx_wrapped * dx_wrapped / (float(2.0) * sigmasq)));
+            }
+
+            bins_y.clear();
+            d_sq_y.clear();
+            weight_y.clear();
+            for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+            {
+                if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                {
+                    continue;
+                }
+                const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
+                    - point.y - (Ly / float(2.0));
+                const float dy_wrapped = m_box.wrap(vec3<float>(0, dy, 0)).y;
+                bins_y.push_back((j + m_width.y) % m_width.y);
+                d_sq_y.push_back(dy_wrapped * dy_wrapped);
+                weight_y.push_back(std::exp(-dy_wrapped * dy_wrapped / (float(2.0) * sigmasq)));
+            }
+
+            bins_z.clear();
+            d_sq_z.clear();
+            weight_z.clear();
+            if (m_box.is2D())
+            {
+                // The direct evaluation's z displacement is identically
+                // zero in 2D, so the z axis contributes a unit weight.
+                bins_z.push_back(0);
+                d_sq_z.push_back(float(0.0));
+                weight_z.push_back(float(1.0));
+            }
+            else
+            {
+                for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+                {
+                    if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                    {
+                        continue;
+                    }
+                    const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0))
+                        - point.z - (Lz / float(2.0));
+                    const float dz_wrapped = m_box.wrap(vec3<float>(0, 0, dz)).z;
+                    bins_z.push_back((k + m_width.z) % m_width.z);
+                    d_sq_z.push_back(dz_wrapped * dz_wrapped);
+                    weight_z.push_back(std::exp(-dz_wrapped * dz_wrapped / (float(2.0) * sigmasq)));
+                }
+            }
+
+            // Combine the axis vectors by outer product, keeping the
+            // spherical support test of the direct evaluation. The z bin
+            // indexes the contiguous dimension of the density array, so
+            // it is the innermost loop.
+            for (size_t ii = 0; ii < bins_x.size(); ++ii)
+            {
+                for (size_t jj = 0; jj < bins_y.size(); ++jj)
+                {
+                    const float d_sq_xy = d_sq_x[ii] + d_sq_y[jj];
+                    const float weight_xy = value * normalization * weight_x[ii] * weight_y[jj];
+                    const size_t row = (size_t(bins_x[ii]) * m_width.y + bins_y[jj]) * m_width.z;
+                    for (size_t kk = 0; kk < bins_z.size(); ++kk)
+                    {
+                        if (d_sq_xy + d_sq_z[kk] < r_max_sq)
+                        {
+                            local_counts[row + bins_z[kk]] += weight_xy * weight_z[kk];
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    local_bin_counts.reduceInto(m_density_array);
+}
+
+namespace {
+//! In-place 3D FFT over a row-major (x, y, z) grid via 1D radix-2 passes.
+/*! Axes of length one (the z axis of 2D grids) are skipped. The line
+ *  transforms along each axis are independent, so they run in parallel.
+ */
+void fft3D(std::vector<std::complex<double>>& grid, const vec3<unsigned int>& width, bool inverse)
+{
+    const size_t nx = width.x;
+    const size_t ny = width.y;
+    const size_t nz = width.z;
+
+    if (nz > 1)
+    {
+        util::forLoopWrapper(0, nx * ny, [&](size_t begin, size_t end) {
+            std::vector<std::complex<double>> line(nz);
+            for (size_t row = begin; row < end; ++row)
+            {
+                const size_t base = row * nz;
+                std::copy(grid.begin() + base, grid.begin() + base + nz, line.begin());
+                util::fftRadix2(line, inverse);
+                std::copy(line.begin(), line.end(), grid.begin() + base);
+            }
+        });
+    }
+    if (ny > 1)
+    {
+        util::forLoopWrapper(0, nx * nz, [&](size_t begin, size_t end) {
+            std::vector<std::complex<double>> line(ny);
+            for (size_t col = begin; col < end; ++col)
+            {
+                const size_t base = (col / nz) * ny * nz + (col % nz);
+                for (size_t j = 0; j < ny; ++j)
+                {
+                    line[j] = grid[base + j * nz];
+                }
+                util::fftRadix2(line, inverse);
+                for (size_t j = 0; j < ny; ++j)
+                {
+                    grid[base + j * nz] = line[j];
+                }
+            }
+        });
+    }
+    if (nx > 1)
+    {
+        util::forLoopWrapper(0, ny * nz, [&](size_t begin, size_t end) {
+            std::vector<std::complex<double>> line(nx);
+            for (size_t col = begin; col < end; ++col)
+            {
+                for (size_t i = 0; i < nx; ++i)
+                {
+                    line[i] = grid[i * ny * nz + col];
+                }
+                util::fftRadix2(line, inverse);
+                for (size_t i = 0; i < nx; ++i)
+                {
+                    grid[i * ny * nz + col] = line[i];
+                }
+            }
+        });
+    }
+}
+} // namespace
+
+/*! Depositing each particle's value on its nearest grid point turns the
+ *  density into a circular convolution of the deposited grid with the
+ *  cutoff Gaussian sampled at cell-center displacements, and the circular
+ *  FFT convolution is exactly the periodic minimum-image sum. The
+ *  per-particle cost becomes independent of the cutoff and the grid cost
+ *  is O(W^3 log W), but particles act from their cell centers, so the
+ *  result carries a position quantization error of up to half a grid
+ *  spacing per axis.
+ */
+void GaussianDensity::computeFFT(const freud::locality::NeighborQuery* nq, const float* values)
+{
+    if (m_box.getTiltFactorXY() != float(0.0) || m_box.getTiltFactorXZ() != float(0.0)
+        || m_box.getTiltFactorYZ() != float(0.0))
+    {
+        throw std::invalid_argument("GaussianDensity FFT mode requires an orthorhombic box.");
+    }
+    const vec3<bool> periodic = m_box.getPeriodic();
+    if (!periodic.x || !periodic.y || (!m_box.is2D() && !periodic.z))
+    {
+        throw std::invalid_argument("GaussianDensity FFT mode requires a fully periodic box "
+                                    "because the convolution is circular.");
+    }
+    if (!util::isPowerOfTwo(m_width.x) || !util::isPowerOfTwo(m_width.y)
+        || (!m_box.is2D() && !util::isPowerOfTwo(m_width.z)))
+    {
+        throw std::invalid_argument("GaussianDensity FFT mode requires power-of-two grid widths.");
+    }
+
+    auto n_points = nq->getNPoints();
+
+    const float Lx = m_box.getLx();
+    const float Ly = m_box.getLy();
+    const float Lz = m_box.getLz();
+
+    const float grid_size_x = Lx / static_cast<float>(m_width.x);
+    const float grid_size_y = Ly / static_cast<float>(m_width.y);
+    const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
+
+    const float r_max_sq = m_r_max * m_r_max;
+    const float sigmasq = m_sigma * m_sigma;
+    const float normalization_base = float(1.0) / std::sqrt(constants::TWO_PI * sigmasq);
+    const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
+    const float normalization = std::pow(normalization_base, dimensions);
+
+    const size_t grid_size = size_t(m_width.x) * m_width.y * m_width.z;
+    std::vector<std::complex<double>> grid(grid_size);
+    std::vector<std::complex<double>> kernel(grid_size);
+
+    // Deposit each particle's value on its nearest grid point. The bin
+    // formula matches the direct evaluation; the double modulus folds
+    // points outside the primary image back into storage range.
+    for (size_t idx = 0; idx < n_points; ++idx)
+    {
+        const vec3<float> point = (*nq)[idx];
+        const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+        const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+        const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+        const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
+
+        const unsigned int ni = ((bin_x % int(m_width.x)) + m_width.x) % m_width.x;
+        const unsigned int nj = ((bin_y % int(m_width.y)) + m_width.y) % m_width.y;
+        const unsigned int nk = ((bin_z % int(m_width.z)) + m_width.z) % m_width.z;
+
+        grid[(size_t(ni) * m_width.y + nj) * m_width.z + nk] += value;
+    }
+
+    // Sample the cutoff Gaussian at minimum-image cell-center displacements.
+    util::forLoopWrapper(0, m_width.x, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float dx = m_box.wrap(vec3<float>(grid_size_x * static_cast<float>(i), 0, 0)).x;
+            for (size_t j = 0; j < m_width.y; ++j)
+            {
+                const float dy = m_box.wrap(vec3<float>(0, grid_size_y * static_cast<float>(j), 0)).y;
+                for (size_t k = 0; k < m_width.z; ++k)
+                {
+                    const float dz = m_box.is2D()
+                        ? float(0.0)
+                        : m_box.wrap(vec3<float>(0, 0, grid_size_z * static_cast<float>(k))).z;
+                    const float r_sq = dx * dx + dy * dy + dz * dz;
+                    if (r_sq < r_max_sq)
+                    {
+                        kernel[(i * m_width.y + j) * m_width.z + k]
+                            = normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
+                    }
+                }
+            }
+        }
+    });
+
+    // Convolve: transform both grids, multiply pointwise, transform back.
+    fft3D(grid, m_width, false);
+    fft3D(kernel, m_width, false);
+    util::forLoopWrapper(0, grid_size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            grid[i] *= kernel[i];
+        }
+    });
+    fft3D(grid, m_width, true);
+
+    util::forLoopWrapper(0, grid_size, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_density_array[i] = static_cast<float>(grid[i].real());
+        }
+    });
+}
+
 }; }; // end namespace freud::density
@@ -4,6 +4,8 @@
 #ifndef GAUSSIAN_DENSITY_H
 #define GAUSSIAN_DENSITY_H
 
+#include <string>
+
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
@@ -24,8 +26,29 @@ namespace freud { namespace density {
 class GaussianDensity
 {
 public:
+    //! Evaluation strategies for compute().
+    /*! All modes produce the same physical field; they trade generality for
+     *  speed. Direct is the reference evaluation and works for any box.
+     *  Separable exploits that the Gaussian factorizes into per-axis weight
+     *  vectors combined by outer product, reducing the exp() count per
+     *  particle from the full cutoff cube to one cutoff width per axis; it
+     *  requires an orthorhombic (zero tilt) box and agrees with Direct up to
+     *  floating point rounding. FFT deposits each particle's value on its
+     *  nearest grid point and convolves with the cutoff Gaussian in k-space,
+     *  making the per-particle cost independent of the cutoff; it requires a
+     *  periodic orthorhombic box and power-of-two grid widths, and snaps
+     *  particles to cell centers, so it carries a position quantization
+     *  error of up to half a grid spacing.
+     */
+    enum class Mode
+    {
+        Direct,
+        Separable,
+        FFT
+    };
+
     //! Constructor
-    GaussianDensity(vec3<unsigned int> width, float r_max, float sigma);
+    GaussianDensity(vec3<unsigned int> width, float r_max, float sigma, Mode mode = Mode::Direct);
 
     // Destructor
     ~GaussianDensity() = default;
@@ -51,16 +74,46 @@ public:
     //! Compute the density.
     void compute(const freud::locality::NeighborQuery* nq, const float* values = nullptr);
 
+    //! Compute the density in slabs, streaming each to a file.
+    /*! For grids too large for node RAM, the direct evaluation is run one
+     *  slab of the grid's slowest (x) dimension at a time, holding only
+     *  \a slab_width planes in memory, and each finished slab is appended
+     *  to \a filename, so resolution is bounded by disk rather than RAM
+     *  and the writes are sequential. Particles are bucketed by the slabs
+     *  their cutoff cube touches using the same bin assignment as the
+     *  in-memory path, and each slab fills in parallel from its bucket.
+     *  The file holds raw float32 values in the row-major (x, y, z) order
+     *  of getDensity(); no density array is retained in memory.
+     */
+    void computeToFile(const freud::locality::NeighborQuery* nq, const std::string& filename,
+                       unsigned int slab_width, const float* values = nullptr);
+
     //! Get a reference to the last computed density.
     const util::ManagedArray<float>& getDensity() const;
 
     vec3<unsigned int> getWidth();
 
+    //! Get the evaluation mode.
+    Mode getMode() const
+    {
+        return m_mode;
+    }
+
 private:
+    //! Reference evaluation: loop each particle over the full cutoff cube.
+    void computeDirect(const freud::locality::NeighborQuery* nq, const float* values);
+
+    //! Factorized per-axis Gaussian weights combined by outer product.
+    void computeSeparable(const freud::locality::NeighborQuery* nq, const float* values);
+
+    //! Nearest-grid-point deposition convolved with the kernel in k-space.
+    void computeFFT(const freud::locality::NeighborQuery* nq, const float* values);
+
     box::Box m_box;             //!< Simulation box containing the points.
     vec3<unsigned int> m_width; //!< Number of bins in the grid in each dimension.
     float m_r_max;              //!< Max distance at which to compute density.
     float m_sigma;              //!< Gaussian width sigma.
+    Mode m_mode;                //!< Evaluation strategy used by compute().
     bool m_has_computed;        //!< Tracks whether a call to compute has been made.
 
     util::ManagedArray<float> m_density_array; //! Computed density array.
@@ -1,8 +1,11 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+
 #include "LocalDensity.h"
 #include "NeighborComputeFunctional.h"
+#include "utils.h"
 
 /*! \file LocalDensity.cc
     \brief Routines for computing local density around a point.
@@ -67,4 +70,49 @@ void LocalDensity::compute(const freud::locality::NeighborQuery* neighbor_query,
         });
 }
 
+void LocalDensity::computeFromNlist(const box::Box& box, const freud::locality::NeighborList* nlist)
+{
+    m_box = box;
+
+    const unsigned int n_query_points = nlist->getNumQueryPoints();
+    m_density_array.prepare(n_query_points);
+    m_num_neighbors_array.prepare(n_query_points);
+
+    const float area = M_PI * m_r_max * m_r_max;
+    const float volume = static_cast<float>(4.0 / 3.0 * M_PI) * m_r_max * m_r_max * m_r_max;
+    const float normalization = m_box.is2D() ? area : volume;
+    const float half_diameter = m_diameter / float(2.0);
+
+    const float* const distances = nlist->getDistances().get();
+    const unsigned int* const segments = nlist->getSegments().get();
+    const unsigned int* const counts = nlist->getCounts().get();
+
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const size_t bond_begin = segments[i];
+            const size_t bond_end = bond_begin + counts[i];
+            float num_neighbors = 0;
+            for (size_t bond = bond_begin; bond < bond_end; ++bond)
+            {
+                const float distance = distances[bond];
+                // Same weighting as compute(): the min() collapses to the
+                // full count of 1 inside r_max - diameter / 2 and to the
+                // fractional overlap in the boundary band, value for value.
+                float weight = std::min(float(1.0),
+                                        float(1.0) + (m_r_max - (distance + half_diameter)) / m_diameter);
+                // A reused list may have been built with a larger r_max than
+                // this object's query radius of r_max + diameter / 2 (the
+                // distance at which the overlap vanishes); bonds past it
+                // contribute nothing, exactly as the ball query in compute()
+                // would not return them.
+                weight = (distance < m_r_max + half_diameter) ? weight : float(0.0);
+                num_neighbors += weight;
+            }
+            m_num_neighbors_array[i] = num_neighbors;
+            m_density_array[i] = num_neighbors / normalization;
+        }
+    });
+}
+
 }; }; // end namespace freud::density
@@ -51,6 +51,20 @@ public:
                  unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                  freud::locality::QueryArgs qargs);
 
+    //! Compute the local density by reusing an existing NeighborList.
+    /*! When another analysis (typically an RDF) has already built a
+     *  NeighborList with distances for the same frame, rerunning a ball
+     *  query here is pure redundancy. This entry point consumes the list
+     *  directly: each query point's bond segment is scanned with a
+     *  branchless weight — full count inside the cutoff, the usual
+     *  fractional overlap out to r_max + diameter / 2, zero beyond — so
+     *  lists built with a larger r_max than this object's query radius
+     *  are filtered correctly, and the
+     *  per-bond work is a lane loop over the contiguous distance stream
+     *  that the compiler vectorizes. Weights match compute() exactly.
+     */
+    void computeFromNlist(const box::Box& box, const freud::locality::NeighborList* nlist);
+
     //! Get a reference to the last computed density
     const util::ManagedArray<float>& getDensity() const
     {
@@ -1,9 +1,15 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
+#include <tbb/parallel_scan.h>
 
+#include "AABBQuery.h"
+#include "NeighborBond.h"
 #include "RDF.h"
+#include "utils.h"
 
 /*! \file RDF.cc
     \brief Routines for computing radial density functions.
@@ -11,8 +17,8 @@
 
 namespace freud { namespace density {
 
-RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
-    : BondHistogramCompute(), m_normalize(normalize)
+RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize, bool async_reduce)
+    : BondHistogramCompute(false, async_reduce), m_normalize(normalize)
 {
     if (bins == 0)
     {
@@ -74,24 +80,133 @@ void RDF::reduce()
         m_pcf[i] = m_histogram[i] * prefactor / vol_array[i];
     });
 
-    // The accumulation of the cumulative density must be performed in
-    // sequence, so it is done after the reduction.
+    // The cumulative density is an inclusive scan over the bin counts, which
+    // parallelizes with tbb::parallel_scan. The scan runs over the integer
+    // counts rather than the normalized float values, so the sums are exactly
+    // associative and the result is deterministic regardless of how the range
+    // is split across threads; each bin is then normalized with a single
+    // multiply in the final pass, which the compiler vectorizes.
     prefactor = float(1.0) / (np * static_cast<float>(m_frame_counter));
-    m_N_r[0] = m_histogram[0] * prefactor;
-    for (unsigned int i = 1; i < getAxisSizes()[0]; i++)
-    {
-        m_N_r[i] = m_N_r[i - 1] + m_histogram[i] * prefactor;
-    }
+    const size_t nbins = getAxisSizes()[0];
+    util::runInComputeArena([&]() {
+        tbb::parallel_scan(
+            tbb::blocked_range<size_t>(0, nbins), std::uint64_t(0),
+            [&](const tbb::blocked_range<size_t>& r, std::uint64_t sum,
+                bool is_final_scan) -> std::uint64_t {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    sum += m_histogram[i];
+                    if (is_final_scan)
+                    {
+                        m_N_r[i] = static_cast<float>(sum) * prefactor;
+                    }
+                }
+                return sum;
+            },
+            [](std::uint64_t left, std::uint64_t right) { return left + right; });
+    });
 }
 
 void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                      unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                      freud::locality::QueryArgs qargs)
 {
+    if (nlist != nullptr)
+    {
+        // Batched fast path: when a NeighborList is provided, its distances
+        // are a precomputed contiguous stream, so instead of funneling every
+        // bond through the per-bond functor we bin the stream in fixed-width
+        // batches. The batch body is a plain lane loop over contiguous
+        // floats that the compiler vectorizes (the structure-of-arrays
+        // pattern of vec3_batch in VectorMath.h); the per-lane arithmetic is
+        // exactly RegularAxis::bin, so the counts match the functor path bit
+        // for bit. The only branch per lane is the range check, and
+        // out-of-range lanes simply carry the overflow bin, which
+        // increment() discards like the scalar path does.
+        m_box = neighbor_query->getBox();
+        const auto bounds = getBounds()[0];
+        const float r_min = bounds.first;
+        const float r_max = bounds.second;
+        const size_t nbins = getAxisSizes()[0];
+        const float bin_width = (r_max - r_min) / static_cast<float>(nbins);
+        const float inverse_bin_width = static_cast<float>(1.0) / bin_width;
+        const float* const distances = nlist->getDistances().get();
+        util::forLoopWrapper(0, nlist->getNumBonds(), [&](size_t begin, size_t end) {
+            constexpr size_t batch_width = 8;
+            size_t bins[batch_width];
+            for (size_t bond = begin; bond < end; bond += batch_width)
+            {
+                const size_t count = std::min(batch_width, end - bond);
+                for (size_t lane = 0; lane < count; lane++)
+                {
+                    const float value = distances[bond + lane];
+                    if (value < r_min || value >= r_max)
+                    {
+                        bins[lane] = util::Axis::OVERFLOW_BIN;
+                        continue;
+                    }
+                    const float val = (value - r_min) * inverse_bin_width;
+                    // Truncation toward zero: identical to the fast
+                    // float-to-int conversion in RegularAxis::bin for the
+                    // non-negative in-range values that reach this point.
+                    size_t bin = static_cast<size_t>(val);
+                    // Avoid rounding leading to overflow.
+                    if (bin == nbins)
+                    {
+                        bin--;
+                    }
+                    bins[lane] = bin;
+                }
+                for (size_t lane = 0; lane < count; lane++)
+                {
+                    m_local_histograms.increment(bins[lane]);
+                }
+            }
+        });
+        finishFrame(neighbor_query, n_query_points);
+        return;
+    }
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
                       [=](const freud::locality::NeighborBond& neighbor_bond) {
                           m_local_histograms(neighbor_bond.distance);
                       });
 }
 
+void RDF::accumulateFrames(const box::Box* boxes, const vec3<float>* points, unsigned int n_frames,
+                           unsigned int n_points, freud::locality::QueryArgs qargs)
+{
+    if (n_frames == 0)
+    {
+        throw std::invalid_argument("RDF::accumulateFrames requires at least one frame.");
+    }
+
+    // Frames are independent, so the parallelism is over frames rather than
+    // over the bonds of each frame: every task builds its frame's AABB tree
+    // and drains the per-point neighbor iterators serially into the
+    // thread-local histograms. For trajectory-sized frame counts this keeps
+    // all threads busy even when each frame is small.
+    util::forLoopWrapper(0, n_frames, [&](size_t begin, size_t end) {
+        for (size_t frame = begin; frame < end; ++frame)
+        {
+            const vec3<float>* const frame_points = points + size_t(n_points) * frame;
+            const locality::AABBQuery nq(boxes[frame], frame_points, n_points);
+            auto iter = nq.query(frame_points, n_points, qargs);
+            for (unsigned int i = 0; i < n_points; ++i)
+            {
+                auto it = iter->query(i);
+                for (locality::NeighborBond nb = it->next(); !(nb == locality::ITERATOR_TERMINATOR);
+                     nb = it->next())
+                {
+                    m_local_histograms(nb.distance);
+                }
+            }
+        }
+    });
+
+    // The box retained for reduce() is the last frame's, as it would be
+    // after repeated accumulate calls.
+    m_box = boxes[n_frames - 1];
+    finishFrames(n_frames, n_points, n_points);
+}
+
 }; }; // end namespace freud::density
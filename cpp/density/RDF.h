@@ -17,7 +17,12 @@ class RDF : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    RDF(unsigned int bins, float r_max, float r_min = 0, bool normalize = false);
+    /*! \param async_reduce If true, each frame's thread-local counts are
+     *      drained in the background while the next frame accumulates (see
+     *      BondHistogramCompute).
+     */
+    RDF(unsigned int bins, float r_max, float r_min = 0, bool normalize = false,
+        bool async_reduce = false);
 
     //! Destructor
     ~RDF() override = default;
@@ -31,6 +36,20 @@ public:
                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    //! Accumulate a whole block of frames in one call.
+    /*! Equivalent to calling accumulate once per frame of the (n_frames,
+     * n_points, 3) position block with the matching box and the frame's own
+     * points as query points, but the build/query/bin pipeline for every
+     * frame runs inside this call: frames are distributed across threads,
+     * each task builds its frame's AABB tree and drains the neighbor
+     * iterators into the thread-local histograms, and the reduction happens
+     * once on the next property access. This removes the per-frame language
+     * binding and NeighborQuery construction overhead that dominates
+     * trajectory averaging for small systems.
+     */
+    void accumulateFrames(const box::Box* boxes, const vec3<float>* points, unsigned int n_frames,
+                          unsigned int n_points, freud::locality::QueryArgs qargs);
+
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
 
@@ -1,8 +1,13 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <fstream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "SphereVoxelization.h"
 
@@ -12,8 +17,9 @@
 
 namespace freud { namespace density {
 
-SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max)
-    : m_box(), m_width(width), m_r_max(r_max), m_has_computed(false)
+SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max, bool bit_packed)
+    : m_box(), m_width(width), m_r_max(r_max), m_bit_packed(bit_packed), m_has_computed(false),
+      m_voxels_unpacked(false)
 {
     if (r_max <= 0)
     {
@@ -24,9 +30,33 @@ SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max)
 //! Get a reference to the last computed voxels.
 const util::ManagedArray<unsigned int>& SphereVoxelization::getVoxels() const
 {
+    // In bit-packed mode the dense array is materialized lazily so that
+    // callers working from the packed words never pay for it.
+    if (m_bit_packed && !m_voxels_unpacked)
+    {
+        m_voxels_array.prepare({m_width.x, m_width.y, m_width.z});
+        const size_t n_voxels = m_voxels_array.size();
+        for (size_t f = 0; f < n_voxels; ++f)
+        {
+            m_voxels_array[f]
+                = static_cast<unsigned int>((m_voxel_words[f >> 6] >> (f & 63)) & std::uint64_t(1));
+        }
+        m_voxels_unpacked = true;
+    }
     return m_voxels_array;
 }
 
+//! Get a reference to the last computed packed voxel words.
+const util::ManagedArray<std::uint64_t>& SphereVoxelization::getVoxelWords() const
+{
+    if (!m_bit_packed)
+    {
+        throw std::runtime_error("SphereVoxelization only stores packed voxel words in "
+                                 "bit-packed mode.");
+    }
+    return m_voxel_words;
+}
+
 //! Get width.
 vec3<unsigned int> SphereVoxelization::getWidth() const
 {
@@ -49,8 +79,6 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
                                     "number of dimensions.");
     }
 
-    auto n_points = nq->getNPoints();
-
     // if the user gives a single number for width, but the nq box is 2D, and
     // we want a 2D calculation
     if (m_box.is2D())
@@ -58,6 +86,179 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
         m_width.z = 1;
     }
 
+    if (m_bit_packed)
+    {
+        m_voxels_unpacked = false;
+        computePacked(nq);
+    }
+    else
+    {
+        computeDense(nq);
+    }
+}
+
+/*! Runs the dense evaluation one slab of the slowest (x) dimension at a
+ *  time so that only slab_width planes of the mask are resident, and
+ *  appends each finished slab to the output file. Slabs along x are
+ *  contiguous runs of the row-major (x, y, z) array, so the file fills
+ *  with purely sequential writes. Particles are bucketed up front by the
+ *  slabs their cutoff range of x bins touches. The per-voxel membership
+ *  test is identical to the in-memory path; only the storage extent
+ *  changes.
+ */
+void SphereVoxelization::computeToFile(const freud::locality::NeighborQuery* nq, const std::string& filename,
+                                       unsigned int slab_width)
+{
+    if (!m_has_computed || nq->getBox().is2D() == m_box.is2D())
+    {
+        m_box = nq->getBox();
+        m_has_computed = true;
+    }
+    else
+    {
+        throw std::invalid_argument("The dimensionality of the box passed to SphereVoxelization has "
+                                    "changed. A new instance must be created to handle a different "
+                                    "number of dimensions.");
+    }
+    if (slab_width == 0)
+    {
+        throw std::invalid_argument("SphereVoxelization requires slab_width to be positive.");
+    }
+
+    if (m_box.is2D())
+    {
+        m_width.z = 1;
+    }
+
+    auto n_points = nq->getNPoints();
+
+    const float Lx = m_box.getLx();
+    const float Ly = m_box.getLy();
+    const float Lz = m_box.getLz();
+    const vec3<bool> periodic = m_box.getPeriodic();
+
+    const float grid_size_x = Lx / static_cast<float>(m_width.x);
+    const float grid_size_y = Ly / static_cast<float>(m_width.y);
+    const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
+
+    const int bin_cut_x = int(m_r_max / grid_size_x);
+    const int bin_cut_y = int(m_r_max / grid_size_y);
+    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    const float r_max_sq = m_r_max * m_r_max;
+
+    const unsigned int n_slabs = (m_width.x + slab_width - 1) / slab_width;
+
+    // Bucket particles by the slabs their cutoff range of x bins touches.
+    std::vector<std::vector<size_t>> slab_points(n_slabs);
+    std::vector<bool> touched(n_slabs);
+    for (size_t idx = 0; idx < n_points; ++idx)
+    {
+        const vec3<float> point = (*nq)[idx];
+        const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+        std::fill(touched.begin(), touched.end(), false);
+        for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+        {
+            if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+            {
+                continue;
+            }
+            touched[((i + m_width.x) % m_width.x) / slab_width] = true;
+        }
+        for (unsigned int slab = 0; slab < n_slabs; slab++)
+        {
+            if (touched[slab])
+            {
+                slab_points[slab].push_back(idx);
+            }
+        }
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("SphereVoxelization could not open " + filename + " for writing.");
+    }
+
+    util::ManagedArray<unsigned int> slab_array;
+    for (unsigned int slab = 0; slab < n_slabs; slab++)
+    {
+        const unsigned int x_start = slab * slab_width;
+        const unsigned int slab_w = std::min(slab_width, m_width.x - x_start);
+        slab_array.prepare({slab_w, m_width.y, m_width.z});
+        const auto& points_in_slab = slab_points[slab];
+
+        util::forLoopWrapper(0, points_in_slab.size(), [&](size_t begin, size_t end) {
+            for (size_t p = begin; p < end; ++p)
+            {
+                const size_t idx = points_in_slab[p];
+                const vec3<float> point = (*nq)[idx];
+                const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+                const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+                const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
+
+                for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+                {
+                    if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                    {
+                        continue;
+                    }
+                    const float dz = (grid_size_z * static_cast<float>(k)) + (grid_size_z / float(2.0))
+                        - point.z - (Lz / float(2.0));
+
+                    for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+                    {
+                        if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                        {
+                            continue;
+                        }
+                        const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
+                            - point.y - (Ly / float(2.0));
+
+                        for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+                        {
+                            if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                            {
+                                continue;
+                            }
+                            // Skip bins outside the current slab.
+                            const unsigned int ni = (i + m_width.x) % m_width.x;
+                            if (ni < x_start || ni >= x_start + slab_w)
+                            {
+                                continue;
+                            }
+                            const float dx = ((grid_size_x * static_cast<float>(i))
+                                              + (grid_size_x / 2.0f) - point.x - (Lx / float(2.0)));
+
+                            const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                            const float r_sq = dot(delta, delta);
+
+                            if (r_sq < r_max_sq)
+                            {
+                                const unsigned int nj = (j + m_width.y) % m_width.y;
+                                const unsigned int nk = (k + m_width.z) % m_width.z;
+                                // Safe across threads: all writers store the same value (1).
+                                slab_array(ni - x_start, nj, nk) = 1;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        file.write(reinterpret_cast<const char*>(slab_array.get()),
+                   static_cast<std::streamsize>(slab_array.size() * sizeof(unsigned int)));
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("SphereVoxelization failed while writing " + filename + ".");
+    }
+}
+
+void SphereVoxelization::computeDense(const freud::locality::NeighborQuery* nq)
+{
+    auto n_points = nq->getNPoints();
+
     m_voxels_array.prepare({m_width.x, m_width.y, m_width.z});
 
     // set up some constants first
@@ -141,4 +342,115 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
     });
 }
 
+/*! The per-voxel in/out test is the one from the dense evaluation; only
+ *  the storage changes. The loop nest is reordered so z — the contiguous
+ *  dimension of the grid — is innermost, and each scanline accumulates
+ *  its hits into a local word mask that is flushed with a single atomic
+ *  OR when the word index changes, so contended atomics happen per word
+ *  rather than per voxel. Since voxel membership is a pure OR, the
+ *  reordering produces exactly the mask the dense evaluation would.
+ */
+void SphereVoxelization::computePacked(const freud::locality::NeighborQuery* nq)
+{
+    auto n_points = nq->getNPoints();
+
+    const size_t n_voxels = size_t(m_width.x) * m_width.y * m_width.z;
+    const size_t n_words = (n_voxels + 63) / 64;
+
+    // Scratch words with atomic OR writes; value-initialization zeroes them.
+    std::vector<std::atomic<std::uint64_t>> words(n_words);
+
+    const float Lx = m_box.getLx();
+    const float Ly = m_box.getLy();
+    const float Lz = m_box.getLz();
+    const vec3<bool> periodic = m_box.getPeriodic();
+
+    const float grid_size_x = Lx / static_cast<float>(m_width.x);
+    const float grid_size_y = Ly / static_cast<float>(m_width.y);
+    const float grid_size_z = m_box.is2D() ? 0 : Lz / static_cast<float>(m_width.z);
+
+    const int bin_cut_x = int(m_r_max / grid_size_x);
+    const int bin_cut_y = int(m_r_max / grid_size_y);
+    const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
+    const float r_max_sq = m_r_max * m_r_max;
+
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const vec3<float> point = (*nq)[idx];
+            const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+            const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+            const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
+
+            for (int i = bin_x - bin_cut_x; i <= bin_x + bin_cut_x; i++)
+            {
+                if (!periodic.x && (i < 0 || i >= int(m_width.x)))
+                {
+                    continue;
+                }
+                const float dx = ((grid_size_x * static_cast<float>(i)) + (grid_size_x / 2.0f)
+                                  - point.x - (Lx / float(2.0)));
+                const unsigned int ni = (i + m_width.x) % m_width.x;
+
+                for (int j = bin_y - bin_cut_y; j <= bin_y + bin_cut_y; j++)
+                {
+                    if (!periodic.y && (j < 0 || j >= int(m_width.y)))
+                    {
+                        continue;
+                    }
+                    const float dy = (grid_size_y * static_cast<float>(j)) + (grid_size_y / float(2.0))
+                        - point.y - (Ly / float(2.0));
+                    const unsigned int nj = (j + m_width.y) % m_width.y;
+
+                    const size_t row = (size_t(ni) * m_width.y + nj) * m_width.z;
+                    size_t cur_word = n_words; // sentinel: no word pending
+                    std::uint64_t mask = 0;
+
+                    for (int k = bin_z - bin_cut_z; k <= bin_z + bin_cut_z; k++)
+                    {
+                        if (!periodic.z && (k < 0 || k >= int(m_width.z)))
+                        {
+                            continue;
+                        }
+                        const float dz = (grid_size_z * static_cast<float>(k))
+                            + (grid_size_z / float(2.0)) - point.z - (Lz / float(2.0));
+
+                        const vec3<float> delta = m_box.wrap(vec3<float>(dx, dy, dz));
+                        const float r_sq = dot(delta, delta);
+
+                        if (r_sq < r_max_sq)
+                        {
+                            const unsigned int nk = (k + m_width.z) % m_width.z;
+                            const size_t f = row + nk;
+                            const size_t word = f >> 6;
+                            if (word != cur_word)
+                            {
+                                if (cur_word != n_words)
+                                {
+                                    words[cur_word].fetch_or(mask, std::memory_order_relaxed);
+                                }
+                                cur_word = word;
+                                mask = 0;
+                            }
+                            mask |= std::uint64_t(1) << (f & 63);
+                        }
+                    }
+                    if (cur_word != n_words)
+                    {
+                        words[cur_word].fetch_or(mask, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+    });
+
+    m_voxel_words.prepare({static_cast<unsigned int>(n_words)});
+    util::forLoopWrapper(0, n_words, [&](size_t begin, size_t end) {
+        for (size_t w = begin; w < end; ++w)
+        {
+            m_voxel_words[w] = words[w].load(std::memory_order_relaxed);
+        }
+    });
+}
+
 }; }; // end namespace freud::density
@@ -4,6 +4,9 @@
 #ifndef SPHERE_VOXELIZATION_H
 #define SPHERE_VOXELIZATION_H
 
+#include <cstdint>
+#include <string>
+
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
@@ -27,7 +30,14 @@ class SphereVoxelization
 {
 public:
     //! Constructor
-    SphereVoxelization(vec3<unsigned int> width, float r_max);
+    /*! When \a bit_packed is true, compute() stores the in/out mask as 64
+     *  voxels per word instead of one unsigned int per voxel, cutting the
+     *  grid memory by 32x; resolution on large void-analysis grids is
+     *  capped by memory, not compute. The packed words are available
+     *  through getVoxelWords(), and getVoxels() still works by unpacking
+     *  into the dense array lazily on first access.
+     */
+    SphereVoxelization(vec3<unsigned int> width, float r_max, bool bit_packed = false);
 
     // Destructor
     ~SphereVoxelization() = default;
@@ -47,18 +57,58 @@ public:
     //! Compute the voxelization.
     void compute(const freud::locality::NeighborQuery* nq);
 
+    //! Compute the voxelization in slabs, streaming each to a file.
+    /*! For grids too large for node RAM, the mask is computed one slab of
+     *  the grid's slowest (x) dimension at a time, holding only
+     *  \a slab_width planes in memory, and each finished slab is appended
+     *  to \a filename sequentially, so resolution is bounded by disk
+     *  rather than RAM. Particles are bucketed by the slabs their cutoff
+     *  range of x bins touches using the same bin assignment as the
+     *  in-memory path. The file holds raw 0/1 unsigned int values in the
+     *  row-major (x, y, z) order of getVoxels(); no voxel array is
+     *  retained in memory.
+     */
+    void computeToFile(const freud::locality::NeighborQuery* nq, const std::string& filename,
+                       unsigned int slab_width);
+
     //! Get a reference to the last computed voxels.
+    /*! In bit-packed mode this unpacks the words into the dense array on
+     *  first access; callers that only need the packed words should use
+     *  getVoxelWords() to avoid materializing the 32-bit grid.
+     */
     const util::ManagedArray<unsigned int>& getVoxels() const;
 
+    //! Whether compute() stores the mask bit-packed.
+    bool isBitPacked() const
+    {
+        return m_bit_packed;
+    }
+
+    //! Get a reference to the last computed packed voxel words.
+    /*! Voxels are packed 64 per word in flat row-major (x, y, z) order:
+     *  voxel index f lives in bit (f % 64) of word (f / 64). Only valid
+     *  in bit-packed mode.
+     */
+    const util::ManagedArray<std::uint64_t>& getVoxelWords() const;
+
     vec3<unsigned int> getWidth() const;
 
 private:
+    //! Dense evaluation writing one unsigned int per voxel.
+    void computeDense(const freud::locality::NeighborQuery* nq);
+
+    //! Bit-packed evaluation accumulating word masks along z scanlines.
+    void computePacked(const freud::locality::NeighborQuery* nq);
+
     box::Box m_box;             //!< Simulation box containing the points.
     vec3<unsigned int> m_width; //!< Number of bins in the grid in each dimension.
     float m_r_max;              //!< Sphere radius used for voxelization.
+    bool m_bit_packed;          //!< Whether the mask is stored 64 voxels per word.
     bool m_has_computed;        //!< Tracks whether a call to compute has been made.
 
-    util::ManagedArray<unsigned int> m_voxels_array; //! Computed voxels array.
+    mutable util::ManagedArray<unsigned int> m_voxels_array; //! Computed voxels array.
+    mutable bool m_voxels_unpacked; //!< Whether m_voxels_array holds the packed result.
+    util::ManagedArray<std::uint64_t> m_voxel_words; //! Packed voxels, 64 per word.
 };
 
 }; }; // end namespace freud::density
@@ -0,0 +1,238 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "IntermediateScattering.h"
+#include "utils.h"
+
+/*! \file IntermediateScattering.cc
+    \brief Compute intermediate scattering functions F(k, t) and F_s(k, t)
+           from streamed frames.
+*/
+
+namespace freud { namespace diffraction {
+
+namespace {
+
+//! Particles per block in the phase evaluation inner loop.
+/*! As in StaticStructureFactorDirect, the phases k.r for a block are staged
+ *  into a small buffer so the transcendental evaluations form a tight loop
+ *  over plain floats that the compiler can vectorize.
+ */
+constexpr unsigned int PHASE_BLOCK_SIZE = 256;
+
+} // namespace
+
+IntermediateScattering::IntermediateScattering(unsigned int block_size, unsigned int num_levels)
+    : m_block_size(block_size), m_num_levels(num_levels)
+{
+    if (block_size < 2 || block_size % 2 != 0)
+    {
+        throw std::invalid_argument("IntermediateScattering requires an even block size of at least 2.");
+    }
+    if (num_levels == 0)
+    {
+        throw std::invalid_argument("IntermediateScattering requires at least one correlator level.");
+    }
+}
+
+void IntermediateScattering::accumulate(const vec3<float>* k_points, unsigned int num_k_points,
+                                        const vec3<float>* points, unsigned int num_points)
+{
+    if (num_k_points == 0 || num_points == 0)
+    {
+        throw std::invalid_argument("IntermediateScattering requires at least one k-vector and point.");
+    }
+    if (m_frame_counter == 0)
+    {
+        m_num_k_points = num_k_points;
+        m_num_points = num_points;
+        const size_t slots(size_t(m_block_size) * num_k_points);
+        m_levels.assign(m_num_levels, CorrelatorLevel());
+        for (auto& level : m_levels)
+        {
+            level.rho.assign(slots, std::complex<double>(0));
+            level.phase_real.assign(slots * num_points, 0.0F);
+            level.phase_imag.assign(slots * num_points, 0.0F);
+            level.coherent.assign(slots, std::complex<double>(0));
+            level.self_part.assign(slots, std::complex<double>(0));
+            level.counts.assign(m_block_size, 0);
+            level.head = m_block_size - 1;
+            level.filled = 0;
+        }
+    }
+    else if (num_k_points != m_num_k_points || num_points != m_num_points)
+    {
+        throw std::invalid_argument("The k-vectors and particle count must not change between "
+                                    "accumulated frames; call reset() first.");
+    }
+
+    // Evaluate this frame's phase factors exp(i k.r_j) directly into the
+    // level-0 history slot; coarser levels copy the finished slot below.
+    CorrelatorLevel& base = m_levels[0];
+    base.head = (base.head + 1) % m_block_size;
+    const size_t phase_slot(size_t(base.head) * m_num_k_points * m_num_points);
+    util::forLoopWrapper(0, m_num_k_points, [&](size_t begin, size_t end) {
+        float thetas[PHASE_BLOCK_SIZE];
+        for (size_t k_idx = begin; k_idx < end; ++k_idx)
+        {
+            const vec3<float> k = k_points[k_idx];
+            float* const slot_real = base.phase_real.data() + phase_slot + k_idx * m_num_points;
+            float* const slot_imag = base.phase_imag.data() + phase_slot + k_idx * m_num_points;
+            double cos_sum(0);
+            double sin_sum(0);
+            for (unsigned int block_start = 0; block_start < m_num_points;
+                 block_start += PHASE_BLOCK_SIZE)
+            {
+                const unsigned int block_end = std::min(block_start + PHASE_BLOCK_SIZE, m_num_points);
+                for (unsigned int i = block_start; i < block_end; ++i)
+                {
+                    thetas[i - block_start] = dot(k, points[i]);
+                }
+                for (unsigned int i = 0; i < block_end - block_start; ++i)
+                {
+                    const float cos_theta = std::cos(thetas[i]);
+                    const float sin_theta = std::sin(thetas[i]);
+                    slot_real[block_start + i] = cos_theta;
+                    slot_imag[block_start + i] = sin_theta;
+                    cos_sum += cos_theta;
+                    sin_sum += sin_theta;
+                }
+            }
+            base.rho[size_t(base.head) * m_num_k_points + k_idx]
+                = std::complex<double>(cos_sum, sin_sum);
+        }
+    });
+    base.filled = std::min(base.filled + 1, m_block_size);
+    correlateLevel(base, 0);
+
+    for (unsigned int level_idx = 1; level_idx < m_num_levels; ++level_idx)
+    {
+        // Level l samples every 2^l-th frame; a frame not divisible by 2^l
+        // is not divisible by any higher power either.
+        if (m_frame_counter % (1U << level_idx) != 0)
+        {
+            break;
+        }
+        CorrelatorLevel& level = m_levels[level_idx];
+        level.head = (level.head + 1) % m_block_size;
+        const size_t level_slot(size_t(level.head) * m_num_k_points * m_num_points);
+        std::copy(base.phase_real.begin() + phase_slot,
+                  base.phase_real.begin() + phase_slot + size_t(m_num_k_points) * m_num_points,
+                  level.phase_real.begin() + level_slot);
+        std::copy(base.phase_imag.begin() + phase_slot,
+                  base.phase_imag.begin() + phase_slot + size_t(m_num_k_points) * m_num_points,
+                  level.phase_imag.begin() + level_slot);
+        std::copy(base.rho.begin() + size_t(base.head) * m_num_k_points,
+                  base.rho.begin() + size_t(base.head + 1) * m_num_k_points,
+                  level.rho.begin() + size_t(level.head) * m_num_k_points);
+        level.filled = std::min(level.filled + 1, m_block_size);
+        correlateLevel(level, level_idx);
+    }
+
+    ++m_frame_counter;
+    m_reduce = true;
+}
+
+void IntermediateScattering::correlateLevel(CorrelatorLevel& level, unsigned int level_idx)
+{
+    // Level 0 covers every lag it can reach; coarser levels only cover lags
+    // from block_size / 2 up, since shorter ones are sampled more finely by
+    // the level below.
+    const unsigned int lag_begin = (level_idx == 0) ? 0 : m_block_size / 2;
+    const unsigned int lag_end = level.filled;
+    if (lag_begin >= lag_end)
+    {
+        return;
+    }
+    for (unsigned int lag = lag_begin; lag < lag_end; ++lag)
+    {
+        ++level.counts[lag];
+    }
+
+    util::forLoopWrapper(0, m_num_k_points, [&](size_t begin, size_t end) {
+        for (size_t k_idx = begin; k_idx < end; ++k_idx)
+        {
+            const std::complex<double> rho_now = level.rho[size_t(level.head) * m_num_k_points + k_idx];
+            const size_t now_offset
+                = (size_t(level.head) * m_num_k_points + k_idx) * m_num_points;
+            const float* const now_real = level.phase_real.data() + now_offset;
+            const float* const now_imag = level.phase_imag.data() + now_offset;
+            for (unsigned int lag = lag_begin; lag < lag_end; ++lag)
+            {
+                const unsigned int prev = (level.head + m_block_size - lag) % m_block_size;
+                level.coherent[size_t(lag) * m_num_k_points + k_idx]
+                    += rho_now * std::conj(level.rho[size_t(prev) * m_num_k_points + k_idx]);
+
+                const size_t prev_offset = (size_t(prev) * m_num_k_points + k_idx) * m_num_points;
+                const float* const old_real = level.phase_real.data() + prev_offset;
+                const float* const old_imag = level.phase_imag.data() + prev_offset;
+                double dot_real(0);
+                double dot_imag(0);
+                // exp(i k.r_j(t)) * conj(exp(i k.r_j(t0))), summed over
+                // particles as a lane loop over the contiguous phase streams.
+                for (unsigned int i = 0; i < m_num_points; ++i)
+                {
+                    dot_real += double(now_real[i]) * double(old_real[i])
+                        + double(now_imag[i]) * double(old_imag[i]);
+                    dot_imag += double(now_imag[i]) * double(old_real[i])
+                        - double(now_real[i]) * double(old_imag[i]);
+                }
+                level.self_part[size_t(lag) * m_num_k_points + k_idx]
+                    += std::complex<double>(dot_real, dot_imag);
+            }
+        }
+    });
+}
+
+void IntermediateScattering::reduce()
+{
+    // Enumerate the lags that have accumulated at least one time origin.
+    // Levels produce disjoint, increasing lag ranges, so level-major order
+    // is already sorted by time.
+    std::vector<unsigned int> entry_levels;
+    std::vector<unsigned int> entry_lags;
+    for (unsigned int level_idx = 0; level_idx < m_num_levels; ++level_idx)
+    {
+        for (unsigned int lag = 0; lag < m_block_size; ++lag)
+        {
+            if (m_levels[level_idx].counts[lag] != 0)
+            {
+                entry_levels.push_back(level_idx);
+                entry_lags.push_back(lag);
+            }
+        }
+    }
+    const auto num_lags = static_cast<unsigned int>(entry_lags.size());
+    m_lag_times.prepare(num_lags);
+    m_fkt.prepare({num_lags, m_num_k_points});
+    m_self_fkt.prepare({num_lags, m_num_k_points});
+
+    for (unsigned int row = 0; row < num_lags; ++row)
+    {
+        const CorrelatorLevel& level = m_levels[entry_levels[row]];
+        const unsigned int lag = entry_lags[row];
+        m_lag_times[row] = lag << entry_levels[row];
+        const double norm
+            = 1.0 / (static_cast<double>(level.counts[lag]) * static_cast<double>(m_num_points));
+        for (unsigned int k_idx = 0; k_idx < m_num_k_points; ++k_idx)
+        {
+            m_fkt(row, k_idx) = static_cast<float>(
+                level.coherent[size_t(lag) * m_num_k_points + k_idx].real() * norm);
+            m_self_fkt(row, k_idx) = static_cast<float>(
+                level.self_part[size_t(lag) * m_num_k_points + k_idx].real() * norm);
+        }
+    }
+}
+
+void IntermediateScattering::reset()
+{
+    m_frame_counter = 0;
+    m_levels.clear();
+    m_reduce = true;
+}
+
+}; }; // end namespace freud::diffraction
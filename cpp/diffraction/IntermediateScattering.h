@@ -0,0 +1,154 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef INTERMEDIATE_SCATTERING_H
+#define INTERMEDIATE_SCATTERING_H
+
+#include <complex>
+#include <vector>
+
+#include "ManagedArray.h"
+#include "VectorMath.h"
+
+/*! \file IntermediateScattering.h
+    \brief Compute intermediate scattering functions F(k, t) and F_s(k, t)
+           from streamed frames.
+*/
+
+namespace freud { namespace diffraction {
+
+//! Time correlations of rho(k) over streamed frames with multi-tau blocking.
+/*! This class maintains the Fourier components of the density,
+ *
+ *      rho(k, t) = sum_j exp(i k.r_j(t)),
+ *
+ *  for a fixed set of k-vectors as frames are streamed through accumulate(),
+ *  and evaluates the coherent and self (incoherent) intermediate scattering
+ *  functions
+ *
+ *      F(k, t)   = < rho(k, t0 + t) rho*(k, t0) > / N
+ *      F_s(k, t) = < sum_j exp(i k.(r_j(t0 + t) - r_j(t0))) > / N
+ *
+ *  averaged over all available time origins t0. The t = 0 row of F(k, t)
+ *  is S(k).
+ *
+ *  Lags are sampled with the standard multi-tau (order-n) blocking scheme:
+ *  correlator level l sees every 2^l-th frame and keeps a circular history
+ *  of the last block_size samples, so level 0 covers lags 0 to
+ *  block_size - 1 in single frames while each coarser level doubles the
+ *  spacing, giving logarithmic coverage out to block_size * 2^(num_levels-1)
+ *  frames at fixed memory. The self part requires the per-particle phase
+ *  factors at every buffered sample, so memory grows as
+ *  num_levels * block_size * num_k_points * num_points single-precision
+ *  complex values; size the k-set and history depth accordingly.
+ *
+ *  Phase evaluation is parallel over k-vectors, with k.r staged into small
+ *  blocks so the sin/cos evaluations form tight vectorizable loops. The
+ *  k-vectors and the particle count must not change between accumulated
+ *  frames, and particle order must be consistent for the self part to be
+ *  meaningful.
+ */
+class IntermediateScattering
+{
+public:
+    //! Constructor.
+    /*! \param block_size Samples buffered per correlator level. Must be even
+     *             and at least 2; lags at level l > 0 span block_size / 2 to
+     *             block_size - 1 in units of 2^l frames.
+     *  \param num_levels Number of correlator levels.
+     */
+    IntermediateScattering(unsigned int block_size, unsigned int num_levels);
+
+    //! Accumulate one frame into the time correlations.
+    /*! \param k_points The k-vectors at which to evaluate rho(k).
+     *  \param num_k_points The number of k-vectors.
+     *  \param points The points of the frame, in a consistent order.
+     *  \param num_points The number of points.
+     */
+    void accumulate(const vec3<float>* k_points, unsigned int num_k_points, const vec3<float>* points,
+                    unsigned int num_points);
+
+    //! Discard all accumulated frames.
+    void reset();
+
+    //! Get the sampled lag times in frames, in increasing order.
+    const util::ManagedArray<unsigned int>& getLagTimes()
+    {
+        reduceIfNeeded();
+        return m_lag_times;
+    }
+
+    //! Get F(k, t) of shape (num_lags, num_k_points).
+    const util::ManagedArray<float>& getFkt()
+    {
+        reduceIfNeeded();
+        return m_fkt;
+    }
+
+    //! Get F_s(k, t) of shape (num_lags, num_k_points).
+    const util::ManagedArray<float>& getSelfFkt()
+    {
+        reduceIfNeeded();
+        return m_self_fkt;
+    }
+
+    unsigned int getBlockSize() const
+    {
+        return m_block_size;
+    }
+
+    unsigned int getNumLevels() const
+    {
+        return m_num_levels;
+    }
+
+    unsigned int getFrameCounter() const
+    {
+        return m_frame_counter;
+    }
+
+private:
+    //! History and running correlation sums for one multi-tau level.
+    struct CorrelatorLevel
+    {
+        std::vector<std::complex<double>> rho;      //!< (block_size, num_k) rho(k) history
+        std::vector<float> phase_real;              //!< (block_size, num_k, N) Re exp(i k.r_j)
+        std::vector<float> phase_imag;              //!< (block_size, num_k, N) Im exp(i k.r_j)
+        std::vector<std::complex<double>> coherent; //!< (block_size, num_k) coherent lag sums
+        std::vector<std::complex<double>> self_part; //!< (block_size, num_k) self lag sums
+        std::vector<unsigned long long> counts;     //!< Time origins accumulated per lag
+        unsigned int head {0};                      //!< Circular slot of the newest sample
+        unsigned int filled {0};                    //!< Samples currently buffered
+    };
+
+    //! Correlate a level's newest sample against its buffered history.
+    void correlateLevel(CorrelatorLevel& level, unsigned int level_idx);
+
+    //! Assemble the output arrays from the lag accumulators.
+    void reduce();
+
+    void reduceIfNeeded()
+    {
+        if (m_reduce)
+        {
+            reduce();
+            m_reduce = false;
+        }
+    }
+
+    unsigned int m_block_size;            //!< Samples buffered per level
+    unsigned int m_num_levels;            //!< Number of correlator levels
+    unsigned int m_num_k_points {0};      //!< Number of k-vectors (fixed at first frame)
+    unsigned int m_num_points {0};        //!< Number of points (fixed at first frame)
+    unsigned int m_frame_counter {0};     //!< Number of accumulated frames
+    bool m_reduce {true};                 //!< Whether the outputs need reassembly
+    std::vector<CorrelatorLevel> m_levels; //!< Multi-tau correlator levels
+
+    util::ManagedArray<unsigned int> m_lag_times; //!< Sampled lag times in frames
+    util::ManagedArray<float> m_fkt;              //!< F(k, t), shape (num_lags, num_k)
+    util::ManagedArray<float> m_self_fkt;         //!< F_s(k, t), shape (num_lags, num_k)
+};
+
+}; }; // end namespace freud::diffraction
+
+#endif // INTERMEDIATE_SCATTERING_H
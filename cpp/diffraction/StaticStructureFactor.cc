@@ -0,0 +1,181 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "FFT.h"
+#include "StaticStructureFactor.h"
+#include "utils.h"
+
+/*! \file StaticStructureFactor.cc
+    \brief Compute the static structure factor S(k) of a set of points.
+*/
+
+namespace freud { namespace diffraction {
+
+namespace {
+
+//! Particles per block in the direct-summation inner loop.
+/*! The phases k.r for a block are staged into a small buffer first so the
+ *  transcendental evaluations form a tight loop over plain floats, which
+ *  the compiler can vectorize; the buffer stays resident in L1.
+ */
+constexpr unsigned int PHASE_BLOCK_SIZE = 256;
+
+} // namespace
+
+void StaticStructureFactorDirect::accumulate(const vec3<float>* k_points, unsigned int num_k_points,
+                                             const vec3<float>* points, unsigned int num_points)
+{
+    if (num_k_points == 0 || num_points == 0)
+    {
+        throw std::invalid_argument("StaticStructureFactorDirect requires at least one k-vector and point.");
+    }
+    if (m_frame_counter == 0)
+    {
+        m_sk_accumulator.assign(num_k_points, 0.0);
+        m_structure_factor.prepare(num_k_points);
+    }
+    else if (m_sk_accumulator.size() != num_k_points)
+    {
+        throw std::invalid_argument(
+            "The set of k-vectors must not change between accumulated frames; call reset() first.");
+    }
+
+    util::forLoopWrapper(0, num_k_points, [&](size_t begin, size_t end) {
+        float thetas[PHASE_BLOCK_SIZE];
+        for (size_t k_idx = begin; k_idx < end; ++k_idx)
+        {
+            const vec3<float> k = k_points[k_idx];
+            double cos_sum(0);
+            double sin_sum(0);
+            for (unsigned int block_start = 0; block_start < num_points; block_start += PHASE_BLOCK_SIZE)
+            {
+                const unsigned int block_end
+                    = std::min(block_start + PHASE_BLOCK_SIZE, num_points);
+                for (unsigned int i = block_start; i < block_end; ++i)
+                {
+                    thetas[i - block_start] = dot(k, points[i]);
+                }
+                for (unsigned int i = 0; i < block_end - block_start; ++i)
+                {
+                    cos_sum += std::cos(thetas[i]);
+                    sin_sum += std::sin(thetas[i]);
+                }
+            }
+            m_sk_accumulator[k_idx]
+                += (cos_sum * cos_sum + sin_sum * sin_sum) / static_cast<double>(num_points);
+        }
+    });
+    ++m_frame_counter;
+
+    const double norm(1.0 / static_cast<double>(m_frame_counter));
+    util::forLoopWrapper(0, num_k_points, [&](size_t begin, size_t end) {
+        for (size_t k_idx = begin; k_idx < end; ++k_idx)
+        {
+            m_structure_factor[k_idx] = static_cast<float>(m_sk_accumulator[k_idx] * norm);
+        }
+    });
+}
+
+void StaticStructureFactorDirect::reset()
+{
+    m_frame_counter = 0;
+    m_sk_accumulator.clear();
+}
+
+StaticStructureFactorGrid::StaticStructureFactorGrid(unsigned int grid_size) : m_grid_size(grid_size)
+{
+    if (!util::isPowerOfTwo(grid_size))
+    {
+        throw std::invalid_argument(
+            "StaticStructureFactorGrid requires a power-of-two grid size for the radix-2 FFT.");
+    }
+}
+
+void StaticStructureFactorGrid::accumulate(const box::Box& box, const vec3<float>* points,
+                                           unsigned int num_points)
+{
+    if (num_points == 0)
+    {
+        throw std::invalid_argument("StaticStructureFactorGrid requires at least one point.");
+    }
+    const size_t g(m_grid_size);
+    const size_t num_cells(g * g * g);
+    if (m_frame_counter == 0)
+    {
+        m_sk_accumulator.assign(num_cells, 0.0);
+        m_structure_factor.prepare({g, g, g});
+    }
+
+    // Assign particles to the mesh by nearest grid point in fractional
+    // coordinates. The binning is a serial memory-bound pass; the FFTs
+    // below dominate the runtime.
+    std::vector<std::complex<double>> mesh(num_cells, std::complex<double>(0));
+    const auto wrapped_index = [&](float fraction) {
+        const int index = static_cast<int>(std::floor(fraction * static_cast<float>(g) + 0.5F));
+        return static_cast<size_t>(util::modulusPositive(index, static_cast<int>(g)));
+    };
+    for (unsigned int i = 0; i < num_points; ++i)
+    {
+        const vec3<float> fractional = box.makeFractional(points[i]);
+        const size_t ix = wrapped_index(fractional.x);
+        const size_t iy = wrapped_index(fractional.y);
+        const size_t iz = wrapped_index(fractional.z);
+        mesh[(ix * g + iy) * g + iz] += 1.0;
+    }
+
+    // 3D FFT as g^2 one-dimensional transforms along each axis in turn.
+    // Lines are independent, so each axis parallelizes over lines with a
+    // per-thread scratch buffer.
+    const auto transform_axis = [&](size_t stride, const std::function<size_t(size_t)>& line_start) {
+        util::forLoopWrapper(0, g * g, [&](size_t begin, size_t end) {
+            std::vector<std::complex<double>> line(g);
+            for (size_t line_idx = begin; line_idx < end; ++line_idx)
+            {
+                const size_t base = line_start(line_idx);
+                for (size_t i = 0; i < g; ++i)
+                {
+                    line[i] = mesh[base + i * stride];
+                }
+                util::fftRadix2(line, false);
+                for (size_t i = 0; i < g; ++i)
+                {
+                    mesh[base + i * stride] = line[i];
+                }
+            }
+        });
+    };
+    transform_axis(1, [&](size_t line_idx) { return line_idx * g; });                              // z
+    transform_axis(g, [&](size_t line_idx) { return (line_idx / g) * g * g + (line_idx % g); });   // y
+    transform_axis(g * g, [&](size_t line_idx) { return line_idx; });                              // x
+
+    util::forLoopWrapper(0, num_cells, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            m_sk_accumulator[cell] += std::norm(mesh[cell]) / static_cast<double>(num_points);
+        }
+    });
+    ++m_frame_counter;
+
+    const double norm(1.0 / static_cast<double>(m_frame_counter));
+    util::forLoopWrapper(0, num_cells, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            m_structure_factor[cell] = static_cast<float>(m_sk_accumulator[cell] * norm);
+        }
+    });
+}
+
+void StaticStructureFactorGrid::reset()
+{
+    m_frame_counter = 0;
+    m_sk_accumulator.clear();
+}
+
+}; }; // end namespace freud::diffraction
@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef STATIC_STRUCTURE_FACTOR_H
+#define STATIC_STRUCTURE_FACTOR_H
+
+#include <vector>
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "VectorMath.h"
+
+/*! \file StaticStructureFactor.h
+    \brief Compute the static structure factor S(k) of a set of points.
+*/
+
+namespace freud { namespace diffraction {
+
+//! Compute S(k) by direct summation of exp(i k.r) over particles.
+/*! For each provided k-vector this class evaluates
+ *
+ *      S(k) = |sum_j exp(i k.r_j)|^2 / N
+ *
+ *  in parallel over k-vectors, so fine k-grids scale across cores. Results
+ *  are averaged over all frames passed to accumulate() since the last
+ *  reset(), which allows trajectory averages without holding more than one
+ *  frame in memory. The set of k-vectors must not change between
+ *  accumulated frames.
+ */
+class StaticStructureFactorDirect
+{
+public:
+    StaticStructureFactorDirect() = default;
+
+    //! Accumulate one frame into the structure factor.
+    /*! \param k_points The k-vectors at which to evaluate S(k).
+     *  \param num_k_points The number of k-vectors.
+     *  \param points The points of the frame.
+     *  \param num_points The number of points.
+     */
+    void accumulate(const vec3<float>* k_points, unsigned int num_k_points, const vec3<float>* points,
+                    unsigned int num_points);
+
+    //! Discard all accumulated frames.
+    void reset();
+
+    //! Get S(k) averaged over accumulated frames, one value per k-vector.
+    const util::ManagedArray<float>& getStructureFactor() const
+    {
+        return m_structure_factor;
+    }
+
+    unsigned int getFrameCounter() const
+    {
+        return m_frame_counter;
+    }
+
+private:
+    util::ManagedArray<float> m_structure_factor; //!< S(k) averaged over frames
+    std::vector<double> m_sk_accumulator;         //!< Running sum of per-frame S(k)
+    unsigned int m_frame_counter {0};             //!< Number of accumulated frames
+};
+
+//! Compute S(k) on a regular grid of reciprocal lattice vectors via FFT.
+/*! Particles are assigned to a grid_size^3 mesh by nearest grid point in
+ *  fractional coordinates, the mesh is Fourier transformed, and
+ *  S(k) = |rho(k)|^2 / N is accumulated at the grid k-vectors. The grid
+ *  index n in each dimension follows FFT frequency ordering
+ *  (0, 1, ..., g/2, -g/2+1, ..., -1) and corresponds to the reciprocal
+ *  lattice vector 2*pi*n*b_i of the (possibly triclinic) box. This path
+ *  evaluates all grid_size^3 k-vectors in O(g^3 log g) instead of the
+ *  O(g^3 N) cost of direct summation; nearest-grid-point assignment
+ *  introduces aliasing near the Nyquist edge of the grid.
+ */
+class StaticStructureFactorGrid
+{
+public:
+    //! Constructor. The grid size must be a power of two for the radix-2 FFT.
+    explicit StaticStructureFactorGrid(unsigned int grid_size);
+
+    //! Accumulate one frame into the structure factor.
+    /*! \param box The simulation box the points live in.
+     *  \param points The points of the frame.
+     *  \param num_points The number of points.
+     */
+    void accumulate(const box::Box& box, const vec3<float>* points, unsigned int num_points);
+
+    //! Discard all accumulated frames.
+    void reset();
+
+    //! Get S(k) of shape (grid_size, grid_size, grid_size) in FFT ordering.
+    const util::ManagedArray<float>& getStructureFactor() const
+    {
+        return m_structure_factor;
+    }
+
+    unsigned int getGridSize() const
+    {
+        return m_grid_size;
+    }
+
+    unsigned int getFrameCounter() const
+    {
+        return m_frame_counter;
+    }
+
+private:
+    unsigned int m_grid_size;                     //!< Mesh points per dimension
+    util::ManagedArray<float> m_structure_factor; //!< S(k) averaged over frames
+    std::vector<double> m_sk_accumulator;         //!< Running sum of per-frame S(k)
+    unsigned int m_frame_counter {0};             //!< Number of accumulated frames
+};
+
+}; }; // end namespace freud::diffraction
+
+#endif // STATIC_STRUCTURE_FACTOR_H
@@ -1,6 +1,9 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
+#include <vector>
+
 #include "AngularSeparation.h"
 #include "NeighborComputeFunctional.h"
 #include "utils.h"
@@ -63,18 +66,81 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
     m_angles.prepare(tot_num_neigh);
 
     util::forLoopWrapper(0, nq->getNPoints(), [=](size_t begin, size_t end) {
+        // Structure-of-arrays buffers for one particle's bond batch. The
+        // separation angle only depends on the scalar part of
+        // q_test * conj(q), and acos is decreasing, so we track the running
+        // maximum of that scalar part per bond and take a single acos per
+        // bond at the end instead of one per equivalent orientation.
+        std::vector<float> temp_s;
+        std::vector<float> temp_x;
+        std::vector<float> temp_y;
+        std::vector<float> temp_z;
+        std::vector<float> max_dot;
+
         size_t bond(m_nlist.find_first_index(begin));
         for (size_t i = begin; i < end; ++i)
         {
-            quat<float> q = orientations[i];
+            const quat<float> q_conj = conj(orientations[i]);
+            const size_t first_bond(bond);
+            temp_s.clear();
+            temp_x.clear();
+            temp_y.clear();
+            temp_z.clear();
+            max_dot.clear();
 
             for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
             {
                 const size_t j(m_nlist.getNeighbors()(bond, 1));
-                quat<float> query_q = query_orientations[j];
+                const quat<float> query_q = query_orientations[j];
+
+                // start with the quaternion before it has been rotated by
+                // equivalent rotations
+                max_dot.push_back(query_q.s * q_conj.s
+                                  - (query_q.v.x * q_conj.v.x + query_q.v.y * q_conj.v.y
+                                     + query_q.v.z * q_conj.v.z));
+                // here we undo a rotation represented by one of the equivalent orientations
+                if (n_equiv_orientations > 0)
+                {
+                    const quat<float> qtemp = query_q * conj(equiv_orientations[0]);
+                    temp_s.push_back(qtemp.s);
+                    temp_x.push_back(qtemp.v.x);
+                    temp_y.push_back(qtemp.v.y);
+                    temp_z.push_back(qtemp.v.z);
+                }
+            }
+            const size_t batch_size(max_dot.size());
 
-                float theta = computeMinSeparationAngle(q, query_q, equiv_orientations, n_equiv_orientations);
-                m_angles[bond] = theta;
+            // loop through all equivalent rotations and see if any of them
+            // gives a smaller angle with q. With the equivalent orientation
+            // fixed, the quaternion product and the scalar-part update run
+            // over the contiguous batch, which the compiler vectorizes.
+            for (unsigned int e = 0; e < n_equiv_orientations; e++)
+            {
+                const quat<float> qe = equiv_orientations[e];
+                for (size_t n = 0; n < batch_size; ++n)
+                {
+                    // q_test = q_temp * qe, expanded term for term as in
+                    // VectorMath.h
+                    const float ts(temp_s[n] * qe.s
+                                   - (temp_x[n] * qe.v.x + temp_y[n] * qe.v.y + temp_z[n] * qe.v.z));
+                    const float tx((temp_s[n] * qe.v.x + qe.s * temp_x[n])
+                                   + (temp_y[n] * qe.v.z - temp_z[n] * qe.v.y));
+                    const float ty((temp_s[n] * qe.v.y + qe.s * temp_y[n])
+                                   + (temp_z[n] * qe.v.x - temp_x[n] * qe.v.z));
+                    const float tz((temp_s[n] * qe.v.z + qe.s * temp_z[n])
+                                   + (temp_x[n] * qe.v.y - temp_y[n] * qe.v.x));
+                    const float d(ts * q_conj.s
+                                  - (tx * q_conj.v.x + ty * q_conj.v.y + tz * q_conj.v.z));
+                    if (d > max_dot[n])
+                    {
+                        max_dot[n] = d;
+                    }
+                }
+            }
+
+            for (size_t n = 0; n < batch_size; ++n)
+            {
+                m_angles[first_bond + n] = float(2.0 * std::acos(util::clamp(max_dot[n], -1, 1)));
             }
         }
     });
@@ -87,16 +153,66 @@ void AngularSeparationGlobal::compute(const quat<float>* global_orientations, un
 {
     m_angles.prepare({n_points, n_global});
 
+    // Each global orientation's set of candidate quaternions (itself and its
+    // products with every equivalent orientation) is independent of the
+    // points, so build the full table once up front instead of recomputing
+    // the quaternion products for every point. Each row holds the unrotated
+    // global orientation followed by its equivalent candidates, stored
+    // component-wise so the per-point minimum reduces to contiguous dot
+    // products.
+    const unsigned int n_variants = n_equiv_orientations + 1;
+    std::vector<float> cand_s(size_t(n_global) * n_variants);
+    std::vector<float> cand_x(size_t(n_global) * n_variants);
+    std::vector<float> cand_y(size_t(n_global) * n_variants);
+    std::vector<float> cand_z(size_t(n_global) * n_variants);
+    for (unsigned int j = 0; j < n_global; j++)
+    {
+        const quat<float> global_q = global_orientations[j];
+        const size_t row(size_t(j) * n_variants);
+        cand_s[row] = global_q.s;
+        cand_x[row] = global_q.v.x;
+        cand_y[row] = global_q.v.y;
+        cand_z[row] = global_q.v.z;
+        if (n_equiv_orientations > 0)
+        {
+            // here we undo a rotation represented by one of the equivalent orientations
+            const quat<float> qtemp = global_q * conj(equiv_orientations[0]);
+            for (unsigned int e = 0; e < n_equiv_orientations; e++)
+            {
+                const quat<float> qtest = qtemp * equiv_orientations[e];
+                cand_s[row + 1 + e] = qtest.s;
+                cand_x[row + 1 + e] = qtest.v.x;
+                cand_y[row + 1 + e] = qtest.v.y;
+                cand_z[row + 1 + e] = qtest.v.z;
+            }
+        }
+    }
+
     util::forLoopWrapper(0, n_points, [=](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
         {
-            quat<float> q = orientations[i];
+            const quat<float> q_conj = conj(orientations[i]);
             for (unsigned int j = 0; j < n_global; j++)
             {
-                quat<float> global_q = global_orientations[j];
-                float theta
-                    = computeMinSeparationAngle(q, global_q, equiv_orientations, n_equiv_orientations);
-                m_angles(i, j) = theta;
+                const float* cs = cand_s.data() + size_t(j) * n_variants;
+                const float* cx = cand_x.data() + size_t(j) * n_variants;
+                const float* cy = cand_y.data() + size_t(j) * n_variants;
+                const float* cz = cand_z.data() + size_t(j) * n_variants;
+                // The angle only depends on the scalar part of
+                // q_test * conj(q), and acos is decreasing, so the maximum
+                // scalar part over the candidates gives the minimum angle.
+                float max_dot = cs[0] * q_conj.s
+                    - (cx[0] * q_conj.v.x + cy[0] * q_conj.v.y + cz[0] * q_conj.v.z);
+                for (unsigned int e = 1; e < n_variants; e++)
+                {
+                    const float d = cs[e] * q_conj.s
+                        - (cx[e] * q_conj.v.x + cy[e] * q_conj.v.y + cz[e] * q_conj.v.z);
+                    if (d > max_dot)
+                    {
+                        max_dot = d;
+                    }
+                }
+                m_angles(i, j) = float(2.0 * std::acos(util::clamp(max_dot, -1, 1)));
             }
         }
     });
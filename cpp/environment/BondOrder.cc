@@ -1,6 +1,7 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 #ifdef __SSE2__
@@ -9,6 +10,7 @@
 
 #include "BondOrder.h"
 #include "NeighborComputeFunctional.h"
+#include "fastmath.h"
 #include "utils.h"
 
 /*! \file BondOrder.h
@@ -17,8 +19,8 @@
 
 namespace freud { namespace environment {
 
-BondOrder::BondOrder(unsigned int n_bins_theta, unsigned int n_bins_phi, BondOrderMode mode)
-    : BondHistogramCompute(), m_mode(mode)
+BondOrder::BondOrder(unsigned int n_bins_theta, unsigned int n_bins_phi, BondOrderMode mode, bool fast_math)
+    : BondHistogramCompute(), m_mode(mode), m_fast_math(fast_math)
 {
     // sanity checks, but this is actually kinda dumb if these values are 1
     if (n_bins_theta < 2)
@@ -118,11 +120,27 @@ void BondOrder::accumulate(const locality::NeighborQuery* neighbor_query, quat<f
                           // NOTE that angles are defined in the "mathematical" way, rather than how
                           // most physics textbooks do it. get theta (azimuthal angle), phi (polar
                           // angle)
-                          float theta = std::atan2(v.y, v.x); //-Pi..Pi
-                          theta = util::modulusPositive(theta, constants::TWO_PI);
+                          float theta;
+                          float phi;
+                          if (m_fast_math)
+                          {
+                              // Polynomial approximations accurate to a small
+                              // fraction of a bin width for typical bin counts.
+                              theta = util::fastAtan2(v.y, v.x); //-Pi..Pi
+                              phi = util::fastAcos(v.z / std::sqrt(dot(v, v))); // 0..Pi
+                          }
+                          else
+                          {
+                              theta = std::atan2(v.y, v.x); //-Pi..Pi
 
-                          // NOTE that the below has replaced the commented out expression for phi.
-                          float phi = std::acos(v.z / std::sqrt(dot(v, v))); // 0..Pi
+                              // NOTE that the below has replaced the commented out expression for
+                              // phi. The ratio is clamped because rounding can push it just past
+                              // +/-1 for bonds aligned with the z axis, making acos return NaN.
+                              const float cos_phi
+                                  = std::min(1.0F, std::max(-1.0F, v.z / std::sqrt(dot(v, v))));
+                              phi = std::acos(cos_phi); // 0..Pi
+                          }
+                          theta = util::modulusPositive(theta, constants::TWO_PI);
 
                           m_local_histograms(theta, phi);
                       });
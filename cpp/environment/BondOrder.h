@@ -34,7 +34,13 @@ class BondOrder : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    BondOrder(unsigned int n_bins_theta, unsigned int n_bins_phi, BondOrderMode mode);
+    /*! \param fast_math If true, bin the bond angles with polynomial
+     *                   approximations of atan2 and acos (accurate to ~1e-4
+     *                   radians, a small fraction of a bin width for typical
+     *                   bin counts) instead of the exact library calls.
+     */
+    BondOrder(unsigned int n_bins_theta, unsigned int n_bins_phi, BondOrderMode mode,
+              bool fast_math = false);
 
     //! Destructor
     ~BondOrder() override = default;
@@ -54,10 +60,17 @@ public:
         return m_mode;
     }
 
+    //!< Whether bond angles are binned with polynomial approximations
+    bool isFastMath() const
+    {
+        return m_fast_math;
+    }
+
 private:
     util::ManagedArray<float> m_bo_array; //!< bond order array computed
     util::ManagedArray<float> m_sa_array; //!< surface area array computed
     BondOrderMode m_mode;                 //!< The mode to calculate with.
+    bool m_fast_math;                     //!< Whether to bin with approximate trig (default false).
 };
 
 }; }; // end namespace freud::environment
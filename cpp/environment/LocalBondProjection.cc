@@ -1,6 +1,9 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is part of the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
+#include <vector>
+
 #include "LocalBondProjection.h"
 #include "NeighborComputeFunctional.h"
 
@@ -61,29 +64,124 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
     m_local_bond_proj.prepare({tot_num_neigh, n_proj});
     m_local_bond_proj_norm.prepare({tot_num_neigh, n_proj});
 
+    // The symmetrically equivalent copies of each projection vector depend
+    // only on the equivalent orientations, not on the bond, so build the full
+    // table once up front instead of re-rotating inside the bond loop. Each
+    // row holds the unrotated vector followed by its image under every
+    // equivalent orientation, stored component-wise so the per-bond maximum
+    // reduces to contiguous dot products.
+    const unsigned int n_variants = n_equiv_orientations + 1;
+    std::vector<float> variant_x(size_t(n_proj) * n_variants);
+    std::vector<float> variant_y(size_t(n_proj) * n_variants);
+    std::vector<float> variant_z(size_t(n_proj) * n_variants);
+    for (unsigned int k = 0; k < n_proj; k++)
+    {
+        const vec3<float> proj_vec = proj_vecs[k];
+        const size_t row(size_t(k) * n_variants);
+        variant_x[row] = proj_vec.x;
+        variant_y[row] = proj_vec.y;
+        variant_z[row] = proj_vec.z;
+        for (unsigned int e = 0; e < n_equiv_orientations; e++)
+        {
+            // here we undo a rotation represented by one of the equivalent orientations
+            const quat<float> qtest = conj(equiv_orientations[0]) * equiv_orientations[e];
+            const vec3<float> equiv_proj_vec = rotate(qtest, proj_vec);
+            variant_x[row + 1 + e] = equiv_proj_vec.x;
+            variant_y[row + 1 + e] = equiv_proj_vec.y;
+            variant_z[row + 1 + e] = equiv_proj_vec.z;
+        }
+    }
+
     // compute the order parameter
     util::forLoopWrapper(0, n_query_points, [=](size_t begin, size_t end) {
+        // Structure-of-arrays buffers for one particle's bond batch, reused
+        // across the chunk. The bonds are gathered once along with the
+        // conjugated neighbor orientations, then rotated into the local
+        // frames in a single contiguous pass.
+        std::vector<float> bond_x;
+        std::vector<float> bond_y;
+        std::vector<float> bond_z;
+        std::vector<float> conj_s;
+        std::vector<float> conj_x;
+        std::vector<float> conj_y;
+        std::vector<float> conj_z;
+        std::vector<float> rot_x;
+        std::vector<float> rot_y;
+        std::vector<float> rot_z;
+        std::vector<float> rot_len;
+
         size_t bond(m_nlist.find_first_index(begin));
         for (size_t i = begin; i < end; ++i)
         {
+            const size_t first_bond(bond);
+            bond_x.clear();
+            bond_y.clear();
+            bond_z.clear();
+            conj_s.clear();
+            conj_x.clear();
+            conj_y.clear();
+            conj_z.clear();
             for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
             {
                 const size_t j(m_nlist.getNeighbors()(bond, 1));
 
                 // compute bond vector between the two particles
-                vec3<float> local_bond(bondVector(locality::NeighborBond(i, j), nq, query_points));
-                // rotate bond vector into the local frame of particle p
-                local_bond = rotate(conj(orientations[j]), local_bond);
+                const vec3<float> delta(bondVector(locality::NeighborBond(i, j), nq, query_points));
+                bond_x.push_back(delta.x);
+                bond_y.push_back(delta.y);
+                bond_z.push_back(delta.z);
+                // the rotation into the local frame of particle p is by the
+                // conjugate of its orientation
+                conj_s.push_back(orientations[j].s);
+                conj_x.push_back(-orientations[j].v.x);
+                conj_y.push_back(-orientations[j].v.y);
+                conj_z.push_back(-orientations[j].v.z);
+            }
+            const size_t batch_size(bond_x.size());
+            rot_x.resize(batch_size);
+            rot_y.resize(batch_size);
+            rot_z.resize(batch_size);
+            rot_len.resize(batch_size);
+
+            // Rotate the whole batch of bond vectors into the local frames.
+            // The expression matches rotate() in VectorMath.h term for term,
+            // but runs over contiguous arrays the compiler can vectorize.
+            for (size_t n = 0; n < batch_size; ++n)
+            {
+                const float qs(conj_s[n]);
+                const float qx(conj_x[n]);
+                const float qy(conj_y[n]);
+                const float qz(conj_z[n]);
+                const float t(qs * qs - (qx * qx + qy * qy + qz * qz));
+                const float two_s(2 * qs);
+                const float two_d(2 * (qx * bond_x[n] + qy * bond_y[n] + qz * bond_z[n]));
+                rot_x[n] = t * bond_x[n] + two_s * (qy * bond_z[n] - qz * bond_y[n]) + two_d * qx;
+                rot_y[n] = t * bond_y[n] + two_s * (qz * bond_x[n] - qx * bond_z[n]) + two_d * qy;
+                rot_z[n] = t * bond_z[n] + two_s * (qx * bond_y[n] - qy * bond_x[n]) + two_d * qz;
                 // store the length of this local bond
-                float local_bond_len = std::sqrt(dot(local_bond, local_bond));
+                rot_len[n] = std::sqrt(rot_x[n] * rot_x[n] + rot_y[n] * rot_y[n] + rot_z[n] * rot_z[n]);
+            }
 
+            for (size_t n = 0; n < batch_size; ++n)
+            {
                 for (unsigned int k = 0; k < n_proj; k++)
                 {
-                    vec3<float> proj_vec = proj_vecs[k];
-                    float max_proj = computeMaxProjection(proj_vec, local_bond, equiv_orientations,
-                                                          n_equiv_orientations);
-                    m_local_bond_proj(bond, k) = max_proj;
-                    m_local_bond_proj_norm(bond, k) = max_proj / local_bond_len;
+                    const float* vx = variant_x.data() + size_t(k) * n_variants;
+                    const float* vy = variant_y.data() + size_t(k) * n_variants;
+                    const float* vz = variant_z.data() + size_t(k) * n_variants;
+                    // start with the reference vector before it has been
+                    // rotated by equivalent quaternions
+                    float max_proj = vx[0] * rot_x[n] + vy[0] * rot_y[n] + vz[0] * rot_z[n];
+                    for (unsigned int e = 1; e < n_variants; e++)
+                    {
+                        const float proj_test = vx[e] * rot_x[n] + vy[e] * rot_y[n] + vz[e] * rot_z[n];
+                        if (proj_test > max_proj)
+                        {
+                            max_proj = proj_test;
+                        }
+                    }
+                    m_local_bond_proj(first_bond + n, k) = max_proj;
+                    m_local_bond_proj_norm(first_bond + n, k) = max_proj / rot_len[n];
                 }
             }
         }
@@ -30,16 +30,52 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
     {
         max_num_neighbors = std::numeric_limits<unsigned int>::max();
     }
-    m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
+    // Every row of the spherical harmonic array is written below unless
+    // max_num_neighbors cuts a particle's bond list short or the loop over
+    // the points of nq does not cover every query point of the neighbor
+    // list, so the zero fill is only needed in those cases.
+    const bool fully_written = max_num_neighbors == std::numeric_limits<unsigned int>::max()
+        && n_query_points == nq->getNPoints();
+    m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()}, false, !fully_written);
 
     util::forLoopWrapper(0, nq->getNPoints(), [=](size_t begin, size_t end) {
         fsph::PointSPHEvaluator<float> sph_eval(m_l_max);
 
+        // Structure-of-arrays buffers for one particle's neighbor batch,
+        // reused across the chunk. The bond vectors are gathered once,
+        // then the frame rotation is applied to the whole batch as a
+        // 3xN matrix product in plain contiguous loops.
+        std::vector<float> bond_x;
+        std::vector<float> bond_y;
+        std::vector<float> bond_z;
+        std::vector<float> bond_mag;
+        std::vector<float> rot_x;
+        std::vector<float> rot_y;
+        std::vector<float> rot_z;
+
         for (size_t i = begin; i < end; ++i)
         {
-            size_t bond(m_nlist.find_first_index(i));
+            const size_t bond(m_nlist.find_first_index(i));
             unsigned int neighbor_count(0);
 
+            // Gather this particle's bond vectors into the batch buffers.
+            bond_x.clear();
+            bond_y.clear();
+            bond_z.clear();
+            bond_mag.clear();
+            for (size_t bond_copy(bond); bond_copy < m_nlist.getNumBonds()
+                 && m_nlist.getNeighbors()(bond_copy, 0) == i && neighbor_count < max_num_neighbors;
+                 ++bond_copy, ++neighbor_count)
+            {
+                const size_t j(m_nlist.getNeighbors()(bond_copy, 1));
+                const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
+                bond_x.push_back(r_ij.x);
+                bond_y.push_back(r_ij.y);
+                bond_z.push_back(r_ij.z);
+                bond_mag.push_back(std::sqrt(dot(r_ij, r_ij)));
+            }
+            const size_t batch_size(bond_x.size());
+
             vec3<float> rotation_0;
             vec3<float> rotation_1;
             vec3<float> rotation_2;
@@ -48,28 +84,25 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
             {
                 util::ManagedArray<float> inertiaTensor = util::ManagedArray<float>({3, 3});
 
-                for (size_t bond_copy(bond); bond_copy < m_nlist.getNumBonds()
-                     && m_nlist.getNeighbors()(bond_copy, 0) == i && neighbor_count < max_num_neighbors;
-                     ++bond_copy, ++neighbor_count)
+                for (size_t n = 0; n < batch_size; ++n)
                 {
-                    const size_t j(m_nlist.getNeighbors()(bond_copy, 1));
-                    const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
-                    const float r_sq(dot(r_ij, r_ij));
+                    const float r_sq(bond_x[n] * bond_x[n] + bond_y[n] * bond_y[n]
+                                     + bond_z[n] * bond_z[n]);
 
                     for (size_t ii(0); ii < 3; ++ii)
                     {
                         inertiaTensor(ii, ii) += r_sq;
                     }
 
-                    inertiaTensor(0, 0) -= r_ij.x * r_ij.x;
-                    inertiaTensor(0, 1) -= r_ij.x * r_ij.y;
-                    inertiaTensor(0, 2) -= r_ij.x * r_ij.z;
-                    inertiaTensor(1, 0) -= r_ij.x * r_ij.y;
-                    inertiaTensor(1, 1) -= r_ij.y * r_ij.y;
-                    inertiaTensor(1, 2) -= r_ij.y * r_ij.z;
-                    inertiaTensor(2, 0) -= r_ij.x * r_ij.z;
-                    inertiaTensor(2, 1) -= r_ij.y * r_ij.z;
-                    inertiaTensor(2, 2) -= r_ij.z * r_ij.z;
+                    inertiaTensor(0, 0) -= bond_x[n] * bond_x[n];
+                    inertiaTensor(0, 1) -= bond_x[n] * bond_y[n];
+                    inertiaTensor(0, 2) -= bond_x[n] * bond_z[n];
+                    inertiaTensor(1, 0) -= bond_x[n] * bond_y[n];
+                    inertiaTensor(1, 1) -= bond_y[n] * bond_y[n];
+                    inertiaTensor(1, 2) -= bond_y[n] * bond_z[n];
+                    inertiaTensor(2, 0) -= bond_x[n] * bond_z[n];
+                    inertiaTensor(2, 1) -= bond_y[n] * bond_z[n];
+                    inertiaTensor(2, 2) -= bond_z[n] * bond_z[n];
                 }
 
                 util::ManagedArray<float> eigenvalues = util::ManagedArray<float>(3);
@@ -99,32 +132,42 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
                 throw std::runtime_error("Uncaught orientation mode in LocalDescriptors::compute");
             }
 
-            neighbor_count = 0;
-            for (; bond < m_nlist.getNumBonds() && m_nlist.getNeighbors()(bond, 0) == i
-                 && neighbor_count < max_num_neighbors;
-                 ++bond, ++neighbor_count)
+            // Rotate the whole batch into the reference frame. Each output
+            // component is an independent fused multiply-add pass over the
+            // contiguous batch, which the compiler vectorizes.
+            rot_x.resize(batch_size);
+            rot_y.resize(batch_size);
+            rot_z.resize(batch_size);
+            for (size_t n = 0; n < batch_size; ++n)
             {
-                const unsigned int sphCount(bond * getSphWidth());
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
-                const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
-                const float r_sq(dot(r_ij, r_ij));
-                const vec3<float> bond_ij(dot(rotation_0, r_ij), dot(rotation_1, r_ij),
-                                          dot(rotation_2, r_ij));
+                rot_x[n] = rotation_0.x * bond_x[n] + rotation_0.y * bond_y[n] + rotation_0.z * bond_z[n];
+            }
+            for (size_t n = 0; n < batch_size; ++n)
+            {
+                rot_y[n] = rotation_1.x * bond_x[n] + rotation_1.y * bond_y[n] + rotation_1.z * bond_z[n];
+            }
+            for (size_t n = 0; n < batch_size; ++n)
+            {
+                rot_z[n] = rotation_2.x * bond_x[n] + rotation_2.y * bond_y[n] + rotation_2.z * bond_z[n];
+            }
 
-                const float magR(std::sqrt(r_sq));
+            // Harmonics over the rotated batch.
+            for (size_t n = 0; n < batch_size; ++n)
+            {
+                const unsigned int sphCount((bond + n) * getSphWidth());
 
                 // Wrap theta into [0, 2*pi]
-                float theta(std::atan2(bond_ij.y, bond_ij.x));
+                float theta(std::atan2(rot_y[n], rot_x[n]));
                 theta = util::modulusPositive(theta, constants::TWO_PI);
 
                 // Phi in [0, pi]
-                float phi(std::acos(bond_ij.z / magR));
+                float phi(std::acos(rot_z[n] / bond_mag[n]));
 
-                // catch cases where bond_ij.z/magR falls outside [-1, 1]
-                // due to numerical issues
+                // catch cases where rot_z[n]/bond_mag[n] falls outside
+                // [-1, 1] due to numerical issues
                 if (std::isnan(phi))
                 {
-                    phi = bond_ij.z > 0 ? 0 : M_PI;
+                    phi = rot_z[n] > 0 ? 0 : M_PI;
                 }
 
                 sph_eval.compute(phi, theta);
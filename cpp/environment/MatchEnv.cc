@@ -1,6 +1,8 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <stdexcept>
 
@@ -8,9 +10,194 @@
 
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
+#include "utils.h"
 
 namespace freud { namespace environment {
 
+namespace {
+
+//! Sorted magnitudes of an environment's vectors.
+/*! The magnitude multiset is invariant under rotation and under the index
+ *  permutations and proper rotations applied by merges, so a spectrum
+ *  computed from the raw vectors stays valid for the whole clustering pass.
+ */
+std::vector<float> distanceSpectrum(const Environment& env)
+{
+    std::vector<float> spectrum;
+    spectrum.reserve(env.vecs.size());
+    for (const auto& v : env.vecs)
+    {
+        spectrum.push_back(std::sqrt(dot(v, v)));
+    }
+    std::sort(spectrum.begin(), spectrum.end());
+    return spectrum;
+}
+
+//! Cheap rotation-invariant rejection test run before isSimilar.
+/*! A full match requires a 1-1 pairing with every vector difference below
+ *  the threshold, which forces the sorted magnitude lists to agree
+ *  elementwise to within the threshold (the sorted pairing minimizes the
+ *  largest magnitude difference). If any sorted entry differs by more, no
+ *  pairing can exist and the expensive registration is skipped.
+ */
+bool spectraCompatible(const std::vector<float>& s1, const std::vector<float>& s2, float threshold_sq)
+{
+    if (s1.size() != s2.size())
+    {
+        return false;
+    }
+    for (size_t k = 0; k < s1.size(); ++k)
+    {
+        const float diff = s1[k] - s2[k];
+        if (diff * diff >= threshold_sq)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! isSimilar against a fixed reference environment.
+/*! Mirrors the isSimilar free function, except that the properly ordered
+ *  reference vectors and the registration object built from them are
+ *  supplied by the caller. A motif heading a disjoint set is never mutated
+ *  by the merges of a matching pass (they only rewrite the particle
+ *  environments), so both can be prepared once and reused for every
+ *  comparison instead of being rebuilt per particle.
+ */
+std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>
+isSimilarToRef(const std::vector<vec3<float>>& v1, RegisterBruteForce& reg, Environment& e2,
+               float threshold_sq, bool registration)
+{
+    FlatBiMap<unsigned int, unsigned int> vec_map;
+    rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
+
+    // If the vector sets do not have equal numbers of vectors, just return
+    // an empty map since the 1-1 bimapping will be too weird in this case.
+    if (v1.size() != e2.vecs.size())
+    {
+        return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
+    }
+
+    std::vector<vec3<float>> v2(e2.vecs.size());
+
+    // get the vectors into the proper orientation and order with respect to
+    // their parent environment
+    for (unsigned int m = 0; m < e2.vecs.size(); m++)
+    {
+        v2[m] = e2.proper_rot * e2.vecs[e2.vec_ind[m]];
+    }
+
+    // If we have to register, first find the rotated set of v2 that best maps
+    // to v1. The Fit operation CHANGES v2.
+    if (registration)
+    {
+        reg.Fit(v2);
+        // get the optimal rotation to take v2 to v1
+        std::vector<vec3<float>> rot = reg.getRotation();
+        // rot must be a 3x3 matrix. if it isn't, something has gone wrong.
+        rotation = rotmat3<float>(rot[0], rot[1], rot[2]);
+        FlatBiMap<unsigned int, unsigned int> tmp_vec_map = reg.getVecMap();
+
+        for (const auto& registered_pair : tmp_vec_map)
+        {
+            // RegisterBruteForce has found the vector mapping that results in
+            // minimal RMSD, as best as it can figure out.
+            // Does this vector mapping pass the more stringent criterion
+            // imposed by the threshold?
+            vec3<float> delta = v1[registered_pair.first] - v2[registered_pair.second];
+            float r_sq = dot(delta, delta);
+            if (r_sq < threshold_sq)
+            {
+                vec_map.emplace(registered_pair.first, registered_pair.second);
+            }
+        }
+    }
+
+    // if we didn't have to register, compare all combinations of vectors
+    else
+    {
+        for (unsigned int i = 0; i < v1.size(); i++)
+        {
+            for (unsigned int j = 0; j < e2.vecs.size(); j++)
+            {
+                vec3<float> delta = v1[i] - v2[j];
+                float r_sq = dot(delta, delta);
+                if (r_sq < threshold_sq)
+                {
+                    // these vectors are deemed "matching"
+                    // since this is a bimap, this (i,j) pair is only inserted
+                    // if j has not already been assigned an i pairing.
+                    // (ditto with i not being assigned a j pairing)
+                    vec_map.emplace(i, j);
+                }
+            }
+        }
+    }
+
+    // if every vector has been paired with every other vector, return this bimap
+    if (vec_map.size() == v1.size())
+    {
+        return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
+    }
+    // otherwise, return an empty bimap
+    FlatBiMap<unsigned int, unsigned int> empty_map;
+    return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, empty_map);
+}
+
+//! minimizeRMSD against a fixed reference environment.
+/*! Mirrors the minimizeRMSD free function with the reference side hoisted,
+ *  exactly as isSimilarToRef does for isSimilar.
+ */
+std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>
+minimizeRMSDToRef(const std::vector<vec3<float>>& v1, RegisterBruteForce& reg, Environment& e2,
+                  float& min_rmsd, bool registration)
+{
+    FlatBiMap<unsigned int, unsigned int> vec_map;
+    rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
+
+    // If the vector sets do not have equal numbers of vectors, force the map
+    // to be empty since it can never be 1-1.
+    // Return the empty vec_map and the identity matrix, and minRMSD = -1.
+    if (v1.size() != e2.vecs.size())
+    {
+        min_rmsd = -1.0;
+        return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
+    }
+
+    std::vector<vec3<float>> v2(e2.vecs.size());
+
+    // Get the vectors into the proper orientation and order with respect
+    // to their parent environment
+    for (unsigned int m = 0; m < e2.vecs.size(); m++)
+    {
+        v2[m] = e2.proper_rot * e2.vecs[e2.vec_ind[m]];
+    }
+
+    // If we have to register, first find the rotated set of v2 that best
+    // maps to v1. The Fit operation CHANGES v2.
+    if (registration)
+    {
+        reg.Fit(v2);
+        // get the optimal rotation to take v2 to v1
+        std::vector<vec3<float>> rot = reg.getRotation();
+        // rot must be a 3x3 matrix. if it isn't, something has gone wrong.
+        rotation = rotmat3<float>(rot[0], rot[1], rot[2]);
+        min_rmsd = reg.getRMSD();
+        vec_map = reg.getVecMap();
+    }
+    else
+    {
+        // this will populate vec_map with the correct mapping
+        min_rmsd = reg.AlignedRMSDTree(makeEigenMatrix(v2), vec_map);
+    }
+
+    // return the rotation matrix and bimap
+    return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
+}
+
+} // namespace
+
 /*****************
  * EnvDisjoinSet *
  *****************/
@@ -18,7 +205,7 @@ EnvDisjointSet::EnvDisjointSet(unsigned int Np) : rank(std::vector<unsigned int>
 {}
 
 void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
-                           BiMap<unsigned int, unsigned int> vec_map, rotmat3<float>& rotation)
+                           FlatBiMap<unsigned int, unsigned int> vec_map, rotmat3<float>& rotation)
 {
     // if tree heights are equal, merge b to a
     if (rank[s[a].env_ind] == rank[s[b].env_ind])
@@ -265,17 +452,17 @@ std::vector<vec3<float>> EnvDisjointSet::getIndividualEnv(const unsigned int m)
 /*************************
  * Convenience functions *
  *************************/
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
+std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
                                                                        float threshold_sq, bool registration)
 {
-    BiMap<unsigned int, unsigned int> vec_map;
+    FlatBiMap<unsigned int, unsigned int> vec_map;
     rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
 
     // If the vector sets do not have equal numbers of vectors, just return
     // an empty map since the 1-1 bimapping will be too weird in this case.
     if (e1.vecs.size() != e2.vecs.size())
     {
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
     }
 
     std::vector<vec3<float>> v1(e1.vecs.size());
@@ -299,19 +486,19 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
         std::vector<vec3<float>> rot = r.getRotation();
         // rot must be a 3x3 matrix. if it isn't, something has gone wrong.
         rotation = rotmat3<float>(rot[0], rot[1], rot[2]);
-        BiMap<unsigned int, unsigned int> tmp_vec_map = r.getVecMap();
+        FlatBiMap<unsigned int, unsigned int> tmp_vec_map = r.getVecMap();
 
-        for (const auto* registered_pair : tmp_vec_map)
+        for (const auto& registered_pair : tmp_vec_map)
         {
             // RegisterBruteForce has found the vector mapping that results in
             // minimal RMSD, as best as it can figure out.
             // Does this vector mapping pass the more stringent criterion
             // imposed by the threshold?
-            vec3<float> delta = v1[registered_pair->first] - v2[registered_pair->second];
+            vec3<float> delta = v1[registered_pair.first] - v2[registered_pair.second];
             float r_sq = dot(delta, delta);
             if (r_sq < threshold_sq)
             {
-                vec_map.emplace(registered_pair->first, registered_pair->second);
+                vec_map.emplace(registered_pair.first, registered_pair.second);
             }
         }
     }
@@ -340,11 +527,11 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
     // if every vector has been paired with every other vector, return this bimap
     if (vec_map.size() == e1.vecs.size())
     {
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
     }
     // otherwise, return an empty bimap
-    BiMap<unsigned int, unsigned int> empty_map;
-    return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, empty_map);
+    FlatBiMap<unsigned int, unsigned int> empty_map;
+    return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, empty_map);
 }
 
 std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<float>* refPoints1,
@@ -356,10 +543,10 @@ std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<f
     std::tie(e0, e1) = makeEnvironments(box, refPoints1, refPoints2, numRef);
 
     // call isSimilar for e0 and e1
-    std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+    std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> mapping
         = isSimilar(e0, e1, threshold_sq, registration);
     rotmat3<float> rotation = mapping.first;
-    BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+    FlatBiMap<unsigned int, unsigned int> vec_map = mapping.second;
 
     // update refPoints2 in case registration has taken place
     for (unsigned int i = 0; i < numRef; i++)
@@ -367,7 +554,7 @@ std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<f
         refPoints2[i] = rotation * e1.vecs[i];
     }
 
-    // Convert BiMap to a std::map and return
+    // Convert FlatBiMap to a std::map and return
     return vec_map.asMap();
 }
 
@@ -399,10 +586,10 @@ std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const
     return std::pair<Environment, Environment>(e0, e1);
 }
 
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
+std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
                                                                           float& min_rmsd, bool registration)
 {
-    BiMap<unsigned int, unsigned int> vec_map;
+    FlatBiMap<unsigned int, unsigned int> vec_map;
     rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
 
     // If the vector sets do not have equal numbers of vectors, force the map
@@ -411,7 +598,7 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Enviro
     if (e1.vecs.size() != e2.vecs.size())
     {
         min_rmsd = -1.0;
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
     }
 
     std::vector<vec3<float>> v1(e1.vecs.size());
@@ -446,7 +633,7 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Enviro
     }
 
     // return the rotation matrix and bimap
-    return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+    return std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>(rotation, vec_map);
 }
 
 std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec3<float>* refPoints1,
@@ -458,10 +645,10 @@ std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec
     std::tie(e0, e1) = makeEnvironments(box, refPoints1, refPoints2, numRef);
 
     float tmp_min_rmsd = -1.0;
-    std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+    std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> mapping
         = minimizeRMSD(e0, e1, tmp_min_rmsd, registration);
     rotmat3<float> rotation = mapping.first;
-    BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+    FlatBiMap<unsigned int, unsigned int> vec_map = mapping.second;
     min_rmsd = tmp_min_rmsd;
 
     // update refPoints2 in case registration has taken place
@@ -470,10 +657,40 @@ std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec
         refPoints2[i] = rotation * e1.vecs[i];
     }
 
-    // Convert BiMap to a std::map and return
+    // Convert FlatBiMap to a std::map and return
     return vec_map.asMap();
 }
 
+/*****************
+ * CompiledMotif *
+ *****************/
+CompiledMotif::CompiledMotif(const box::Box& box, const vec3<float>* motif, unsigned int motif_size)
+    : m_env(Environment(true))
+{
+    // loop through all the vectors in motif and add them to the environment.
+    // wrap all the vectors back into the box. I think this is necessary since
+    // all the vectors that will be added to actual particle environments will
+    // be wrapped into the box as well.
+    for (unsigned int i = 0; i < motif_size; i++)
+    {
+        vec3<float> p = box.wrap(motif[i]);
+        m_env.addVec(p);
+    }
+
+    // the motif's spectrum prunes particles whose environments cannot
+    // possibly match before the expensive registration runs.
+    m_spectrum = distanceSpectrum(m_env);
+
+    // the vectors in proper orientation and order; for a freshly built motif
+    // the ordering and rotation are the identity, so this is just a copy,
+    // but it is what the registration is seeded with.
+    m_proper_vecs.resize(m_env.vecs.size());
+    for (unsigned int m = 0; m < m_env.vecs.size(); m++)
+    {
+        m_proper_vecs[m] = m_env.proper_rot * m_env.vecs[m_env.vec_ind[m]];
+    }
+}
+
 /************
  * MatchEnv *
  ************/
@@ -548,6 +765,35 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
     // reallocate the m_point_environments array
     m_point_environments.prepare({Np, dj.m_max_num_neigh});
 
+    // Precompute the sorted magnitude spectrum of every environment. These
+    // only depend on the raw vectors, which merges never touch, so they can
+    // prune pairs for the whole clustering pass.
+    std::vector<std::vector<float>> spectra(Np);
+    util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            spectra[i] = distanceSpectrum(dj.s[i]);
+        }
+    });
+
+    // Environments are rewritten (reindexed and rotated) when their set is
+    // merged. Track a version per node so speculatively computed pair
+    // results can be detected as stale and redone.
+    std::vector<unsigned int> node_version(Np, 0);
+    auto mergeAndVersion = [&](unsigned int i, unsigned int j, FlatBiMap<unsigned int, unsigned int>& vec_map,
+                               rotmat3<float>& rotation) {
+        const unsigned int head_i = dj.find(i);
+        const unsigned int head_j = dj.find(j);
+        // merge rewrites j's set unless j's tree is the taller one, in
+        // which case it rewrites i's set. Mirror its rank logic here.
+        const unsigned int modified_head = (dj.rank[head_j] > dj.rank[head_i]) ? head_i : head_j;
+        for (const unsigned int node : dj.findSet(modified_head))
+        {
+            ++node_version[node];
+        }
+        dj.merge(i, j, vec_map, rotation);
+    };
+
     size_t bond(0);
     // loop through points
     for (unsigned int i = 0; i < Np; i++)
@@ -558,46 +804,81 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
             for (; bond < nlist.getNumBonds() && nlist.getNeighbors()(bond, 0) == i; ++bond)
             {
                 const size_t j(nlist.getNeighbors()(bond, 1));
-                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+                if (!spectraCompatible(spectra[i], spectra[j], m_threshold_sq))
+                {
+                    continue;
+                }
+                // pairs already in the same cluster could not be merged
+                // any further, so don't bother registering them.
+                if (dj.find(i) == dj.find(j))
+                {
+                    continue;
+                }
+                std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> mapping
                     = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
                 rotmat3<float> rotation = mapping.first;
-                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+                FlatBiMap<unsigned int, unsigned int> vec_map = mapping.second;
                 // if the mapping between the vectors of the environments
                 // is NOT empty, then the environments are similar, so
                 // merge them.
                 if (!vec_map.empty())
                 {
-                    // merge the two sets using the disjoint set
-                    unsigned int a = dj.find(i);
-                    unsigned int b = dj.find(j);
-                    if (a != b)
-                    {
-                        dj.merge(i, j, vec_map, rotation);
-                    }
+                    dj.merge(i, j, vec_map, rotation);
                 }
             }
         }
         else
         {
-            // loop over all other particles
+            // Gather the candidates that survive the cheap filters, then
+            // evaluate the expensive similarity checks for the whole block
+            // in parallel. Merges are applied serially afterwards in
+            // ascending j order; any result whose environments were
+            // rewritten by an earlier merge in the block is recomputed, so
+            // the final clustering is identical to the serial loop's.
+            std::vector<unsigned int> candidates;
             for (unsigned int j = i + 1; j < Np; j++)
             {
-                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-                    = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
-                rotmat3<float> rotation = mapping.first;
-                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-                // if the mapping between the vectors of the environments
-                // is NOT empty, then the environments are similar, so
-                // merge them.
-                if (!vec_map.empty())
+                if (!spectraCompatible(spectra[i], spectra[j], m_threshold_sq))
+                {
+                    continue;
+                }
+                if (dj.find(i) == dj.find(j))
+                {
+                    continue;
+                }
+                candidates.push_back(j);
+            }
+
+            std::vector<std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>>> results(
+                candidates.size());
+            util::forLoopWrapper(0, candidates.size(), [&](size_t begin, size_t end) {
+                for (size_t c = begin; c < end; ++c)
+                {
+                    results[c] = isSimilar(dj.s[i], dj.s[candidates[c]], m_threshold_sq, registration);
+                }
+            });
+
+            // Versions at the time the speculative results were computed.
+            const unsigned int version_i = node_version[i];
+            std::vector<unsigned int> version_j(candidates.size());
+            for (size_t c = 0; c < candidates.size(); ++c)
+            {
+                version_j[c] = node_version[candidates[c]];
+            }
+
+            for (size_t c = 0; c < candidates.size(); ++c)
+            {
+                const unsigned int j = candidates[c];
+                std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> mapping = results[c];
+                if (node_version[i] != version_i || node_version[j] != version_j[c])
                 {
-                    // merge the two sets using the disjoint set
-                    unsigned int a = dj.find(i);
-                    unsigned int b = dj.find(j);
-                    if (a != b)
-                    {
-                        dj.merge(i, j, vec_map, rotation);
-                    }
+                    // An earlier merge in this block rewrote one of the
+                    // environments; redo the check against current state.
+                    mapping = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
+                }
+                if (!mapping.second.empty() && dj.find(i) != dj.find(j))
+                {
+                    mergeAndVersion(i, j, mapping.second, mapping.first);
                 }
             }
         }
@@ -669,12 +950,21 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
                                     const freud::locality::NeighborList* nlist_arg, locality::QueryArgs qargs,
                                     const vec3<float>* motif, unsigned int motif_size, float threshold,
                                     bool registration)
+{
+    // compile the motif for this single call and delegate.
+    compute(nq, nlist_arg, qargs, CompiledMotif(nq->getBox(), motif, motif_size), threshold, registration);
+}
+
+void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
+                                    const freud::locality::NeighborList* nlist_arg, locality::QueryArgs qargs,
+                                    const CompiledMotif& motif, float threshold, bool registration)
 {
     const locality::NeighborList nlist
         = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
 
     unsigned int Np = nq->getNPoints();
     float m_threshold_sq = threshold * threshold;
+    const unsigned int motif_size = motif.getMotifSize();
 
     nlist.validate(Np, Np);
 
@@ -687,23 +977,18 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
     // reallocate the m_point_environments array
     m_point_environments.prepare({Np, motif_size});
 
-    // create the environment characterized by motif. Index it as 0.
-    // set the IGNORE flag to true, since this is not an environment we have
-    // actually encountered in the simulation.
-    Environment e0 = Environment(true);
+    // the compiled motif environment is indexed as 0. Its IGNORE flag is
+    // true, since this is not an environment we have actually encountered in
+    // the simulation.
+    dj.s.push_back(motif.getEnvironment());
 
-    // loop through all the vectors in motif and add them to the environment.
-    // wrap all the vectors back into the box. I think this is necessary since
-    // all the vectors that will be added to actual particle environments will
-    // be wrapped into the box as well.
-    for (unsigned int i = 0; i < motif_size; i++)
-    {
-        vec3<float> p = nq->getBox().wrap(motif[i]);
-        e0.addVec(p);
-    }
+    const std::vector<float>& motif_spectrum = motif.getSpectrum();
 
-    // add this environment to the set
-    dj.s.push_back(e0);
+    // The motif's side of every comparison never changes during the pass
+    // (merges only rewrite the particle environments), so the registration
+    // is seeded once from the compiled reference points and reused.
+    std::vector<vec3<float>> v1 = motif.getProperVecs();
+    RegisterBruteForce reg(v1);
 
     size_t bond(0);
     const size_t num_bonds(nlist.getNumBonds());
@@ -720,17 +1005,21 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
         Environment ei = buildEnv(nq, &nlist, num_bonds, bond, i, dummy);
         dj.s.push_back(ei);
 
-        // if the environment matches e0, merge it into the e0 environment set
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = isSimilar(dj.s[0], dj.s[dummy], m_threshold_sq, registration);
-        rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-        // if the mapping between the vectors of the environments is NOT empty,
-        // then the environments are similar.
-        if (!vec_map.empty())
+        // if the environment matches the motif, merge it into the motif's
+        // environment set
+        if (spectraCompatible(motif_spectrum, distanceSpectrum(ei), m_threshold_sq))
         {
-            dj.merge(0, dummy, vec_map, rotation);
-            m_matches[i] = true;
+            std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> mapping
+                = isSimilarToRef(v1, reg, dj.s[dummy], m_threshold_sq, registration);
+            rotmat3<float> rotation = mapping.first;
+            FlatBiMap<unsigned int, unsigned int> vec_map = mapping.second;
+            // if the mapping between the vectors of the environments is NOT
+            // empty, then the environments are similar.
+            if (!vec_map.empty())
+            {
+                dj.merge(0, dummy, vec_map, rotation);
+                m_matches[i] = true;
+            }
         }
         // grab the set of vectors that define this individual environment
         std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
@@ -749,11 +1038,21 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
                                        const freud::locality::NeighborList* nlist_arg,
                                        locality::QueryArgs qargs, const vec3<float>* motif,
                                        unsigned int motif_size, bool registration)
+{
+    // compile the motif for this single call and delegate.
+    compute(nq, nlist_arg, qargs, CompiledMotif(nq->getBox(), motif, motif_size), registration);
+}
+
+void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
+                                       const freud::locality::NeighborList* nlist_arg,
+                                       locality::QueryArgs qargs, const CompiledMotif& motif,
+                                       bool registration)
 {
     const locality::NeighborList nlist
         = locality::makeDefaultNlist(nq, nlist_arg, nq->getPoints(), nq->getNPoints(), qargs);
 
     unsigned int Np = nq->getNPoints();
+    const unsigned int motif_size = motif.getMotifSize();
 
     // create a disjoint set where all particles belong in their own cluster.
     // this has to have ONE MORE environment than there are actual particles,
@@ -764,23 +1063,16 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
     // reallocate the m_point_environments array
     m_point_environments.prepare({Np, motif_size});
 
-    // create the environment characterized by motif. Index it as 0.
-    // set the IGNORE flag to true, since this is not an environment we
-    // have actually encountered in the simulation.
-    Environment e0 = Environment(true);
-
-    // loop through all the vectors in motif and add them to the environment.
-    // wrap all the vectors back into the box. I think this is necessary since
-    // all the vectors that will be added to actual particle environments will
-    // be wrapped into the box as well.
-    for (unsigned int i = 0; i < motif_size; i++)
-    {
-        vec3<float> p = nq->getBox().wrap(motif[i]);
-        e0.addVec(p);
-    }
+    // the compiled motif environment is indexed as 0. Its IGNORE flag is
+    // true, since this is not an environment we have actually encountered in
+    // the simulation.
+    dj.s.push_back(motif.getEnvironment());
 
-    // add this environment to the set
-    dj.s.push_back(e0);
+    // The motif's side of every comparison never changes during the pass
+    // (merges only rewrite the particle environments), so the registration
+    // is seeded once from the compiled reference points and reused.
+    std::vector<vec3<float>> v1 = motif.getProperVecs();
+    RegisterBruteForce reg(v1);
 
     size_t bond(0);
     const size_t num_bonds(nlist.getNumBonds());
@@ -797,12 +1089,13 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
         Environment ei = buildEnv(nq, &nlist, num_bonds, bond, i, dummy);
         dj.s.push_back(ei);
 
-        // if the environment matches e0, merge it into the e0 environment set
+        // if the environment matches the motif, merge it into the motif's
+        // environment set
         float min_rmsd = -1.0;
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = minimizeRMSD(dj.s[0], dj.s[dummy], min_rmsd, registration);
+        std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> mapping
+            = minimizeRMSDToRef(v1, reg, dj.s[dummy], min_rmsd, registration);
         rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+        FlatBiMap<unsigned int, unsigned int> vec_map = mapping.second;
         // populate the min_rmsd vector
         m_rmsds[i] = min_rmsd;
 
@@ -7,7 +7,7 @@
 #include <map>
 #include <vector>
 
-#include "BiMap.h"
+#include "FlatBiMap.h"
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
@@ -61,7 +61,7 @@ struct EnvDisjointSet
      * the right. The rotation must take the set of PROPERLY ROTATED vectors b
      * and rotate them to match the set of PROPERLY ROTATED vectors a
      */
-    void merge(const unsigned int a, const unsigned int b, BiMap<unsigned int, unsigned int> vec_map,
+    void merge(const unsigned int a, const unsigned int b, FlatBiMap<unsigned int, unsigned int> vec_map,
                rotmat3<float>& rotation);
 
     //! Find the set with a given element (taken mostly from Cluster.cc).
@@ -121,7 +121,7 @@ std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const
  *                     orient the second set of vectors such that it
  *                     minimizes the RMSD between the two sets
  */
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
+std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
                                                                           float& min_rmsd, bool registration);
 
 //! Overload of the above minimizeRMSD function that provides an easier interface to Python.
@@ -163,7 +163,7 @@ std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec
  *                     orient the second set of vectors such that it
  *                     minimizes the RMSD between the two sets
  */
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
+std::pair<rotmat3<float>, FlatBiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
                                                                        float threshold_sq, bool registration);
 
 //! Overload of the above isSimilar function that provides an easier interface to Python.
@@ -191,6 +191,55 @@ std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<f
                                                vec3<float>* refPoints2, unsigned int numRef,
                                                float threshold_sq, bool registration);
 
+//! Preprocessed motif that can be reused across frames.
+/*! EnvironmentMotifMatch and EnvironmentRMSDMinimizer rebuild the motif
+ * environment, its sorted distance spectrum, and the registration reference
+ * points from the raw motif vectors on every call. When the same motif is
+ * matched against every frame of a trajectory, that setup can be compiled
+ * once with this class and passed to the corresponding compute overloads, so
+ * the per-frame calls only pay for the per-particle comparison work.
+ */
+class CompiledMotif
+{
+public:
+    //! Compile the motif vectors, wrapped back into the box.
+    /*! \param box The system box (the motif vectors are wrapped into it, as
+     *             they would be by the raw-vector compute signatures).
+     * \param motif The vectors characterizing the motif.
+     * \param motif_size The number of vectors characterizing the motif.
+     */
+    CompiledMotif(const box::Box& box, const vec3<float>* motif, unsigned int motif_size);
+
+    //! Get the motif as a (ghost) environment, ready to head a disjoint set.
+    const Environment& getEnvironment() const
+    {
+        return m_env;
+    }
+
+    //! Get the sorted magnitudes of the motif vectors, used to prune
+    //! comparisons that cannot possibly match.
+    const std::vector<float>& getSpectrum() const
+    {
+        return m_spectrum;
+    }
+
+    //! Get the motif vectors in their proper order, as fed to registration.
+    const std::vector<vec3<float>>& getProperVecs() const
+    {
+        return m_proper_vecs;
+    }
+
+    unsigned int getMotifSize() const
+    {
+        return m_env.num_vecs;
+    }
+
+private:
+    Environment m_env;                      //!< The wrapped motif as a ghost environment
+    std::vector<float> m_spectrum;          //!< Sorted magnitudes of the motif vectors
+    std::vector<vec3<float>> m_proper_vecs; //!< The motif vectors in proper order
+};
+
 //! Parent class for environment matching.
 /*! This class defines some of the common features of the different environment
  * matching classes. All of them perform some form of registration for
@@ -367,6 +416,16 @@ public:
                  locality::QueryArgs qargs, const vec3<float>* motif, unsigned int motif_size,
                  float threshold, bool registration = false);
 
+    //! Overload taking a precompiled motif.
+    /*! Identical to the raw-vector compute, but the motif normalization and
+     * registration setup are taken from the CompiledMotif instead of being
+     * redone, which is the preferred entry point when matching the same
+     * motif against every frame of a trajectory.
+     */
+    void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist_arg,
+                 locality::QueryArgs qargs, const CompiledMotif& motif, float threshold,
+                 bool registration = false);
+
     //! Return the array indicating whether each particle matched the motif or not.
     const util::ManagedArray<bool>& getMatches()
     {
@@ -429,6 +488,15 @@ public:
                  locality::QueryArgs qargs, const vec3<float>* motif, unsigned int motif_size,
                  bool registration = false);
 
+    //! Overload taking a precompiled motif.
+    /*! Identical to the raw-vector compute, but the motif normalization and
+     * registration setup are taken from the CompiledMotif instead of being
+     * redone, which is the preferred entry point when minimizing against the
+     * same motif for every frame of a trajectory.
+     */
+    void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist_arg,
+                 locality::QueryArgs qargs, const CompiledMotif& motif, bool registration = false);
+
     //! Return the array indicating whether or not a successful mapping was found between each particle and
     //! the provided motif.
     const util::ManagedArray<float>& getRMSDs()
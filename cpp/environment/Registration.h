@@ -4,9 +4,13 @@
 #ifndef REGISTRATION_H
 #define REGISTRATION_H
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <random>
+#include <set>
 #include <sstream>
 #include <vector>
 
@@ -21,8 +25,10 @@
 #include "Eigen/Eigen/Dense"
 #include "Eigen/Eigen/Sparse"
 
-#include "BiMap.h"
+#include "FlatBiMap.h"
+#include "ManagedArray.h"
 #include "VectorMath.h"
+#include "diagonalize.h"
 
 namespace freud { namespace environment {
 
@@ -236,24 +242,38 @@ public:
                 p.row(2) = m_ref_points.row(p2);
                 q.resize(num_pts, m_ref_points.cols());
             }
+            // 3-point candidates are deferred and registered in blocks so
+            // their cross-covariances and rotations can be solved as one
+            // batch; the degenerate 1- and 2-point cases keep the direct
+            // one-at-a-time path.
+            std::vector<std::array<size_t, 3>> batch;
+            batch.reserve(m_batch_size);
             do
             {
                 do
                 {
-                    if (N == int(2))
+                    if (num_pts == 3)
                     {
-                        q.row(0) = points.row(comb[0]);
-                        q.row(1) = points.row(comb[1]);
+                        batch.push_back({{comb[0], comb[1], comb[2]}});
+                        if (batch.size() == m_batch_size)
+                        {
+                            if (FitCandidateBatch(batch, p, points, pts, rmsd_min))
+                            {
+                                return;
+                            }
+                            batch.clear();
+                        }
+                        continue;
                     }
-                    else if (N == int(1))
+
+                    if (N == int(2))
                     {
                         q.row(0) = points.row(comb[0]);
+                        q.row(1) = points.row(comb[1]);
                     }
                     else
                     {
                         q.row(0) = points.row(comb[0]);
-                        q.row(1) = points.row(comb[1]);
-                        q.row(2) = points.row(comb[2]);
                     }
 
                     // finds the optimal rotation of the FIRST input set
@@ -267,7 +287,7 @@ public:
 
                     // feed back in the TRANSPOSE of rot_points such that
                     // the input matrix is (Nx3).
-                    BiMap<unsigned int, unsigned int> vec_map;
+                    FlatBiMap<unsigned int, unsigned int> vec_map;
                     float rmsd = AlignedRMSDTree(rot_points.transpose(), vec_map);
                     if (rmsd < rmsd_min || rmsd_min < 0.0)
                     {
@@ -288,6 +308,10 @@ public:
                     }
                 } while (std::next_permutation(comb, comb + num_pts));
             } while (NextCombination(comb, N, num_pts));
+            if (!batch.empty() && FitCandidateBatch(batch, p, points, pts, rmsd_min))
+            {
+                return;
+            }
         } // end for loop over shuffles
         // The rotation that we've found from the KabschAlgorithm
         // actually acts on P^T.
@@ -314,7 +338,7 @@ public:
         return m_rmsd;
     }
 
-    BiMap<unsigned int, unsigned int> getVecMap()
+    FlatBiMap<unsigned int, unsigned int> getVecMap()
     {
         return m_vec_map;
     }
@@ -337,13 +361,13 @@ public:
     // set, the vector set used in the argument below.
     // To fully solve this, we need to use the Hungarian algorithm or some
     // other way of solving the so-called assignment problem.
-    float AlignedRMSDTree(const matrix& points, BiMap<unsigned int, unsigned int>& m)
+    float AlignedRMSDTree(const matrix& points, FlatBiMap<unsigned int, unsigned int>& m)
     {
         // Also brute force.
         float rmsd = 0.0;
 
         // a mapping between the vectors of m_ref_points and the vectors of points
-        BiMap<unsigned int, unsigned int> vec_map;
+        FlatBiMap<unsigned int, unsigned int> vec_map;
 
         // keeps track of whether m_ref_points have been matched to any point in points
         // guarantees 1-1 mapping
@@ -382,6 +406,273 @@ public:
     }
 
 private:
+    //! Register a block of candidate 3-point correspondences at once.
+    /*! Every candidate's 3x3 cross-covariance is accumulated into one flat
+     *  array so the compiler can vectorize across the batch, and the
+     *  rotations are then recovered analytically from the batched
+     *  trigonometric eigensolver applied to the covariance Gram matrices,
+     *  instead of running one Eigen JacobiSVD per candidate. A candidate
+     *  whose covariance is (nearly) rank deficient falls back to
+     *  KabschAlgorithm, which completes the singular basis properly.
+     *  Candidates are then scored with AlignedRMSDTree in their original
+     *  order, updating the best fit exactly as the one-at-a-time path
+     *  does. Returns true once a fit within tolerance is found, in which
+     *  case pts has been rotated into place.
+     */
+    bool FitCandidateBatch(const std::vector<std::array<size_t, 3>>& batch, const matrix& p,
+                           const matrix& points, std::vector<vec3<float>>& pts, double& rmsd_min)
+    {
+        const auto num = static_cast<unsigned int>(batch.size());
+        util::ManagedArray<float> covariances({num, 3, 3});
+        util::ManagedArray<float> grams({num, 3, 3});
+        for (unsigned int b = 0; b < num; b++)
+        {
+            // Cross-covariance A = Q^T P over the three matched points,
+            // where Q holds the candidate points and P the references.
+            for (unsigned int row = 0; row < 3; row++)
+            {
+                for (unsigned int col = 0; col < 3; col++)
+                {
+                    double sum = 0.0;
+                    for (unsigned int k = 0; k < 3; k++)
+                    {
+                        sum += points(int(batch[b][k]), int(row)) * p(int(k), int(col));
+                    }
+                    covariances(b, row, col) = float(sum);
+                }
+            }
+            // Gram matrix A^T A, whose eigenvectors are the right
+            // singular vectors of A.
+            for (unsigned int row = 0; row < 3; row++)
+            {
+                for (unsigned int col = 0; col < 3; col++)
+                {
+                    double sum = 0.0;
+                    for (unsigned int k = 0; k < 3; k++)
+                    {
+                        sum += double(covariances(b, k, row)) * double(covariances(b, k, col));
+                    }
+                    grams(b, row, col) = float(sum);
+                }
+            }
+        }
+        util::ManagedArray<float> eigen_vals({num, 3});
+        util::ManagedArray<float> eigen_vecs({num, 3, 3});
+        util::diagonalize33SymmetricMatrices(grams, eigen_vals, eigen_vecs);
+
+        for (unsigned int b = 0; b < num; b++)
+        {
+            matrix r(3, 3);
+            // Eigenvalues arrive in ascending order; the singular values
+            // of A are the square roots of the refined Rayleigh quotients
+            // computed below.
+            double sigma[3]; // NOLINT(modernize-avoid-c-arrays)
+            // Refine the single-precision eigenpairs of the batch solve in
+            // double before building the rotation: a Rayleigh quotient for
+            // each eigenvalue and the eigenvector from the largest cross
+            // product of the rows of (G - lambda I). The refined frame is
+            // then re-orthonormalized. Nearly degenerate directions leave
+            // all cross products tiny; those keep the batch solver's
+            // vectors.
+            double g[3][3];     // NOLINT(modernize-avoid-c-arrays)
+            double v[3][3];     // NOLINT(modernize-avoid-c-arrays)
+            double scale = 0.0;
+            for (unsigned int row = 0; row < 3; row++)
+            {
+                for (unsigned int col = 0; col < 3; col++)
+                {
+                    double sum = 0.0;
+                    for (unsigned int k = 0; k < 3; k++)
+                    {
+                        sum += double(covariances(b, k, row)) * double(covariances(b, k, col));
+                    }
+                    g[row][col] = sum;
+                    scale = std::max(scale, std::abs(sum));
+                }
+            }
+            for (unsigned int i = 0; i < 3; i++)
+            {
+                for (unsigned int col = 0; col < 3; col++)
+                {
+                    v[i][col] = double(eigen_vecs(b, i, col));
+                }
+            }
+            // two passes: the second squares the accuracy of the first
+            for (unsigned int pass = 0; pass < 2; pass++)
+            {
+                for (unsigned int i = 0; i < 3; i++)
+                {
+                    double lambda = 0.0;
+                    for (unsigned int row = 0; row < 3; row++)
+                    {
+                        for (unsigned int col = 0; col < 3; col++)
+                        {
+                            lambda += v[i][row] * g[row][col] * v[i][col];
+                        }
+                    }
+                    // rows of (G - lambda I) and their pairwise cross products
+                    double m[3][3]; // NOLINT(modernize-avoid-c-arrays)
+                    for (unsigned int row = 0; row < 3; row++)
+                    {
+                        for (unsigned int col = 0; col < 3; col++)
+                        {
+                            m[row][col] = g[row][col] - (row == col ? lambda : 0.0);
+                        }
+                    }
+                    double best[3] = {0.0, 0.0, 0.0}; // NOLINT(modernize-avoid-c-arrays)
+                    double best_norm_sq = 0.0;
+                    for (unsigned int r1 = 0; r1 < 2; r1++)
+                    {
+                        for (unsigned int r2 = r1 + 1; r2 < 3; r2++)
+                        {
+                            const double cx = m[r1][1] * m[r2][2] - m[r1][2] * m[r2][1];
+                            const double cy = m[r1][2] * m[r2][0] - m[r1][0] * m[r2][2];
+                            const double cz = m[r1][0] * m[r2][1] - m[r1][1] * m[r2][0];
+                            const double norm_sq = cx * cx + cy * cy + cz * cz;
+                            if (norm_sq > best_norm_sq)
+                            {
+                                best[0] = cx;
+                                best[1] = cy;
+                                best[2] = cz;
+                                best_norm_sq = norm_sq;
+                            }
+                        }
+                    }
+                    if (best_norm_sq > 1e-14 * scale * scale)
+                    {
+                        const double inv_norm = 1.0 / std::sqrt(best_norm_sq);
+                        // keep the orientation of the unrefined vector
+                        const double sign
+                            = (best[0] * v[i][0] + best[1] * v[i][1] + best[2] * v[i][2]) < 0.0 ? -1.0 : 1.0;
+                        for (unsigned int col = 0; col < 3; col++)
+                        {
+                            v[i][col] = sign * best[col] * inv_norm;
+                        }
+                    }
+                }
+            }
+            // re-orthonormalize: keep v2, project it out of v1, and close
+            // the frame with their cross product.
+            double dot12 = v[1][0] * v[2][0] + v[1][1] * v[2][1] + v[1][2] * v[2][2];
+            double norm1 = 0.0;
+            for (unsigned int col = 0; col < 3; col++)
+            {
+                v[1][col] -= dot12 * v[2][col];
+                norm1 += v[1][col] * v[1][col];
+            }
+            if (norm1 > 0.0)
+            {
+                const double inv_norm = 1.0 / std::sqrt(norm1);
+                for (unsigned int col = 0; col < 3; col++)
+                {
+                    v[1][col] *= inv_norm;
+                }
+            }
+            v[0][0] = v[2][1] * v[1][2] - v[2][2] * v[1][1];
+            v[0][1] = v[2][2] * v[1][0] - v[2][0] * v[1][2];
+            v[0][2] = v[2][0] * v[1][1] - v[2][1] * v[1][0];
+            // refined singular values from the Rayleigh quotients
+            for (unsigned int i = 0; i < 3; i++)
+            {
+                double lambda = 0.0;
+                for (unsigned int row = 0; row < 3; row++)
+                {
+                    for (unsigned int col = 0; col < 3; col++)
+                    {
+                        lambda += v[i][row] * g[row][col] * v[i][col];
+                    }
+                }
+                sigma[i] = std::sqrt(std::max(0.0, lambda));
+            }
+
+            if (sigma[2] > 0.0 && sigma[0] > 1e-6 * sigma[2])
+            {
+                // With A = U S V^T, the optimal rotation is V U^T. The
+                // right singular vectors v_i are the rows refined above;
+                // u_i = A v_i / sigma_i. If the product is improper, flip
+                // the smallest singular direction (index 0), exactly as
+                // KabschAlgorithm flips the last column of V.
+                double u[3][3]; // NOLINT(modernize-avoid-c-arrays)
+                for (unsigned int i = 0; i < 3; i++)
+                {
+                    for (unsigned int row = 0; row < 3; row++)
+                    {
+                        double sum = 0.0;
+                        for (unsigned int col = 0; col < 3; col++)
+                        {
+                            sum += double(covariances(b, row, col)) * v[i][col];
+                        }
+                        u[i][row] = sum / sigma[i];
+                    }
+                }
+                double rot[3][3]; // NOLINT(modernize-avoid-c-arrays)
+                for (unsigned int row = 0; row < 3; row++)
+                {
+                    for (unsigned int col = 0; col < 3; col++)
+                    {
+                        double sum = 0.0;
+                        for (unsigned int i = 0; i < 3; i++)
+                        {
+                            sum += v[i][row] * u[i][col];
+                        }
+                        rot[row][col] = sum;
+                    }
+                }
+                const double det = rot[0][0] * (rot[1][1] * rot[2][2] - rot[1][2] * rot[2][1])
+                    - rot[0][1] * (rot[1][0] * rot[2][2] - rot[1][2] * rot[2][0])
+                    + rot[0][2] * (rot[1][0] * rot[2][1] - rot[1][1] * rot[2][0]);
+                if (det < 0)
+                {
+                    for (unsigned int row = 0; row < 3; row++)
+                    {
+                        for (unsigned int col = 0; col < 3; col++)
+                        {
+                            rot[row][col] -= 2.0 * v[0][row] * u[0][col];
+                        }
+                    }
+                }
+                for (unsigned int row = 0; row < 3; row++)
+                {
+                    for (unsigned int col = 0; col < 3; col++)
+                    {
+                        r(int(row), int(col)) = rot[row][col];
+                    }
+                }
+            }
+            else
+            {
+                matrix q(3, 3);
+                for (unsigned int k = 0; k < 3; k++)
+                {
+                    for (unsigned int col = 0; col < 3; col++)
+                    {
+                        q(int(k), int(col)) = points(int(batch[b][k]), int(col));
+                    }
+                }
+                KabschAlgorithm(q, p, r);
+            }
+
+            // The rotation acts on P^T, just as in the one-at-a-time path.
+            matrix rot_points = Rotate(r, points.transpose());
+            FlatBiMap<unsigned int, unsigned int> vec_map;
+            float rmsd = AlignedRMSDTree(rot_points.transpose(), vec_map);
+            if (rmsd < rmsd_min || rmsd_min < 0.0)
+            {
+                m_rmsd = rmsd;
+                m_rotation = r;
+                m_vec_map = vec_map;
+                rmsd_min = m_rmsd;
+                if (rmsd_min < m_tol)
+                {
+                    matrix ptsT = Rotate(m_rotation, points.transpose());
+                    pts = makeVec3Matrix(ptsT.transpose());
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     static vec3<float> make_point(const Eigen::VectorXd& row)
     {
         if (row.rows() == 2)
@@ -471,7 +762,8 @@ private:
     float m_rmsd {0.0};
     double m_tol {1e-6};
     size_t m_shuffles {1};
-    BiMap<unsigned int, unsigned int>
+    static constexpr size_t m_batch_size {64}; //! Candidates registered per batch in Fit.
+    FlatBiMap<unsigned int, unsigned int>
         m_vec_map; //! The mapping between indices of the two sets of points ref_points->points (where
                    //! "ref_points" are those that RegisterBruteForce was constructed with and "points" are
                    //! those passed to Fit).
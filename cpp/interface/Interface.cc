@@ -0,0 +1,82 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include "Interface.h"
+#include "NeighborComputeFunctional.h"
+#include "ThreadStorage.h"
+#include "utils.h"
+
+/*! \file Interface.cc
+    \brief Compute the particles at the interface between two sets of points.
+*/
+
+namespace freud { namespace interface {
+
+namespace {
+
+//! Compact the true entries of a mask into a sorted id array.
+void maskToIds(const util::ManagedArray<bool>& mask, util::ManagedArray<unsigned int>& ids)
+{
+    unsigned int count(0);
+    for (unsigned int i = 0; i < mask.size(); ++i)
+    {
+        count += mask[i] ? 1 : 0;
+    }
+    ids.prepare(count);
+    unsigned int insert_pos(0);
+    for (unsigned int i = 0; i < mask.size(); ++i)
+    {
+        if (mask[i])
+        {
+            ids[insert_pos++] = i;
+        }
+    }
+}
+
+} // namespace
+
+void Interface::compute(const freud::locality::NeighborQuery* neighbor_query,
+                        const vec3<float>* query_points, unsigned int n_query_points,
+                        const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    const unsigned int n_points = neighbor_query->getNPoints();
+    m_point_mask.prepare(n_points);
+    m_query_point_mask.prepare(n_query_points);
+
+    // Bonds touching the same point may be visited by different threads, so
+    // membership is flagged in thread-local masks that are OR-reduced into
+    // the outputs afterwards.
+    util::ThreadStorage<bool> local_point_mask(n_points);
+    util::ThreadStorage<bool> local_query_point_mask(n_query_points);
+
+    freud::locality::loopOverNeighbors(
+        neighbor_query, query_points, n_query_points, qargs, nlist,
+        [&](const freud::locality::NeighborBond& neighbor_bond) {
+            local_point_mask.local()[neighbor_bond.point_idx] = true;
+            local_query_point_mask.local()[neighbor_bond.query_point_idx] = true;
+        });
+
+    for (auto mask = local_point_mask.begin(); mask != local_point_mask.end(); ++mask)
+    {
+        util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_point_mask[i] = m_point_mask[i] || (*mask)[i];
+            }
+        });
+    }
+    for (auto mask = local_query_point_mask.begin(); mask != local_query_point_mask.end(); ++mask)
+    {
+        util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_query_point_mask[i] = m_query_point_mask[i] || (*mask)[i];
+            }
+        });
+    }
+
+    maskToIds(m_point_mask, m_point_ids);
+    maskToIds(m_query_point_mask, m_query_point_ids);
+}
+
+}; }; // end namespace freud::interface
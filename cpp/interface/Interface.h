@@ -0,0 +1,77 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef INTERFACE_H
+#define INTERFACE_H
+
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file Interface.h
+    \brief Compute the particles at the interface between two sets of points.
+*/
+
+namespace freud { namespace interface {
+
+//! Find the particles at the interface between two sets of points.
+/*! A point is on the interface if it participates in at least one neighbor
+ *  bond between the two sets. Membership is flagged directly during the
+ *  neighbor loop into boolean masks, so no neighbor indices ever need to be
+ *  exported and deduplicated outside the compute.
+ */
+class Interface
+{
+public:
+    Interface() = default;
+
+    //! Compute the interface between the points and the query points.
+    void compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                 unsigned int n_query_points, const freud::locality::NeighborList* nlist,
+                 freud::locality::QueryArgs qargs);
+
+    //! Get a mask over points that is true for points on the interface.
+    const util::ManagedArray<bool>& getPointMask() const
+    {
+        return m_point_mask;
+    }
+
+    //! Get a mask over query points that is true for query points on the interface.
+    const util::ManagedArray<bool>& getQueryPointMask() const
+    {
+        return m_query_point_mask;
+    }
+
+    //! Get the sorted ids of the points on the interface.
+    const util::ManagedArray<unsigned int>& getPointIds() const
+    {
+        return m_point_ids;
+    }
+
+    //! Get the sorted ids of the query points on the interface.
+    const util::ManagedArray<unsigned int>& getQueryPointIds() const
+    {
+        return m_query_point_ids;
+    }
+
+    unsigned int getPointCount() const
+    {
+        return m_point_ids.size();
+    }
+
+    unsigned int getQueryPointCount() const
+    {
+        return m_query_point_ids.size();
+    }
+
+private:
+    util::ManagedArray<bool> m_point_mask;            //!< Interface membership of each point
+    util::ManagedArray<bool> m_query_point_mask;      //!< Interface membership of each query point
+    util::ManagedArray<unsigned int> m_point_ids;     //!< Ids of points on the interface
+    util::ManagedArray<unsigned int> m_query_point_ids; //!< Ids of query points on the interface
+};
+
+}; }; // end namespace freud::interface
+
+#endif // INTERFACE_H
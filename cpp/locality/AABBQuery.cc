@@ -8,8 +8,9 @@
 
 namespace freud { namespace locality {
 
-AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points)
-    : NeighborQuery(box, points, n_points)
+AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                     bool spatial_sort)
+    : NeighborQuery(box, points, n_points, spatial_sort)
 {
     // Allocate memory and create image vectors
     setupTree(m_n_points);
@@ -38,9 +39,75 @@ AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_i
     throw std::runtime_error("Invalid query mode provided to query function in AABBQuery.");
 }
 
+void AABBQuery::updatePoints(const vec3<float>* points, unsigned int n_points, float margin)
+{
+    if (n_points == 0)
+    {
+        throw std::invalid_argument("Cannot update an AABBQuery with 0 particles.");
+    }
+    if (spatialSortEnabled())
+    {
+        // Refitting relies on the stored order matching the new array, which a
+        // persistent sort breaks; rebuilding would discard the refit benefit.
+        throw std::runtime_error("updatePoints is not supported on a spatially sorted AABBQuery.");
+    }
+
+    // A changed particle count or fattening radius invalidates the stored topology.
+    const bool rebuild_required
+        = (n_points != m_n_points) || (margin != m_margin) || (m_ref_points.size() != n_points);
+
+    m_margin = margin;
+    m_points = points;
+    m_n_points = n_points;
+
+    if (rebuild_required)
+    {
+        setupTree(n_points);
+        buildTree(points, n_points);
+        return;
+    }
+
+    // Find the maximum displacement since the AABBs were last fattened.
+    float max_disp_sq(0);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        vec3<float> new_pos(points[i]);
+        if (m_box.is2D())
+        {
+            if (std::abs(new_pos.z) > 1e-6)
+            {
+                throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
+            }
+            new_pos.z = 0;
+        }
+        const vec3<float> dr = m_box.wrap(new_pos - m_ref_points[i]);
+        max_disp_sq = std::max(max_disp_sq, dot(dr, dr));
+    }
+    const float max_disp = std::sqrt(max_disp_sq);
+
+    if (max_disp < margin)
+    {
+        // The fattened AABBs still enclose every point, so the tree is valid as-is.
+        return;
+    }
+
+    if (margin > float(0.0) && max_disp > float(3.0) * margin)
+    {
+        // Points have drifted far enough that the build-time partitioning no
+        // longer reflects their positions and query performance would degrade,
+        // so pay for a full rebuild.
+        buildTree(points, n_points);
+    }
+    else
+    {
+        refitTree(points, n_points);
+    }
+}
+
 void AABBQuery::setupTree(unsigned int Np)
 {
     m_aabbs.resize(Np);
+    m_ref_points.resize(Np);
 }
 
 void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
@@ -54,13 +121,49 @@ void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
         {
             my_pos.z = 0;
         }
-        m_aabbs[i] = AABB(my_pos, i);
+        if (m_margin > float(0.0))
+        {
+            m_aabbs[i] = AABB(my_pos, m_margin);
+            m_aabbs[i].tag = i;
+        }
+        else
+        {
+            m_aabbs[i] = AABB(my_pos, i);
+        }
+        m_ref_points[i] = my_pos;
     }
 
     // Call the tree build routine, one tree per type
     m_aabb_tree.buildTree(m_aabbs.data(), Np);
 }
 
+void AABBQuery::refitTree(const vec3<float>* points, unsigned int Np)
+{
+    // Recompute the fattened point AABBs in place. The AABBs are regenerated
+    // in particle index order, which is the order the original buildTree call
+    // saw them in, so the indices stored in the tree nodes remain valid.
+    for (unsigned int i = 0; i < Np; ++i)
+    {
+        vec3<float> my_pos(points[i]);
+        if (m_box.is2D())
+        {
+            my_pos.z = 0;
+        }
+        if (m_margin > float(0.0))
+        {
+            m_aabbs[i] = AABB(my_pos, m_margin);
+            m_aabbs[i].tag = i;
+        }
+        else
+        {
+            m_aabbs[i] = AABB(my_pos, i);
+        }
+        m_ref_points[i] = my_pos;
+    }
+
+    m_aabb_tree.refit(m_aabbs.data(), Np);
+}
+
 void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
 {
 
@@ -130,6 +233,62 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
     }
 }
 
+/*! \param node_idx Index of the leaf node to process
+    \param pos_i_image Position of the query point image
+
+    Copies the candidate positions in the leaf into SoA displacement arrays
+   and computes all of their squared distances to the query point in one pass.
+   With up to NODE_CAPACITY candidates per leaf this is where ball queries
+   spend most of their time, so the inner loop is written over contiguous
+   arrays that vectorize with AVX (8 lanes) or SSE (4 lanes) when available.
+   The results are cached in m_leaf_r_sq so that next() can keep returning
+   bonds one at a time as it drains the leaf.
+*/
+void AABBQueryBallIterator::computeLeafDistances(unsigned int node_idx, const vec3<float>& pos_i_image)
+{
+    CACHE_ALIGN float dx[NODE_CAPACITY];
+    CACHE_ALIGN float dy[NODE_CAPACITY];
+    CACHE_ALIGN float dz[NODE_CAPACITY];
+
+    const bool is_2d = m_neighbor_query->getBox().is2D();
+    const unsigned int num_particles = m_aabb_query->m_aabb_tree.getNodeNumParticles(node_idx);
+    for (unsigned int k = 0; k < num_particles; ++k)
+    {
+        const unsigned int j = m_aabb_query->m_aabb_tree.getNodeParticleTag(node_idx, k);
+        const vec3<float> pos_j((*m_neighbor_query)[j]);
+        dx[k] = pos_j.x - pos_i_image.x;
+        dy[k] = pos_j.y - pos_i_image.y;
+        dz[k] = is_2d ? float(0.0) : pos_j.z - pos_i_image.z;
+    }
+
+    unsigned int k = 0;
+#if defined(__AVX__)
+    for (; k + 8 <= num_particles; k += 8)
+    {
+        const __m256 x_v = _mm256_load_ps(dx + k);
+        const __m256 y_v = _mm256_load_ps(dy + k);
+        const __m256 z_v = _mm256_load_ps(dz + k);
+        const __m256 r_sq_v = _mm256_add_ps(_mm256_mul_ps(x_v, x_v),
+                                            _mm256_add_ps(_mm256_mul_ps(y_v, y_v), _mm256_mul_ps(z_v, z_v)));
+        _mm256_storeu_ps(m_leaf_r_sq.data() + k, r_sq_v);
+    }
+#elif defined(__SSE__)
+    for (; k + 4 <= num_particles; k += 4)
+    {
+        const __m128 x_v = _mm_load_ps(dx + k);
+        const __m128 y_v = _mm_load_ps(dy + k);
+        const __m128 z_v = _mm_load_ps(dz + k);
+        const __m128 r_sq_v
+            = _mm_add_ps(_mm_mul_ps(x_v, x_v), _mm_add_ps(_mm_mul_ps(y_v, y_v), _mm_mul_ps(z_v, z_v)));
+        _mm_storeu_ps(m_leaf_r_sq.data() + k, r_sq_v);
+    }
+#endif
+    for (; k < num_particles; ++k)
+    {
+        m_leaf_r_sq[k] = dx[k] * dx[k] + dy[k] * dy[k] + dz[k] * dz[k];
+    }
+}
+
 NeighborBond AABBQueryBallIterator::next()
 {
     float r_max_sq = m_r_max * m_r_max;
@@ -156,11 +315,18 @@ NeighborBond AABBQueryBallIterator::next()
             {
                 if (m_aabb_query->m_aabb_tree.isNodeLeaf(cur_node_idx))
                 {
+                    // Batch-compute the distances to all candidates when we
+                    // first enter the leaf; drain the cached results below.
+                    if (cur_ref_p == 0)
+                    {
+                        computeLeafDistances(cur_node_idx, pos_i_image);
+                    }
                     while (cur_ref_p < m_aabb_query->m_aabb_tree.getNodeNumParticles(cur_node_idx))
                     {
                         // Neighbor j
                         const unsigned int j
                             = m_aabb_query->m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
+                        const float r_sq = m_leaf_r_sq[cur_ref_p];
                         // Increment before possible return.
                         cur_ref_p++;
 
@@ -170,17 +336,6 @@ NeighborBond AABBQueryBallIterator::next()
                             continue;
                         }
 
-                        // Read in the position of j
-                        vec3<float> pos_j((*m_neighbor_query)[j]);
-                        if (m_neighbor_query->getBox().is2D())
-                        {
-                            pos_j.z = 0;
-                        }
-
-                        // Compute distance
-                        const vec3<float> r_ij = pos_j - pos_i_image;
-                        const float r_sq = dot(r_ij, r_ij);
-
                         // Check ii exclusion before including the pair.
                         if (r_sq < r_max_sq && r_sq >= r_min_sq)
                         {
@@ -278,6 +433,10 @@ NeighborBond AABBQueryIterator::next()
             if (m_current_neighbors.size() >= m_num_neighbors)
             {
                 std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
+                // Teach the query object the distance that actually enclosed
+                // k neighbors so later queries start close to it.
+                m_aabb_query->reportNeighborDistance(m_num_neighbors,
+                                                     m_current_neighbors[m_num_neighbors - 1].distance);
                 break;
             }
 
@@ -297,6 +456,11 @@ NeighborBond AABBQueryIterator::next()
                     }
                 }
                 std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
+                if (m_current_neighbors.size() >= m_num_neighbors)
+                {
+                    m_aabb_query->reportNeighborDistance(m_num_neighbors,
+                                                         m_current_neighbors[m_num_neighbors - 1].distance);
+                }
                 break;
             }
 
@@ -4,6 +4,8 @@
 #ifndef AABBQUERY_H
 #define AABBQUERY_H
 
+#include <array>
+#include <atomic>
 #include <cmath>
 #include <map>
 #include <memory>
@@ -36,7 +38,12 @@ public:
     AABBQuery();
 
     //! New-style constructor.
-    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points);
+    /*! \param spatial_sort If true, the points are reordered along a Morton
+     *             curve before the tree is built so that tree leaves reference
+     *             contiguous position ranges (see NeighborQuery).
+     */
+    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+              bool spatial_sort = false);
 
     //! Destructor
     ~AABBQuery() override;
@@ -49,6 +56,39 @@ public:
     std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
+    //! Update the points and refit or rebuild the tree as needed.
+    /*! For trajectory replay where particles move only a small amount between
+     *  frames, this is much cheaper than constructing a new AABBQuery, since
+     *  the tree topology from the previous frame is reused whenever possible.
+     *
+     *  \param points The new point positions (must remain valid while queries are performed).
+     *  \param n_points The number of points.
+     *  \param margin Fattening radius for the leaf AABBs. When every point has
+     *                moved less than this distance since the last refit, the
+     *                fattened AABBs still enclose all points and the tree is
+     *                left untouched; pass the expected per-frame displacement.
+     */
+    void updatePoints(const vec3<float>* points, unsigned int n_points, float margin = 0.0);
+
+    //! Feed back the k-th neighbor distance observed by a completed
+    //  nearest-k query. The blended estimate seeds the initial search radius
+    //  of subsequent queries so they rarely need to re-traverse with an
+    //  expanded ball, and it persists across updatePoints calls so replayed
+    //  trajectories start each frame with a near-correct radius. The update
+    //  is deliberately racy: the estimate is only a heuristic, so query
+    //  threads blend into it without synchronization.
+    void reportNeighborDistance(unsigned int num_neighbors, float distance) const
+    {
+        const float old_estimate = m_learned_r_guess.load(std::memory_order_relaxed);
+        float new_estimate = distance;
+        if (old_estimate > 0 && m_learned_num_neighbors.load(std::memory_order_relaxed) == num_neighbors)
+        {
+            new_estimate = float(0.75) * old_estimate + float(0.25) * distance;
+        }
+        m_learned_r_guess.store(new_estimate, std::memory_order_relaxed);
+        m_learned_num_neighbors.store(num_neighbors, std::memory_order_relaxed);
+    }
+
     AABBTree m_aabb_tree; //!< AABB tree of points
 
 protected:
@@ -72,15 +112,37 @@ protected:
 
             if (args.r_guess == DEFAULT_R_GUESS)
             {
-                // By default, we assume a homogeneous system density and use
-                // that to estimate the distance we need to query. This
-                // calculation assumes a constant density of N/V, where N is
-                // the number of particles and V is the box volume, and it
-                // calculates the radius of a sphere that will contain the
-                // desired number of neighbors.
-                float r_guess = std::cbrtf(
-                    (float(3.0) * static_cast<float>(args.num_neighbors) * m_box.getVolume())
-                    / (float(4.0) * static_cast<float>(M_PI) * static_cast<float>(getNPoints())));
+                float r_guess(0);
+                const float learned_r_guess = m_learned_r_guess.load(std::memory_order_relaxed);
+                if (learned_r_guess > 0)
+                {
+                    // Previous nearest-k queries have reported the k-th
+                    // neighbor distances they actually found, so start from
+                    // that learned estimate (with a little headroom so the
+                    // first ball query usually succeeds). If the requested
+                    // neighbor count differs from the learned one, rescale
+                    // assuming homogeneous density.
+                    const unsigned int learned_num_neighbors
+                        = m_learned_num_neighbors.load(std::memory_order_relaxed);
+                    r_guess = learned_r_guess * float(1.05);
+                    if (learned_num_neighbors != args.num_neighbors)
+                    {
+                        r_guess *= std::cbrtf(static_cast<float>(args.num_neighbors)
+                                              / static_cast<float>(learned_num_neighbors));
+                    }
+                }
+                else
+                {
+                    // With no history, we assume a homogeneous system density
+                    // and use that to estimate the distance we need to query.
+                    // This calculation assumes a constant density of N/V,
+                    // where N is the number of particles and V is the box
+                    // volume, and it calculates the radius of a sphere that
+                    // will contain the desired number of neighbors.
+                    r_guess = std::cbrtf(
+                        (float(3.0) * static_cast<float>(args.num_neighbors) * m_box.getVolume())
+                        / (float(4.0) * static_cast<float>(M_PI) * static_cast<float>(getNPoints())));
+                }
 
                 // The upper bound is set by the minimum nearest plane distances.
                 vec3<float> nearest_plane_distance = m_box.getNearestPlaneDistance();
@@ -110,7 +172,15 @@ private:
     //! Driver to build AABB trees
     void buildTree(const vec3<float>* points, unsigned int N);
 
-    std::vector<AABB> m_aabbs; //!< Flat array of AABBs of all types
+    //! Recompute the fattened point AABBs and refit the existing tree topology
+    void refitTree(const vec3<float>* points, unsigned int N);
+
+    std::vector<AABB> m_aabbs;              //!< Flat array of AABBs of all types
+    std::vector<vec3<float>> m_ref_points;  //!< Positions enclosed by the current (fattened) AABBs
+    float m_margin {0};                     //!< Fattening radius applied to the leaf AABBs
+    mutable std::atomic<float> m_learned_r_guess {0}; //!< Blended k-th neighbor distance from past queries
+    mutable std::atomic<unsigned int> m_learned_num_neighbors {
+        0}; //!< Neighbor count the learned radius was observed for
 };
 
 //! Parent class of AABB iterators that knows how to traverse general AABB tree structures.
@@ -194,10 +264,15 @@ public:
     NeighborBond next() override;
 
 private:
+    //! Compute squared distances to all candidates in a leaf node in one vectorized batch.
+    void computeLeafDistances(unsigned int node_idx, const vec3<float>& pos_i_image);
+
     unsigned int cur_image;    //!< The current node in the tree.
     unsigned int cur_node_idx; //!< The current node in the tree.
     unsigned int
         cur_ref_p; //!< The current index into the reference particles in the current node of the tree.
+    std::array<float, NODE_CAPACITY>
+        m_leaf_r_sq {}; //!< Squared distances to the candidates in the current leaf node.
 };
 }; }; // end namespace freud::locality
 
@@ -4,10 +4,16 @@
 #ifndef AABB_TREE_H
 #define AABB_TREE_H
 
+#include <algorithm>
 #include <array>
 #include <cstring>
+#include <memory>
 #include <stack>
 #include <stdexcept>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/task_group.h>
+#include <utility>
 #include <vector>
 
 #include "AABB.h"
@@ -30,6 +36,30 @@ namespace freud { namespace locality {
 
 constexpr unsigned int NODE_CAPACITY = 16;        //!< Maximum number of particles in a node
 constexpr unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
+constexpr unsigned int PARALLEL_BUILD_GRAIN
+    = 4096; //!< Subtree size below which tree construction stays serial
+
+//! Temporary record describing a subtree during a parallel tree build
+/*! The parallel build first partitions particles into subtrees without
+ *  touching the node array, recording the result in a tree of these records,
+ *  and then emits the records into the flat node array in pre-order.
+ *
+ *  The bounds are stored as plain vectors rather than as an AABB: AABB
+ *  carries extended (32-byte) alignment that plain operator new does not
+ *  honor under C++14, so a heap-allocated record holding one would make the
+ *  aligned SSE loads in its accessors undefined. emitNode() forms the
+ *  aligned AABB only when writing into the node array.
+ */
+struct AABBBuildRecord
+{
+    vec3<float> lower;                     //!< Lower corner of the box bounding this subtree
+    vec3<float> upper;                     //!< Upper corner of the box bounding this subtree
+    unsigned int start {0};                //!< First index of the subtree's range in aabbs/idx
+    unsigned int len {0};                  //!< Number of particles in the subtree's range
+    unsigned int count {1};                //!< Total number of nodes in the subtree
+    std::unique_ptr<AABBBuildRecord> left; //!< Left child record (null for leaves)
+    std::unique_ptr<AABBBuildRecord> right; //!< Right child record (null for leaves)
+};
 
 //! Node in an AABBTree
 /*! Stores data for a node in the AABB tree
@@ -158,6 +188,9 @@ public:
     //! Build a tree smartly from a list of AABBs
     inline void buildTree(AABB* aabbs, unsigned int N);
 
+    //! Refit every node AABB to a new set of particle AABBs, keeping the topology
+    inline void refit(const AABB* aabbs, unsigned int N);
+
     //! Find all particles that overlap with the query AABB
     inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
@@ -252,6 +285,14 @@ private:
     inline unsigned int buildNode(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
                                   unsigned int len, unsigned int parent);
 
+    //! Partition particles into subtrees in parallel without allocating nodes
+    static inline std::unique_ptr<AABBBuildRecord> partitionNode(AABB* aabbs, std::vector<unsigned int>& idx,
+                                                                 unsigned int start, unsigned int len);
+
+    //! Emit a tree of build records into the flat node array in pre-order
+    inline unsigned int emitNode(const AABBBuildRecord* record, AABB* aabbs,
+                                 const std::vector<unsigned int>& idx, unsigned int parent);
+
     //! Allocate a new node
     inline unsigned int allocateNode();
 
@@ -392,8 +433,234 @@ inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
         idx.push_back(i);
     }
 
-    m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
-    updateSkip(m_root);
+    if (N > PARALLEL_BUILD_GRAIN)
+    {
+        // Partition particles into subtrees with TBB tasks, then emit the
+        // resulting records serially so the node array layout (pre-order,
+        // with skip values) is identical to the serial build.
+        std::unique_ptr<AABBBuildRecord> record = partitionNode(aabbs, idx, 0, N);
+        m_root = emitNode(record.get(), aabbs, idx, INVALID_NODE);
+    }
+    else
+    {
+        m_root = buildNode(aabbs, idx, 0, N, INVALID_NODE);
+        updateSkip(m_root);
+    }
+}
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+
+    Performs the same median-split recursion as buildNode(), but records the
+   result in AABBBuildRecord objects instead of allocating tree nodes, so
+   sibling subtrees (which own disjoint subranges of aabbs and idx) can be
+   partitioned concurrently. Subtrees larger than PARALLEL_BUILD_GRAIN spawn a
+   TBB task for their left child; smaller ones recurse serially to keep task
+   overhead bounded. The bounding box merge for large ranges similarly uses a
+   parallel reduction so the top levels of the tree do not serialize the build.
+*/
+inline std::unique_ptr<AABBBuildRecord> AABBTree::partitionNode(AABB* aabbs, std::vector<unsigned int>& idx,
+                                                                unsigned int start, unsigned int len)
+{
+    std::unique_ptr<AABBBuildRecord> record(new AABBBuildRecord());
+    record->start = start;
+    record->len = len;
+
+    // merge all the AABBs into one. The merged box is carried as a plain
+    // (lower, upper) pair rather than an AABB so that neither the records
+    // nor TBB's internal task storage ever hold the extended-alignment type
+    // in memory that plain operator new provided.
+    using Bounds = std::pair<vec3<float>, vec3<float>>;
+    const auto merge_bounds = [](Bounds a, const Bounds& b) {
+        a.first.x = std::min(a.first.x, b.first.x);
+        a.first.y = std::min(a.first.y, b.first.y);
+        a.first.z = std::min(a.first.z, b.first.z);
+        a.second.x = std::max(a.second.x, b.second.x);
+        a.second.y = std::max(a.second.y, b.second.y);
+        a.second.z = std::max(a.second.z, b.second.z);
+        return a;
+    };
+    Bounds bounds(aabbs[start].getLower(), aabbs[start].getUpper());
+    if (len > PARALLEL_BUILD_GRAIN)
+    {
+        bounds = tbb::parallel_reduce(
+            tbb::blocked_range<unsigned int>(start + 1, start + len), bounds,
+            [aabbs, &merge_bounds](const tbb::blocked_range<unsigned int>& r, Bounds running) {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                    running = merge_bounds(running, Bounds(aabbs[i].getLower(), aabbs[i].getUpper()));
+                }
+                return running;
+            },
+            merge_bounds);
+    }
+    else
+    {
+        for (unsigned int i = 1; i < len; i++)
+        {
+            bounds = merge_bounds(bounds, Bounds(aabbs[start + i].getLower(), aabbs[start + i].getUpper()));
+        }
+    }
+    record->lower = bounds.first;
+    record->upper = bounds.second;
+
+    // handle the case of a leaf node creation
+    if (len <= NODE_CAPACITY)
+    {
+        return record;
+    }
+
+    // need to split the list of aabbs into two sets for left and right
+    unsigned int start_right = len;
+
+    // if there are only 2 aabbs, put one on each side
+    if (len != 2)
+    {
+        // otherwise, we need to split them based on a heuristic. split the longest dimension in half
+        const vec3<float> my_radius = record->upper - record->lower;
+        float vec3<float>::*axis = &vec3<float>::z;
+        if (my_radius.x > my_radius.y && my_radius.x > my_radius.z)
+        {
+            axis = &vec3<float>::x;
+        }
+        else if (my_radius.y > my_radius.z)
+        {
+            axis = &vec3<float>::y;
+        }
+        // Same arithmetic per component as AABB::getPosition().
+        const float split = float(0.5) * (record->lower.*axis + record->upper.*axis);
+
+        for (unsigned int i = 0; i < start_right; i++)
+        {
+            if (aabbs[start + i].getPosition().*axis >= split)
+            {
+                // if on the right side, swap the current aabb to the right
+                // partition and look at the swapped-in aabb next, exactly as
+                // in buildNode()
+                std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
+                std::swap(idx[start + i], idx[start + start_right - 1]);
+                start_right--;
+                i--;
+            }
+        }
+    }
+
+    // sanity check. The left or right tree may have ended up empty. If so, just borrow one particle from it
+    if (start_right == len)
+    {
+        start_right = len - 1;
+    }
+    if (start_right == 0)
+    {
+        start_right = 1;
+    }
+
+    if (len > PARALLEL_BUILD_GRAIN)
+    {
+        tbb::task_group g;
+        g.run([&] { record->left = partitionNode(aabbs, idx, start, start_right); });
+        record->right = partitionNode(aabbs, idx, start + start_right, len - start_right);
+        g.wait();
+    }
+    else
+    {
+        record->left = partitionNode(aabbs, idx, start, start_right);
+        record->right = partitionNode(aabbs, idx, start + start_right, len - start_right);
+    }
+    record->count = 1 + record->left->count + record->right->count;
+
+    return record;
+}
+
+/*! \param record Build record describing the subtree to emit
+    \param aabbs List of AABBs, fully partitioned by partitionNode
+    \param idx List of indices, fully partitioned by partitionNode
+    \param parent Index of the parent node
+
+    Walks the build record tree in pre-order and allocates the corresponding
+   tree nodes, filling in the particle assignments, reverse mapping, and skip
+   values (the subtree node counts are known from the records, so no separate
+   updateSkip() pass is needed).
+*/
+inline unsigned int AABBTree::emitNode(const AABBBuildRecord* record, AABB* aabbs,
+                                       const std::vector<unsigned int>& idx, unsigned int parent)
+{
+    const unsigned int my_idx = allocateNode();
+
+    if (!record->left)
+    {
+        m_nodes[my_idx].aabb = AABB(record->lower, record->upper);
+        m_nodes[my_idx].parent = parent;
+        m_nodes[my_idx].num_particles = record->len;
+        m_nodes[my_idx].skip = 0;
+
+        for (unsigned int i = 0; i < record->len; i++)
+        {
+            // assign the particle indices into the leaf node
+            m_nodes[my_idx].particles[i] = idx[record->start + i];
+            m_nodes[my_idx].particle_tags[i] = aabbs[record->start + i].tag;
+
+            // assign the reverse mapping from particle indices to leaf node indices
+            m_mapping[idx[record->start + i]] = my_idx;
+        }
+
+        return my_idx;
+    }
+
+    // note: emitNode has side effects, the m_nodes array may be reallocated, so determine the left and
+    // right children before writing any fields of our node
+    const unsigned int new_left = emitNode(record->left.get(), aabbs, idx, my_idx);
+    const unsigned int new_right = emitNode(record->right.get(), aabbs, idx, my_idx);
+
+    m_nodes[my_idx].aabb = AABB(record->lower, record->upper);
+    m_nodes[my_idx].parent = parent;
+    m_nodes[my_idx].left = new_left;
+    m_nodes[my_idx].right = new_right;
+    m_nodes[my_idx].skip = record->count - 1;
+
+    return my_idx;
+}
+
+/*! \param aabbs List of AABBs for each particle, indexed as in the original buildTree() call
+    \param N Number of AABBs in the list
+
+    Recomputes the AABB of every node from a new set of particle AABBs while
+   keeping the existing topology, particle assignments, and skip values. Nodes
+   are allocated in pre-order by buildNode(), so children always have larger
+   indices than their parents and a single reverse sweep over the node array
+   visits children before parents. Unlike update(), refit() tightens AABBs
+   around the new particle positions rather than only growing them, so repeated
+   refits do not accumulate volume. The topology itself still reflects the
+   positions at build time, so callers should rebuild once particles have moved
+   far enough that query performance degrades.
+*/
+inline void AABBTree::refit(const AABB* aabbs, unsigned int N)
+{
+    if (N != m_mapping.size() || m_num_nodes == 0)
+    {
+        throw std::runtime_error(
+            "AABBTree::refit called before buildTree or with a different number of particles.");
+    }
+
+    for (unsigned int current_node_idx = m_num_nodes; current_node_idx-- > 0;)
+    {
+        AABBNode& node = m_nodes[current_node_idx];
+        if (node.left == INVALID_NODE)
+        {
+            AABB new_aabb = aabbs[node.particles[0]];
+            for (unsigned int i = 1; i < node.num_particles; i++)
+            {
+                new_aabb = merge(new_aabb, aabbs[node.particles[i]]);
+            }
+            node.aabb = new_aabb;
+        }
+        else
+        {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+        }
+    }
 }
 
 /*! \param aabbs List of AABBs
@@ -1,8 +1,19 @@
 #ifndef BOND_HISTOGRAM_COMPUTE_H
 #define BOND_HISTOGRAM_COMPUTE_H
 
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#include <vector>
+
 #include "Box.h"
 #include "Histogram.h"
+#include "Instrumentation.h"
 #include "NeighborComputeFunctional.h"
 #include "NeighborQuery.h"
 
@@ -22,15 +33,45 @@ public:
     //! Default constructor
     BondHistogramCompute() : m_box(box::Box()), m_histogram(), m_local_histograms() {}
 
+    //! Constructor selecting the thread-local storage scheme.
+    /*! \param sparse If true, subclasses construct their thread-local
+     *      histograms with pages allocated on first touch instead of dense
+     *      per-thread copies (see util::Histogram::ThreadLocalHistogram). At
+     *      fine binnings most bins are empty in any one frame, so this makes
+     *      high-resolution histograms feasible where the thread-count times
+     *      histogram-size dense allocation would not be. The counts are
+     *      identical to the dense storage.
+     *  \param async_reduce If true, each frame's thread-local counts are
+     *      drained into a carry array on a background task after the frame
+     *      accumulates, while the caller assembles the next frame into a
+     *      second buffer set. This hides the reduction latency during
+     *      trajectory averaging; the counts are identical since only integer
+     *      counts move.
+     */
+    explicit BondHistogramCompute(bool sparse, bool async_reduce = false)
+        : m_box(box::Box()), m_sparse(sparse), m_async_reduce(async_reduce)
+    {}
+
     //! Destructor
-    virtual ~BondHistogramCompute() = default;
+    virtual ~BondHistogramCompute()
+    {
+        // Any background compute or drain still references members of this
+        // object.
+        m_compute_tasks.wait();
+        m_reduction_tasks.wait();
+    }
 
     //! Reset the histogram to all zeros
     virtual void reset()
     {
+        m_compute_tasks.wait();
+        m_reduction_tasks.wait();
         m_local_histograms.reset();
+        m_local_histograms_back.reset();
+        m_carry.reset();
         m_frame_counter = 0;
         m_reduce = true;
+        ++m_result_generation;
     }
 
     //! Reduce thread-local arrays onto the primary data arrays.
@@ -42,23 +83,235 @@ public:
         return m_box;
     }
 
+    //! Confine this compute's parallel work to its own task arena.
+    /*! When set, accumulation and reduction submit their parallel loops to a
+     *  dedicated tbb::task_arena instead of the global one, so a heavyweight
+     *  analysis can be capped below the process-wide thread count (set with
+     *  freud.parallel) and cannot starve work running in other arenas.
+     *
+     *  \param max_concurrency The maximum number of threads the arena may
+     *             use.
+     *  \param priority Scheduling priority relative to other arenas:
+     *             negative for low, zero for normal, positive for high.
+     */
+    void setArena(unsigned int max_concurrency, int priority = 0)
+    {
+        auto arena_priority = tbb::task_arena::priority::normal;
+        if (priority < 0)
+        {
+            arena_priority = tbb::task_arena::priority::low;
+        }
+        else if (priority > 0)
+        {
+            arena_priority = tbb::task_arena::priority::high;
+        }
+        m_arena = std::make_unique<tbb::task_arena>(static_cast<int>(max_concurrency), 1, arena_priority);
+    }
+
+    //! Release the dedicated arena; parallel work runs in the global arena.
+    void clearArena()
+    {
+        m_arena.reset();
+    }
+
+    //! Submit a compute call to run asynchronously.
+    /*! Runs the given callable (typically a lambda invoking one of this
+     *  object's accumulate or compute methods) on a background task and
+     *  returns immediately, so the caller can overlap the analysis of one
+     *  frame with I/O for the next. This object is the handle on the result:
+     *  any getter routed through reduceAndReturn() blocks until the submitted
+     *  work finishes and then performs the usual lazy reduction, and
+     *  waitAsync() blocks without touching the results. Only one compute may
+     *  be in flight at a time, so a new submission first waits for the
+     *  previous one; the caller must keep the points and neighbor query alive
+     *  until the work completes.
+     */
+    template<typename Func> void computeAsync(Func compute_call)
+    {
+        m_compute_tasks.wait();
+        m_compute_tasks.run(std::move(compute_call));
+    }
+
+    //! Block until any asynchronously submitted compute has finished.
+    void waitAsync()
+    {
+        m_compute_tasks.wait();
+    }
+
     //! Return thing_to_return after reducing if necessary.
     template<typename U> U& reduceAndReturn(U& thing_to_return)
     {
+        m_compute_tasks.wait();
         if (m_reduce)
         {
+            const util::ComputeArenaScope arena_scope(m_arena.get());
+            const util::PhaseTimer timer(m_reduce_ns);
+            finalizeAsyncReduction();
             reduce();
+            if (util::instrumentationEnabled())
+            {
+                m_bins_reduced += m_histogram.size();
+                const auto& counts = m_histogram.getBinCounts();
+                unsigned long long total = 0;
+                for (size_t i = 0; i < counts.size(); ++i)
+                {
+                    total += counts[i];
+                }
+                m_bonds_binned = total;
+            }
         }
         m_reduce = false;
         return thing_to_return;
     }
 
+    //! Report this object's instrumentation counters.
+    /*! Only populated when the FREUD_INSTRUMENT environment variable is set
+     *  (see Instrumentation.h); otherwise all counters read zero. Times are
+     *  cumulative nanoseconds over the object's lifetime: accumulate_ns
+     *  covers the neighbor traversal and binning of accumulateGeneral, and
+     *  reduce_ns covers the lazy reductions triggered by result access.
+     *  bonds_binned is the total count in the reduced histogram at the last
+     *  reduction, bins_reduced the cumulative bins swept by reductions, and
+     *  managed_array_bytes the process-wide ManagedArray allocation tally.
+     */
+    std::map<std::string, unsigned long long> getInstrumentation() const
+    {
+        std::map<std::string, unsigned long long> counters;
+        counters["accumulate_ns"] = m_accumulate_ns;
+        counters["reduce_ns"] = m_reduce_ns;
+        counters["frames_accumulated"] = m_frames_accumulated;
+        counters["bonds_binned"] = m_bonds_binned;
+        counters["bins_reduced"] = m_bins_reduced;
+        counters["managed_array_bytes"] = util::managedArrayBytesAllocated().load();
+        return counters;
+    }
+
     //! Get a reference to the bin counts array
     const util::ManagedArray<unsigned int>& getBinCounts()
     {
         return reduceAndReturn(m_histogram.getBinCounts());
     }
 
+    //! Generation counter for zero-copy result views.
+    /*! Advances whenever the results change: once per accumulated frame and
+     *  on reset. A caller holding zero-copy views of the output arrays can
+     *  poll this to decide when to re-fetch instead of copying defensively:
+     *  reduction runs at most once per generation (the m_reduce flag), and a
+     *  reduction that would overwrite a buffer still referenced by an
+     *  outstanding view reallocates first (ManagedArray::prepare detaches
+     *  shared buffers), so stale views retain the generation they were
+     *  fetched from rather than mutating underneath the reader.
+     */
+    unsigned long long getResultGeneration() const
+    {
+        return m_result_generation;
+    }
+
+    //! Serialize this object's accumulation state to a compact buffer.
+    /*! The buffer holds five little-endian 64-bit fields (format version,
+     *  frame counter, point count, query point count, bin count), the seven
+     *  box parameters, and the raw 32-bit bin counts. Any pending
+     *  asynchronous work is finished and the histogram reduced first, so the
+     *  buffer is independent of the thread-local storage scheme and can be
+     *  shipped across processes (e.g. through an MPI reduction tree) and
+     *  merged on the receiving side with mergeSerializedState().
+     */
+    std::vector<unsigned char> serializeState()
+    {
+        const auto& counts = getBinCounts();
+        std::vector<unsigned char> buffer(STATE_HEADER_BYTES + counts.size() * sizeof(std::uint32_t));
+        const std::uint64_t header[5]
+            = {SERIALIZED_STATE_VERSION, m_frame_counter, m_n_points, m_n_query_points, counts.size()};
+        const vec3<float> box_l = m_box.getL();
+        const float box_params[7] = {box_l.x,
+                                     box_l.y,
+                                     box_l.z,
+                                     m_box.getTiltFactorXY(),
+                                     m_box.getTiltFactorXZ(),
+                                     m_box.getTiltFactorYZ(),
+                                     m_box.is2D() ? float(1.0) : float(0.0)};
+        std::memcpy(buffer.data(), header, sizeof(header));
+        std::memcpy(buffer.data() + sizeof(header), box_params, sizeof(box_params));
+        static_assert(STATE_HEADER_BYTES == sizeof(header) + sizeof(box_params),
+                      "Serialized state header layout mismatch.");
+        static_assert(sizeof(unsigned int) == sizeof(std::uint32_t),
+                      "Serialized bin counts assume 32-bit histogram counters.");
+        std::memcpy(buffer.data() + STATE_HEADER_BYTES, counts.get(),
+                    counts.size() * sizeof(std::uint32_t));
+        return buffer;
+    }
+
+    //! Merge a serialized accumulation state into this object.
+    /*! Bin counts and frame counters add, so subsequent reductions of the
+     *  merged object produce exactly the statistics of a single object that
+     *  had accumulated every frame itself, preserving the frame-weighted
+     *  normalization. The incoming state must describe the same histogram
+     *  and, unless this object is freshly reset, the same point counts,
+     *  since the normalizations are per-point; a freshly reset object adopts
+     *  the incoming box and point counts, so a zeroed instance can serve as
+     *  the root of a reduction tree.
+     */
+    void mergeSerializedState(const std::vector<unsigned char>& buffer)
+    {
+        m_compute_tasks.wait();
+        if (buffer.size() < STATE_HEADER_BYTES)
+        {
+            throw std::invalid_argument("The serialized histogram state is truncated.");
+        }
+        std::uint64_t header[5];
+        float box_params[7];
+        std::memcpy(header, buffer.data(), sizeof(header));
+        std::memcpy(box_params, buffer.data() + sizeof(header), sizeof(box_params));
+        if (header[0] != SERIALIZED_STATE_VERSION)
+        {
+            throw std::invalid_argument("Unknown serialized histogram state version.");
+        }
+        const auto nbins = static_cast<size_t>(header[4]);
+        if (nbins != m_histogram.size()
+            || buffer.size() != STATE_HEADER_BYTES + nbins * sizeof(std::uint32_t))
+        {
+            throw std::invalid_argument(
+                "The serialized histogram state does not match this object's binning.");
+        }
+        if (m_frame_counter == 0)
+        {
+            // A fresh aggregator adopts the incoming system parameters.
+            m_box = box::Box(box_params[0], box_params[1], box_params[2], box_params[3], box_params[4],
+                             box_params[5], box_params[6] != float(0.0));
+            m_n_points = static_cast<unsigned int>(header[2]);
+            m_n_query_points = static_cast<unsigned int>(header[3]);
+        }
+        else if (m_n_points != header[2] || m_n_query_points != header[3])
+        {
+            throw std::invalid_argument(
+                "Histogram states with different point counts cannot be merged.");
+        }
+
+        // The counts are added to this thread's local histogram so they
+        // survive future reductions (which rebuild the master histogram from
+        // the thread-local copies).
+        const auto* counts = reinterpret_cast<const std::uint32_t*>(buffer.data() + STATE_HEADER_BYTES);
+        for (size_t i = 0; i < nbins; ++i)
+        {
+            if (counts[i] != 0)
+            {
+                m_local_histograms.increment(i, counts[i]);
+            }
+        }
+        m_frame_counter += static_cast<unsigned int>(header[1]);
+        m_reduce = true;
+        ++m_result_generation;
+    }
+
+    //! Merge another compute object's accumulated state into this one.
+    /*! In-process convenience wrapper around the serialized form; see
+     *  mergeSerializedState() for the semantics and constraints.
+     */
+    void merge(BondHistogramCompute& other)
+    {
+        mergeSerializedState(other.serializeState());
+    }
+
     //! Return the bin centers.
     /*! This vector will be of size axis.size() for each axis.
      */
@@ -87,6 +340,18 @@ public:
         return m_histogram.getAxisSizes();
     }
 
+    //!< Whether thread-local histograms use first-touch pages
+    bool isSparse() const
+    {
+        return m_sparse;
+    }
+
+    //!< Whether frames are drained into the carry array asynchronously
+    bool isAsyncReduce() const
+    {
+        return m_async_reduce;
+    }
+
     //! \internal
     // Wrapper to do accumulation.
     /*! \param neighbor_query NeighborQuery object to iterate over
@@ -103,23 +368,122 @@ public:
                            locality::QueryArgs qargs, Func cf)
     {
         m_box = neighbor_query->getBox();
+        // All parallel loops issued below run inside the dedicated arena
+        // when one was requested with setArena().
+        const util::ComputeArenaScope arena_scope(m_arena.get());
+        const util::PhaseTimer timer(m_accumulate_ns);
+        if (util::instrumentationEnabled())
+        {
+            ++m_frames_accumulated;
+        }
         locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
-        m_frame_counter++;
-        m_n_points = neighbor_query->getNPoints();
+        finishFrame(neighbor_query, n_query_points);
+    }
+
+protected:
+    //! \internal
+    // Record a processed frame.
+    /*! Shared bookkeeping tail of accumulateGeneral: bumps the frame counter,
+     *  records the point counts, marks the histogram for reduction and kicks
+     *  off the background drain in async mode. Subclasses that bin a frame
+     *  through their own loop instead of the per-bond functor (e.g. the
+     *  batched RDF path) call this directly so every accumulation route stays
+     *  consistent.
+     */
+    void finishFrame(const locality::NeighborQuery* neighbor_query, unsigned int n_query_points)
+    {
+        finishFrames(1, neighbor_query->getNPoints(), n_query_points);
+    }
+
+    //! \internal
+    // Record a batch of processed frames.
+    /*! Like finishFrame, but for accumulation routes that bin many frames
+     *  before surfacing (e.g. RDF::accumulateFrames): the counter advances by
+     *  the whole batch and the async drain runs once per batch rather than
+     *  once per frame.
+     */
+    void finishFrames(unsigned int n_frames, unsigned int n_points, unsigned int n_query_points)
+    {
+        m_frame_counter += n_frames;
+        m_result_generation += n_frames;
+        m_n_points = n_points;
         m_n_query_points = n_query_points;
         m_reduce = true;
+        if (m_async_reduce)
+        {
+            // Swap this frame's counts into the back buffer and drain them
+            // into the carry array in the background while the caller
+            // assembles the next frame.
+            m_reduction_tasks.wait();
+            if (m_carry.size() != m_histogram.size())
+            {
+                m_carry.prepare(m_histogram.size());
+                m_local_histograms_back
+                    = util::Histogram<unsigned int>::ThreadLocalHistogram(m_histogram, m_sparse);
+            }
+            std::swap(m_local_histograms, m_local_histograms_back);
+            m_reduction_tasks.run([this]() {
+                m_local_histograms_back.accumulateInto(m_carry);
+                m_local_histograms_back.reset();
+            });
+        }
     }
 
-protected:
+    //! Make all asynchronously drained counts visible to reduce().
+    /*! Waits for any in-flight background drain and then moves the carry
+     *  array back into the active thread-local histograms, so the virtual
+     *  reduce() implementations see every count accumulated so far. A no-op
+     *  in the default synchronous mode.
+     */
+    void finalizeAsyncReduction()
+    {
+        if (!m_async_reduce)
+        {
+            return;
+        }
+        m_reduction_tasks.wait();
+        for (size_t i = 0; i < m_carry.size(); ++i)
+        {
+            if (m_carry[i] != 0)
+            {
+                m_local_histograms.increment(i, m_carry[i]);
+            }
+        }
+        m_carry.reset();
+    }
+
+    //! Format version of the serialized accumulation state.
+    static constexpr std::uint64_t SERIALIZED_STATE_VERSION = 1;
+    //! Fixed-size prefix of the serialized state: five 64-bit fields plus
+    //! the seven box parameters.
+    static constexpr size_t STATE_HEADER_BYTES = 5 * sizeof(std::uint64_t) + 7 * sizeof(float);
+
     box::Box m_box;
     unsigned int m_frame_counter {0};  //!< Number of frames calculated.
     unsigned int m_n_points {0};       //!< The number of points.
     unsigned int m_n_query_points {0}; //!< The number of query points.
     bool m_reduce {true};              //!< Whether or not the histogram needs to be reduced.
+    unsigned long long m_result_generation {0}; //!< Advances when results change (see getResultGeneration).
+    bool m_sparse {false};             //!< Whether thread-local histograms use first-touch pages.
+    bool m_async_reduce {false};       //!< Whether frames are drained into the carry array asynchronously.
 
     util::Histogram<unsigned int> m_histogram; //!< Histogram of interparticle distances (bond lengths).
     util::Histogram<unsigned int>::ThreadLocalHistogram
         m_local_histograms; //!< Thread local bin counts for TBB parallelism
+    util::Histogram<unsigned int>::ThreadLocalHistogram
+        m_local_histograms_back;                //!< Buffer set drained in the background (async mode).
+    util::ManagedArray<unsigned int> m_carry;   //!< Counts of frames already drained (async mode).
+    tbb::task_group m_reduction_tasks;          //!< Background drains of the back buffer (async mode).
+    tbb::task_group m_compute_tasks;            //!< Computes submitted through computeAsync().
+    std::unique_ptr<tbb::task_arena> m_arena;   //!< Dedicated arena for this compute (null = global).
+
+    // Instrumentation counters (see getInstrumentation). Cumulative over the
+    // object's lifetime; not cleared by reset().
+    unsigned long long m_accumulate_ns {0};     //!< Time spent in accumulateGeneral.
+    unsigned long long m_reduce_ns {0};         //!< Time spent in lazy reductions.
+    unsigned long long m_frames_accumulated {0}; //!< Frames seen by accumulateGeneral.
+    unsigned long long m_bonds_binned {0};      //!< Histogram total at the last reduction.
+    unsigned long long m_bins_reduced {0};      //!< Bins swept across all reductions.
 
     using BondHistogram = util::Histogram<unsigned int>;
     using BHAxes = typename BondHistogram::Axes;
@@ -6,6 +6,7 @@
 #include <stdexcept>
 
 #include "LinkCell.h"
+#include "utils.h"
 
 /*! \file LinkCell.cc
     \brief Build a cell list from a set of points.
@@ -18,11 +19,11 @@ namespace freud { namespace locality {
  ********************/
 void IteratorLinkCell::copy(const IteratorLinkCell& rhs)
 {
-    m_cell_list = rhs.m_cell_list;
-    m_Np = rhs.m_Np;
-    m_Nc = rhs.m_Nc;
+    m_cell_members = rhs.m_cell_members;
+    m_start = rhs.m_start;
+    m_end = rhs.m_end;
+    m_pos = rhs.m_pos;
     m_cur_idx = rhs.m_cur_idx;
-    m_cell = rhs.m_cell;
 }
 
 bool IteratorLinkCell::atEnd() const
@@ -32,15 +33,14 @@ bool IteratorLinkCell::atEnd() const
 
 unsigned int IteratorLinkCell::next()
 {
-    m_cur_idx = m_cell_list[m_cur_idx];
+    m_cur_idx = (m_pos < m_end) ? m_cell_members[m_pos++] : LINK_CELL_TERMINATOR;
     return m_cur_idx;
 }
 
 unsigned int IteratorLinkCell::begin()
 {
-    m_cur_idx = m_Np + m_cell;
-    m_cur_idx = m_cell_list[m_cur_idx];
-    return m_cur_idx;
+    m_pos = m_start;
+    return next();
 }
 
 /*********************
@@ -211,8 +211,9 @@ void IteratorCellShell::reset(unsigned int range)
 // Default constructor
 LinkCell::LinkCell() : NeighborQuery() {}
 
-LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width)
-    : NeighborQuery(box, points, n_points), m_cell_width(cell_width)
+LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width,
+                   bool spatial_sort)
+    : NeighborQuery(box, points, n_points, spatial_sort), m_cell_width(cell_width)
 {
     // If no cell width is provided, we calculate the system density and
     // estimate the number of cells that would lead to 10 particles per cell.
@@ -248,7 +249,8 @@ LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int
         throw std::runtime_error("At least one cell must be present.");
     }
 
-    computeCellList(points, n_points);
+    // Bin the stored points (the sorted copy when spatial sorting is on).
+    computeCellList(m_points, m_n_points);
 }
 
 unsigned int LinkCell::getCellIndex(const vec3<int> cellCoord) const
@@ -267,6 +269,22 @@ unsigned int LinkCell::getCellIndex(const vec3<int> cellCoord) const
     return coordToIndex(x, y, z);
 }
 
+bool LinkCell::isFirstShellVisit(const vec3<int>& offset) const
+{
+    const auto is_minimal_image = [](int o, int n) {
+        int r = o % n;
+        r += (r < 0 ? n : 0);
+        // The residue class of o contains the representatives r and r - n;
+        // the smaller in magnitude is the one an earlier (or this) shell
+        // reaches first. When n is even the two tie at n / 2 and the
+        // positive representative is canonical.
+        return o == ((2 * r > n) ? r - n : r);
+    };
+    return is_minimal_image(offset.x, static_cast<int>(m_celldim.x))
+        && is_minimal_image(offset.y, static_cast<int>(m_celldim.y))
+        && is_minimal_image(offset.z, static_cast<int>(m_celldim.z));
+}
+
 vec3<unsigned int> LinkCell::computeDimensions(const box::Box& box, float cell_width)
 {
     vec3<unsigned int> dim;
@@ -307,24 +325,40 @@ vec3<unsigned int> LinkCell::computeDimensions(const box::Box& box, float cell_w
 
 void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
 {
-    // determine the number of cells and allocate memory
-    unsigned int Nc = getNumCells();
-    m_cell_list.prepare(n_points + Nc);
+    const unsigned int Nc = getNumCells();
     m_n_points = n_points;
 
-    // initialize memory
-    for (unsigned int cell = 0; cell < Nc; cell++)
+    // Bin each particle. Binning is independent per particle, so it
+    // parallelizes trivially.
+    std::vector<unsigned int> cells(n_points);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            cells[i] = getCell(points[i]);
+        }
+    });
+
+    // Counting sort the particle indices so that each cell's members occupy
+    // a contiguous, ascending range of m_cell_members delimited by
+    // m_cell_starts (a standard CSR layout).
+    m_cell_starts.assign(Nc + 1, 0);
+    for (unsigned int i = 0; i < n_points; ++i)
     {
-        m_cell_list[n_points + cell] = LINK_CELL_TERMINATOR;
+        ++m_cell_starts[cells[i] + 1];
+    }
+    for (unsigned int cell = 0; cell < Nc; ++cell)
+    {
+        m_cell_starts[cell + 1] += m_cell_starts[cell];
     }
 
-    // Generate the cell list.
-    for (unsigned int i = n_points - 1; i != static_cast<unsigned int>(-1); --i)
+    m_cell_members.prepare(n_points);
+    std::vector<unsigned int> insert_pos(m_cell_starts.begin(), m_cell_starts.end() - 1);
+    for (unsigned int i = 0; i < n_points; ++i)
     {
-        unsigned int cell = getCell(points[i]);
-        m_cell_list[i] = m_cell_list[n_points + cell];
-        m_cell_list[n_points + cell] = i;
+        m_cell_members[insert_pos[cells[i]]++] = i;
     }
+
+    computeCellNeighborTable();
 }
 
 vec3<unsigned int> LinkCell::indexToCoord(unsigned int x) const
@@ -360,114 +394,62 @@ vec3<unsigned int> LinkCell::getCellCoord(const vec3<float>& p) const
     return c;
 }
 
-const std::vector<unsigned int>& LinkCell::getCellNeighbors(unsigned int cell) const
+std::vector<unsigned int> LinkCell::getCellNeighbors(unsigned int cell) const
 {
-    // check if the list of neighbors has been already computed
-    // return the list if it has
-    // otherwise, compute it and return
-    CellNeighbors::const_accessor a;
-    if (m_cell_neighbors.find(a, cell))
-    {
-        return a->second;
-    }
-    return computeCellNeighbors(cell);
+    const unsigned int* row = m_cell_neighbor_table.data() + size_t(cell) * m_stencil_size;
+    return std::vector<unsigned int>(row, row + m_stencil_size);
 }
 
-const std::vector<unsigned int>& LinkCell::computeCellNeighbors(unsigned int cur_cell) const
+void LinkCell::computeCellNeighborTable()
 {
-    std::vector<unsigned int> neighbor_cells;
-    vec3<unsigned int> l_idx = indexToCoord(cur_cell);
-    const int i = static_cast<int>(l_idx.x);
-    const int j = static_cast<int>(l_idx.y);
-    const int k = static_cast<int>(l_idx.z);
-
-    // loop over the neighbor cells
-    int starti;
-    int startj;
-    int startk;
-    int endi;
-    int endj;
-    int endk;
-    if (m_celldim.x < 3)
-    {
-        starti = i;
-    }
-    else
-    {
-        starti = i - 1;
-    }
-    if (m_celldim.y < 3)
-    {
-        startj = j;
-    }
-    else
-    {
-        startj = j - 1;
-    }
-    if (m_celldim.z < 3)
-    {
-        startk = k;
-    }
-    else
-    {
-        startk = k - 1;
-    }
-
-    if (m_celldim.x < 2)
-    {
-        endi = i;
-    }
-    else
-    {
-        endi = i + 1;
-    }
-    if (m_celldim.y < 2)
-    {
-        endj = j;
-    }
-    else
-    {
-        endj = j + 1;
-    }
-    if (m_celldim.z < 2)
-    {
-        endk = k;
-    }
-    else
-    {
-        endk = k + 1;
-    }
+    // Build the stencil of coordinate offsets once. The half-open ranges
+    // below are chosen so that narrow dimensions drop the offsets that would
+    // wrap back onto cells already in the stencil: with fewer than 3 cells
+    // -1 and +1 alias each other, and with fewer than 2 cells every offset
+    // aliases 0.
+    const int starti = (m_celldim.x < 3) ? 0 : -1;
+    const int startj = (m_celldim.y < 3) ? 0 : -1;
+    int startk = (m_celldim.z < 3) ? 0 : -1;
+    const int endi = (m_celldim.x < 2) ? 0 : 1;
+    const int endj = (m_celldim.y < 2) ? 0 : 1;
+    int endk = (m_celldim.z < 2) ? 0 : 1;
     if (m_box.is2D())
     {
-        startk = endk = k;
+        startk = endk = 0;
     }
 
-    for (int neighk = startk; neighk <= endk; neighk++)
+    std::vector<vec3<int>> stencil;
+    for (int k = startk; k <= endk; ++k)
     {
-        for (int neighj = startj; neighj <= endj; neighj++)
+        for (int j = startj; j <= endj; ++j)
         {
-            for (int neighi = starti; neighi <= endi; neighi++)
+            for (int i = starti; i <= endi; ++i)
             {
-                // wrap back into the box
-                unsigned int wrapi = (m_celldim.x + neighi) % m_celldim.x;
-                unsigned int wrapj = (m_celldim.y + neighj) % m_celldim.y;
-                unsigned int wrapk = (m_celldim.z + neighk) % m_celldim.z;
-
-                unsigned int neigh_cell = coordToIndex(wrapi, wrapj, wrapk);
-                // add to the list
-                neighbor_cells.push_back(neigh_cell);
+                stencil.emplace_back(i, j, k);
             }
         }
     }
+    m_stencil_size = stencil.size();
 
-    // sort the list
-    std::sort(neighbor_cells.begin(), neighbor_cells.end());
-
-    // add the vector of neighbor cells to the hash table
-    CellNeighbors::accessor a;
-    m_cell_neighbors.insert(a, cur_cell);
-    a->second = neighbor_cells;
-    return a->second;
+    // Resolve the stencil to a flat table of neighbor cell ids, one
+    // contiguous (sorted) row per cell. The table makes neighbor lookups a
+    // linear scan with no per-query computation or locking.
+    m_cell_neighbor_table.resize(size_t(m_size) * m_stencil_size);
+    util::forLoopWrapper(0, m_size, [&](size_t begin, size_t end) {
+        for (size_t cell = begin; cell < end; ++cell)
+        {
+            const vec3<unsigned int> coord = indexToCoord(cell);
+            unsigned int* row = m_cell_neighbor_table.data() + cell * m_stencil_size;
+            for (unsigned int s = 0; s < m_stencil_size; ++s)
+            {
+                row[s] = getCellIndex(
+                    vec3<int>(static_cast<int>(coord.x), static_cast<int>(coord.y),
+                              static_cast<int>(coord.z))
+                    + stencil[s]);
+            }
+            std::sort(row, row + m_stencil_size);
+        }
+    });
 }
 
 std::shared_ptr<NeighborQueryPerPointIterator>
@@ -488,14 +470,24 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
 }
 
 NeighborBond LinkCellQueryBallIterator::next()
+{
+    switch (m_box_shape)
+    {
+    case box::Box::Shape::Orthorhombic2D:
+        return nextShape<box::Box::Shape::Orthorhombic2D>();
+    case box::Box::Shape::Orthorhombic3D:
+        return nextShape<box::Box::Shape::Orthorhombic3D>();
+    default:
+        return nextShape<box::Box::Shape::Triclinic>();
+    }
+}
+
+template<box::Box::Shape shape> NeighborBond LinkCellQueryBallIterator::nextShape()
 {
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
 
     vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
 
     // Loop over cell list neighbor shells relative to this point's cell.
     while (true)
@@ -511,7 +503,8 @@ NeighborBond LinkCellQueryBallIterator::next()
                 continue;
             }
 
-            const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
+            const vec3<float> r_ij(
+                m_neighbor_query->getBox().wrapShape<shape>((*m_linkcell)[j] - m_query_point));
             const float r_sq(dot(r_ij, r_ij));
 
             if (r_sq < r_max_sq && r_sq >= r_min_sq)
@@ -537,17 +530,14 @@ NeighborBond LinkCellQueryBallIterator::next()
                 break;
             }
 
-            const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-            // Insertion to an unordered set returns a pair, the second
-            // element indicates insertion success or failure (if it
-            // already exists)
-            if (m_searched_cells.insert(neighbor_cell_index).second)
+            // Offsets whose wrapped cell was already reached by an earlier
+            // (or this) shell are detected arithmetically; no per-visit
+            // bookkeeping is required. Otherwise, we loop back, increment
+            // the cell shell iterator, and try the next one.
+            if (m_linkcell->isFirstShellVisit(*m_neigh_cell_iter))
             {
-                // This cell has not been searched yet, so we will iterate
-                // over its contents. Otherwise, we loop back, increment
-                // the cell shell iterator, and try the next one.
-                m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
+                m_cell_iter = m_linkcell->itercell(m_linkcell->getCellIndex(
+                    vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter)));
                 break;
             }
         }
@@ -562,6 +552,19 @@ NeighborBond LinkCellQueryBallIterator::next()
 }
 
 NeighborBond LinkCellQueryIterator::next()
+{
+    switch (m_box_shape)
+    {
+    case box::Box::Shape::Orthorhombic2D:
+        return nextShape<box::Box::Shape::Orthorhombic2D>();
+    case box::Box::Shape::Orthorhombic3D:
+        return nextShape<box::Box::Shape::Orthorhombic3D>();
+    default:
+        return nextShape<box::Box::Shape::Triclinic>();
+    }
+}
+
+template<box::Box::Shape shape> NeighborBond LinkCellQueryIterator::nextShape()
 {
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
@@ -576,9 +579,6 @@ NeighborBond LinkCellQueryIterator::next()
         = static_cast<unsigned int>(std::ceil(min_plane_distance / (2 * m_linkcell->getCellWidth()))) + 1;
 
     vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
-    const unsigned int point_cell_index = m_linkcell->getCellIndex(
-        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-    m_searched_cells.insert(point_cell_index);
 
     // Loop over cell list neighbor shells relative to this point's cell.
     if (m_current_neighbors.empty())
@@ -600,7 +600,8 @@ NeighborBond LinkCellQueryIterator::next()
                     {
                         continue;
                     }
-                    const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
+                    const vec3<float> r_ij(
+                        m_neighbor_query->getBox().wrapShape<shape>((*m_linkcell)[j] - m_query_point));
                     const float r_sq(dot(r_ij, r_ij));
                     if (r_sq < r_max_sq && r_sq >= r_min_sq)
                     {
@@ -618,18 +619,15 @@ NeighborBond LinkCellQueryIterator::next()
                     break;
                 }
 
-                const unsigned int neighbor_cell_index = m_linkcell->getCellIndex(
-                    vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
-                // Insertion to an unordered set returns a pair, the second
-                // element indicates insertion success or failure (if it
-                // already exists)
-                if (m_searched_cells.insert(neighbor_cell_index).second)
+                // Offsets whose wrapped cell was already reached by an
+                // earlier (or this) shell are detected arithmetically; no
+                // per-visit bookkeeping is required. Otherwise, we loop
+                // back, increment the cell shell iterator, and try the next
+                // one.
+                if (m_linkcell->isFirstShellVisit(*m_neigh_cell_iter))
                 {
-                    // This cell has not been searched yet, so we will
-                    // iterate over its contents. Otherwise, we loop back,
-                    // increment the cell shell iterator, and try the next
-                    // one.
-                    m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
+                    m_cell_iter = m_linkcell->itercell(m_linkcell->getCellIndex(
+                        vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter)));
                     break;
                 }
             }
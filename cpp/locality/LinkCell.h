@@ -5,8 +5,6 @@
 #define LINKCELL_H
 
 #include <memory>
-#include <tbb/concurrent_hash_map.h>
-#include <unordered_set>
 #include <vector>
 
 #include "Box.h"
@@ -20,21 +18,20 @@
 namespace freud { namespace locality {
 
 /*! \internal
-    \brief Signifies the end of the linked list
+    \brief Signifies the end of iteration over a cell
 */
 const unsigned int LINK_CELL_TERMINATOR = 0xffffffff;
 
-//! Iterates over particles in a link cell list generated by LinkCell
-/*! The link-cell structure is not trivial to iterate over. This helper class
- *  makes that easier both in C++ and provides a Python compatible interface
- *  for direct usage there. An IteratorLinkCell is given the bare essentials
- *  it needs to iterate over a given cell, the cell list, the number of
- *  particles, number of cells and the cell to iterate over. Call next() to
- *  get the index of the next particle in the cell, atEnd() will return true
- *  if you are at the end. In C++, next() will crash the code if you attempt
- *  to iterate past the end (no bounds checking for performance). When called
- *  from Python, a different version of next() is used that will throw
- *  StopIteration at the end.
+//! Iterates over particles in a cell list generated by LinkCell
+/*! This helper class iterates over the contents of one cell both in C++ and
+ *  provides a Python compatible interface for direct usage there. Cell
+ *  membership is stored in compressed sparse row (CSR) form, so an
+ *  IteratorLinkCell is given the array of particle indices sorted by cell
+ *  along with the half-open range of slots belonging to its cell, and simply
+ *  scans that contiguous range. Call next() to get the index of the next
+ *  particle in the cell, atEnd() will return true if you are at the end.
+ *  When called from Python, a different version of next() is used that will
+ *  throw StopIteration at the end.
  *
  *  A loop over all of the particles in a cell can be accomplished with the
  *   following code in C++.
@@ -54,12 +51,13 @@ class IteratorLinkCell
 public:
     IteratorLinkCell() = default;
 
-    IteratorLinkCell(const util::ManagedArray<unsigned int>& cell_list, unsigned int Np, unsigned int Nc,
-                     unsigned int cell)
-        : m_cell_list(cell_list), m_Np(Np), m_Nc(Nc)
+    IteratorLinkCell(const util::ManagedArray<unsigned int>& cell_members, unsigned int start,
+                     unsigned int end)
+        : m_cell_members(cell_members), m_start(start), m_end(end), m_pos(start)
     {
-        m_cell = cell;
-        m_cur_idx = m_Np + cell;
+        // Any value other than the terminator marks the iteration as not yet
+        // finished; the first call to next() establishes the real state.
+        m_cur_idx = m_start;
     }
 
     //! Copy the position of rhs into this object
@@ -75,11 +73,11 @@ public:
     unsigned int begin();
 
 private:
-    util::ManagedArray<unsigned int> m_cell_list;  //!< The cell list
-    unsigned int m_Np {0};                         //!< Number of particles in the cell list
-    unsigned int m_Nc {0};                         //!< Number of cells in the cell list
-    unsigned int m_cur_idx {LINK_CELL_TERMINATOR}; //!< Current index
-    unsigned int m_cell {0};                       //!< Cell being considered
+    util::ManagedArray<unsigned int> m_cell_members; //!< Particle indices sorted by cell
+    unsigned int m_start {0};                        //!< First slot of this cell's contiguous range
+    unsigned int m_end {0};                          //!< One past the last slot of this cell's range
+    unsigned int m_pos {0};                          //!< Next slot to return
+    unsigned int m_cur_idx {LINK_CELL_TERMINATOR};   //!< Last particle index returned
 };
 
 //! Iterates over sets of shells in a cell list
@@ -165,8 +163,13 @@ private:
  *  an arbitrary point.
 
  *  <b>Data structures:</b><br>
- *  The internal data structure used in LinkCell is a linked list of particle
- *  indices. See IteratorLinkCell for information on how to iterate through these.
+ *  The internal data structure used in LinkCell is a compressed sparse row
+ *  (CSR) layout: particle indices are counting-sorted by cell into a single
+ *  contiguous array, with a per-cell offsets array delimiting each cell's
+ *  range. A flat table of neighboring cell ids (the 27-cell stencil, reduced
+ *  appropriately for 2D and narrow boxes) is precomputed for every cell so
+ *  no per-query neighbor-cell computation or locking is required. See
+ *  IteratorLinkCell for information on how to iterate through the cells.
 
  *  <b>2D:</b><br>
  *  LinkCell properly handles 2D boxes. When a 2D box is handed to LinkCell,
@@ -182,7 +185,14 @@ public:
     LinkCell();
 
     //! Constructor
-    LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0);
+    /*! \param cell_width The width of the cells (0 picks a width targeting
+     *             roughly 10 particles per cell).
+     *  \param spatial_sort If true, the points are reordered along a Morton
+     *             curve before binning so that each cell's members occupy a
+     *             contiguous position range (see NeighborQuery).
+     */
+    LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0,
+             bool spatial_sort = false);
 
     //! Compute LinkCell dimensions
     static vec3<unsigned int> computeDimensions(const box::Box& box, float cell_width);
@@ -190,6 +200,17 @@ public:
     //! Compute cell id from cell coordinates
     unsigned int getCellIndex(const vec3<int> cellCoord) const;
 
+    //! Check whether a shell offset is the first to reach its wrapped cell.
+    /*! Offsets from IteratorCellShell alias each other modulo the cell
+     *  dimensions once a shell grows wider than the grid. An offset is the
+     *  first visit to its wrapped cell exactly when every component is the
+     *  minimal image of its residue class (ties at half an even dimension
+     *  resolve to the positive side), since no earlier shell can reach that
+     *  cell. This reduces duplicate-cell detection in the query iterators to
+     *  arithmetic with no per-visit hash-set bookkeeping.
+     */
+    bool isFirstShellVisit(const vec3<int>& offset) const;
+
     //! Get the number of cells
     unsigned int getNumCells() const
     {
@@ -221,11 +242,11 @@ public:
     //! Iterate over particles in a cell
     IteratorLinkCell itercell(unsigned int cell) const
     {
-        return IteratorLinkCell(m_cell_list, m_n_points, getNumCells(), cell);
+        return IteratorLinkCell(m_cell_members, m_cell_starts[cell], m_cell_starts[cell + 1]);
     }
 
     //! Get a list of neighbors to a cell
-    const std::vector<unsigned int>& getCellNeighbors(unsigned int cell) const;
+    std::vector<unsigned int> getCellNeighbors(unsigned int cell) const;
 
     //! Compute the cell list
     void computeCellList(const vec3<float>* points, unsigned int n_points);
@@ -239,16 +260,18 @@ public:
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
 private:
-    //! Helper function to compute cell neighbors
-    const std::vector<unsigned int>& computeCellNeighbors(unsigned int cell) const;
+    //! Helper function to precompute the flat table of neighbor cells
+    void computeCellNeighborTable();
 
     float m_cell_width {0};                 //!< Minimum necessary cell width cutoff
     vec3<unsigned int> m_celldim {0, 0, 0}; //!< Cell dimensions
     unsigned int m_size {0};                //!< The size of cell list.
 
-    util::ManagedArray<unsigned int> m_cell_list; //!< The cell list last computed
-    using CellNeighbors = tbb::concurrent_hash_map<unsigned int, std::vector<unsigned int>>;
-    mutable CellNeighbors m_cell_neighbors; //!< Hash map of cell neighbors for each cell
+    util::ManagedArray<unsigned int> m_cell_members; //!< Particle indices sorted by cell (CSR values)
+    std::vector<unsigned int> m_cell_starts; //!< Per-cell offsets into m_cell_members (CSR offsets)
+    std::vector<unsigned int>
+        m_cell_neighbor_table;       //!< Neighbor cell ids, m_stencil_size contiguous entries per cell
+    unsigned int m_stencil_size {0}; //!< Number of neighbor cells in the stencil of each cell
 };
 
 //! Parent class of LinkCell iterators that knows how to traverse general cell-linked list structures.
@@ -264,7 +287,8 @@ public:
         : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
                                         exclude_ii),
           m_linkcell(neighbor_query), m_neigh_cell_iter(0, neighbor_query->getBox().is2D()),
-          m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point)))
+          m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point))),
+          m_box_shape(neighbor_query->getBox().getShape())
     {}
 
     //! Empty Destructor
@@ -275,8 +299,7 @@ protected:
     IteratorCellShell
         m_neigh_cell_iter;        //!< The shell iterator indicating how far out we're currently searching.
     IteratorLinkCell m_cell_iter; //!< The cell iterator indicating which cell we're currently searching.
-    std::unordered_set<unsigned int>
-        m_searched_cells; //!< Set of cells that have already been searched by the cell shell iterator.
+    box::Box::Shape m_box_shape;  //!< Shape category of the box, classified at construction.
 };
 
 //! Iterator that gets specified numbers of nearest neighbors from LinkCell tree structures.
@@ -295,9 +318,15 @@ public:
     ~LinkCellQueryIterator() override = default;
 
     //! Get the next element.
+    /*! Dispatches once on the box shape so the candidate loops run the wrap
+     *  kernel matching this box with all shape branches compiled away.
+     */
     NeighborBond next() override;
 
 protected:
+    //! Implementation of next() specialized on the box shape.
+    template<box::Box::Shape shape> NeighborBond nextShape();
+
     unsigned int m_count;                          //!< Number of neighbors returned for the current point.
     unsigned int m_num_neighbors;                  //!< Number of nearest neighbors to find
     std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
@@ -329,9 +358,15 @@ public:
     ~LinkCellQueryBallIterator() override = default;
 
     //! Get the next element.
+    /*! Dispatches once on the box shape so the candidate loop runs the wrap
+     *  kernel matching this box with all shape branches compiled away.
+     */
     NeighborBond next() override;
 
 protected:
+    //! Implementation of next() specialized on the box shape.
+    template<box::Box::Shape shape> NeighborBond nextShape();
+
     int m_extra_search_width; //!< The extra shell distance to search, always 0 or 1.
 };
 }; }; // end namespace freud::locality
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "MultiscaleLinkCell.h"
+
+/*! \file MultiscaleLinkCell.cc
+    \brief Hierarchical cell list for polydisperse systems.
+*/
+
+namespace freud { namespace locality {
+
+MultiscaleLinkCell::MultiscaleLinkCell() : NeighborQuery() {}
+
+MultiscaleLinkCell::MultiscaleLinkCell(const box::Box& box, const vec3<float>* points,
+                                       unsigned int n_points, const float* interaction_radii,
+                                       unsigned int num_levels)
+    : NeighborQuery(box, points, n_points)
+{
+    if (num_levels == 0)
+    {
+        throw std::invalid_argument("MultiscaleLinkCell requires at least one level.");
+    }
+    if (n_points == 0)
+    {
+        throw std::invalid_argument("MultiscaleLinkCell requires at least one point.");
+    }
+    float r_lo = interaction_radii[0];
+    float r_hi = interaction_radii[0];
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        if (interaction_radii[i] <= 0)
+        {
+            throw std::invalid_argument("MultiscaleLinkCell interaction radii must be positive.");
+        }
+        r_lo = std::min(r_lo, interaction_radii[i]);
+        r_hi = std::max(r_hi, interaction_radii[i]);
+    }
+
+    // Level l covers radii in (r_hi / ratio^(l+1), r_hi / ratio^l], with
+    // geometric boundaries between the extreme radii, so each level spans
+    // the same size ratio. Monodisperse radii collapse to a single level.
+    const unsigned int levels = (r_hi == r_lo) ? 1 : num_levels;
+    const auto ratio
+        = static_cast<float>(std::pow(static_cast<double>(r_hi / r_lo), 1.0 / static_cast<double>(levels)));
+
+    std::vector<Level> buckets(levels);
+    std::vector<float> level_max_radius(levels, 0.0F);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        unsigned int level = 0;
+        float boundary = r_hi / ratio;
+        while (level + 1 < levels && interaction_radii[i] <= boundary)
+        {
+            ++level;
+            boundary /= ratio;
+        }
+        buckets[level].points.push_back(points[i]);
+        buckets[level].original_index.push_back(i);
+        level_max_radius[level] = std::max(level_max_radius[level], interaction_radii[i]);
+    }
+
+    // Build a cell list per non-empty level, each sized to the largest
+    // radius it holds (capped so LinkCell's half-box constraint is met).
+    const vec3<float> npd = box.getNearestPlaneDistance();
+    float max_width = std::min(npd.x, npd.y);
+    if (!box.is2D())
+    {
+        max_width = std::min(max_width, npd.z);
+    }
+    max_width *= 0.499F;
+    for (unsigned int level = 0; level < levels; ++level)
+    {
+        if (buckets[level].points.empty())
+        {
+            continue;
+        }
+        const float cell_width = std::min(2.0F * level_max_radius[level], max_width);
+        buckets[level].cells = std::unique_ptr<LinkCell>(
+            new LinkCell(box, buckets[level].points.data(),
+                         static_cast<unsigned int>(buckets[level].points.size()), cell_width));
+        m_levels.push_back(std::move(buckets[level]));
+    }
+}
+
+std::shared_ptr<NeighborQueryPerPointIterator>
+MultiscaleLinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_idx,
+                                QueryArgs args) const
+{
+    this->validateQueryArgs(args);
+    return std::make_shared<MultiscaleLinkCellPerPointIterator>(this, query_point, query_point_idx, args);
+}
+
+MultiscaleLinkCellPerPointIterator::MultiscaleLinkCellPerPointIterator(
+    const MultiscaleLinkCell* neighbor_query, const vec3<float>& query_point, unsigned int query_point_idx,
+    QueryArgs args)
+    : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, args.r_max, args.r_min,
+                                    args.exclude_ii),
+      m_multiscale(neighbor_query), m_args(args)
+{
+    // The per-level cell lists see subset-local indices, so self-exclusion
+    // must happen here after remapping rather than inside them.
+    m_args.exclude_ii = false;
+
+    if (args.mode == QueryType::nearest)
+    {
+        // The global k nearest are among the union of each level's k
+        // nearest, so collect those up front and keep the k smallest. When
+        // excluding self bonds, ask each level for one extra neighbor since
+        // the self bond would otherwise consume a slot in its own level.
+        QueryArgs level_args = m_args;
+        if (m_exclude_ii)
+        {
+            ++level_args.num_neighbors;
+        }
+        for (const auto& level : m_multiscale->m_levels)
+        {
+            auto it = level.cells->querySingle(m_query_point, m_query_point_idx, level_args);
+            for (NeighborBond nb = it->next(); !it->end(); nb = it->next())
+            {
+                nb.point_idx = level.original_index[nb.point_idx];
+                if (m_exclude_ii && nb.point_idx == m_query_point_idx)
+                {
+                    continue;
+                }
+                m_bonds.push_back(nb);
+            }
+        }
+        std::sort(m_bonds.begin(), m_bonds.end(), [](const NeighborBond& a, const NeighborBond& b) {
+            if (a.distance != b.distance)
+            {
+                return a.distance < b.distance;
+            }
+            return a.point_idx < b.point_idx;
+        });
+        if (m_bonds.size() > m_args.num_neighbors)
+        {
+            m_bonds.resize(m_args.num_neighbors);
+        }
+    }
+}
+
+NeighborBond MultiscaleLinkCellPerPointIterator::next()
+{
+    if (m_args.mode == QueryType::nearest)
+    {
+        if (m_bond_index < m_bonds.size())
+        {
+            return m_bonds[m_bond_index++];
+        }
+        m_finished = true;
+        return ITERATOR_TERMINATOR;
+    }
+
+    // Ball mode: drain each level's ball iterator in turn.
+    while (m_level < m_multiscale->m_levels.size())
+    {
+        const auto& level = m_multiscale->m_levels[m_level];
+        if (!m_level_iter)
+        {
+            m_level_iter = level.cells->querySingle(m_query_point, m_query_point_idx, m_args);
+        }
+        const NeighborBond nb = m_level_iter->next();
+        if (m_level_iter->end())
+        {
+            m_level_iter.reset();
+            ++m_level;
+            continue;
+        }
+        NeighborBond mapped(nb);
+        mapped.point_idx = level.original_index[nb.point_idx];
+        if (m_exclude_ii && mapped.point_idx == m_query_point_idx)
+        {
+            continue;
+        }
+        return mapped;
+    }
+    m_finished = true;
+    return ITERATOR_TERMINATOR;
+}
+
+}; }; // end namespace freud::locality
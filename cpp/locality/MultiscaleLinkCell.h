@@ -0,0 +1,121 @@
+#ifndef MULTISCALE_LINK_CELL_H
+#define MULTISCALE_LINK_CELL_H
+
+#include <memory>
+#include <vector>
+
+#include "LinkCell.h"
+#include "NeighborQuery.h"
+
+/*! \file MultiscaleLinkCell.h
+    \brief Hierarchical cell list for polydisperse systems.
+*/
+
+namespace freud { namespace locality {
+
+//! A hierarchical, multi-resolution cell list.
+/*! A single LinkCell sizes every cell from one width, which breaks down for
+ *  polydisperse systems whose interaction ranges span an order of magnitude
+ *  or more: cells sized for the large particles make queries scan huge
+ *  occupancies, while cells sized for the small ones force traversals over
+ *  thousands of nearly empty cells. MultiscaleLinkCell instead partitions
+ *  the points into a small number of levels by their interaction radius
+ *  (geometric boundaries between the smallest and largest radius) and builds
+ *  an independent LinkCell per level, with each level's cell width sized to
+ *  the largest radius it holds. A query visits every level, traversing each
+ *  level's stencil at that level's resolution, and merges the results, so
+ *  both populations are searched at an appropriate granularity.
+ *
+ *  The per-point interaction radii only steer the data structure; query
+ *  semantics (r_max, num_neighbors, exclude_ii) are identical to the other
+ *  NeighborQuery backends, and all reported indices refer to the original
+ *  point array.
+ */
+class MultiscaleLinkCell : public NeighborQuery
+{
+public:
+    //! Null Constructor
+    MultiscaleLinkCell();
+
+    //! Constructor
+    /*! \param box The simulation box.
+     *  \param points The points to build the structure over.
+     *  \param n_points The number of points.
+     *  \param interaction_radii Per-point interaction radius used to assign
+     *             each point to a level; must be positive.
+     *  \param num_levels The number of nested resolutions (at least 1;
+     *             2 or 3 covers typical bimodal and trimodal systems).
+     */
+    MultiscaleLinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                       const float* interaction_radii, unsigned int num_levels = 2);
+
+    //! Implementation of per-particle query (see NeighborQuery.h for documentation).
+    std::shared_ptr<NeighborQueryPerPointIterator>
+    querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
+
+    //! Get the number of non-empty levels actually built.
+    unsigned int getNumLevels() const
+    {
+        return static_cast<unsigned int>(m_levels.size());
+    }
+
+    //! Get the cell width of a level.
+    float getLevelCellWidth(unsigned int level) const
+    {
+        return m_levels[level].cells->getCellWidth();
+    }
+
+    //! Get the number of points assigned to a level.
+    unsigned int getLevelNumPoints(unsigned int level) const
+    {
+        return static_cast<unsigned int>(m_levels[level].original_index.size());
+    }
+
+private:
+    //! One resolution of the hierarchy: an owned subset of the points and
+    //! its cell list. Indices reported by the cell list are subset-local and
+    //! are remapped through original_index by the query iterator.
+    struct Level
+    {
+        std::vector<vec3<float>> points;          //!< Owned copies of this level's points.
+        std::vector<unsigned int> original_index; //!< Subset index -> original point index.
+        std::unique_ptr<LinkCell> cells;          //!< Cell list over the subset.
+    };
+
+    friend class MultiscaleLinkCellPerPointIterator;
+
+    std::vector<Level> m_levels; //!< The levels, ordered from largest to smallest cell width.
+};
+
+//! Per-point iterator merging the per-level traversals.
+/*! Ball queries drain each level's ball iterator in turn, remapping the
+ *  subset-local indices back to the original point array. Nearest queries
+ *  collect the k best candidates of every level up front (the global k
+ *  nearest are necessarily among them) and emit the k smallest of the
+ *  union in ascending distance order. Self-exclusion is applied here after
+ *  remapping, since the per-level cell lists only see subset indices.
+ */
+class MultiscaleLinkCellPerPointIterator : public NeighborQueryPerPointIterator
+{
+public:
+    MultiscaleLinkCellPerPointIterator(const MultiscaleLinkCell* neighbor_query,
+                                       const vec3<float>& query_point, unsigned int query_point_idx,
+                                       QueryArgs args);
+
+    ~MultiscaleLinkCellPerPointIterator() override = default;
+
+    //! Get the next element.
+    NeighborBond next() override;
+
+private:
+    const MultiscaleLinkCell* m_multiscale; //!< The queried hierarchy.
+    QueryArgs m_args;                       //!< Validated query arguments (exclusion handled here).
+    size_t m_level {0};                     //!< Level currently being drained (ball mode).
+    std::shared_ptr<NeighborQueryPerPointIterator> m_level_iter; //!< Iterator of that level (ball mode).
+    std::vector<NeighborBond> m_bonds;      //!< Pre-merged sorted bonds (nearest mode).
+    size_t m_bond_index {0};                //!< Next bond to emit (nearest mode).
+};
+
+}; }; // end namespace freud::locality
+
+#endif // MULTISCALE_LINK_CELL_H
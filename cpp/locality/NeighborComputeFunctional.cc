@@ -11,11 +11,23 @@ NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist
                               locality::QueryArgs qargs)
 {
     bool requires_delete(false);
+    std::shared_ptr<const NeighborList> cached;
     if (nlist == nullptr)
     {
-        auto nqiter(nq->query(query_points, num_query_points, qargs));
-        nlist = nqiter->toNeighborList();
-        requires_delete = true;
+        if (nq->queryCacheEnabled())
+        {
+            // Share the traversal with every other compute issuing an
+            // equivalent query against this object; the copy below still
+            // happens, but the query itself runs only once.
+            cached = nq->cachedNeighborList(query_points, num_query_points, qargs);
+            nlist = cached.get();
+        }
+        else
+        {
+            auto nqiter(nq->query(query_points, num_query_points, qargs));
+            nlist = nqiter->toNeighborList();
+            requires_delete = true;
+        }
     }
     // Ideally we wouldn't allocate a new NeighborList at all, but we don't
     // want to force calling code to manage the memory of a raw pointer, so we
@@ -1,6 +1,8 @@
 #ifndef NEIGHBOR_COMPUTE_FUNCTIONAL_H
 #define NEIGHBOR_COMPUTE_FUNCTIONAL_H
 
+#include <array>
+#include <initializer_list>
 #include <memory>
 
 #include "AABBQuery.h"
@@ -133,6 +135,16 @@ void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<f
             },
             parallel);
     }
+    else if (neighbor_query->queryCacheEnabled())
+    {
+        // The first compute to issue this query pays for the traversal;
+        // every later compute with an equivalent query replays the shared
+        // memoized list through the nlist path above.
+        const std::shared_ptr<const NeighborList> cached
+            = neighbor_query->cachedNeighborList(query_points, n_query_points, qargs);
+        loopOverNeighborsIterator(neighbor_query, query_points, n_query_points, qargs, cached.get(), cf,
+                                  parallel);
+    }
     else
     {
         std::shared_ptr<NeighborQueryIterator> iter
@@ -193,6 +205,14 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
             },
             parallel);
     }
+    else if (neighbor_query->queryCacheEnabled())
+    {
+        // As in loopOverNeighborsIterator, equivalent queries share one
+        // memoized list instead of traversing the query structure again.
+        const std::shared_ptr<const NeighborList> cached
+            = neighbor_query->cachedNeighborList(query_points, n_query_points, qargs);
+        loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, cached.get(), cf, parallel);
+    }
     else
     {
         std::shared_ptr<NeighborQueryIterator> iter
@@ -218,6 +238,209 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
     }
 }
 
+constexpr unsigned int NEIGHBOR_BATCH_SIZE = 256; //!< Number of bonds handed to a batched functor at once.
+
+//! SoA view of a contiguous batch of neighbor bonds.
+/*! All pointers refer to arrays of length size. The vectors array holds the
+ *  bond separation vectors as defined by bondVector() (from the query_point
+ *  to the point, wrapped into the box).
+ */
+struct NeighborBondBatch
+{
+    const unsigned int* query_point_indices; //!< Query point index of each bond.
+    const unsigned int* point_indices;       //!< Point index of each bond.
+    const float* distances;                  //!< Distance of each bond.
+    const float* weights;                    //!< Weight of each bond.
+    const vec3<float>* vectors;              //!< Separation vector of each bond.
+    unsigned int size;                       //!< Number of bonds in the batch.
+};
+
+//! Fixed-capacity SoA buffer used to assemble NeighborBondBatch spans.
+/*! Bonds are appended one at a time as they are produced by the underlying
+ *  iteration and flushed to the compute functor whenever the buffer fills,
+ *  so functors always see contiguous arrays they can vectorize over.
+ */
+class NeighborBondBatchBuffer
+{
+public:
+    NeighborBondBatchBuffer() = default;
+
+    //! Whether the buffer is at capacity.
+    bool full() const
+    {
+        return m_size == NEIGHBOR_BATCH_SIZE;
+    }
+
+    //! Whether the buffer holds no bonds.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    //! Append a bond to the buffer (must not be full).
+    void add(const NeighborBond& nb, const vec3<float>& vector)
+    {
+        m_query_point_indices[m_size] = nb.query_point_idx;
+        m_point_indices[m_size] = nb.point_idx;
+        m_distances[m_size] = nb.distance;
+        m_weights[m_size] = nb.weight;
+        m_vectors[m_size] = vector;
+        ++m_size;
+    }
+
+    //! Get a batch view of the currently buffered bonds.
+    NeighborBondBatch view() const
+    {
+        return {m_query_point_indices.data(), m_point_indices.data(), m_distances.data(), m_weights.data(),
+                m_vectors.data(),             m_size};
+    }
+
+    //! Empty the buffer.
+    void clear()
+    {
+        m_size = 0;
+    }
+
+private:
+    std::array<unsigned int, NEIGHBOR_BATCH_SIZE> m_query_point_indices {};
+    std::array<unsigned int, NEIGHBOR_BATCH_SIZE> m_point_indices {};
+    std::array<float, NEIGHBOR_BATCH_SIZE> m_distances {};
+    std::array<float, NEIGHBOR_BATCH_SIZE> m_weights {};
+    std::array<vec3<float>, NEIGHBOR_BATCH_SIZE> m_vectors {};
+    unsigned int m_size {0};
+};
+
+//! Batched variant of loopOverNeighbors.
+/*! Instead of invoking the compute functor once per bond, bonds (and their
+ *  precomputed separation vectors) are accumulated into SoA buffers of up to
+ *  NEIGHBOR_BATCH_SIZE entries and the functor is handed one NeighborBondBatch
+ *  at a time, so per-bond math can be written as a vectorizable loop over
+ *  contiguous arrays. Like loopOverNeighbors, this function handles both the
+ *  NeighborList and NeighborQuery code paths; batches never mix bonds from
+ *  different threads, and within a thread bonds appear in iteration order.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ * given qargs. \param cf An object with operator(const NeighborBondBatch&) as input.
+ */
+template<typename ComputeBatchType>
+void loopOverNeighborsBatched(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                              unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                              const ComputeBatchType& cf, bool parallel = true)
+{
+    // check if nlist exists
+    if (nlist != nullptr)
+    {
+        // Lists with stored bond vectors (see NeighborList::storeBondVectors)
+        // provide them as a linear per-bond stream, so the scattered position
+        // gathers and box wraps are skipped entirely.
+        const vec3<float>* const stored_vectors
+            = nlist->hasBondVectors() ? nlist->getBondVectors().get() : nullptr;
+        util::forLoopWrapper(
+            0, nlist->getNumBonds(),
+            [&](size_t begin, size_t end) {
+                NeighborBondBatchBuffer batch;
+                for (size_t bond = begin; bond != end; ++bond)
+                {
+                    const NeighborBond nb(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
+                                          nlist->getDistances()[bond], nlist->getWeights()[bond]);
+                    batch.add(nb,
+                              stored_vectors != nullptr ? stored_vectors[bond]
+                                                        : bondVector(nb, neighbor_query, query_points));
+                    if (batch.full())
+                    {
+                        cf(batch.view());
+                        batch.clear();
+                    }
+                }
+                if (!batch.empty())
+                {
+                    cf(batch.view());
+                }
+            },
+            parallel);
+    }
+    else if (neighbor_query->queryCacheEnabled())
+    {
+        // As in loopOverNeighborsIterator, equivalent queries share one
+        // memoized list instead of traversing the query structure again.
+        const std::shared_ptr<const NeighborList> cached
+            = neighbor_query->cachedNeighborList(query_points, n_query_points, qargs);
+        loopOverNeighborsBatched(neighbor_query, query_points, n_query_points, qargs, cached.get(), cf,
+                                 parallel);
+    }
+    else
+    {
+        std::shared_ptr<NeighborQueryIterator> iter
+            = neighbor_query->query(query_points, n_query_points, qargs);
+
+        // iterate over the query object in parallel
+        util::forLoopWrapper(
+            0, n_query_points,
+            [&](size_t begin, size_t end) {
+                NeighborBondBatchBuffer batch;
+                NeighborBond nb;
+                for (size_t i = begin; i != end; ++i)
+                {
+                    std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
+                    nb = it->next();
+                    while (!it->end())
+                    {
+                        batch.add(nb, bondVector(nb, neighbor_query, query_points));
+                        if (batch.full())
+                        {
+                            cf(batch.view());
+                            batch.clear();
+                        }
+                        nb = it->next();
+                    }
+                }
+                if (!batch.empty())
+                {
+                    cf(batch.view());
+                }
+            },
+            parallel);
+    }
+}
+
+//! Drive several bond-consuming kernels from one neighbor pass.
+/*! Analyses that run back to back on the same system (order parameters,
+ *  bond-order histograms, ...) each traverse the same bonds and re-derive
+ *  the same separation vectors. This wrapper performs the neighbor
+ *  iteration once, computes the bond vector (as defined by bondVector())
+ *  once per bond, and fans both out to every registered kernel while the
+ *  data is still in registers.
+ *
+ *  Each kernel must be callable as cf(const NeighborBond&, const
+ *  vec3<float>&). Kernels are invoked in registration order for every bond
+ *  and must be safe to call concurrently for different bonds, exactly as
+ *  with loopOverNeighbors.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use
+ *         neighbor_query appropriately with given qargs.
+ *  \param cfs The kernels to apply to every bond.
+ */
+template<typename... ComputePairTypes>
+void loopOverNeighborsMulti(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                            unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                            const ComputePairTypes&... cfs)
+{
+    loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist,
+                      [&](const NeighborBond& nb) {
+                          const vec3<float> bond_vector = bondVector(nb, neighbor_query, query_points);
+                          // Expand the kernel pack in order for this bond.
+                          (void) std::initializer_list<int> {((void) cfs(nb, bond_vector), 0)...};
+                      });
+}
+
 }; }; // end namespace freud::locality
 
 #endif // NEIGHBOR_COMPUTE_FUNCTIONAL_H
@@ -2,24 +2,86 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "NeighborList.h"
+#include "utils.h"
 
 namespace freud { namespace locality {
 
+namespace {
+
+//! Fixed-size header of the binary NeighborList file format.
+/*! All sections are laid out at fixed offsets derivable from the header so
+ *  loaders can point directly into a file mapping: the neighbors array
+ *  (num_bonds x 2 uint32) starts right after the header, followed by the
+ *  distances and weights (num_bonds float each) and the CSR segments and
+ *  counts arrays (num_query_points uint32 each). All sections are 4-byte
+ *  aligned. Values are stored in the native byte order.
+ */
+struct NeighborListFileHeader
+{
+    char magic[8];             // NOLINT(modernize-avoid-c-arrays): fixed binary layout
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t num_bonds;
+    std::uint64_t num_query_points;
+    std::uint64_t num_points;
+    char padding[24];          // NOLINT(modernize-avoid-c-arrays): fixed binary layout
+};
+
+static_assert(sizeof(NeighborListFileHeader) == 64, "NeighborList file header must be 64 bytes.");
+
+constexpr char NEIGHBOR_LIST_FILE_MAGIC[8] = {'F', 'R', 'E', 'U', 'D', 'N', 'B', 'L'};
+constexpr std::uint32_t NEIGHBOR_LIST_FILE_VERSION = 1;
+
+//! Compute the expected file size for a given header.
+std::uint64_t neighborListFileSize(const NeighborListFileHeader& header)
+{
+    return sizeof(NeighborListFileHeader)
+        + header.num_bonds * (2 * sizeof(std::uint32_t) + 2 * sizeof(float))
+        + header.num_query_points * 2 * sizeof(std::uint32_t);
+}
+
+//! Rebind an array to a smaller logical shape on top of the same allocation.
+/*! The returned array aliases the input's storage, so repeated in-place
+ *  filters keep reusing the capacity of the original allocation instead of
+ *  reallocating on every pass.
+ */
+template<typename T>
+util::ManagedArray<T> shrinkToView(const util::ManagedArray<T>& array, const std::vector<size_t>& shape)
+{
+    auto owner = std::make_shared<util::ManagedArray<T>>(array);
+    return util::ManagedArray<T>(shape, std::shared_ptr<T>(owner, owner->get()));
+}
+
+//! Block size for parallel bond compaction in the filter methods.
+constexpr size_t FILTER_BLOCK_SIZE = 65536;
+
+} // namespace
+
 NeighborList::NeighborList()
     : m_num_query_points(0), m_num_points(0), m_neighbors({0, 2}), m_distances(0), m_weights(0),
-      m_segments_counts_updated(false)
+      m_vectors(0), m_has_vectors(false), m_segments_counts_updated(false)
 {}
 
 NeighborList::NeighborList(unsigned int num_bonds)
     : m_num_query_points(0), m_num_points(0), m_neighbors({num_bonds, 2}), m_distances(num_bonds),
-      m_weights(num_bonds), m_segments_counts_updated(false)
+      m_weights(num_bonds), m_vectors(0), m_has_vectors(false), m_segments_counts_updated(false)
 {}
 
 NeighborList::NeighborList(const NeighborList& other)
     : m_num_query_points(other.m_num_query_points), m_num_points(other.m_num_points),
-      m_segments_counts_updated(false)
+      m_has_vectors(false), m_segments_counts_updated(false)
 {
     copy(other);
 }
@@ -28,31 +90,38 @@ NeighborList::NeighborList(unsigned int num_bonds, const unsigned int* query_poi
                            unsigned int num_query_points, const unsigned int* point_index,
                            unsigned int num_points, const float* distances, const float* weights)
     : m_num_query_points(num_query_points), m_num_points(num_points), m_neighbors({num_bonds, 2}),
-      m_distances(num_bonds), m_weights(num_bonds), m_segments_counts_updated(false)
+      m_distances(num_bonds), m_weights(num_bonds), m_vectors(0), m_has_vectors(false),
+      m_segments_counts_updated(false)
 {
-    unsigned int last_index(0);
-    for (unsigned int i = 0; i < num_bonds; i++)
-    {
-        unsigned int index = query_point_index[i];
-        if (index < last_index)
-        {
-            throw std::invalid_argument("NeighborList query_point_index must be sorted.");
-        }
-        if (index >= m_num_query_points)
+    // Validate and copy in parallel. Each block checks its own bonds plus the
+    // boundary against the previous block, which covers the full sortedness
+    // check; exceptions thrown inside the loop body are rethrown by TBB.
+    unsigned int* neighbors(m_neighbors.get());
+    float* bond_distances(m_distances.get());
+    float* bond_weights(m_weights.get());
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
         {
-            throw std::invalid_argument(
-                "NeighborList query_point_index values must be less than num_query_points.");
-        }
-        if (point_index[i] >= m_num_points)
-        {
-            throw std::invalid_argument("NeighborList point_index values must be less than num_points.");
+            const unsigned int index = query_point_index[i];
+            if (i > 0 && index < query_point_index[i - 1])
+            {
+                throw std::invalid_argument("NeighborList query_point_index must be sorted.");
+            }
+            if (index >= m_num_query_points)
+            {
+                throw std::invalid_argument(
+                    "NeighborList query_point_index values must be less than num_query_points.");
+            }
+            if (point_index[i] >= m_num_points)
+            {
+                throw std::invalid_argument("NeighborList point_index values must be less than num_points.");
+            }
+            neighbors[2 * i] = index;
+            neighbors[2 * i + 1] = point_index[i];
+            bond_weights[i] = weights[i];
+            bond_distances[i] = distances[i];
         }
-        m_neighbors(i, 0) = index;
-        m_neighbors(i, 1) = point_index[i];
-        m_weights[i] = weights[i];
-        m_distances[i] = distances[i];
-        last_index = index;
-    }
+    });
 }
 
 unsigned int NeighborList::getNumBonds() const
@@ -84,33 +153,64 @@ void NeighborList::updateSegmentCounts() const
     {
         m_counts.prepare(m_num_query_points);
         m_segments.prepare(m_num_query_points);
-        const unsigned int INDEX_TERMINATOR(0xffffffff);
-        unsigned int last_index(INDEX_TERMINATOR);
-        unsigned int counter(0);
-        for (unsigned int i = 0; i < getNumBonds(); i++)
-        {
-            const unsigned int index(m_neighbors(i, 0));
-            if (index != last_index)
+        const size_t num_bonds(getNumBonds());
+        const unsigned int* neighbors(m_neighbors.get());
+
+        // Bonds are sorted by query point index, so each segment is
+        // contiguous. Each block processes only the segments that begin
+        // inside it (following the last one past the block edge if needed),
+        // so every segment is written by exactly one thread.
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            size_t bond(begin);
+            if (begin > 0)
             {
-                m_segments[index] = i;
-                if (index > 0)
+                const unsigned int previous_index(neighbors[2 * (begin - 1)]);
+                while (bond < end && neighbors[2 * bond] == previous_index)
                 {
-                    if (last_index != INDEX_TERMINATOR)
-                    {
-                        m_counts[last_index] = counter;
-                    }
-                    counter = 0;
+                    bond++;
                 }
             }
-            last_index = index;
-            counter++;
-        }
-        if (last_index != INDEX_TERMINATOR)
+            while (bond < end)
+            {
+                const unsigned int index(neighbors[2 * bond]);
+                m_segments[index] = bond;
+                size_t segment_end(bond + 1);
+                while (segment_end < num_bonds && neighbors[2 * segment_end] == index)
+                {
+                    segment_end++;
+                }
+                m_counts[index] = segment_end - bond;
+                bond = segment_end;
+            }
+        });
+        m_segments_counts_updated = true;
+    }
+}
+
+void NeighborList::storeBondVectors(const box::Box& box, const vec3<float>* query_points,
+                                    const vec3<float>* points)
+{
+    const size_t num_bonds(getNumBonds());
+    m_vectors.prepare(num_bonds);
+    const unsigned int* neighbors(m_neighbors.get());
+    vec3<float>* vectors(m_vectors.get());
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
         {
-            m_counts[last_index] = counter;
+            vectors[bond] = box.wrap(points[neighbors[2 * bond + 1]] - query_points[neighbors[2 * bond]]);
         }
-        m_segments_counts_updated = true;
+    });
+    m_has_vectors = true;
+}
+
+const util::ManagedArray<vec3<float>>& NeighborList::getBondVectors() const
+{
+    if (!m_has_vectors)
+    {
+        throw std::runtime_error(
+            "NeighborList has no stored bond vectors; call storeBondVectors first.");
     }
+    return m_vectors;
 }
 
 // We are currently assuming that the input iterator has the correct length;
@@ -131,6 +231,7 @@ template<typename Iterator> unsigned int NeighborList::filter(Iterator begin)
     auto new_neighbors = util::ManagedArray<unsigned int>({new_size, 2});
     auto new_distances = util::ManagedArray<float>(new_size);
     auto new_weights = util::ManagedArray<float>(new_size);
+    auto new_vectors = util::ManagedArray<vec3<float>>(m_has_vectors ? new_size : 0);
 
     auto current_element = begin;
     unsigned int num_good(0);
@@ -142,6 +243,10 @@ template<typename Iterator> unsigned int NeighborList::filter(Iterator begin)
             new_neighbors(num_good, 1) = m_neighbors(i, 1);
             new_weights[num_good] = m_weights[i];
             new_distances[num_good] = m_distances[i];
+            if (m_has_vectors)
+            {
+                new_vectors[num_good] = m_vectors[i];
+            }
             ++num_good;
         }
         ++current_element;
@@ -150,6 +255,7 @@ template<typename Iterator> unsigned int NeighborList::filter(Iterator begin)
     m_neighbors = new_neighbors;
     m_distances = new_distances;
     m_weights = new_weights;
+    m_vectors = new_vectors;
     m_segments_counts_updated = false;
     return old_size - new_size;
 }
@@ -161,6 +267,157 @@ template unsigned int NeighborList::filter(std::vector<bool>::iterator);
 template unsigned int NeighborList::filter(const bool*);
 template unsigned int NeighborList::filter(bool*);
 
+template<typename Iterator> unsigned int NeighborList::filterInPlace(Iterator begin)
+{
+    const unsigned int old_size(getNumBonds());
+    unsigned int* neighbors(m_neighbors.get());
+    float* distances(m_distances.get());
+    float* weights(m_weights.get());
+    vec3<float>* vectors(m_has_vectors ? m_vectors.get() : nullptr);
+
+    // Pass 1: each block stably compacts its own survivors within its input
+    // range, so writes never overtake reads and blocks never touch each
+    // other's ranges.
+    const size_t num_blocks((old_size + FILTER_BLOCK_SIZE - 1) / FILTER_BLOCK_SIZE);
+    std::vector<size_t> block_counts(num_blocks, 0);
+    util::forLoopWrapper(0, num_blocks, [&](size_t block_begin, size_t block_end) {
+        for (size_t block = block_begin; block < block_end; ++block)
+        {
+            const size_t bond_begin(block * FILTER_BLOCK_SIZE);
+            const size_t bond_end(
+                std::min(static_cast<size_t>(old_size), bond_begin + FILTER_BLOCK_SIZE));
+            auto element = begin + bond_begin;
+            size_t out(bond_begin);
+            for (size_t i = bond_begin; i < bond_end; ++i, ++element)
+            {
+                if (*element)
+                {
+                    if (out != i)
+                    {
+                        neighbors[2 * out] = neighbors[2 * i];
+                        neighbors[2 * out + 1] = neighbors[2 * i + 1];
+                        distances[out] = distances[i];
+                        weights[out] = weights[i];
+                        if (vectors != nullptr)
+                        {
+                            vectors[out] = vectors[i];
+                        }
+                    }
+                    ++out;
+                }
+            }
+            block_counts[block] = out - bond_begin;
+        }
+    });
+
+    // Pass 2: slide each block's compacted run down to its final offset.
+    // Processing blocks left to right keeps the moves from overlapping, and
+    // the bandwidth-bound memmove is cheap next to the predicate pass above.
+    size_t new_size(0);
+    for (size_t block = 0; block < num_blocks; ++block)
+    {
+        const size_t bond_begin(block * FILTER_BLOCK_SIZE);
+        if (new_size != bond_begin && block_counts[block] > 0)
+        {
+            std::memmove(neighbors + 2 * new_size, neighbors + 2 * bond_begin,
+                         block_counts[block] * 2 * sizeof(unsigned int));
+            std::memmove(distances + new_size, distances + bond_begin,
+                         block_counts[block] * sizeof(float));
+            std::memmove(weights + new_size, weights + bond_begin, block_counts[block] * sizeof(float));
+            if (vectors != nullptr)
+            {
+                std::memmove(vectors + new_size, vectors + bond_begin,
+                             block_counts[block] * sizeof(vec3<float>));
+            }
+        }
+        new_size += block_counts[block];
+    }
+
+    if (new_size != old_size)
+    {
+        // Shrink the logical shape without giving up the allocation.
+        m_neighbors = shrinkToView(m_neighbors, {new_size, 2});
+        m_distances = shrinkToView(m_distances, {new_size});
+        m_weights = shrinkToView(m_weights, {new_size});
+        if (m_has_vectors)
+        {
+            m_vectors = shrinkToView(m_vectors, {new_size});
+        }
+        m_segments_counts_updated = false;
+    }
+    return old_size - static_cast<unsigned int>(new_size);
+}
+
+template unsigned int NeighborList::filterInPlace(std::vector<bool>::const_iterator);
+template unsigned int NeighborList::filterInPlace(std::vector<bool>::iterator);
+template unsigned int NeighborList::filterInPlace(const bool*);
+template unsigned int NeighborList::filterInPlace(bool*);
+
+template<typename Iterator> NeighborList NeighborList::filteredCopy(Iterator begin) const
+{
+    const unsigned int old_size(getNumBonds());
+
+    // Per-block survivor counts and a prefix sum give every block its output
+    // offset, so the survivors can be copied out in one parallel pass
+    // without modifying this object.
+    const size_t num_blocks((old_size + FILTER_BLOCK_SIZE - 1) / FILTER_BLOCK_SIZE);
+    std::vector<size_t> block_offsets(num_blocks + 1, 0);
+    util::forLoopWrapper(0, num_blocks, [&](size_t block_begin, size_t block_end) {
+        for (size_t block = block_begin; block < block_end; ++block)
+        {
+            const size_t bond_begin(block * FILTER_BLOCK_SIZE);
+            const size_t bond_end(
+                std::min(static_cast<size_t>(old_size), bond_begin + FILTER_BLOCK_SIZE));
+            block_offsets[block + 1] = std::count(begin + bond_begin, begin + bond_end, true);
+        }
+    });
+    for (size_t block = 0; block < num_blocks; ++block)
+    {
+        block_offsets[block + 1] += block_offsets[block];
+    }
+
+    NeighborList result;
+    const auto new_size = static_cast<unsigned int>(block_offsets[num_blocks]);
+    result.resize(new_size);
+    result.setNumBonds(new_size, m_num_query_points, m_num_points);
+    if (m_has_vectors)
+    {
+        result.m_vectors.prepare(new_size);
+        result.m_has_vectors = true;
+    }
+    util::forLoopWrapper(0, num_blocks, [&](size_t block_begin, size_t block_end) {
+        for (size_t block = block_begin; block < block_end; ++block)
+        {
+            const size_t bond_begin(block * FILTER_BLOCK_SIZE);
+            const size_t bond_end(
+                std::min(static_cast<size_t>(old_size), bond_begin + FILTER_BLOCK_SIZE));
+            auto element = begin + bond_begin;
+            size_t out(block_offsets[block]);
+            for (size_t i = bond_begin; i < bond_end; ++i, ++element)
+            {
+                if (*element)
+                {
+                    result.getNeighbors()(out, 0) = m_neighbors(i, 0);
+                    result.getNeighbors()(out, 1) = m_neighbors(i, 1);
+                    result.getDistances()[out] = m_distances[i];
+                    result.getWeights()[out] = m_weights[i];
+                    if (m_has_vectors)
+                    {
+                        result.m_vectors[out] = m_vectors[i];
+                    }
+                    ++out;
+                }
+            }
+        }
+    });
+    return result;
+}
+
+template NeighborList NeighborList::filteredCopy(std::vector<bool>::const_iterator) const;
+template NeighborList NeighborList::filteredCopy(std::vector<bool>::iterator) const;
+template NeighborList NeighborList::filteredCopy(const bool*) const;
+template NeighborList NeighborList::filteredCopy(bool*) const;
+
 unsigned int NeighborList::filter_r(float r_max, float r_min)
 {
     if (r_max <= 0)
@@ -176,7 +433,9 @@ unsigned int NeighborList::filter_r(float r_max, float r_min)
     {
         dist_filter[i] = (m_distances[i] >= r_min && m_distances[i] < r_max);
     }
-    return filter(dist_filter.cbegin());
+    // Sweeps with tightening radii filter the same list repeatedly, so
+    // compact in place rather than reallocating on every pass.
+    return filterInPlace(dist_filter.cbegin());
 }
 
 unsigned int NeighborList::find_first_index(unsigned int i) const
@@ -194,7 +453,10 @@ void NeighborList::resize(unsigned int num_bonds)
     auto new_distances = util::ManagedArray<float>(num_bonds);
     auto new_weights = util::ManagedArray<float>(num_bonds);
 
-    // On shrinking resizes, keep existing data.
+    // On shrinking resizes, keep existing data. Growing resizes add bonds
+    // whose vectors are unknown, so any stored vectors are dropped.
+    const bool keep_vectors(m_has_vectors && num_bonds <= getNumBonds());
+    auto new_vectors = util::ManagedArray<vec3<float>>(keep_vectors ? num_bonds : 0);
     if (num_bonds <= getNumBonds())
     {
         for (unsigned int i = 0; i < num_bonds; i++)
@@ -203,12 +465,18 @@ void NeighborList::resize(unsigned int num_bonds)
             new_neighbors(i, 1) = m_neighbors(i, 1);
             new_distances[i] = m_distances[i];
             new_weights[i] = m_weights[i];
+            if (keep_vectors)
+            {
+                new_vectors[i] = m_vectors[i];
+            }
         }
     }
 
     m_neighbors = new_neighbors;
     m_distances = new_distances;
     m_weights = new_weights;
+    m_vectors = new_vectors;
+    m_has_vectors = keep_vectors;
     m_segments_counts_updated = false;
 }
 
@@ -218,9 +486,152 @@ void NeighborList::copy(const NeighborList& other)
     m_neighbors = other.m_neighbors.copy();
     m_weights = other.m_weights.copy();
     m_distances = other.m_distances.copy();
+    if (other.m_has_vectors)
+    {
+        m_vectors = other.m_vectors.copy();
+    }
+    m_has_vectors = other.m_has_vectors;
     m_segments_counts_updated = false;
 }
 
+void NeighborList::save(const std::string& filename) const
+{
+    // Persist the CSR segments and counts as well so loads need no extra pass.
+    updateSegmentCounts();
+
+    NeighborListFileHeader header {};
+    std::memcpy(header.magic, NEIGHBOR_LIST_FILE_MAGIC, sizeof(header.magic));
+    header.version = NEIGHBOR_LIST_FILE_VERSION;
+    header.num_bonds = getNumBonds();
+    header.num_query_points = m_num_query_points;
+    header.num_points = m_num_points;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("NeighborList::save could not open the file for writing.");
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(m_neighbors.get()),
+               std::streamsize(header.num_bonds * 2 * sizeof(std::uint32_t)));
+    file.write(reinterpret_cast<const char*>(m_distances.get()),
+               std::streamsize(header.num_bonds * sizeof(float)));
+    file.write(reinterpret_cast<const char*>(m_weights.get()),
+               std::streamsize(header.num_bonds * sizeof(float)));
+    file.write(reinterpret_cast<const char*>(m_segments.get()),
+               std::streamsize(header.num_query_points * sizeof(std::uint32_t)));
+    file.write(reinterpret_cast<const char*>(m_counts.get()),
+               std::streamsize(header.num_query_points * sizeof(std::uint32_t)));
+    if (!file)
+    {
+        throw std::runtime_error("NeighborList::save failed to write the file.");
+    }
+}
+
+void NeighborList::load(const std::string& filename)
+{
+    // Bond vectors are not part of the file format; a loaded list starts
+    // without them and storeBondVectors() can rebuild them from positions.
+    m_vectors = util::ManagedArray<vec3<float>>(0);
+    m_has_vectors = false;
+#ifndef _WIN32
+    const int fd = open(filename.c_str(), O_RDONLY); // NOLINT(cppcoreguidelines-pro-type-vararg)
+    if (fd < 0)
+    {
+        throw std::runtime_error("NeighborList::load could not open the file for reading.");
+    }
+
+    struct stat file_info {};
+    if (fstat(fd, &file_info) != 0 || size_t(file_info.st_size) < sizeof(NeighborListFileHeader))
+    {
+        close(fd);
+        throw std::runtime_error("NeighborList::load found a truncated or unreadable file.");
+    }
+    const auto file_size = size_t(file_info.st_size);
+
+    // Map copy-on-write: pages are shared with the page cache (and with any
+    // other process mapping the same file) until they are written to, so
+    // loading is zero-copy and concurrent readers do not duplicate the data.
+    void* map = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        throw std::runtime_error("NeighborList::load failed to map the file.");
+    }
+    std::shared_ptr<void> mapping(map, [file_size](void* p) { munmap(p, file_size); });
+
+    auto* base = static_cast<char*>(map);
+    NeighborListFileHeader header {};
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, NEIGHBOR_LIST_FILE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != NEIGHBOR_LIST_FILE_VERSION || neighborListFileSize(header) != file_size)
+    {
+        throw std::runtime_error("NeighborList::load found an invalid or incompatible file.");
+    }
+
+    const auto num_bonds = size_t(header.num_bonds);
+    const auto num_query_points = size_t(header.num_query_points);
+    char* cursor = base + sizeof(header);
+    auto view_uint = [&](const std::vector<size_t>& shape, size_t count) {
+        util::ManagedArray<unsigned int> array(
+            shape, std::shared_ptr<unsigned int>(mapping, reinterpret_cast<unsigned int*>(cursor)));
+        cursor += count * sizeof(std::uint32_t);
+        return array;
+    };
+    auto view_float = [&](size_t count) {
+        util::ManagedArray<float> array(std::vector<size_t> {count},
+                                        std::shared_ptr<float>(mapping, reinterpret_cast<float*>(cursor)));
+        cursor += count * sizeof(float);
+        return array;
+    };
+
+    m_neighbors = view_uint({num_bonds, 2}, num_bonds * 2);
+    m_distances = view_float(num_bonds);
+    m_weights = view_float(num_bonds);
+    m_segments = view_uint({num_query_points}, num_query_points);
+    m_counts = view_uint({num_query_points}, num_query_points);
+    m_num_query_points = static_cast<unsigned int>(header.num_query_points);
+    m_num_points = static_cast<unsigned int>(header.num_points);
+    m_segments_counts_updated = true;
+#else
+    // Windows has no posix mmap; fall back to reading the file into memory.
+    std::ifstream file(filename, std::ios::binary);
+    if (!file)
+    {
+        throw std::runtime_error("NeighborList::load could not open the file for reading.");
+    }
+
+    NeighborListFileHeader header {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || std::memcmp(header.magic, NEIGHBOR_LIST_FILE_MAGIC, sizeof(header.magic)) != 0
+        || header.version != NEIGHBOR_LIST_FILE_VERSION)
+    {
+        throw std::runtime_error("NeighborList::load found an invalid or incompatible file.");
+    }
+
+    const auto num_bonds = static_cast<unsigned int>(header.num_bonds);
+    const auto num_query_points = static_cast<unsigned int>(header.num_query_points);
+    setNumBonds(num_bonds, num_query_points, static_cast<unsigned int>(header.num_points));
+    m_segments.prepare(num_query_points);
+    m_counts.prepare(num_query_points);
+    file.read(reinterpret_cast<char*>(m_neighbors.get()),
+              std::streamsize(size_t(num_bonds) * 2 * sizeof(std::uint32_t)));
+    file.read(reinterpret_cast<char*>(m_distances.get()),
+              std::streamsize(size_t(num_bonds) * sizeof(float)));
+    file.read(reinterpret_cast<char*>(m_weights.get()), std::streamsize(size_t(num_bonds) * sizeof(float)));
+    file.read(reinterpret_cast<char*>(m_segments.get()),
+              std::streamsize(size_t(num_query_points) * sizeof(std::uint32_t)));
+    file.read(reinterpret_cast<char*>(m_counts.get()),
+              std::streamsize(size_t(num_query_points) * sizeof(std::uint32_t)));
+    if (!file)
+    {
+        throw std::runtime_error("NeighborList::load found a truncated file.");
+    }
+    m_segments_counts_updated = true;
+#endif
+}
+
 void NeighborList::validate(unsigned int num_query_points, unsigned int num_points) const
 {
     if (num_query_points != m_num_query_points)
@@ -4,6 +4,7 @@
 #ifndef NEIGHBOR_LIST_H
 #define NEIGHBOR_LIST_H
 
+#include <string>
 #include <vector>
 
 #include "Box.h"
@@ -23,6 +24,10 @@ namespace freud { namespace locality {
 
     Query point and point indices are stored in a 2D array m_neighbors of shape
     (n_bonds, 2). The distances and weights arrays are flat per-bond arrays.
+    Optionally, the wrapped bond separation vectors can be materialized into an
+    additional flat per-bond array via storeBondVectors(), so computes that
+    consume the same list repeatedly read a linear vector stream instead of
+    gathering and wrapping positions for every bond on every pass.
  */
 class NeighborList
 {
@@ -106,10 +111,39 @@ public:
         return m_segments;
     }
 
+    //! Materialize the wrapped bond separation vectors into a per-bond array.
+    /*! The vector of each bond points from the query_point to the point and is
+     *  wrapped into the given box, matching the bondVector() convention used
+     *  throughout the compute modules. Storing the vectors trades one extra
+     *  vec3 per bond for eliminating the scattered position gathers and wraps
+     *  that every consuming compute otherwise repeats per bond per call; the
+     *  filter methods and copies keep the stored vectors consistent with the
+     *  surviving bonds. Call again to refresh after positions change.
+     */
+    void storeBondVectors(const box::Box& box, const vec3<float>* query_points, const vec3<float>* points);
+    //! Whether bond vectors have been stored via storeBondVectors().
+    bool hasBondVectors() const
+    {
+        return m_has_vectors;
+    }
+    //! Access the stored bond vectors. Throws if storeBondVectors() has not
+    //  been called on the current bonds.
+    const util::ManagedArray<vec3<float>>& getBondVectors() const;
+
     //! Remove bonds in this object based on an array of boolean values. The
     //  array must be at least as long as the number of neighbor bonds.
     //  Returns the number of bonds removed.
     template<typename Iterator> unsigned int filter(Iterator begin);
+    //! Remove bonds in this object based on an array of boolean values,
+    //  compacting the existing arrays in place instead of allocating new
+    //  ones. The surviving bonds keep their order and the allocation keeps
+    //  its capacity, so repeated filtering sweeps reuse the same memory.
+    //  Returns the number of bonds removed.
+    template<typename Iterator> unsigned int filterInPlace(Iterator begin);
+    //! Return a copy of this NeighborList restricted to the bonds where the
+    //  mask is true, leaving this object untouched. Useful when several
+    //  masks are applied to the same base list.
+    template<typename Iterator> NeighborList filteredCopy(Iterator begin) const;
     //! Remove bonds in this object based on minimum and maximum distance
     //  constraints. Returns the number of bonds removed.
     unsigned int filter_r(float r_max, float r_min = 0);
@@ -120,6 +154,14 @@ public:
     //! Resize member arrays to a different size
     void resize(unsigned int num_bonds);
 
+    //! Save the bonds to a binary file that can be memory-mapped by load()
+    void save(const std::string& filename) const;
+    //! Replace the contents of this object with bonds loaded from a file
+    //  written by save(). Where the platform allows, the bond arrays are
+    //  memory-mapped copy-on-write instead of being read into memory, so a
+    //  large list can be shared read-only by multiple concurrent processes.
+    void load(const std::string& filename);
+
     //! Copy the bonds from another NeighborList object
     void copy(const NeighborList& other);
     //! Throw a runtime_error if num_points and num_query_points do not match
@@ -140,6 +182,10 @@ private:
     util::ManagedArray<float> m_distances;
     //! Neighbor list per-bond weight array
     util::ManagedArray<float> m_weights;
+    //! Optional per-bond wrapped separation vectors (see storeBondVectors)
+    util::ManagedArray<vec3<float>> m_vectors;
+    //! Whether m_vectors currently holds vectors for the stored bonds
+    bool m_has_vectors;
 
     //! Track whether segments and counts are up to date
     mutable bool m_segments_counts_updated;
@@ -4,11 +4,17 @@
 #ifndef NEIGHBOR_QUERY_H
 #define NEIGHBOR_QUERY_H
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
+#include <tbb/task_group.h>
 #include <utility>
+#include <vector>
 
 #include "Box.h"
 #include "NeighborBond.h"
@@ -38,6 +44,7 @@ constexpr float DEFAULT_R_MIN(0);                         //!< Default minimum q
 constexpr float DEFAULT_R_GUESS(-1.0);                    //!< Default guess query distance.
 constexpr float DEFAULT_SCALE(-1.0);      //!< Default scaling parameter for AABB nearest neighbor queries.
 constexpr bool DEFAULT_EXCLUDE_II(false); //!< Default for whether or not to include self-neighbors.
+constexpr bool DEFAULT_MORTON_SORT(false); //!< Default for whether to traverse query points in Morton order.
 constexpr auto ITERATOR_TERMINATOR
     = NeighborBond(-1, -1, 0); //!< The object returned when iteration is complete.
 
@@ -60,12 +67,58 @@ struct QueryArgs
     float scale {DEFAULT_SCALE};          //! The scale factor to use when performing repeated ball queries
                                           //! to find a specified number of nearest neighbors.
     bool exclude_ii {DEFAULT_EXCLUDE_II}; //! If true, exclude self-neighbors.
+    bool morton_sort {DEFAULT_MORTON_SORT}; //! If true, traverse query points in Morton (Z-curve) order so
+                                            //! that consecutive queries are spatially adjacent and hit warm
+                                            //! cache lines in the spatial data structure. Results are
+                                            //! reported with their original query point indices.
 };
 
+//! Whether two validated QueryArgs describe queries with identical results.
+/*! morton_sort only changes the traversal order of the query points, never
+ *  the reported neighbors, so it does not participate in the comparison.
+ */
+inline bool queryArgsEquivalent(const QueryArgs& a, const QueryArgs& b)
+{
+    return a.mode == b.mode && a.num_neighbors == b.num_neighbors && a.r_max == b.r_max
+        && a.r_min == b.r_min && a.r_guess == b.r_guess && a.scale == b.scale
+        && a.exclude_ii == b.exclude_ii;
+}
+
 // Forward declare the iterators
 class NeighborQueryIterator;
 class NeighborQueryPerPointIterator;
 
+//! Cached Verlet candidate list for repeated ball queries.
+/*! Stores, in CSR form, the candidates found by a ball query performed with
+ *  an enlarged cutoff of r_max + skin, along with snapshots of the point and
+ *  query point positions at build time. As long as no point has moved more
+ *  than skin/2 since the snapshot was taken, every pair currently within
+ *  r_max is guaranteed to appear in the candidate list, so queries can be
+ *  served by filtering candidates with recomputed distances instead of
+ *  traversing the spatial data structure.
+ */
+struct VerletListCache
+{
+    std::vector<size_t> starts;           //!< Offset of each query point's candidates (CSR row starts).
+    std::vector<unsigned int> candidates; //!< Candidate point indices for all query points.
+    std::vector<vec3<float>> points_snapshot;       //!< Point positions when the cache was built.
+    std::vector<vec3<float>> query_points_snapshot; //!< Query point positions when the cache was built.
+    float r_max {0};                                //!< The (unenlarged) r_max the cache was built for.
+};
+
+//! One memoized query result held by the NeighborQuery query cache.
+/*! The query points are keyed by address: the cache is scoped to the
+ *  lifetime of one frame's arrays, during which identical pointers imply
+ *  identical coordinates.
+ */
+struct CachedQueryResult
+{
+    QueryArgs args;                             //!< The validated arguments the list was built with.
+    const vec3<float>* query_points;            //!< The query points the list was built against.
+    unsigned int n_query_points;                //!< The number of query points.
+    std::shared_ptr<const NeighborList> nlist;  //!< The shared immutable result.
+};
+
 //! Parent data structure for all neighbor finding algorithms.
 /*! This class defines the API for all data structures for accelerating
  *  neighbor finding. The object encapsulates a set of points and a system box
@@ -80,7 +133,19 @@ public:
     NeighborQuery() = default;
 
     //! Constructor
-    NeighborQuery(box::Box box, const vec3<float>* points, unsigned int n_points)
+    /*! \param box The simulation box.
+     *  \param points The points to build the structure over.
+     *  \param n_points The number of points.
+     *  \param spatial_sort If true, the points are copied and reordered along
+     *             a Morton (Z-)curve before the spatial data structure is
+     *             built over them, so that spatially adjacent points occupy
+     *             adjacent memory and traversals touch contiguous cache
+     *             lines. The reordering persists for the lifetime of the
+     *             object: getPoints() returns the sorted copy, while all
+     *             neighbor indices reported by queries are mapped back to the
+     *             caller's input order (see getOriginalPointIndex()).
+     */
+    NeighborQuery(box::Box box, const vec3<float>* points, unsigned int n_points, bool spatial_sort = false)
         : m_box(std::move(box)), m_points(points), m_n_points(n_points)
     {
         // Reject systems with 0 particles
@@ -100,6 +165,11 @@ public:
                 }
             }
         }
+
+        if (spatial_sort && m_n_points > 1)
+        {
+            applySpatialSort();
+        }
     }
 
     //! Empty Destructor
@@ -128,9 +198,90 @@ public:
         }
 
         this->validateQueryArgs(query_args);
+        if (m_verlet_skin > float(0.0) && query_args.mode == QueryType::ball)
+        {
+            return this->queryVerlet(query_points, n_query_points, query_args);
+        }
         return std::make_shared<NeighborQueryIterator>(this, query_points, n_query_points, query_args);
     }
 
+    //! Enable Verlet-list caching of ball queries.
+    /*! When enabled, the first ball query builds a candidate list using an
+     *  enlarged cutoff of r_max + skin. Subsequent ball queries with the same
+     *  r_max and query points are served by filtering the cached candidates,
+     *  which avoids repeated traversals of the spatial data structure when the
+     *  same system is queried several times per frame. The cache is
+     *  invalidated automatically when any point or query point has moved more
+     *  than skin/2 since the cache was built, or when r_max or the number of
+     *  query points changes.
+     *
+     *  \param skin The skin distance added to r_max when building the
+     *              candidate list; larger skins survive more motion but
+     *              produce more candidates to filter.
+     */
+    void enableVerletList(float skin)
+    {
+        if (skin <= float(0.0))
+        {
+            throw std::invalid_argument("The Verlet list skin distance must be positive.");
+        }
+        m_verlet_skin = skin;
+        m_verlet_cache.reset();
+    }
+
+    //! Disable Verlet-list caching and free the cached candidates.
+    void disableVerletList()
+    {
+        m_verlet_skin = 0;
+        m_verlet_cache.reset();
+    }
+
+    //! Enable memoization of materialized query results.
+    /*! When enabled, computes that would otherwise traverse this object
+     *  through the generic neighbor loops instead materialize the query into
+     *  a NeighborList once and share the immutable result: subsequent
+     *  queries with equivalent arguments (see queryArgsEquivalent()) against
+     *  the same query point array replay the cached list with no traversal.
+     *  The cache is keyed by the query point address and assumes positions
+     *  do not change while it is enabled, matching the lifetime of one
+     *  frame's system; call clearQueryCache() when reusing this object with
+     *  updated coordinates.
+     */
+    void enableQueryCache()
+    {
+        m_query_cache_enabled = true;
+    }
+
+    //! Disable query-result memoization and free the cached lists.
+    void disableQueryCache()
+    {
+        m_query_cache_enabled = false;
+        m_query_cache.clear();
+    }
+
+    //! Drop all memoized query results.
+    void clearQueryCache()
+    {
+        m_query_cache.clear();
+    }
+
+    //! Whether query-result memoization is enabled.
+    bool queryCacheEnabled() const
+    {
+        return m_query_cache_enabled;
+    }
+
+    //! Get a shared, memoized NeighborList for the given query.
+    /*! Returns the cached list when an equivalent query against the same
+     *  query points has already been materialized, and otherwise performs
+     *  the query, stores the result, and returns it. The returned list is
+     *  shared and must not be modified. Lookups and insertions happen on the
+     *  calling thread; the query itself parallelizes internally as usual.
+     */
+    inline std::shared_ptr<const NeighborList>
+    cachedNeighborList(const vec3<float>* query_points, unsigned int n_query_points,
+                       QueryArgs query_args) const;
+
     //! Perform a per-particle query based on a set of query parameters.
     /*! This function is the primary interface by which subclasses provide
      *  logic for finding neighbors. All such logic should be contained in
@@ -162,6 +313,21 @@ public:
         return m_n_points;
     }
 
+    //! Whether the points were spatially sorted at construction.
+    bool spatialSortEnabled() const
+    {
+        return !m_original_index.empty();
+    }
+
+    //! Map an index into the (sorted) stored points back to the input order.
+    /*! Identity unless the object was constructed with spatial sorting.
+     *  \param sorted_index An index into the array returned by getPoints().
+     */
+    unsigned int getOriginalPointIndex(unsigned int sorted_index) const
+    {
+        return m_original_index.empty() ? sorted_index : m_original_index[sorted_index];
+    }
+
     //! Get a point's coordinates using index operator notation
     /*! \param index The point index to return.
      */
@@ -239,9 +405,30 @@ protected:
         }
     }
 
+    //! Serve a ball query from the Verlet cache, rebuilding it if it is stale.
+    inline std::shared_ptr<NeighborQueryIterator>
+    queryVerlet(const vec3<float>* query_points, unsigned int n_query_points, QueryArgs query_args) const;
+
+    //! Check whether the current Verlet cache can serve the given query.
+    inline bool verletCacheValid(const vec3<float>* query_points, unsigned int n_query_points,
+                                 const QueryArgs& query_args) const;
+
+    //! Build the Verlet cache with an enlarged cutoff of r_max + skin.
+    inline void buildVerletCache(const vec3<float>* query_points, unsigned int n_query_points,
+                                 QueryArgs query_args) const;
+
+    //! Reorder the points along a Morton curve into owned storage.
+    inline void applySpatialSort();
+
     const box::Box m_box;        //!< Simulation box where the particles belong.
     const vec3<float>* m_points; //!< Point coordinates.
     unsigned int m_n_points;     //!< Number of points.
+    std::vector<vec3<float>> m_sorted_points;   //!< Owned Morton-ordered copy of the points (spatial sort).
+    std::vector<unsigned int> m_original_index; //!< Sorted index -> input index (empty when not sorting).
+    float m_verlet_skin {0};     //!< Skin distance for Verlet-list caching (0 disables caching).
+    mutable std::unique_ptr<VerletListCache> m_verlet_cache; //!< Cached ball query candidates.
+    bool m_query_cache_enabled {false}; //!< Whether query results are memoized.
+    mutable std::vector<CachedQueryResult> m_query_cache; //!< Memoized query results.
 };
 
 //! Implementation of per-point finding logic for NeighborQuery objects.
@@ -288,6 +475,110 @@ protected:
     bool m_exclude_ii; //!< Flag to indicate whether or not to include self bonds.
 };
 
+//! Per-point iterator mapping spatially sorted point indices back to input order.
+/*! When a NeighborQuery is constructed with spatial sorting, its subclasses
+ *  find neighbors among (and report indices into) the sorted copy of the
+ *  points. This decorator remaps each bond's point index through the stored
+ *  permutation so that callers always see indices into the array they
+ *  provided. Self-exclusion must be applied here, after remapping, since the
+ *  inner iterator cannot recognize the self bond from sorted indices; for
+ *  nearest queries the caller therefore disables exclusion on the inner
+ *  iterator, requests one extra neighbor when excluding (the self bond would
+ *  otherwise consume one of the k slots), and caps the emitted bonds at k
+ *  through max_bonds.
+ */
+class SpatialSortPerPointIterator : public NeighborQueryPerPointIterator
+{
+public:
+    //! Constructor
+    SpatialSortPerPointIterator(std::shared_ptr<NeighborQueryPerPointIterator> iter,
+                                const NeighborQuery* neighbor_query, const vec3<float>& query_point,
+                                unsigned int query_point_idx, bool exclude_ii, unsigned int max_bonds)
+        : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, 0, 0, exclude_ii),
+          m_iter(std::move(iter)), m_max_bonds(max_bonds)
+    {}
+
+    //! Empty Destructor
+    ~SpatialSortPerPointIterator() override = default;
+
+    //! Get the next element, remapped to the input order.
+    NeighborBond next() override
+    {
+        while (m_emitted < m_max_bonds)
+        {
+            NeighborBond nb = m_iter->next();
+            if (m_iter->end())
+            {
+                break;
+            }
+            nb.point_idx = m_neighbor_query->getOriginalPointIndex(nb.point_idx);
+            if (m_exclude_ii && nb.point_idx == m_query_point_idx)
+            {
+                continue;
+            }
+            ++m_emitted;
+            return nb;
+        }
+        m_finished = true;
+        return ITERATOR_TERMINATOR;
+    }
+
+private:
+    std::shared_ptr<NeighborQueryPerPointIterator> m_iter; //!< The sorted-index iterator being decorated.
+    unsigned int m_max_bonds; //!< Maximum number of bonds to emit (caps kNN queries at k).
+    unsigned int m_emitted {0}; //!< The number of bonds emitted so far.
+};
+
+//! Spread the lowest 10 bits of an integer so they occupy every third bit.
+inline std::uint32_t expandBits3(std::uint32_t v)
+{
+    v = (v * 0x00010001U) & 0xFF0000FFU;
+    v = (v * 0x00000101U) & 0x0F00F00FU;
+    v = (v * 0x00000011U) & 0xC30C30C3U;
+    v = (v * 0x00000005U) & 0x49249249U;
+    return v;
+}
+
+//! Compute the 30-bit Morton (Z-curve) code of a point.
+/*! \param fraction The point in fractional coordinates; each component is
+ *                  clamped to [0, 1) and quantized to 10 bits.
+ */
+inline std::uint32_t getMortonCode(const vec3<float>& fraction)
+{
+    const auto quantize = [](float f) {
+        return static_cast<std::uint32_t>(util::clamp(f * float(1024.0), float(0.0), float(1023.0)));
+    };
+    return (expandBits3(quantize(fraction.x)) << 2) | (expandBits3(quantize(fraction.y)) << 1)
+        | expandBits3(quantize(fraction.z));
+}
+
+/*! Copies the points into owned storage ordered along a Morton (Z-)curve and
+   repoints m_points at the sorted copy, so that the spatial data structure a
+   subclass builds afterwards (AABB tree leaves, link cells) references
+   contiguous position ranges. The permutation is recorded in m_original_index
+   so query results can be mapped back to the caller's input order.
+*/
+inline void NeighborQuery::applySpatialSort()
+{
+    std::vector<std::uint32_t> codes(m_n_points);
+    util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            codes[i] = getMortonCode(m_box.makeFractional(m_points[i]));
+        }
+    });
+    m_original_index.resize(m_n_points);
+    std::iota(m_original_index.begin(), m_original_index.end(), 0);
+    tbb::parallel_sort(m_original_index.begin(), m_original_index.end(),
+                       [&codes](unsigned int a, unsigned int b) { return codes[a] < codes[b]; });
+    m_sorted_points.resize(m_n_points);
+    for (unsigned int i = 0; i < m_n_points; ++i)
+    {
+        m_sorted_points[i] = m_points[m_original_index[i]];
+    }
+    m_points = m_sorted_points.data();
+}
+
 //! The iterator class for neighbor queries on NeighborQuery objects.
 /*! All queries to a NeighborQuery return instances of this class. The
  *  NeighborQueryIterator is capable of either iterating over all neighbors of
@@ -295,10 +586,11 @@ protected:
  *  NeighborQuery object, or of providing NeighborQueryPerPoint iterator
  *  instances for any of the query_points it was constructed with. The first
  *  interface is much more convenient for user interaction, while the second is
- *  primarily provided to support thread-safe parallelism. This class is not
- *  designed to be inherited from; the implementation of the querySingle method
- *  in NeighborQuery subclasses (to return per-point iterators) should be
- *  sufficient for this class to work.
+ *  primarily provided to support thread-safe parallelism. The implementation
+ *  of the querySingle method in NeighborQuery subclasses (to return per-point
+ *  iterators) is sufficient for this class to work; subclasses of this class
+ *  may additionally override query() to change where per-point neighbors come
+ *  from (see VerletNeighborQueryIterator).
  */
 class NeighborQueryIterator
 {
@@ -309,11 +601,30 @@ public:
         : m_neighbor_query(neighbor_query), m_query_points(query_points),
           m_num_query_points(num_query_points), m_qargs(qargs), m_finished(false), m_cur_p(0)
     {
-        m_iter = this->query(m_cur_p);
+        if (qargs.morton_sort && m_num_query_points > 1)
+        {
+            // Traverse query points along a Z-curve so that consecutive
+            // queries are spatially adjacent and reuse cached tree/cell data.
+            // Results keep their original query point indices, so output is
+            // unaffected by the traversal order.
+            const box::Box& box = m_neighbor_query->getBox();
+            std::vector<std::uint32_t> codes(m_num_query_points);
+            util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    codes[i] = getMortonCode(box.makeFractional(m_query_points[i]));
+                }
+            });
+            m_traversal_order.resize(m_num_query_points);
+            std::iota(m_traversal_order.begin(), m_traversal_order.end(), 0);
+            tbb::parallel_sort(
+                m_traversal_order.begin(), m_traversal_order.end(),
+                [&codes](unsigned int a, unsigned int b) { return codes[a] < codes[b]; });
+        }
     }
 
     //! Empty Destructor
-    ~NeighborQueryIterator() = default;
+    virtual ~NeighborQueryIterator() = default;
 
     //! Indicate when done.
     bool end() const
@@ -322,9 +633,34 @@ public:
     }
 
     //! Get an iterator for a specific query point by index.
-    std::shared_ptr<NeighborQueryPerPointIterator> query(unsigned int i)
+    /*! Subclasses may override this to source per-point neighbors from
+     *  somewhere other than the NeighborQuery object (e.g. a cached candidate
+     *  list); next() and toNeighborList() then work unchanged.
+     */
+    virtual std::shared_ptr<NeighborQueryPerPointIterator> query(unsigned int i)
     {
-        return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
+        if (!m_neighbor_query->spatialSortEnabled())
+        {
+            return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
+        }
+        // The subclass reports indices into its sorted copy of the points, so
+        // exclusion is deferred to the remapping decorator. Nearest queries
+        // request one extra neighbor when excluding (the self bond would
+        // otherwise consume a slot) and are capped back at k on emission.
+        QueryArgs inner_args = m_qargs;
+        inner_args.exclude_ii = false;
+        unsigned int max_bonds = std::numeric_limits<unsigned int>::max();
+        if (m_qargs.mode == QueryType::nearest)
+        {
+            max_bonds = m_qargs.num_neighbors;
+            if (m_qargs.exclude_ii)
+            {
+                ++inner_args.num_neighbors;
+            }
+        }
+        return std::make_shared<SpatialSortPerPointIterator>(
+            m_neighbor_query->querySingle(m_query_points[i], i, inner_args), m_neighbor_query,
+            m_query_points[i], i, m_qargs.exclude_ii, max_bonds);
     }
 
     //! Get the next element.
@@ -334,6 +670,12 @@ public:
         {
             return ITERATOR_TERMINATOR;
         }
+        // The per-point iterator is created lazily on the first call so that
+        // the virtual query() of the most derived class is used.
+        if (!m_iter)
+        {
+            m_iter = this->query(traversalIndex(m_cur_p));
+        }
         NeighborBond nb;
         while (true)
         {
@@ -351,19 +693,59 @@ public:
             {
                 break;
             }
-            m_iter = this->query(m_cur_p);
+            m_iter = this->query(traversalIndex(m_cur_p));
         }
         m_finished = true;
         return ITERATOR_TERMINATOR;
     }
 
+    //! Fill caller-provided buffers with the next chunk of bonds.
+    /*! Streams the query results in bounded-memory chunks: each call drains
+     *  up to max_bonds bonds into the given arrays and returns the number
+     *  actually written, with 0 indicating that iteration is complete. The
+     *  iterator state carries across calls, so a loop over nextChunk visits
+     *  exactly the bonds that repeated next() calls would, in the same
+     *  order, without materializing the whole result. This is the intended
+     *  backend for chunked language bindings: the caller preallocates K-bond
+     *  blocks (e.g. NumPy arrays viewed as raw pointers) and pays one call
+     *  per block instead of one per bond, keeping memory bounded for
+     *  arbitrarily large queries.
+     *
+     *  \param query_point_indices Buffer of max_bonds entries for the query point indices.
+     *  \param point_indices Buffer of max_bonds entries for the point indices.
+     *  \param distances Buffer of max_bonds entries for the bond distances.
+     *  \param max_bonds The capacity of the buffers.
+     */
+    unsigned int nextChunk(unsigned int* query_point_indices, unsigned int* point_indices, float* distances,
+                           unsigned int max_bonds)
+    {
+        unsigned int written = 0;
+        while (written < max_bonds)
+        {
+            const NeighborBond nb = next();
+            if (m_finished)
+            {
+                break;
+            }
+            query_point_indices[written] = nb.query_point_idx;
+            point_indices[written] = nb.point_idx;
+            distances[written] = nb.distance;
+            ++written;
+        }
+        return written;
+    }
+
     //! Generate a NeighborList from query.
-    /*! This function exploits parallelism by finding the neighbors for
-     *  each query point in parallel and adding them to a list, which is
-     *  then sorted in parallel as well before being added to the
-     *  NeighborList object. Right now this won't be backwards compatible
-     *  because the kn query is not symmetric, so even if we reverse the
-     *  output order here the actual neighbors found will be different.
+    /*! The NeighborList is assembled in two passes: the neighbors of each
+     *  query point are first counted in parallel and an exclusive scan of the
+     *  counts provides each query point's segment offset in the final CSR
+     *  layout, after which a second parallel pass writes each query point's
+     *  bonds (sorted within the segment) directly into the NeighborList
+     *  arrays. Bonds are grouped by query point by construction, so no
+     *  global sort or intermediate bond buffer is needed. Right now this
+     *  won't be backwards compatible because the kn query is not symmetric,
+     *  so even if we reverse the output order here the actual neighbors found
+     *  will be different.
      *
      *  This function returns a pointer, not a shared pointer, so the
      *  caller is responsible for deleting it. The reason for this is that
@@ -372,49 +754,74 @@ public:
      */
     NeighborList* toNeighborList(bool sort_by_distance = false)
     {
-        using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
-        BondVector bonds;
+        // Pass 1: count the neighbors of each query point.
+        std::vector<size_t> offsets(size_t(m_num_query_points) + 1, 0);
         util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
-            BondVector::reference local_bonds(bonds.local());
-            NeighborBond nb;
             for (size_t i = begin; i < end; ++i)
             {
-                std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(i);
+                const unsigned int qp = traversalIndex(i);
+                size_t count(0);
+                std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(qp);
                 while (!it->end())
                 {
-                    nb = it->next();
-                    // If we're excluding ii bonds, we have to check before adding.
-                    if (nb != ITERATOR_TERMINATOR)
+                    if (it->next() != ITERATOR_TERMINATOR)
                     {
-                        local_bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
+                        ++count;
                     }
                 }
+                offsets[size_t(qp) + 1] = count;
             }
         });
 
-        tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
-        std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
-        if (sort_by_distance)
-        {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborDistance);
-        }
-        else
+        // Exclusive scan of the counts gives the CSR segment offsets.
+        for (size_t i = 0; i < m_num_query_points; ++i)
         {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
+            offsets[i + 1] += offsets[i];
         }
-
-        unsigned int num_bonds = linear_bonds.size();
+        const auto num_bonds = static_cast<unsigned int>(offsets[m_num_query_points]);
 
         auto* nl = new NeighborList();
         nl->setNumBonds(num_bonds, m_num_query_points, m_neighbor_query->getNPoints());
 
-        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-            for (size_t bond = begin; bond < end; ++bond)
+        // Pass 2: write each query point's bonds into its segment of the
+        // final arrays. Only a per-point scratch buffer is needed to order
+        // the bonds within a segment; since bonds are already grouped by
+        // query point, this reproduces the ordering of a global sort.
+        using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
+        BondVector scratch;
+        util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
+            BondVector::reference local_bonds(scratch.local());
+            for (size_t i = begin; i < end; ++i)
             {
-                nl->getNeighbors()(bond, 0) = linear_bonds[bond].query_point_idx;
-                nl->getNeighbors()(bond, 1) = linear_bonds[bond].point_idx;
-                nl->getDistances()[bond] = linear_bonds[bond].distance;
-                nl->getWeights()[bond] = float(1.0);
+                const unsigned int qp = traversalIndex(i);
+                local_bonds.clear();
+                std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(qp);
+                while (!it->end())
+                {
+                    NeighborBond nb = it->next();
+                    if (nb != ITERATOR_TERMINATOR)
+                    {
+                        local_bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
+                    }
+                }
+                if (sort_by_distance)
+                {
+                    std::sort(local_bonds.begin(), local_bonds.end(), compareNeighborDistance);
+                }
+                else
+                {
+                    std::sort(local_bonds.begin(), local_bonds.end(), compareNeighborBond);
+                }
+
+                size_t bond = offsets[qp];
+                for (const auto& nb : local_bonds)
+                {
+                    nl->getNeighbors()(bond, 0) = nb.query_point_idx;
+                    nl->getNeighbors()(bond, 1) = nb.point_idx;
+                    nl->getDistances()[bond] = nb.distance;
+                    nl->getWeights()[bond] = float(1.0);
+                    ++bond;
+                }
             }
         });
 
@@ -422,16 +829,344 @@ public:
     }
 
 protected:
+    //! Map a traversal position to a query point index.
+    /*! Identity unless Morton-ordered traversal was requested via the query
+     *  arguments.
+     */
+    unsigned int traversalIndex(size_t position) const
+    {
+        return m_traversal_order.empty() ? static_cast<unsigned int>(position)
+                                         : m_traversal_order[position];
+    }
+
     const NeighborQuery* m_neighbor_query;                 //!< Link to the NeighborQuery object.
     const vec3<float>* m_query_points;                     //!< Coordinates of the query points.
     unsigned int m_num_query_points;                       //!< The number of query points.
     const QueryArgs m_qargs;                               //!< The query arguments
     std::shared_ptr<NeighborQueryPerPointIterator> m_iter; //!< The per-point iterator being used.
+    std::vector<unsigned int> m_traversal_order; //!< Morton-sorted traversal order (empty for input order).
 
     bool m_finished; //!< Flag to indicate that iteration is complete (must be set by next on termination).
     unsigned int m_cur_p; //!< The current particle under consideration.
 };
 
+//! Iterator over the cached Verlet candidates of a single query point.
+/*! Walks the slice of the Verlet candidate list belonging to one query point,
+ *  recomputing minimum image distances against the current point positions
+ *  and filtering by the r_max/r_min of the query actually being served.
+ */
+class VerletListPerPointIterator : public NeighborQueryPerPointIterator
+{
+public:
+    //! Constructor
+    VerletListPerPointIterator(const NeighborQuery* neighbor_query, const vec3<float>& query_point,
+                               unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
+                               const unsigned int* candidates, size_t num_candidates)
+        : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
+                                        exclude_ii),
+          m_candidates(candidates), m_num_candidates(num_candidates),
+          m_box_shape(neighbor_query->getBox().getShape())
+    {}
+
+    //! Empty Destructor
+    ~VerletListPerPointIterator() override = default;
+
+    //! Get the next element.
+    /*! Dispatches once on the box shape so the candidate loop runs the
+     *  wrap kernel matching this box with all shape branches compiled away.
+     */
+    NeighborBond next() override
+    {
+        switch (m_box_shape)
+        {
+        case box::Box::Shape::Orthorhombic2D:
+            return nextShape<box::Box::Shape::Orthorhombic2D>();
+        case box::Box::Shape::Orthorhombic3D:
+            return nextShape<box::Box::Shape::Orthorhombic3D>();
+        default:
+            return nextShape<box::Box::Shape::Triclinic>();
+        }
+    }
+
+private:
+    //! Candidate loop specialized on the box shape.
+    template<box::Box::Shape shape> NeighborBond nextShape()
+    {
+        const float r_max_sq = m_r_max * m_r_max;
+        const float r_min_sq = m_r_min * m_r_min;
+        while (m_cur < m_num_candidates)
+        {
+            const unsigned int j = m_candidates[m_cur];
+            ++m_cur;
+
+            if (m_exclude_ii && m_query_point_idx == j)
+            {
+                continue;
+            }
+
+            const vec3<float> r_ij
+                = m_neighbor_query->getBox().wrapShape<shape>((*m_neighbor_query)[j] - m_query_point);
+            const float r_sq = dot(r_ij, r_ij);
+            if (r_sq < r_max_sq && r_sq >= r_min_sq)
+            {
+                return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
+            }
+        }
+        m_finished = true;
+        return ITERATOR_TERMINATOR;
+    }
+
+    const unsigned int* m_candidates; //!< This query point's slice of the cached candidate list.
+    size_t m_num_candidates;          //!< The number of cached candidates for this query point.
+    size_t m_cur {0};                 //!< The current index into the candidate slice.
+    box::Box::Shape m_box_shape;      //!< Shape category of the box, classified at construction.
+};
+
+//! Iterator serving a ball query from a Verlet candidate cache.
+/*! Behaves exactly like its parent, but sources per-point neighbors from the
+ *  Verlet cache held by the NeighborQuery instead of traversing the spatial
+ *  data structure. The cache must outlive the iterator; it is owned by the
+ *  NeighborQuery that created this iterator and remains valid until the next
+ *  query that rebuilds it.
+ */
+class VerletNeighborQueryIterator : public NeighborQueryIterator
+{
+public:
+    //! Constructor
+    VerletNeighborQueryIterator(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                unsigned int num_query_points, QueryArgs& qargs,
+                                const VerletListCache& cache)
+        : NeighborQueryIterator(neighbor_query, query_points, num_query_points, qargs), m_cache(cache)
+    {}
+
+    //! Empty Destructor
+    ~VerletNeighborQueryIterator() override = default;
+
+    //! Get an iterator over the cached candidates for query point i.
+    /*! With spatial sorting enabled the cached candidates are sorted indices,
+     *  so the iterator is wrapped in the remapping decorator and exclusion is
+     *  deferred to it, as in the parent's query().
+     */
+    std::shared_ptr<NeighborQueryPerPointIterator> query(unsigned int i) override
+    {
+        const bool sorted = m_neighbor_query->spatialSortEnabled();
+        auto it = std::make_shared<VerletListPerPointIterator>(
+            m_neighbor_query, m_query_points[i], i, m_qargs.r_max, m_qargs.r_min,
+            m_qargs.exclude_ii && !sorted, m_cache.candidates.data() + m_cache.starts[i],
+            m_cache.starts[i + 1] - m_cache.starts[i]);
+        if (!sorted)
+        {
+            return it;
+        }
+        return std::make_shared<SpatialSortPerPointIterator>(std::move(it), m_neighbor_query,
+                                                             m_query_points[i], i, m_qargs.exclude_ii,
+                                                             std::numeric_limits<unsigned int>::max());
+    }
+
+private:
+    const VerletListCache& m_cache; //!< The candidate cache owned by the NeighborQuery.
+};
+
+/*! \param query_points The points to find neighbors for.
+    \param n_query_points The number of query points.
+    \param query_args The (already validated) query arguments.
+
+    Rebuilds the Verlet cache if it cannot serve this query and returns an
+   iterator that filters the cached candidates.
+*/
+inline std::shared_ptr<NeighborQueryIterator>
+NeighborQuery::queryVerlet(const vec3<float>* query_points, unsigned int n_query_points,
+                           QueryArgs query_args) const
+{
+    if (!verletCacheValid(query_points, n_query_points, query_args))
+    {
+        buildVerletCache(query_points, n_query_points, query_args);
+    }
+    return std::make_shared<VerletNeighborQueryIterator>(this, query_points, n_query_points, query_args,
+                                                         *m_verlet_cache);
+}
+
+/*! \param query_points The points to find neighbors for.
+    \param n_query_points The number of query points.
+    \param query_args The (already validated) query arguments.
+
+    The cache can serve a query when it was built for the same r_max and the
+   same number of query points, and neither the points nor the query points
+   have moved more than skin/2 since the snapshot was taken. Under that bound,
+   no pair can have approached by more than skin, so every pair currently
+   within r_max was within r_max + skin at build time and is present in the
+   candidate list.
+*/
+inline bool NeighborQuery::verletCacheValid(const vec3<float>* query_points, unsigned int n_query_points,
+                                            const QueryArgs& query_args) const
+{
+    if (!m_verlet_cache || m_verlet_cache->r_max != query_args.r_max
+        || m_verlet_cache->query_points_snapshot.size() != n_query_points
+        || m_verlet_cache->points_snapshot.size() != m_n_points)
+    {
+        return false;
+    }
+
+    const float max_disp_sq = (m_verlet_skin / float(2.0)) * (m_verlet_skin / float(2.0));
+    for (unsigned int i = 0; i < m_n_points; ++i)
+    {
+        const vec3<float> dr = m_box.wrap(m_points[i] - m_verlet_cache->points_snapshot[i]);
+        if (dot(dr, dr) > max_disp_sq)
+        {
+            return false;
+        }
+    }
+    for (unsigned int i = 0; i < n_query_points; ++i)
+    {
+        const vec3<float> dr = m_box.wrap(query_points[i] - m_verlet_cache->query_points_snapshot[i]);
+        if (dot(dr, dr) > max_disp_sq)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*! \param query_points The points to find neighbors for.
+    \param n_query_points The number of query points.
+    \param query_args The (already validated) query arguments.
+
+    Runs a full ball query with the cutoff enlarged by the skin distance and
+   stores the resulting pairs as a CSR candidate list, along with snapshots of
+   all positions for the displacement-based invalidation check. The enlarged
+   query is run without the ii exclusion so the cache can serve queries with
+   either setting.
+*/
+inline void NeighborQuery::buildVerletCache(const vec3<float>* query_points, unsigned int n_query_points,
+                                            QueryArgs query_args) const
+{
+    std::unique_ptr<VerletListCache> cache(new VerletListCache());
+    cache->r_max = query_args.r_max;
+
+    QueryArgs wide_args = query_args;
+    wide_args.r_max += m_verlet_skin;
+    wide_args.r_min = 0;
+    wide_args.exclude_ii = false;
+
+    using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
+    BondVector bonds;
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        BondVector::reference local_bonds(bonds.local());
+        for (size_t i = begin; i < end; ++i)
+        {
+            std::shared_ptr<NeighborQueryPerPointIterator> it
+                = this->querySingle(query_points[i], i, wide_args);
+            while (!it->end())
+            {
+                NeighborBond nb = it->next();
+                if (nb != ITERATOR_TERMINATOR)
+                {
+                    local_bonds.emplace_back(nb);
+                }
+            }
+        }
+    });
+
+    tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
+    std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
+    tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
+
+    // Assemble the CSR structure from the sorted bonds.
+    cache->starts.assign(size_t(n_query_points) + 1, 0);
+    cache->candidates.reserve(linear_bonds.size());
+    for (const auto& bond : linear_bonds)
+    {
+        cache->starts[bond.query_point_idx + 1]++;
+        cache->candidates.push_back(bond.point_idx);
+    }
+    for (size_t i = 0; i < n_query_points; ++i)
+    {
+        cache->starts[i + 1] += cache->starts[i];
+    }
+
+    cache->points_snapshot.assign(m_points, m_points + m_n_points);
+    cache->query_points_snapshot.assign(query_points, query_points + n_query_points);
+
+    m_verlet_cache = std::move(cache);
+}
+
+/*! \param query_points The points to find neighbors for.
+    \param n_query_points The number of query points.
+    \param query_args The query arguments.
+
+    The arguments are validated first so that cached entries compare against
+   canonical values (e.g. an inferred mode) regardless of how the caller
+   specified them.
+*/
+inline std::shared_ptr<const NeighborList>
+NeighborQuery::cachedNeighborList(const vec3<float>* query_points, unsigned int n_query_points,
+                                  QueryArgs query_args) const
+{
+    this->validateQueryArgs(query_args);
+    for (const auto& entry : m_query_cache)
+    {
+        if (entry.query_points == query_points && entry.n_query_points == n_query_points
+            && queryArgsEquivalent(entry.args, query_args))
+        {
+            return entry.nlist;
+        }
+    }
+    std::shared_ptr<const NeighborList> nlist(
+        this->query(query_points, n_query_points, query_args)->toNeighborList());
+    m_query_cache.push_back({query_args, query_points, n_query_points, nlist});
+    return nlist;
+}
+
+//! Build and query a batch of frames inside one software pipeline.
+/*! Driver loops that construct a NeighborQuery and query it once per frame
+ *  pay the full construction latency on the critical path of every
+ *  iteration. This helper accepts F frames of positions sharing one box and
+ *  point count, queries each frame against its own points, and overlaps the
+ *  construction of frame i+1's query structure (e.g. an AABB tree) with the
+ *  query of frame i using a tbb::task_group, so construction cost is hidden
+ *  behind query work for all but the first frame.
+ *
+ *  \param box The simulation box shared by all frames.
+ *  \param frames Per-frame pointers to the point positions. Each array must
+ *                remain valid until the call returns.
+ *  \param n_points The number of points in every frame.
+ *  \param qargs The query arguments applied to every frame.
+ *  \return One NeighborList per frame, in frame order. As with
+ *          toNeighborList, the caller takes ownership.
+ */
+template<typename NeighborQueryType>
+std::vector<NeighborList*> buildAndQueryFrames(const box::Box& box,
+                                               const std::vector<const vec3<float>*>& frames,
+                                               unsigned int n_points, QueryArgs qargs)
+{
+    const size_t num_frames = frames.size();
+    std::vector<NeighborList*> neighbor_lists(num_frames);
+
+    tbb::task_group builder;
+    std::shared_ptr<NeighborQueryType> current_frame;
+    std::shared_ptr<NeighborQueryType> next_frame;
+    if (num_frames > 0)
+    {
+        current_frame = std::make_shared<NeighborQueryType>(box, frames[0], n_points);
+    }
+    for (size_t frame = 0; frame < num_frames; ++frame)
+    {
+        if (frame + 1 < num_frames)
+        {
+            builder.run([&next_frame, &box, &frames, n_points, frame]() {
+                next_frame = std::make_shared<NeighborQueryType>(box, frames[frame + 1], n_points);
+            });
+        }
+        neighbor_lists[frame] = current_frame->query(frames[frame], n_points, qargs)->toNeighborList();
+        if (frame + 1 < num_frames)
+        {
+            builder.wait();
+            current_frame = std::move(next_frame);
+        }
+    }
+    return neighbor_lists;
+}
+
 }; }; // end namespace freud::locality
 
 #endif // NEIGHBOR_QUERY_H
@@ -1,9 +1,11 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
 #include <stdexcept>
 
 #include "PeriodicBuffer.h"
+#include "utils.h"
 
 /*! \file PeriodicBuffer.cc
     \brief Replicates points across periodic boundaries.
@@ -11,8 +13,8 @@
 
 namespace freud { namespace locality {
 
-void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
-                             const bool use_images)
+void PeriodicBuffer::setup(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
+                           const bool use_images)
 {
     m_box = neighbor_query->getBox();
     if (buff.x < 0)
@@ -27,6 +29,7 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
     {
         throw std::invalid_argument("Buffer z distance must be non-negative.");
     }
+    m_use_images = use_images;
 
     // Get the box dimensions
     vec3<float> L(m_box.getL());
@@ -55,63 +58,252 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
         images.z = 0;
     }
 
-    m_buffer_points.clear();
-    m_buffer_ids.clear();
-
-    // for each point
-    for (unsigned int point_id = 0; point_id < neighbor_query->getNPoints(); point_id++)
+    // Enumerate the image shifts. Each shift later becomes one tile of
+    // ghost points, and the eager path loops over them in this order.
+    m_shifts.clear();
+    for (int i = use_images ? 0 : -images.x; i <= images.x; i++)
     {
-        for (int i = use_images ? 0 : -images.x; i <= images.x; i++)
+        for (int j = use_images ? 0 : -images.y; j <= images.y; j++)
         {
-            for (int j = use_images ? 0 : -images.y; j <= images.y; j++)
+            for (int k = use_images ? 0 : -images.z; k <= images.z; k++)
             {
-                for (int k = use_images ? 0 : -images.z; k <= images.z; k++)
+                // Skip the origin image
+                if (i == 0 && j == 0 && k == 0)
                 {
-                    // Skip the origin image
-                    if (i == 0 && j == 0 && k == 0)
-                    {
-                        continue;
-                    }
+                    continue;
+                }
+                m_shifts.emplace_back(i, j, k);
+            }
+        }
+    }
 
-                    // Compute the new position for the buffer point,
-                    // shifted by images.
-                    vec3<float> point_image = (*neighbor_query)[point_id];
-                    point_image += float(i) * m_box.getLatticeVector(0);
-                    point_image += float(j) * m_box.getLatticeVector(1);
-                    if (!is2D)
-                    {
-                        point_image += float(k) * m_box.getLatticeVector(2);
-                    }
+    // Snapshot the points so ghost generation does not depend on the
+    // NeighborQuery outliving this object.
+    const unsigned int n_points = neighbor_query->getNPoints();
+    m_points.resize(n_points);
+    for (unsigned int point_id = 0; point_id < n_points; point_id++)
+    {
+        m_points[point_id] = (*neighbor_query)[point_id];
+    }
+}
+
+vec3<float> PeriodicBuffer::imagePosition(const vec3<float>& point, const vec3<int>& shift) const
+{
+    // Compute the new position for the buffer point, shifted by images.
+    vec3<float> point_image = point;
+    point_image += float(shift.x) * m_box.getLatticeVector(0);
+    point_image += float(shift.y) * m_box.getLatticeVector(1);
+    if (!m_box.is2D())
+    {
+        point_image += float(shift.z) * m_box.getLatticeVector(2);
+    }
+    return point_image;
+}
+
+bool PeriodicBuffer::isInBuffer(const vec3<float>& point_image) const
+{
+    // When using a buffer "skin distance," we check the fractional
+    // coordinates to see if the points are inside the buffer box.
+    // Unexpected results may occur due to numerical imprecision in this
+    // check!
+    vec3<float> buff_frac = m_buffer_box.makeFractional(point_image);
+    return 0 <= buff_frac.x && buff_frac.x < 1 && 0 <= buff_frac.y && buff_frac.y < 1
+        && (m_box.is2D() || (0 <= buff_frac.z && buff_frac.z < 1));
+}
 
-                    if (use_images)
+void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
+                             const bool use_images)
+{
+    setup(neighbor_query, buff, use_images);
+    m_lazy = false;
+
+    const size_t n_points = m_points.size();
+    const size_t n_shifts = m_shifts.size();
+
+    if (use_images)
+    {
+        // Wrap the positions back into the buffer box and always append
+        // them if a number of images was specified. Performing the check
+        // this way ensures we have the correct number of points instead of
+        // relying on the floating point precision of the fractional check
+        // below. Every shift produces a ghost, so all output slots are
+        // known up front and the images can be generated in parallel.
+        m_buffer_points.resize(n_points * n_shifts);
+        m_buffer_ids.resize(n_points * n_shifts);
+        util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+            for (size_t point_id = begin; point_id < end; ++point_id)
+            {
+                for (size_t shift = 0; shift < n_shifts; ++shift)
+                {
+                    m_buffer_points[point_id * n_shifts + shift]
+                        = m_buffer_box.wrap(imagePosition(m_points[point_id], m_shifts[shift]));
+                    m_buffer_ids[point_id * n_shifts + shift] = point_id;
+                }
+            }
+        });
+    }
+    else
+    {
+        // Two passes: count the images surviving the skin check for each
+        // point, take a prefix sum, then fill each point's slots in
+        // parallel. The output matches the serial point-major ordering.
+        std::vector<size_t> offsets(n_points + 1, 0);
+        util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+            for (size_t point_id = begin; point_id < end; ++point_id)
+            {
+                size_t count(0);
+                for (size_t shift = 0; shift < n_shifts; ++shift)
+                {
+                    if (isInBuffer(imagePosition(m_points[point_id], m_shifts[shift])))
                     {
-                        // Wrap the positions back into the buffer box and
-                        // always append them if a number of images was
-                        // specified. Performing the check this way ensures we
-                        // have the correct number of points instead of
-                        // relying on the floating point precision of the
-                        // fractional check below.
-                        m_buffer_points.push_back(m_buffer_box.wrap(point_image));
-                        m_buffer_ids.push_back(point_id);
+                        count++;
                     }
-                    else
+                }
+                offsets[point_id + 1] = count;
+            }
+        });
+        for (size_t point_id = 0; point_id < n_points; ++point_id)
+        {
+            offsets[point_id + 1] += offsets[point_id];
+        }
+
+        m_buffer_points.resize(offsets[n_points]);
+        m_buffer_ids.resize(offsets[n_points]);
+        util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+            for (size_t point_id = begin; point_id < end; ++point_id)
+            {
+                size_t slot = offsets[point_id];
+                for (size_t shift = 0; shift < n_shifts; ++shift)
+                {
+                    const vec3<float> point_image = imagePosition(m_points[point_id], m_shifts[shift]);
+                    if (isInBuffer(point_image))
                     {
-                        // When using a buffer "skin distance," we check the
-                        // fractional coordinates to see if the points are
-                        // inside the buffer box. Unexpected results may occur
-                        // due to numerical imprecision in this check!
-                        vec3<float> buff_frac = m_buffer_box.makeFractional(point_image);
-                        if (0 <= buff_frac.x && buff_frac.x < 1 && 0 <= buff_frac.y && buff_frac.y < 1
-                            && (is2D || (0 <= buff_frac.z && buff_frac.z < 1)))
-                        {
-                            m_buffer_points.push_back(point_image);
-                            m_buffer_ids.push_back(point_id);
-                        }
+                        m_buffer_points[slot] = point_image;
+                        m_buffer_ids[slot] = point_id;
+                        slot++;
                     }
                 }
             }
+        });
+    }
+}
+
+void PeriodicBuffer::computeLazy(const freud::locality::NeighborQuery* neighbor_query,
+                                 const vec3<float>& buff, const bool use_images)
+{
+    setup(neighbor_query, buff, use_images);
+    m_lazy = true;
+
+    // Nothing is materialized; ghosts are streamed by getTile() or
+    // generated per region by getBufferPointsInRegion().
+    m_buffer_points.clear();
+    m_buffer_ids.clear();
+}
+
+void PeriodicBuffer::getTile(unsigned int tile, std::vector<vec3<float>>& buffer_points,
+                             std::vector<unsigned int>& buffer_ids) const
+{
+    if (!m_lazy)
+    {
+        throw std::runtime_error("getTile requires a buffer prepared with computeLazy.");
+    }
+    if (tile >= m_shifts.size())
+    {
+        throw std::invalid_argument("Tile index is out of range.");
+    }
+
+    buffer_points.clear();
+    buffer_ids.clear();
+    const vec3<int>& shift = m_shifts[tile];
+    for (unsigned int point_id = 0; point_id < m_points.size(); point_id++)
+    {
+        const vec3<float> point_image = imagePosition(m_points[point_id], shift);
+        if (m_use_images)
+        {
+            buffer_points.push_back(m_buffer_box.wrap(point_image));
+            buffer_ids.push_back(point_id);
+        }
+        else if (isInBuffer(point_image))
+        {
+            buffer_points.push_back(point_image);
+            buffer_ids.push_back(point_id);
         }
     }
 }
 
+void PeriodicBuffer::getBufferPointsInRegion(const vec3<float>& position, float r_max,
+                                             std::vector<vec3<float>>& buffer_points,
+                                             std::vector<unsigned int>& buffer_ids) const
+{
+    if (!m_lazy)
+    {
+        throw std::runtime_error("getBufferPointsInRegion requires a buffer prepared with computeLazy.");
+    }
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("getBufferPointsInRegion requires a positive search distance.");
+    }
+
+    const size_t n_points = m_points.size();
+    const size_t n_shifts = m_shifts.size();
+    const float r_max_sq = r_max * r_max;
+
+    // The region check compares absolute positions: ghosts live outside the
+    // original box, so no wrapping is applied to the distance. Same
+    // count/fill two-pass structure as the eager path.
+    auto ghost_in_region = [&](size_t point_id, size_t shift, vec3<float>& ghost) {
+        ghost = imagePosition(m_points[point_id], m_shifts[shift]);
+        if (m_use_images)
+        {
+            ghost = m_buffer_box.wrap(ghost);
+        }
+        else if (!isInBuffer(ghost))
+        {
+            return false;
+        }
+        const vec3<float> delta = ghost - position;
+        return dot(delta, delta) <= r_max_sq;
+    };
+
+    std::vector<size_t> offsets(n_points + 1, 0);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t point_id = begin; point_id < end; ++point_id)
+        {
+            size_t count(0);
+            vec3<float> ghost;
+            for (size_t shift = 0; shift < n_shifts; ++shift)
+            {
+                if (ghost_in_region(point_id, shift, ghost))
+                {
+                    count++;
+                }
+            }
+            offsets[point_id + 1] = count;
+        }
+    });
+    for (size_t point_id = 0; point_id < n_points; ++point_id)
+    {
+        offsets[point_id + 1] += offsets[point_id];
+    }
+
+    buffer_points.resize(offsets[n_points]);
+    buffer_ids.resize(offsets[n_points]);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t point_id = begin; point_id < end; ++point_id)
+        {
+            size_t slot = offsets[point_id];
+            vec3<float> ghost;
+            for (size_t shift = 0; shift < n_shifts; ++shift)
+            {
+                if (ghost_in_region(point_id, shift, ghost))
+                {
+                    buffer_points[slot] = ghost;
+                    buffer_ids[slot] = point_id;
+                    slot++;
+                }
+            }
+        }
+    });
+}
+
 }; }; // end namespace freud::locality
@@ -34,10 +34,34 @@ public:
         return m_buffer_box;
     }
 
-    //! Compute the periodic buffer
+    //! Compute the periodic buffer, materializing all replicated points
     void compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
                  const bool use_images);
 
+    //! Set up a lazy periodic buffer. Only the parameters and a snapshot of
+    //  the points are stored; ghost points are generated on demand with
+    //  getTile() or getBufferPointsInRegion() instead of being materialized
+    //  all at once, keeping memory bounded for wide buffers.
+    void computeLazy(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
+                     const bool use_images);
+
+    //! Number of tiles a lazy buffer streams ghost points in. Each tile
+    //  holds the ghosts of one periodic image shift.
+    unsigned int getNumTiles() const
+    {
+        return m_shifts.size();
+    }
+
+    //! Generate the ghost points of one tile of a lazy buffer.
+    void getTile(unsigned int tile, std::vector<vec3<float>>& buffer_points,
+                 std::vector<unsigned int>& buffer_ids) const;
+
+    //! Generate only the ghost points of a lazy buffer that lie within
+    //  r_max of the given position.
+    void getBufferPointsInRegion(const vec3<float>& position, float r_max,
+                                 std::vector<vec3<float>>& buffer_points,
+                                 std::vector<unsigned int>& buffer_ids) const;
+
     //! Return the buffer points
     std::vector<vec3<float>> getBufferPoints() const
     {
@@ -51,8 +75,24 @@ public:
     }
 
 private:
+    //! Validate arguments and set up the boxes, image counts, image shifts,
+    //  and point snapshot shared by the eager and lazy paths.
+    void setup(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
+               bool use_images);
+
+    //! Compute the image of a point under the given image shift.
+    vec3<float> imagePosition(const vec3<float>& point, const vec3<int>& shift) const;
+
+    //! Check whether an image position lies inside the buffer box (the skin
+    //  distance criterion used when images are not explicitly requested).
+    bool isInBuffer(const vec3<float>& point_image) const;
+
     freud::box::Box m_box;                    //!< Simulation box of the original points
     freud::box::Box m_buffer_box;             //!< Simulation box of the replicated points
+    bool m_use_images {false};                //!< Whether buff counts images rather than a distance
+    bool m_lazy {false};                      //!< Whether ghost points are generated on demand
+    std::vector<vec3<float>> m_points;        //!< Snapshot of the original points
+    std::vector<vec3<int>> m_shifts;          //!< Image shifts, one per tile
     std::vector<vec3<float>> m_buffer_points; //!< The replicated points
     std::vector<unsigned int> m_buffer_ids;   //!< The replicated points' original point ids
 };
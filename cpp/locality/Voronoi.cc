@@ -1,13 +1,19 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <atomic>
 #include <cmath>
 #include <iterator>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
+#include <tbb/task_arena.h>
 #include <vector>
 
 #include "NeighborBond.h"
 #include "Voronoi.h"
+#include "utils.h"
 
 /*! \file Voronoi.cc
     \brief Computes Voronoi neighbors for a set of points.
@@ -17,6 +23,19 @@ namespace freud { namespace locality {
 
 // Voronoi calculations should be kept in double precision.
 void Voronoi::compute(const freud::locality::NeighborQuery* nq)
+{
+    auto bonds = computeCells(nq);
+    buildNeighborList(bonds, nq->getNPoints());
+}
+
+std::vector<NeighborBond> Voronoi::computeBonds(const freud::locality::NeighborQuery* nq)
+{
+    auto bonds = computeCells(nq);
+    sortBonds(bonds);
+    return bonds;
+}
+
+std::vector<NeighborBond> Voronoi::computeCells(const freud::locality::NeighborQuery* nq)
 {
     const auto box = nq->getBox();
     const auto n_points = nq->getNPoints();
@@ -24,6 +43,151 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
     m_polytopes.resize(n_points);
     m_volumes.prepare(n_points);
 
+    std::vector<NeighborBond> bonds;
+
+    // The sharded path slices the box into orthogonal z-slabs, so it only
+    // applies to untilted 3D boxes; everything else takes the reference
+    // serial path. The sharded path can also decline the computation (too
+    // few slabs fit in the box, or a cell grew past its ghost margin), in
+    // which case we recompute serially from scratch.
+    const bool orthorhombic = (box.getTiltFactorXY() == float(0.0)) && (box.getTiltFactorXZ() == float(0.0))
+        && (box.getTiltFactorYZ() == float(0.0));
+    if (n_points >= SHARDED_VORONOI_MIN_POINTS && !box.is2D() && orthorhombic)
+    {
+        if (computeSharded(nq, bonds))
+        {
+            return bonds;
+        }
+        bonds.clear();
+    }
+    computeSerial(nq, bonds);
+    return bonds;
+}
+
+double Voronoi::processCell(voro::voronoicell_neighbor& cell, unsigned int query_point_id,
+                            vec3<double> query_point, const freud::locality::NeighborQuery* nq,
+                            std::vector<NeighborBond>& bonds)
+{
+    const auto box = nq->getBox();
+    const auto n_points = nq->getNPoints();
+
+    std::vector<double> face_areas;
+    std::vector<int> face_vertices;
+    std::vector<int> neighbors;
+    std::vector<double> normals;
+    std::vector<double> vertices;
+
+    // Get Voronoi cell properties
+    cell.face_areas(face_areas);
+    cell.face_vertices(face_vertices);
+    cell.neighbors(neighbors);
+    cell.normals(normals);
+    cell.vertices(query_point.x, query_point.y, query_point.z, vertices);
+
+    // Compute polytope vertices in relative coordinates, tracking the
+    // farthest vertex for the sharded path's ghost margin validation.
+    double max_radius_sq(0);
+    std::vector<vec3<double>> relative_vertices;
+    auto vertex_iterator = vertices.begin();
+    while (vertex_iterator != vertices.end())
+    {
+        double vert_x = *vertex_iterator;
+        vertex_iterator++;
+        double vert_y = *vertex_iterator;
+        vertex_iterator++;
+        double vert_z = *vertex_iterator;
+        vertex_iterator++;
+
+        vec3<double> delta = vec3<double>(vert_x, vert_y, vert_z) - query_point;
+        max_radius_sq = std::max(max_radius_sq, dot(delta, delta));
+
+        // In 2D systems, only use vertices from the upper plane
+        // to prevent double-counting, and set z=0 manually
+        if (box.is2D())
+        {
+            if (vert_z < 0)
+            {
+                continue;
+            }
+            delta.z = 0;
+        }
+        relative_vertices.push_back(delta);
+    }
+
+    // Sort relative vertices by their angle in 2D systems
+    if (box.is2D())
+    {
+        std::sort(relative_vertices.begin(), relative_vertices.end(),
+                  [](const vec3<double>& a, const vec3<double>& b) {
+                      return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+                  });
+    }
+
+    // Save polytope vertices in system coordinates
+    const vec3<double>& query_point_system_coords((*nq)[query_point_id]);
+
+    std::vector<vec3<double>> system_vertices;
+    system_vertices.reserve(relative_vertices.size());
+    std::transform(relative_vertices.begin(), relative_vertices.end(), std::back_inserter(system_vertices),
+                   [&](const auto& relative_vertex) { return relative_vertex + query_point_system_coords; });
+    m_polytopes[query_point_id] = system_vertices;
+
+    // Save cell volume
+    m_volumes[query_point_id] = cell.volume();
+
+    // Compute cell neighbors
+    size_t neighbor_counter(0);
+    for (auto neighbor_iterator = neighbors.begin(); neighbor_iterator != neighbors.end();
+         neighbor_iterator++, neighbor_counter++)
+    {
+        // Get the normal to the current face
+        const vec3<double> normal(normals[3 * neighbor_counter], normals[3 * neighbor_counter + 1],
+                                  normals[3 * neighbor_counter + 2]);
+
+        // Ignore bonds in 2D systems that point up or down. This check
+        // should only be dealing with bonds whose normal vectors' z
+        // components are -1, 0, or +1 (within some tolerance). This
+        // also skips bonds where the normal vector is exactly zero.
+        // A normal vector of exactly zero seems to appear for certain
+        // particles in 2D systems where the neighbors are very close.
+        // It seems like an issue of numerical imprecision but could be
+        // some other pathological case.
+        if (box.is2D() && std::abs(normal.z) > 0.5 || (normal.x == 0 && normal.y == 0 && normal.z == 0))
+        {
+            continue;
+        }
+
+        // Fetch neighbor information. Ghost particles in the sharded path
+        // carry an id offset by n_points; map them back to the real
+        // particle. Negative ids (container walls) can only belong to cells
+        // that fail the margin validation, so they are safe to skip.
+        int point_id = *neighbor_iterator;
+        if (point_id < 0)
+        {
+            continue;
+        }
+        if (point_id >= static_cast<int>(n_points))
+        {
+            point_id -= static_cast<int>(n_points);
+        }
+        const float weight(face_areas[neighbor_counter]);
+        const vec3<double> point_system_coords((*nq)[point_id]);
+
+        // Compute the distance from query_point to point.
+        const vec3<float> rij = box.wrap(point_system_coords - query_point_system_coords);
+        const float distance(std::sqrt(dot(rij, rij)));
+
+        bonds.emplace_back(query_point_id, point_id, distance, weight);
+    }
+
+    return max_radius_sq;
+}
+
+void Voronoi::computeSerial(const freud::locality::NeighborQuery* nq, std::vector<NeighborBond>& bonds)
+{
+    const auto box = nq->getBox();
+    const auto n_points = nq->getNPoints();
+
     const vec3<float> v1 = box.getLatticeVector(0);
     const vec3<float> v2 = box.getLatticeVector(1);
     const vec3<float> v3 = (box.is2D() ? vec3<float>(0, 0, 1) : box.getLatticeVector(2));
@@ -50,12 +214,6 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
 
     voro::voronoicell_neighbor cell;
     voro::c_loop_all_periodic voronoi_loop(container);
-    std::vector<double> face_areas;
-    std::vector<int> face_vertices;
-    std::vector<int> neighbors;
-    std::vector<double> normals;
-    std::vector<double> vertices;
-    std::vector<NeighborBond> bonds;
 
     if (voronoi_loop.start())
     {
@@ -67,109 +225,190 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
             const int query_point_id(voronoi_loop.pid());
             vec3<double> query_point(voronoi_loop.x(), voronoi_loop.y(), voronoi_loop.z());
 
-            // Get Voronoi cell properties
-            cell.face_areas(face_areas);
-            cell.face_vertices(face_vertices);
-            cell.neighbors(neighbors);
-            cell.normals(normals);
-            cell.vertices(query_point.x, query_point.y, query_point.z, vertices);
-
-            // Compute polytope vertices in relative coordinates
-            std::vector<vec3<double>> relative_vertices;
-            auto vertex_iterator = vertices.begin();
-            while (vertex_iterator != vertices.end())
-            {
-                double vert_x = *vertex_iterator;
-                vertex_iterator++;
-                double vert_y = *vertex_iterator;
-                vertex_iterator++;
-                double vert_z = *vertex_iterator;
-                vertex_iterator++;
-
-                // In 2D systems, only use vertices from the upper plane
-                // to prevent double-counting, and set z=0 manually
-                if (box.is2D())
-                {
-                    if (vert_z < 0)
-                    {
-                        continue;
-                    }
-                    vert_z = 0;
-                }
-                vec3<double> delta = vec3<double>(vert_x, vert_y, vert_z) - query_point;
-                relative_vertices.push_back(delta);
-            }
+            processCell(cell, query_point_id, query_point, nq, bonds);
+        } while (voronoi_loop.inc());
+    }
+}
 
-            // Sort relative vertices by their angle in 2D systems
-            if (box.is2D())
-            {
-                std::sort(relative_vertices.begin(), relative_vertices.end(),
-                          [](const vec3<double>& a, const vec3<double>& b) {
-                              return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
-                          });
-            }
+bool Voronoi::computeSharded(const freud::locality::NeighborQuery* nq, std::vector<NeighborBond>& bonds)
+{
+    const auto box = nq->getBox();
+    const auto n_points = nq->getNPoints();
+    const double lx = box.getLx();
+    const double ly = box.getLy();
+    const double lz = box.getLz();
+
+    // Ghost margin of a few typical interparticle spacings. A cell is only
+    // accepted if its farthest vertex lies within half the margin: any
+    // particle outside the ghost region is then too distant to cut it.
+    const double typical_spacing = std::cbrt(box.getVolume() / static_cast<double>(n_points));
+    const double margin = 4.0 * typical_spacing;
 
-            // Save polytope vertices in system coordinates
-            const vec3<double>& query_point_system_coords((*nq)[query_point_id]);
+    const auto max_threads = static_cast<unsigned int>(tbb::this_task_arena::max_concurrency());
+    const auto max_slabs = static_cast<unsigned int>(lz / (2.0 * margin));
+    const unsigned int num_slabs = std::min(max_threads, max_slabs);
+    if (num_slabs < 2)
+    {
+        return false;
+    }
+    const double slab_width = lz / num_slabs;
+    // An owned particle must never see its own periodic image as a ghost.
+    if (slab_width + 2.0 * margin > lz)
+    {
+        return false;
+    }
 
-            std::vector<vec3<double>> system_vertices;
-            system_vertices.reserve(relative_vertices.size());
-            std::transform(
-                relative_vertices.begin(), relative_vertices.end(), std::back_inserter(system_vertices),
-                [&](const auto& relative_vertex) { return relative_vertex + query_point_system_coords; });
-            m_polytopes[query_point_id] = system_vertices;
+    // Bin wrapped particles into their owning slab and into the ghost list
+    // of every slab whose margin-extended range covers them (possibly
+    // through the periodic z boundary).
+    std::vector<vec3<double>> wrapped(n_points);
+    std::vector<std::vector<unsigned int>> owned(num_slabs);
+    std::vector<std::vector<unsigned int>> ghosts(num_slabs);
+    const auto num_slabs_int = static_cast<int>(num_slabs);
+    for (unsigned int i = 0; i < n_points; i++)
+    {
+        wrapped[i] = vec3<double>(box.wrap((*nq)[i]));
+        const double shifted_z = wrapped[i].z + lz / 2.0;
+        const int slab = util::clamp(static_cast<int>(std::floor(shifted_z / slab_width)), 0,
+                                     num_slabs_int - 1);
+        owned[slab].push_back(i);
+
+        const int ghost_begin = static_cast<int>(std::floor((shifted_z - margin) / slab_width));
+        const int ghost_end = static_cast<int>(std::floor((shifted_z + margin) / slab_width));
+        for (int neighbor_slab = ghost_begin; neighbor_slab <= ghost_end; neighbor_slab++)
+        {
+            const int wrapped_slab = util::modulusPositive(neighbor_slab, num_slabs_int);
+            if (wrapped_slab != slab)
+            {
+                ghosts[wrapped_slab].push_back(i);
+            }
+        }
+    }
 
-            // Save cell volume
-            m_volumes[query_point_id] = cell.volume();
+    std::atomic<bool> valid(true);
+    tbb::enumerable_thread_specific<std::vector<NeighborBond>> bond_vectors;
 
-            // Compute cell neighbors
-            size_t neighbor_counter(0);
-            for (auto neighbor_iterator = neighbors.begin(); neighbor_iterator != neighbors.end();
-                 neighbor_iterator++, neighbor_counter++)
+    tbb::parallel_for(
+        tbb::blocked_range<unsigned int>(0, num_slabs, 1), [&](const tbb::blocked_range<unsigned int>& r) {
+            for (unsigned int slab = r.begin(); slab != r.end(); slab++)
             {
-                // Get the normal to the current face
-                const vec3<double> normal(normals[3 * neighbor_counter], normals[3 * neighbor_counter + 1],
-                                          normals[3 * neighbor_counter + 2]);
-
-                // Ignore bonds in 2D systems that point up or down. This check
-                // should only be dealing with bonds whose normal vectors' z
-                // components are -1, 0, or +1 (within some tolerance). This
-                // also skips bonds where the normal vector is exactly zero.
-                // A normal vector of exactly zero seems to appear for certain
-                // particles in 2D systems where the neighbors are very close.
-                // It seems like an issue of numerical imprecision but could be
-                // some other pathological case.
-                if (box.is2D() && std::abs(normal.z) > 0.5
-                    || (normal.x == 0 && normal.y == 0 && normal.z == 0))
+                if (owned[slab].empty() || !valid.load(std::memory_order_relaxed))
                 {
                     continue;
                 }
+                const double z_lo = -lz / 2.0 + slab * slab_width;
+                const double ghost_lo = z_lo - margin;
+                const double ghost_hi = z_lo + slab_width + margin;
 
-                // Fetch neighbor information
-                const int point_id = *neighbor_iterator;
-                const float weight(face_areas[neighbor_counter]);
-                const vec3<double> point_system_coords((*nq)[point_id]);
+                // Same block-size heuristic as the serial path, applied to
+                // the slab's extended volume.
+                const size_t n_local = owned[slab].size() + ghosts[slab].size();
+                const double block_scale = std::pow(
+                    n_local / (voro::optimal_particles * lx * ly * (ghost_hi - ghost_lo)), 1.0 / 3.0);
+                const int voro_blocks_x = int(lx * block_scale + 1);
+                const int voro_blocks_y = int(ly * block_scale + 1);
+                const int voro_blocks_z = int((ghost_hi - ghost_lo) * block_scale + 1);
 
-                // Compute the distance from query_point to point.
-                const vec3<float> rij = box.wrap(point_system_coords - query_point_system_coords);
-                const float distance(std::sqrt(dot(rij, rij)));
+                // Periodic in x and y; z is covered by explicit ghosts.
+                voro::container container(-lx / 2.0, lx / 2.0, -ly / 2.0, ly / 2.0, ghost_lo, ghost_hi,
+                                          voro_blocks_x, voro_blocks_y, voro_blocks_z, true, true, false, 3);
+                for (const unsigned int i : owned[slab])
+                {
+                    container.put(static_cast<int>(i), wrapped[i].x, wrapped[i].y, wrapped[i].z);
+                }
+                for (const unsigned int i : ghosts[slab])
+                {
+                    double ghost_z = wrapped[i].z;
+                    if (ghost_z < ghost_lo)
+                    {
+                        ghost_z += lz;
+                    }
+                    else if (ghost_z > ghost_hi)
+                    {
+                        ghost_z -= lz;
+                    }
+                    // Ghosts carry an offset id so the cell loop below can
+                    // skip them; processCell maps neighbor ids back.
+                    container.put(static_cast<int>(n_points + i), wrapped[i].x, wrapped[i].y, ghost_z);
+                }
 
-                bonds.emplace_back(query_point_id, point_id, distance, weight);
+                std::vector<NeighborBond>& bonds = bond_vectors.local();
+                voro::voronoicell_neighbor cell;
+                voro::c_loop_all voronoi_loop(container);
+                size_t num_processed(0);
+                if (voronoi_loop.start())
+                {
+                    do
+                    {
+                        const int query_point_id(voronoi_loop.pid());
+                        if (query_point_id >= static_cast<int>(n_points))
+                        {
+                            // Ghost particle: its cell belongs to another slab.
+                            continue;
+                        }
+                        if (!container.compute_cell(cell, voronoi_loop))
+                        {
+                            valid.store(false, std::memory_order_relaxed);
+                            break;
+                        }
+                        vec3<double> query_point(voronoi_loop.x(), voronoi_loop.y(), voronoi_loop.z());
+                        const double max_radius_sq
+                            = processCell(cell, query_point_id, query_point, nq, bonds);
+                        if (max_radius_sq > 0.25 * margin * margin)
+                        {
+                            // The cell reaches past the validated region, so
+                            // a particle outside the ghost margin could
+                            // still cut it. Give up on the sharded path.
+                            valid.store(false, std::memory_order_relaxed);
+                            break;
+                        }
+                        num_processed++;
+                    } while (voronoi_loop.inc());
+                }
+                if (num_processed != owned[slab].size())
+                {
+                    valid.store(false, std::memory_order_relaxed);
+                }
             }
+        });
 
-        } while (voronoi_loop.inc());
+    if (!valid.load())
+    {
+        return false;
+    }
+
+    // Stitch the per-thread bond vectors together; the caller's sort
+    // restores the canonical global ordering.
+    size_t num_bonds(0);
+    for (const auto& local_bonds : bond_vectors)
+    {
+        num_bonds += local_bonds.size();
     }
+    bonds.reserve(num_bonds);
+    for (const auto& local_bonds : bond_vectors)
+    {
+        bonds.insert(bonds.end(), local_bonds.begin(), local_bonds.end());
+    }
+    return true;
+}
 
+void Voronoi::sortBonds(std::vector<NeighborBond>& bonds)
+{
     tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
         return n1.less_id_ref_weight(n2);
     });
+}
+
+void Voronoi::buildNeighborList(std::vector<NeighborBond>& bonds, unsigned int n_points)
+{
+    sortBonds(bonds);
 
     unsigned int num_bonds = bonds.size();
 
     m_neighbor_list->resize(num_bonds);
     m_neighbor_list->setNumBonds(num_bonds, n_points, n_points);
 
-    util::forLoopWrapper(0, num_bonds, [=](size_t begin, size_t end) {
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
         for (size_t bond = begin; bond != end; ++bond)
         {
             m_neighbor_list->getNeighbors()(bond, 0) = bonds[bond].query_point_idx;
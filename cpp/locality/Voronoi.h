@@ -13,6 +13,9 @@
 
 namespace freud { namespace locality {
 
+//! Minimum number of points before the domain-sharded parallel path is attempted.
+constexpr unsigned int SHARDED_VORONOI_MIN_POINTS = 20000;
+
 class Voronoi
 {
 public:
@@ -21,6 +24,14 @@ public:
 
     void compute(const freud::locality::NeighborQuery* nq);
 
+    //! Compute Voronoi cells and return the bonds sorted by query point.
+    /*! Fused consumers (e.g. Voronoi-weighted Steinhardt) accumulate
+     *  directly from the returned bonds, with facet areas as weights, while
+     *  the cell data is still hot in cache; the stored NeighborList is not
+     *  built. Polytopes and volumes are still populated as in compute.
+     */
+    std::vector<NeighborBond> computeBonds(const freud::locality::NeighborQuery* nq);
+
     std::shared_ptr<NeighborList> getNeighborList() const
     {
         return m_neighbor_list;
@@ -37,6 +48,32 @@ public:
     }
 
 private:
+    //! Store the polytope, volume, and bonds of one computed Voronoi cell.
+    //  Returns the squared distance of the farthest polytope vertex from the
+    //  particle, which the sharded path uses to validate the ghost margin.
+    double processCell(voro::voronoicell_neighbor& cell, unsigned int query_point_id,
+                       vec3<double> query_point, const freud::locality::NeighborQuery* nq,
+                       std::vector<NeighborBond>& bonds);
+
+    //! Compute all cells, dispatching between the sharded and serial paths,
+    //  and return the unsorted bonds.
+    std::vector<NeighborBond> computeCells(const freud::locality::NeighborQuery* nq);
+
+    //! Reference path feeding all particles into one periodic container.
+    void computeSerial(const freud::locality::NeighborQuery* nq, std::vector<NeighborBond>& bonds);
+
+    //! Domain-sharded parallel path: one container per z-slab with ghost
+    //  margins, computed under tbb::parallel_for. Returns false if any cell
+    //  could not be validated against the margin, in which case the serial
+    //  path must be used instead.
+    bool computeSharded(const freud::locality::NeighborQuery* nq, std::vector<NeighborBond>& bonds);
+
+    //! Sort bonds into the canonical query-point-major order.
+    static void sortBonds(std::vector<NeighborBond>& bonds);
+
+    //! Sort bonds and fill the stored neighbor list from them.
+    void buildNeighborList(std::vector<NeighborBond>& bonds, unsigned int n_points);
+
     box::Box m_box;
     std::shared_ptr<NeighborList> m_neighbor_list;      //!< Stored neighbor list
     std::vector<std::vector<vec3<double>>> m_polytopes; //!< Voronoi polytopes
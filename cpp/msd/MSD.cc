@@ -0,0 +1,160 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+#include "FFT.h"
+#include "MSD.h"
+#include "utils.h"
+
+/*! \file MSD.cc
+    \brief Compute the mean squared displacement over a trajectory.
+*/
+
+namespace freud { namespace msd {
+
+namespace {
+
+//! Autocorrelation of a real sequence of length N via zero-padded FFT.
+/*! Computes sum_{k} x[k]*x[k+m] for each lag m into result[0..N-1]. The
+ *  scratch buffer is reused across calls to avoid per-particle allocation.
+ */
+void autocorrelate(const std::vector<double>& x, std::vector<double>& result,
+                   std::vector<std::complex<double>>& scratch)
+{
+    const size_t N = x.size();
+    size_t padded_size(1);
+    while (padded_size < 2 * N)
+    {
+        padded_size <<= 1;
+    }
+
+    scratch.assign(padded_size, std::complex<double>(0));
+    for (size_t k = 0; k < N; ++k)
+    {
+        scratch[k] = x[k];
+    }
+    util::fftRadix2(scratch, false);
+    for (auto& value : scratch)
+    {
+        value = value * std::conj(value);
+    }
+    util::fftRadix2(scratch, true);
+
+    result.resize(N);
+    for (size_t m = 0; m < N; ++m)
+    {
+        result[m] = scratch[m].real();
+    }
+}
+
+} // namespace
+
+void MSD::compute(const vec3<float>* positions, unsigned int num_frames, unsigned int num_particles)
+{
+    computeImpl(positions, num_frames, num_particles);
+}
+
+void MSD::compute(const vec3<double>* positions, unsigned int num_frames, unsigned int num_particles)
+{
+    computeImpl(positions, num_frames, num_particles);
+}
+
+template<typename T>
+void MSD::computeImpl(const vec3<T>* positions, unsigned int num_frames, unsigned int num_particles)
+{
+    if (num_frames == 0 || num_particles == 0)
+    {
+        throw std::invalid_argument("MSD requires at least one frame and one particle.");
+    }
+
+    m_particle_msd.prepare({num_frames, num_particles});
+    m_msd.prepare(num_frames);
+
+    if (m_mode == Mode::direct)
+    {
+        util::forLoopWrapper(0, num_frames, [&](size_t begin, size_t end) {
+            for (size_t frame = begin; frame < end; ++frame)
+            {
+                for (unsigned int particle = 0; particle < num_particles; ++particle)
+                {
+                    const vec3<T> dr = positions[frame * num_particles + particle]
+                        - positions[particle];
+                    m_particle_msd(frame, particle) = static_cast<float>(dot(dr, dr));
+                }
+            }
+        });
+    }
+    else
+    {
+        // Windowed MSD via the FFT algorithm: for each particle,
+        //   MSD(m) = S1(m) - 2*S2(m)
+        // where S2 is the positional autocorrelation (one FFT per
+        // dimension) and S1 follows from a backwards recurrence over the
+        // squared magnitudes. Particles are independent, so they are
+        // processed in parallel blocks with per-thread scratch buffers.
+        util::forLoopWrapper(0, num_particles, [&](size_t begin, size_t end) {
+            const size_t N(num_frames);
+            std::vector<double> x(N);
+            std::vector<double> squared_magnitudes(N);
+            std::vector<double> S2(N);
+            std::vector<double> correlation(N);
+            std::vector<std::complex<double>> scratch;
+
+            for (size_t particle = begin; particle < end; ++particle)
+            {
+                std::fill(S2.begin(), S2.end(), 0.0);
+                for (unsigned int dim = 0; dim < 3; ++dim)
+                {
+                    for (size_t frame = 0; frame < N; ++frame)
+                    {
+                        const vec3<T>& r = positions[frame * num_particles + particle];
+                        x[frame] = (dim == 0) ? r.x : ((dim == 1) ? r.y : r.z);
+                    }
+                    autocorrelate(x, correlation, scratch);
+                    for (size_t m = 0; m < N; ++m)
+                    {
+                        S2[m] += correlation[m];
+                    }
+                }
+
+                double Q(0);
+                for (size_t frame = 0; frame < N; ++frame)
+                {
+                    const vec3<T>& r = positions[frame * num_particles + particle];
+                    squared_magnitudes[frame] = dot(vec3<double>(r), vec3<double>(r));
+                    Q += 2.0 * squared_magnitudes[frame];
+                }
+
+                for (size_t m = 0; m < N; ++m)
+                {
+                    if (m > 0)
+                    {
+                        Q -= squared_magnitudes[m - 1] + squared_magnitudes[N - m];
+                    }
+                    const double S1 = Q / static_cast<double>(N - m);
+                    m_particle_msd(m, particle)
+                        = static_cast<float>(S1 - 2.0 * S2[m] / static_cast<double>(N - m));
+                }
+            }
+        });
+    }
+
+    // Average over particles per lag time.
+    util::forLoopWrapper(0, num_frames, [&](size_t begin, size_t end) {
+        for (size_t frame = begin; frame < end; ++frame)
+        {
+            double total(0);
+            for (unsigned int particle = 0; particle < num_particles; ++particle)
+            {
+                total += m_particle_msd(frame, particle);
+            }
+            m_msd[frame] = static_cast<float>(total / static_cast<double>(num_particles));
+        }
+    });
+}
+
+}; }; // end namespace freud::msd
@@ -0,0 +1,89 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MSD_H
+#define MSD_H
+
+#include "ManagedArray.h"
+#include "VectorMath.h"
+
+/*! \file MSD.h
+    \brief Compute the mean squared displacement over a trajectory.
+*/
+
+namespace freud { namespace msd {
+
+//! Compute the mean squared displacement (MSD) of a set of trajectories.
+/*! Two definitions are supported. The windowed mode averages displacements
+ *  over all pairs of frames separated by a given lag time m:
+ *
+ *      MSD(m) = <1/(N-m) * sum_{k=0}^{N-m-1} (r(k+m) - r(k))^2>_particles
+ *
+ *  and is evaluated with the FFT-based autocorrelation algorithm of
+ *  Calandrini et al. (nMoldyn), which reduces the cost per particle from
+ *  O(N^2) to O(N log N) in the number of frames. The direct mode simply
+ *  measures displacements relative to the first frame:
+ *
+ *      MSD(m) = <(r(m) - r(0))^2>_particles
+ *
+ *  Positions must be unwrapped (no periodic jumps) before being passed in.
+ *  Particles are processed in independent blocks across threads, so memory
+ *  overhead beyond the output arrays is a few FFT buffers per thread
+ *  regardless of particle count.
+ */
+class MSD
+{
+public:
+    enum class Mode
+    {
+        window,
+        direct
+    };
+
+    //! Constructor
+    explicit MSD(Mode mode = Mode::window) : m_mode(mode) {}
+
+    //! Compute the MSD.
+    /*! \param positions Unwrapped positions in frame-major order, so
+     *                   positions[frame * num_particles + particle] is the
+     *                   position of a particle at a frame.
+     *  \param num_frames The number of frames in the trajectory.
+     *  \param num_particles The number of particles per frame.
+     */
+    void compute(const vec3<float>* positions, unsigned int num_frames, unsigned int num_particles);
+
+    //! Double-precision overload of compute.
+    /*! Long unwrapped trajectories can exceed float precision in the
+     *  coordinates themselves (the accumulated displacement grows while the
+     *  float resolution stays proportional to the distance from the origin),
+     *  so this overload accepts double positions directly; the internal
+     *  arithmetic is already double in both modes. Selected by input dtype
+     *  at the binding layer; float remains the default.
+     */
+    void compute(const vec3<double>* positions, unsigned int num_frames, unsigned int num_particles);
+
+    //! Get the MSD averaged over particles, one value per lag time.
+    const util::ManagedArray<float>& getMSD() const
+    {
+        return m_msd;
+    }
+
+    //! Get the per-particle MSD of shape (num_frames, num_particles).
+    const util::ManagedArray<float>& getParticleMSD() const
+    {
+        return m_particle_msd;
+    }
+
+private:
+    //! Shared implementation of both compute overloads.
+    template<typename T>
+    void computeImpl(const vec3<T>* positions, unsigned int num_frames, unsigned int num_particles);
+
+    Mode m_mode;                                //!< The MSD definition to compute
+    util::ManagedArray<float> m_msd;            //!< MSD per lag time, averaged over particles
+    util::ManagedArray<float> m_particle_msd;   //!< MSD per lag time and particle
+};
+
+}; }; // end namespace freud::msd
+
+#endif // MSD_H
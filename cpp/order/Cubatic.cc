@@ -170,8 +170,20 @@ tensor4 Cubatic::calcCubaticTensor(quat<float>& orientation)
 
 float Cubatic::calcCubaticOrderParameter(const tensor4& cubatic_tensor, const tensor4& global_tensor)
 {
-    tensor4 diff = global_tensor - cubatic_tensor;
-    return float(1.0) - dot(diff, diff) / dot(cubatic_tensor, cubatic_tensor);
+    // Evaluate both contractions of eq. 22 in a single flat pass over the 81
+    // components rather than materializing the difference tensor. The two
+    // independent multiply-add accumulations vectorize cleanly, and this
+    // function sits in the innermost annealing loop so it dominates the cost
+    // of each replicate.
+    float diff_norm = 0;
+    float cubatic_norm = 0;
+    for (unsigned int i = 0; i < 81; i++)
+    {
+        const float diff = global_tensor.data[i] - cubatic_tensor.data[i];
+        diff_norm += diff * diff;
+        cubatic_norm += cubatic_tensor.data[i] * cubatic_tensor.data[i];
+    }
+    return float(1.0) - diff_norm / cubatic_norm;
 }
 
 template<typename T> quat<float> Cubatic::calcRandomQuaternion(T& dist, float angle_multiplier) const
@@ -261,20 +273,22 @@ void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
         tbb::blocked_range<size_t>(0, m_n_replicates),
         [=, &p_cubatic_orientation, &p_cubatic_order_parameter,
          &p_cubatic_tensor](const tbb::blocked_range<size_t>& r) {
-            // create thread-specific rng
-            unsigned int thread_start = r.begin();
-
-            std::vector<unsigned int> seed_seq(3);
-            seed_seq[0] = m_seed;
-            seed_seq[1] = thread_start;
-            seed_seq[2] = 0xffaabb;
-            std::seed_seq seed(seed_seq.begin(), seed_seq.end());
-            std::mt19937 rng(seed);
             std::uniform_real_distribution<float> base_dist(0, 1);
-            auto dist = [&]() { return base_dist(rng); };
 
             for (size_t i = r.begin(); i != r.end(); i++)
             {
+                // Seed each replicate independently rather than per-range so
+                // the multi-start search is deterministic for a given seed
+                // regardless of how TBB partitions the replicates across
+                // threads.
+                std::vector<unsigned int> seed_seq(3);
+                seed_seq[0] = m_seed;
+                seed_seq[1] = static_cast<unsigned int>(i);
+                seed_seq[2] = 0xffaabb;
+                std::seed_seq seed(seed_seq.begin(), seed_seq.end());
+                std::mt19937 rng(seed);
+                auto dist = [&]() { return base_dist(rng); };
+
                 // need to generate random orientation
                 quat<float> cubatic_orientation = calcRandomQuaternion(dist);
                 quat<float> new_orientation = cubatic_orientation;
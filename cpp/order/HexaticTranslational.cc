@@ -51,12 +51,78 @@ Hexatic::Hexatic(unsigned int k, bool weighted) : HexaticTranslational<unsigned
 void Hexatic::compute(const freud::locality::NeighborList* nlist,
                       const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
-    computeGeneral(
-        [this](const vec3<float>& delta) {
-            const float theta_ij = std::atan2(delta.y, delta.x);
-            return std::exp(std::complex<float>(0, static_cast<float>(m_k) * theta_ij));
-        },
-        nlist, points, qargs, false);
+    const auto box = points->getBox();
+    box.enforce2D();
+
+    const unsigned int Np = points->getNPoints();
+
+    m_psi_array.prepare(Np);
+
+    freud::locality::loopOverNeighborsIterator(
+        points, points->getPoints(), Np, qargs, nlist,
+        [=](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
+            // Gather the unit bond directions of this particle in SoA form.
+            // Since k is an integer, exp(i k theta) equals the unit bond
+            // direction (delta.x + i delta.y)/r raised to the k-th power, so
+            // the whole block reduces to multiply-adds over contiguous float
+            // arrays that the compiler can vectorize; no atan2 or complex
+            // exp is called per bond.
+            std::vector<float> unit_re;
+            std::vector<float> unit_im;
+            std::vector<float> weights;
+            const vec3<float> ref((*points)[i]);
+
+            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            {
+                // Compute vector from query_point to point
+                const vec3<float> delta = box.wrap((*points)[nb.point_idx] - ref);
+                const float r_xy = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+                // Coincident points get theta = 0, matching atan2(0, 0).
+                unit_re.push_back((r_xy == float(0)) ? float(1) : delta.x / r_xy);
+                unit_im.push_back((r_xy == float(0)) ? float(0) : delta.y / r_xy);
+                weights.push_back(m_weighted ? nb.weight : float(1.0));
+            }
+
+            const auto num_bonds = static_cast<unsigned int>(weights.size());
+            // Raise the whole block to the k-th power by exponentiation by
+            // squaring, applied lane-wise over the bond arrays.
+            std::vector<float> power_re(num_bonds, 1.0F);
+            std::vector<float> power_im(num_bonds, 0.0F);
+            unsigned int exponent = m_k;
+            while (exponent > 0)
+            {
+                if ((exponent & 1U) != 0)
+                {
+                    for (unsigned int b = 0; b < num_bonds; ++b)
+                    {
+                        const float next_re = power_re[b] * unit_re[b] - power_im[b] * unit_im[b];
+                        power_im[b] = power_re[b] * unit_im[b] + power_im[b] * unit_re[b];
+                        power_re[b] = next_re;
+                    }
+                }
+                exponent >>= 1U;
+                if (exponent > 0)
+                {
+                    for (unsigned int b = 0; b < num_bonds; ++b)
+                    {
+                        const float next_re = unit_re[b] * unit_re[b] - unit_im[b] * unit_im[b];
+                        unit_im[b] = 2.0F * unit_re[b] * unit_im[b];
+                        unit_re[b] = next_re;
+                    }
+                }
+            }
+
+            float sum_re(0);
+            float sum_im(0);
+            float total_weight(0);
+            for (unsigned int b = 0; b < num_bonds; ++b)
+            {
+                sum_re += weights[b] * power_re[b];
+                sum_im += weights[b] * power_im[b];
+                total_weight += weights[b];
+            }
+            m_psi_array[i] = std::complex<float>(sum_re, sum_im) / std::complex<float>(total_weight);
+        });
 }
 
 Translational::Translational(float k, bool weighted) : HexaticTranslational<float>(k, weighted) {}
@@ -1,6 +1,7 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "Nematic.h"
@@ -51,36 +52,78 @@ void Nematic::compute(quat<float>* orientations, unsigned int n)
     m_particle_tensor.prepare({m_n, 3, 3});
     m_nematic_tensor_local.reset();
 
-    // calculate per-particle tensor
+    // Calculate the per-particle tensors in blocks. Directors are computed
+    // for a block of orientations at a time into structure-of-arrays form,
+    // and only the six unique components of the symmetric ordering tensor
+    // are evaluated, as lane loops over the block that the compiler
+    // vectorizes. Each thread carries the six running sums in registers and
+    // folds them into its thread-local tensor once at the end of its range;
+    // the per-thread tensors are reduced later as before. This replaces the
+    // former scalar path, which also heap-allocated a scratch 3x3 array for
+    // every particle.
     util::forLoopWrapper(0, n, [=](size_t begin, size_t end) {
-        for (size_t i = begin; i < end; ++i)
+        constexpr size_t batch_width = 8;
+        float ux[batch_width];
+        float uy[batch_width];
+        float uz[batch_width];
+        float sum_xx(0);
+        float sum_xy(0);
+        float sum_xz(0);
+        float sum_yy(0);
+        float sum_yz(0);
+        float sum_zz(0);
+        for (size_t block = begin; block < end; block += batch_width)
         {
-            // get the director of the particle
-            quat<float> q = orientations[i];
-            vec3<float> u_i = rotate(q, m_u);
-
-            util::ManagedArray<float> Q_ab({3, 3});
-
-            Q_ab(0, 0) = 1.5f * u_i.x * u_i.x - 0.5f;
-            Q_ab(0, 1) = 1.5f * u_i.x * u_i.y;
-            Q_ab(0, 2) = 1.5f * u_i.x * u_i.z;
-            Q_ab(1, 0) = 1.5f * u_i.y * u_i.x;
-            Q_ab(1, 1) = 1.5f * u_i.y * u_i.y - 0.5f;
-            Q_ab(1, 2) = 1.5f * u_i.y * u_i.z;
-            Q_ab(2, 0) = 1.5f * u_i.z * u_i.x;
-            Q_ab(2, 1) = 1.5f * u_i.z * u_i.y;
-            Q_ab(2, 2) = 1.5f * u_i.z * u_i.z - 0.5f;
-
-            // Set the values. The nematic tensor is reduced later.
-            for (unsigned int j = 0; j < 3; j++)
+            const size_t count = std::min(batch_width, end - block);
+            for (size_t lane = 0; lane < count; ++lane)
             {
-                for (unsigned int k = 0; k < 3; k++)
-                {
-                    m_particle_tensor(i, j, k) += Q_ab(j, k);
-                    m_nematic_tensor_local.local()(j, k) += Q_ab(j, k);
-                }
+                // get the director of the particle
+                const vec3<float> u_i = rotate(orientations[block + lane], m_u);
+                ux[lane] = u_i.x;
+                uy[lane] = u_i.y;
+                uz[lane] = u_i.z;
+            }
+            for (size_t lane = 0; lane < count; ++lane)
+            {
+                const float xx = 1.5F * ux[lane] * ux[lane] - 0.5F;
+                const float xy = 1.5F * ux[lane] * uy[lane];
+                const float xz = 1.5F * ux[lane] * uz[lane];
+                const float yy = 1.5F * uy[lane] * uy[lane] - 0.5F;
+                const float yz = 1.5F * uy[lane] * uz[lane];
+                const float zz = 1.5F * uz[lane] * uz[lane] - 0.5F;
+
+                float* const row = &m_particle_tensor(block + lane, 0, 0);
+                row[0] = xx;
+                row[1] = xy;
+                row[2] = xz;
+                row[3] = xy;
+                row[4] = yy;
+                row[5] = yz;
+                row[6] = xz;
+                row[7] = yz;
+                row[8] = zz;
+
+                sum_xx += xx;
+                sum_xy += xy;
+                sum_xz += xz;
+                sum_yy += yy;
+                sum_yz += yz;
+                sum_zz += zz;
             }
         }
+
+        // Fold this range's partials into the thread-local tensor; it is
+        // reduced over threads later.
+        auto& local_tensor = m_nematic_tensor_local.local();
+        local_tensor(0, 0) += sum_xx;
+        local_tensor(0, 1) += sum_xy;
+        local_tensor(0, 2) += sum_xz;
+        local_tensor(1, 0) += sum_xy;
+        local_tensor(1, 1) += sum_yy;
+        local_tensor(1, 2) += sum_yz;
+        local_tensor(2, 0) += sum_xz;
+        local_tensor(2, 1) += sum_yz;
+        local_tensor(2, 2) += sum_zz;
     });
 
     // Now calculate the sum of Q_ab's
@@ -12,33 +12,30 @@
 
 namespace freud { namespace order {
 
-// This function wraps exponentiation for complex numbers to avoid
-// the case where pow((0,0), 0) returns (nan, nan). Additionally, it
-// serves as a micro-optimization since std::pow can be slow. We can take the
-// exponent to be an unsigned int since all the sums in the hyperspherical
-// harmonic below guarantee this.
-inline std::complex<float> cpow(std::complex<float> base, unsigned int p)
+namespace {
+
+// Fill pows[0..max_power] with successive powers of base by recurrence. This
+// replaces repeated calls to std::pow on complex numbers: every term of every
+// harmonic at a fixed (xi, zeta) draws from the same four power tables, so
+// each power is computed exactly once per orientation. Starting from 1 also
+// sidesteps the pow((0,0), 0) == (nan, nan) pitfall.
+inline void fillPowers(std::complex<float> base, unsigned int max_power,
+                       std::vector<std::complex<float>>& pows)
 {
-    if (p == 0)
-    {
-        return {1, 0};
-    }
-    std::complex<float> val(base);
-    for (unsigned int i = 1; i < p; i++)
+    pows[0] = std::complex<float>(1, 0);
+    for (unsigned int k = 1; k <= max_power; k++)
     {
-        val *= base;
+        pows[k] = pows[k - 1] * base;
     }
-    return val;
 }
 
-inline std::complex<float> RotationalAutocorrelation::hypersphere_harmonic(const std::complex<float> xi,
-                                                                           std::complex<float> zeta,
-                                                                           const unsigned int m1,
-                                                                           const unsigned int m2)
-{
-    const std::complex<float> xi_conj = std::conj(xi);
-    const std::complex<float> zeta_conj = std::conj(zeta);
+} // namespace
 
+inline std::complex<float> RotationalAutocorrelation::hypersphere_harmonic(
+    const std::vector<std::complex<float>>& xi_conj_pows, const std::vector<std::complex<float>>& zeta_pows,
+    const std::vector<std::complex<float>>& zeta_conj_pows,
+    const std::vector<std::complex<float>>& neg_xi_pows, const unsigned int m1, const unsigned int m2)
+{
     // Doing a summation over non-negative exponents, which requires the additional inner conditional.
     std::complex<float> sum_tracker(0, 0);
     for (unsigned int k = (m1 + m2 < m_l ? 0 : m1 + m2 - m_l); k <= std::min(m1, m2); k++)
@@ -46,8 +43,8 @@ inline std::complex<float> RotationalAutocorrelation::hypersphere_harmonic(const
         float fact_product = static_cast<float>(m_factorials[k])
             * static_cast<float>(m_factorials[m_l + k - m1 - m2]) * static_cast<float>(m_factorials[m1 - k])
             * static_cast<float>(m_factorials[m2 - k]);
-        sum_tracker += cpow(xi_conj, k) * cpow(zeta, m2 - k) * cpow(zeta_conj, m1 - k)
-            * cpow(-xi, m_l + k - m1 - m2) / fact_product;
+        sum_tracker += xi_conj_pows[k] * zeta_pows[m2 - k] * zeta_conj_pows[m1 - k]
+            * neg_xi_pows[m_l + k - m1 - m2] / fact_product;
     }
     return sum_tracker;
 }
@@ -60,30 +57,55 @@ void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, con
     // Precompute the hyperspherical harmonics for the unit quaternion. The
     // default quaternion constructor gives a unit quaternion. We will assume
     // the same iteration order here as in the loop below to save ourselves
-    // from having to use a more expensive process (i.e. a map).
-    std::complex<float> xi = std::complex<float>(0, 0);
-    std::complex<float> zeta = std::complex<float>(0, 1);
-    std::vector<std::complex<float>> unit_harmonics;
-    std::vector<std::vector<float>> prefactors(m_l + 1, std::vector<float>(m_l + 1, float(0)));
-    for (unsigned int a = 0; a <= m_l; a++)
+    // from having to use a more expensive process (i.e. a map). Both tables
+    // depend only on m_l, so they are built once on the first compute and
+    // cached on the class for the remaining frames of the trajectory.
+    if (m_unit_harmonics.empty())
     {
-        for (unsigned int b = 0; b <= m_l; b++)
+        std::complex<float> xi = std::complex<float>(0, 0);
+        std::complex<float> zeta = std::complex<float>(0, 1);
+        std::vector<std::complex<float>> xi_conj_pows(m_l + 1);
+        std::vector<std::complex<float>> zeta_pows(m_l + 1);
+        std::vector<std::complex<float>> zeta_conj_pows(m_l + 1);
+        std::vector<std::complex<float>> neg_xi_pows(m_l + 1);
+        fillPowers(std::conj(xi), m_l, xi_conj_pows);
+        fillPowers(zeta, m_l, zeta_pows);
+        fillPowers(std::conj(zeta), m_l, zeta_conj_pows);
+        fillPowers(-xi, m_l, neg_xi_pows);
+
+        m_prefactors.assign(m_l + 1, std::vector<float>(m_l + 1, float(0)));
+        for (unsigned int a = 0; a <= m_l; a++)
         {
-            unit_harmonics.push_back(std::conj(hypersphere_harmonic(xi, zeta, a, b)));
-            prefactors[a][b] = static_cast<float>(m_factorials[a] * m_factorials[m_l - a] * m_factorials[b]
-                                                  * m_factorials[m_l - b])
-                / (static_cast<float>(m_l + 1));
+            for (unsigned int b = 0; b <= m_l; b++)
+            {
+                m_unit_harmonics.push_back(std::conj(
+                    hypersphere_harmonic(xi_conj_pows, zeta_pows, zeta_conj_pows, neg_xi_pows, a, b)));
+                m_prefactors[a][b] = static_cast<float>(m_factorials[a] * m_factorials[m_l - a]
+                                                        * m_factorials[b] * m_factorials[m_l - b])
+                    / (static_cast<float>(m_l + 1));
+            }
         }
     }
 
     // Parallel loop is over orientations (technically (ref_or, or) pairs).
     util::forLoopWrapper(0, N, [=](size_t begin, size_t end) {
+        // Power tables shared by all harmonics of one orientation, refilled
+        // by recurrence per particle.
+        std::vector<std::complex<float>> xi_conj_pows(m_l + 1);
+        std::vector<std::complex<float>> zeta_pows(m_l + 1);
+        std::vector<std::complex<float>> zeta_conj_pows(m_l + 1);
+        std::vector<std::complex<float>> neg_xi_pows(m_l + 1);
+
         for (size_t i = begin; i < end; ++i)
         {
             // Transform the orientation quaternions into Xi/Zeta coordinates;
             quat<float> qq_1 = conj(ref_orientations[i]) * orientations[i];
             std::complex<float> xi = std::complex<float>(qq_1.v.x, qq_1.v.y);
             std::complex<float> zeta = std::complex<float>(qq_1.v.z, qq_1.s);
+            fillPowers(std::conj(xi), m_l, xi_conj_pows);
+            fillPowers(zeta, m_l, zeta_pows);
+            fillPowers(std::conj(zeta), m_l, zeta_conj_pows);
+            fillPowers(-xi, m_l, neg_xi_pows);
 
             // Loop through the valid quantum numbers.
             m_RA_array[i] = std::complex<float>(0, 0);
@@ -92,9 +114,9 @@ void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, con
             {
                 for (unsigned int b = 0; b <= m_l; b++)
                 {
-                    std::complex<float> combined_value
-                        = unit_harmonics[uh_index] * hypersphere_harmonic(xi, zeta, a, b);
-                    m_RA_array[i] += prefactors[a][b] * combined_value;
+                    std::complex<float> combined_value = m_unit_harmonics[uh_index]
+                        * hypersphere_harmonic(xi_conj_pows, zeta_pows, zeta_conj_pows, neg_xi_pows, a, b);
+                    m_RA_array[i] += m_prefactors[a][b] * combined_value;
                     uh_index += 1;
                 }
             }
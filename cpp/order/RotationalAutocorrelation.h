@@ -5,6 +5,7 @@
 #define ROTATIONAL_AUTOCORRELATION_H
 
 #include <complex>
+#include <vector>
 
 #include "ManagedArray.h"
 #include "VectorMath.h"
@@ -100,12 +101,17 @@ public:
 
 private:
     //! Compute a hyperspherical harmonic.
-    /*! \param xi The first complex number coordinate.
-     *  \param zeta The second complex number coordinate.
-     *  \param l The azimuthal quantum number.
+    /*! \param xi_conj_pows Powers 0 through m_l of conj(xi).
+     *  \param zeta_pows Powers 0 through m_l of zeta.
+     *  \param zeta_conj_pows Powers 0 through m_l of conj(zeta).
+     *  \param neg_xi_pows Powers 0 through m_l of -xi.
      *  \param m1 The first magnetic quantum number.
      *  \param m2 The second magnetic quantum number.
-     *  \return The value of the hyperspherical harmonic (l, m1, m2) at (xi, zeta).
+     *  \return The value of the hyperspherical harmonic (m_l, m1, m2) at (xi, zeta).
+     *
+     *  The powers of the four coordinate quantities are shared by every term
+     *  of every harmonic at a given (xi, zeta), so callers build them once per
+     *  orientation by recurrence and each term here reduces to table lookups.
      *
      *  The hyperspherical harmonic function is a generalization of spherical
      *  harmonics from the 2-sphere to the 3-sphere. For details, see Harmonic
@@ -114,7 +120,10 @@ private:
      *  method to access the cached factorial values for the class's value of
      *  m_l.
      */
-    std::complex<float> hypersphere_harmonic(const std::complex<float> xi, std::complex<float> zeta,
+    std::complex<float> hypersphere_harmonic(const std::vector<std::complex<float>>& xi_conj_pows,
+                                             const std::vector<std::complex<float>>& zeta_pows,
+                                             const std::vector<std::complex<float>>& zeta_conj_pows,
+                                             const std::vector<std::complex<float>>& neg_xi_pows,
                                              const unsigned int m1, const unsigned int m2);
 
     unsigned int m_l; //!< Order of the hyperspherical harmonic.
@@ -122,6 +131,11 @@ private:
 
     util::ManagedArray<std::complex<float>> m_RA_array; //!< Array of RA values per particle
     util::ManagedArray<unsigned int> m_factorials;      //!< Array of cached factorials
+    //! Conjugated harmonics of the unit quaternion and the quantum-number
+    //! prefactors. Both depend only on m_l, so they are computed on the first
+    //! call to compute and reused for every subsequent frame of a trajectory.
+    std::vector<std::complex<float>> m_unit_harmonics;
+    std::vector<std::vector<float>> m_prefactors;
 };
 
 }; }; // end namespace freud::order
@@ -1,10 +1,12 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "NeighborComputeFunctional.h"
 #include "SolidLiquid.h"
+#include "SphericalHarmonics.h"
 
 namespace freud { namespace order {
 
@@ -29,39 +31,246 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
 
     // Compute Steinhardt using neighbor list (also gets ql for normalization)
     m_steinhardt.compute(&m_nlist, points, qargs);
-    // SolidLiquid only has one l value so we index the 2D array from Steinhardt.
-    const auto& qlm = m_steinhardt.getQlm()[0];
-    const auto& ql = m_steinhardt.getQl();
+
+    // Deep-copy the qlm and ql arrays so they survive later Steinhardt
+    // computes and can seed incremental updates on subsequent frames.
+    const auto& qlm_src = m_steinhardt.getQlm()[0];
+    const auto& ql_src = m_steinhardt.getQl();
+    m_qlm.prepare({num_query_points, m_num_ms});
+    m_ql.prepare(num_query_points);
+    std::copy(qlm_src.get(), qlm_src.get() + qlm_src.size(), m_qlm.get());
+    std::copy(ql_src.get(), ql_src.get() + ql_src.size(), m_ql.get());
+    m_cached_positions.assign(points->getPoints(), points->getPoints() + points->getNPoints());
+
+    classifyAndCluster(points, qargs);
+}
+
+void SolidLiquid::computeIncremental(const freud::locality::NeighborList* nlist,
+                                     const freud::locality::NeighborQuery* points,
+                                     freud::locality::QueryArgs qargs, float displacement_threshold)
+{
+    const unsigned int num_points(points->getNPoints());
+    if (m_cached_positions.size() != num_points)
+    {
+        compute(nlist, points, qargs);
+        return;
+    }
+
+    // Keep the previous frame's bonds: a neighbor that moved away still
+    // changes this particle's neighborhood.
+    const freud::locality::NeighborList previous_nlist(m_nlist);
+    m_nlist = locality::makeDefaultNlist(points, nlist, points->getPoints(), num_points, qargs);
+
+    const auto& box = points->getBox();
+    std::vector<bool> moved(num_points);
+    const float threshold_sq(displacement_threshold * displacement_threshold);
+    for (unsigned int i = 0; i < num_points; ++i)
+    {
+        const vec3<float> delta = box.wrap((*points)[i] - m_cached_positions[i]);
+        moved[i] = dot(delta, delta) > threshold_sq;
+    }
+
+    // A particle's qlm must be re-evaluated if it moved or if any current
+    // or previous neighbor moved.
+    std::vector<bool> changed(moved);
+    const std::array<const freud::locality::NeighborList*, 2> bond_lists {{&m_nlist, &previous_nlist}};
+    for (const auto* bond_list : bond_lists)
+    {
+        const unsigned int num_bonds(bond_list->getNumBonds());
+        for (unsigned int bond = 0; bond < num_bonds; ++bond)
+        {
+            const unsigned int i(bond_list->getNeighbors()(bond, 0));
+            const unsigned int j(bond_list->getNeighbors()(bond, 1));
+            if (moved[j])
+            {
+                changed[i] = true;
+            }
+        }
+    }
+
+    std::vector<unsigned int> changed_particles;
+    for (unsigned int i = 0; i < num_points; ++i)
+    {
+        if (changed[i])
+        {
+            changed_particles.push_back(i);
+        }
+    }
+
+    computeQlmRows(points, changed_particles);
+    m_cached_positions.assign(points->getPoints(), points->getPoints() + num_points);
+
+    classifyAndCluster(points, qargs);
+}
+
+void SolidLiquid::computeQlmRows(const freud::locality::NeighborQuery* points,
+                                 const std::vector<unsigned int>& particles)
+{
+    const auto& box = points->getBox();
+    const auto normalizationfactor = float(4.0 * M_PI / m_num_ms);
+    const unsigned int num_bonds(m_nlist.getNumBonds());
+    const std::vector<unsigned int> ls {m_l};
+
+    util::forLoopWrapper(0, particles.size(), [&](size_t begin, size_t end) {
+        BatchedYlmEvaluator ylm_eval(ls);
+        std::vector<float> cos_thetas;
+        std::vector<float> sin_thetas;
+        std::vector<float> cos_phis;
+        std::vector<float> sin_phis;
+
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            const unsigned int i = particles[idx];
+            const vec3<float> ref((*points)[i]);
+            cos_thetas.clear();
+            sin_thetas.clear();
+            cos_phis.clear();
+            sin_phis.clear();
+
+            unsigned int bond(m_nlist.find_first_index(i));
+            for (; bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+            {
+                const unsigned int j(m_nlist.getNeighbors()(bond, 1));
+                const vec3<float> delta = box.wrap((*points)[j] - ref);
+                const float distance = m_nlist.getDistances()[bond];
+                // Bond angles are derived exactly as in Steinhardt so cached
+                // and recomputed rows agree bit-for-bit.
+                const float cos_theta
+                    = (distance == float(0)) ? float(1) : util::clamp(delta.z / distance, -1, 1);
+                const float sin_theta = std::sqrt(std::max(float(0), 1 - cos_theta * cos_theta));
+                const float r_xy = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+                cos_thetas.push_back(cos_theta);
+                sin_thetas.push_back(sin_theta);
+                cos_phis.push_back((r_xy == float(0)) ? float(1) : delta.x / r_xy);
+                sin_phis.push_back((r_xy == float(0)) ? float(0) : delta.y / r_xy);
+            }
+
+            const auto bond_count = static_cast<unsigned int>(cos_thetas.size());
+            const size_t row = m_qlm.getIndex({i, 0});
+            for (unsigned int k = 0; k < m_num_ms; ++k)
+            {
+                m_qlm[row + k] = std::complex<float>(0);
+            }
+            if (bond_count > 0)
+            {
+                ylm_eval.compute(cos_thetas.data(), sin_thetas.data(), cos_phis.data(), sin_phis.data(),
+                                 bond_count);
+                for (unsigned int k = 0; k < m_num_ms; ++k)
+                {
+                    const float* row_re = ylm_eval.real(0) + size_t(k) * bond_count;
+                    const float* row_im = ylm_eval.imag(0) + size_t(k) * bond_count;
+                    float sum_re(0);
+                    float sum_im(0);
+                    for (unsigned int b = 0; b < bond_count; ++b)
+                    {
+                        sum_re += row_re[b];
+                        sum_im += row_im[b];
+                    }
+                    m_qlm[row + k]
+                        = std::complex<float>(sum_re, sum_im) / static_cast<float>(bond_count);
+                }
+            }
+
+            float ql_sum(0);
+            for (unsigned int k = 0; k < m_num_ms; ++k)
+            {
+                ql_sum += std::norm(m_qlm[row + k]);
+            }
+            m_ql[i] = std::sqrt(ql_sum * normalizationfactor);
+        }
+    });
+}
+
+void SolidLiquid::classifyAndCluster(const freud::locality::NeighborQuery* points,
+                                     freud::locality::QueryArgs qargs)
+{
+    const unsigned int num_query_points(m_nlist.getNumQueryPoints());
 
     // Compute (normalized) dot products for each bond in the neighbor list
     const auto normalizationfactor = float(4.0 * M_PI / m_num_ms);
     const unsigned int num_bonds(m_nlist.getNumBonds());
     m_ql_ij.prepare(num_bonds);
 
+    // Only the real part of q_lm(i) q_lm^*(j) is kept below, so each bond
+    // reduces to two real dot products over m. The cached qlm rows are split
+    // into separate real and imaginary planes once per call so the bond
+    // kernel reads contiguous floats instead of interleaved complex values.
+    const size_t num_ms(m_num_ms);
+    std::vector<float> qlm_re(size_t(num_query_points) * num_ms);
+    std::vector<float> qlm_im(size_t(num_query_points) * num_ms);
+    util::forLoopWrapper(0, qlm_re.size(), [&](size_t begin, size_t end) {
+        for (size_t idx = begin; idx < end; ++idx)
+        {
+            qlm_re[idx] = m_qlm[idx].real();
+            qlm_im[idx] = m_qlm[idx].imag();
+        }
+    });
+
     util::forLoopWrapper(
         0, num_query_points,
-        [=](size_t begin, size_t end) {
+        [&](size_t begin, size_t end) {
+            // Bonds are evaluated in batches: the neighbors' rows for up to
+            // batch_width bonds of a query point are first gathered into
+            // m-major planes, and the reduction over m then runs as a lane
+            // loop with the query point's component broadcast, which the
+            // compiler turns into FMAs across the batch. The reduction always
+            // scans the full batch width so the inner loop carries no
+            // lane-count branch; lanes beyond the batch's bond count read
+            // leftover plane entries and are discarded.
+            constexpr unsigned int batch_width = 8;
+            std::vector<float> batch_re(num_ms * batch_width);
+            std::vector<float> batch_im(num_ms * batch_width);
+            float acc[batch_width];
+            float nb_ql[batch_width];
             for (unsigned int i = begin; i != end; ++i)
             {
+                const float* const row_re = qlm_re.data() + size_t(i) * num_ms;
+                const float* const row_im = qlm_im.data() + size_t(i) * num_ms;
                 unsigned int bond(m_nlist.find_first_index(i));
-                for (; bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+                while (bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i)
                 {
-                    const unsigned int j(m_nlist.getNeighbors()(bond, 1));
+                    unsigned int count = 0;
+                    for (; count < batch_width && bond + count < num_bonds
+                         && m_nlist.getNeighbors()(bond + count, 0) == i;
+                         ++count)
+                    {
+                        const unsigned int j(m_nlist.getNeighbors()(bond + count, 1));
+                        nb_ql[count] = m_ql[j];
+                        const float* const nb_re = qlm_re.data() + size_t(j) * num_ms;
+                        const float* const nb_im = qlm_im.data() + size_t(j) * num_ms;
+                        for (size_t k = 0; k < num_ms; ++k)
+                        {
+                            batch_re[k * batch_width + count] = nb_re[k];
+                            batch_im[k * batch_width + count] = nb_im[k];
+                        }
+                    }
 
-                    // Accumulate the dot product over m of qlmi and qlmj vectors
-                    std::complex<float> bond_ql_ij = 0;
-                    for (unsigned int k = 0; k < m_num_ms; k++)
+                    for (unsigned int lane = 0; lane < batch_width; ++lane)
+                    {
+                        acc[lane] = float(0);
+                    }
+                    for (size_t k = 0; k < num_ms; ++k)
                     {
-                        bond_ql_ij += qlm(i, k) * std::conj(qlm(j, k));
+                        const float a_re = row_re[k];
+                        const float a_im = row_im[k];
+                        const float* const b_re = batch_re.data() + k * batch_width;
+                        const float* const b_im = batch_im.data() + k * batch_width;
+                        for (unsigned int lane = 0; lane < batch_width; ++lane)
+                        {
+                            acc[lane] += a_re * b_re[lane] + a_im * b_im[lane];
+                        }
                     }
 
-                    // Optionally normalize dot products by points' ql values,
-                    // accounting for the normalization of ql values
-                    if (m_normalize_q)
+                    for (unsigned int lane = 0; lane < count; ++lane)
                     {
-                        bond_ql_ij *= normalizationfactor / (ql[i] * ql[j]);
+                        // Optionally normalize dot products by points' ql
+                        // values (cached per particle), accounting for the
+                        // normalization of ql values.
+                        m_ql_ij[bond + lane] = m_normalize_q
+                            ? acc[lane] * (normalizationfactor / (m_ql[i] * nb_ql[lane]))
+                            : acc[lane];
                     }
-                    m_ql_ij[bond] = bond_ql_ij.real();
+                    bond += count;
                 }
             }
         },
@@ -88,6 +88,20 @@ public:
     void compute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                  freud::locality::QueryArgs qargs);
 
+    //! Compute incrementally, reusing cached qlm from the previous frame.
+    /*! Particles whose neighborhood is unchanged -- neither they nor any
+     *  current or previous neighbor moved farther than
+     *  displacement_threshold since the last compute -- keep their cached
+     *  qlm and ql values, and harmonics are re-evaluated only for the rest.
+     *  The bond dot products, solid-like filtering, and clustering are
+     *  recomputed every frame; they are cheap compared to the harmonics.
+     *  Falls back to a full compute when no cached frame is available or
+     *  the number of points changed.
+     */
+    void computeIncremental(const freud::locality::NeighborList* nlist,
+                            const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs,
+                            float displacement_threshold);
+
     //! Returns largest cluster size.
     unsigned int getLargestClusterSize() const
     {
@@ -132,7 +146,7 @@ public:
     //! Get the last calculated qlm for each particle
     const util::ManagedArray<std::complex<float>>& getQlm() const
     {
-        return m_steinhardt.getQlm()[0];
+        return m_qlm;
     }
 
     //! Return the ql_ij values.
@@ -142,6 +156,15 @@ public:
     }
 
 private:
+    //! Recompute qlm and ql rows for the given particles from m_nlist bonds.
+    void computeQlmRows(const freud::locality::NeighborQuery* points,
+                        const std::vector<unsigned int>& particles);
+
+    //! Compute bond dot products, filter solid-like bonds, and cluster,
+    //  using the current m_qlm, m_ql, and m_nlist.
+    void classifyAndCluster(const freud::locality::NeighborQuery* points,
+                            freud::locality::QueryArgs qargs);
+
     unsigned int m_l;               //!< Value of l for the spherical harmonic.
     unsigned int m_num_ms;          //!< The number of magnetic quantum numbers (2*m_l+1).
     float m_q_threshold;            //!< Dot product cutoff
@@ -152,6 +175,9 @@ private:
     freud::order::Steinhardt m_steinhardt; //!< Steinhardt class used to compute qlm
     freud::cluster::Cluster m_cluster;     //!< Cluster class used to cluster solid-like bonds
 
+    util::ManagedArray<std::complex<float>> m_qlm; //!< qlm for each particle, cached across frames
+    util::ManagedArray<float> m_ql;                //!< ql for each particle, cached across frames
+    std::vector<vec3<float>> m_cached_positions;   //!< Positions at the last cached compute
     util::ManagedArray<float> m_ql_ij;                        //!< All of the qlmi dot qlmj's computed
     util::ManagedArray<unsigned int> m_number_of_connections; //! Number of connections for each particle with
                                                               //! dot product above q_threshold
@@ -0,0 +1,141 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "SphericalHarmonics.h"
+
+/*! \file SphericalHarmonics.cc
+    \brief Batched evaluation of spherical harmonics over blocks of bonds.
+*/
+
+namespace freud { namespace order {
+
+BatchedYlmEvaluator::BatchedYlmEvaluator(const std::vector<unsigned int>& ls)
+    : m_ls(ls), m_max_l(*std::max_element(ls.begin(), ls.end())), m_slot(m_max_l + 1, -1),
+      m_re(ls.size()), m_im(ls.size())
+{
+    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    {
+        m_slot[m_ls[l_index]] = static_cast<int>(l_index);
+    }
+
+    // Normalization K_l^m = sqrt((2l+1)/(4 pi) * (l-m)!/(l+m)!), evaluated
+    // in double since the factorial ratio underflows float range by l=20.
+    m_norm.resize((m_max_l + 1) * (m_max_l + 2) / 2);
+    for (unsigned int l = 0; l <= m_max_l; ++l)
+    {
+        for (unsigned int m = 0; m <= l; ++m)
+        {
+            double factorial_ratio(1.0);
+            for (unsigned int k = l - m + 1; k <= l + m; ++k)
+            {
+                factorial_ratio /= static_cast<double>(k);
+            }
+            m_norm[l * (l + 1) / 2 + m] = static_cast<float>(
+                std::sqrt((2.0 * l + 1.0) / (4.0 * M_PI) * factorial_ratio));
+        }
+    }
+}
+
+void BatchedYlmEvaluator::emitRow(unsigned int l, unsigned int m, const float* p_lm,
+                                  unsigned int num_bonds)
+{
+    const int slot = m_slot[l];
+    if (slot < 0)
+    {
+        return;
+    }
+    const float normalization = m_norm[l * (l + 1) / 2 + m];
+    const float phase = (m % 2 == 1) ? -1.0F : 1.0F;
+    // m ordering is [0, 1, ..., l, -1, ..., -l], so -m lives at row l + m.
+    float* re_pos = m_re[slot].data() + size_t(m) * num_bonds;
+    float* im_pos = m_im[slot].data() + size_t(m) * num_bonds;
+    const float* cos_m = m_cos_m.data();
+    const float* sin_m = m_sin_m.data();
+    if (m == 0)
+    {
+        for (unsigned int b = 0; b < num_bonds; ++b)
+        {
+            re_pos[b] = normalization * p_lm[b];
+            im_pos[b] = 0.0F;
+        }
+        return;
+    }
+    float* re_neg = m_re[slot].data() + size_t(l + m) * num_bonds;
+    float* im_neg = m_im[slot].data() + size_t(l + m) * num_bonds;
+    for (unsigned int b = 0; b < num_bonds; ++b)
+    {
+        const float base = normalization * p_lm[b];
+        // Y_l^m = (-1)^m K P e^(i m phi), Y_l^-m = K P e^(-i m phi).
+        re_pos[b] = phase * base * cos_m[b];
+        im_pos[b] = phase * base * sin_m[b];
+        re_neg[b] = base * cos_m[b];
+        im_neg[b] = -base * sin_m[b];
+    }
+}
+
+void BatchedYlmEvaluator::compute(const float* cos_theta, const float* sin_theta, const float* cos_phi,
+                                  const float* sin_phi, unsigned int num_bonds)
+{
+    m_row_stride = num_bonds;
+    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    {
+        m_re[l_index].resize(size_t(2 * m_ls[l_index] + 1) * num_bonds);
+        m_im[l_index].resize(size_t(2 * m_ls[l_index] + 1) * num_bonds);
+    }
+    m_p_mm.assign(num_bonds, 1.0F);
+    m_cos_m.assign(num_bonds, 1.0F);
+    m_sin_m.assign(num_bonds, 0.0F);
+    m_p_prev.resize(num_bonds);
+    m_p_curr.resize(num_bonds);
+
+    for (unsigned int m = 0; m <= m_max_l; ++m)
+    {
+        if (m > 0)
+        {
+            // P_m^m = (2m-1)!! sin(theta)^m and the angle-addition step for
+            // cos/sin of m*phi, both as vectorizable per-bond updates.
+            const float diagonal = static_cast<float>(2 * m - 1);
+            for (unsigned int b = 0; b < num_bonds; ++b)
+            {
+                m_p_mm[b] *= diagonal * sin_theta[b];
+                const float next_cos = m_cos_m[b] * cos_phi[b] - m_sin_m[b] * sin_phi[b];
+                m_sin_m[b] = m_sin_m[b] * cos_phi[b] + m_cos_m[b] * sin_phi[b];
+                m_cos_m[b] = next_cos;
+            }
+        }
+
+        std::copy(m_p_mm.begin(), m_p_mm.end(), m_p_prev.begin());
+        emitRow(m, m, m_p_prev.data(), num_bonds);
+        if (m == m_max_l)
+        {
+            break;
+        }
+
+        // P_{m+1}^m = (2m+1) cos(theta) P_m^m.
+        const float first_band = static_cast<float>(2 * m + 1);
+        for (unsigned int b = 0; b < num_bonds; ++b)
+        {
+            m_p_curr[b] = first_band * cos_theta[b] * m_p_prev[b];
+        }
+        emitRow(m + 1, m, m_p_curr.data(), num_bonds);
+
+        // (l-m) P_l^m = (2l-1) cos(theta) P_{l-1}^m - (l+m-1) P_{l-2}^m.
+        for (unsigned int l = m + 2; l <= m_max_l; ++l)
+        {
+            const float a = static_cast<float>(2 * l - 1);
+            const float c = static_cast<float>(l + m - 1);
+            const float inv = 1.0F / static_cast<float>(l - m);
+            for (unsigned int b = 0; b < num_bonds; ++b)
+            {
+                m_p_prev[b] = (a * cos_theta[b] * m_p_curr[b] - c * m_p_prev[b]) * inv;
+            }
+            std::swap(m_p_prev, m_p_curr);
+            emitRow(l, m, m_p_curr.data(), num_bonds);
+        }
+    }
+}
+
+}; }; // end namespace freud::order
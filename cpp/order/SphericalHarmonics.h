@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SPHERICAL_HARMONICS_H
+#define SPHERICAL_HARMONICS_H
+
+#include <cstddef>
+#include <vector>
+
+/*! \file SphericalHarmonics.h
+    \brief Batched evaluation of spherical harmonics over blocks of bonds.
+*/
+
+namespace freud { namespace order {
+
+//! Evaluate Y_lm for blocks of bond directions with vectorizable recurrences.
+/*! The evaluator computes spherical harmonics for every requested l from
+ *  structure-of-arrays inputs describing a block of unit directions. All
+ *  per-bond work is expressed as associated-Legendre and angle-addition
+ *  recurrences over the bond dimension, so the inner loops are plain float
+ *  arithmetic over contiguous arrays that the compiler can vectorize; no
+ *  transcendental function is called anywhere in the kernel.
+ *
+ *  Outputs follow the m ordering used throughout the order module:
+ *  m = 0, 1, ..., l, -1, ..., -l. Positive m entries carry the
+ *  Condon-Shortley phase and negative m entries equal (-1)^m times the
+ *  conjugate of the corresponding positive entry, matching the convention
+ *  of the previous per-bond evaluator.
+ */
+class BatchedYlmEvaluator
+{
+public:
+    //! Constructor. Precomputes normalization tables for the requested ls.
+    explicit BatchedYlmEvaluator(const std::vector<unsigned int>& ls);
+
+    //! Evaluate Ylm for a block of unit bond directions.
+    /*! \param cos_theta Cosine of the polar angle per bond.
+     *  \param sin_theta Sine of the polar angle per bond (non-negative).
+     *  \param cos_phi Cosine of the azimuthal angle per bond.
+     *  \param sin_phi Sine of the azimuthal angle per bond.
+     *  \param num_bonds The number of bonds in the block.
+     */
+    void compute(const float* cos_theta, const float* sin_theta, const float* cos_phi,
+                 const float* sin_phi, unsigned int num_bonds);
+
+    //! Real parts for the l at l_index: 2*l+1 rows of rowStride() floats.
+    const float* real(size_t l_index) const
+    {
+        return m_re[l_index].data();
+    }
+
+    //! Imaginary parts for the l at l_index, laid out like real().
+    const float* imag(size_t l_index) const
+    {
+        return m_im[l_index].data();
+    }
+
+    //! Number of floats between consecutive m rows of the last compute.
+    unsigned int rowStride() const
+    {
+        return m_row_stride;
+    }
+
+private:
+    std::vector<unsigned int> m_ls; //!< Requested spherical harmonic numbers l
+    unsigned int m_max_l;           //!< Largest requested l
+    std::vector<int> m_slot;        //!< Map from l value to index in m_ls, -1 if absent
+    std::vector<float> m_norm;      //!< Normalization constants, indexed l*(l+1)/2 + m
+    unsigned int m_row_stride {0};  //!< Bonds per m row in the last compute
+
+    std::vector<std::vector<float>> m_re; //!< Per-l real outputs, m rows by bond
+    std::vector<std::vector<float>> m_im; //!< Per-l imaginary outputs, m rows by bond
+
+    // Scratch buffers reused across compute calls.
+    std::vector<float> m_p_mm;   //!< P_m^m values per bond
+    std::vector<float> m_p_prev; //!< P_{l-1}^m values per bond
+    std::vector<float> m_p_curr; //!< P_l^m values per bond
+    std::vector<float> m_cos_m;  //!< cos(m*phi) per bond
+    std::vector<float> m_sin_m;  //!< sin(m*phi) per bond
+
+    //! Write the normalized harmonics for one (l, m) row pair.
+    void emitRow(unsigned int l, unsigned int m, const float* p_lm, unsigned int num_bonds);
+};
+
+}; }; // end namespace freud::order
+
+#endif // SPHERICAL_HARMONICS_H
@@ -1,9 +1,12 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
-#include "Steinhardt.h"
 #include "NeighborComputeFunctional.h"
+#include "SphericalHarmonics.h"
+#include "Steinhardt.h"
+#include "Voronoi.h"
 #include "utils.h"
+#include <numeric>
 #include <vector>
 
 /*! \file Steinhardt.cc
@@ -12,28 +15,6 @@
 
 namespace freud { namespace order {
 
-// Calculating Ylm using fsph module
-void Steinhardt::computeYlm(fsph::PointSPHEvaluator<float>& sph_eval, const float theta, const float phi,
-                            YlmsType& Ylms) const
-{
-    sph_eval.compute(theta, phi);
-
-    for (size_t i = 0; i < m_ls.size(); ++i)
-    {
-        auto& Ylm = Ylms[i];
-        const auto l = m_ls[i];
-        size_t m_index(0);
-
-        const auto end_iter(sph_eval.begin_l(l + 1, 0, true));
-        for (auto iter(sph_eval.begin_l(l, 0, true)); iter != end_iter; ++iter, ++m_index)
-        {
-            // Manually add the Condon-Shortley phase, (-1)^m, to positive odd m
-            const float phase = (m_index <= l && m_index % 2 == 1) ? -1 : 1;
-            Ylm[m_index] = phase * (*iter);
-        }
-    }
-}
-
 void Steinhardt::reallocateArrays(unsigned int Np)
 {
     m_Np = Np;
@@ -41,13 +22,11 @@ void Steinhardt::reallocateArrays(unsigned int Np)
     const auto num_ls = m_ls.size();
 
     m_qli.prepare({Np, num_ls});
+    m_wli.prepare({Np, num_ls});
     if (m_average)
     {
         m_qliAve.prepare({Np, num_ls});
-    }
-    if (m_wl)
-    {
-        m_wli.prepare({Np, num_ls});
+        m_wliAve.prepare({Np, num_ls});
     }
 
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
@@ -73,25 +52,59 @@ void Steinhardt::compute(const freud::locality::NeighborList* nlist,
 
     if (m_average)
     {
-        computeAve(nlist, points, qargs);
+        computeAveFromCSR();
     }
 
+    finalizeOrder();
+}
+
+void Steinhardt::computeFromVoronoi(locality::Voronoi& voronoi,
+                                    const freud::locality::NeighborQuery* points)
+{
+    computeFromSortedBonds(voronoi.computeBonds(points), points);
+}
+
+void Steinhardt::computeFromSortedBonds(const std::vector<locality::NeighborBond>& bonds,
+                                        const freud::locality::NeighborQuery* points)
+{
+    reallocateArrays(points->getNPoints());
+
+    // Prefix-sum the per-particle bond counts so each particle's bonds are a
+    // contiguous span of the sorted vector.
+    std::vector<size_t> first_bond(m_Np + 1, 0);
+    for (const auto& bond : bonds)
+    {
+        ++first_bond[bond.query_point_idx + 1];
+    }
+    std::partial_sum(first_bond.begin(), first_bond.end(), first_bond.begin());
+
+    baseComputeFromBonds(bonds, first_bond, points);
+
+    if (m_average)
+    {
+        computeAveFromBonds(bonds, first_bond, points);
+    }
+
+    finalizeOrder();
+}
+
+void Steinhardt::finalizeOrder()
+{
     // Reduce qlm
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
         m_qlm_local[l_index].reduceInto(m_qlm[l_index]);
     }
 
-    if (m_wl)
+    // The wl invariants are always aggregated from the cached qlm arrays:
+    // once the neighbor and harmonics pass has filled qlmi, the Wigner
+    // reduction is cheap per particle, and computing both ql and wl (plain
+    // and averaged) lets a single pass serve every derived variant for the
+    // whole l list instead of re-running the neighbor loop per variant.
+    aggregatewl(m_wli, m_qlmi, m_qli);
+    if (m_average)
     {
-        if (m_average)
-        {
-            aggregatewl(m_wli, m_qlmiAve, m_qliAve);
-        }
-        else
-        {
-            aggregatewl(m_wli, m_qlmi, m_qli);
-        }
+        aggregatewl(m_wliAve, m_qlmiAve, m_qliAve);
     }
     m_norm = normalizeSystem();
 }
@@ -111,63 +124,93 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
         qlm_local.reset();
     }
 
+    // With averaging enabled, the neighbor indices visited in this pass are
+    // recorded so the averaging pass can run as a sparse matrix-vector
+    // product over the stored qlm arrays instead of re-traversing the query
+    // structure (see computeAveFromCSR). Each particle writes only its own
+    // slot, so the scratch needs no synchronization; it is flattened into
+    // CSR form after the loop.
+    std::vector<std::vector<unsigned int>> cached_neighbors(m_average ? m_Np : 0);
+
     freud::locality::loopOverNeighborsIterator(
         points, points->getPoints(), m_Np, qargs, nlist,
-        [=](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
+        [=, &cached_neighbors](size_t i,
+                               const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
             float total_weight(0);
             const vec3<float> ref((*points)[i]);
-            // Construct PointSPHEvaluator outside loop since the construction is costly.
-            auto max_l = *std::max_element(m_ls.begin(), m_ls.end());
-            fsph::PointSPHEvaluator<float> sph_eval(max_l);
-
-            // Alocate and instantiate this array before looping over particles to prevent N instantiations
-            // and N * m_l.size() allocations.
-            YlmsType Ylms(m_ls.size());
-            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-            {
-                Ylms[l_index].resize(m_num_ms[l_index]);
-            }
+            // Construct the evaluator outside the bond loop since the
+            // construction (normalization tables) is costly.
+            BatchedYlmEvaluator ylm_eval(m_ls);
+
+            // Gather this particle's bonds into structure-of-arrays form so
+            // the harmonics can be evaluated for the whole block at once
+            // with vectorized recurrences instead of per-bond calls.
+            std::vector<float> cos_thetas;
+            std::vector<float> sin_thetas;
+            std::vector<float> cos_phis;
+            std::vector<float> sin_phis;
+            std::vector<float> weights;
 
             for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
             {
                 const vec3<float> delta = points->getBox().wrap((*points)[nb.point_idx] - ref);
                 const float weight(m_weighted ? nb.weight : float(1.0));
 
-                // phi is usually in range 0..2Pi, but
-                // it only appears in Ylm as exp(im\phi),
-                // so range -Pi..Pi will give same results.
-                const float phi = std::atan2(delta.y, delta.x); // -Pi..Pi
-
                 // This value must be clamped in cases where the particles are
                 // aligned along z, otherwise due to floating point error we
                 // could get delta.z/nb.distance = -1-eps, which is outside the
-                // valid range of std::acos.
-                float theta = std::acos(util::clamp(delta.z / nb.distance, -1, 1)); // 0..Pi
-
-                // If the points are directly on top of each other,
-                // theta should be zero instead of nan.
-                if (nb.distance == float(0))
+                // valid range of the recurrences. If the points are directly
+                // on top of each other, theta should be zero instead of nan.
+                const float cos_theta
+                    = (nb.distance == float(0)) ? float(1) : util::clamp(delta.z / nb.distance, -1, 1);
+                const float sin_theta = std::sqrt(std::max(float(0), 1 - cos_theta * cos_theta));
+
+                // Only cos/sin of phi are needed, so they are read off the
+                // normalized in-plane components directly; no atan2 call.
+                const float r_xy = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+                const float cos_phi = (r_xy == float(0)) ? float(1) : delta.x / r_xy;
+                const float sin_phi = (r_xy == float(0)) ? float(0) : delta.y / r_xy;
+
+                cos_thetas.push_back(cos_theta);
+                sin_thetas.push_back(sin_theta);
+                cos_phis.push_back(cos_phi);
+                sin_phis.push_back(sin_phi);
+                weights.push_back(weight);
+                // Accumulate weight for normalization
+                total_weight += weight;
+                if (m_average)
                 {
-                    theta = 0;
+                    cached_neighbors[i].push_back(nb.point_idx);
                 }
+            } // End loop going over neighbor bonds
 
-                computeYlm(sph_eval, theta, phi, Ylms); // Fill up Ylm
+            const auto num_bonds = static_cast<unsigned int>(weights.size());
+            if (num_bonds > 0)
+            {
+                ylm_eval.compute(cos_thetas.data(), sin_thetas.data(), cos_phis.data(), sin_phis.data(),
+                                 num_bonds);
+            }
 
-                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+            {
+                auto& qlmi = m_qlmi[l_index];
+                // Get the initial index and iterate using ++ for faster iteration
+                // Profiling showed using operator() to slow the code significantly.
+                const size_t index = qlmi.getIndex({i, 0});
+                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
                 {
-                    auto& qlmi = m_qlmi[l_index];
-                    const auto& Ylm = Ylms[l_index];
-                    // Get the initial index and iterate using ++ for faster iteration
-                    // Profiling showed using operator() to slow the code significantly.
-                    const size_t index = qlmi.getIndex({i, 0});
-                    for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                    const float* row_re = ylm_eval.real(l_index) + k * num_bonds;
+                    const float* row_im = ylm_eval.imag(l_index) + k * num_bonds;
+                    float sum_re(0);
+                    float sum_im(0);
+                    for (unsigned int b = 0; b < num_bonds; ++b)
                     {
-                        qlmi[index + k] += weight * Ylm[k];
+                        sum_re += weights[b] * row_re[b];
+                        sum_im += weights[b] * row_im[b];
                     }
+                    qlmi[index + k] += std::complex<float>(sum_re, sum_im);
                 }
-                // Accumulate weight for normalization
-                total_weight += weight;
-            } // End loop going over neighbor bonds
+            }
 
             // Normalize!
             const size_t qli_i_start = m_qli.getIndex({i, 0});
@@ -197,29 +240,155 @@ void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
                 m_qli[qli_index] = std::sqrt(m_qli[qli_index]);
             }
         });
+
+    if (m_average)
+    {
+        // Flatten the per-particle scratch into CSR form for computeAveFromCSR.
+        m_first_cached_bond.assign(size_t(m_Np) + 1, 0);
+        for (size_t i = 0; i < m_Np; ++i)
+        {
+            m_first_cached_bond[i + 1] = m_first_cached_bond[i] + cached_neighbors[i].size();
+        }
+        m_cached_neighbors.resize(m_first_cached_bond[m_Np]);
+        util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                std::copy(cached_neighbors[i].begin(), cached_neighbors[i].end(),
+                          m_cached_neighbors.begin() + m_first_cached_bond[i]);
+            }
+        });
+    }
 }
 
-void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
-                            const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
+void Steinhardt::baseComputeFromBonds(const std::vector<locality::NeighborBond>& bonds,
+                                      const std::vector<size_t>& first_bond,
+                                      const freud::locality::NeighborQuery* points)
 {
-    std::shared_ptr<locality::NeighborQueryIterator> iter;
-    if (nlist == nullptr)
+    std::vector<float> normalizationfactor(m_ls.size());
+    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
-        iter = points->query(points->getPoints(), points->getNPoints(), qargs);
+        normalizationfactor[l_index] = float(4.0 * M_PI / m_num_ms[l_index]);
+    }
+    for (auto& qlm_local : m_qlm_local)
+    {
+        qlm_local.reset();
     }
 
+    const auto box = points->getBox();
+
+    // Mirrors the accumulation in baseCompute, but iterates each particle's
+    // contiguous span of the sorted bond vector instead of a neighbor
+    // iterator, so the fused Voronoi path needs no NeighborList.
+    util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
+        BatchedYlmEvaluator ylm_eval(m_ls);
+        std::vector<float> cos_thetas;
+        std::vector<float> sin_thetas;
+        std::vector<float> cos_phis;
+        std::vector<float> sin_phis;
+        std::vector<float> weights;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            float total_weight(0);
+            const vec3<float> ref((*points)[i]);
+            cos_thetas.clear();
+            sin_thetas.clear();
+            cos_phis.clear();
+            sin_phis.clear();
+            weights.clear();
+
+            for (size_t bond = first_bond[i]; bond < first_bond[i + 1]; ++bond)
+            {
+                const auto& nb = bonds[bond];
+                const vec3<float> delta = box.wrap((*points)[nb.point_idx] - ref);
+                const float weight(m_weighted ? nb.weight : float(1.0));
+
+                // Bond angles are derived exactly as in baseCompute so both
+                // entry points agree bit-for-bit.
+                const float cos_theta
+                    = (nb.distance == float(0)) ? float(1) : util::clamp(delta.z / nb.distance, -1, 1);
+                const float sin_theta = std::sqrt(std::max(float(0), 1 - cos_theta * cos_theta));
+                const float r_xy = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+
+                cos_thetas.push_back(cos_theta);
+                sin_thetas.push_back(sin_theta);
+                cos_phis.push_back((r_xy == float(0)) ? float(1) : delta.x / r_xy);
+                sin_phis.push_back((r_xy == float(0)) ? float(0) : delta.y / r_xy);
+                weights.push_back(weight);
+                total_weight += weight;
+            }
+
+            const auto num_bonds = static_cast<unsigned int>(weights.size());
+            if (num_bonds > 0)
+            {
+                ylm_eval.compute(cos_thetas.data(), sin_thetas.data(), cos_phis.data(), sin_phis.data(),
+                                 num_bonds);
+            }
+
+            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+            {
+                auto& qlmi = m_qlmi[l_index];
+                const size_t index = qlmi.getIndex({i, 0});
+                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                {
+                    const float* row_re = ylm_eval.real(l_index) + k * num_bonds;
+                    const float* row_im = ylm_eval.imag(l_index) + k * num_bonds;
+                    float sum_re(0);
+                    float sum_im(0);
+                    for (unsigned int b = 0; b < num_bonds; ++b)
+                    {
+                        sum_re += weights[b] * row_re[b];
+                        sum_im += weights[b] * row_im[b];
+                    }
+                    qlmi[index + k] += std::complex<float>(sum_re, sum_im);
+                }
+            }
+
+            // Normalize!
+            const size_t qli_i_start = m_qli.getIndex({i, 0});
+            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+            {
+                auto& qlmi = m_qlmi[l_index];
+                auto& qlm_local = m_qlm_local[l_index];
+                const size_t first_qlmi_index = qlmi.getIndex({i, 0});
+                const size_t qli_index = qli_i_start + l_index;
+
+                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                {
+                    const size_t qlmi_index = first_qlmi_index + k;
+
+                    qlmi[qlmi_index] /= total_weight;
+                    m_qli[qli_index] += norm(qlmi[qlmi_index]);
+                    if (!m_average)
+                    {
+                        qlm_local.local()[k] += qlmi[qlmi_index] / float(m_Np);
+                    }
+                }
+                m_qli[qli_index] *= normalizationfactor[l_index];
+                m_qli[qli_index] = std::sqrt(m_qli[qli_index]);
+            }
+        }
+    });
+}
+
+void Steinhardt::computeAveFromBonds(const std::vector<locality::NeighborBond>& bonds,
+                                     const std::vector<size_t>& first_bond,
+                                     const freud::locality::NeighborQuery* points)
+{
     std::vector<float> normalizationfactor(m_ls.size());
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
         normalizationfactor[l_index] = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
     }
 
-    freud::locality::loopOverNeighborsIterator(
-        points, points->getPoints(), m_Np, qargs, nlist,
-        [=](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
+    // Mirrors computeAve over the sorted bond vector.
+    util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
             unsigned int neighborcount(1);
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            for (size_t bond = first_bond[i]; bond < first_bond[i + 1]; ++bond)
             {
+                const auto& nb = bonds[bond];
                 for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
                 {
                     auto& qlmiAve = m_qlmiAve[l_index];
@@ -227,6 +396,67 @@ void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
                     const auto ave_index = qlmiAve.getIndex({i, 0});
                     const auto nb_index = qlmi.getIndex({nb.point_idx, 0});
                     for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                    {
+                        qlmiAve[ave_index + k] += qlmi[nb_index + k];
+                    }
+                }
+                neighborcount++;
+            }
+
+            // Normalize!
+
+            const size_t qliAve_i_start = m_qliAve.getIndex({i, 0});
+            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+            {
+                auto& qlmiAve = m_qlmiAve[l_index];
+                auto& qlmi = m_qlmi[l_index];
+                auto& qlm_local = m_qlm_local[l_index];
+                const size_t first_qlmi_index = qlmiAve.getIndex({i, 0});
+                const size_t qliAve_index = qliAve_i_start + l_index;
+
+                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                {
+                    const size_t qlmi_index = first_qlmi_index + k;
+                    qlmiAve[qlmi_index] += qlmi[qlmi_index];
+                    qlmiAve[qlmi_index] /= static_cast<float>(neighborcount);
+                    qlm_local.local()[k] += qlmiAve[qlmi_index] / float(m_Np);
+                    m_qliAve[qliAve_index] += norm(qlmiAve[qlmi_index]);
+                }
+                m_qliAve[qliAve_index] *= normalizationfactor[l_index];
+                m_qliAve[qliAve_index] = std::sqrt(m_qliAve[qliAve_index]);
+            }
+        }
+    });
+}
+
+void Steinhardt::computeAveFromCSR()
+{
+    std::vector<float> normalizationfactor(m_ls.size());
+    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    {
+        normalizationfactor[l_index] = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
+    }
+
+    // The averaging pass is a sparse matrix-vector product: the CSR bond
+    // structure cached by baseCompute is the sparsity pattern and the stored
+    // qlm arrays are the vectors, so no positions are fetched and the query
+    // structure is never re-traversed. The cached bonds are in first-pass
+    // iteration order, so the sums match the former neighbor-loop
+    // implementation bit for bit.
+    util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            unsigned int neighborcount(1);
+            for (size_t bond = m_first_cached_bond[i]; bond < m_first_cached_bond[i + 1]; ++bond)
+            {
+                const unsigned int nb_idx = m_cached_neighbors[bond];
+                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+                {
+                    auto& qlmiAve = m_qlmiAve[l_index];
+                    auto& qlmi = m_qlmi[l_index];
+                    const auto ave_index = qlmiAve.getIndex({i, 0});
+                    const auto nb_index = qlmi.getIndex({nb_idx, 0});
+                    for (size_t k = 0; k < m_num_ms[l_index]; ++k)
                     {
                         // Adding all the qlm of the neighbors. We use the
                         // vector function signature for indexing into the
@@ -262,7 +492,8 @@ void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
                 m_qliAve[qliAve_index] *= normalizationfactor[l_index];
                 m_qliAve[qliAve_index] = std::sqrt(m_qliAve[qliAve_index]);
             }
-        });
+        }
+    });
 }
 
 std::vector<float> Steinhardt::normalizeSystem()
@@ -283,8 +514,7 @@ std::vector<float> Steinhardt::normalizeSystem()
 
         if (m_wl)
         {
-            const auto wigner3j_values = getWigner3j(l);
-            float wl_system_norm = reduceWigner3j(qlm.get(), l, wigner3j_values);
+            float wl_system_norm = reduceWigner3j(qlm.get(), getWigner3jTerms(l));
 
             // The normalization factor of wl is calculated using qli, which is
             // equivalent to calculate the normalization factor from qlmi
@@ -307,6 +537,15 @@ void Steinhardt::aggregatewl(util::ManagedArray<float>& target,
                              const std::vector<util::ManagedArray<std::complex<float>>>& source,
                              const util::ManagedArray<float>& normalization_source) const
 {
+    // Resolve each l's term table once; the per-particle loop below then
+    // streams the same flat tables for every particle.
+    std::vector<const std::vector<Wigner3jTerm>*> wigner3j_terms;
+    wigner3j_terms.reserve(m_ls.size());
+    for (const auto l : m_ls)
+    {
+        wigner3j_terms.push_back(&getWigner3jTerms(l));
+    }
+
     util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
         {
@@ -314,14 +553,12 @@ void Steinhardt::aggregatewl(util::ManagedArray<float>& target,
             const auto norm_particle_index = normalization_source.getIndex({i, 0});
             for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
             {
-                const auto l = m_ls[l_index];
                 const auto& source_l = source[l_index];
 
                 const auto normalizationfactor = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
-                const auto wigner3j_values = getWigner3j(l);
 
                 target[target_particle_index + l_index]
-                    = reduceWigner3j(&(source_l({i, 0})), l, wigner3j_values);
+                    = reduceWigner3j(&(source_l({i, 0})), *wigner3j_terms[l_index]);
                 if (m_wl_normalize)
                 {
                     const float normalization = std::sqrt(normalizationfactor) /
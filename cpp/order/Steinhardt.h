@@ -14,15 +14,16 @@
 #include "ThreadStorage.h"
 #include "VectorMath.h"
 #include "Wigner3j.h"
-#include "fsph/src/spherical_harmonics.hpp"
 
 /*! \file Steinhardt.h
     \brief Computes variants of Steinhardt order parameters.
 */
 
-namespace freud { namespace order {
+namespace freud { namespace locality {
+class Voronoi;
+}; }; // end namespace freud::locality
 
-using YlmsType = std::vector<std::vector<std::complex<float>>>;
+namespace freud { namespace order {
 
 //! Compute the Steinhardt local rotationally invariant ql or wl order parameter for a set of points
 /*!
@@ -45,8 +46,11 @@ using YlmsType = std::vector<std::vector<std::complex<float>>>;
  * If the norm flag is set, the ql value is normalized by the average qlm value
  * for the system.
  *
- * If the flag wl is set, the third-order invariant wl order parameter will
- * be calculated. wl can aid in distinguishing between FCC, HCP, and BCC.
+ * Both the second-order invariant ql and the third-order invariant wl are
+ * derived from the same cached qlm arrays, so a single neighbor and
+ * harmonics pass serves all variants for the whole l list. The wl flag
+ * selects which of the two getParticleOrder and getOrder report. wl can
+ * aid in distinguishing between FCC, HCP, and BCC.
  *
  * If the flag wl_normalize is set, the third-order invariant wl order parameter
  * will be normalized.
@@ -97,7 +101,7 @@ public:
     {
         if (m_wl)
         {
-            return m_wli;
+            return getWl();
         }
         return getQl();
     }
@@ -112,6 +116,20 @@ public:
         return m_qli;
     }
 
+    //! Get the last calculated wl for each l
+    /*! The wl invariants are always aggregated from the cached qlm arrays
+     *  regardless of the wl flag, so one neighbor and harmonics pass serves
+     *  both the ql and wl variants for the whole l list.
+     */
+    const util::ManagedArray<float>& getWl() const
+    {
+        if (m_average)
+        {
+            return m_wliAve;
+        }
+        return m_wli;
+    }
+
     //! Get the last calculated qlm for each particle and l
     const std::vector<util::ManagedArray<std::complex<float>>>& getQlm() const
     {
@@ -152,19 +170,31 @@ public:
     void compute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                  freud::locality::QueryArgs qargs);
 
+    //! Compute the order parameter fused with a Voronoi tessellation.
+    /*! Computes Voronoi cells for the points and accumulates qlm directly
+     *  from the bonds returned by Voronoi::computeBonds, while the cells are
+     *  still in cache; no intermediate NeighborList is materialized. With
+     *  the weighted flag set the facet areas act as bond weights, yielding
+     *  the Minkowski structure metrics of Mickel et al. All derived
+     *  quantities (ql, wl, averaged variants, system norms) are produced
+     *  exactly as by compute on the exported Voronoi neighbor list.
+     */
+    void computeFromVoronoi(locality::Voronoi& voronoi, const freud::locality::NeighborQuery* points);
+
+    //! Compute the order parameter from an explicit bond vector.
+    /*! The bonds must be sorted by query point index, as produced by
+     *  Voronoi::computeBonds. Shared by computeFromVoronoi and usable by any
+     *  caller that already holds sorted bonds for the points.
+     */
+    void computeFromSortedBonds(const std::vector<locality::NeighborBond>& bonds,
+                                const freud::locality::NeighborQuery* points);
+
     std::vector<unsigned int> getL() const
     {
         return m_ls;
     }
 
 private:
-    //! \internal
-    //! Spherical harmonics calculation for Ylm filling a
-    //  std::vector<std::vector<std::complex<float> > > with values for m = 0, 1, ..., l, -1, ..., -l
-    //  for all l in m_ls
-    void computeYlm(fsph::PointSPHEvaluator<float>& sph_eval, const float theta, const float phi,
-                    YlmsType& Ylms) const;
-
     template<typename T> std::shared_ptr<T> makeArray(size_t size);
 
     //! Reallocates only the necessary arrays when the number of particles changes
@@ -175,9 +205,27 @@ private:
     void baseCompute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                      freud::locality::QueryArgs qargs);
 
-    //! Calculates the neighbor average ql order parameter
-    void computeAve(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
-                    freud::locality::QueryArgs qargs);
+    //! Calculates the neighbor average ql order parameter.
+    /*! Runs as a sparse matrix-vector product over the stored qlm arrays
+     *  using the bond structure cached by baseCompute, so the averaging pass
+     *  never re-traverses the query structure.
+     */
+    void computeAveFromCSR();
+
+    //! Calculates qlms and ql from sorted bonds (fused Voronoi path).
+    //  first_bond holds each particle's offset into the bond vector.
+    void baseComputeFromBonds(const std::vector<locality::NeighborBond>& bonds,
+                              const std::vector<size_t>& first_bond,
+                              const freud::locality::NeighborQuery* points);
+
+    //! Calculates the neighbor average ql from sorted bonds.
+    void computeAveFromBonds(const std::vector<locality::NeighborBond>& bonds,
+                             const std::vector<size_t>& first_bond,
+                             const freud::locality::NeighborQuery* points);
+
+    //! Reduce qlm across threads, aggregate the wl invariants, and compute
+    //  the system norms. Shared tail of all compute entry points.
+    void finalizeOrder();
 
     //! Compute the system-wide order by averaging over particles, then
     //  reducing over the m values to produce a single scalar.
@@ -200,6 +248,8 @@ private:
     bool m_weighted;     //!< Whether to use neighbor weights in computing qlmi (default false)
     bool m_wl_normalize; //!< Whether to normalize the third-order invariant wl (default false)
 
+    std::vector<size_t> m_first_cached_bond;      //!< Each particle's offset into m_cached_neighbors.
+    std::vector<unsigned int> m_cached_neighbors; //!< First-pass neighbor indices in CSR form (averaging).
     std::vector<util::ManagedArray<std::complex<float>>> m_qlmi; //!< qlm for each particle i
     std::vector<util::ManagedArray<std::complex<float>>> m_qlm;  //!< Normalized qlm(Ave) for the whole system
     std::vector<util::ThreadStorage<std::complex<float>>>
@@ -214,7 +264,9 @@ private:
         m_qlmAve;                  //!< Normalized qlmiAve for the whole system
     std::vector<float> m_norm {0}; //!< System normalized order parameter
     util::ManagedArray<float>
-        m_wli; //!< wl order parameter for each particle i, also used for wl averaged data
+        m_wli; //!< wl order parameter for each particle i
+    util::ManagedArray<float>
+        m_wliAve; //!< Averaged wl with 2nd neighbor shell for each particle i
 };
 
 }; };  // end namespace freud::order
@@ -2,7 +2,8 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
-#include <vector>
+#include <array>
+#include <stdexcept>
 
 #include "Wigner3j.h"
 
@@ -12,13 +13,2346 @@
 
 namespace freud { namespace order {
 
+namespace {
+
+// All coefficients for a given l are stored contiguously starting at
+// WIGNER3J_OFFSETS[l]; each l contributes 3*l*l + 3*l + 1 values, in the
+// (m1, m2) iteration order documented in reduceWigner3j. Keeping the table
+// constexpr places it in read-only data shared between processes and avoids
+// any dynamic initialization at library load.
+constexpr std::array<size_t, 22> WIGNER3J_OFFSETS = {0, 1, 8, 27, 64, 125, 216, 343, 512, 729, 1000, 1331, 1728, 2197, 2744, 3375, 4096, 4913, 5832, 6859, 8000, 9261};
+
+constexpr std::array<double, 9261> WIGNER3J_TABLE = {{
+    1.0, 0.408248290463863, -0.408248290463863, -0.408248290463863,
+    0.0, 0.408248290463863, 0.408248290463863, -0.408248290463863,
+    0.23904572186687872, -0.29277002188455997, 0.23904572186687872, -0.29277002188455997,
+    0.11952286093343936, 0.11952286093343936, -0.29277002188455997, 0.23904572186687872,
+    0.11952286093343936, -0.23904572186687872, 0.11952286093343936, 0.23904572186687872,
+    -0.29277002188455997, 0.11952286093343936, 0.11952286093343936, -0.29277002188455997,
+    0.23904572186687872, -0.29277002188455997, 0.23904572186687872, 0.1543033499620919,
+    -0.2182178902359924, 0.2182178902359924, -0.1543033499620919, -0.2182178902359924,
+    0.1543033499620919, 0.0, -0.1543033499620919, 0.2182178902359924,
+    0.2182178902359924, 0.0, -0.1543033499620919, 0.1543033499620919,
+    0.0, -0.2182178902359924, -0.1543033499620919, -0.1543033499620919,
+    0.1543033499620919, 0.0, -0.1543033499620919, 0.1543033499620919,
+    0.1543033499620919, 0.2182178902359924, 0.0, -0.1543033499620919,
+    0.1543033499620919, 0.0, -0.2182178902359924, -0.2182178902359924,
+    0.1543033499620919, 0.0, -0.1543033499620919, 0.2182178902359924,
+    0.1543033499620919, -0.2182178902359924, 0.2182178902359924, -0.1543033499620919,
+    0.10429770312912398, -0.16490914830605122, 0.18698939800169143, -0.16490914830605122,
+    0.10429770312912398, -0.16490914830605122, 0.15644655469368596, -0.062329799333897144,
+    -0.062329799333897144, 0.15644655469368596, -0.16490914830605122, 0.18698939800169143,
+    -0.062329799333897144, -0.08194819531574027, 0.1413506985480439, -0.08194819531574027,
+    -0.062329799333897144, 0.18698939800169143, -0.16490914830605122, -0.062329799333897144,
+    0.1413506985480439, -0.06704852344015114, -0.06704852344015114, 0.1413506985480439,
+    -0.062329799333897144, -0.16490914830605122, 0.10429770312912398, 0.15644655469368596,
+    -0.08194819531574027, -0.06704852344015114, 0.13409704688030227, -0.06704852344015114,
+    -0.08194819531574027, 0.15644655469368596, 0.10429770312912398, -0.16490914830605122,
+    -0.062329799333897144, 0.1413506985480439, -0.06704852344015114, -0.06704852344015114,
+    0.1413506985480439, -0.062329799333897144, -0.16490914830605122, 0.18698939800169143,
+    -0.062329799333897144, -0.08194819531574027, 0.1413506985480439, -0.08194819531574027,
+    -0.062329799333897144, 0.18698939800169143, -0.16490914830605122, 0.15644655469368596,
+    -0.062329799333897144, -0.062329799333897144, 0.15644655469368596, -0.16490914830605122,
+    0.10429770312912398, -0.16490914830605122, 0.18698939800169143, -0.16490914830605122,
+    0.10429770312912398, 0.07242068243779014, -0.1254363015010636, 0.15644655469368596,
+    -0.15644655469368596, 0.1254363015010636, -0.07242068243779014, -0.1254363015010636,
+    0.14484136487558028, -0.09349469900084571, 0.0, 0.09349469900084571,
+    -0.14484136487558028, 0.1254363015010636, 0.15644655469368596, -0.09349469900084571,
+    -0.02414022747926338, 0.10795837927188262, -0.10795837927188262, 0.02414022747926338,
+    0.09349469900084571, -0.15644655469368596, -0.15644655469368596, 0.0,
+    0.10795837927188262, -0.09656090991705352, 0.0, 0.09656090991705352,
+    -0.10795837927188262, 0.0, 0.15644655469368596, 0.1254363015010636,
+    0.09349469900084571, -0.10795837927188262, 0.0, 0.09656090991705352,
+    -0.09656090991705352, 0.0, 0.10795837927188262, -0.09349469900084571,
+    -0.1254363015010636, -0.07242068243779014, -0.14484136487558028, 0.02414022747926338,
+    0.09656090991705352, -0.09656090991705352, 0.0, 0.09656090991705352,
+    -0.09656090991705352, -0.02414022747926338, 0.14484136487558028, 0.07242068243779014,
+    0.1254363015010636, 0.09349469900084571, -0.10795837927188262, 0.0,
+    0.09656090991705352, -0.09656090991705352, 0.0, 0.10795837927188262,
+    -0.09349469900084571, -0.1254363015010636, -0.15644655469368596, 0.0,
+    0.10795837927188262, -0.09656090991705352, 0.0, 0.09656090991705352,
+    -0.10795837927188262, 0.0, 0.15644655469368596, 0.15644655469368596,
+    -0.09349469900084571, -0.02414022747926338, 0.10795837927188262, -0.10795837927188262,
+    0.02414022747926338, 0.09349469900084571, -0.15644655469368596, -0.1254363015010636,
+    0.14484136487558028, -0.09349469900084571, 0.0, 0.09349469900084571,
+    -0.14484136487558028, 0.1254363015010636, 0.07242068243779014, -0.1254363015010636,
+    0.15644655469368596, -0.15644655469368596, 0.1254363015010636, -0.07242068243779014,
+    0.051182725116209915, -0.09575411075314348, 0.12911481660011878, -0.14143819512005507,
+    0.12911481660011878, -0.09575411075314348, 0.051182725116209915, -0.09575411075314348,
+    0.1279568127905248, -0.1060786463400413, 0.0408296900131293, 0.0408296900131293,
+    -0.1060786463400413, 0.1279568127905248, -0.09575411075314348, 0.12911481660011878,
+    -0.1060786463400413, 0.01861190004225815, 0.06881842847817146, -0.10445902991252017,
+    0.06881842847817146, 0.01861190004225815, -0.1060786463400413, 0.12911481660011878,
+    -0.14143819512005507, 0.0408296900131293, 0.06881842847817146, -0.10003896272713755,
+    0.045232086779460515, 0.045232086779460515, -0.10003896272713755, 0.06881842847817146,
+    0.0408296900131293, -0.14143819512005507, 0.12911481660011878, 0.0408296900131293,
+    -0.10445902991252017, 0.045232086779460515, 0.051182725116209915, -0.09535761169699032,
+    0.051182725116209915, 0.045232086779460515, -0.10445902991252017, 0.0408296900131293,
+    0.12911481660011878, -0.09575411075314348, -0.1060786463400413, 0.06881842847817146,
+    0.045232086779460515, -0.09535761169699032, 0.046529750105645376, 0.046529750105645376,
+    -0.09535761169699032, 0.045232086779460515, 0.06881842847817146, -0.1060786463400413,
+    -0.09575411075314348, 0.051182725116209915, 0.1279568127905248, 0.01861190004225815,
+    -0.10003896272713755, 0.051182725116209915, 0.046529750105645376, -0.09305950021129075,
+    0.046529750105645376, 0.051182725116209915, -0.10003896272713755, 0.01861190004225815,
+    0.1279568127905248, 0.051182725116209915, -0.09575411075314348, -0.1060786463400413,
+    0.06881842847817146, 0.045232086779460515, -0.09535761169699032, 0.046529750105645376,
+    0.046529750105645376, -0.09535761169699032, 0.045232086779460515, 0.06881842847817146,
+    -0.1060786463400413, -0.09575411075314348, 0.12911481660011878, 0.0408296900131293,
+    -0.10445902991252017, 0.045232086779460515, 0.051182725116209915, -0.09535761169699032,
+    0.051182725116209915, 0.045232086779460515, -0.10445902991252017, 0.0408296900131293,
+    0.12911481660011878, -0.14143819512005507, 0.0408296900131293, 0.06881842847817146,
+    -0.10003896272713755, 0.045232086779460515, 0.045232086779460515, -0.10003896272713755,
+    0.06881842847817146, 0.0408296900131293, -0.14143819512005507, 0.12911481660011878,
+    -0.1060786463400413, 0.01861190004225815, 0.06881842847817146, -0.10445902991252017,
+    0.06881842847817146, 0.01861190004225815, -0.1060786463400413, 0.12911481660011878,
+    -0.09575411075314348, 0.1279568127905248, -0.1060786463400413, 0.0408296900131293,
+    0.0408296900131293, -0.1060786463400413, 0.1279568127905248, -0.09575411075314348,
+    0.051182725116209915, -0.09575411075314348, 0.12911481660011878, -0.14143819512005507,
+    0.12911481660011878, -0.09575411075314348, 0.051182725116209915, 0.036627711739690504,
+    -0.07325542347938101, 0.10557230146166803, -0.12441815044835987, 0.12441815044835987,
+    -0.10557230146166803, 0.07325542347938101, -0.036627711739690504, -0.07325542347938101,
+    0.10988313521907152, -0.10750956949750906, 0.06583589693379592, 0.0,
+    -0.06583589693379592, 0.10750956949750906, -0.10988313521907152, 0.07325542347938101,
+    0.10557230146166803, -0.10750956949750906, 0.04789777689036451, 0.03162654189033221,
+    -0.08564508030762896, 0.08564508030762896, -0.03162654189033221, -0.04789777689036451,
+    0.10750956949750906, -0.10557230146166803, -0.12441815044835987, 0.06583589693379592,
+    0.03162654189033221, -0.08734300491772351, 0.06992891524445957, 0.0,
+    -0.06992891524445957, 0.08734300491772351, -0.03162654189033221, -0.06583589693379592,
+    0.12441815044835987, 0.12441815044835987, 0.0, -0.08564508030762896,
+    0.06992891524445957, 0.008452548863005501, -0.07454447412044773, 0.07454447412044773,
+    -0.008452548863005501, -0.06992891524445957, 0.08564508030762896, 0.0,
+    -0.12441815044835987, -0.10557230146166803, -0.06583589693379592, 0.08564508030762896,
+    0.0, -0.07454447412044773, 0.07043790719171251, 0.0,
+    -0.07043790719171251, 0.07454447412044773, 0.0, -0.08564508030762896,
+    0.06583589693379592, 0.10557230146166803, 0.07325542347938101, 0.10750956949750906,
+    -0.03162654189033221, -0.06992891524445957, 0.07454447412044773, 0.0,
+    -0.07043790719171251, 0.07043790719171251, 0.0, -0.07454447412044773,
+    0.06992891524445957, 0.03162654189033221, -0.10750956949750906, -0.07325542347938101,
+    -0.036627711739690504, -0.10988313521907152, -0.04789777689036451, 0.08734300491772351,
+    -0.008452548863005501, -0.07043790719171251, 0.07043790719171251, 0.0,
+    -0.07043790719171251, 0.07043790719171251, 0.008452548863005501, -0.08734300491772351,
+    0.04789777689036451, 0.10988313521907152, 0.036627711739690504, 0.07325542347938101,
+    0.10750956949750906, -0.03162654189033221, -0.06992891524445957, 0.07454447412044773,
+    0.0, -0.07043790719171251, 0.07043790719171251, 0.0,
+    -0.07454447412044773, 0.06992891524445957, 0.03162654189033221, -0.10750956949750906,
+    -0.07325542347938101, -0.10557230146166803, -0.06583589693379592, 0.08564508030762896,
+    0.0, -0.07454447412044773, 0.07043790719171251, 0.0,
+    -0.07043790719171251, 0.07454447412044773, 0.0, -0.08564508030762896,
+    0.06583589693379592, 0.10557230146166803, 0.12441815044835987, 0.0,
+    -0.08564508030762896, 0.06992891524445957, 0.008452548863005501, -0.07454447412044773,
+    0.07454447412044773, -0.008452548863005501, -0.06992891524445957, 0.08564508030762896,
+    0.0, -0.12441815044835987, -0.12441815044835987, 0.06583589693379592,
+    0.03162654189033221, -0.08734300491772351, 0.06992891524445957, 0.0,
+    -0.06992891524445957, 0.08734300491772351, -0.03162654189033221, -0.06583589693379592,
+    0.12441815044835987, 0.10557230146166803, -0.10750956949750906, 0.04789777689036451,
+    0.03162654189033221, -0.08564508030762896, 0.08564508030762896, -0.03162654189033221,
+    -0.04789777689036451, 0.10750956949750906, -0.10557230146166803, -0.07325542347938101,
+    0.10988313521907152, -0.10750956949750906, 0.06583589693379592, 0.0,
+    -0.06583589693379592, 0.10750956949750906, -0.10988313521907152, 0.07325542347938101,
+    0.036627711739690504, -0.07325542347938101, 0.10557230146166803, -0.12441815044835987,
+    0.12441815044835987, -0.10557230146166803, 0.07325542347938101, -0.036627711739690504,
+    0.02645674994617371, -0.05612324188528877, 0.08572966806188397, -0.1074678263122828,
+    0.11543896335436807, -0.1074678263122828, 0.08572966806188397, -0.05612324188528877,
+    0.02645674994617371, -0.05612324188528877, 0.092598624811608, -0.10246655193630476,
+    0.07937024983852113, -0.029806212171661055, -0.029806212171661055, 0.07937024983852113,
+    -0.10246655193630476, 0.092598624811608, -0.05612324188528877, 0.08572966806188397,
+    -0.10246655193630476, 0.06614187486543427, 0.0, -0.06028603244005229,
+    0.08430469899226617, -0.06028603244005229, 0.0, 0.06614187486543427,
+    -0.10246655193630476, 0.08572966806188397, -0.1074678263122828, 0.07937024983852113,
+    0.0, -0.06614187486543427, 0.0778289332164142, -0.03362594233395219,
+    -0.03362594233395219, 0.0778289332164142, -0.06614187486543427, 0.0,
+    0.07937024983852113, -0.1074678263122828, 0.11543896335436807, -0.029806212171661055,
+    -0.06028603244005229, 0.0778289332164142, -0.025439182640551644, -0.04458756536551671,
+    0.07576606905360043, -0.04458756536551671, -0.025439182640551644, 0.0778289332164142,
+    -0.06028603244005229, -0.029806212171661055, 0.11543896335436807, -0.1074678263122828,
+    -0.029806212171661055, 0.08430469899226617, -0.03362594233395219, -0.04458756536551671,
+    0.0742824133104108, -0.03507287480528919, -0.03507287480528919, 0.0742824133104108,
+    -0.04458756536551671, -0.03362594233395219, 0.08430469899226617, -0.029806212171661055,
+    -0.1074678263122828, 0.08572966806188397, 0.07937024983852113, -0.06028603244005229,
+    -0.03362594233395219, 0.07576606905360043, -0.03507287480528919, -0.03764999030801643,
+    0.07224011237680622, -0.03764999030801643, -0.03507287480528919, 0.07576606905360043,
+    -0.03362594233395219, -0.06028603244005229, 0.07937024983852113, 0.08572966806188397,
+    -0.05612324188528877, -0.10246655193630476, 0.0, 0.0778289332164142,
+    -0.04458756536551671, -0.03507287480528919, 0.07224011237680622, -0.0356148556967723,
+    -0.0356148556967723, 0.07224011237680622, -0.03507287480528919, -0.04458756536551671,
+    0.0778289332164142, 0.0, -0.10246655193630476, -0.05612324188528877,
+    0.02645674994617371, 0.092598624811608, 0.06614187486543427, -0.06614187486543427,
+    -0.025439182640551644, 0.0742824133104108, -0.03764999030801643, -0.0356148556967723,
+    0.0712297113935446, -0.0356148556967723, -0.03764999030801643, 0.0742824133104108,
+    -0.025439182640551644, -0.06614187486543427, 0.06614187486543427, 0.092598624811608,
+    0.02645674994617371, -0.05612324188528877, -0.10246655193630476, 0.0,
+    0.0778289332164142, -0.04458756536551671, -0.03507287480528919, 0.07224011237680622,
+    -0.0356148556967723, -0.0356148556967723, 0.07224011237680622, -0.03507287480528919,
+    -0.04458756536551671, 0.0778289332164142, 0.0, -0.10246655193630476,
+    -0.05612324188528877, 0.08572966806188397, 0.07937024983852113, -0.06028603244005229,
+    -0.03362594233395219, 0.07576606905360043, -0.03507287480528919, -0.03764999030801643,
+    0.07224011237680622, -0.03764999030801643, -0.03507287480528919, 0.07576606905360043,
+    -0.03362594233395219, -0.06028603244005229, 0.07937024983852113, 0.08572966806188397,
+    -0.1074678263122828, -0.029806212171661055, 0.08430469899226617, -0.03362594233395219,
+    -0.04458756536551671, 0.0742824133104108, -0.03507287480528919, -0.03507287480528919,
+    0.0742824133104108, -0.04458756536551671, -0.03362594233395219, 0.08430469899226617,
+    -0.029806212171661055, -0.1074678263122828, 0.11543896335436807, -0.029806212171661055,
+    -0.06028603244005229, 0.0778289332164142, -0.025439182640551644, -0.04458756536551671,
+    0.07576606905360043, -0.04458756536551671, -0.025439182640551644, 0.0778289332164142,
+    -0.06028603244005229, -0.029806212171661055, 0.11543896335436807, -0.1074678263122828,
+    0.07937024983852113, 0.0, -0.06614187486543427, 0.0778289332164142,
+    -0.03362594233395219, -0.03362594233395219, 0.0778289332164142, -0.06614187486543427,
+    0.0, 0.07937024983852113, -0.1074678263122828, 0.08572966806188397,
+    -0.10246655193630476, 0.06614187486543427, 0.0, -0.06028603244005229,
+    0.08430469899226617, -0.06028603244005229, 0.0, 0.06614187486543427,
+    -0.10246655193630476, 0.08572966806188397, -0.05612324188528877, 0.092598624811608,
+    -0.10246655193630476, 0.07937024983852113, -0.029806212171661055, -0.029806212171661055,
+    0.07937024983852113, -0.10246655193630476, 0.092598624811608, -0.05612324188528877,
+    0.02645674994617371, -0.05612324188528877, 0.08572966806188397, -0.1074678263122828,
+    0.11543896335436807, -0.1074678263122828, 0.08572966806188397, -0.05612324188528877,
+    0.02645674994617371, 0.019248154353244368, -0.04304018157526291, 0.06924301541391162,
+    -0.09159989940671116, 0.10443995424508518, -0.10443995424508518, 0.09159989940671116,
+    -0.06924301541391162, 0.04304018157526291, -0.019248154353244368, -0.04304018157526291,
+    0.07699261741297747, -0.09394899606030287, 0.08480502800787701, -0.050171331170259785,
+    0.0, 0.050171331170259785, -0.08480502800787701, 0.09394899606030287,
+    -0.07699261741297747, 0.04304018157526291, 0.06924301541391162, -0.09394899606030287,
+    0.07586037303925722, -0.02480623136379577, -0.033797067827589254, 0.0719888416593996,
+    -0.0719888416593996, 0.033797067827589254, 0.02480623136379577, -0.07586037303925722,
+    0.09394899606030287, -0.06924301541391162, -0.09159989940671116, 0.08480502800787701,
+    -0.02480623136379577, -0.04189304182764951, 0.07349565596342092, -0.05441844920067935,
+    0.0, 0.05441844920067935, -0.07349565596342092, 0.04189304182764951,
+    0.02480623136379577, -0.08480502800787701, 0.09159989940671116, 0.10443995424508518,
+    -0.050171331170259785, -0.033797067827589254, 0.07349565596342092, -0.04812038588311092,
+    -0.013480366662971442, 0.06204657845062042, -0.06204657845062042, 0.013480366662971442,
+    0.04812038588311092, -0.07349565596342092, 0.033797067827589254, 0.050171331170259785,
+    -0.10443995424508518, -0.10443995424508518, 0.0, 0.0719888416593996,
+    -0.05441844920067935, -0.013480366662971442, 0.06340568492833439, -0.05533826277992775,
+    0.0, 0.05533826277992775, -0.06340568492833439, 0.013480366662971442,
+    0.05441844920067935, -0.0719888416593996, 0.0, 0.10443995424508518,
+    0.09159989940671116, 0.050171331170259785, -0.0719888416593996, 0.0,
+    0.06204657845062042, -0.05533826277992775, -0.003962855308020899, 0.05742722925916745,
+    -0.05742722925916745, 0.003962855308020899, 0.05533826277992775, -0.06204657845062042,
+    0.0, 0.0719888416593996, -0.050171331170259785, -0.09159989940671116,
+    -0.06924301541391162, -0.08480502800787701, 0.033797067827589254, 0.05441844920067935,
+    -0.06204657845062042, 0.0, 0.05742722925916745, -0.055479974312292596,
+    0.0, 0.055479974312292596, -0.05742722925916745, 0.0,
+    0.06204657845062042, -0.05441844920067935, -0.033797067827589254, 0.08480502800787701,
+    0.06924301541391162, 0.04304018157526291, 0.09394899606030287, 0.02480623136379577,
+    -0.07349565596342092, 0.013480366662971442, 0.05533826277992775, -0.05742722925916745,
+    0.0, 0.055479974312292596, -0.055479974312292596, 0.0,
+    0.05742722925916745, -0.05533826277992775, -0.013480366662971442, 0.07349565596342092,
+    -0.02480623136379577, -0.09394899606030287, -0.04304018157526291, -0.019248154353244368,
+    -0.07699261741297747, -0.07586037303925722, 0.04189304182764951, 0.04812038588311092,
+    -0.06340568492833439, 0.003962855308020899, 0.055479974312292596, -0.055479974312292596,
+    0.0, 0.055479974312292596, -0.055479974312292596, -0.003962855308020899,
+    0.06340568492833439, -0.04812038588311092, -0.04189304182764951, 0.07586037303925722,
+    0.07699261741297747, 0.019248154353244368, 0.04304018157526291, 0.09394899606030287,
+    0.02480623136379577, -0.07349565596342092, 0.013480366662971442, 0.05533826277992775,
+    -0.05742722925916745, 0.0, 0.055479974312292596, -0.055479974312292596,
+    0.0, 0.05742722925916745, -0.05533826277992775, -0.013480366662971442,
+    0.07349565596342092, -0.02480623136379577, -0.09394899606030287, -0.04304018157526291,
+    -0.06924301541391162, -0.08480502800787701, 0.033797067827589254, 0.05441844920067935,
+    -0.06204657845062042, 0.0, 0.05742722925916745, -0.055479974312292596,
+    0.0, 0.055479974312292596, -0.05742722925916745, 0.0,
+    0.06204657845062042, -0.05441844920067935, -0.033797067827589254, 0.08480502800787701,
+    0.06924301541391162, 0.09159989940671116, 0.050171331170259785, -0.0719888416593996,
+    0.0, 0.06204657845062042, -0.05533826277992775, -0.003962855308020899,
+    0.05742722925916745, -0.05742722925916745, 0.003962855308020899, 0.05533826277992775,
+    -0.06204657845062042, 0.0, 0.0719888416593996, -0.050171331170259785,
+    -0.09159989940671116, -0.10443995424508518, 0.0, 0.0719888416593996,
+    -0.05441844920067935, -0.013480366662971442, 0.06340568492833439, -0.05533826277992775,
+    0.0, 0.05533826277992775, -0.06340568492833439, 0.013480366662971442,
+    0.05441844920067935, -0.0719888416593996, 0.0, 0.10443995424508518,
+    0.10443995424508518, -0.050171331170259785, -0.033797067827589254, 0.07349565596342092,
+    -0.04812038588311092, -0.013480366662971442, 0.06204657845062042, -0.06204657845062042,
+    0.013480366662971442, 0.04812038588311092, -0.07349565596342092, 0.033797067827589254,
+    0.050171331170259785, -0.10443995424508518, -0.09159989940671116, 0.08480502800787701,
+    -0.02480623136379577, -0.04189304182764951, 0.07349565596342092, -0.05441844920067935,
+    0.0, 0.05441844920067935, -0.07349565596342092, 0.04189304182764951,
+    0.02480623136379577, -0.08480502800787701, 0.09159989940671116, 0.06924301541391162,
+    -0.09394899606030287, 0.07586037303925722, -0.02480623136379577, -0.033797067827589254,
+    0.0719888416593996, -0.0719888416593996, 0.033797067827589254, 0.02480623136379577,
+    -0.07586037303925722, 0.09394899606030287, -0.06924301541391162, -0.04304018157526291,
+    0.07699261741297747, -0.09394899606030287, 0.08480502800787701, -0.050171331170259785,
+    0.0, 0.050171331170259785, -0.08480502800787701, 0.09394899606030287,
+    -0.07699261741297747, 0.04304018157526291, 0.019248154353244368, -0.04304018157526291,
+    0.06924301541391162, -0.09159989940671116, 0.10443995424508518, -0.10443995424508518,
+    0.09159989940671116, -0.06924301541391162, 0.04304018157526291, -0.019248154353244368,
+    0.014084201054019469, -0.03303037929414734, 0.0556844122765083, -0.07727756515750789,
+    0.09277095161439448, -0.09839845347550115, 0.09277095161439448, -0.07727756515750789,
+    0.0556844122765083, -0.03303037929414734, 0.014084201054019469, -0.03303037929414734,
+    0.0633789047430876, -0.08386964498510284, 0.0847211352923922, -0.06286446595773457,
+    0.02319273790359862, 0.02319273790359862, -0.06286446595773457, 0.0847211352923922,
+    -0.08386964498510284, 0.0633789047430876, -0.03303037929414734, 0.0556844122765083,
+    -0.08386964498510284, 0.07931629014632016, -0.042848251158211725, -0.009333263758353732,
+    0.053967901150019815, -0.07138574104403102, 0.053967901150019815, -0.009333263758353732,
+    -0.042848251158211725, 0.07931629014632016, -0.08386964498510284, 0.0556844122765083,
+    -0.07727756515750789, 0.0847211352923922, -0.042848251158211725, -0.018161206622288262,
+    0.06128213087410669, -0.0635353430452619, 0.02649508509090357, 0.02649508509090357,
+    -0.0635353430452619, 0.06128213087410669, -0.018161206622288262, -0.042848251158211725,
+    0.0847211352923922, -0.07727756515750789, 0.09277095161439448, -0.06286446595773457,
+    -0.009333263758353732, 0.06128213087410669, -0.059781546888732794, 0.01360074441523714,
+    0.04032776579596398, -0.0636141744884848, 0.04032776579596398, 0.01360074441523714,
+    -0.059781546888732794, 0.06128213087410669, -0.009333263758353732, -0.06286446595773457,
+    0.09277095161439448, -0.09839845347550115, 0.02319273790359862, 0.053967901150019815,
+    -0.0635353430452619, 0.01360074441523714, 0.0438332604010931, -0.06128239750305534,
+    0.027896660938361115, 0.027896660938361115, -0.06128239750305534, 0.0438332604010931,
+    0.01360074441523714, -0.0635353430452619, 0.053967901150019815, 0.02319273790359862,
+    -0.09839845347550115, 0.09277095161439448, 0.02319273790359862, -0.07138574104403102,
+    0.02649508509090357, 0.04032776579596398, -0.06128239750305534, 0.02391697918925597,
+    0.033388822149103825, -0.0599760188805225, 0.033388822149103825, 0.02391697918925597,
+    -0.06128239750305534, 0.04032776579596398, 0.02649508509090357, -0.07138574104403102,
+    0.02319273790359862, 0.09277095161439448, -0.07727756515750789, -0.06286446595773457,
+    0.053967901150019815, 0.02649508509090357, -0.0636141744884848, 0.027896660938361115,
+    0.033388822149103825, -0.05929099809041168, 0.028565958372935296, 0.028565958372935296,
+    -0.05929099809041168, 0.033388822149103825, 0.027896660938361115, -0.0636141744884848,
+    0.02649508509090357, 0.053967901150019815, -0.06286446595773457, -0.07727756515750789,
+    0.0556844122765083, 0.0847211352923922, -0.009333263758353732, -0.0635353430452619,
+    0.04032776579596398, 0.027896660938361115, -0.0599760188805225, 0.028565958372935296,
+    0.029912575613180666, -0.05822024152320929, 0.029912575613180666, 0.028565958372935296,
+    -0.0599760188805225, 0.027896660938361115, 0.04032776579596398, -0.0635353430452619,
+    -0.009333263758353732, 0.0847211352923922, 0.0556844122765083, -0.03303037929414734,
+    -0.08386964498510284, -0.042848251158211725, 0.06128213087410669, 0.01360074441523714,
+    -0.06128239750305534, 0.033388822149103825, 0.028565958372935296, -0.05822024152320929,
+    0.02884426934128136, 0.02884426934128136, -0.05822024152320929, 0.028565958372935296,
+    0.033388822149103825, -0.06128239750305534, 0.01360074441523714, 0.06128213087410669,
+    -0.042848251158211725, -0.08386964498510284, -0.03303037929414734, 0.014084201054019469,
+    0.0633789047430876, 0.07931629014632016, -0.018161206622288262, -0.059781546888732794,
+    0.0438332604010931, 0.02391697918925597, -0.05929099809041168, 0.029912575613180666,
+    0.02884426934128136, -0.05768853868256272, 0.02884426934128136, 0.029912575613180666,
+    -0.05929099809041168, 0.02391697918925597, 0.0438332604010931, -0.059781546888732794,
+    -0.018161206622288262, 0.07931629014632016, 0.0633789047430876, 0.014084201054019469,
+    -0.03303037929414734, -0.08386964498510284, -0.042848251158211725, 0.06128213087410669,
+    0.01360074441523714, -0.06128239750305534, 0.033388822149103825, 0.028565958372935296,
+    -0.05822024152320929, 0.02884426934128136, 0.02884426934128136, -0.05822024152320929,
+    0.028565958372935296, 0.033388822149103825, -0.06128239750305534, 0.01360074441523714,
+    0.06128213087410669, -0.042848251158211725, -0.08386964498510284, -0.03303037929414734,
+    0.0556844122765083, 0.0847211352923922, -0.009333263758353732, -0.0635353430452619,
+    0.04032776579596398, 0.027896660938361115, -0.0599760188805225, 0.028565958372935296,
+    0.029912575613180666, -0.05822024152320929, 0.029912575613180666, 0.028565958372935296,
+    -0.0599760188805225, 0.027896660938361115, 0.04032776579596398, -0.0635353430452619,
+    -0.009333263758353732, 0.0847211352923922, 0.0556844122765083, -0.07727756515750789,
+    -0.06286446595773457, 0.053967901150019815, 0.02649508509090357, -0.0636141744884848,
+    0.027896660938361115, 0.033388822149103825, -0.05929099809041168, 0.028565958372935296,
+    0.028565958372935296, -0.05929099809041168, 0.033388822149103825, 0.027896660938361115,
+    -0.0636141744884848, 0.02649508509090357, 0.053967901150019815, -0.06286446595773457,
+    -0.07727756515750789, 0.09277095161439448, 0.02319273790359862, -0.07138574104403102,
+    0.02649508509090357, 0.04032776579596398, -0.06128239750305534, 0.02391697918925597,
+    0.033388822149103825, -0.0599760188805225, 0.033388822149103825, 0.02391697918925597,
+    -0.06128239750305534, 0.04032776579596398, 0.02649508509090357, -0.07138574104403102,
+    0.02319273790359862, 0.09277095161439448, -0.09839845347550115, 0.02319273790359862,
+    0.053967901150019815, -0.0635353430452619, 0.01360074441523714, 0.0438332604010931,
+    -0.06128239750305534, 0.027896660938361115, 0.027896660938361115, -0.06128239750305534,
+    0.0438332604010931, 0.01360074441523714, -0.0635353430452619, 0.053967901150019815,
+    0.02319273790359862, -0.09839845347550115, 0.09277095161439448, -0.06286446595773457,
+    -0.009333263758353732, 0.06128213087410669, -0.059781546888732794, 0.01360074441523714,
+    0.04032776579596398, -0.0636141744884848, 0.04032776579596398, 0.01360074441523714,
+    -0.059781546888732794, 0.06128213087410669, -0.009333263758353732, -0.06286446595773457,
+    0.09277095161439448, -0.07727756515750789, 0.0847211352923922, -0.042848251158211725,
+    -0.018161206622288262, 0.06128213087410669, -0.0635353430452619, 0.02649508509090357,
+    0.02649508509090357, -0.0635353430452619, 0.06128213087410669, -0.018161206622288262,
+    -0.042848251158211725, 0.0847211352923922, -0.07727756515750789, 0.0556844122765083,
+    -0.08386964498510284, 0.07931629014632016, -0.042848251158211725, -0.009333263758353732,
+    0.053967901150019815, -0.07138574104403102, 0.053967901150019815, -0.009333263758353732,
+    -0.042848251158211725, 0.07931629014632016, -0.08386964498510284, 0.0556844122765083,
+    -0.03303037929414734, 0.0633789047430876, -0.08386964498510284, 0.0847211352923922,
+    -0.06286446595773457, 0.02319273790359862, 0.02319273790359862, -0.06286446595773457,
+    0.0847211352923922, -0.08386964498510284, 0.0633789047430876, -0.03303037929414734,
+    0.014084201054019469, -0.03303037929414734, 0.0556844122765083, -0.07727756515750789,
+    0.09277095161439448, -0.09839845347550115, 0.09277095161439448, -0.07727756515750789,
+    0.0556844122765083, -0.03303037929414734, 0.014084201054019469, 0.010353958773579627,
+    -0.02536191581308319, 0.04461995085008539, -0.0646604518165043, 0.08124984886574907,
+    -0.09063800094387633, 0.09063800094387633, -0.08124984886574907, 0.0646604518165043,
+    -0.04461995085008539, 0.02536191581308319, -0.010353958773579627, -0.02536191581308319,
+    0.05176979386789814, -0.07342242818523824, 0.08105616599464421, -0.06957821371079587,
+    0.0401710004156613, 0.0, -0.0401710004156613, 0.06957821371079587,
+    -0.08105616599464421, 0.07342242818523824, -0.05176979386789814, 0.02536191581308319,
+    0.04461995085008539, -0.07342242818523824, 0.07839425928567433, -0.054847866708622926,
+    0.011477428690188944, 0.033950691917997156, -0.06260198269876582, 0.06260198269876582,
+    -0.033950691917997156, -0.011477428690188944, 0.054847866708622926, -0.07839425928567433,
+    0.07342242818523824, -0.04461995085008539, -0.0646604518165043, 0.08105616599464421,
+    -0.054847866708622926, 0.0029582739353084648, 0.04483491976341964, -0.06325614866282217,
+    0.04426628648202024, 0.0, -0.04426628648202024, 0.06325614866282217,
+    -0.04483491976341964, -0.0029582739353084648, 0.054847866708622926, -0.08105616599464421,
+    0.0646604518165043, 0.08124984886574907, -0.06957821371079587, 0.011477428690188944,
+    0.04483491976341964, -0.0620459033273907, 0.03394087248412062, 0.016284840993022895,
+    -0.05373723365131875, 0.05373723365131875, -0.016284840993022895, -0.03394087248412062,
+    0.0620459033273907, -0.04483491976341964, -0.011477428690188944, 0.06957821371079587,
+    -0.08124984886574907, -0.09063800094387633, 0.0401710004156613, 0.033950691917997156,
+    -0.06325614866282217, 0.03394087248412062, 0.020941465489420448, -0.05570476104834648,
+    0.04541625165775246, 0.0, -0.04541625165775246, 0.05570476104834648,
+    -0.020941465489420448, -0.03394087248412062, 0.06325614866282217, -0.033950691917997156,
+    -0.0401710004156613, 0.09063800094387633, 0.09063800094387633, 0.0,
+    -0.06260198269876582, 0.04426628648202024, 0.016284840993022895, -0.05570476104834648,
+    0.04242787617745035, 0.007099242818288509, -0.04926084132261772, 0.04926084132261772,
+    -0.007099242818288509, -0.04242787617745035, 0.05570476104834648, -0.016284840993022895,
+    -0.04426628648202024, 0.06260198269876582, 0.0, -0.09063800094387633,
+    -0.08124984886574907, -0.0401710004156613, 0.06260198269876582, 0.0,
+    -0.05373723365131875, 0.04541625165775246, 0.007099242818288509, -0.05013495827206978,
+    0.04572346768555488, 0.0, -0.04572346768555488, 0.05013495827206978,
+    -0.007099242818288509, -0.04541625165775246, 0.05373723365131875, 0.0,
+    -0.06260198269876582, 0.0401710004156613, 0.08124984886574907, 0.0646604518165043,
+    0.06957821371079587, -0.033950691917997156, -0.04426628648202024, 0.05373723365131875,
+    0.0, -0.04926084132261772, 0.04572346768555488, 0.0021797807944378164,
+    -0.04685261222228255, 0.04685261222228255, -0.0021797807944378164, -0.04572346768555488,
+    0.04926084132261772, 0.0, -0.05373723365131875, 0.04426628648202024,
+    0.033950691917997156, -0.06957821371079587, -0.0646604518165043, -0.04461995085008539,
+    -0.08105616599464421, -0.011477428690188944, 0.06325614866282217, -0.016284840993022895,
+    -0.04541625165775246, 0.04926084132261772, 0.0, -0.04685261222228255,
+    0.04577539668319414, 0.0, -0.04577539668319414, 0.04685261222228255,
+    0.0, -0.04926084132261772, 0.04541625165775246, 0.016284840993022895,
+    -0.06325614866282217, 0.011477428690188944, 0.08105616599464421, 0.04461995085008539,
+    0.02536191581308319, 0.07342242818523824, 0.054847866708622926, -0.04483491976341964,
+    -0.03394087248412062, 0.05570476104834648, -0.007099242818288509, -0.04572346768555488,
+    0.04685261222228255, 0.0, -0.04577539668319414, 0.04577539668319414,
+    0.0, -0.04685261222228255, 0.04572346768555488, 0.007099242818288509,
+    -0.05570476104834648, 0.03394087248412062, 0.04483491976341964, -0.054847866708622926,
+    -0.07342242818523824, -0.02536191581308319, -0.010353958773579627, -0.05176979386789814,
+    -0.07839425928567433, -0.0029582739353084648, 0.0620459033273907, -0.020941465489420448,
+    -0.04242787617745035, 0.05013495827206978, -0.0021797807944378164, -0.04577539668319414,
+    0.04577539668319414, 0.0, -0.04577539668319414, 0.04577539668319414,
+    0.0021797807944378164, -0.05013495827206978, 0.04242787617745035, 0.020941465489420448,
+    -0.0620459033273907, 0.0029582739353084648, 0.07839425928567433, 0.05176979386789814,
+    0.010353958773579627, 0.02536191581308319, 0.07342242818523824, 0.054847866708622926,
+    -0.04483491976341964, -0.03394087248412062, 0.05570476104834648, -0.007099242818288509,
+    -0.04572346768555488, 0.04685261222228255, 0.0, -0.04577539668319414,
+    0.04577539668319414, 0.0, -0.04685261222228255, 0.04572346768555488,
+    0.007099242818288509, -0.05570476104834648, 0.03394087248412062, 0.04483491976341964,
+    -0.054847866708622926, -0.07342242818523824, -0.02536191581308319, -0.04461995085008539,
+    -0.08105616599464421, -0.011477428690188944, 0.06325614866282217, -0.016284840993022895,
+    -0.04541625165775246, 0.04926084132261772, 0.0, -0.04685261222228255,
+    0.04577539668319414, 0.0, -0.04577539668319414, 0.04685261222228255,
+    0.0, -0.04926084132261772, 0.04541625165775246, 0.016284840993022895,
+    -0.06325614866282217, 0.011477428690188944, 0.08105616599464421, 0.04461995085008539,
+    0.0646604518165043, 0.06957821371079587, -0.033950691917997156, -0.04426628648202024,
+    0.05373723365131875, 0.0, -0.04926084132261772, 0.04572346768555488,
+    0.0021797807944378164, -0.04685261222228255, 0.04685261222228255, -0.0021797807944378164,
+    -0.04572346768555488, 0.04926084132261772, 0.0, -0.05373723365131875,
+    0.04426628648202024, 0.033950691917997156, -0.06957821371079587, -0.0646604518165043,
+    -0.08124984886574907, -0.0401710004156613, 0.06260198269876582, 0.0,
+    -0.05373723365131875, 0.04541625165775246, 0.007099242818288509, -0.05013495827206978,
+    0.04572346768555488, 0.0, -0.04572346768555488, 0.05013495827206978,
+    -0.007099242818288509, -0.04541625165775246, 0.05373723365131875, 0.0,
+    -0.06260198269876582, 0.0401710004156613, 0.08124984886574907, 0.09063800094387633,
+    0.0, -0.06260198269876582, 0.04426628648202024, 0.016284840993022895,
+    -0.05570476104834648, 0.04242787617745035, 0.007099242818288509, -0.04926084132261772,
+    0.04926084132261772, -0.007099242818288509, -0.04242787617745035, 0.05570476104834648,
+    -0.016284840993022895, -0.04426628648202024, 0.06260198269876582, 0.0,
+    -0.09063800094387633, -0.09063800094387633, 0.0401710004156613, 0.033950691917997156,
+    -0.06325614866282217, 0.03394087248412062, 0.020941465489420448, -0.05570476104834648,
+    0.04541625165775246, 0.0, -0.04541625165775246, 0.05570476104834648,
+    -0.020941465489420448, -0.03394087248412062, 0.06325614866282217, -0.033950691917997156,
+    -0.0401710004156613, 0.09063800094387633, 0.08124984886574907, -0.06957821371079587,
+    0.011477428690188944, 0.04483491976341964, -0.0620459033273907, 0.03394087248412062,
+    0.016284840993022895, -0.05373723365131875, 0.05373723365131875, -0.016284840993022895,
+    -0.03394087248412062, 0.0620459033273907, -0.04483491976341964, -0.011477428690188944,
+    0.06957821371079587, -0.08124984886574907, -0.0646604518165043, 0.08105616599464421,
+    -0.054847866708622926, 0.0029582739353084648, 0.04483491976341964, -0.06325614866282217,
+    0.04426628648202024, 0.0, -0.04426628648202024, 0.06325614866282217,
+    -0.04483491976341964, -0.0029582739353084648, 0.054847866708622926, -0.08105616599464421,
+    0.0646604518165043, 0.04461995085008539, -0.07342242818523824, 0.07839425928567433,
+    -0.054847866708622926, 0.011477428690188944, 0.033950691917997156, -0.06260198269876582,
+    0.06260198269876582, -0.033950691917997156, -0.011477428690188944, 0.054847866708622926,
+    -0.07839425928567433, 0.07342242818523824, -0.04461995085008539, -0.02536191581308319,
+    0.05176979386789814, -0.07342242818523824, 0.08105616599464421, -0.06957821371079587,
+    0.0401710004156613, 0.0, -0.0401710004156613, 0.06957821371079587,
+    -0.08105616599464421, 0.07342242818523824, -0.05176979386789814, 0.02536191581308319,
+    0.010353958773579627, -0.02536191581308319, 0.04461995085008539, -0.0646604518165043,
+    0.08124984886574907, -0.09063800094387633, 0.09063800094387633, -0.08124984886574907,
+    0.0646604518165043, -0.04461995085008539, 0.02536191581308319, -0.010353958773579627,
+    0.007641326409130185, -0.019481636234943346, 0.0356456775720244, -0.05373788086563255,
+    0.07035940192950862, -0.08205245760021009, 0.08626297667839215, -0.08205245760021009,
+    0.07035940192950862, -0.05373788086563255, 0.0356456775720244, -0.019481636234943346,
+    0.007641326409130185, -0.019481636234943346, 0.042027295250216014, -0.06332346173655777,
+    0.07523303321188557, -0.07181026388945431, 0.0517033900004071, -0.01882412477623535,
+    -0.01882412477623535, 0.0517033900004071, -0.07181026388945431, 0.07523303321188557,
+    -0.06332346173655777, 0.042027295250216014, -0.019481636234943346, 0.0356456775720244,
+    -0.06332346173655777, 0.07458599038477072, -0.06180400475030353, 0.02800960520681357,
+    0.0143994702606103, -0.04902681079973495, 0.06230905222287632, -0.04902681079973495,
+    0.0143994702606103, 0.02800960520681357, -0.06180400475030353, 0.07458599038477072,
+    -0.06332346173655777, 0.0356456775720244, -0.05373788086563255, 0.07523303321188557,
+    -0.06180400475030353, 0.020432242354848102, 0.02693894213312211, -0.056185458863912296,
+    0.0534927873541926, -0.02170319453598171, -0.02170319453598171, 0.0534927873541926,
+    -0.056185458863912296, 0.02693894213312211, 0.020432242354848102, -0.06180400475030353,
+    0.07523303321188557, -0.05373788086563255, 0.07035940192950862, -0.07181026388945431,
+    0.02800960520681357, 0.02693894213312211, -0.057143832276973554, 0.046682675344689284,
+    -0.006028665148883808, -0.03709886503034876, 0.055231071662635446, -0.03709886503034876,
+    -0.006028665148883808, 0.046682675344689284, -0.057143832276973554, 0.02693894213312211,
+    0.02800960520681357, -0.07181026388945431, 0.07035940192950862, -0.08205245760021009,
+    0.0517033900004071, 0.0143994702606103, -0.056185458863912296, 0.046682675344689284,
+    -0.0011628105405198108, -0.04236208106508133, 0.05220380452638073, -0.023012946526098102,
+    -0.023012946526098102, 0.05220380452638073, -0.04236208106508133, -0.0011628105405198108,
+    0.046682675344689284, -0.056185458863912296, 0.0143994702606103, 0.0517033900004071,
+    -0.08205245760021009, 0.08626297667839215, -0.01882412477623535, -0.04902681079973495,
+    0.0534927873541926, -0.006028665148883808, -0.04236208106508133, 0.0507177740267325,
+    -0.016139152732150042, -0.03062128569169099, 0.05172863807767612, -0.03062128569169099,
+    -0.016139152732150042, 0.0507177740267325, -0.04236208106508133, -0.006028665148883808,
+    0.0534927873541926, -0.04902681079973495, -0.01882412477623535, 0.08626297667839215,
+    -0.08205245760021009, -0.01882412477623535, 0.06230905222287632, -0.02170319453598171,
+    -0.03709886503034876, 0.05220380452638073, -0.016139152732150042, -0.032759782671637074,
+    0.05062047373912593, -0.023705039958792577, -0.023705039958792577, 0.05062047373912593,
+    -0.032759782671637074, -0.016139152732150042, 0.05220380452638073, -0.03709886503034876,
+    -0.02170319453598171, 0.06230905222287632, -0.01882412477623535, -0.08205245760021009,
+    0.07035940192950862, 0.0517033900004071, -0.04902681079973495, -0.02170319453598171,
+    0.055231071662635446, -0.023012946526098102, -0.03062128569169099, 0.05062047373912593,
+    -0.02145516591304974, -0.02686301318080366, 0.0497905430180781, -0.02686301318080366,
+    -0.02145516591304974, 0.05062047373912593, -0.03062128569169099, -0.023012946526098102,
+    0.055231071662635446, -0.02170319453598171, -0.04902681079973495, 0.0517033900004071,
+    0.07035940192950862, -0.05373788086563255, -0.07181026388945431, 0.0143994702606103,
+    0.0534927873541926, -0.03709886503034876, -0.023012946526098102, 0.05172863807767612,
+    -0.023705039958792577, -0.02686301318080366, 0.04941507650389451, -0.02407341777315654,
+    -0.02407341777315654, 0.04941507650389451, -0.02686301318080366, -0.023705039958792577,
+    0.05172863807767612, -0.023012946526098102, -0.03709886503034876, 0.0534927873541926,
+    0.0143994702606103, -0.07181026388945431, -0.05373788086563255, 0.0356456775720244,
+    0.07523303321188557, 0.02800960520681357, -0.056185458863912296, -0.006028665148883808,
+    0.05220380452638073, -0.03062128569169099, -0.023705039958792577, 0.0497905430180781,
+    -0.02407341777315654, -0.0248649111070552, 0.04878456976415475, -0.0248649111070552,
+    -0.02407341777315654, 0.0497905430180781, -0.023705039958792577, -0.03062128569169099,
+    0.05220380452638073, -0.006028665148883808, -0.056185458863912296, 0.02800960520681357,
+    0.07523303321188557, 0.0356456775720244, -0.019481636234943346, -0.06332346173655777,
+    -0.06180400475030353, 0.02693894213312211, 0.046682675344689284, -0.04236208106508133,
+    -0.016139152732150042, 0.05062047373912593, -0.02686301318080366, -0.02407341777315654,
+    0.04878456976415475, -0.024235419686623422, -0.024235419686623422, 0.04878456976415475,
+    -0.02407341777315654, -0.02686301318080366, 0.05062047373912593, -0.016139152732150042,
+    -0.04236208106508133, 0.046682675344689284, 0.02693894213312211, -0.06180400475030353,
+    -0.06332346173655777, -0.019481636234943346, 0.007641326409130185, 0.042027295250216014,
+    0.07458599038477072, 0.020432242354848102, -0.057143832276973554, -0.0011628105405198108,
+    0.0507177740267325, -0.032759782671637074, -0.02145516591304974, 0.04941507650389451,
+    -0.0248649111070552, -0.024235419686623422, 0.048470839373246845, -0.024235419686623422,
+    -0.0248649111070552, 0.04941507650389451, -0.02145516591304974, -0.032759782671637074,
+    0.0507177740267325, -0.0011628105405198108, -0.057143832276973554, 0.020432242354848102,
+    0.07458599038477072, 0.042027295250216014, 0.007641326409130185, -0.019481636234943346,
+    -0.06332346173655777, -0.06180400475030353, 0.02693894213312211, 0.046682675344689284,
+    -0.04236208106508133, -0.016139152732150042, 0.05062047373912593, -0.02686301318080366,
+    -0.02407341777315654, 0.04878456976415475, -0.024235419686623422, -0.024235419686623422,
+    0.04878456976415475, -0.02407341777315654, -0.02686301318080366, 0.05062047373912593,
+    -0.016139152732150042, -0.04236208106508133, 0.046682675344689284, 0.02693894213312211,
+    -0.06180400475030353, -0.06332346173655777, -0.019481636234943346, 0.0356456775720244,
+    0.07523303321188557, 0.02800960520681357, -0.056185458863912296, -0.006028665148883808,
+    0.05220380452638073, -0.03062128569169099, -0.023705039958792577, 0.0497905430180781,
+    -0.02407341777315654, -0.0248649111070552, 0.04878456976415475, -0.0248649111070552,
+    -0.02407341777315654, 0.0497905430180781, -0.023705039958792577, -0.03062128569169099,
+    0.05220380452638073, -0.006028665148883808, -0.056185458863912296, 0.02800960520681357,
+    0.07523303321188557, 0.0356456775720244, -0.05373788086563255, -0.07181026388945431,
+    0.0143994702606103, 0.0534927873541926, -0.03709886503034876, -0.023012946526098102,
+    0.05172863807767612, -0.023705039958792577, -0.02686301318080366, 0.04941507650389451,
+    -0.02407341777315654, -0.02407341777315654, 0.04941507650389451, -0.02686301318080366,
+    -0.023705039958792577, 0.05172863807767612, -0.023012946526098102, -0.03709886503034876,
+    0.0534927873541926, 0.0143994702606103, -0.07181026388945431, -0.05373788086563255,
+    0.07035940192950862, 0.0517033900004071, -0.04902681079973495, -0.02170319453598171,
+    0.055231071662635446, -0.023012946526098102, -0.03062128569169099, 0.05062047373912593,
+    -0.02145516591304974, -0.02686301318080366, 0.0497905430180781, -0.02686301318080366,
+    -0.02145516591304974, 0.05062047373912593, -0.03062128569169099, -0.023012946526098102,
+    0.055231071662635446, -0.02170319453598171, -0.04902681079973495, 0.0517033900004071,
+    0.07035940192950862, -0.08205245760021009, -0.01882412477623535, 0.06230905222287632,
+    -0.02170319453598171, -0.03709886503034876, 0.05220380452638073, -0.016139152732150042,
+    -0.032759782671637074, 0.05062047373912593, -0.023705039958792577, -0.023705039958792577,
+    0.05062047373912593, -0.032759782671637074, -0.016139152732150042, 0.05220380452638073,
+    -0.03709886503034876, -0.02170319453598171, 0.06230905222287632, -0.01882412477623535,
+    -0.08205245760021009, 0.08626297667839215, -0.01882412477623535, -0.04902681079973495,
+    0.0534927873541926, -0.006028665148883808, -0.04236208106508133, 0.0507177740267325,
+    -0.016139152732150042, -0.03062128569169099, 0.05172863807767612, -0.03062128569169099,
+    -0.016139152732150042, 0.0507177740267325, -0.04236208106508133, -0.006028665148883808,
+    0.0534927873541926, -0.04902681079973495, -0.01882412477623535, 0.08626297667839215,
+    -0.08205245760021009, 0.0517033900004071, 0.0143994702606103, -0.056185458863912296,
+    0.046682675344689284, -0.0011628105405198108, -0.04236208106508133, 0.05220380452638073,
+    -0.023012946526098102, -0.023012946526098102, 0.05220380452638073, -0.04236208106508133,
+    -0.0011628105405198108, 0.046682675344689284, -0.056185458863912296, 0.0143994702606103,
+    0.0517033900004071, -0.08205245760021009, 0.07035940192950862, -0.07181026388945431,
+    0.02800960520681357, 0.02693894213312211, -0.057143832276973554, 0.046682675344689284,
+    -0.006028665148883808, -0.03709886503034876, 0.055231071662635446, -0.03709886503034876,
+    -0.006028665148883808, 0.046682675344689284, -0.057143832276973554, 0.02693894213312211,
+    0.02800960520681357, -0.07181026388945431, 0.07035940192950862, -0.05373788086563255,
+    0.07523303321188557, -0.06180400475030353, 0.020432242354848102, 0.02693894213312211,
+    -0.056185458863912296, 0.0534927873541926, -0.02170319453598171, -0.02170319453598171,
+    0.0534927873541926, -0.056185458863912296, 0.02693894213312211, 0.020432242354848102,
+    -0.06180400475030353, 0.07523303321188557, -0.05373788086563255, 0.0356456775720244,
+    -0.06332346173655777, 0.07458599038477072, -0.06180400475030353, 0.02800960520681357,
+    0.0143994702606103, -0.04902681079973495, 0.06230905222287632, -0.04902681079973495,
+    0.0143994702606103, 0.02800960520681357, -0.06180400475030353, 0.07458599038477072,
+    -0.06332346173655777, 0.0356456775720244, -0.019481636234943346, 0.042027295250216014,
+    -0.06332346173655777, 0.07523303321188557, -0.07181026388945431, 0.0517033900004071,
+    -0.01882412477623535, -0.01882412477623535, 0.0517033900004071, -0.07181026388945431,
+    0.07523303321188557, -0.06332346173655777, 0.042027295250216014, -0.019481636234943346,
+    0.007641326409130185, -0.019481636234943346, 0.0356456775720244, -0.05373788086563255,
+    0.07035940192950862, -0.08205245760021009, 0.08626297667839215, -0.08205245760021009,
+    0.07035940192950862, -0.05373788086563255, 0.0356456775720244, -0.019481636234943346,
+    0.007641326409130185, 0.0056579139037989746, -0.014969433128866713, 0.028402502381279792,
+    -0.044406514929192405, 0.060363892585845014, -0.07325519054242073, 0.08045905431571458,
+    -0.08045905431571458, 0.07325519054242073, -0.060363892585845014, 0.044406514929192405,
+    -0.028402502381279792, 0.014969433128866713, -0.0056579139037989746, -0.014969433128866713,
+    0.03394748342279385, -0.053973058710758276, 0.0682711191247949, -0.07082078000048107,
+    0.058694521265462804, -0.033276665697944297, 0.0, 0.033276665697944297,
+    -0.058694521265462804, 0.07082078000048107, -0.0682711191247949, 0.053973058710758276,
+    -0.03394748342279385, 0.014969433128866713, 0.028402502381279792, -0.053973058710758276,
+    0.0690265496263475, -0.06476767045290993, 0.04026410941057507, -0.003183157342390924,
+    -0.033276665697944297, 0.05568251201161527, -0.05568251201161527, 0.033276665697944297,
+    0.003183157342390924, -0.04026410941057507, 0.06476767045290993, -0.0690265496263475,
+    0.053973058710758276, -0.028402502381279792, -0.044406514929192405, 0.0682711191247949,
+    -0.06476767045290993, 0.03394748342279385, 0.009549472027172773, -0.04479099409424417,
+    0.05534353782142295, -0.03712167467441018, 0.0, 0.03712167467441018,
+    -0.05534353782142295, 0.04479099409424417, -0.009549472027172773, -0.03394748342279385,
+    0.06476767045290993, -0.0682711191247949, 0.044406514929192405, 0.060363892585845014,
+    -0.07082078000048107, 0.04026410941057507, 0.009549472027172773, -0.047378879037899245,
+    0.05220977169843273, -0.02412901029070312, -0.017809857162989974, 0.047715056307592374,
+    -0.047715056307592374, 0.017809857162989974, 0.02412901029070312, -0.05220977169843273,
+    0.047378879037899245, -0.009549472027172773, -0.04026410941057507, 0.07082078000048107,
+    -0.060363892585845014, -0.07325519054242073, 0.058694521265462804, -0.003183157342390924,
+    -0.04479099409424417, 0.05220977169843273, -0.01977809903762772, -0.025012049701003517,
+    0.0497490802029598, -0.03838197538275717, 0.0, 0.03838197538275717,
+    -0.0497490802029598, 0.025012049701003517, 0.01977809903762772, -0.05220977169843273,
+    0.04479099409424417, 0.003183157342390924, -0.058694521265462804, 0.07325519054242073,
+    0.08045905431571458, -0.033276665697944297, -0.033276665697944297, 0.05534353782142295,
+    -0.02412901029070312, -0.025012049701003517, 0.04983884160476836, -0.033096508611813985,
+    -0.00927872315042477, 0.043521069295790846, -0.043521069295790846, 0.00927872315042477,
+    0.033096508611813985, -0.04983884160476836, 0.025012049701003517, 0.02412901029070312,
+    -0.05534353782142295, 0.033276665697944297, 0.033276665697944297, -0.08045905431571458,
+    -0.08045905431571458, 0.0, 0.05568251201161527, -0.03712167467441018,
+    -0.017809857162989974, 0.0497490802029598, -0.033096508611813985, -0.012103015828996068,
+    0.04500685555710979, -0.03881568378618365, 0.0, 0.03881568378618365,
+    -0.04500685555710979, 0.012103015828996068, 0.033096508611813985, -0.0497490802029598,
+    0.017809857162989974, 0.03712167467441018, -0.05568251201161527, 0.0,
+    0.08045905431571458, 0.07325519054242073, 0.033276665697944297, -0.05568251201161527,
+    0.0, 0.047715056307592374, -0.03838197538275717, -0.00927872315042477,
+    0.04500685555710979, -0.037145434759723706, -0.004223978507798474, 0.04104969247305556,
+    -0.04104969247305556, 0.004223978507798474, 0.037145434759723706, -0.04500685555710979,
+    0.00927872315042477, 0.03838197538275717, -0.047715056307592374, 0.0,
+    0.05568251201161527, -0.033276665697944297, -0.07325519054242073, -0.060363892585845014,
+    -0.058694521265462804, 0.033276665697944297, 0.03712167467441018, -0.047715056307592374,
+    0.0, 0.043521069295790846, -0.03881568378618365, -0.004223978507798474,
+    0.0416225666314255, -0.0389431576392977, 0.0, 0.0389431576392977,
+    -0.0416225666314255, 0.004223978507798474, 0.03881568378618365, -0.043521069295790846,
+    0.0, 0.047715056307592374, -0.03712167467441018, -0.033276665697944297,
+    0.058694521265462804, 0.060363892585845014, 0.044406514929192405, 0.07082078000048107,
+    0.003183157342390924, -0.05534353782142295, 0.017809857162989974, 0.03838197538275717,
+    -0.043521069295790846, 0.0, 0.04104969247305556, -0.0389431576392977,
+    -0.0013283797861093245, 0.03962443072426683, -0.03962443072426683, 0.0013283797861093245,
+    0.0389431576392977, -0.04104969247305556, 0.0, 0.043521069295790846,
+    -0.03838197538275717, -0.017809857162989974, 0.05534353782142295, -0.003183157342390924,
+    -0.07082078000048107, -0.044406514929192405, -0.028402502381279792, -0.0682711191247949,
+    -0.04026410941057507, 0.04479099409424417, 0.02412901029070312, -0.0497490802029598,
+    0.00927872315042477, 0.03881568378618365, -0.04104969247305556, 0.0,
+    0.03962443072426683, -0.03896580705920685, 0.0, 0.03896580705920685,
+    -0.03962443072426683, 0.0, 0.04104969247305556, -0.03881568378618365,
+    -0.00927872315042477, 0.0497490802029598, -0.02412901029070312, -0.04479099409424417,
+    0.04026410941057507, 0.0682711191247949, 0.028402502381279792, 0.014969433128866713,
+    0.053973058710758276, 0.06476767045290993, -0.009549472027172773, -0.05220977169843273,
+    0.025012049701003517, 0.033096508611813985, -0.04500685555710979, 0.004223978507798474,
+    0.0389431576392977, -0.03962443072426683, 0.0, 0.03896580705920685,
+    -0.03896580705920685, 0.0, 0.03962443072426683, -0.0389431576392977,
+    -0.004223978507798474, 0.04500685555710979, -0.033096508611813985, -0.025012049701003517,
+    0.05220977169843273, 0.009549472027172773, -0.06476767045290993, -0.053973058710758276,
+    -0.014969433128866713, -0.0056579139037989746, -0.03394748342279385, -0.0690265496263475,
+    -0.03394748342279385, 0.047378879037899245, 0.01977809903762772, -0.04983884160476836,
+    0.012103015828996068, 0.037145434759723706, -0.0416225666314255, 0.0013283797861093245,
+    0.03896580705920685, -0.03896580705920685, 0.0, 0.03896580705920685,
+    -0.03896580705920685, -0.0013283797861093245, 0.0416225666314255, -0.037145434759723706,
+    -0.012103015828996068, 0.04983884160476836, -0.01977809903762772, -0.047378879037899245,
+    0.03394748342279385, 0.0690265496263475, 0.03394748342279385, 0.0056579139037989746,
+    0.014969433128866713, 0.053973058710758276, 0.06476767045290993, -0.009549472027172773,
+    -0.05220977169843273, 0.025012049701003517, 0.033096508611813985, -0.04500685555710979,
+    0.004223978507798474, 0.0389431576392977, -0.03962443072426683, 0.0,
+    0.03896580705920685, -0.03896580705920685, 0.0, 0.03962443072426683,
+    -0.0389431576392977, -0.004223978507798474, 0.04500685555710979, -0.033096508611813985,
+    -0.025012049701003517, 0.05220977169843273, 0.009549472027172773, -0.06476767045290993,
+    -0.053973058710758276, -0.014969433128866713, -0.028402502381279792, -0.0682711191247949,
+    -0.04026410941057507, 0.04479099409424417, 0.02412901029070312, -0.0497490802029598,
+    0.00927872315042477, 0.03881568378618365, -0.04104969247305556, 0.0,
+    0.03962443072426683, -0.03896580705920685, 0.0, 0.03896580705920685,
+    -0.03962443072426683, 0.0, 0.04104969247305556, -0.03881568378618365,
+    -0.00927872315042477, 0.0497490802029598, -0.02412901029070312, -0.04479099409424417,
+    0.04026410941057507, 0.0682711191247949, 0.028402502381279792, 0.044406514929192405,
+    0.07082078000048107, 0.003183157342390924, -0.05534353782142295, 0.017809857162989974,
+    0.03838197538275717, -0.043521069295790846, 0.0, 0.04104969247305556,
+    -0.0389431576392977, -0.0013283797861093245, 0.03962443072426683, -0.03962443072426683,
+    0.0013283797861093245, 0.0389431576392977, -0.04104969247305556, 0.0,
+    0.043521069295790846, -0.03838197538275717, -0.017809857162989974, 0.05534353782142295,
+    -0.003183157342390924, -0.07082078000048107, -0.044406514929192405, -0.060363892585845014,
+    -0.058694521265462804, 0.033276665697944297, 0.03712167467441018, -0.047715056307592374,
+    0.0, 0.043521069295790846, -0.03881568378618365, -0.004223978507798474,
+    0.0416225666314255, -0.0389431576392977, 0.0, 0.0389431576392977,
+    -0.0416225666314255, 0.004223978507798474, 0.03881568378618365, -0.043521069295790846,
+    0.0, 0.047715056307592374, -0.03712167467441018, -0.033276665697944297,
+    0.058694521265462804, 0.060363892585845014, 0.07325519054242073, 0.033276665697944297,
+    -0.05568251201161527, 0.0, 0.047715056307592374, -0.03838197538275717,
+    -0.00927872315042477, 0.04500685555710979, -0.037145434759723706, -0.004223978507798474,
+    0.04104969247305556, -0.04104969247305556, 0.004223978507798474, 0.037145434759723706,
+    -0.04500685555710979, 0.00927872315042477, 0.03838197538275717, -0.047715056307592374,
+    0.0, 0.05568251201161527, -0.033276665697944297, -0.07325519054242073,
+    -0.08045905431571458, 0.0, 0.05568251201161527, -0.03712167467441018,
+    -0.017809857162989974, 0.0497490802029598, -0.033096508611813985, -0.012103015828996068,
+    0.04500685555710979, -0.03881568378618365, 0.0, 0.03881568378618365,
+    -0.04500685555710979, 0.012103015828996068, 0.033096508611813985, -0.0497490802029598,
+    0.017809857162989974, 0.03712167467441018, -0.05568251201161527, 0.0,
+    0.08045905431571458, 0.08045905431571458, -0.033276665697944297, -0.033276665697944297,
+    0.05534353782142295, -0.02412901029070312, -0.025012049701003517, 0.04983884160476836,
+    -0.033096508611813985, -0.00927872315042477, 0.043521069295790846, -0.043521069295790846,
+    0.00927872315042477, 0.033096508611813985, -0.04983884160476836, 0.025012049701003517,
+    0.02412901029070312, -0.05534353782142295, 0.033276665697944297, 0.033276665697944297,
+    -0.08045905431571458, -0.07325519054242073, 0.058694521265462804, -0.003183157342390924,
+    -0.04479099409424417, 0.05220977169843273, -0.01977809903762772, -0.025012049701003517,
+    0.0497490802029598, -0.03838197538275717, 0.0, 0.03838197538275717,
+    -0.0497490802029598, 0.025012049701003517, 0.01977809903762772, -0.05220977169843273,
+    0.04479099409424417, 0.003183157342390924, -0.058694521265462804, 0.07325519054242073,
+    0.060363892585845014, -0.07082078000048107, 0.04026410941057507, 0.009549472027172773,
+    -0.047378879037899245, 0.05220977169843273, -0.02412901029070312, -0.017809857162989974,
+    0.047715056307592374, -0.047715056307592374, 0.017809857162989974, 0.02412901029070312,
+    -0.05220977169843273, 0.047378879037899245, -0.009549472027172773, -0.04026410941057507,
+    0.07082078000048107, -0.060363892585845014, -0.044406514929192405, 0.0682711191247949,
+    -0.06476767045290993, 0.03394748342279385, 0.009549472027172773, -0.04479099409424417,
+    0.05534353782142295, -0.03712167467441018, 0.0, 0.03712167467441018,
+    -0.05534353782142295, 0.04479099409424417, -0.009549472027172773, -0.03394748342279385,
+    0.06476767045290993, -0.0682711191247949, 0.044406514929192405, 0.028402502381279792,
+    -0.053973058710758276, 0.0690265496263475, -0.06476767045290993, 0.04026410941057507,
+    -0.003183157342390924, -0.033276665697944297, 0.05568251201161527, -0.05568251201161527,
+    0.033276665697944297, 0.003183157342390924, -0.04026410941057507, 0.06476767045290993,
+    -0.0690265496263475, 0.053973058710758276, -0.028402502381279792, -0.014969433128866713,
+    0.03394748342279385, -0.053973058710758276, 0.0682711191247949, -0.07082078000048107,
+    0.058694521265462804, -0.033276665697944297, 0.0, 0.033276665697944297,
+    -0.058694521265462804, 0.07082078000048107, -0.0682711191247949, 0.053973058710758276,
+    -0.03394748342279385, 0.014969433128866713, 0.0056579139037989746, -0.014969433128866713,
+    0.028402502381279792, -0.044406514929192405, 0.060363892585845014, -0.07325519054242073,
+    0.08045905431571458, -0.08045905431571458, 0.07325519054242073, -0.060363892585845014,
+    0.044406514929192405, -0.028402502381279792, 0.014969433128866713, -0.0056579139037989746,
+    0.004201102820261771, -0.011505193905279716, 0.022580249176036234, -0.036517119480472225,
+    0.05138414181436862, -0.06465696054949265, 0.07384345263283243, -0.07712697085199444,
+    0.07384345263283243, -0.06465696054949265, 0.05138414181436862, -0.036517119480472225,
+    0.022580249176036234, -0.011505193905279716, 0.004201102820261771, -0.011505193905279716,
+    0.02730716833170151, -0.045565775679734646, 0.0608797637178923, -0.06763065171923319,
+    0.06205224648430349, -0.04368637572353741, 0.01574347699949146, 0.01574347699949146,
+    -0.04368637572353741, 0.06205224648430349, -0.06763065171923319, 0.0608797637178923,
+    -0.045565775679734646, 0.02730716833170151, -0.011505193905279716, 0.022580249176036234,
+    -0.045565775679734646, 0.06254975310167525, -0.06472020085013493, 0.04860349405838362,
+    -0.018003182691287905, -0.017251717088799627, 0.04503152242785616, -0.055537766549493016,
+    0.04503152242785616, -0.017251717088799627, -0.018003182691287905, 0.04860349405838362,
+    -0.06472020085013493, 0.06254975310167525, -0.045565775679734646, 0.022580249176036234,
+    -0.036517119480472225, 0.0608797637178923, -0.06472020085013493, 0.043644790410497285,
+    -0.00608797637178923, -0.031170196317796602, 0.05143285630404252, -0.046041613646013335,
+    0.018279716826986547, 0.018279716826986547, -0.046041613646013335, 0.05143285630404252,
+    -0.031170196317796602, -0.00608797637178923, 0.043644790410497285, -0.06472020085013493,
+    0.0608797637178923, -0.036517119480472225, 0.05138414181436862, -0.06763065171923319,
+    0.04860349405838362, -0.00608797637178923, -0.03482247448794757, 0.051623340412812635,
+    -0.03684412264500153, 0.0009597969344576107, 0.03447990108345921, -0.04904962732150642,
+    0.03447990108345921, 0.0009597969344576107, -0.03684412264500153, 0.051623340412812635,
+    -0.03482247448794757, -0.00608797637178923, 0.04860349405838362, -0.06763065171923319,
+    0.05138414181436862, -0.06465696054949265, 0.06205224648430349, -0.018003182691287905,
+    -0.031170196317796602, 0.051623340412812635, -0.03346878580141877, -0.006852323642503038,
+    0.0404871854822612, -0.04542588191860526, 0.01949034554679506, 0.01949034554679506,
+    -0.04542588191860526, 0.0404871854822612, -0.006852323642503038, -0.03346878580141877,
+    0.051623340412812635, -0.031170196317796602, -0.018003182691287905, 0.06205224648430349,
+    -0.06465696054949265, 0.07384345263283243, -0.04368637572353741, -0.017251717088799627,
+    0.05143285630404252, -0.03684412264500153, -0.006852323642503038, 0.041921729398708765,
+    -0.042467434126869, 0.01055877043639689, 0.028534007200298542, -0.04573901331970019,
+    0.028534007200298542, 0.01055877043639689, -0.042467434126869, 0.041921729398708765,
+    -0.006852323642503038, -0.03684412264500153, 0.05143285630404252, -0.017251717088799627,
+    -0.04368637572353741, 0.07384345263283243, -0.07712697085199444, 0.01574347699949146,
+    0.04503152242785616, -0.046041613646013335, 0.0009597969344576107, 0.0404871854822612,
+    -0.042467434126869, 0.007669549544816055, 0.032084655560415364, -0.04425643468117621,
+    0.020169009076232928, 0.020169009076232928, -0.04425643468117621, 0.032084655560415364,
+    0.007669549544816055, -0.042467434126869, 0.0404871854822612, 0.0009597969344576107,
+    -0.046041613646013335, 0.04503152242785616, 0.01574347699949146, -0.07712697085199444,
+    0.07384345263283243, 0.01574347699949146, -0.055537766549493016, 0.018279716826986547,
+    0.03447990108345921, -0.04542588191860526, 0.01055877043639689, 0.032084655560415364,
+    -0.04354128497869374, 0.016033240837219163, 0.024839890888786006, -0.04379177123430918,
+    0.024839890888786006, 0.016033240837219163, -0.04354128497869374, 0.032084655560415364,
+    0.01055877043639689, -0.04542588191860526, 0.03447990108345921, 0.018279716826986547,
+    -0.055537766549493016, 0.01574347699949146, 0.07384345263283243, -0.06465696054949265,
+    -0.04368637572353741, 0.04503152242785616, 0.018279716826986547, -0.04904962732150642,
+    0.01949034554679506, 0.028534007200298542, -0.04425643468117621, 0.016033240837219163,
+    0.026223405575170212, -0.043174669426322046, 0.020567603172426233, 0.020567603172426233,
+    -0.043174669426322046, 0.026223405575170212, 0.016033240837219163, -0.04425643468117621,
+    0.028534007200298542, 0.01949034554679506, -0.04904962732150642, 0.018279716826986547,
+    0.04503152242785616, -0.04368637572353741, -0.06465696054949265, 0.05138414181436862,
+    0.06205224648430349, -0.017251717088799627, -0.046041613646013335, 0.03447990108345921,
+    0.01949034554679506, -0.04573901331970019, 0.020169009076232928, 0.024839890888786006,
+    -0.043174669426322046, 0.019166770548092835, 0.022554422426408278, -0.042623780180777296,
+    0.022554422426408278, 0.019166770548092835, -0.043174669426322046, 0.024839890888786006,
+    0.020169009076232928, -0.04573901331970019, 0.01949034554679506, 0.03447990108345921,
+    -0.046041613646013335, -0.017251717088799627, 0.06205224648430349, 0.05138414181436862,
+    -0.036517119480472225, -0.06763065171923319, -0.018003182691287905, 0.05143285630404252,
+    0.0009597969344576107, -0.04542588191860526, 0.028534007200298542, 0.020169009076232928,
+    -0.04379177123430918, 0.020567603172426233, 0.022554422426408278, -0.04239460715577204,
+    0.020793274907466103, 0.020793274907466103, -0.04239460715577204, 0.022554422426408278,
+    0.020567603172426233, -0.04379177123430918, 0.020169009076232928, 0.028534007200298542,
+    -0.04542588191860526, 0.0009597969344576107, 0.05143285630404252, -0.018003182691287905,
+    -0.06763065171923319, -0.036517119480472225, 0.022580249176036234, 0.0608797637178923,
+    0.04860349405838362, -0.031170196317796602, -0.03684412264500153, 0.0404871854822612,
+    0.01055877043639689, -0.04425643468117621, 0.024839890888786006, 0.020567603172426233,
+    -0.042623780180777296, 0.020793274907466103, 0.021297764732283585, -0.04199228186005081,
+    0.021297764732283585, 0.020793274907466103, -0.042623780180777296, 0.020567603172426233,
+    0.024839890888786006, -0.04425643468117621, 0.01055877043639689, 0.0404871854822612,
+    -0.03684412264500153, -0.031170196317796602, 0.04860349405838362, 0.0608797637178923,
+    0.022580249176036234, -0.011505193905279716, -0.045565775679734646, -0.06472020085013493,
+    -0.00608797637178923, 0.051623340412812635, -0.006852323642503038, -0.042467434126869,
+    0.032084655560415364, 0.016033240837219163, -0.043174669426322046, 0.022554422426408278,
+    0.020793274907466103, -0.04199228186005081, 0.02089592011469333, 0.02089592011469333,
+    -0.04199228186005081, 0.020793274907466103, 0.022554422426408278, -0.043174669426322046,
+    0.016033240837219163, 0.032084655560415364, -0.042467434126869, -0.006852323642503038,
+    0.051623340412812635, -0.00608797637178923, -0.06472020085013493, -0.045565775679734646,
+    -0.011505193905279716, 0.004201102820261771, 0.02730716833170151, 0.06254975310167525,
+    0.043644790410497285, -0.03482247448794757, -0.03346878580141877, 0.041921729398708765,
+    0.007669549544816055, -0.04354128497869374, 0.026223405575170212, 0.019166770548092835,
+    -0.04239460715577204, 0.021297764732283585, 0.02089592011469333, -0.04179184022938666,
+    0.02089592011469333, 0.021297764732283585, -0.04239460715577204, 0.019166770548092835,
+    0.026223405575170212, -0.04354128497869374, 0.007669549544816055, 0.041921729398708765,
+    -0.03346878580141877, -0.03482247448794757, 0.043644790410497285, 0.06254975310167525,
+    0.02730716833170151, 0.004201102820261771, -0.011505193905279716, -0.045565775679734646,
+    -0.06472020085013493, -0.00608797637178923, 0.051623340412812635, -0.006852323642503038,
+    -0.042467434126869, 0.032084655560415364, 0.016033240837219163, -0.043174669426322046,
+    0.022554422426408278, 0.020793274907466103, -0.04199228186005081, 0.02089592011469333,
+    0.02089592011469333, -0.04199228186005081, 0.020793274907466103, 0.022554422426408278,
+    -0.043174669426322046, 0.016033240837219163, 0.032084655560415364, -0.042467434126869,
+    -0.006852323642503038, 0.051623340412812635, -0.00608797637178923, -0.06472020085013493,
+    -0.045565775679734646, -0.011505193905279716, 0.022580249176036234, 0.0608797637178923,
+    0.04860349405838362, -0.031170196317796602, -0.03684412264500153, 0.0404871854822612,
+    0.01055877043639689, -0.04425643468117621, 0.024839890888786006, 0.020567603172426233,
+    -0.042623780180777296, 0.020793274907466103, 0.021297764732283585, -0.04199228186005081,
+    0.021297764732283585, 0.020793274907466103, -0.042623780180777296, 0.020567603172426233,
+    0.024839890888786006, -0.04425643468117621, 0.01055877043639689, 0.0404871854822612,
+    -0.03684412264500153, -0.031170196317796602, 0.04860349405838362, 0.0608797637178923,
+    0.022580249176036234, -0.036517119480472225, -0.06763065171923319, -0.018003182691287905,
+    0.05143285630404252, 0.0009597969344576107, -0.04542588191860526, 0.028534007200298542,
+    0.020169009076232928, -0.04379177123430918, 0.020567603172426233, 0.022554422426408278,
+    -0.04239460715577204, 0.020793274907466103, 0.020793274907466103, -0.04239460715577204,
+    0.022554422426408278, 0.020567603172426233, -0.04379177123430918, 0.020169009076232928,
+    0.028534007200298542, -0.04542588191860526, 0.0009597969344576107, 0.05143285630404252,
+    -0.018003182691287905, -0.06763065171923319, -0.036517119480472225, 0.05138414181436862,
+    0.06205224648430349, -0.017251717088799627, -0.046041613646013335, 0.03447990108345921,
+    0.01949034554679506, -0.04573901331970019, 0.020169009076232928, 0.024839890888786006,
+    -0.043174669426322046, 0.019166770548092835, 0.022554422426408278, -0.042623780180777296,
+    0.022554422426408278, 0.019166770548092835, -0.043174669426322046, 0.024839890888786006,
+    0.020169009076232928, -0.04573901331970019, 0.01949034554679506, 0.03447990108345921,
+    -0.046041613646013335, -0.017251717088799627, 0.06205224648430349, 0.05138414181436862,
+    -0.06465696054949265, -0.04368637572353741, 0.04503152242785616, 0.018279716826986547,
+    -0.04904962732150642, 0.01949034554679506, 0.028534007200298542, -0.04425643468117621,
+    0.016033240837219163, 0.026223405575170212, -0.043174669426322046, 0.020567603172426233,
+    0.020567603172426233, -0.043174669426322046, 0.026223405575170212, 0.016033240837219163,
+    -0.04425643468117621, 0.028534007200298542, 0.01949034554679506, -0.04904962732150642,
+    0.018279716826986547, 0.04503152242785616, -0.04368637572353741, -0.06465696054949265,
+    0.07384345263283243, 0.01574347699949146, -0.055537766549493016, 0.018279716826986547,
+    0.03447990108345921, -0.04542588191860526, 0.01055877043639689, 0.032084655560415364,
+    -0.04354128497869374, 0.016033240837219163, 0.024839890888786006, -0.04379177123430918,
+    0.024839890888786006, 0.016033240837219163, -0.04354128497869374, 0.032084655560415364,
+    0.01055877043639689, -0.04542588191860526, 0.03447990108345921, 0.018279716826986547,
+    -0.055537766549493016, 0.01574347699949146, 0.07384345263283243, -0.07712697085199444,
+    0.01574347699949146, 0.04503152242785616, -0.046041613646013335, 0.0009597969344576107,
+    0.0404871854822612, -0.042467434126869, 0.007669549544816055, 0.032084655560415364,
+    -0.04425643468117621, 0.020169009076232928, 0.020169009076232928, -0.04425643468117621,
+    0.032084655560415364, 0.007669549544816055, -0.042467434126869, 0.0404871854822612,
+    0.0009597969344576107, -0.046041613646013335, 0.04503152242785616, 0.01574347699949146,
+    -0.07712697085199444, 0.07384345263283243, -0.04368637572353741, -0.017251717088799627,
+    0.05143285630404252, -0.03684412264500153, -0.006852323642503038, 0.041921729398708765,
+    -0.042467434126869, 0.01055877043639689, 0.028534007200298542, -0.04573901331970019,
+    0.028534007200298542, 0.01055877043639689, -0.042467434126869, 0.041921729398708765,
+    -0.006852323642503038, -0.03684412264500153, 0.05143285630404252, -0.017251717088799627,
+    -0.04368637572353741, 0.07384345263283243, -0.06465696054949265, 0.06205224648430349,
+    -0.018003182691287905, -0.031170196317796602, 0.051623340412812635, -0.03346878580141877,
+    -0.006852323642503038, 0.0404871854822612, -0.04542588191860526, 0.01949034554679506,
+    0.01949034554679506, -0.04542588191860526, 0.0404871854822612, -0.006852323642503038,
+    -0.03346878580141877, 0.051623340412812635, -0.031170196317796602, -0.018003182691287905,
+    0.06205224648430349, -0.06465696054949265, 0.05138414181436862, -0.06763065171923319,
+    0.04860349405838362, -0.00608797637178923, -0.03482247448794757, 0.051623340412812635,
+    -0.03684412264500153, 0.0009597969344576107, 0.03447990108345921, -0.04904962732150642,
+    0.03447990108345921, 0.0009597969344576107, -0.03684412264500153, 0.051623340412812635,
+    -0.03482247448794757, -0.00608797637178923, 0.04860349405838362, -0.06763065171923319,
+    0.05138414181436862, -0.036517119480472225, 0.0608797637178923, -0.06472020085013493,
+    0.043644790410497285, -0.00608797637178923, -0.031170196317796602, 0.05143285630404252,
+    -0.046041613646013335, 0.018279716826986547, 0.018279716826986547, -0.046041613646013335,
+    0.05143285630404252, -0.031170196317796602, -0.00608797637178923, 0.043644790410497285,
+    -0.06472020085013493, 0.0608797637178923, -0.036517119480472225, 0.022580249176036234,
+    -0.045565775679734646, 0.06254975310167525, -0.06472020085013493, 0.04860349405838362,
+    -0.018003182691287905, -0.017251717088799627, 0.04503152242785616, -0.055537766549493016,
+    0.04503152242785616, -0.017251717088799627, -0.018003182691287905, 0.04860349405838362,
+    -0.06472020085013493, 0.06254975310167525, -0.045565775679734646, 0.022580249176036234,
+    -0.011505193905279716, 0.02730716833170151, -0.045565775679734646, 0.0608797637178923,
+    -0.06763065171923319, 0.06205224648430349, -0.04368637572353741, 0.01574347699949146,
+    0.01574347699949146, -0.04368637572353741, 0.06205224648430349, -0.06763065171923319,
+    0.0608797637178923, -0.045565775679734646, 0.02730716833170151, -0.011505193905279716,
+    0.004201102820261771, -0.011505193905279716, 0.022580249176036234, -0.036517119480472225,
+    0.05138414181436862, -0.06465696054949265, 0.07384345263283243, -0.07712697085199444,
+    0.07384345263283243, -0.06465696054949265, 0.05138414181436862, -0.036517119480472225,
+    0.022580249176036234, -0.011505193905279716, 0.004201102820261771, 0.0031269823000042996,
+    -0.00884444155593339, 0.01791615859566177, -0.029902891420361847, 0.04344789394034224,
+    -0.05652081218639529, 0.06687632686006072, -0.07260229780692978, 0.07260229780692978,
+    -0.06687632686006072, 0.05652081218639529, -0.04344789394034224, 0.029902891420361847,
+    -0.01791615859566177, 0.00884444155593339, -0.0031269823000042996, -0.00884444155593339,
+    0.021888876100030097, -0.038165266333821155, 0.053534763307268154, -0.06304083034203398,
+    0.06261507939047613, -0.050553751276911356, 0.028260406093197646, 0.0,
+    -0.028260406093197646, 0.050553751276911356, -0.06261507939047613, 0.06304083034203398,
+    -0.053534763307268154, 0.038165266333821155, -0.021888876100030097, 0.00884444155593339,
+    0.01791615859566177, -0.038165266333821155, 0.055746546520766306, -0.06251547321318089,
+    0.05357167111124354, -0.02976597472238238, -0.002237680382813104, 0.03226452673976127,
+    -0.05033537552047327, 0.05033537552047327, -0.03226452673976127, 0.002237680382813104,
+    0.02976597472238238, -0.05357167111124354, 0.06251547321318089, -0.055746546520766306,
+    0.038165266333821155, -0.01791615859566177, -0.029902891420361847, 0.053534763307268154,
+    -0.06251547321318089, 0.04992388982420658, -0.019288675826891737, -0.016964168332763287,
+    0.04346305529542573, -0.04905064815727292, 0.031834886704915785, 0.0,
+    -0.031834886704915785, 0.04905064815727292, -0.04346305529542573, 0.016964168332763287,
+    0.019288675826891737, -0.04992388982420658, 0.06251547321318089, -0.053534763307268154,
+    0.029902891420361847, 0.04344789394034224, -0.06304083034203398, 0.05357167111124354,
+    -0.019288675826891737, -0.02117002959428198, 0.04634536720004783, -0.043983421039385705,
+    0.017060985511609412, 0.018587569265458983, -0.04310464036632843, 0.04310464036632843,
+    -0.018587569265458983, -0.017060985511609412, 0.043983421039385705, -0.04634536720004783,
+    0.02117002959428198, 0.019288675826891737, -0.05357167111124354, 0.06304083034203398,
+    -0.04344789394034224, -0.05652081218639529, 0.06261507939047613, -0.02976597472238238,
+    -0.016964168332763287, 0.04634536720004783, -0.041800924309252876, 0.009729262813810318,
+    0.02711051235023537, -0.04491349286240468, 0.03313480062523981, 0.0,
+    -0.03313480062523981, 0.04491349286240468, -0.02711051235023537, -0.009729262813810318,
+    0.041800924309252876, -0.04634536720004783, 0.016964168332763287, 0.02976597472238238,
+    -0.06261507939047613, 0.05652081218639529, 0.06687632686006072, -0.050553751276911356,
+    -0.002237680382813104, 0.04346305529542573, -0.043983421039385705, 0.009729262813810318,
+    0.029494272130845153, -0.04444568709275543, 0.026070690762106222, 0.010750348892621761,
+    -0.03920562481920355, 0.03920562481920355, -0.010750348892621761, -0.026070690762106222,
+    0.04444568709275543, -0.029494272130845153, -0.009729262813810318, 0.043983421039385705,
+    -0.04346305529542573, 0.002237680382813104, 0.050553751276911356, -0.06687632686006072,
+    -0.07260229780692978, 0.028260406093197646, 0.03226452673976127, -0.04905064815727292,
+    0.017060985511609412, 0.02711051235023537, -0.04444568709275543, 0.023628484643940535,
+    0.015483693425092187, -0.040990364954344646, 0.033653915268038584, 0.0,
+    -0.033653915268038584, 0.040990364954344646, -0.015483693425092187, -0.023628484643940535,
+    0.04444568709275543, -0.02711051235023537, -0.017060985511609412, 0.04905064815727292,
+    -0.03226452673976127, -0.028260406093197646, 0.07260229780692978, 0.07260229780692978,
+    0.0, -0.05033537552047327, 0.031834886704915785, 0.018587569265458983,
+    -0.04491349286240468, 0.026070690762106222, 0.015483693425092187, -0.04131210868534416,
+    0.030556878922487145, 0.005838768515590004, -0.03679917021387186, 0.03679917021387186,
+    -0.005838768515590004, -0.030556878922487145, 0.04131210868534416, -0.015483693425092187,
+    -0.026070690762106222, 0.04491349286240468, -0.018587569265458983, -0.031834886704915785,
+    0.05033537552047327, 0.0, -0.07260229780692978, -0.06687632686006072,
+    -0.028260406093197646, 0.05033537552047327, 0.0, -0.04310464036632843,
+    0.03313480062523981, 0.010750348892621761, -0.040990364954344646, 0.030556878922487145,
+    0.007670092216332385, -0.03787065692170211, 0.0338503132728654, 0.0,
+    -0.0338503132728654, 0.03787065692170211, -0.007670092216332385, -0.030556878922487145,
+    0.040990364954344646, -0.010750348892621761, -0.03313480062523981, 0.04310464036632843,
+    0.0, -0.05033537552047327, 0.028260406093197646, 0.06687632686006072,
+    0.05652081218639529, 0.050553751276911356, -0.03226452673976127, -0.031834886704915785,
+    0.04310464036632843, 0.0, -0.03920562481920355, 0.033653915268038584,
+    0.005838768515590004, -0.03787065692170211, 0.03281534298740144, 0.002725442798439903,
+    -0.035271218914294425, 0.035271218914294425, -0.002725442798439903, -0.03281534298740144,
+    0.03787065692170211, -0.005838768515590004, -0.033653915268038584, 0.03920562481920355,
+    0.0, -0.04310464036632843, 0.031834886704915785, 0.03226452673976127,
+    -0.050553751276911356, -0.05652081218639529, -0.04344789394034224, -0.06261507939047613,
+    0.002237680382813104, 0.04905064815727292, -0.018587569265458983, -0.03313480062523981,
+    0.03920562481920355, 0.0, -0.03679917021387186, 0.0338503132728654,
+    0.002725442798439903, -0.03566197515016398, 0.03391121343593522, 0.0,
+    -0.03391121343593522, 0.03566197515016398, -0.002725442798439903, -0.0338503132728654,
+    0.03679917021387186, 0.0, -0.03920562481920355, 0.03313480062523981,
+    0.018587569265458983, -0.04905064815727292, -0.002237680382813104, 0.06261507939047613,
+    0.04344789394034224, 0.029902891420361847, 0.06304083034203398, 0.02976597472238238,
+    -0.04346305529542573, -0.017060985511609412, 0.04491349286240468, -0.010750348892621761,
+    -0.033653915268038584, 0.03679917021387186, 0.0, -0.035271218914294425,
+    0.03391121343593522, 0.0008698042719552189, -0.034354516086797314, 0.034354516086797314,
+    -0.0008698042719552189, -0.03391121343593522, 0.035271218914294425, 0.0,
+    -0.03679917021387186, 0.033653915268038584, 0.010750348892621761, -0.04491349286240468,
+    0.017060985511609412, 0.04346305529542573, -0.02976597472238238, -0.06304083034203398,
+    -0.029902891420361847, -0.01791615859566177, -0.053534763307268154, -0.05357167111124354,
+    0.016964168332763287, 0.043983421039385705, -0.02711051235023537, -0.026070690762106222,
+    0.040990364954344646, -0.005838768515590004, -0.0338503132728654, 0.035271218914294425,
+    0.0, -0.034354516086797314, 0.033922366606253536, 0.0,
+    -0.033922366606253536, 0.034354516086797314, 0.0, -0.035271218914294425,
+    0.0338503132728654, 0.005838768515590004, -0.040990364954344646, 0.026070690762106222,
+    0.02711051235023537, -0.043983421039385705, -0.016964168332763287, 0.05357167111124354,
+    0.053534763307268154, 0.01791615859566177, 0.00884444155593339, 0.038165266333821155,
+    0.06251547321318089, 0.019288675826891737, -0.04634536720004783, -0.009729262813810318,
+    0.04444568709275543, -0.015483693425092187, -0.030556878922487145, 0.03787065692170211,
+    -0.002725442798439903, -0.03391121343593522, 0.034354516086797314, 0.0,
+    -0.033922366606253536, 0.033922366606253536, 0.0, -0.034354516086797314,
+    0.03391121343593522, 0.002725442798439903, -0.03787065692170211, 0.030556878922487145,
+    0.015483693425092187, -0.04444568709275543, 0.009729262813810318, 0.04634536720004783,
+    -0.019288675826891737, -0.06251547321318089, -0.038165266333821155, -0.00884444155593339,
+    -0.0031269823000042996, -0.021888876100030097, -0.055746546520766306, -0.04992388982420658,
+    0.02117002959428198, 0.041800924309252876, -0.029494272130845153, -0.023628484643940535,
+    0.04131210868534416, -0.007670092216332385, -0.03281534298740144, 0.03566197515016398,
+    -0.0008698042719552189, -0.033922366606253536, 0.033922366606253536, 0.0,
+    -0.033922366606253536, 0.033922366606253536, 0.0008698042719552189, -0.03566197515016398,
+    0.03281534298740144, 0.007670092216332385, -0.04131210868534416, 0.023628484643940535,
+    0.029494272130845153, -0.041800924309252876, -0.02117002959428198, 0.04992388982420658,
+    0.055746546520766306, 0.021888876100030097, 0.0031269823000042996, 0.00884444155593339,
+    0.038165266333821155, 0.06251547321318089, 0.019288675826891737, -0.04634536720004783,
+    -0.009729262813810318, 0.04444568709275543, -0.015483693425092187, -0.030556878922487145,
+    0.03787065692170211, -0.002725442798439903, -0.03391121343593522, 0.034354516086797314,
+    0.0, -0.033922366606253536, 0.033922366606253536, 0.0,
+    -0.034354516086797314, 0.03391121343593522, 0.002725442798439903, -0.03787065692170211,
+    0.030556878922487145, 0.015483693425092187, -0.04444568709275543, 0.009729262813810318,
+    0.04634536720004783, -0.019288675826891737, -0.06251547321318089, -0.038165266333821155,
+    -0.00884444155593339, -0.01791615859566177, -0.053534763307268154, -0.05357167111124354,
+    0.016964168332763287, 0.043983421039385705, -0.02711051235023537, -0.026070690762106222,
+    0.040990364954344646, -0.005838768515590004, -0.0338503132728654, 0.035271218914294425,
+    0.0, -0.034354516086797314, 0.033922366606253536, 0.0,
+    -0.033922366606253536, 0.034354516086797314, 0.0, -0.035271218914294425,
+    0.0338503132728654, 0.005838768515590004, -0.040990364954344646, 0.026070690762106222,
+    0.02711051235023537, -0.043983421039385705, -0.016964168332763287, 0.05357167111124354,
+    0.053534763307268154, 0.01791615859566177, 0.029902891420361847, 0.06304083034203398,
+    0.02976597472238238, -0.04346305529542573, -0.017060985511609412, 0.04491349286240468,
+    -0.010750348892621761, -0.033653915268038584, 0.03679917021387186, 0.0,
+    -0.035271218914294425, 0.03391121343593522, 0.0008698042719552189, -0.034354516086797314,
+    0.034354516086797314, -0.0008698042719552189, -0.03391121343593522, 0.035271218914294425,
+    0.0, -0.03679917021387186, 0.033653915268038584, 0.010750348892621761,
+    -0.04491349286240468, 0.017060985511609412, 0.04346305529542573, -0.02976597472238238,
+    -0.06304083034203398, -0.029902891420361847, -0.04344789394034224, -0.06261507939047613,
+    0.002237680382813104, 0.04905064815727292, -0.018587569265458983, -0.03313480062523981,
+    0.03920562481920355, 0.0, -0.03679917021387186, 0.0338503132728654,
+    0.002725442798439903, -0.03566197515016398, 0.03391121343593522, 0.0,
+    -0.03391121343593522, 0.03566197515016398, -0.002725442798439903, -0.0338503132728654,
+    0.03679917021387186, 0.0, -0.03920562481920355, 0.03313480062523981,
+    0.018587569265458983, -0.04905064815727292, -0.002237680382813104, 0.06261507939047613,
+    0.04344789394034224, 0.05652081218639529, 0.050553751276911356, -0.03226452673976127,
+    -0.031834886704915785, 0.04310464036632843, 0.0, -0.03920562481920355,
+    0.033653915268038584, 0.005838768515590004, -0.03787065692170211, 0.03281534298740144,
+    0.002725442798439903, -0.035271218914294425, 0.035271218914294425, -0.002725442798439903,
+    -0.03281534298740144, 0.03787065692170211, -0.005838768515590004, -0.033653915268038584,
+    0.03920562481920355, 0.0, -0.04310464036632843, 0.031834886704915785,
+    0.03226452673976127, -0.050553751276911356, -0.05652081218639529, -0.06687632686006072,
+    -0.028260406093197646, 0.05033537552047327, 0.0, -0.04310464036632843,
+    0.03313480062523981, 0.010750348892621761, -0.040990364954344646, 0.030556878922487145,
+    0.007670092216332385, -0.03787065692170211, 0.0338503132728654, 0.0,
+    -0.0338503132728654, 0.03787065692170211, -0.007670092216332385, -0.030556878922487145,
+    0.040990364954344646, -0.010750348892621761, -0.03313480062523981, 0.04310464036632843,
+    0.0, -0.05033537552047327, 0.028260406093197646, 0.06687632686006072,
+    0.07260229780692978, 0.0, -0.05033537552047327, 0.031834886704915785,
+    0.018587569265458983, -0.04491349286240468, 0.026070690762106222, 0.015483693425092187,
+    -0.04131210868534416, 0.030556878922487145, 0.005838768515590004, -0.03679917021387186,
+    0.03679917021387186, -0.005838768515590004, -0.030556878922487145, 0.04131210868534416,
+    -0.015483693425092187, -0.026070690762106222, 0.04491349286240468, -0.018587569265458983,
+    -0.031834886704915785, 0.05033537552047327, 0.0, -0.07260229780692978,
+    -0.07260229780692978, 0.028260406093197646, 0.03226452673976127, -0.04905064815727292,
+    0.017060985511609412, 0.02711051235023537, -0.04444568709275543, 0.023628484643940535,
+    0.015483693425092187, -0.040990364954344646, 0.033653915268038584, 0.0,
+    -0.033653915268038584, 0.040990364954344646, -0.015483693425092187, -0.023628484643940535,
+    0.04444568709275543, -0.02711051235023537, -0.017060985511609412, 0.04905064815727292,
+    -0.03226452673976127, -0.028260406093197646, 0.07260229780692978, 0.06687632686006072,
+    -0.050553751276911356, -0.002237680382813104, 0.04346305529542573, -0.043983421039385705,
+    0.009729262813810318, 0.029494272130845153, -0.04444568709275543, 0.026070690762106222,
+    0.010750348892621761, -0.03920562481920355, 0.03920562481920355, -0.010750348892621761,
+    -0.026070690762106222, 0.04444568709275543, -0.029494272130845153, -0.009729262813810318,
+    0.043983421039385705, -0.04346305529542573, 0.002237680382813104, 0.050553751276911356,
+    -0.06687632686006072, -0.05652081218639529, 0.06261507939047613, -0.02976597472238238,
+    -0.016964168332763287, 0.04634536720004783, -0.041800924309252876, 0.009729262813810318,
+    0.02711051235023537, -0.04491349286240468, 0.03313480062523981, 0.0,
+    -0.03313480062523981, 0.04491349286240468, -0.02711051235023537, -0.009729262813810318,
+    0.041800924309252876, -0.04634536720004783, 0.016964168332763287, 0.02976597472238238,
+    -0.06261507939047613, 0.05652081218639529, 0.04344789394034224, -0.06304083034203398,
+    0.05357167111124354, -0.019288675826891737, -0.02117002959428198, 0.04634536720004783,
+    -0.043983421039385705, 0.017060985511609412, 0.018587569265458983, -0.04310464036632843,
+    0.04310464036632843, -0.018587569265458983, -0.017060985511609412, 0.043983421039385705,
+    -0.04634536720004783, 0.02117002959428198, 0.019288675826891737, -0.05357167111124354,
+    0.06304083034203398, -0.04344789394034224, -0.029902891420361847, 0.053534763307268154,
+    -0.06251547321318089, 0.04992388982420658, -0.019288675826891737, -0.016964168332763287,
+    0.04346305529542573, -0.04905064815727292, 0.031834886704915785, 0.0,
+    -0.031834886704915785, 0.04905064815727292, -0.04346305529542573, 0.016964168332763287,
+    0.019288675826891737, -0.04992388982420658, 0.06251547321318089, -0.053534763307268154,
+    0.029902891420361847, 0.01791615859566177, -0.038165266333821155, 0.055746546520766306,
+    -0.06251547321318089, 0.05357167111124354, -0.02976597472238238, -0.002237680382813104,
+    0.03226452673976127, -0.05033537552047327, 0.05033537552047327, -0.03226452673976127,
+    0.002237680382813104, 0.02976597472238238, -0.05357167111124354, 0.06251547321318089,
+    -0.055746546520766306, 0.038165266333821155, -0.01791615859566177, -0.00884444155593339,
+    0.021888876100030097, -0.038165266333821155, 0.053534763307268154, -0.06304083034203398,
+    0.06261507939047613, -0.050553751276911356, 0.028260406093197646, 0.0,
+    -0.028260406093197646, 0.050553751276911356, -0.06261507939047613, 0.06304083034203398,
+    -0.053534763307268154, 0.038165266333821155, -0.021888876100030097, 0.00884444155593339,
+    0.0031269823000042996, -0.00884444155593339, 0.01791615859566177, -0.029902891420361847,
+    0.04344789394034224, -0.05652081218639529, 0.06687632686006072, -0.07260229780692978,
+    0.07260229780692978, -0.06687632686006072, 0.05652081218639529, -0.04344789394034224,
+    0.029902891420361847, -0.01791615859566177, 0.00884444155593339, -0.0031269823000042996,
+    0.002332434819536523, -0.006800157615289823, 0.014190739125793207, -0.02439633453002056,
+    0.036524330106695854, -0.049002530970728445, 0.05989198229755699, -0.06732818568756019,
+    0.06996950303537157, -0.06732818568756019, 0.05989198229755699, -0.049002530970728445,
+    0.036524330106695854, -0.02439633453002056, 0.014190739125793207, -0.006800157615289823,
+    0.002332434819536523, -0.006800157615289823, 0.01749326114652392, -0.03175495342041885,
+    0.04653947075981801, -0.05766112191581057, 0.061116893992414975, -0.05444725663414272,
+    0.03767031413024793, -0.013465637137512037, -0.013465637137512037, 0.03767031413024793,
+    -0.05444725663414272, 0.061116893992414975, -0.05766112191581057, 0.04653947075981801,
+    -0.03175495342041885, 0.01749326114652392, -0.006800157615289823, 0.014190739125793207,
+    -0.03175495342041885, 0.04901875112671112, -0.05886044394387448, 0.055775788586250624,
+    -0.03850957655394699, 0.010976918204446077, 0.018862197257764036, -0.04172236023864111,
+    0.05026757490132502, -0.04172236023864111, 0.018862197257764036, 0.010976918204446077,
+    -0.03850957655394699, 0.055775788586250624, -0.05886044394387448, 0.04901875112671112,
+    -0.03175495342041885, 0.014190739125793207, -0.02439633453002056, 0.04653947075981801,
+    -0.05886044394387448, 0.05330742160134279, -0.029782683557593614, -0.0033600089844400306,
+    0.033008845201087066, -0.047172204086926656, 0.04029752117966596, -0.015722270889929855,
+    -0.015722270889929855, 0.04029752117966596, -0.047172204086926656, 0.033008845201087066,
+    -0.0033600089844400306, -0.029782683557593614, 0.05330742160134279, -0.05886044394387448,
+    0.04653947075981801, -0.02439633453002056, 0.036524330106695854, -0.05766112191581057,
+    0.055775788586250624, -0.029782683557593614, -0.007701704963063591, 0.03784508554399198,
+    -0.0460145657870965, 0.02927628765579554, 0.0025451765996826314, -0.03228026116417114,
+    0.04427720455204181, -0.03228026116417114, 0.0025451765996826314, 0.02927628765579554,
+    -0.0460145657870965, 0.03784508554399198, -0.007701704963063591, -0.029782683557593614,
+    0.055775788586250624, -0.05766112191581057, 0.036524330106695854, -0.049002530970728445,
+    0.061116893992414975, -0.03850957655394699, -0.0033600089844400306, 0.03784508554399198,
+    -0.04504920132260558, 0.023191638763602442, 0.012110099474284711, -0.03846034762840496,
+    0.04014710529172678, -0.016838621425166362, -0.016838621425166362, 0.04014710529172678,
+    -0.03846034762840496, 0.012110099474284711, 0.023191638763602442, -0.04504920132260558,
+    0.03784508554399198, -0.0033600089844400306, -0.03850957655394699, 0.061116893992414975,
+    -0.049002530970728445, 0.05989198229755699, -0.05444725663414272, 0.010976918204446077,
+    0.033008845201087066, -0.0460145657870965, 0.023191638763602442, 0.014998239101895496,
+    -0.04021564159683018, 0.03582726352161462, -0.006450641267776993, -0.026835187064573413,
+    0.041161074594851105, -0.026835187064573413, -0.006450641267776993, 0.03582726352161462,
+    -0.04021564159683018, 0.014998239101895496, 0.023191638763602442, -0.0460145657870965,
+    0.033008845201087066, 0.010976918204446077, -0.05444725663414272, 0.05989198229755699,
+    -0.06732818568756019, 0.03767031413024793, 0.018862197257764036, -0.047172204086926656,
+    0.02927628765579554, 0.012110099474284711, -0.04021564159683018, 0.03416537032376719,
+    -0.0014800491361420564, -0.031232118321023662, 0.03932573780534777, -0.017490093546632834,
+    -0.017490093546632834, 0.03932573780534777, -0.031232118321023662, -0.0014800491361420564,
+    0.03416537032376719, -0.04021564159683018, 0.012110099474284711, 0.02927628765579554,
+    -0.047172204086926656, 0.018862197257764036, 0.03767031413024793, -0.06732818568756019,
+    0.06996950303537157, -0.013465637137512037, -0.04172236023864111, 0.04029752117966596,
+    0.0025451765996826314, -0.03846034762840496, 0.03582726352161462, -0.0014800491361420564,
+    -0.032439351260796855, 0.03782655441812914, -0.011859937700410775, -0.02331653674132676,
+    0.03926516262847559, -0.02331653674132676, -0.011859937700410775, 0.03782655441812914,
+    -0.032439351260796855, -0.0014800491361420564, 0.03582726352161462, -0.03846034762840496,
+    0.0025451765996826314, 0.04029752117966596, -0.04172236023864111, -0.013465637137512037,
+    0.06996950303537157, -0.06732818568756019, -0.013465637137512037, 0.05026757490132502,
+    -0.015722270889929855, -0.03228026116417114, 0.04014710529172678, -0.006450641267776993,
+    -0.031232118321023662, 0.03782655441812914, -0.010008367977771717, -0.025773356818701038,
+    0.03842831211221362, -0.017894419176959823, -0.017894419176959823, 0.03842831211221362,
+    -0.025773356818701038, -0.010008367977771717, 0.03782655441812914, -0.031232118321023662,
+    -0.006450641267776993, 0.04014710529172678, -0.03228026116417114, -0.015722270889929855,
+    0.05026757490132502, -0.013465637137512037, -0.06732818568756019, 0.05989198229755699,
+    0.03767031413024793, -0.04172236023864111, -0.015722270889929855, 0.04427720455204181,
+    -0.016838621425166362, -0.026835187064573413, 0.03932573780534777, -0.011859937700410775,
+    -0.025773356818701038, 0.03803633000201913, -0.015198869152750111, -0.020980260102638197,
+    0.03805137529297539, -0.020980260102638197, -0.015198869152750111, 0.03803633000201913,
+    -0.025773356818701038, -0.011859937700410775, 0.03932573780534777, -0.026835187064573413,
+    -0.016838621425166362, 0.04427720455204181, -0.015722270889929855, -0.04172236023864111,
+    0.03767031413024793, 0.05989198229755699, -0.049002530970728445, -0.05444725663414272,
+    0.018862197257764036, 0.04029752117966596, -0.03228026116417114, -0.016838621425166362,
+    0.041161074594851105, -0.017490093546632834, -0.02331653674132676, 0.03842831211221362,
+    -0.015198869152750111, -0.021922898204612937, 0.037670497912531554, -0.01814709977885351,
+    -0.01814709977885351, 0.037670497912531554, -0.021922898204612937, -0.015198869152750111,
+    0.03842831211221362, -0.02331653674132676, -0.017490093546632834, 0.041161074594851105,
+    -0.016838621425166362, -0.03228026116417114, 0.04029752117966596, 0.018862197257764036,
+    -0.05444725663414272, -0.049002530970728445, 0.036524330106695854, 0.061116893992414975,
+    0.010976918204446077, -0.047172204086926656, 0.0025451765996826314, 0.04014710529172678,
+    -0.026835187064573413, -0.017490093546632834, 0.03926516262847559, -0.017894419176959823,
+    -0.020980260102638197, 0.037670497912531554, -0.017213922456605385, -0.019479737758967205,
+    0.037288745330013265, -0.019479737758967205, -0.017213922456605385, 0.037670497912531554,
+    -0.020980260102638197, -0.017894419176959823, 0.03926516262847559, -0.017490093546632834,
+    -0.026835187064573413, 0.04014710529172678, 0.0025451765996826314, -0.047172204086926656,
+    0.010976918204446077, 0.061116893992414975, 0.036524330106695854, -0.02439633453002056,
+    -0.05766112191581057, -0.03850957655394699, 0.033008845201087066, 0.02927628765579554,
+    -0.03846034762840496, -0.006450641267776993, 0.03932573780534777, -0.02331653674132676,
+    -0.017894419176959823, 0.03805137529297539, -0.01814709977885351, -0.019479737758967205,
+    0.03713812206595289, -0.01829584898667091, -0.01829584898667091, 0.03713812206595289,
+    -0.019479737758967205, -0.01814709977885351, 0.03805137529297539, -0.017894419176959823,
+    -0.02331653674132676, 0.03932573780534777, -0.006450641267776993, -0.03846034762840496,
+    0.02927628765579554, 0.033008845201087066, -0.03850957655394699, -0.05766112191581057,
+    -0.02439633453002056, 0.014190739125793207, 0.04653947075981801, 0.055775788586250624,
+    -0.0033600089844400306, -0.0460145657870965, 0.012110099474284711, 0.03582726352161462,
+    -0.031232118321023662, -0.011859937700410775, 0.03842831211221362, -0.020980260102638197,
+    -0.01814709977885351, 0.037288745330013265, -0.01829584898667091, -0.018637079571558777,
+    0.03686579691985189, -0.018637079571558777, -0.01829584898667091, 0.037288745330013265,
+    -0.01814709977885351, -0.020980260102638197, 0.03842831211221362, -0.011859937700410775,
+    -0.031232118321023662, 0.03582726352161462, 0.012110099474284711, -0.0460145657870965,
+    -0.0033600089844400306, 0.055775788586250624, 0.04653947075981801, 0.014190739125793207,
+    -0.006800157615289823, -0.03175495342041885, -0.05886044394387448, -0.029782683557593614,
+    0.03784508554399198, 0.023191638763602442, -0.04021564159683018, -0.0014800491361420564,
+    0.03782655441812914, -0.025773356818701038, -0.015198869152750111, 0.037670497912531554,
+    -0.019479737758967205, -0.01829584898667091, 0.03686579691985189, -0.018365005417229453,
+    -0.018365005417229453, 0.03686579691985189, -0.01829584898667091, -0.019479737758967205,
+    0.037670497912531554, -0.015198869152750111, -0.025773356818701038, 0.03782655441812914,
+    -0.0014800491361420564, -0.04021564159683018, 0.023191638763602442, 0.03784508554399198,
+    -0.029782683557593614, -0.05886044394387448, -0.03175495342041885, -0.006800157615289823,
+    0.002332434819536523, 0.01749326114652392, 0.04901875112671112, 0.05330742160134279,
+    -0.007701704963063591, -0.04504920132260558, 0.014998239101895496, 0.03416537032376719,
+    -0.032439351260796855, -0.010008367977771717, 0.03803633000201913, -0.021922898204612937,
+    -0.017213922456605385, 0.03713812206595289, -0.018637079571558777, -0.018365005417229453,
+    0.036730010834458905, -0.018365005417229453, -0.018637079571558777, 0.03713812206595289,
+    -0.017213922456605385, -0.021922898204612937, 0.03803633000201913, -0.010008367977771717,
+    -0.032439351260796855, 0.03416537032376719, 0.014998239101895496, -0.04504920132260558,
+    -0.007701704963063591, 0.05330742160134279, 0.04901875112671112, 0.01749326114652392,
+    0.002332434819536523, -0.006800157615289823, -0.03175495342041885, -0.05886044394387448,
+    -0.029782683557593614, 0.03784508554399198, 0.023191638763602442, -0.04021564159683018,
+    -0.0014800491361420564, 0.03782655441812914, -0.025773356818701038, -0.015198869152750111,
+    0.037670497912531554, -0.019479737758967205, -0.01829584898667091, 0.03686579691985189,
+    -0.018365005417229453, -0.018365005417229453, 0.03686579691985189, -0.01829584898667091,
+    -0.019479737758967205, 0.037670497912531554, -0.015198869152750111, -0.025773356818701038,
+    0.03782655441812914, -0.0014800491361420564, -0.04021564159683018, 0.023191638763602442,
+    0.03784508554399198, -0.029782683557593614, -0.05886044394387448, -0.03175495342041885,
+    -0.006800157615289823, 0.014190739125793207, 0.04653947075981801, 0.055775788586250624,
+    -0.0033600089844400306, -0.0460145657870965, 0.012110099474284711, 0.03582726352161462,
+    -0.031232118321023662, -0.011859937700410775, 0.03842831211221362, -0.020980260102638197,
+    -0.01814709977885351, 0.037288745330013265, -0.01829584898667091, -0.018637079571558777,
+    0.03686579691985189, -0.018637079571558777, -0.01829584898667091, 0.037288745330013265,
+    -0.01814709977885351, -0.020980260102638197, 0.03842831211221362, -0.011859937700410775,
+    -0.031232118321023662, 0.03582726352161462, 0.012110099474284711, -0.0460145657870965,
+    -0.0033600089844400306, 0.055775788586250624, 0.04653947075981801, 0.014190739125793207,
+    -0.02439633453002056, -0.05766112191581057, -0.03850957655394699, 0.033008845201087066,
+    0.02927628765579554, -0.03846034762840496, -0.006450641267776993, 0.03932573780534777,
+    -0.02331653674132676, -0.017894419176959823, 0.03805137529297539, -0.01814709977885351,
+    -0.019479737758967205, 0.03713812206595289, -0.01829584898667091, -0.01829584898667091,
+    0.03713812206595289, -0.019479737758967205, -0.01814709977885351, 0.03805137529297539,
+    -0.017894419176959823, -0.02331653674132676, 0.03932573780534777, -0.006450641267776993,
+    -0.03846034762840496, 0.02927628765579554, 0.033008845201087066, -0.03850957655394699,
+    -0.05766112191581057, -0.02439633453002056, 0.036524330106695854, 0.061116893992414975,
+    0.010976918204446077, -0.047172204086926656, 0.0025451765996826314, 0.04014710529172678,
+    -0.026835187064573413, -0.017490093546632834, 0.03926516262847559, -0.017894419176959823,
+    -0.020980260102638197, 0.037670497912531554, -0.017213922456605385, -0.019479737758967205,
+    0.037288745330013265, -0.019479737758967205, -0.017213922456605385, 0.037670497912531554,
+    -0.020980260102638197, -0.017894419176959823, 0.03926516262847559, -0.017490093546632834,
+    -0.026835187064573413, 0.04014710529172678, 0.0025451765996826314, -0.047172204086926656,
+    0.010976918204446077, 0.061116893992414975, 0.036524330106695854, -0.049002530970728445,
+    -0.05444725663414272, 0.018862197257764036, 0.04029752117966596, -0.03228026116417114,
+    -0.016838621425166362, 0.041161074594851105, -0.017490093546632834, -0.02331653674132676,
+    0.03842831211221362, -0.015198869152750111, -0.021922898204612937, 0.037670497912531554,
+    -0.01814709977885351, -0.01814709977885351, 0.037670497912531554, -0.021922898204612937,
+    -0.015198869152750111, 0.03842831211221362, -0.02331653674132676, -0.017490093546632834,
+    0.041161074594851105, -0.016838621425166362, -0.03228026116417114, 0.04029752117966596,
+    0.018862197257764036, -0.05444725663414272, -0.049002530970728445, 0.05989198229755699,
+    0.03767031413024793, -0.04172236023864111, -0.015722270889929855, 0.04427720455204181,
+    -0.016838621425166362, -0.026835187064573413, 0.03932573780534777, -0.011859937700410775,
+    -0.025773356818701038, 0.03803633000201913, -0.015198869152750111, -0.020980260102638197,
+    0.03805137529297539, -0.020980260102638197, -0.015198869152750111, 0.03803633000201913,
+    -0.025773356818701038, -0.011859937700410775, 0.03932573780534777, -0.026835187064573413,
+    -0.016838621425166362, 0.04427720455204181, -0.015722270889929855, -0.04172236023864111,
+    0.03767031413024793, 0.05989198229755699, -0.06732818568756019, -0.013465637137512037,
+    0.05026757490132502, -0.015722270889929855, -0.03228026116417114, 0.04014710529172678,
+    -0.006450641267776993, -0.031232118321023662, 0.03782655441812914, -0.010008367977771717,
+    -0.025773356818701038, 0.03842831211221362, -0.017894419176959823, -0.017894419176959823,
+    0.03842831211221362, -0.025773356818701038, -0.010008367977771717, 0.03782655441812914,
+    -0.031232118321023662, -0.006450641267776993, 0.04014710529172678, -0.03228026116417114,
+    -0.015722270889929855, 0.05026757490132502, -0.013465637137512037, -0.06732818568756019,
+    0.06996950303537157, -0.013465637137512037, -0.04172236023864111, 0.04029752117966596,
+    0.0025451765996826314, -0.03846034762840496, 0.03582726352161462, -0.0014800491361420564,
+    -0.032439351260796855, 0.03782655441812914, -0.011859937700410775, -0.02331653674132676,
+    0.03926516262847559, -0.02331653674132676, -0.011859937700410775, 0.03782655441812914,
+    -0.032439351260796855, -0.0014800491361420564, 0.03582726352161462, -0.03846034762840496,
+    0.0025451765996826314, 0.04029752117966596, -0.04172236023864111, -0.013465637137512037,
+    0.06996950303537157, -0.06732818568756019, 0.03767031413024793, 0.018862197257764036,
+    -0.047172204086926656, 0.02927628765579554, 0.012110099474284711, -0.04021564159683018,
+    0.03416537032376719, -0.0014800491361420564, -0.031232118321023662, 0.03932573780534777,
+    -0.017490093546632834, -0.017490093546632834, 0.03932573780534777, -0.031232118321023662,
+    -0.0014800491361420564, 0.03416537032376719, -0.04021564159683018, 0.012110099474284711,
+    0.02927628765579554, -0.047172204086926656, 0.018862197257764036, 0.03767031413024793,
+    -0.06732818568756019, 0.05989198229755699, -0.05444725663414272, 0.010976918204446077,
+    0.033008845201087066, -0.0460145657870965, 0.023191638763602442, 0.014998239101895496,
+    -0.04021564159683018, 0.03582726352161462, -0.006450641267776993, -0.026835187064573413,
+    0.041161074594851105, -0.026835187064573413, -0.006450641267776993, 0.03582726352161462,
+    -0.04021564159683018, 0.014998239101895496, 0.023191638763602442, -0.0460145657870965,
+    0.033008845201087066, 0.010976918204446077, -0.05444725663414272, 0.05989198229755699,
+    -0.049002530970728445, 0.061116893992414975, -0.03850957655394699, -0.0033600089844400306,
+    0.03784508554399198, -0.04504920132260558, 0.023191638763602442, 0.012110099474284711,
+    -0.03846034762840496, 0.04014710529172678, -0.016838621425166362, -0.016838621425166362,
+    0.04014710529172678, -0.03846034762840496, 0.012110099474284711, 0.023191638763602442,
+    -0.04504920132260558, 0.03784508554399198, -0.0033600089844400306, -0.03850957655394699,
+    0.061116893992414975, -0.049002530970728445, 0.036524330106695854, -0.05766112191581057,
+    0.055775788586250624, -0.029782683557593614, -0.007701704963063591, 0.03784508554399198,
+    -0.0460145657870965, 0.02927628765579554, 0.0025451765996826314, -0.03228026116417114,
+    0.04427720455204181, -0.03228026116417114, 0.0025451765996826314, 0.02927628765579554,
+    -0.0460145657870965, 0.03784508554399198, -0.007701704963063591, -0.029782683557593614,
+    0.055775788586250624, -0.05766112191581057, 0.036524330106695854, -0.02439633453002056,
+    0.04653947075981801, -0.05886044394387448, 0.05330742160134279, -0.029782683557593614,
+    -0.0033600089844400306, 0.033008845201087066, -0.047172204086926656, 0.04029752117966596,
+    -0.015722270889929855, -0.015722270889929855, 0.04029752117966596, -0.047172204086926656,
+    0.033008845201087066, -0.0033600089844400306, -0.029782683557593614, 0.05330742160134279,
+    -0.05886044394387448, 0.04653947075981801, -0.02439633453002056, 0.014190739125793207,
+    -0.03175495342041885, 0.04901875112671112, -0.05886044394387448, 0.055775788586250624,
+    -0.03850957655394699, 0.010976918204446077, 0.018862197257764036, -0.04172236023864111,
+    0.05026757490132502, -0.04172236023864111, 0.018862197257764036, 0.010976918204446077,
+    -0.03850957655394699, 0.055775788586250624, -0.05886044394387448, 0.04901875112671112,
+    -0.03175495342041885, 0.014190739125793207, -0.006800157615289823, 0.01749326114652392,
+    -0.03175495342041885, 0.04653947075981801, -0.05766112191581057, 0.061116893992414975,
+    -0.05444725663414272, 0.03767031413024793, -0.013465637137512037, -0.013465637137512037,
+    0.03767031413024793, -0.05444725663414272, 0.061116893992414975, -0.05766112191581057,
+    0.04653947075981801, -0.03175495342041885, 0.01749326114652392, -0.006800157615289823,
+    0.002332434819536523, -0.006800157615289823, 0.014190739125793207, -0.02439633453002056,
+    0.036524330106695854, -0.049002530970728445, 0.05989198229755699, -0.06732818568756019,
+    0.06996950303537157, -0.06732818568756019, 0.05989198229755699, -0.049002530970728445,
+    0.036524330106695854, -0.02439633453002056, 0.014190739125793207, -0.006800157615289823,
+    0.002332434819536523, 0.0017430351706682638, -0.005229105512004791, 0.011222567573749308,
+    -0.01983888408430599, 0.030547808720168414, -0.042181056145679366, 0.053124807143824525,
+    -0.06165542478218704, 0.06633067594020957, -0.06633067594020957, 0.06165542478218704,
+    -0.053124807143824525, 0.042181056145679366, -0.030547808720168414, 0.01983888408430599,
+    -0.011222567573749308, 0.005229105512004791, -0.0017430351706682638, -0.005229105512004791,
+    0.01394428136534611, -0.026271987923296436, 0.040072581556208235, -0.05194166419616664,
+    0.05817466389970664, -0.055937562598944036, 0.044252599268367825, -0.024461544628521993,
+    0.0, 0.024461544628521993, -0.044252599268367825, 0.055937562598944036,
+    -0.05817466389970664, 0.05194166419616664, -0.040072581556208235, 0.026271987923296436,
+    -0.01394428136534611, 0.005229105512004791, 0.011222567573749308, -0.026271987923296436,
+    0.04262513280997845, -0.05431750219531801, 0.05581296007723946, -0.0444772428723558,
+    0.021985802085253255, 0.005901803984617525, -0.031132874981755262, 0.04605956564248058,
+    -0.04605956564248058, 0.031132874981755262, -0.005901803984617525, -0.021985802085253255,
+    0.0444772428723558, -0.05581296007723946, 0.05431750219531801, -0.04262513280997845,
+    0.026271987923296436, -0.011222567573749308, -0.01983888408430599, 0.040072581556208235,
+    -0.05431750219531801, 0.054351005776292226, -0.037587226681516275, 0.008859200012260232,
+    0.021404167109452903, -0.04160150009219351, 0.043935651885486024, -0.027774963135064168,
+    0.0, 0.027774963135064168, -0.043935651885486024, 0.04160150009219351,
+    -0.021404167109452903, -0.008859200012260232, 0.037587226681516275, -0.054351005776292226,
+    0.05431750219531801, -0.040072581556208235, 0.01983888408430599, 0.030547808720168414,
+    -0.05194166419616664, 0.05581296007723946, -0.037587226681516275, 0.004694949572606452,
+    0.027469032528210216, -0.04378704734301017, 0.037147656387073826, -0.011818442611335637,
+    -0.018917278287409266, 0.039437797520839125, -0.039437797520839125, 0.018917278287409266,
+    0.011818442611335637, -0.037147656387073826, 0.04378704734301017, -0.027469032528210216,
+    -0.004694949572606452, 0.037587226681516275, -0.05581296007723946, 0.05194166419616664,
+    -0.030547808720168414, -0.042181056145679366, 0.05817466389970664, -0.0444772428723558,
+    0.008859200012260232, 0.027469032528210216, -0.0439285755329122, 0.03275064400283913,
+    -0.002481955250691748, -0.0280313680086187, 0.0408826054359804, -0.029073930064566367,
+    0.0, 0.029073930064566367, -0.0408826054359804, 0.0280313680086187,
+    0.002481955250691748, -0.03275064400283913, 0.0439285755329122, -0.027469032528210216,
+    -0.008859200012260232, 0.0444772428723558, -0.05817466389970664, 0.042181056145679366,
+    0.053124807143824525, -0.055937562598944036, 0.021985802085253255, 0.021404167109452903,
+    -0.04378704734301017, 0.03275064400283913, 0.0004969650787439751, -0.031478857394074876,
+    0.039572314531603744, -0.020634911822652164, -0.011729746062562187, 0.03581220655585093,
+    -0.03581220655585093, 0.011729746062562187, 0.020634911822652164, -0.039572314531603744,
+    0.031478857394074876, -0.0004969650787439751, -0.03275064400283913, 0.04378704734301017,
+    -0.021404167109452903, -0.021985802085253255, 0.055937562598944036, -0.053124807143824525,
+    -0.06165542478218704, 0.044252599268367825, 0.005901803984617525, -0.04160150009219351,
+    0.037147656387073826, -0.002481955250691748, -0.031478857394074876, 0.03883554274330157,
+    -0.0162374321580816, -0.017709489651333135, 0.03767070371724776, -0.0296466823298746,
+    0.0, 0.0296466823298746, -0.03767070371724776, 0.017709489651333135,
+    0.0162374321580816, -0.03883554274330157, 0.031478857394074876, 0.002481955250691748,
+    -0.037147656387073826, 0.04160150009219351, -0.005901803984617525, -0.044252599268367825,
+    0.06165542478218704, 0.06633067594020957, -0.024461544628521993, -0.031132874981755262,
+    0.043935651885486024, -0.011818442611335637, -0.0280313680086187, 0.039572314531603744,
+    -0.0162374321580816, -0.0195091328065916, 0.03790996708892741, -0.025342972726045895,
+    -0.007058733888065381, 0.03351226374434976, -0.03351226374434976, 0.007058733888065381,
+    0.025342972726045895, -0.03790996708892741, 0.0195091328065916, 0.0162374321580816,
+    -0.039572314531603744, 0.0280313680086187, 0.011818442611335637, -0.043935651885486024,
+    0.031132874981755262, 0.024461544628521993, -0.06633067594020957, -0.06633067594020957,
+    0.0, 0.04605956564248058, -0.027774963135064168, -0.018917278287409266,
+    0.0408826054359804, -0.020634911822652164, -0.017709489651333135, 0.03790996708892741,
+    -0.023842573112837388, -0.010298671573246517, 0.034910987842325304, -0.02989771714360907,
+    0.0, 0.02989771714360907, -0.034910987842325304, 0.010298671573246517,
+    0.023842573112837388, -0.03790996708892741, 0.017709489651333135, 0.020634911822652164,
+    -0.0408826054359804, 0.018917278287409266, 0.027774963135064168, -0.04605956564248058,
+    0.0, 0.06633067594020957, 0.06165542478218704, 0.024461544628521993,
+    -0.04605956564248058, 0.0, 0.039437797520839125, -0.029073930064566367,
+    -0.011729746062562187, 0.03767070371724776, -0.025342972726045895, -0.010298671573246517,
+    0.035236460363309956, -0.027914074143408192, -0.003930156983391267, 0.03197798106536353,
+    -0.03197798106536353, 0.003930156983391267, 0.027914074143408192, -0.035236460363309956,
+    0.010298671573246517, 0.025342972726045895, -0.03767070371724776, 0.011729746062562187,
+    0.029073930064566367, -0.039437797520839125, 0.0, 0.04605956564248058,
+    -0.024461544628521993, -0.06165542478218704, -0.053124807143824525, -0.044252599268367825,
+    0.031132874981755262, 0.027774963135064168, -0.039437797520839125, 0.0,
+    0.03581220655585093, -0.0296466823298746, -0.007058733888065381, 0.034910987842325304,
+    -0.027914074143408192, -0.005183865444542137, 0.03275883438521618, -0.029998005271263267,
+    0.0, 0.029998005271263267, -0.03275883438521618, 0.005183865444542137,
+    0.027914074143408192, -0.034910987842325304, 0.007058733888065381, 0.0296466823298746,
+    -0.03581220655585093, 0.0, 0.039437797520839125, -0.027774963135064168,
+    -0.031132874981755262, 0.044252599268367825, 0.053124807143824525, 0.042181056145679366,
+    0.055937562598944036, -0.005901803984617525, -0.043935651885486024, 0.018917278287409266,
+    0.029073930064566367, -0.03581220655585093, 0.0, 0.03351226374434976,
+    -0.02989771714360907, -0.003930156983391267, 0.03275883438521618, -0.029309423992358582,
+    -0.0018641186409721468, 0.0309607520455798, -0.0309607520455798, 0.0018641186409721468,
+    0.029309423992358582, -0.03275883438521618, 0.003930156983391267, 0.02989771714360907,
+    -0.03351226374434976, 0.0, 0.03581220655585093, -0.029073930064566367,
+    -0.018917278287409266, 0.043935651885486024, 0.005901803984617525, -0.055937562598944036,
+    -0.042181056145679366, -0.030547808720168414, -0.05817466389970664, -0.021985802085253255,
+    0.04160150009219351, 0.011818442611335637, -0.0408826054359804, 0.011729746062562187,
+    0.0296466823298746, -0.03351226374434976, 0.0, 0.03197798106536353,
+    -0.029998005271263267, -0.0018641186409721468, 0.03123762029628471, -0.030030165526296216,
+    0.0, 0.030030165526296216, -0.03123762029628471, 0.0018641186409721468,
+    0.029998005271263267, -0.03197798106536353, 0.0, 0.03351226374434976,
+    -0.0296466823298746, -0.011729746062562187, 0.0408826054359804, -0.011818442611335637,
+    -0.04160150009219351, 0.021985802085253255, 0.05817466389970664, 0.030547808720168414,
+    0.01983888408430599, 0.05194166419616664, 0.0444772428723558, -0.021404167109452903,
+    -0.037147656387073826, 0.0280313680086187, 0.020634911822652164, -0.03767070371724776,
+    0.007058733888065381, 0.02989771714360907, -0.03197798106536353, 0.0,
+    0.0309607520455798, -0.030030165526296216, -0.0006007234672362444, 0.030335048119712202,
+    -0.030335048119712202, 0.0006007234672362444, 0.030030165526296216, -0.0309607520455798,
+    0.0, 0.03197798106536353, -0.02989771714360907, -0.007058733888065381,
+    0.03767070371724776, -0.020634911822652164, -0.0280313680086187, 0.037147656387073826,
+    0.021404167109452903, -0.0444772428723558, -0.05194166419616664, -0.01983888408430599,
+    -0.011222567573749308, -0.040072581556208235, -0.05581296007723946, -0.008859200012260232,
+    0.04378704734301017, 0.002481955250691748, -0.039572314531603744, 0.017709489651333135,
+    0.025342972726045895, -0.034910987842325304, 0.003930156983391267, 0.029998005271263267,
+    -0.0309607520455798, 0.0, 0.030335048119712202, -0.030036173361812222,
+    0.0, 0.030036173361812222, -0.030335048119712202, 0.0,
+    0.0309607520455798, -0.029998005271263267, -0.003930156983391267, 0.034910987842325304,
+    -0.025342972726045895, -0.017709489651333135, 0.039572314531603744, -0.002481955250691748,
+    -0.04378704734301017, 0.008859200012260232, 0.05581296007723946, 0.040072581556208235,
+    0.011222567573749308, 0.005229105512004791, 0.026271987923296436, 0.05431750219531801,
+    0.037587226681516275, -0.027469032528210216, -0.03275064400283913, 0.031478857394074876,
+    0.0162374321580816, -0.03790996708892741, 0.010298671573246517, 0.027914074143408192,
+    -0.03275883438521618, 0.0018641186409721468, 0.030030165526296216, -0.030335048119712202,
+    0.0, 0.030036173361812222, -0.030036173361812222, 0.0,
+    0.030335048119712202, -0.030030165526296216, -0.0018641186409721468, 0.03275883438521618,
+    -0.027914074143408192, -0.010298671573246517, 0.03790996708892741, -0.0162374321580816,
+    -0.031478857394074876, 0.03275064400283913, 0.027469032528210216, -0.037587226681516275,
+    -0.05431750219531801, -0.026271987923296436, -0.005229105512004791, -0.0017430351706682638,
+    -0.01394428136534611, -0.04262513280997845, -0.054351005776292226, -0.004694949572606452,
+    0.0439285755329122, -0.0004969650787439751, -0.03883554274330157, 0.0195091328065916,
+    0.023842573112837388, -0.035236460363309956, 0.005183865444542137, 0.029309423992358582,
+    -0.03123762029628471, 0.0006007234672362444, 0.030036173361812222, -0.030036173361812222,
+    0.0, 0.030036173361812222, -0.030036173361812222, -0.0006007234672362444,
+    0.03123762029628471, -0.029309423992358582, -0.005183865444542137, 0.035236460363309956,
+    -0.023842573112837388, -0.0195091328065916, 0.03883554274330157, 0.0004969650787439751,
+    -0.0439285755329122, 0.004694949572606452, 0.054351005776292226, 0.04262513280997845,
+    0.01394428136534611, 0.0017430351706682638, 0.005229105512004791, 0.026271987923296436,
+    0.05431750219531801, 0.037587226681516275, -0.027469032528210216, -0.03275064400283913,
+    0.031478857394074876, 0.0162374321580816, -0.03790996708892741, 0.010298671573246517,
+    0.027914074143408192, -0.03275883438521618, 0.0018641186409721468, 0.030030165526296216,
+    -0.030335048119712202, 0.0, 0.030036173361812222, -0.030036173361812222,
+    0.0, 0.030335048119712202, -0.030030165526296216, -0.0018641186409721468,
+    0.03275883438521618, -0.027914074143408192, -0.010298671573246517, 0.03790996708892741,
+    -0.0162374321580816, -0.031478857394074876, 0.03275064400283913, 0.027469032528210216,
+    -0.037587226681516275, -0.05431750219531801, -0.026271987923296436, -0.005229105512004791,
+    -0.011222567573749308, -0.040072581556208235, -0.05581296007723946, -0.008859200012260232,
+    0.04378704734301017, 0.002481955250691748, -0.039572314531603744, 0.017709489651333135,
+    0.025342972726045895, -0.034910987842325304, 0.003930156983391267, 0.029998005271263267,
+    -0.0309607520455798, 0.0, 0.030335048119712202, -0.030036173361812222,
+    0.0, 0.030036173361812222, -0.030335048119712202, 0.0,
+    0.0309607520455798, -0.029998005271263267, -0.003930156983391267, 0.034910987842325304,
+    -0.025342972726045895, -0.017709489651333135, 0.039572314531603744, -0.002481955250691748,
+    -0.04378704734301017, 0.008859200012260232, 0.05581296007723946, 0.040072581556208235,
+    0.011222567573749308, 0.01983888408430599, 0.05194166419616664, 0.0444772428723558,
+    -0.021404167109452903, -0.037147656387073826, 0.0280313680086187, 0.020634911822652164,
+    -0.03767070371724776, 0.007058733888065381, 0.02989771714360907, -0.03197798106536353,
+    0.0, 0.0309607520455798, -0.030030165526296216, -0.0006007234672362444,
+    0.030335048119712202, -0.030335048119712202, 0.0006007234672362444, 0.030030165526296216,
+    -0.0309607520455798, 0.0, 0.03197798106536353, -0.02989771714360907,
+    -0.007058733888065381, 0.03767070371724776, -0.020634911822652164, -0.0280313680086187,
+    0.037147656387073826, 0.021404167109452903, -0.0444772428723558, -0.05194166419616664,
+    -0.01983888408430599, -0.030547808720168414, -0.05817466389970664, -0.021985802085253255,
+    0.04160150009219351, 0.011818442611335637, -0.0408826054359804, 0.011729746062562187,
+    0.0296466823298746, -0.03351226374434976, 0.0, 0.03197798106536353,
+    -0.029998005271263267, -0.0018641186409721468, 0.03123762029628471, -0.030030165526296216,
+    0.0, 0.030030165526296216, -0.03123762029628471, 0.0018641186409721468,
+    0.029998005271263267, -0.03197798106536353, 0.0, 0.03351226374434976,
+    -0.0296466823298746, -0.011729746062562187, 0.0408826054359804, -0.011818442611335637,
+    -0.04160150009219351, 0.021985802085253255, 0.05817466389970664, 0.030547808720168414,
+    0.042181056145679366, 0.055937562598944036, -0.005901803984617525, -0.043935651885486024,
+    0.018917278287409266, 0.029073930064566367, -0.03581220655585093, 0.0,
+    0.03351226374434976, -0.02989771714360907, -0.003930156983391267, 0.03275883438521618,
+    -0.029309423992358582, -0.0018641186409721468, 0.0309607520455798, -0.0309607520455798,
+    0.0018641186409721468, 0.029309423992358582, -0.03275883438521618, 0.003930156983391267,
+    0.02989771714360907, -0.03351226374434976, 0.0, 0.03581220655585093,
+    -0.029073930064566367, -0.018917278287409266, 0.043935651885486024, 0.005901803984617525,
+    -0.055937562598944036, -0.042181056145679366, -0.053124807143824525, -0.044252599268367825,
+    0.031132874981755262, 0.027774963135064168, -0.039437797520839125, 0.0,
+    0.03581220655585093, -0.0296466823298746, -0.007058733888065381, 0.034910987842325304,
+    -0.027914074143408192, -0.005183865444542137, 0.03275883438521618, -0.029998005271263267,
+    0.0, 0.029998005271263267, -0.03275883438521618, 0.005183865444542137,
+    0.027914074143408192, -0.034910987842325304, 0.007058733888065381, 0.0296466823298746,
+    -0.03581220655585093, 0.0, 0.039437797520839125, -0.027774963135064168,
+    -0.031132874981755262, 0.044252599268367825, 0.053124807143824525, 0.06165542478218704,
+    0.024461544628521993, -0.04605956564248058, 0.0, 0.039437797520839125,
+    -0.029073930064566367, -0.011729746062562187, 0.03767070371724776, -0.025342972726045895,
+    -0.010298671573246517, 0.035236460363309956, -0.027914074143408192, -0.003930156983391267,
+    0.03197798106536353, -0.03197798106536353, 0.003930156983391267, 0.027914074143408192,
+    -0.035236460363309956, 0.010298671573246517, 0.025342972726045895, -0.03767070371724776,
+    0.011729746062562187, 0.029073930064566367, -0.039437797520839125, 0.0,
+    0.04605956564248058, -0.024461544628521993, -0.06165542478218704, -0.06633067594020957,
+    0.0, 0.04605956564248058, -0.027774963135064168, -0.018917278287409266,
+    0.0408826054359804, -0.020634911822652164, -0.017709489651333135, 0.03790996708892741,
+    -0.023842573112837388, -0.010298671573246517, 0.034910987842325304, -0.02989771714360907,
+    0.0, 0.02989771714360907, -0.034910987842325304, 0.010298671573246517,
+    0.023842573112837388, -0.03790996708892741, 0.017709489651333135, 0.020634911822652164,
+    -0.0408826054359804, 0.018917278287409266, 0.027774963135064168, -0.04605956564248058,
+    0.0, 0.06633067594020957, 0.06633067594020957, -0.024461544628521993,
+    -0.031132874981755262, 0.043935651885486024, -0.011818442611335637, -0.0280313680086187,
+    0.039572314531603744, -0.0162374321580816, -0.0195091328065916, 0.03790996708892741,
+    -0.025342972726045895, -0.007058733888065381, 0.03351226374434976, -0.03351226374434976,
+    0.007058733888065381, 0.025342972726045895, -0.03790996708892741, 0.0195091328065916,
+    0.0162374321580816, -0.039572314531603744, 0.0280313680086187, 0.011818442611335637,
+    -0.043935651885486024, 0.031132874981755262, 0.024461544628521993, -0.06633067594020957,
+    -0.06165542478218704, 0.044252599268367825, 0.005901803984617525, -0.04160150009219351,
+    0.037147656387073826, -0.002481955250691748, -0.031478857394074876, 0.03883554274330157,
+    -0.0162374321580816, -0.017709489651333135, 0.03767070371724776, -0.0296466823298746,
+    0.0, 0.0296466823298746, -0.03767070371724776, 0.017709489651333135,
+    0.0162374321580816, -0.03883554274330157, 0.031478857394074876, 0.002481955250691748,
+    -0.037147656387073826, 0.04160150009219351, -0.005901803984617525, -0.044252599268367825,
+    0.06165542478218704, 0.053124807143824525, -0.055937562598944036, 0.021985802085253255,
+    0.021404167109452903, -0.04378704734301017, 0.03275064400283913, 0.0004969650787439751,
+    -0.031478857394074876, 0.039572314531603744, -0.020634911822652164, -0.011729746062562187,
+    0.03581220655585093, -0.03581220655585093, 0.011729746062562187, 0.020634911822652164,
+    -0.039572314531603744, 0.031478857394074876, -0.0004969650787439751, -0.03275064400283913,
+    0.04378704734301017, -0.021404167109452903, -0.021985802085253255, 0.055937562598944036,
+    -0.053124807143824525, -0.042181056145679366, 0.05817466389970664, -0.0444772428723558,
+    0.008859200012260232, 0.027469032528210216, -0.0439285755329122, 0.03275064400283913,
+    -0.002481955250691748, -0.0280313680086187, 0.0408826054359804, -0.029073930064566367,
+    0.0, 0.029073930064566367, -0.0408826054359804, 0.0280313680086187,
+    0.002481955250691748, -0.03275064400283913, 0.0439285755329122, -0.027469032528210216,
+    -0.008859200012260232, 0.0444772428723558, -0.05817466389970664, 0.042181056145679366,
+    0.030547808720168414, -0.05194166419616664, 0.05581296007723946, -0.037587226681516275,
+    0.004694949572606452, 0.027469032528210216, -0.04378704734301017, 0.037147656387073826,
+    -0.011818442611335637, -0.018917278287409266, 0.039437797520839125, -0.039437797520839125,
+    0.018917278287409266, 0.011818442611335637, -0.037147656387073826, 0.04378704734301017,
+    -0.027469032528210216, -0.004694949572606452, 0.037587226681516275, -0.05581296007723946,
+    0.05194166419616664, -0.030547808720168414, -0.01983888408430599, 0.040072581556208235,
+    -0.05431750219531801, 0.054351005776292226, -0.037587226681516275, 0.008859200012260232,
+    0.021404167109452903, -0.04160150009219351, 0.043935651885486024, -0.027774963135064168,
+    0.0, 0.027774963135064168, -0.043935651885486024, 0.04160150009219351,
+    -0.021404167109452903, -0.008859200012260232, 0.037587226681516275, -0.054351005776292226,
+    0.05431750219531801, -0.040072581556208235, 0.01983888408430599, 0.011222567573749308,
+    -0.026271987923296436, 0.04262513280997845, -0.05431750219531801, 0.05581296007723946,
+    -0.0444772428723558, 0.021985802085253255, 0.005901803984617525, -0.031132874981755262,
+    0.04605956564248058, -0.04605956564248058, 0.031132874981755262, -0.005901803984617525,
+    -0.021985802085253255, 0.0444772428723558, -0.05581296007723946, 0.05431750219531801,
+    -0.04262513280997845, 0.026271987923296436, -0.011222567573749308, -0.005229105512004791,
+    0.01394428136534611, -0.026271987923296436, 0.040072581556208235, -0.05194166419616664,
+    0.05817466389970664, -0.055937562598944036, 0.044252599268367825, -0.024461544628521993,
+    0.0, 0.024461544628521993, -0.044252599268367825, 0.055937562598944036,
+    -0.05817466389970664, 0.05194166419616664, -0.040072581556208235, 0.026271987923296436,
+    -0.01394428136534611, 0.005229105512004791, 0.0017430351706682638, -0.005229105512004791,
+    0.011222567573749308, -0.01983888408430599, 0.030547808720168414, -0.042181056145679366,
+    0.053124807143824525, -0.06165542478218704, 0.06633067594020957, -0.06633067594020957,
+    0.06165542478218704, -0.053124807143824525, 0.042181056145679366, -0.030547808720168414,
+    0.01983888408430599, -0.011222567573749308, 0.005229105512004791, -0.0017430351706682638,
+    0.0013047409207377007, -0.004021481601021059, 0.008862913783126458, -0.016085926404084235,
+    0.025434082855374122, -0.036081453664199105, 0.04673097595438579, -0.05585419940279951,
+    0.06201472972293868, -0.0641913437305869, 0.06201472972293868, -0.05585419940279951,
+    0.04673097595438579, -0.036081453664199105, 0.025434082855374122, -0.016085926404084235,
+    0.008862913783126458, -0.004021481601021059, 0.0013047409207377007, -0.004021481601021059,
+    0.011090297826270456, -0.021629654376535128, 0.034224809993309374, -0.04620330597793104,
+    0.05429000161378429, -0.05555803139913008, 0.048371155590866, -0.03300307057717762,
+    0.011719682319270088, 0.011719682319270088, -0.03300307057717762, 0.048371155590866,
+    -0.05555803139913008, 0.05429000161378429, -0.04620330597793104, 0.034224809993309374,
+    -0.021629654376535128, 0.011090297826270456, -0.004021481601021059, 0.008862913783126458,
+    -0.021629654376535128, 0.036719137340761, -0.04931818185098251, 0.05422841339019883,
+    -0.04802382253689016, 0.030661955327869358, -0.005891591825620426, -0.0197377113768079,
+    0.03892975414086468, -0.04603399829904926, 0.03892975414086468, -0.0197377113768079,
+    -0.005891591825620426, 0.030661955327869358, -0.04802382253689016, 0.05422841339019883,
+    -0.04931818185098251, 0.036719137340761, -0.021629654376535128, 0.008862913783126458,
+    -0.016085926404084235, 0.034224809993309374, -0.04931818185098251, 0.05358757353029842,
+    -0.04290306983665025, 0.019243518181438157, 0.009699043537804111, -0.03352769397781691,
+    0.04340564707727172, -0.035740035642216395, 0.013745665494121932, 0.013745665494121932,
+    -0.035740035642216395, 0.04340564707727172, -0.03352769397781691, 0.009699043537804111,
+    0.019243518181438157, -0.04290306983665025, 0.05358757353029842, -0.04931818185098251,
+    0.034224809993309374, -0.016085926404084235, 0.025434082855374122, -0.04620330597793104,
+    0.05422841339019883, -0.04290306983665025, 0.015470499488747022, 0.01635048183559765,
+    -0.03831736454607647, 0.04077841448577397, -0.023344498615084593, -0.005026352155495699,
+    0.030392809958491737, -0.040466143530873036, 0.030392809958491737, -0.005026352155495699,
+    -0.023344498615084593, 0.04077841448577397, -0.03831736454607647, 0.01635048183559765,
+    0.015470499488747022, -0.04290306983665025, 0.05422841339019883, -0.04620330597793104,
+    0.025434082855374122, -0.036081453664199105, 0.05429000161378429, -0.04802382253689016,
+    0.019243518181438157, 0.01635048183559765, -0.039375217072262755, 0.038227703390916495,
+    -0.015195480876658785, -0.015577729793770681, 0.036427627581107305, -0.03591182640396406,
+    0.014776146418067274, 0.014776146418067274, -0.03591182640396406, 0.036427627581107305,
+    -0.015577729793770681, -0.015195480876658785, 0.038227703390916495, -0.039375217072262755,
+    0.01635048183559765, 0.019243518181438157, -0.04802382253689016, 0.05429000161378429,
+    -0.036081453664199105, 0.04673097595438579, -0.05555803139913008, 0.030661955327869358,
+    0.009699043537804111, -0.03831736454607647, 0.038227703390916495, -0.012461177687690712,
+    -0.020074613689540676, 0.037907925294660534, -0.030389089420120526, 0.0033617153771855045,
+    0.025393803691065763, -0.03753144943335908, 0.025393803691065763, 0.0033617153771855045,
+    -0.030389089420120526, 0.037907925294660534, -0.020074613689540676, -0.012461177687690712,
+    0.038227703390916495, -0.03831736454607647, 0.009699043537804111, 0.030661955327869358,
+    -0.05555803139913008, 0.04673097595438579, -0.05585419940279951, 0.048371155590866,
+    -0.005891591825620426, -0.03352769397781691, 0.04077841448577397, -0.015195480876658785,
+    -0.020074613689540676, 0.038079495097981766, -0.02713477165544653, -0.0030865561497699394,
+    0.03024385525866823, -0.035367742510235445, 0.015395638021716078, 0.015395638021716078,
+    -0.035367742510235445, 0.03024385525866823, -0.0030865561497699394, -0.02713477165544653,
+    0.038079495097981766, -0.020074613689540676, -0.015195480876658785, 0.04077841448577397,
+    -0.03352769397781691, -0.005891591825620426, 0.048371155590866, -0.05585419940279951,
+    0.06201472972293868, -0.03300307057717762, -0.0197377113768079, 0.04340564707727172,
+    -0.023344498615084593, -0.015577729793770681, 0.037907925294660534, -0.02713477165544653,
+    -0.005134061186996236, 0.032016738327393095, -0.0330670126507366, 0.008601683939533786,
+    0.022080648802315684, -0.03570762718433615, 0.022080648802315684, 0.008601683939533786,
+    -0.0330670126507366, 0.032016738327393095, -0.005134061186996236, -0.02713477165544653,
+    0.037907925294660534, -0.015577729793770681, -0.023344498615084593, 0.04340564707727172,
+    -0.0197377113768079, -0.03300307057717762, 0.06201472972293868, -0.0641913437305869,
+    0.011719682319270088, 0.03892975414086468, -0.035740035642216395, -0.005026352155495699,
+    0.036427627581107305, -0.030389089420120526, -0.0030865561497699394, 0.032016738327393095,
+    -0.03216431021499327, 0.005268628994424059, 0.025294797069790202, -0.03465307055560398,
+    0.01579440720512491, 0.01579440720512491, -0.03465307055560398, 0.025294797069790202,
+    0.005268628994424059, -0.03216431021499327, 0.032016738327393095, -0.0030865561497699394,
+    -0.030389089420120526, 0.036427627581107305, -0.005026352155495699, -0.035740035642216395,
+    0.03892975414086468, 0.011719682319270088, -0.0641913437305869, 0.06201472972293868,
+    0.011719682319270088, -0.04603399829904926, 0.013745665494121932, 0.030392809958491737,
+    -0.03591182640396406, 0.0033617153771855045, 0.03024385525866823, -0.0330670126507366,
+    0.005268628994424059, 0.026234663917858666, -0.03380748189477056, 0.01199406134328838,
+    0.01978955738340553, -0.03449684521604605, 0.01978955738340553, 0.01199406134328838,
+    -0.03380748189477056, 0.026234663917858666, 0.005268628994424059, -0.0330670126507366,
+    0.03024385525866823, 0.0033617153771855045, -0.03591182640396406, 0.030392809958491737,
+    0.013745665494121932, -0.04603399829904926, 0.011719682319270088, 0.06201472972293868,
+    -0.05585419940279951, -0.03300307057717762, 0.03892975414086468, 0.013745665494121932,
+    -0.040466143530873036, 0.014776146418067274, 0.025393803691065763, -0.035367742510235445,
+    0.008601683939533786, 0.025294797069790202, -0.03380748189477056, 0.010734775103588909,
+    0.02154761290740908, -0.03397716162642046, 0.01605740757832031, 0.01605740757832031,
+    -0.03397716162642046, 0.02154761290740908, 0.010734775103588909, -0.03380748189477056,
+    0.025294797069790202, 0.008601683939533786, -0.035367742510235445, 0.025393803691065763,
+    0.014776146418067274, -0.040466143530873036, 0.013745665494121932, 0.03892975414086468,
+    -0.03300307057717762, -0.05585419940279951, 0.04673097595438579, 0.048371155590866,
+    -0.0197377113768079, -0.035740035642216395, 0.030392809958491737, 0.014776146418067274,
+    -0.03753144943335908, 0.015395638021716078, 0.022080648802315684, -0.03465307055560398,
+    0.01199406134328838, 0.02154761290740908, -0.03374133001927757, 0.014197110982159655,
+    0.018207388779702623, -0.03368230229363357, 0.018207388779702623, 0.014197110982159655,
+    -0.03374133001927757, 0.02154761290740908, 0.01199406134328838, -0.03465307055560398,
+    0.022080648802315684, 0.015395638021716078, -0.03753144943335908, 0.014776146418067274,
+    0.030392809958491737, -0.035740035642216395, -0.0197377113768079, 0.048371155590866,
+    0.04673097595438579, -0.036081453664199105, -0.05555803139913008, -0.005891591825620426,
+    0.04340564707727172, -0.005026352155495699, -0.03591182640396406, 0.025393803691065763,
+    0.015395638021716078, -0.03570762718433615, 0.01579440720512491, 0.01978955738340553,
+    -0.03397716162642046, 0.014197110982159655, 0.018877328763231643, -0.03342967036216636,
+    0.016228539313173543, 0.016228539313173543, -0.03342967036216636, 0.018877328763231643,
+    0.014197110982159655, -0.03397716162642046, 0.01978955738340553, 0.01579440720512491,
+    -0.03570762718433615, 0.015395638021716078, 0.025393803691065763, -0.03591182640396406,
+    -0.005026352155495699, 0.04340564707727172, -0.005891591825620426, -0.05555803139913008,
+    -0.036081453664199105, 0.025434082855374122, 0.05429000161378429, 0.030661955327869358,
+    -0.03352769397781691, -0.023344498615084593, 0.036427627581107305, 0.0033617153771855045,
+    -0.035367742510235445, 0.022080648802315684, 0.01579440720512491, -0.03449684521604605,
+    0.01605740757832031, 0.018207388779702623, -0.03342967036216636, 0.015574891202332186,
+    0.017166433754219338, -0.033155160180033776, 0.017166433754219338, 0.015574891202332186,
+    -0.03342967036216636, 0.018207388779702623, 0.01605740757832031, -0.03449684521604605,
+    0.01579440720512491, 0.022080648802315684, -0.035367742510235445, 0.0033617153771855045,
+    0.036427627581107305, -0.023344498615084593, -0.03352769397781691, 0.030661955327869358,
+    0.05429000161378429, 0.025434082855374122, -0.016085926404084235, -0.04620330597793104,
+    -0.04802382253689016, 0.009699043537804111, 0.04077841448577397, -0.015577729793770681,
+    -0.030389089420120526, 0.03024385525866823, 0.008601683939533786, -0.03465307055560398,
+    0.01978955738340553, 0.01605740757832031, -0.03368230229363357, 0.016228539313173543,
+    0.017166433754219338, -0.033050654952980506, 0.016331972733181002, 0.016331972733181002,
+    -0.033050654952980506, 0.017166433754219338, 0.016228539313173543, -0.03368230229363357,
+    0.01605740757832031, 0.01978955738340553, -0.03465307055560398, 0.008601683939533786,
+    0.03024385525866823, -0.030389089420120526, -0.015577729793770681, 0.04077841448577397,
+    0.009699043537804111, -0.04802382253689016, -0.04620330597793104, -0.016085926404084235,
+    0.008862913783126458, 0.034224809993309374, 0.05422841339019883, 0.019243518181438157,
+    -0.03831736454607647, -0.015195480876658785, 0.037907925294660534, -0.0030865561497699394,
+    -0.0330670126507366, 0.025294797069790202, 0.01199406134328838, -0.03397716162642046,
+    0.018207388779702623, 0.016228539313173543, -0.033155160180033776, 0.016331972733181002,
+    0.016573506273797802, -0.03285779847665091, 0.016573506273797802, 0.016331972733181002,
+    -0.033155160180033776, 0.016228539313173543, 0.018207388779702623, -0.03397716162642046,
+    0.01199406134328838, 0.025294797069790202, -0.0330670126507366, -0.0030865561497699394,
+    0.037907925294660534, -0.015195480876658785, -0.03831736454607647, 0.019243518181438157,
+    0.05422841339019883, 0.034224809993309374, 0.008862913783126458, -0.004021481601021059,
+    -0.021629654376535128, -0.04931818185098251, -0.04290306983665025, 0.01635048183559765,
+    0.038227703390916495, -0.020074613689540676, -0.02713477165544653, 0.032016738327393095,
+    0.005268628994424059, -0.03380748189477056, 0.02154761290740908, 0.014197110982159655,
+    -0.03342967036216636, 0.017166433754219338, 0.016331972733181002, -0.03285779847665091,
+    0.016380791084567595, 0.016380791084567595, -0.03285779847665091, 0.016331972733181002,
+    0.017166433754219338, -0.03342967036216636, 0.014197110982159655, 0.02154761290740908,
+    -0.03380748189477056, 0.005268628994424059, 0.032016738327393095, -0.02713477165544653,
+    -0.020074613689540676, 0.038227703390916495, 0.01635048183559765, -0.04290306983665025,
+    -0.04931818185098251, -0.021629654376535128, -0.004021481601021059, 0.0013047409207377007,
+    0.011090297826270456, 0.036719137340761, 0.05358757353029842, 0.015470499488747022,
+    -0.039375217072262755, -0.012461177687690712, 0.038079495097981766, -0.005134061186996236,
+    -0.03216431021499327, 0.026234663917858666, 0.010734775103588909, -0.03374133001927757,
+    0.018877328763231643, 0.015574891202332186, -0.033050654952980506, 0.016573506273797802,
+    0.016380791084567595, -0.03276158216913519, 0.016380791084567595, 0.016573506273797802,
+    -0.033050654952980506, 0.015574891202332186, 0.018877328763231643, -0.03374133001927757,
+    0.010734775103588909, 0.026234663917858666, -0.03216431021499327, -0.005134061186996236,
+    0.038079495097981766, -0.012461177687690712, -0.039375217072262755, 0.015470499488747022,
+    0.05358757353029842, 0.036719137340761, 0.011090297826270456, 0.0013047409207377007,
+    -0.004021481601021059, -0.021629654376535128, -0.04931818185098251, -0.04290306983665025,
+    0.01635048183559765, 0.038227703390916495, -0.020074613689540676, -0.02713477165544653,
+    0.032016738327393095, 0.005268628994424059, -0.03380748189477056, 0.02154761290740908,
+    0.014197110982159655, -0.03342967036216636, 0.017166433754219338, 0.016331972733181002,
+    -0.03285779847665091, 0.016380791084567595, 0.016380791084567595, -0.03285779847665091,
+    0.016331972733181002, 0.017166433754219338, -0.03342967036216636, 0.014197110982159655,
+    0.02154761290740908, -0.03380748189477056, 0.005268628994424059, 0.032016738327393095,
+    -0.02713477165544653, -0.020074613689540676, 0.038227703390916495, 0.01635048183559765,
+    -0.04290306983665025, -0.04931818185098251, -0.021629654376535128, -0.004021481601021059,
+    0.008862913783126458, 0.034224809993309374, 0.05422841339019883, 0.019243518181438157,
+    -0.03831736454607647, -0.015195480876658785, 0.037907925294660534, -0.0030865561497699394,
+    -0.0330670126507366, 0.025294797069790202, 0.01199406134328838, -0.03397716162642046,
+    0.018207388779702623, 0.016228539313173543, -0.033155160180033776, 0.016331972733181002,
+    0.016573506273797802, -0.03285779847665091, 0.016573506273797802, 0.016331972733181002,
+    -0.033155160180033776, 0.016228539313173543, 0.018207388779702623, -0.03397716162642046,
+    0.01199406134328838, 0.025294797069790202, -0.0330670126507366, -0.0030865561497699394,
+    0.037907925294660534, -0.015195480876658785, -0.03831736454607647, 0.019243518181438157,
+    0.05422841339019883, 0.034224809993309374, 0.008862913783126458, -0.016085926404084235,
+    -0.04620330597793104, -0.04802382253689016, 0.009699043537804111, 0.04077841448577397,
+    -0.015577729793770681, -0.030389089420120526, 0.03024385525866823, 0.008601683939533786,
+    -0.03465307055560398, 0.01978955738340553, 0.01605740757832031, -0.03368230229363357,
+    0.016228539313173543, 0.017166433754219338, -0.033050654952980506, 0.016331972733181002,
+    0.016331972733181002, -0.033050654952980506, 0.017166433754219338, 0.016228539313173543,
+    -0.03368230229363357, 0.01605740757832031, 0.01978955738340553, -0.03465307055560398,
+    0.008601683939533786, 0.03024385525866823, -0.030389089420120526, -0.015577729793770681,
+    0.04077841448577397, 0.009699043537804111, -0.04802382253689016, -0.04620330597793104,
+    -0.016085926404084235, 0.025434082855374122, 0.05429000161378429, 0.030661955327869358,
+    -0.03352769397781691, -0.023344498615084593, 0.036427627581107305, 0.0033617153771855045,
+    -0.035367742510235445, 0.022080648802315684, 0.01579440720512491, -0.03449684521604605,
+    0.01605740757832031, 0.018207388779702623, -0.03342967036216636, 0.015574891202332186,
+    0.017166433754219338, -0.033155160180033776, 0.017166433754219338, 0.015574891202332186,
+    -0.03342967036216636, 0.018207388779702623, 0.01605740757832031, -0.03449684521604605,
+    0.01579440720512491, 0.022080648802315684, -0.035367742510235445, 0.0033617153771855045,
+    0.036427627581107305, -0.023344498615084593, -0.03352769397781691, 0.030661955327869358,
+    0.05429000161378429, 0.025434082855374122, -0.036081453664199105, -0.05555803139913008,
+    -0.005891591825620426, 0.04340564707727172, -0.005026352155495699, -0.03591182640396406,
+    0.025393803691065763, 0.015395638021716078, -0.03570762718433615, 0.01579440720512491,
+    0.01978955738340553, -0.03397716162642046, 0.014197110982159655, 0.018877328763231643,
+    -0.03342967036216636, 0.016228539313173543, 0.016228539313173543, -0.03342967036216636,
+    0.018877328763231643, 0.014197110982159655, -0.03397716162642046, 0.01978955738340553,
+    0.01579440720512491, -0.03570762718433615, 0.015395638021716078, 0.025393803691065763,
+    -0.03591182640396406, -0.005026352155495699, 0.04340564707727172, -0.005891591825620426,
+    -0.05555803139913008, -0.036081453664199105, 0.04673097595438579, 0.048371155590866,
+    -0.0197377113768079, -0.035740035642216395, 0.030392809958491737, 0.014776146418067274,
+    -0.03753144943335908, 0.015395638021716078, 0.022080648802315684, -0.03465307055560398,
+    0.01199406134328838, 0.02154761290740908, -0.03374133001927757, 0.014197110982159655,
+    0.018207388779702623, -0.03368230229363357, 0.018207388779702623, 0.014197110982159655,
+    -0.03374133001927757, 0.02154761290740908, 0.01199406134328838, -0.03465307055560398,
+    0.022080648802315684, 0.015395638021716078, -0.03753144943335908, 0.014776146418067274,
+    0.030392809958491737, -0.035740035642216395, -0.0197377113768079, 0.048371155590866,
+    0.04673097595438579, -0.05585419940279951, -0.03300307057717762, 0.03892975414086468,
+    0.013745665494121932, -0.040466143530873036, 0.014776146418067274, 0.025393803691065763,
+    -0.035367742510235445, 0.008601683939533786, 0.025294797069790202, -0.03380748189477056,
+    0.010734775103588909, 0.02154761290740908, -0.03397716162642046, 0.01605740757832031,
+    0.01605740757832031, -0.03397716162642046, 0.02154761290740908, 0.010734775103588909,
+    -0.03380748189477056, 0.025294797069790202, 0.008601683939533786, -0.035367742510235445,
+    0.025393803691065763, 0.014776146418067274, -0.040466143530873036, 0.013745665494121932,
+    0.03892975414086468, -0.03300307057717762, -0.05585419940279951, 0.06201472972293868,
+    0.011719682319270088, -0.04603399829904926, 0.013745665494121932, 0.030392809958491737,
+    -0.03591182640396406, 0.0033617153771855045, 0.03024385525866823, -0.0330670126507366,
+    0.005268628994424059, 0.026234663917858666, -0.03380748189477056, 0.01199406134328838,
+    0.01978955738340553, -0.03449684521604605, 0.01978955738340553, 0.01199406134328838,
+    -0.03380748189477056, 0.026234663917858666, 0.005268628994424059, -0.0330670126507366,
+    0.03024385525866823, 0.0033617153771855045, -0.03591182640396406, 0.030392809958491737,
+    0.013745665494121932, -0.04603399829904926, 0.011719682319270088, 0.06201472972293868,
+    -0.0641913437305869, 0.011719682319270088, 0.03892975414086468, -0.035740035642216395,
+    -0.005026352155495699, 0.036427627581107305, -0.030389089420120526, -0.0030865561497699394,
+    0.032016738327393095, -0.03216431021499327, 0.005268628994424059, 0.025294797069790202,
+    -0.03465307055560398, 0.01579440720512491, 0.01579440720512491, -0.03465307055560398,
+    0.025294797069790202, 0.005268628994424059, -0.03216431021499327, 0.032016738327393095,
+    -0.0030865561497699394, -0.030389089420120526, 0.036427627581107305, -0.005026352155495699,
+    -0.035740035642216395, 0.03892975414086468, 0.011719682319270088, -0.0641913437305869,
+    0.06201472972293868, -0.03300307057717762, -0.0197377113768079, 0.04340564707727172,
+    -0.023344498615084593, -0.015577729793770681, 0.037907925294660534, -0.02713477165544653,
+    -0.005134061186996236, 0.032016738327393095, -0.0330670126507366, 0.008601683939533786,
+    0.022080648802315684, -0.03570762718433615, 0.022080648802315684, 0.008601683939533786,
+    -0.0330670126507366, 0.032016738327393095, -0.005134061186996236, -0.02713477165544653,
+    0.037907925294660534, -0.015577729793770681, -0.023344498615084593, 0.04340564707727172,
+    -0.0197377113768079, -0.03300307057717762, 0.06201472972293868, -0.05585419940279951,
+    0.048371155590866, -0.005891591825620426, -0.03352769397781691, 0.04077841448577397,
+    -0.015195480876658785, -0.020074613689540676, 0.038079495097981766, -0.02713477165544653,
+    -0.0030865561497699394, 0.03024385525866823, -0.035367742510235445, 0.015395638021716078,
+    0.015395638021716078, -0.035367742510235445, 0.03024385525866823, -0.0030865561497699394,
+    -0.02713477165544653, 0.038079495097981766, -0.020074613689540676, -0.015195480876658785,
+    0.04077841448577397, -0.03352769397781691, -0.005891591825620426, 0.048371155590866,
+    -0.05585419940279951, 0.04673097595438579, -0.05555803139913008, 0.030661955327869358,
+    0.009699043537804111, -0.03831736454607647, 0.038227703390916495, -0.012461177687690712,
+    -0.020074613689540676, 0.037907925294660534, -0.030389089420120526, 0.0033617153771855045,
+    0.025393803691065763, -0.03753144943335908, 0.025393803691065763, 0.0033617153771855045,
+    -0.030389089420120526, 0.037907925294660534, -0.020074613689540676, -0.012461177687690712,
+    0.038227703390916495, -0.03831736454607647, 0.009699043537804111, 0.030661955327869358,
+    -0.05555803139913008, 0.04673097595438579, -0.036081453664199105, 0.05429000161378429,
+    -0.04802382253689016, 0.019243518181438157, 0.01635048183559765, -0.039375217072262755,
+    0.038227703390916495, -0.015195480876658785, -0.015577729793770681, 0.036427627581107305,
+    -0.03591182640396406, 0.014776146418067274, 0.014776146418067274, -0.03591182640396406,
+    0.036427627581107305, -0.015577729793770681, -0.015195480876658785, 0.038227703390916495,
+    -0.039375217072262755, 0.01635048183559765, 0.019243518181438157, -0.04802382253689016,
+    0.05429000161378429, -0.036081453664199105, 0.025434082855374122, -0.04620330597793104,
+    0.05422841339019883, -0.04290306983665025, 0.015470499488747022, 0.01635048183559765,
+    -0.03831736454607647, 0.04077841448577397, -0.023344498615084593, -0.005026352155495699,
+    0.030392809958491737, -0.040466143530873036, 0.030392809958491737, -0.005026352155495699,
+    -0.023344498615084593, 0.04077841448577397, -0.03831736454607647, 0.01635048183559765,
+    0.015470499488747022, -0.04290306983665025, 0.05422841339019883, -0.04620330597793104,
+    0.025434082855374122, -0.016085926404084235, 0.034224809993309374, -0.04931818185098251,
+    0.05358757353029842, -0.04290306983665025, 0.019243518181438157, 0.009699043537804111,
+    -0.03352769397781691, 0.04340564707727172, -0.035740035642216395, 0.013745665494121932,
+    0.013745665494121932, -0.035740035642216395, 0.04340564707727172, -0.03352769397781691,
+    0.009699043537804111, 0.019243518181438157, -0.04290306983665025, 0.05358757353029842,
+    -0.04931818185098251, 0.034224809993309374, -0.016085926404084235, 0.008862913783126458,
+    -0.021629654376535128, 0.036719137340761, -0.04931818185098251, 0.05422841339019883,
+    -0.04802382253689016, 0.030661955327869358, -0.005891591825620426, -0.0197377113768079,
+    0.03892975414086468, -0.04603399829904926, 0.03892975414086468, -0.0197377113768079,
+    -0.005891591825620426, 0.030661955327869358, -0.04802382253689016, 0.05422841339019883,
+    -0.04931818185098251, 0.036719137340761, -0.021629654376535128, 0.008862913783126458,
+    -0.004021481601021059, 0.011090297826270456, -0.021629654376535128, 0.034224809993309374,
+    -0.04620330597793104, 0.05429000161378429, -0.05555803139913008, 0.048371155590866,
+    -0.03300307057717762, 0.011719682319270088, 0.011719682319270088, -0.03300307057717762,
+    0.048371155590866, -0.05555803139913008, 0.05429000161378429, -0.04620330597793104,
+    0.034224809993309374, -0.021629654376535128, 0.011090297826270456, -0.004021481601021059,
+    0.0013047409207377007, -0.004021481601021059, 0.008862913783126458, -0.016085926404084235,
+    0.025434082855374122, -0.036081453664199105, 0.04673097595438579, -0.05585419940279951,
+    0.06201472972293868, -0.0641913437305869, 0.06201472972293868, -0.05585419940279951,
+    0.04673097595438579, -0.036081453664199105, 0.025434082855374122, -0.016085926404084235,
+    0.008862913783126458, -0.004021481601021059, 0.0013047409207377007, 0.0009781092487714952,
+    -0.003093053026594175, 0.006990647531748283, -0.013008922575277776, 0.02109119662282997,
+    -0.030692199334093572, 0.04080650850415323, -0.05012608406688618, 0.05729417138265093,
+    -0.061193306306744036, 0.061193306306744036, -0.05729417138265093, 0.05012608406688618,
+    -0.04080650850415323, 0.030692199334093572, -0.02109119662282997, 0.013008922575277776,
+    -0.006990647531748283, 0.003093053026594175, -0.0009781092487714952, -0.003093053026594175,
+    0.008802983238943456, -0.017731819057911682, 0.029026546394551208, -0.0406649609673957,
+    0.049858425816548785, -0.05378327012504151, 0.05042181574222642, -0.03924277692885753,
+    0.021494154143078578, 0.0, -0.021494154143078578, 0.03924277692885753,
+    -0.05042181574222642, 0.05378327012504151, -0.049858425816548785, 0.0406649609673957,
+    -0.029026546394551208, 0.017731819057911682, -0.008802983238943456, 0.003093053026594175,
+    0.006990647531748283, -0.017731819057911682, 0.03137880211599364, -0.04418178582513785,
+    0.051494935958408344, -0.04954988389892809, 0.0370708562062046, -0.01608303714920613,
+    -0.00843654133574013, 0.02998373599114278, -0.04255038540725863, 0.04255038540725863,
+    -0.02998373599114278, 0.00843654133574013, 0.01608303714920613, -0.0370708562062046,
+    0.04954988389892809, -0.051494935958408344, 0.04418178582513785, -0.03137880211599364,
+    0.017731819057911682, -0.006990647531748283, -0.013008922575277776, 0.029026546394551208,
+    -0.04418178582513785, 0.05149613017856412, -0.046035027743741574, 0.027600934800827343,
+    -0.0013388419947011469, -0.024024660654037577, 0.03955899720567498, -0.039704162396234255,
+    0.024566476469003094, 0.0, -0.024566476469003094, 0.039704162396234255,
+    -0.03955899720567498, 0.024024660654037577, 0.0013388419947011469, -0.027600934800827343,
+    0.046035027743741574, -0.05149613017856412, 0.04418178582513785, -0.029026546394551208,
+    0.013008922575277776, 0.02109119662282997, -0.0406649609673957, 0.051494935958408344,
+    -0.046035027743741574, 0.02434698967887965, 0.005375166079517332, -0.03063579431833898,
+    0.0406443852512516, -0.03145989219716722, 0.007841020770864357, 0.018972728173296805,
+    -0.03643797312453839, 0.03643797312453839, -0.018972728173296805, -0.007841020770864357,
+    0.03145989219716722, -0.0406443852512516, 0.03063579431833898, -0.005375166079517332,
+    -0.02434698967887965, 0.046035027743741574, -0.051494935958408344, 0.0406649609673957,
+    -0.02109119662282997, -0.030692199334093572, 0.049858425816548785, -0.04954988389892809,
+    0.027600934800827343, 0.005375166079517332, -0.032383346749867065, 0.03988161386986895,
+    -0.025118902367438783, -0.00280425778002324, 0.02823703319891857, -0.03746432342742005,
+    0.025841654858101932, 0.0, -0.025841654858101932, 0.03746432342742005,
+    -0.02823703319891857, 0.00280425778002324, 0.025118902367438783, -0.03988161386986895,
+    0.032383346749867065, -0.005375166079517332, -0.027600934800827343, 0.04954988389892809,
+    -0.049858425816548785, 0.030692199334093572, 0.04080650850415323, -0.05378327012504151,
+    0.0370708562062046, -0.0013388419947011469, -0.03063579431833898, 0.03988161386986895,
+    -0.02286660811317144, -0.007712611381153141, 0.031966223431724, -0.03522086909726457,
+    0.01634369757191148, 0.012368705514061258, -0.03305675596537063, 0.03305675596537063,
+    -0.012368705514061258, -0.01634369757191148, 0.03522086909726457, -0.031966223431724,
+    0.007712611381153141, 0.02286660811317144, -0.03988161386986895, 0.03063579431833898,
+    0.0013388419947011469, -0.0370708562062046, 0.05378327012504151, -0.04080650850415323,
+    -0.05012608406688618, 0.05042181574222642, -0.01608303714920613, -0.024024660654037577,
+    0.0406443852512516, -0.025118902367438783, -0.007712611381153141, 0.03291205445190572,
+    -0.033410066604699445, 0.010415206791433478, 0.019126771796468624, -0.03484488030230979,
+    0.026445404772296507, 0.0, -0.026445404772296507, 0.03484488030230979,
+    -0.019126771796468624, -0.010415206791433478, 0.033410066604699445, -0.03291205445190572,
+    0.007712611381153141, 0.025118902367438783, -0.0406443852512516, 0.024024660654037577,
+    0.01608303714920613, -0.05042181574222642, 0.05012608406688618, 0.05729417138265093,
+    -0.03924277692885753, -0.00843654133574013, 0.03955899720567498, -0.03145989219716722,
+    -0.00280425778002324, 0.031966223431724, -0.033410066604699445, 0.008444400031351116,
+    0.022002051290244063, -0.034750964925543824, 0.02113073952454542, 0.007965547602659603,
+    -0.030873276923766086, 0.030873276923766086, -0.007965547602659603, -0.02113073952454542,
+    0.034750964925543824, -0.022002051290244063, -0.008444400031351116, 0.033410066604699445,
+    -0.031966223431724, 0.00280425778002324, 0.03145989219716722, -0.03955899720567498,
+    0.00843654133574013, 0.03924277692885753, -0.05729417138265093, -0.061193306306744036,
+    0.021494154143078578, 0.02998373599114278, -0.039704162396234255, 0.007841020770864357,
+    0.02823703319891857, -0.03522086909726457, 0.010415206791433478, 0.022002051290244063,
+    -0.03454635817925582, 0.018315510393441824, 0.012246340338193544, -0.03244702397283322,
+    0.026737042114053314, 0.0, -0.026737042114053314, 0.03244702397283322,
+    -0.012246340338193544, -0.018315510393441824, 0.03454635817925582, -0.022002051290244063,
+    -0.010415206791433478, 0.03522086909726457, -0.02823703319891857, -0.007841020770864357,
+    0.039704162396234255, -0.02998373599114278, -0.021494154143078578, 0.061193306306744036,
+    0.061193306306744036, 0.0, -0.04255038540725863, 0.024566476469003094,
+    0.018972728173296805, -0.03746432342742005, 0.01634369757191148, 0.019126771796468624,
+    -0.034750964925543824, 0.018315510393441824, 0.013580539530349125, -0.03285684871811529,
+    0.023903471607724002, 0.0049106807640345715, -0.0293730052794804, 0.0293730052794804,
+    -0.0049106807640345715, -0.023903471607724002, 0.03285684871811529, -0.013580539530349125,
+    -0.018315510393441824, 0.034750964925543824, -0.019126771796468624, -0.01634369757191148,
+    0.03746432342742005, -0.018972728173296805, -0.024566476469003094, 0.04255038540725863,
+    0.0, -0.061193306306744036, -0.05729417138265093, -0.021494154143078578,
+    0.04255038540725863, 0.0, -0.03643797312453839, 0.025841654858101932,
+    0.012368705514061258, -0.03484488030230979, 0.02113073952454542, 0.012246340338193544,
+    -0.03285684871811529, 0.02291521511158467, 0.007218643147079756, -0.030451862889781918,
+    0.026871990188271102, 0.0, -0.026871990188271102, 0.030451862889781918,
+    -0.007218643147079756, -0.02291521511158467, 0.03285684871811529, -0.012246340338193544,
+    -0.02113073952454542, 0.03484488030230979, -0.012368705514061258, -0.025841654858101932,
+    0.03643797312453839, 0.0, -0.04255038540725863, 0.021494154143078578,
+    0.05729417138265093, 0.05012608406688618, 0.03924277692885753, -0.02998373599114278,
+    -0.024566476469003094, 0.03643797312453839, 0.0, -0.03305675596537063,
+    0.026445404772296507, 0.007965547602659603, -0.03244702397283322, 0.023903471607724002,
+    0.007218643147079756, -0.030732840689712552, 0.025518818999417985, 0.0027790350664043846,
+    -0.028325564752211194, 0.028325564752211194, -0.0027790350664043846, -0.025518818999417985,
+    0.030732840689712552, -0.007218643147079756, -0.023903471607724002, 0.03244702397283322,
+    -0.007965547602659603, -0.026445404772296507, 0.03305675596537063, 0.0,
+    -0.03643797312453839, 0.024566476469003094, 0.02998373599114278, -0.03924277692885753,
+    -0.05012608406688618, -0.04080650850415323, -0.05042181574222642, 0.00843654133574013,
+    0.039704162396234255, -0.018972728173296805, -0.025841654858101932, 0.03305675596537063,
+    0.0, -0.030873276923766086, 0.026737042114053314, 0.0049106807640345715,
+    -0.030451862889781918, 0.025518818999417985, 0.003674944906347653, -0.02890674305960421,
+    0.026927815721455334, 0.0, -0.026927815721455334, 0.02890674305960421,
+    -0.003674944906347653, -0.025518818999417985, 0.030451862889781918, -0.0049106807640345715,
+    -0.026737042114053314, 0.030873276923766086, 0.0, -0.03305675596537063,
+    0.025841654858101932, 0.018972728173296805, -0.039704162396234255, -0.00843654133574013,
+    0.05042181574222642, 0.04080650850415323, 0.030692199334093572, 0.05378327012504151,
+    0.01608303714920613, -0.03955899720567498, -0.007841020770864357, 0.03746432342742005,
+    -0.012368705514061258, -0.026445404772296507, 0.030873276923766086, 0.0,
+    -0.0293730052794804, 0.026871990188271102, 0.0027790350664043846, -0.02890674305960421,
+    0.02644519177705076, 0.0013325812847546463, -0.027611564425412446, 0.027611564425412446,
+    -0.0013325812847546463, -0.02644519177705076, 0.02890674305960421, -0.0027790350664043846,
+    -0.026871990188271102, 0.0293730052794804, 0.0, -0.030873276923766086,
+    0.026445404772296507, 0.012368705514061258, -0.03746432342742005, 0.007841020770864357,
+    0.03955899720567498, -0.01608303714920613, -0.05378327012504151, -0.030692199334093572,
+    -0.02109119662282997, -0.049858425816548785, -0.0370708562062046, 0.024024660654037577,
+    0.03145989219716722, -0.02823703319891857, -0.01634369757191148, 0.03484488030230979,
+    -0.007965547602659603, -0.026737042114053314, 0.0293730052794804, 0.0,
+    -0.028325564752211194, 0.026927815721455334, 0.0013325812847546463, -0.027814288899023414,
+    0.02694612773698313, 0.0, -0.02694612773698313, 0.027814288899023414,
+    -0.0013325812847546463, -0.026927815721455334, 0.028325564752211194, 0.0,
+    -0.0293730052794804, 0.026737042114053314, 0.007965547602659603, -0.03484488030230979,
+    0.01634369757191148, 0.02823703319891857, -0.03145989219716722, -0.024024660654037577,
+    0.0370708562062046, 0.049858425816548785, 0.02109119662282997, 0.013008922575277776,
+    0.0406649609673957, 0.04954988389892809, 0.0013388419947011469, -0.0406443852512516,
+    0.00280425778002324, 0.03522086909726457, -0.019126771796468624, -0.02113073952454542,
+    0.03244702397283322, -0.0049106807640345715, -0.026871990188271102, 0.028325564752211194,
+    0.0, -0.027611564425412446, 0.02694612773698313, 0.00043234645957031215,
+    -0.02716490909036265, 0.02716490909036265, -0.00043234645957031215, -0.02694612773698313,
+    0.027611564425412446, 0.0, -0.028325564752211194, 0.026871990188271102,
+    0.0049106807640345715, -0.03244702397283322, 0.02113073952454542, 0.019126771796468624,
+    -0.03522086909726457, -0.00280425778002324, 0.0406443852512516, -0.0013388419947011469,
+    -0.04954988389892809, -0.0406649609673957, -0.013008922575277776, -0.006990647531748283,
+    -0.029026546394551208, -0.051494935958408344, -0.027600934800827343, 0.03063579431833898,
+    0.025118902367438783, -0.031966223431724, -0.010415206791433478, 0.034750964925543824,
+    -0.012246340338193544, -0.023903471607724002, 0.030451862889781918, -0.0027790350664043846,
+    -0.026927815721455334, 0.027611564425412446, 0.0, -0.02716490909036265,
+    0.02694959597988279, 0.0, -0.02694959597988279, 0.02716490909036265,
+    0.0, -0.027611564425412446, 0.026927815721455334, 0.0027790350664043846,
+    -0.030451862889781918, 0.023903471607724002, 0.012246340338193544, -0.034750964925543824,
+    0.010415206791433478, 0.031966223431724, -0.025118902367438783, -0.03063579431833898,
+    0.027600934800827343, 0.051494935958408344, 0.029026546394551208, 0.006990647531748283,
+    0.003093053026594175, 0.017731819057911682, 0.04418178582513785, 0.046035027743741574,
+    -0.005375166079517332, -0.03988161386986895, 0.007712611381153141, 0.033410066604699445,
+    -0.022002051290244063, -0.018315510393441824, 0.03285684871811529, -0.007218643147079756,
+    -0.025518818999417985, 0.02890674305960421, -0.0013325812847546463, -0.02694612773698313,
+    0.02716490909036265, 0.0, -0.02694959597988279, 0.02694959597988279,
+    0.0, -0.02716490909036265, 0.02694612773698313, 0.0013325812847546463,
+    -0.02890674305960421, 0.025518818999417985, 0.007218643147079756, -0.03285684871811529,
+    0.018315510393441824, 0.022002051290244063, -0.033410066604699445, -0.007712611381153141,
+    0.03988161386986895, 0.005375166079517332, -0.046035027743741574, -0.04418178582513785,
+    -0.017731819057911682, -0.003093053026594175, -0.0009781092487714952, -0.008802983238943456,
+    -0.03137880211599364, -0.05149613017856412, -0.02434698967887965, 0.032383346749867065,
+    0.02286660811317144, -0.03291205445190572, -0.008444400031351116, 0.03454635817925582,
+    -0.013580539530349125, -0.02291521511158467, 0.030732840689712552, -0.003674944906347653,
+    -0.02644519177705076, 0.027814288899023414, -0.00043234645957031215, -0.02694959597988279,
+    0.02694959597988279, 0.0, -0.02694959597988279, 0.02694959597988279,
+    0.00043234645957031215, -0.027814288899023414, 0.02644519177705076, 0.003674944906347653,
+    -0.030732840689712552, 0.02291521511158467, 0.013580539530349125, -0.03454635817925582,
+    0.008444400031351116, 0.03291205445190572, -0.02286660811317144, -0.032383346749867065,
+    0.02434698967887965, 0.05149613017856412, 0.03137880211599364, 0.008802983238943456,
+    0.0009781092487714952, 0.003093053026594175, 0.017731819057911682, 0.04418178582513785,
+    0.046035027743741574, -0.005375166079517332, -0.03988161386986895, 0.007712611381153141,
+    0.033410066604699445, -0.022002051290244063, -0.018315510393441824, 0.03285684871811529,
+    -0.007218643147079756, -0.025518818999417985, 0.02890674305960421, -0.0013325812847546463,
+    -0.02694612773698313, 0.02716490909036265, 0.0, -0.02694959597988279,
+    0.02694959597988279, 0.0, -0.02716490909036265, 0.02694612773698313,
+    0.0013325812847546463, -0.02890674305960421, 0.025518818999417985, 0.007218643147079756,
+    -0.03285684871811529, 0.018315510393441824, 0.022002051290244063, -0.033410066604699445,
+    -0.007712611381153141, 0.03988161386986895, 0.005375166079517332, -0.046035027743741574,
+    -0.04418178582513785, -0.017731819057911682, -0.003093053026594175, -0.006990647531748283,
+    -0.029026546394551208, -0.051494935958408344, -0.027600934800827343, 0.03063579431833898,
+    0.025118902367438783, -0.031966223431724, -0.010415206791433478, 0.034750964925543824,
+    -0.012246340338193544, -0.023903471607724002, 0.030451862889781918, -0.0027790350664043846,
+    -0.026927815721455334, 0.027611564425412446, 0.0, -0.02716490909036265,
+    0.02694959597988279, 0.0, -0.02694959597988279, 0.02716490909036265,
+    0.0, -0.027611564425412446, 0.026927815721455334, 0.0027790350664043846,
+    -0.030451862889781918, 0.023903471607724002, 0.012246340338193544, -0.034750964925543824,
+    0.010415206791433478, 0.031966223431724, -0.025118902367438783, -0.03063579431833898,
+    0.027600934800827343, 0.051494935958408344, 0.029026546394551208, 0.006990647531748283,
+    0.013008922575277776, 0.0406649609673957, 0.04954988389892809, 0.0013388419947011469,
+    -0.0406443852512516, 0.00280425778002324, 0.03522086909726457, -0.019126771796468624,
+    -0.02113073952454542, 0.03244702397283322, -0.0049106807640345715, -0.026871990188271102,
+    0.028325564752211194, 0.0, -0.027611564425412446, 0.02694612773698313,
+    0.00043234645957031215, -0.02716490909036265, 0.02716490909036265, -0.00043234645957031215,
+    -0.02694612773698313, 0.027611564425412446, 0.0, -0.028325564752211194,
+    0.026871990188271102, 0.0049106807640345715, -0.03244702397283322, 0.02113073952454542,
+    0.019126771796468624, -0.03522086909726457, -0.00280425778002324, 0.0406443852512516,
+    -0.0013388419947011469, -0.04954988389892809, -0.0406649609673957, -0.013008922575277776,
+    -0.02109119662282997, -0.049858425816548785, -0.0370708562062046, 0.024024660654037577,
+    0.03145989219716722, -0.02823703319891857, -0.01634369757191148, 0.03484488030230979,
+    -0.007965547602659603, -0.026737042114053314, 0.0293730052794804, 0.0,
+    -0.028325564752211194, 0.026927815721455334, 0.0013325812847546463, -0.027814288899023414,
+    0.02694612773698313, 0.0, -0.02694612773698313, 0.027814288899023414,
+    -0.0013325812847546463, -0.026927815721455334, 0.028325564752211194, 0.0,
+    -0.0293730052794804, 0.026737042114053314, 0.007965547602659603, -0.03484488030230979,
+    0.01634369757191148, 0.02823703319891857, -0.03145989219716722, -0.024024660654037577,
+    0.0370708562062046, 0.049858425816548785, 0.02109119662282997, 0.030692199334093572,
+    0.05378327012504151, 0.01608303714920613, -0.03955899720567498, -0.007841020770864357,
+    0.03746432342742005, -0.012368705514061258, -0.026445404772296507, 0.030873276923766086,
+    0.0, -0.0293730052794804, 0.026871990188271102, 0.0027790350664043846,
+    -0.02890674305960421, 0.02644519177705076, 0.0013325812847546463, -0.027611564425412446,
+    0.027611564425412446, -0.0013325812847546463, -0.02644519177705076, 0.02890674305960421,
+    -0.0027790350664043846, -0.026871990188271102, 0.0293730052794804, 0.0,
+    -0.030873276923766086, 0.026445404772296507, 0.012368705514061258, -0.03746432342742005,
+    0.007841020770864357, 0.03955899720567498, -0.01608303714920613, -0.05378327012504151,
+    -0.030692199334093572, -0.04080650850415323, -0.05042181574222642, 0.00843654133574013,
+    0.039704162396234255, -0.018972728173296805, -0.025841654858101932, 0.03305675596537063,
+    0.0, -0.030873276923766086, 0.026737042114053314, 0.0049106807640345715,
+    -0.030451862889781918, 0.025518818999417985, 0.003674944906347653, -0.02890674305960421,
+    0.026927815721455334, 0.0, -0.026927815721455334, 0.02890674305960421,
+    -0.003674944906347653, -0.025518818999417985, 0.030451862889781918, -0.0049106807640345715,
+    -0.026737042114053314, 0.030873276923766086, 0.0, -0.03305675596537063,
+    0.025841654858101932, 0.018972728173296805, -0.039704162396234255, -0.00843654133574013,
+    0.05042181574222642, 0.04080650850415323, 0.05012608406688618, 0.03924277692885753,
+    -0.02998373599114278, -0.024566476469003094, 0.03643797312453839, 0.0,
+    -0.03305675596537063, 0.026445404772296507, 0.007965547602659603, -0.03244702397283322,
+    0.023903471607724002, 0.007218643147079756, -0.030732840689712552, 0.025518818999417985,
+    0.0027790350664043846, -0.028325564752211194, 0.028325564752211194, -0.0027790350664043846,
+    -0.025518818999417985, 0.030732840689712552, -0.007218643147079756, -0.023903471607724002,
+    0.03244702397283322, -0.007965547602659603, -0.026445404772296507, 0.03305675596537063,
+    0.0, -0.03643797312453839, 0.024566476469003094, 0.02998373599114278,
+    -0.03924277692885753, -0.05012608406688618, -0.05729417138265093, -0.021494154143078578,
+    0.04255038540725863, 0.0, -0.03643797312453839, 0.025841654858101932,
+    0.012368705514061258, -0.03484488030230979, 0.02113073952454542, 0.012246340338193544,
+    -0.03285684871811529, 0.02291521511158467, 0.007218643147079756, -0.030451862889781918,
+    0.026871990188271102, 0.0, -0.026871990188271102, 0.030451862889781918,
+    -0.007218643147079756, -0.02291521511158467, 0.03285684871811529, -0.012246340338193544,
+    -0.02113073952454542, 0.03484488030230979, -0.012368705514061258, -0.025841654858101932,
+    0.03643797312453839, 0.0, -0.04255038540725863, 0.021494154143078578,
+    0.05729417138265093, 0.061193306306744036, 0.0, -0.04255038540725863,
+    0.024566476469003094, 0.018972728173296805, -0.03746432342742005, 0.01634369757191148,
+    0.019126771796468624, -0.034750964925543824, 0.018315510393441824, 0.013580539530349125,
+    -0.03285684871811529, 0.023903471607724002, 0.0049106807640345715, -0.0293730052794804,
+    0.0293730052794804, -0.0049106807640345715, -0.023903471607724002, 0.03285684871811529,
+    -0.013580539530349125, -0.018315510393441824, 0.034750964925543824, -0.019126771796468624,
+    -0.01634369757191148, 0.03746432342742005, -0.018972728173296805, -0.024566476469003094,
+    0.04255038540725863, 0.0, -0.061193306306744036, -0.061193306306744036,
+    0.021494154143078578, 0.02998373599114278, -0.039704162396234255, 0.007841020770864357,
+    0.02823703319891857, -0.03522086909726457, 0.010415206791433478, 0.022002051290244063,
+    -0.03454635817925582, 0.018315510393441824, 0.012246340338193544, -0.03244702397283322,
+    0.026737042114053314, 0.0, -0.026737042114053314, 0.03244702397283322,
+    -0.012246340338193544, -0.018315510393441824, 0.03454635817925582, -0.022002051290244063,
+    -0.010415206791433478, 0.03522086909726457, -0.02823703319891857, -0.007841020770864357,
+    0.039704162396234255, -0.02998373599114278, -0.021494154143078578, 0.061193306306744036,
+    0.05729417138265093, -0.03924277692885753, -0.00843654133574013, 0.03955899720567498,
+    -0.03145989219716722, -0.00280425778002324, 0.031966223431724, -0.033410066604699445,
+    0.008444400031351116, 0.022002051290244063, -0.034750964925543824, 0.02113073952454542,
+    0.007965547602659603, -0.030873276923766086, 0.030873276923766086, -0.007965547602659603,
+    -0.02113073952454542, 0.034750964925543824, -0.022002051290244063, -0.008444400031351116,
+    0.033410066604699445, -0.031966223431724, 0.00280425778002324, 0.03145989219716722,
+    -0.03955899720567498, 0.00843654133574013, 0.03924277692885753, -0.05729417138265093,
+    -0.05012608406688618, 0.05042181574222642, -0.01608303714920613, -0.024024660654037577,
+    0.0406443852512516, -0.025118902367438783, -0.007712611381153141, 0.03291205445190572,
+    -0.033410066604699445, 0.010415206791433478, 0.019126771796468624, -0.03484488030230979,
+    0.026445404772296507, 0.0, -0.026445404772296507, 0.03484488030230979,
+    -0.019126771796468624, -0.010415206791433478, 0.033410066604699445, -0.03291205445190572,
+    0.007712611381153141, 0.025118902367438783, -0.0406443852512516, 0.024024660654037577,
+    0.01608303714920613, -0.05042181574222642, 0.05012608406688618, 0.04080650850415323,
+    -0.05378327012504151, 0.0370708562062046, -0.0013388419947011469, -0.03063579431833898,
+    0.03988161386986895, -0.02286660811317144, -0.007712611381153141, 0.031966223431724,
+    -0.03522086909726457, 0.01634369757191148, 0.012368705514061258, -0.03305675596537063,
+    0.03305675596537063, -0.012368705514061258, -0.01634369757191148, 0.03522086909726457,
+    -0.031966223431724, 0.007712611381153141, 0.02286660811317144, -0.03988161386986895,
+    0.03063579431833898, 0.0013388419947011469, -0.0370708562062046, 0.05378327012504151,
+    -0.04080650850415323, -0.030692199334093572, 0.049858425816548785, -0.04954988389892809,
+    0.027600934800827343, 0.005375166079517332, -0.032383346749867065, 0.03988161386986895,
+    -0.025118902367438783, -0.00280425778002324, 0.02823703319891857, -0.03746432342742005,
+    0.025841654858101932, 0.0, -0.025841654858101932, 0.03746432342742005,
+    -0.02823703319891857, 0.00280425778002324, 0.025118902367438783, -0.03988161386986895,
+    0.032383346749867065, -0.005375166079517332, -0.027600934800827343, 0.04954988389892809,
+    -0.049858425816548785, 0.030692199334093572, 0.02109119662282997, -0.0406649609673957,
+    0.051494935958408344, -0.046035027743741574, 0.02434698967887965, 0.005375166079517332,
+    -0.03063579431833898, 0.0406443852512516, -0.03145989219716722, 0.007841020770864357,
+    0.018972728173296805, -0.03643797312453839, 0.03643797312453839, -0.018972728173296805,
+    -0.007841020770864357, 0.03145989219716722, -0.0406443852512516, 0.03063579431833898,
+    -0.005375166079517332, -0.02434698967887965, 0.046035027743741574, -0.051494935958408344,
+    0.0406649609673957, -0.02109119662282997, -0.013008922575277776, 0.029026546394551208,
+    -0.04418178582513785, 0.05149613017856412, -0.046035027743741574, 0.027600934800827343,
+    -0.0013388419947011469, -0.024024660654037577, 0.03955899720567498, -0.039704162396234255,
+    0.024566476469003094, 0.0, -0.024566476469003094, 0.039704162396234255,
+    -0.03955899720567498, 0.024024660654037577, 0.0013388419947011469, -0.027600934800827343,
+    0.046035027743741574, -0.05149613017856412, 0.04418178582513785, -0.029026546394551208,
+    0.013008922575277776, 0.006990647531748283, -0.017731819057911682, 0.03137880211599364,
+    -0.04418178582513785, 0.051494935958408344, -0.04954988389892809, 0.0370708562062046,
+    -0.01608303714920613, -0.00843654133574013, 0.02998373599114278, -0.04255038540725863,
+    0.04255038540725863, -0.02998373599114278, 0.00843654133574013, 0.01608303714920613,
+    -0.0370708562062046, 0.04954988389892809, -0.051494935958408344, 0.04418178582513785,
+    -0.03137880211599364, 0.017731819057911682, -0.006990647531748283, -0.003093053026594175,
+    0.008802983238943456, -0.017731819057911682, 0.029026546394551208, -0.0406649609673957,
+    0.049858425816548785, -0.05378327012504151, 0.05042181574222642, -0.03924277692885753,
+    0.021494154143078578, 0.0, -0.021494154143078578, 0.03924277692885753,
+    -0.05042181574222642, 0.05378327012504151, -0.049858425816548785, 0.0406649609673957,
+    -0.029026546394551208, 0.017731819057911682, -0.008802983238943456, 0.003093053026594175,
+    0.0009781092487714952, -0.003093053026594175, 0.006990647531748283, -0.013008922575277776,
+    0.02109119662282997, -0.030692199334093572, 0.04080650850415323, -0.05012608406688618,
+    0.05729417138265093, -0.061193306306744036, 0.061193306306744036, -0.05729417138265093,
+    0.05012608406688618, -0.04080650850415323, 0.030692199334093572, -0.02109119662282997,
+    0.013008922575277776, -0.006990647531748283, 0.003093053026594175, -0.0009781092487714952,
+    0.0007342271125681172, -0.0023791677651473432, 0.005507644580631185, -0.010495754201812346,
+    0.017426608529437587, -0.025978054192733392, 0.03540212038711747, -0.04461559569939831,
+    0.05238843492903513, -0.05758757653750022, 0.059416207210648615, -0.05758757653750022,
+    0.05238843492903513, -0.04461559569939831, 0.03540212038711747, -0.025978054192733392,
+    0.017426608529437587, -0.010495754201812346, 0.005507644580631185, -0.0023791677651473432,
+    0.0007342271125681172, -0.0023791677651473432, 0.006975157569397114, -0.014481938107885934,
+    0.024468353148246223, -0.035467138110187785, 0.045182401235578366, -0.05101988560537101,
+    0.05079709028063259, -0.043416492681398716, 0.029286025434036734, -0.010343034077007743,
+    -0.010343034077007743, 0.029286025434036734, -0.043416492681398716, 0.05079709028063259,
+    -0.05101988560537101, 0.045182401235578366, -0.035467138110187785, 0.024468353148246223,
+    -0.014481938107885934, 0.006975157569397114, -0.0023791677651473432, 0.005507644580631185,
+    -0.014481938107885934, 0.02662985258275902, -0.03913510349250114, 0.048006184232305564,
+    -0.049457654564265555, 0.04140086207487967, -0.024464622414979025, 0.0021239330439393926,
+    0.020161388171516914, -0.03653709520858106, 0.04254882974255448, -0.03653709520858106,
+    0.020161388171516914, 0.0021239330439393926, -0.024464622414979025, 0.04140086207487967,
+    -0.049457654564265555, 0.048006184232305564, -0.03913510349250114, 0.02662985258275902,
+    -0.014481938107885934, 0.005507644580631185, -0.010495754201812346, 0.024468353148246223,
+    -0.03913510349250114, 0.048487228933825274, -0.047334079710196104, 0.03392724527115009,
+    -0.011196594598243893, -0.013993429710596266, 0.033301127788507884, -0.04008835708335762,
+    0.03204111379717317, -0.01217644265628854, -0.01217644265628854, 0.03204111379717317,
+    -0.04008835708335762, 0.033301127788507884, -0.013993429710596266, -0.011196594598243893,
+    0.03392724527115009, -0.047334079710196104, 0.048487228933825274, -0.03913510349250114,
+    0.024468353148246223, -0.010495754201812346, 0.017426608529437587, -0.035467138110187785,
+    0.048006184232305564, -0.047334079710196104, 0.03125120930479639, -0.004816138116954908,
+    -0.021687144131695292, 0.03743250465851851, -0.03605732040518568, 0.018621698533530052,
+    0.006812522305094141, -0.028748781148966444, 0.03734299854965229, -0.028748781148966444,
+    0.006812522305094141, 0.018621698533530052, -0.03605732040518568, 0.03743250465851851,
+    -0.021687144131695292, -0.004816138116954908, 0.03125120930479639, -0.047334079710196104,
+    0.048006184232305564, -0.035467138110187785, 0.017426608529437587, -0.025978054192733392,
+    0.045182401235578366, -0.049457654564265555, 0.03392724527115009, -0.004816138116954908,
+    -0.023894436812027072, 0.03825071407679321, -0.031831607683290866, 0.008952915068337971,
+    0.017849714336153292, -0.03446566146260097, 0.032436743055838185, -0.013130000808752056,
+    -0.013130000808752056, 0.032436743055838185, -0.03446566146260097, 0.017849714336153292,
+    0.008952915068337971, -0.031831607683290866, 0.03825071407679321, -0.023894436812027072,
+    -0.004816138116954908, 0.03392724527115009, -0.049457654564265555, 0.045182401235578366,
+    -0.025978054192733392, 0.03540212038711747, -0.05101988560537101, 0.04140086207487967,
+    -0.011196594598243893, -0.021687144131695292, 0.03825071407679321, -0.030200241805829343,
+    0.00418838607586827, 0.023119786308483888, -0.03536465665737663, 0.0258799825904089,
+    -0.0009988365357561043, -0.024140094468019603, 0.03457289864304533, -0.024140094468019603,
+    -0.0009988365357561043, 0.0258799825904089, -0.03536465665737663, 0.023119786308483888,
+    0.00418838607586827, -0.030200241805829343, 0.03825071407679321, -0.021687144131695292,
+    -0.011196594598243893, 0.04140086207487967, -0.05101988560537101, 0.03540212038711747,
+    -0.04461559569939831, 0.05079709028063259, -0.024464622414979025, -0.013993429710596266,
+    0.03743250465851851, -0.031831607683290866, 0.00418838607586827, 0.024636296223062636,
+    -0.035050862259149565, 0.02120977870646221, 0.006476139177256272, -0.02917931194865307,
+    0.032109531259110265, -0.013716660068143025, -0.013716660068143025, 0.032109531259110265,
+    -0.02917931194865307, 0.006476139177256272, 0.02120977870646221, -0.035050862259149565,
+    0.024636296223062636, 0.00418838607586827, -0.031831607683290866, 0.03743250465851851,
+    -0.013993429710596266, -0.024464622414979025, 0.05079709028063259, -0.04461559569939831,
+    0.05238843492903513, -0.043416492681398716, 0.0021239330439393926, 0.033301127788507884,
+    -0.03605732040518568, 0.008952915068337971, 0.023119786308483888, -0.035050862259149565,
+    0.019573792649607, 0.009921045374039305, -0.03109331855343597, 0.02903410079514328,
+    -0.006022720117838283, -0.021031934071634412, 0.032826328257795995, -0.021031934071634412,
+    -0.006022720117838283, 0.02903410079514328, -0.03109331855343597, 0.009921045374039305,
+    0.019573792649607, -0.035050862259149565, 0.023119786308483888, 0.008952915068337971,
+    -0.03605732040518568, 0.033301127788507884, 0.0021239330439393926, -0.043416492681398716,
+    0.05238843492903513, -0.05758757653750022, 0.029286025434036734, 0.020161388171516914,
+    -0.04008835708335762, 0.018621698533530052, 0.017849714336153292, -0.03536465665737663,
+    0.02120977870646221, 0.009921045374039305, -0.03155459316887729, 0.02716623941683059,
+    -0.0015272549226460431, -0.024747036986531457, 0.031557283383081336, -0.014104453155305192,
+    -0.014104453155305192, 0.031557283383081336, -0.024747036986531457, -0.0015272549226460431,
+    0.02716623941683059, -0.03155459316887729, 0.009921045374039305, 0.02120977870646221,
+    -0.03536465665737663, 0.017849714336153292, 0.018621698533530052, -0.04008835708335762,
+    0.020161388171516914, 0.029286025434036734, -0.05758757653750022, 0.059416207210648615,
+    -0.010343034077007743, -0.03653709520858106, 0.03204111379717317, 0.006812522305094141,
+    -0.03446566146260097, 0.0258799825904089, 0.006476139177256272, -0.03109331855343597,
+    0.02716623941683059, -6.624096460212324e-05, -0.026255424209331992, 0.030216608042805994,
+    -0.009387415455545348, -0.018825359050076502, 0.03164008962427204, -0.018825359050076502,
+    -0.009387415455545348, 0.030216608042805994, -0.026255424209331992, -6.624096460212324e-05,
+    0.02716623941683059, -0.03109331855343597, 0.006476139177256272, 0.0258799825904089,
+    -0.03446566146260097, 0.006812522305094141, 0.03204111379717317, -0.03653709520858106,
+    -0.010343034077007743, 0.059416207210648615, -0.05758757653750022, -0.010343034077007743,
+    0.04254882974255448, -0.01217644265628854, -0.028748781148966444, 0.032436743055838185,
+    -0.0009988365357561043, -0.02917931194865307, 0.02903410079514328, -0.0015272549226460431,
+    -0.026255424209331992, 0.02968635422595281, -0.007045695965290556, -0.02122055311920687,
+    0.030979239330514604, -0.014369269283190541, -0.014369269283190541, 0.030979239330514604,
+    -0.02122055311920687, -0.007045695965290556, 0.02968635422595281, -0.026255424209331992,
+    -0.0015272549226460431, 0.02903410079514328, -0.02917931194865307, -0.0009988365357561043,
+    0.032436743055838185, -0.028748781148966444, -0.01217644265628854, 0.04254882974255448,
+    -0.010343034077007743, -0.05758757653750022, 0.05238843492903513, 0.029286025434036734,
+    -0.03653709520858106, -0.01217644265628854, 0.03734299854965229, -0.013130000808752056,
+    -0.024140094468019603, 0.032109531259110265, -0.006022720117838283, -0.024747036986531457,
+    0.030216608042805994, -0.007045695965290556, -0.021946034114876792, 0.03046292757574619,
+    -0.011673137937825442, -0.01723667190041236, 0.030810947429936546, -0.01723667190041236,
+    -0.011673137937825442, 0.03046292757574619, -0.021946034114876792, -0.007045695965290556,
+    0.030216608042805994, -0.024747036986531457, -0.006022720117838283, 0.032109531259110265,
+    -0.024140094468019603, -0.013130000808752056, 0.03734299854965229, -0.01217644265628854,
+    -0.03653709520858106, 0.029286025434036734, 0.05238843492903513, -0.04461559569939831,
+    -0.043416492681398716, 0.020161388171516914, 0.03204111379717317, -0.028748781148966444,
+    -0.013130000808752056, 0.03457289864304533, -0.013716660068143025, -0.021031934071634412,
+    0.031557283383081336, -0.009387415455545348, -0.02122055311920687, 0.03046292757574619,
+    -0.010776399200789983, -0.018534154698679004, 0.03046527453909969, -0.014551094714836526,
+    -0.014551094714836526, 0.03046527453909969, -0.018534154698679004, -0.010776399200789983,
+    0.03046292757574619, -0.02122055311920687, -0.009387415455545348, 0.031557283383081336,
+    -0.021031934071634412, -0.013716660068143025, 0.03457289864304533, -0.013130000808752056,
+    -0.028748781148966444, 0.03204111379717317, 0.020161388171516914, -0.043416492681398716,
+    -0.04461559569939831, 0.03540212038711747, 0.05079709028063259, 0.0021239330439393926,
+    -0.04008835708335762, 0.006812522305094141, 0.032436743055838185, -0.024140094468019603,
+    -0.013716660068143025, 0.032826328257795995, -0.014104453155305192, -0.018825359050076502,
+    0.030979239330514604, -0.011673137937825442, -0.018534154698679004, 0.030313113652035786,
+    -0.013210618634264398, -0.01611104488636372, 0.03023499108513313, -0.01611104488636372,
+    -0.013210618634264398, 0.030313113652035786, -0.018534154698679004, -0.011673137937825442,
+    0.030979239330514604, -0.018825359050076502, -0.014104453155305192, 0.032826328257795995,
+    -0.013716660068143025, -0.024140094468019603, 0.032436743055838185, 0.006812522305094141,
+    -0.04008835708335762, 0.0021239330439393926, 0.05079709028063259, 0.03540212038711747,
+    -0.025978054192733392, -0.05101988560537101, -0.024464622414979025, 0.033301127788507884,
+    0.018621698533530052, -0.03446566146260097, -0.0009988365357561043, 0.032109531259110265,
+    -0.021031934071634412, -0.014104453155305192, 0.03164008962427204, -0.014369269283190541,
+    -0.01723667190041236, 0.03046527453909969, -0.013210618634264398, -0.016603806802589334,
+    0.0300582797989512, -0.014672765684867526, -0.014672765684867526, 0.0300582797989512,
+    -0.016603806802589334, -0.013210618634264398, 0.03046527453909969, -0.01723667190041236,
+    -0.014369269283190541, 0.03164008962427204, -0.014104453155305192, -0.021031934071634412,
+    0.032109531259110265, -0.0009988365357561043, -0.03446566146260097, 0.018621698533530052,
+    0.033301127788507884, -0.024464622414979025, -0.05101988560537101, -0.025978054192733392,
+    0.017426608529437587, 0.045182401235578366, 0.04140086207487967, -0.013993429710596266,
+    -0.03605732040518568, 0.017849714336153292, 0.0258799825904089, -0.02917931194865307,
+    -0.006022720117838283, 0.031557283383081336, -0.018825359050076502, -0.014369269283190541,
+    0.030810947429936546, -0.014551094714836526, -0.01611104488636372, 0.0300582797989512,
+    -0.014196764518339759, -0.01535810437054133, 0.029854661591954577, -0.01535810437054133,
+    -0.014196764518339759, 0.0300582797989512, -0.01611104488636372, -0.014551094714836526,
+    0.030810947429936546, -0.014369269283190541, -0.018825359050076502, 0.031557283383081336,
+    -0.006022720117838283, -0.02917931194865307, 0.0258799825904089, 0.017849714336153292,
+    -0.03605732040518568, -0.013993429710596266, 0.04140086207487967, 0.045182401235578366,
+    0.017426608529437587, -0.010495754201812346, -0.035467138110187785, -0.049457654564265555,
+    -0.011196594598243893, 0.03743250465851851, 0.008952915068337971, -0.03536465665737663,
+    0.006476139177256272, 0.02903410079514328, -0.024747036986531457, -0.009387415455545348,
+    0.030979239330514604, -0.01723667190041236, -0.014551094714836526, 0.03023499108513313,
+    -0.014672765684867526, -0.01535810437054133, 0.029779086652332254, -0.01474769331688136,
+    -0.01474769331688136, 0.029779086652332254, -0.01535810437054133, -0.014672765684867526,
+    0.03023499108513313, -0.014551094714836526, -0.01723667190041236, 0.030979239330514604,
+    -0.009387415455545348, -0.024747036986531457, 0.02903410079514328, 0.006476139177256272,
+    -0.03536465665737663, 0.008952915068337971, 0.03743250465851851, -0.011196594598243893,
+    -0.049457654564265555, -0.035467138110187785, -0.010495754201812346, 0.005507644580631185,
+    0.024468353148246223, 0.048006184232305564, 0.03392724527115009, -0.021687144131695292,
+    -0.031831607683290866, 0.023119786308483888, 0.02120977870646221, -0.03109331855343597,
+    -0.0015272549226460431, 0.030216608042805994, -0.02122055311920687, -0.011673137937825442,
+    0.03046527453909969, -0.01611104488636372, -0.014672765684867526, 0.029854661591954577,
+    -0.01474769331688136, -0.014924910412451557, 0.029637533898749846, -0.014924910412451557,
+    -0.01474769331688136, 0.029854661591954577, -0.014672765684867526, -0.01611104488636372,
+    0.03046527453909969, -0.011673137937825442, -0.02122055311920687, 0.030216608042805994,
+    -0.0015272549226460431, -0.03109331855343597, 0.02120977870646221, 0.023119786308483888,
+    -0.031831607683290866, -0.021687144131695292, 0.03392724527115009, 0.048006184232305564,
+    0.024468353148246223, 0.005507644580631185, -0.0023791677651473432, -0.014481938107885934,
+    -0.03913510349250114, -0.047334079710196104, -0.004816138116954908, 0.03825071407679321,
+    0.00418838607586827, -0.035050862259149565, 0.009921045374039305, 0.02716623941683059,
+    -0.026255424209331992, -0.007045695965290556, 0.03046292757574619, -0.018534154698679004,
+    -0.013210618634264398, 0.0300582797989512, -0.01535810437054133, -0.01474769331688136,
+    0.029637533898749846, -0.014783442067309836, -0.014783442067309836, 0.029637533898749846,
+    -0.01474769331688136, -0.01535810437054133, 0.0300582797989512, -0.013210618634264398,
+    -0.018534154698679004, 0.03046292757574619, -0.007045695965290556, -0.026255424209331992,
+    0.02716623941683059, 0.009921045374039305, -0.035050862259149565, 0.00418838607586827,
+    0.03825071407679321, -0.004816138116954908, -0.047334079710196104, -0.03913510349250114,
+    -0.014481938107885934, -0.0023791677651473432, 0.0007342271125681172, 0.006975157569397114,
+    0.02662985258275902, 0.048487228933825274, 0.03125120930479639, -0.023894436812027072,
+    -0.030200241805829343, 0.024636296223062636, 0.019573792649607, -0.03155459316887729,
+    -6.624096460212324e-05, 0.02968635422595281, -0.021946034114876792, -0.010776399200789983,
+    0.030313113652035786, -0.016603806802589334, -0.014196764518339759, 0.029779086652332254,
+    -0.014924910412451557, -0.014783442067309836, 0.02956688413461967, -0.014783442067309836,
+    -0.014924910412451557, 0.029779086652332254, -0.014196764518339759, -0.016603806802589334,
+    0.030313113652035786, -0.010776399200789983, -0.021946034114876792, 0.02968635422595281,
+    -6.624096460212324e-05, -0.03155459316887729, 0.019573792649607, 0.024636296223062636,
+    -0.030200241805829343, -0.023894436812027072, 0.03125120930479639, 0.048487228933825274,
+    0.02662985258275902, 0.006975157569397114, 0.0007342271125681172, -0.0023791677651473432,
+    -0.014481938107885934, -0.03913510349250114, -0.047334079710196104, -0.004816138116954908,
+    0.03825071407679321, 0.00418838607586827, -0.035050862259149565, 0.009921045374039305,
+    0.02716623941683059, -0.026255424209331992, -0.007045695965290556, 0.03046292757574619,
+    -0.018534154698679004, -0.013210618634264398, 0.0300582797989512, -0.01535810437054133,
+    -0.01474769331688136, 0.029637533898749846, -0.014783442067309836, -0.014783442067309836,
+    0.029637533898749846, -0.01474769331688136, -0.01535810437054133, 0.0300582797989512,
+    -0.013210618634264398, -0.018534154698679004, 0.03046292757574619, -0.007045695965290556,
+    -0.026255424209331992, 0.02716623941683059, 0.009921045374039305, -0.035050862259149565,
+    0.00418838607586827, 0.03825071407679321, -0.004816138116954908, -0.047334079710196104,
+    -0.03913510349250114, -0.014481938107885934, -0.0023791677651473432, 0.005507644580631185,
+    0.024468353148246223, 0.048006184232305564, 0.03392724527115009, -0.021687144131695292,
+    -0.031831607683290866, 0.023119786308483888, 0.02120977870646221, -0.03109331855343597,
+    -0.0015272549226460431, 0.030216608042805994, -0.02122055311920687, -0.011673137937825442,
+    0.03046527453909969, -0.01611104488636372, -0.014672765684867526, 0.029854661591954577,
+    -0.01474769331688136, -0.014924910412451557, 0.029637533898749846, -0.014924910412451557,
+    -0.01474769331688136, 0.029854661591954577, -0.014672765684867526, -0.01611104488636372,
+    0.03046527453909969, -0.011673137937825442, -0.02122055311920687, 0.030216608042805994,
+    -0.0015272549226460431, -0.03109331855343597, 0.02120977870646221, 0.023119786308483888,
+    -0.031831607683290866, -0.021687144131695292, 0.03392724527115009, 0.048006184232305564,
+    0.024468353148246223, 0.005507644580631185, -0.010495754201812346, -0.035467138110187785,
+    -0.049457654564265555, -0.011196594598243893, 0.03743250465851851, 0.008952915068337971,
+    -0.03536465665737663, 0.006476139177256272, 0.02903410079514328, -0.024747036986531457,
+    -0.009387415455545348, 0.030979239330514604, -0.01723667190041236, -0.014551094714836526,
+    0.03023499108513313, -0.014672765684867526, -0.01535810437054133, 0.029779086652332254,
+    -0.01474769331688136, -0.01474769331688136, 0.029779086652332254, -0.01535810437054133,
+    -0.014672765684867526, 0.03023499108513313, -0.014551094714836526, -0.01723667190041236,
+    0.030979239330514604, -0.009387415455545348, -0.024747036986531457, 0.02903410079514328,
+    0.006476139177256272, -0.03536465665737663, 0.008952915068337971, 0.03743250465851851,
+    -0.011196594598243893, -0.049457654564265555, -0.035467138110187785, -0.010495754201812346,
+    0.017426608529437587, 0.045182401235578366, 0.04140086207487967, -0.013993429710596266,
+    -0.03605732040518568, 0.017849714336153292, 0.0258799825904089, -0.02917931194865307,
+    -0.006022720117838283, 0.031557283383081336, -0.018825359050076502, -0.014369269283190541,
+    0.030810947429936546, -0.014551094714836526, -0.01611104488636372, 0.0300582797989512,
+    -0.014196764518339759, -0.01535810437054133, 0.029854661591954577, -0.01535810437054133,
+    -0.014196764518339759, 0.0300582797989512, -0.01611104488636372, -0.014551094714836526,
+    0.030810947429936546, -0.014369269283190541, -0.018825359050076502, 0.031557283383081336,
+    -0.006022720117838283, -0.02917931194865307, 0.0258799825904089, 0.017849714336153292,
+    -0.03605732040518568, -0.013993429710596266, 0.04140086207487967, 0.045182401235578366,
+    0.017426608529437587, -0.025978054192733392, -0.05101988560537101, -0.024464622414979025,
+    0.033301127788507884, 0.018621698533530052, -0.03446566146260097, -0.0009988365357561043,
+    0.032109531259110265, -0.021031934071634412, -0.014104453155305192, 0.03164008962427204,
+    -0.014369269283190541, -0.01723667190041236, 0.03046527453909969, -0.013210618634264398,
+    -0.016603806802589334, 0.0300582797989512, -0.014672765684867526, -0.014672765684867526,
+    0.0300582797989512, -0.016603806802589334, -0.013210618634264398, 0.03046527453909969,
+    -0.01723667190041236, -0.014369269283190541, 0.03164008962427204, -0.014104453155305192,
+    -0.021031934071634412, 0.032109531259110265, -0.0009988365357561043, -0.03446566146260097,
+    0.018621698533530052, 0.033301127788507884, -0.024464622414979025, -0.05101988560537101,
+    -0.025978054192733392, 0.03540212038711747, 0.05079709028063259, 0.0021239330439393926,
+    -0.04008835708335762, 0.006812522305094141, 0.032436743055838185, -0.024140094468019603,
+    -0.013716660068143025, 0.032826328257795995, -0.014104453155305192, -0.018825359050076502,
+    0.030979239330514604, -0.011673137937825442, -0.018534154698679004, 0.030313113652035786,
+    -0.013210618634264398, -0.01611104488636372, 0.03023499108513313, -0.01611104488636372,
+    -0.013210618634264398, 0.030313113652035786, -0.018534154698679004, -0.011673137937825442,
+    0.030979239330514604, -0.018825359050076502, -0.014104453155305192, 0.032826328257795995,
+    -0.013716660068143025, -0.024140094468019603, 0.032436743055838185, 0.006812522305094141,
+    -0.04008835708335762, 0.0021239330439393926, 0.05079709028063259, 0.03540212038711747,
+    -0.04461559569939831, -0.043416492681398716, 0.020161388171516914, 0.03204111379717317,
+    -0.028748781148966444, -0.013130000808752056, 0.03457289864304533, -0.013716660068143025,
+    -0.021031934071634412, 0.031557283383081336, -0.009387415455545348, -0.02122055311920687,
+    0.03046292757574619, -0.010776399200789983, -0.018534154698679004, 0.03046527453909969,
+    -0.014551094714836526, -0.014551094714836526, 0.03046527453909969, -0.018534154698679004,
+    -0.010776399200789983, 0.03046292757574619, -0.02122055311920687, -0.009387415455545348,
+    0.031557283383081336, -0.021031934071634412, -0.013716660068143025, 0.03457289864304533,
+    -0.013130000808752056, -0.028748781148966444, 0.03204111379717317, 0.020161388171516914,
+    -0.043416492681398716, -0.04461559569939831, 0.05238843492903513, 0.029286025434036734,
+    -0.03653709520858106, -0.01217644265628854, 0.03734299854965229, -0.013130000808752056,
+    -0.024140094468019603, 0.032109531259110265, -0.006022720117838283, -0.024747036986531457,
+    0.030216608042805994, -0.007045695965290556, -0.021946034114876792, 0.03046292757574619,
+    -0.011673137937825442, -0.01723667190041236, 0.030810947429936546, -0.01723667190041236,
+    -0.011673137937825442, 0.03046292757574619, -0.021946034114876792, -0.007045695965290556,
+    0.030216608042805994, -0.024747036986531457, -0.006022720117838283, 0.032109531259110265,
+    -0.024140094468019603, -0.013130000808752056, 0.03734299854965229, -0.01217644265628854,
+    -0.03653709520858106, 0.029286025434036734, 0.05238843492903513, -0.05758757653750022,
+    -0.010343034077007743, 0.04254882974255448, -0.01217644265628854, -0.028748781148966444,
+    0.032436743055838185, -0.0009988365357561043, -0.02917931194865307, 0.02903410079514328,
+    -0.0015272549226460431, -0.026255424209331992, 0.02968635422595281, -0.007045695965290556,
+    -0.02122055311920687, 0.030979239330514604, -0.014369269283190541, -0.014369269283190541,
+    0.030979239330514604, -0.02122055311920687, -0.007045695965290556, 0.02968635422595281,
+    -0.026255424209331992, -0.0015272549226460431, 0.02903410079514328, -0.02917931194865307,
+    -0.0009988365357561043, 0.032436743055838185, -0.028748781148966444, -0.01217644265628854,
+    0.04254882974255448, -0.010343034077007743, -0.05758757653750022, 0.059416207210648615,
+    -0.010343034077007743, -0.03653709520858106, 0.03204111379717317, 0.006812522305094141,
+    -0.03446566146260097, 0.0258799825904089, 0.006476139177256272, -0.03109331855343597,
+    0.02716623941683059, -6.624096460212324e-05, -0.026255424209331992, 0.030216608042805994,
+    -0.009387415455545348, -0.018825359050076502, 0.03164008962427204, -0.018825359050076502,
+    -0.009387415455545348, 0.030216608042805994, -0.026255424209331992, -6.624096460212324e-05,
+    0.02716623941683059, -0.03109331855343597, 0.006476139177256272, 0.0258799825904089,
+    -0.03446566146260097, 0.006812522305094141, 0.03204111379717317, -0.03653709520858106,
+    -0.010343034077007743, 0.059416207210648615, -0.05758757653750022, 0.029286025434036734,
+    0.020161388171516914, -0.04008835708335762, 0.018621698533530052, 0.017849714336153292,
+    -0.03536465665737663, 0.02120977870646221, 0.009921045374039305, -0.03155459316887729,
+    0.02716623941683059, -0.0015272549226460431, -0.024747036986531457, 0.031557283383081336,
+    -0.014104453155305192, -0.014104453155305192, 0.031557283383081336, -0.024747036986531457,
+    -0.0015272549226460431, 0.02716623941683059, -0.03155459316887729, 0.009921045374039305,
+    0.02120977870646221, -0.03536465665737663, 0.017849714336153292, 0.018621698533530052,
+    -0.04008835708335762, 0.020161388171516914, 0.029286025434036734, -0.05758757653750022,
+    0.05238843492903513, -0.043416492681398716, 0.0021239330439393926, 0.033301127788507884,
+    -0.03605732040518568, 0.008952915068337971, 0.023119786308483888, -0.035050862259149565,
+    0.019573792649607, 0.009921045374039305, -0.03109331855343597, 0.02903410079514328,
+    -0.006022720117838283, -0.021031934071634412, 0.032826328257795995, -0.021031934071634412,
+    -0.006022720117838283, 0.02903410079514328, -0.03109331855343597, 0.009921045374039305,
+    0.019573792649607, -0.035050862259149565, 0.023119786308483888, 0.008952915068337971,
+    -0.03605732040518568, 0.033301127788507884, 0.0021239330439393926, -0.043416492681398716,
+    0.05238843492903513, -0.04461559569939831, 0.05079709028063259, -0.024464622414979025,
+    -0.013993429710596266, 0.03743250465851851, -0.031831607683290866, 0.00418838607586827,
+    0.024636296223062636, -0.035050862259149565, 0.02120977870646221, 0.006476139177256272,
+    -0.02917931194865307, 0.032109531259110265, -0.013716660068143025, -0.013716660068143025,
+    0.032109531259110265, -0.02917931194865307, 0.006476139177256272, 0.02120977870646221,
+    -0.035050862259149565, 0.024636296223062636, 0.00418838607586827, -0.031831607683290866,
+    0.03743250465851851, -0.013993429710596266, -0.024464622414979025, 0.05079709028063259,
+    -0.04461559569939831, 0.03540212038711747, -0.05101988560537101, 0.04140086207487967,
+    -0.011196594598243893, -0.021687144131695292, 0.03825071407679321, -0.030200241805829343,
+    0.00418838607586827, 0.023119786308483888, -0.03536465665737663, 0.0258799825904089,
+    -0.0009988365357561043, -0.024140094468019603, 0.03457289864304533, -0.024140094468019603,
+    -0.0009988365357561043, 0.0258799825904089, -0.03536465665737663, 0.023119786308483888,
+    0.00418838607586827, -0.030200241805829343, 0.03825071407679321, -0.021687144131695292,
+    -0.011196594598243893, 0.04140086207487967, -0.05101988560537101, 0.03540212038711747,
+    -0.025978054192733392, 0.045182401235578366, -0.049457654564265555, 0.03392724527115009,
+    -0.004816138116954908, -0.023894436812027072, 0.03825071407679321, -0.031831607683290866,
+    0.008952915068337971, 0.017849714336153292, -0.03446566146260097, 0.032436743055838185,
+    -0.013130000808752056, -0.013130000808752056, 0.032436743055838185, -0.03446566146260097,
+    0.017849714336153292, 0.008952915068337971, -0.031831607683290866, 0.03825071407679321,
+    -0.023894436812027072, -0.004816138116954908, 0.03392724527115009, -0.049457654564265555,
+    0.045182401235578366, -0.025978054192733392, 0.017426608529437587, -0.035467138110187785,
+    0.048006184232305564, -0.047334079710196104, 0.03125120930479639, -0.004816138116954908,
+    -0.021687144131695292, 0.03743250465851851, -0.03605732040518568, 0.018621698533530052,
+    0.006812522305094141, -0.028748781148966444, 0.03734299854965229, -0.028748781148966444,
+    0.006812522305094141, 0.018621698533530052, -0.03605732040518568, 0.03743250465851851,
+    -0.021687144131695292, -0.004816138116954908, 0.03125120930479639, -0.047334079710196104,
+    0.048006184232305564, -0.035467138110187785, 0.017426608529437587, -0.010495754201812346,
+    0.024468353148246223, -0.03913510349250114, 0.048487228933825274, -0.047334079710196104,
+    0.03392724527115009, -0.011196594598243893, -0.013993429710596266, 0.033301127788507884,
+    -0.04008835708335762, 0.03204111379717317, -0.01217644265628854, -0.01217644265628854,
+    0.03204111379717317, -0.04008835708335762, 0.033301127788507884, -0.013993429710596266,
+    -0.011196594598243893, 0.03392724527115009, -0.047334079710196104, 0.048487228933825274,
+    -0.03913510349250114, 0.024468353148246223, -0.010495754201812346, 0.005507644580631185,
+    -0.014481938107885934, 0.02662985258275902, -0.03913510349250114, 0.048006184232305564,
+    -0.049457654564265555, 0.04140086207487967, -0.024464622414979025, 0.0021239330439393926,
+    0.020161388171516914, -0.03653709520858106, 0.04254882974255448, -0.03653709520858106,
+    0.020161388171516914, 0.0021239330439393926, -0.024464622414979025, 0.04140086207487967,
+    -0.049457654564265555, 0.048006184232305564, -0.03913510349250114, 0.02662985258275902,
+    -0.014481938107885934, 0.005507644580631185, -0.0023791677651473432, 0.006975157569397114,
+    -0.014481938107885934, 0.024468353148246223, -0.035467138110187785, 0.045182401235578366,
+    -0.05101988560537101, 0.05079709028063259, -0.043416492681398716, 0.029286025434036734,
+    -0.010343034077007743, -0.010343034077007743, 0.029286025434036734, -0.043416492681398716,
+    0.05079709028063259, -0.05101988560537101, 0.045182401235578366, -0.035467138110187785,
+    0.024468353148246223, -0.014481938107885934, 0.006975157569397114, -0.0023791677651473432,
+    0.0007342271125681172, -0.0023791677651473432, 0.005507644580631185, -0.010495754201812346,
+    0.017426608529437587, -0.025978054192733392, 0.03540212038711747, -0.04461559569939831,
+    0.05238843492903513, -0.05758757653750022, 0.059416207210648615, -0.05758757653750022,
+    0.05238843492903513, -0.04461559569939831, 0.03540212038711747, -0.025978054192733392,
+    0.017426608529437587, -0.010495754201812346, 0.005507644580631185, -0.0023791677651473432,
+    0.0007342271125681172}};
+
+} // namespace
+
 inline int lmIndex(int l, int m)
 {
     return m < 0 ? l - m : m;
 }
 
-float reduceWigner3j(const std::complex<float>* source, unsigned int l_, const std::vector<double>& wigner3j)
+const std::vector<Wigner3jTerm>& getWigner3jTerms(unsigned int l)
 {
+    if (l >= 21)
+    {
+        throw std::out_of_range("Wigner 3j coefficients are implemented for l <= 20.");
+    }
     /*
      * Wigner 3j coefficients:
      * (j1 j2 j3)
@@ -33,5800 +2367,61 @@ float reduceWigner3j(const std::complex<float>* source, unsigned int l_, const s
      * m1 from -l to l
      * m2 from max(-l-m1, -l) to min(l-m1, l)
      * m3 = -m1 - m2
+     *
+     * The tables pair each coefficient with the three source-array indices
+     * its (m1, m2, m3) triple addresses, so reductions never redo this index
+     * arithmetic. Built once for all l on first use; the initialization of
+     * the function-local static is thread-safe.
      */
-
-    const int l(static_cast<int>(l_)); // Create signed int for simplicity of following code
-    float result = 0;
-    unsigned int counter = 0;
-    for (int m1 = -l; m1 <= l; m1++)
-    {
-        const int m1_index = lmIndex(l, m1);
-        for (int m2 = std::max(-l - m1, -l); m2 <= std::min(l - m1, l); m2++)
+    static const std::array<std::vector<Wigner3jTerm>, 21> term_tables = []() {
+        std::array<std::vector<Wigner3jTerm>, 21> tables;
+        for (int l_value = 0; l_value < 21; l_value++)
         {
-            const int m2_index = lmIndex(l, m2);
-            const int m3 = -m1 - m2;
-            const int m3_index = lmIndex(l, m3);
-            result
-                += (float(wigner3j[counter]) * source[m1_index] * source[m2_index] * source[m3_index]).real();
-            counter++;
+            const double* coefficients = &WIGNER3J_TABLE[WIGNER3J_OFFSETS[l_value]];
+            auto& terms = tables[l_value];
+            terms.reserve(3 * l_value * l_value + 3 * l_value + 1);
+            unsigned int counter = 0;
+            for (int m1 = -l_value; m1 <= l_value; m1++)
+            {
+                for (int m2 = std::max(-l_value - m1, -l_value); m2 <= std::min(l_value - m1, l_value);
+                     m2++)
+                {
+                    const int m3 = -m1 - m2;
+                    terms.push_back({static_cast<unsigned int>(lmIndex(l_value, m1)),
+                                     static_cast<unsigned int>(lmIndex(l_value, m2)),
+                                     static_cast<unsigned int>(lmIndex(l_value, m3)),
+                                     static_cast<float>(coefficients[counter])});
+                    counter++;
+                }
+            }
         }
-    } // Ends loop over Wigner 3j coefficients
-    return result;
+        return tables;
+    }();
+    return term_tables[l];
 }
 
-std::vector<double> getWigner3j(unsigned int l)
+float reduceWigner3j(const std::complex<float>* source, const std::vector<Wigner3jTerm>& terms)
 {
-    switch (l)
+    // With the index arithmetic resolved into the term table, each term is
+    // three gathered complex loads and a fused multiply-add chain on the real
+    // part of their product.
+    float result = 0;
+    for (const auto& term : terms)
     {
-    case 0: {
-        return {1.0};
-    }
-
-    case 1: {
-        return {0.408248290463863, -0.408248290463863, -0.408248290463863, 0.0,
-                0.408248290463863, 0.408248290463863,  -0.408248290463863};
-    }
-
-    case 2: {
-        return {0.23904572186687872,  -0.29277002188455997, 0.23904572186687872,  -0.29277002188455997,
-                0.11952286093343936,  0.11952286093343936,  -0.29277002188455997, 0.23904572186687872,
-                0.11952286093343936,  -0.23904572186687872, 0.11952286093343936,  0.23904572186687872,
-                -0.29277002188455997, 0.11952286093343936,  0.11952286093343936,  -0.29277002188455997,
-                0.23904572186687872,  -0.29277002188455997, 0.23904572186687872};
-    }
-
-    case 3: {
-        return {0.1543033499620919,
-                -0.2182178902359924,
-                0.2182178902359924,
-                -0.1543033499620919,
-                -0.2182178902359924,
-                0.1543033499620919,
-                0.0,
-                -0.1543033499620919,
-                0.2182178902359924,
-                0.2182178902359924,
-                0.0,
-                -0.1543033499620919,
-                0.1543033499620919,
-                0.0,
-                -0.2182178902359924,
-                -0.1543033499620919,
-                -0.1543033499620919,
-                0.1543033499620919,
-                0.0,
-                -0.1543033499620919,
-                0.1543033499620919,
-                0.1543033499620919,
-                0.2182178902359924,
-                0.0,
-                -0.1543033499620919,
-                0.1543033499620919,
-                0.0,
-                -0.2182178902359924,
-                -0.2182178902359924,
-                0.1543033499620919,
-                0.0,
-                -0.1543033499620919,
-                0.2182178902359924,
-                0.1543033499620919,
-                -0.2182178902359924,
-                0.2182178902359924,
-                -0.1543033499620919};
-    }
-
-    case 4: {
-        return {0.10429770312912398,   -0.16490914830605122,  0.18698939800169143,  -0.16490914830605122,
-                0.10429770312912398,   -0.16490914830605122,  0.15644655469368596,  -0.062329799333897144,
-                -0.062329799333897144, 0.15644655469368596,   -0.16490914830605122, 0.18698939800169143,
-                -0.062329799333897144, -0.08194819531574027,  0.1413506985480439,   -0.08194819531574027,
-                -0.062329799333897144, 0.18698939800169143,   -0.16490914830605122, -0.062329799333897144,
-                0.1413506985480439,    -0.06704852344015114,  -0.06704852344015114, 0.1413506985480439,
-                -0.062329799333897144, -0.16490914830605122,  0.10429770312912398,  0.15644655469368596,
-                -0.08194819531574027,  -0.06704852344015114,  0.13409704688030227,  -0.06704852344015114,
-                -0.08194819531574027,  0.15644655469368596,   0.10429770312912398,  -0.16490914830605122,
-                -0.062329799333897144, 0.1413506985480439,    -0.06704852344015114, -0.06704852344015114,
-                0.1413506985480439,    -0.062329799333897144, -0.16490914830605122, 0.18698939800169143,
-                -0.062329799333897144, -0.08194819531574027,  0.1413506985480439,   -0.08194819531574027,
-                -0.062329799333897144, 0.18698939800169143,   -0.16490914830605122, 0.15644655469368596,
-                -0.062329799333897144, -0.062329799333897144, 0.15644655469368596,  -0.16490914830605122,
-                0.10429770312912398,   -0.16490914830605122,  0.18698939800169143,  -0.16490914830605122,
-                0.10429770312912398};
-    }
-
-    case 5: {
-        return {0.07242068243779014,
-                -0.1254363015010636,
-                0.15644655469368596,
-                -0.15644655469368596,
-                0.1254363015010636,
-                -0.07242068243779014,
-                -0.1254363015010636,
-                0.14484136487558028,
-                -0.09349469900084571,
-                0.0,
-                0.09349469900084571,
-                -0.14484136487558028,
-                0.1254363015010636,
-                0.15644655469368596,
-                -0.09349469900084571,
-                -0.02414022747926338,
-                0.10795837927188262,
-                -0.10795837927188262,
-                0.02414022747926338,
-                0.09349469900084571,
-                -0.15644655469368596,
-                -0.15644655469368596,
-                0.0,
-                0.10795837927188262,
-                -0.09656090991705352,
-                0.0,
-                0.09656090991705352,
-                -0.10795837927188262,
-                0.0,
-                0.15644655469368596,
-                0.1254363015010636,
-                0.09349469900084571,
-                -0.10795837927188262,
-                0.0,
-                0.09656090991705352,
-                -0.09656090991705352,
-                0.0,
-                0.10795837927188262,
-                -0.09349469900084571,
-                -0.1254363015010636,
-                -0.07242068243779014,
-                -0.14484136487558028,
-                0.02414022747926338,
-                0.09656090991705352,
-                -0.09656090991705352,
-                0.0,
-                0.09656090991705352,
-                -0.09656090991705352,
-                -0.02414022747926338,
-                0.14484136487558028,
-                0.07242068243779014,
-                0.1254363015010636,
-                0.09349469900084571,
-                -0.10795837927188262,
-                0.0,
-                0.09656090991705352,
-                -0.09656090991705352,
-                0.0,
-                0.10795837927188262,
-                -0.09349469900084571,
-                -0.1254363015010636,
-                -0.15644655469368596,
-                0.0,
-                0.10795837927188262,
-                -0.09656090991705352,
-                0.0,
-                0.09656090991705352,
-                -0.10795837927188262,
-                0.0,
-                0.15644655469368596,
-                0.15644655469368596,
-                -0.09349469900084571,
-                -0.02414022747926338,
-                0.10795837927188262,
-                -0.10795837927188262,
-                0.02414022747926338,
-                0.09349469900084571,
-                -0.15644655469368596,
-                -0.1254363015010636,
-                0.14484136487558028,
-                -0.09349469900084571,
-                0.0,
-                0.09349469900084571,
-                -0.14484136487558028,
-                0.1254363015010636,
-                0.07242068243779014,
-                -0.1254363015010636,
-                0.15644655469368596,
-                -0.15644655469368596,
-                0.1254363015010636,
-                -0.07242068243779014};
-    }
-
-    case 6: {
-        return {0.051182725116209915, -0.09575411075314348, 0.12911481660011878,  -0.14143819512005507,
-                0.12911481660011878,  -0.09575411075314348, 0.051182725116209915, -0.09575411075314348,
-                0.1279568127905248,   -0.1060786463400413,  0.0408296900131293,   0.0408296900131293,
-                -0.1060786463400413,  0.1279568127905248,   -0.09575411075314348, 0.12911481660011878,
-                -0.1060786463400413,  0.01861190004225815,  0.06881842847817146,  -0.10445902991252017,
-                0.06881842847817146,  0.01861190004225815,  -0.1060786463400413,  0.12911481660011878,
-                -0.14143819512005507, 0.0408296900131293,   0.06881842847817146,  -0.10003896272713755,
-                0.045232086779460515, 0.045232086779460515, -0.10003896272713755, 0.06881842847817146,
-                0.0408296900131293,   -0.14143819512005507, 0.12911481660011878,  0.0408296900131293,
-                -0.10445902991252017, 0.045232086779460515, 0.051182725116209915, -0.09535761169699032,
-                0.051182725116209915, 0.045232086779460515, -0.10445902991252017, 0.0408296900131293,
-                0.12911481660011878,  -0.09575411075314348, -0.1060786463400413,  0.06881842847817146,
-                0.045232086779460515, -0.09535761169699032, 0.046529750105645376, 0.046529750105645376,
-                -0.09535761169699032, 0.045232086779460515, 0.06881842847817146,  -0.1060786463400413,
-                -0.09575411075314348, 0.051182725116209915, 0.1279568127905248,   0.01861190004225815,
-                -0.10003896272713755, 0.051182725116209915, 0.046529750105645376, -0.09305950021129075,
-                0.046529750105645376, 0.051182725116209915, -0.10003896272713755, 0.01861190004225815,
-                0.1279568127905248,   0.051182725116209915, -0.09575411075314348, -0.1060786463400413,
-                0.06881842847817146,  0.045232086779460515, -0.09535761169699032, 0.046529750105645376,
-                0.046529750105645376, -0.09535761169699032, 0.045232086779460515, 0.06881842847817146,
-                -0.1060786463400413,  -0.09575411075314348, 0.12911481660011878,  0.0408296900131293,
-                -0.10445902991252017, 0.045232086779460515, 0.051182725116209915, -0.09535761169699032,
-                0.051182725116209915, 0.045232086779460515, -0.10445902991252017, 0.0408296900131293,
-                0.12911481660011878,  -0.14143819512005507, 0.0408296900131293,   0.06881842847817146,
-                -0.10003896272713755, 0.045232086779460515, 0.045232086779460515, -0.10003896272713755,
-                0.06881842847817146,  0.0408296900131293,   -0.14143819512005507, 0.12911481660011878,
-                -0.1060786463400413,  0.01861190004225815,  0.06881842847817146,  -0.10445902991252017,
-                0.06881842847817146,  0.01861190004225815,  -0.1060786463400413,  0.12911481660011878,
-                -0.09575411075314348, 0.1279568127905248,   -0.1060786463400413,  0.0408296900131293,
-                0.0408296900131293,   -0.1060786463400413,  0.1279568127905248,   -0.09575411075314348,
-                0.051182725116209915, -0.09575411075314348, 0.12911481660011878,  -0.14143819512005507,
-                0.12911481660011878,  -0.09575411075314348, 0.051182725116209915};
-    }
-
-    case 7: {
-        return {0.036627711739690504,
-                -0.07325542347938101,
-                0.10557230146166803,
-                -0.12441815044835987,
-                0.12441815044835987,
-                -0.10557230146166803,
-                0.07325542347938101,
-                -0.036627711739690504,
-                -0.07325542347938101,
-                0.10988313521907152,
-                -0.10750956949750906,
-                0.06583589693379592,
-                0.0,
-                -0.06583589693379592,
-                0.10750956949750906,
-                -0.10988313521907152,
-                0.07325542347938101,
-                0.10557230146166803,
-                -0.10750956949750906,
-                0.04789777689036451,
-                0.03162654189033221,
-                -0.08564508030762896,
-                0.08564508030762896,
-                -0.03162654189033221,
-                -0.04789777689036451,
-                0.10750956949750906,
-                -0.10557230146166803,
-                -0.12441815044835987,
-                0.06583589693379592,
-                0.03162654189033221,
-                -0.08734300491772351,
-                0.06992891524445957,
-                0.0,
-                -0.06992891524445957,
-                0.08734300491772351,
-                -0.03162654189033221,
-                -0.06583589693379592,
-                0.12441815044835987,
-                0.12441815044835987,
-                0.0,
-                -0.08564508030762896,
-                0.06992891524445957,
-                0.008452548863005501,
-                -0.07454447412044773,
-                0.07454447412044773,
-                -0.008452548863005501,
-                -0.06992891524445957,
-                0.08564508030762896,
-                0.0,
-                -0.12441815044835987,
-                -0.10557230146166803,
-                -0.06583589693379592,
-                0.08564508030762896,
-                0.0,
-                -0.07454447412044773,
-                0.07043790719171251,
-                0.0,
-                -0.07043790719171251,
-                0.07454447412044773,
-                0.0,
-                -0.08564508030762896,
-                0.06583589693379592,
-                0.10557230146166803,
-                0.07325542347938101,
-                0.10750956949750906,
-                -0.03162654189033221,
-                -0.06992891524445957,
-                0.07454447412044773,
-                0.0,
-                -0.07043790719171251,
-                0.07043790719171251,
-                0.0,
-                -0.07454447412044773,
-                0.06992891524445957,
-                0.03162654189033221,
-                -0.10750956949750906,
-                -0.07325542347938101,
-                -0.036627711739690504,
-                -0.10988313521907152,
-                -0.04789777689036451,
-                0.08734300491772351,
-                -0.008452548863005501,
-                -0.07043790719171251,
-                0.07043790719171251,
-                0.0,
-                -0.07043790719171251,
-                0.07043790719171251,
-                0.008452548863005501,
-                -0.08734300491772351,
-                0.04789777689036451,
-                0.10988313521907152,
-                0.036627711739690504,
-                0.07325542347938101,
-                0.10750956949750906,
-                -0.03162654189033221,
-                -0.06992891524445957,
-                0.07454447412044773,
-                0.0,
-                -0.07043790719171251,
-                0.07043790719171251,
-                0.0,
-                -0.07454447412044773,
-                0.06992891524445957,
-                0.03162654189033221,
-                -0.10750956949750906,
-                -0.07325542347938101,
-                -0.10557230146166803,
-                -0.06583589693379592,
-                0.08564508030762896,
-                0.0,
-                -0.07454447412044773,
-                0.07043790719171251,
-                0.0,
-                -0.07043790719171251,
-                0.07454447412044773,
-                0.0,
-                -0.08564508030762896,
-                0.06583589693379592,
-                0.10557230146166803,
-                0.12441815044835987,
-                0.0,
-                -0.08564508030762896,
-                0.06992891524445957,
-                0.008452548863005501,
-                -0.07454447412044773,
-                0.07454447412044773,
-                -0.008452548863005501,
-                -0.06992891524445957,
-                0.08564508030762896,
-                0.0,
-                -0.12441815044835987,
-                -0.12441815044835987,
-                0.06583589693379592,
-                0.03162654189033221,
-                -0.08734300491772351,
-                0.06992891524445957,
-                0.0,
-                -0.06992891524445957,
-                0.08734300491772351,
-                -0.03162654189033221,
-                -0.06583589693379592,
-                0.12441815044835987,
-                0.10557230146166803,
-                -0.10750956949750906,
-                0.04789777689036451,
-                0.03162654189033221,
-                -0.08564508030762896,
-                0.08564508030762896,
-                -0.03162654189033221,
-                -0.04789777689036451,
-                0.10750956949750906,
-                -0.10557230146166803,
-                -0.07325542347938101,
-                0.10988313521907152,
-                -0.10750956949750906,
-                0.06583589693379592,
-                0.0,
-                -0.06583589693379592,
-                0.10750956949750906,
-                -0.10988313521907152,
-                0.07325542347938101,
-                0.036627711739690504,
-                -0.07325542347938101,
-                0.10557230146166803,
-                -0.12441815044835987,
-                0.12441815044835987,
-                -0.10557230146166803,
-                0.07325542347938101,
-                -0.036627711739690504};
-    }
-
-    case 8: {
-        return {0.02645674994617371,
-                -0.05612324188528877,
-                0.08572966806188397,
-                -0.1074678263122828,
-                0.11543896335436807,
-                -0.1074678263122828,
-                0.08572966806188397,
-                -0.05612324188528877,
-                0.02645674994617371,
-                -0.05612324188528877,
-                0.092598624811608,
-                -0.10246655193630476,
-                0.07937024983852113,
-                -0.029806212171661055,
-                -0.029806212171661055,
-                0.07937024983852113,
-                -0.10246655193630476,
-                0.092598624811608,
-                -0.05612324188528877,
-                0.08572966806188397,
-                -0.10246655193630476,
-                0.06614187486543427,
-                0.0,
-                -0.06028603244005229,
-                0.08430469899226617,
-                -0.06028603244005229,
-                0.0,
-                0.06614187486543427,
-                -0.10246655193630476,
-                0.08572966806188397,
-                -0.1074678263122828,
-                0.07937024983852113,
-                0.0,
-                -0.06614187486543427,
-                0.0778289332164142,
-                -0.03362594233395219,
-                -0.03362594233395219,
-                0.0778289332164142,
-                -0.06614187486543427,
-                0.0,
-                0.07937024983852113,
-                -0.1074678263122828,
-                0.11543896335436807,
-                -0.029806212171661055,
-                -0.06028603244005229,
-                0.0778289332164142,
-                -0.025439182640551644,
-                -0.04458756536551671,
-                0.07576606905360043,
-                -0.04458756536551671,
-                -0.025439182640551644,
-                0.0778289332164142,
-                -0.06028603244005229,
-                -0.029806212171661055,
-                0.11543896335436807,
-                -0.1074678263122828,
-                -0.029806212171661055,
-                0.08430469899226617,
-                -0.03362594233395219,
-                -0.04458756536551671,
-                0.0742824133104108,
-                -0.03507287480528919,
-                -0.03507287480528919,
-                0.0742824133104108,
-                -0.04458756536551671,
-                -0.03362594233395219,
-                0.08430469899226617,
-                -0.029806212171661055,
-                -0.1074678263122828,
-                0.08572966806188397,
-                0.07937024983852113,
-                -0.06028603244005229,
-                -0.03362594233395219,
-                0.07576606905360043,
-                -0.03507287480528919,
-                -0.03764999030801643,
-                0.07224011237680622,
-                -0.03764999030801643,
-                -0.03507287480528919,
-                0.07576606905360043,
-                -0.03362594233395219,
-                -0.06028603244005229,
-                0.07937024983852113,
-                0.08572966806188397,
-                -0.05612324188528877,
-                -0.10246655193630476,
-                0.0,
-                0.0778289332164142,
-                -0.04458756536551671,
-                -0.03507287480528919,
-                0.07224011237680622,
-                -0.0356148556967723,
-                -0.0356148556967723,
-                0.07224011237680622,
-                -0.03507287480528919,
-                -0.04458756536551671,
-                0.0778289332164142,
-                0.0,
-                -0.10246655193630476,
-                -0.05612324188528877,
-                0.02645674994617371,
-                0.092598624811608,
-                0.06614187486543427,
-                -0.06614187486543427,
-                -0.025439182640551644,
-                0.0742824133104108,
-                -0.03764999030801643,
-                -0.0356148556967723,
-                0.0712297113935446,
-                -0.0356148556967723,
-                -0.03764999030801643,
-                0.0742824133104108,
-                -0.025439182640551644,
-                -0.06614187486543427,
-                0.06614187486543427,
-                0.092598624811608,
-                0.02645674994617371,
-                -0.05612324188528877,
-                -0.10246655193630476,
-                0.0,
-                0.0778289332164142,
-                -0.04458756536551671,
-                -0.03507287480528919,
-                0.07224011237680622,
-                -0.0356148556967723,
-                -0.0356148556967723,
-                0.07224011237680622,
-                -0.03507287480528919,
-                -0.04458756536551671,
-                0.0778289332164142,
-                0.0,
-                -0.10246655193630476,
-                -0.05612324188528877,
-                0.08572966806188397,
-                0.07937024983852113,
-                -0.06028603244005229,
-                -0.03362594233395219,
-                0.07576606905360043,
-                -0.03507287480528919,
-                -0.03764999030801643,
-                0.07224011237680622,
-                -0.03764999030801643,
-                -0.03507287480528919,
-                0.07576606905360043,
-                -0.03362594233395219,
-                -0.06028603244005229,
-                0.07937024983852113,
-                0.08572966806188397,
-                -0.1074678263122828,
-                -0.029806212171661055,
-                0.08430469899226617,
-                -0.03362594233395219,
-                -0.04458756536551671,
-                0.0742824133104108,
-                -0.03507287480528919,
-                -0.03507287480528919,
-                0.0742824133104108,
-                -0.04458756536551671,
-                -0.03362594233395219,
-                0.08430469899226617,
-                -0.029806212171661055,
-                -0.1074678263122828,
-                0.11543896335436807,
-                -0.029806212171661055,
-                -0.06028603244005229,
-                0.0778289332164142,
-                -0.025439182640551644,
-                -0.04458756536551671,
-                0.07576606905360043,
-                -0.04458756536551671,
-                -0.025439182640551644,
-                0.0778289332164142,
-                -0.06028603244005229,
-                -0.029806212171661055,
-                0.11543896335436807,
-                -0.1074678263122828,
-                0.07937024983852113,
-                0.0,
-                -0.06614187486543427,
-                0.0778289332164142,
-                -0.03362594233395219,
-                -0.03362594233395219,
-                0.0778289332164142,
-                -0.06614187486543427,
-                0.0,
-                0.07937024983852113,
-                -0.1074678263122828,
-                0.08572966806188397,
-                -0.10246655193630476,
-                0.06614187486543427,
-                0.0,
-                -0.06028603244005229,
-                0.08430469899226617,
-                -0.06028603244005229,
-                0.0,
-                0.06614187486543427,
-                -0.10246655193630476,
-                0.08572966806188397,
-                -0.05612324188528877,
-                0.092598624811608,
-                -0.10246655193630476,
-                0.07937024983852113,
-                -0.029806212171661055,
-                -0.029806212171661055,
-                0.07937024983852113,
-                -0.10246655193630476,
-                0.092598624811608,
-                -0.05612324188528877,
-                0.02645674994617371,
-                -0.05612324188528877,
-                0.08572966806188397,
-                -0.1074678263122828,
-                0.11543896335436807,
-                -0.1074678263122828,
-                0.08572966806188397,
-                -0.05612324188528877,
-                0.02645674994617371};
-    }
-
-    case 9: {
-        return {0.019248154353244368,
-                -0.04304018157526291,
-                0.06924301541391162,
-                -0.09159989940671116,
-                0.10443995424508518,
-                -0.10443995424508518,
-                0.09159989940671116,
-                -0.06924301541391162,
-                0.04304018157526291,
-                -0.019248154353244368,
-                -0.04304018157526291,
-                0.07699261741297747,
-                -0.09394899606030287,
-                0.08480502800787701,
-                -0.050171331170259785,
-                0.0,
-                0.050171331170259785,
-                -0.08480502800787701,
-                0.09394899606030287,
-                -0.07699261741297747,
-                0.04304018157526291,
-                0.06924301541391162,
-                -0.09394899606030287,
-                0.07586037303925722,
-                -0.02480623136379577,
-                -0.033797067827589254,
-                0.0719888416593996,
-                -0.0719888416593996,
-                0.033797067827589254,
-                0.02480623136379577,
-                -0.07586037303925722,
-                0.09394899606030287,
-                -0.06924301541391162,
-                -0.09159989940671116,
-                0.08480502800787701,
-                -0.02480623136379577,
-                -0.04189304182764951,
-                0.07349565596342092,
-                -0.05441844920067935,
-                0.0,
-                0.05441844920067935,
-                -0.07349565596342092,
-                0.04189304182764951,
-                0.02480623136379577,
-                -0.08480502800787701,
-                0.09159989940671116,
-                0.10443995424508518,
-                -0.050171331170259785,
-                -0.033797067827589254,
-                0.07349565596342092,
-                -0.04812038588311092,
-                -0.013480366662971442,
-                0.06204657845062042,
-                -0.06204657845062042,
-                0.013480366662971442,
-                0.04812038588311092,
-                -0.07349565596342092,
-                0.033797067827589254,
-                0.050171331170259785,
-                -0.10443995424508518,
-                -0.10443995424508518,
-                0.0,
-                0.0719888416593996,
-                -0.05441844920067935,
-                -0.013480366662971442,
-                0.06340568492833439,
-                -0.05533826277992775,
-                0.0,
-                0.05533826277992775,
-                -0.06340568492833439,
-                0.013480366662971442,
-                0.05441844920067935,
-                -0.0719888416593996,
-                0.0,
-                0.10443995424508518,
-                0.09159989940671116,
-                0.050171331170259785,
-                -0.0719888416593996,
-                0.0,
-                0.06204657845062042,
-                -0.05533826277992775,
-                -0.003962855308020899,
-                0.05742722925916745,
-                -0.05742722925916745,
-                0.003962855308020899,
-                0.05533826277992775,
-                -0.06204657845062042,
-                0.0,
-                0.0719888416593996,
-                -0.050171331170259785,
-                -0.09159989940671116,
-                -0.06924301541391162,
-                -0.08480502800787701,
-                0.033797067827589254,
-                0.05441844920067935,
-                -0.06204657845062042,
-                0.0,
-                0.05742722925916745,
-                -0.055479974312292596,
-                0.0,
-                0.055479974312292596,
-                -0.05742722925916745,
-                0.0,
-                0.06204657845062042,
-                -0.05441844920067935,
-                -0.033797067827589254,
-                0.08480502800787701,
-                0.06924301541391162,
-                0.04304018157526291,
-                0.09394899606030287,
-                0.02480623136379577,
-                -0.07349565596342092,
-                0.013480366662971442,
-                0.05533826277992775,
-                -0.05742722925916745,
-                0.0,
-                0.055479974312292596,
-                -0.055479974312292596,
-                0.0,
-                0.05742722925916745,
-                -0.05533826277992775,
-                -0.013480366662971442,
-                0.07349565596342092,
-                -0.02480623136379577,
-                -0.09394899606030287,
-                -0.04304018157526291,
-                -0.019248154353244368,
-                -0.07699261741297747,
-                -0.07586037303925722,
-                0.04189304182764951,
-                0.04812038588311092,
-                -0.06340568492833439,
-                0.003962855308020899,
-                0.055479974312292596,
-                -0.055479974312292596,
-                0.0,
-                0.055479974312292596,
-                -0.055479974312292596,
-                -0.003962855308020899,
-                0.06340568492833439,
-                -0.04812038588311092,
-                -0.04189304182764951,
-                0.07586037303925722,
-                0.07699261741297747,
-                0.019248154353244368,
-                0.04304018157526291,
-                0.09394899606030287,
-                0.02480623136379577,
-                -0.07349565596342092,
-                0.013480366662971442,
-                0.05533826277992775,
-                -0.05742722925916745,
-                0.0,
-                0.055479974312292596,
-                -0.055479974312292596,
-                0.0,
-                0.05742722925916745,
-                -0.05533826277992775,
-                -0.013480366662971442,
-                0.07349565596342092,
-                -0.02480623136379577,
-                -0.09394899606030287,
-                -0.04304018157526291,
-                -0.06924301541391162,
-                -0.08480502800787701,
-                0.033797067827589254,
-                0.05441844920067935,
-                -0.06204657845062042,
-                0.0,
-                0.05742722925916745,
-                -0.055479974312292596,
-                0.0,
-                0.055479974312292596,
-                -0.05742722925916745,
-                0.0,
-                0.06204657845062042,
-                -0.05441844920067935,
-                -0.033797067827589254,
-                0.08480502800787701,
-                0.06924301541391162,
-                0.09159989940671116,
-                0.050171331170259785,
-                -0.0719888416593996,
-                0.0,
-                0.06204657845062042,
-                -0.05533826277992775,
-                -0.003962855308020899,
-                0.05742722925916745,
-                -0.05742722925916745,
-                0.003962855308020899,
-                0.05533826277992775,
-                -0.06204657845062042,
-                0.0,
-                0.0719888416593996,
-                -0.050171331170259785,
-                -0.09159989940671116,
-                -0.10443995424508518,
-                0.0,
-                0.0719888416593996,
-                -0.05441844920067935,
-                -0.013480366662971442,
-                0.06340568492833439,
-                -0.05533826277992775,
-                0.0,
-                0.05533826277992775,
-                -0.06340568492833439,
-                0.013480366662971442,
-                0.05441844920067935,
-                -0.0719888416593996,
-                0.0,
-                0.10443995424508518,
-                0.10443995424508518,
-                -0.050171331170259785,
-                -0.033797067827589254,
-                0.07349565596342092,
-                -0.04812038588311092,
-                -0.013480366662971442,
-                0.06204657845062042,
-                -0.06204657845062042,
-                0.013480366662971442,
-                0.04812038588311092,
-                -0.07349565596342092,
-                0.033797067827589254,
-                0.050171331170259785,
-                -0.10443995424508518,
-                -0.09159989940671116,
-                0.08480502800787701,
-                -0.02480623136379577,
-                -0.04189304182764951,
-                0.07349565596342092,
-                -0.05441844920067935,
-                0.0,
-                0.05441844920067935,
-                -0.07349565596342092,
-                0.04189304182764951,
-                0.02480623136379577,
-                -0.08480502800787701,
-                0.09159989940671116,
-                0.06924301541391162,
-                -0.09394899606030287,
-                0.07586037303925722,
-                -0.02480623136379577,
-                -0.033797067827589254,
-                0.0719888416593996,
-                -0.0719888416593996,
-                0.033797067827589254,
-                0.02480623136379577,
-                -0.07586037303925722,
-                0.09394899606030287,
-                -0.06924301541391162,
-                -0.04304018157526291,
-                0.07699261741297747,
-                -0.09394899606030287,
-                0.08480502800787701,
-                -0.050171331170259785,
-                0.0,
-                0.050171331170259785,
-                -0.08480502800787701,
-                0.09394899606030287,
-                -0.07699261741297747,
-                0.04304018157526291,
-                0.019248154353244368,
-                -0.04304018157526291,
-                0.06924301541391162,
-                -0.09159989940671116,
-                0.10443995424508518,
-                -0.10443995424508518,
-                0.09159989940671116,
-                -0.06924301541391162,
-                0.04304018157526291,
-                -0.019248154353244368};
-    }
-
-    case 10: {
-        return {0.014084201054019469,  -0.03303037929414734,  0.0556844122765083,    -0.07727756515750789,
-                0.09277095161439448,   -0.09839845347550115,  0.09277095161439448,   -0.07727756515750789,
-                0.0556844122765083,    -0.03303037929414734,  0.014084201054019469,  -0.03303037929414734,
-                0.0633789047430876,    -0.08386964498510284,  0.0847211352923922,    -0.06286446595773457,
-                0.02319273790359862,   0.02319273790359862,   -0.06286446595773457,  0.0847211352923922,
-                -0.08386964498510284,  0.0633789047430876,    -0.03303037929414734,  0.0556844122765083,
-                -0.08386964498510284,  0.07931629014632016,   -0.042848251158211725, -0.009333263758353732,
-                0.053967901150019815,  -0.07138574104403102,  0.053967901150019815,  -0.009333263758353732,
-                -0.042848251158211725, 0.07931629014632016,   -0.08386964498510284,  0.0556844122765083,
-                -0.07727756515750789,  0.0847211352923922,    -0.042848251158211725, -0.018161206622288262,
-                0.06128213087410669,   -0.0635353430452619,   0.02649508509090357,   0.02649508509090357,
-                -0.0635353430452619,   0.06128213087410669,   -0.018161206622288262, -0.042848251158211725,
-                0.0847211352923922,    -0.07727756515750789,  0.09277095161439448,   -0.06286446595773457,
-                -0.009333263758353732, 0.06128213087410669,   -0.059781546888732794, 0.01360074441523714,
-                0.04032776579596398,   -0.0636141744884848,   0.04032776579596398,   0.01360074441523714,
-                -0.059781546888732794, 0.06128213087410669,   -0.009333263758353732, -0.06286446595773457,
-                0.09277095161439448,   -0.09839845347550115,  0.02319273790359862,   0.053967901150019815,
-                -0.0635353430452619,   0.01360074441523714,   0.0438332604010931,    -0.06128239750305534,
-                0.027896660938361115,  0.027896660938361115,  -0.06128239750305534,  0.0438332604010931,
-                0.01360074441523714,   -0.0635353430452619,   0.053967901150019815,  0.02319273790359862,
-                -0.09839845347550115,  0.09277095161439448,   0.02319273790359862,   -0.07138574104403102,
-                0.02649508509090357,   0.04032776579596398,   -0.06128239750305534,  0.02391697918925597,
-                0.033388822149103825,  -0.0599760188805225,   0.033388822149103825,  0.02391697918925597,
-                -0.06128239750305534,  0.04032776579596398,   0.02649508509090357,   -0.07138574104403102,
-                0.02319273790359862,   0.09277095161439448,   -0.07727756515750789,  -0.06286446595773457,
-                0.053967901150019815,  0.02649508509090357,   -0.0636141744884848,   0.027896660938361115,
-                0.033388822149103825,  -0.05929099809041168,  0.028565958372935296,  0.028565958372935296,
-                -0.05929099809041168,  0.033388822149103825,  0.027896660938361115,  -0.0636141744884848,
-                0.02649508509090357,   0.053967901150019815,  -0.06286446595773457,  -0.07727756515750789,
-                0.0556844122765083,    0.0847211352923922,    -0.009333263758353732, -0.0635353430452619,
-                0.04032776579596398,   0.027896660938361115,  -0.0599760188805225,   0.028565958372935296,
-                0.029912575613180666,  -0.05822024152320929,  0.029912575613180666,  0.028565958372935296,
-                -0.0599760188805225,   0.027896660938361115,  0.04032776579596398,   -0.0635353430452619,
-                -0.009333263758353732, 0.0847211352923922,    0.0556844122765083,    -0.03303037929414734,
-                -0.08386964498510284,  -0.042848251158211725, 0.06128213087410669,   0.01360074441523714,
-                -0.06128239750305534,  0.033388822149103825,  0.028565958372935296,  -0.05822024152320929,
-                0.02884426934128136,   0.02884426934128136,   -0.05822024152320929,  0.028565958372935296,
-                0.033388822149103825,  -0.06128239750305534,  0.01360074441523714,   0.06128213087410669,
-                -0.042848251158211725, -0.08386964498510284,  -0.03303037929414734,  0.014084201054019469,
-                0.0633789047430876,    0.07931629014632016,   -0.018161206622288262, -0.059781546888732794,
-                0.0438332604010931,    0.02391697918925597,   -0.05929099809041168,  0.029912575613180666,
-                0.02884426934128136,   -0.05768853868256272,  0.02884426934128136,   0.029912575613180666,
-                -0.05929099809041168,  0.02391697918925597,   0.0438332604010931,    -0.059781546888732794,
-                -0.018161206622288262, 0.07931629014632016,   0.0633789047430876,    0.014084201054019469,
-                -0.03303037929414734,  -0.08386964498510284,  -0.042848251158211725, 0.06128213087410669,
-                0.01360074441523714,   -0.06128239750305534,  0.033388822149103825,  0.028565958372935296,
-                -0.05822024152320929,  0.02884426934128136,   0.02884426934128136,   -0.05822024152320929,
-                0.028565958372935296,  0.033388822149103825,  -0.06128239750305534,  0.01360074441523714,
-                0.06128213087410669,   -0.042848251158211725, -0.08386964498510284,  -0.03303037929414734,
-                0.0556844122765083,    0.0847211352923922,    -0.009333263758353732, -0.0635353430452619,
-                0.04032776579596398,   0.027896660938361115,  -0.0599760188805225,   0.028565958372935296,
-                0.029912575613180666,  -0.05822024152320929,  0.029912575613180666,  0.028565958372935296,
-                -0.0599760188805225,   0.027896660938361115,  0.04032776579596398,   -0.0635353430452619,
-                -0.009333263758353732, 0.0847211352923922,    0.0556844122765083,    -0.07727756515750789,
-                -0.06286446595773457,  0.053967901150019815,  0.02649508509090357,   -0.0636141744884848,
-                0.027896660938361115,  0.033388822149103825,  -0.05929099809041168,  0.028565958372935296,
-                0.028565958372935296,  -0.05929099809041168,  0.033388822149103825,  0.027896660938361115,
-                -0.0636141744884848,   0.02649508509090357,   0.053967901150019815,  -0.06286446595773457,
-                -0.07727756515750789,  0.09277095161439448,   0.02319273790359862,   -0.07138574104403102,
-                0.02649508509090357,   0.04032776579596398,   -0.06128239750305534,  0.02391697918925597,
-                0.033388822149103825,  -0.0599760188805225,   0.033388822149103825,  0.02391697918925597,
-                -0.06128239750305534,  0.04032776579596398,   0.02649508509090357,   -0.07138574104403102,
-                0.02319273790359862,   0.09277095161439448,   -0.09839845347550115,  0.02319273790359862,
-                0.053967901150019815,  -0.0635353430452619,   0.01360074441523714,   0.0438332604010931,
-                -0.06128239750305534,  0.027896660938361115,  0.027896660938361115,  -0.06128239750305534,
-                0.0438332604010931,    0.01360074441523714,   -0.0635353430452619,   0.053967901150019815,
-                0.02319273790359862,   -0.09839845347550115,  0.09277095161439448,   -0.06286446595773457,
-                -0.009333263758353732, 0.06128213087410669,   -0.059781546888732794, 0.01360074441523714,
-                0.04032776579596398,   -0.0636141744884848,   0.04032776579596398,   0.01360074441523714,
-                -0.059781546888732794, 0.06128213087410669,   -0.009333263758353732, -0.06286446595773457,
-                0.09277095161439448,   -0.07727756515750789,  0.0847211352923922,    -0.042848251158211725,
-                -0.018161206622288262, 0.06128213087410669,   -0.0635353430452619,   0.02649508509090357,
-                0.02649508509090357,   -0.0635353430452619,   0.06128213087410669,   -0.018161206622288262,
-                -0.042848251158211725, 0.0847211352923922,    -0.07727756515750789,  0.0556844122765083,
-                -0.08386964498510284,  0.07931629014632016,   -0.042848251158211725, -0.009333263758353732,
-                0.053967901150019815,  -0.07138574104403102,  0.053967901150019815,  -0.009333263758353732,
-                -0.042848251158211725, 0.07931629014632016,   -0.08386964498510284,  0.0556844122765083,
-                -0.03303037929414734,  0.0633789047430876,    -0.08386964498510284,  0.0847211352923922,
-                -0.06286446595773457,  0.02319273790359862,   0.02319273790359862,   -0.06286446595773457,
-                0.0847211352923922,    -0.08386964498510284,  0.0633789047430876,    -0.03303037929414734,
-                0.014084201054019469,  -0.03303037929414734,  0.0556844122765083,    -0.07727756515750789,
-                0.09277095161439448,   -0.09839845347550115,  0.09277095161439448,   -0.07727756515750789,
-                0.0556844122765083,    -0.03303037929414734,  0.014084201054019469};
-    }
-
-    case 11: {
-        return {0.010353958773579627,
-                -0.02536191581308319,
-                0.04461995085008539,
-                -0.0646604518165043,
-                0.08124984886574907,
-                -0.09063800094387633,
-                0.09063800094387633,
-                -0.08124984886574907,
-                0.0646604518165043,
-                -0.04461995085008539,
-                0.02536191581308319,
-                -0.010353958773579627,
-                -0.02536191581308319,
-                0.05176979386789814,
-                -0.07342242818523824,
-                0.08105616599464421,
-                -0.06957821371079587,
-                0.0401710004156613,
-                0.0,
-                -0.0401710004156613,
-                0.06957821371079587,
-                -0.08105616599464421,
-                0.07342242818523824,
-                -0.05176979386789814,
-                0.02536191581308319,
-                0.04461995085008539,
-                -0.07342242818523824,
-                0.07839425928567433,
-                -0.054847866708622926,
-                0.011477428690188944,
-                0.033950691917997156,
-                -0.06260198269876582,
-                0.06260198269876582,
-                -0.033950691917997156,
-                -0.011477428690188944,
-                0.054847866708622926,
-                -0.07839425928567433,
-                0.07342242818523824,
-                -0.04461995085008539,
-                -0.0646604518165043,
-                0.08105616599464421,
-                -0.054847866708622926,
-                0.0029582739353084648,
-                0.04483491976341964,
-                -0.06325614866282217,
-                0.04426628648202024,
-                0.0,
-                -0.04426628648202024,
-                0.06325614866282217,
-                -0.04483491976341964,
-                -0.0029582739353084648,
-                0.054847866708622926,
-                -0.08105616599464421,
-                0.0646604518165043,
-                0.08124984886574907,
-                -0.06957821371079587,
-                0.011477428690188944,
-                0.04483491976341964,
-                -0.0620459033273907,
-                0.03394087248412062,
-                0.016284840993022895,
-                -0.05373723365131875,
-                0.05373723365131875,
-                -0.016284840993022895,
-                -0.03394087248412062,
-                0.0620459033273907,
-                -0.04483491976341964,
-                -0.011477428690188944,
-                0.06957821371079587,
-                -0.08124984886574907,
-                -0.09063800094387633,
-                0.0401710004156613,
-                0.033950691917997156,
-                -0.06325614866282217,
-                0.03394087248412062,
-                0.020941465489420448,
-                -0.05570476104834648,
-                0.04541625165775246,
-                0.0,
-                -0.04541625165775246,
-                0.05570476104834648,
-                -0.020941465489420448,
-                -0.03394087248412062,
-                0.06325614866282217,
-                -0.033950691917997156,
-                -0.0401710004156613,
-                0.09063800094387633,
-                0.09063800094387633,
-                0.0,
-                -0.06260198269876582,
-                0.04426628648202024,
-                0.016284840993022895,
-                -0.05570476104834648,
-                0.04242787617745035,
-                0.007099242818288509,
-                -0.04926084132261772,
-                0.04926084132261772,
-                -0.007099242818288509,
-                -0.04242787617745035,
-                0.05570476104834648,
-                -0.016284840993022895,
-                -0.04426628648202024,
-                0.06260198269876582,
-                0.0,
-                -0.09063800094387633,
-                -0.08124984886574907,
-                -0.0401710004156613,
-                0.06260198269876582,
-                0.0,
-                -0.05373723365131875,
-                0.04541625165775246,
-                0.007099242818288509,
-                -0.05013495827206978,
-                0.04572346768555488,
-                0.0,
-                -0.04572346768555488,
-                0.05013495827206978,
-                -0.007099242818288509,
-                -0.04541625165775246,
-                0.05373723365131875,
-                0.0,
-                -0.06260198269876582,
-                0.0401710004156613,
-                0.08124984886574907,
-                0.0646604518165043,
-                0.06957821371079587,
-                -0.033950691917997156,
-                -0.04426628648202024,
-                0.05373723365131875,
-                0.0,
-                -0.04926084132261772,
-                0.04572346768555488,
-                0.0021797807944378164,
-                -0.04685261222228255,
-                0.04685261222228255,
-                -0.0021797807944378164,
-                -0.04572346768555488,
-                0.04926084132261772,
-                0.0,
-                -0.05373723365131875,
-                0.04426628648202024,
-                0.033950691917997156,
-                -0.06957821371079587,
-                -0.0646604518165043,
-                -0.04461995085008539,
-                -0.08105616599464421,
-                -0.011477428690188944,
-                0.06325614866282217,
-                -0.016284840993022895,
-                -0.04541625165775246,
-                0.04926084132261772,
-                0.0,
-                -0.04685261222228255,
-                0.04577539668319414,
-                0.0,
-                -0.04577539668319414,
-                0.04685261222228255,
-                0.0,
-                -0.04926084132261772,
-                0.04541625165775246,
-                0.016284840993022895,
-                -0.06325614866282217,
-                0.011477428690188944,
-                0.08105616599464421,
-                0.04461995085008539,
-                0.02536191581308319,
-                0.07342242818523824,
-                0.054847866708622926,
-                -0.04483491976341964,
-                -0.03394087248412062,
-                0.05570476104834648,
-                -0.007099242818288509,
-                -0.04572346768555488,
-                0.04685261222228255,
-                0.0,
-                -0.04577539668319414,
-                0.04577539668319414,
-                0.0,
-                -0.04685261222228255,
-                0.04572346768555488,
-                0.007099242818288509,
-                -0.05570476104834648,
-                0.03394087248412062,
-                0.04483491976341964,
-                -0.054847866708622926,
-                -0.07342242818523824,
-                -0.02536191581308319,
-                -0.010353958773579627,
-                -0.05176979386789814,
-                -0.07839425928567433,
-                -0.0029582739353084648,
-                0.0620459033273907,
-                -0.020941465489420448,
-                -0.04242787617745035,
-                0.05013495827206978,
-                -0.0021797807944378164,
-                -0.04577539668319414,
-                0.04577539668319414,
-                0.0,
-                -0.04577539668319414,
-                0.04577539668319414,
-                0.0021797807944378164,
-                -0.05013495827206978,
-                0.04242787617745035,
-                0.020941465489420448,
-                -0.0620459033273907,
-                0.0029582739353084648,
-                0.07839425928567433,
-                0.05176979386789814,
-                0.010353958773579627,
-                0.02536191581308319,
-                0.07342242818523824,
-                0.054847866708622926,
-                -0.04483491976341964,
-                -0.03394087248412062,
-                0.05570476104834648,
-                -0.007099242818288509,
-                -0.04572346768555488,
-                0.04685261222228255,
-                0.0,
-                -0.04577539668319414,
-                0.04577539668319414,
-                0.0,
-                -0.04685261222228255,
-                0.04572346768555488,
-                0.007099242818288509,
-                -0.05570476104834648,
-                0.03394087248412062,
-                0.04483491976341964,
-                -0.054847866708622926,
-                -0.07342242818523824,
-                -0.02536191581308319,
-                -0.04461995085008539,
-                -0.08105616599464421,
-                -0.011477428690188944,
-                0.06325614866282217,
-                -0.016284840993022895,
-                -0.04541625165775246,
-                0.04926084132261772,
-                0.0,
-                -0.04685261222228255,
-                0.04577539668319414,
-                0.0,
-                -0.04577539668319414,
-                0.04685261222228255,
-                0.0,
-                -0.04926084132261772,
-                0.04541625165775246,
-                0.016284840993022895,
-                -0.06325614866282217,
-                0.011477428690188944,
-                0.08105616599464421,
-                0.04461995085008539,
-                0.0646604518165043,
-                0.06957821371079587,
-                -0.033950691917997156,
-                -0.04426628648202024,
-                0.05373723365131875,
-                0.0,
-                -0.04926084132261772,
-                0.04572346768555488,
-                0.0021797807944378164,
-                -0.04685261222228255,
-                0.04685261222228255,
-                -0.0021797807944378164,
-                -0.04572346768555488,
-                0.04926084132261772,
-                0.0,
-                -0.05373723365131875,
-                0.04426628648202024,
-                0.033950691917997156,
-                -0.06957821371079587,
-                -0.0646604518165043,
-                -0.08124984886574907,
-                -0.0401710004156613,
-                0.06260198269876582,
-                0.0,
-                -0.05373723365131875,
-                0.04541625165775246,
-                0.007099242818288509,
-                -0.05013495827206978,
-                0.04572346768555488,
-                0.0,
-                -0.04572346768555488,
-                0.05013495827206978,
-                -0.007099242818288509,
-                -0.04541625165775246,
-                0.05373723365131875,
-                0.0,
-                -0.06260198269876582,
-                0.0401710004156613,
-                0.08124984886574907,
-                0.09063800094387633,
-                0.0,
-                -0.06260198269876582,
-                0.04426628648202024,
-                0.016284840993022895,
-                -0.05570476104834648,
-                0.04242787617745035,
-                0.007099242818288509,
-                -0.04926084132261772,
-                0.04926084132261772,
-                -0.007099242818288509,
-                -0.04242787617745035,
-                0.05570476104834648,
-                -0.016284840993022895,
-                -0.04426628648202024,
-                0.06260198269876582,
-                0.0,
-                -0.09063800094387633,
-                -0.09063800094387633,
-                0.0401710004156613,
-                0.033950691917997156,
-                -0.06325614866282217,
-                0.03394087248412062,
-                0.020941465489420448,
-                -0.05570476104834648,
-                0.04541625165775246,
-                0.0,
-                -0.04541625165775246,
-                0.05570476104834648,
-                -0.020941465489420448,
-                -0.03394087248412062,
-                0.06325614866282217,
-                -0.033950691917997156,
-                -0.0401710004156613,
-                0.09063800094387633,
-                0.08124984886574907,
-                -0.06957821371079587,
-                0.011477428690188944,
-                0.04483491976341964,
-                -0.0620459033273907,
-                0.03394087248412062,
-                0.016284840993022895,
-                -0.05373723365131875,
-                0.05373723365131875,
-                -0.016284840993022895,
-                -0.03394087248412062,
-                0.0620459033273907,
-                -0.04483491976341964,
-                -0.011477428690188944,
-                0.06957821371079587,
-                -0.08124984886574907,
-                -0.0646604518165043,
-                0.08105616599464421,
-                -0.054847866708622926,
-                0.0029582739353084648,
-                0.04483491976341964,
-                -0.06325614866282217,
-                0.04426628648202024,
-                0.0,
-                -0.04426628648202024,
-                0.06325614866282217,
-                -0.04483491976341964,
-                -0.0029582739353084648,
-                0.054847866708622926,
-                -0.08105616599464421,
-                0.0646604518165043,
-                0.04461995085008539,
-                -0.07342242818523824,
-                0.07839425928567433,
-                -0.054847866708622926,
-                0.011477428690188944,
-                0.033950691917997156,
-                -0.06260198269876582,
-                0.06260198269876582,
-                -0.033950691917997156,
-                -0.011477428690188944,
-                0.054847866708622926,
-                -0.07839425928567433,
-                0.07342242818523824,
-                -0.04461995085008539,
-                -0.02536191581308319,
-                0.05176979386789814,
-                -0.07342242818523824,
-                0.08105616599464421,
-                -0.06957821371079587,
-                0.0401710004156613,
-                0.0,
-                -0.0401710004156613,
-                0.06957821371079587,
-                -0.08105616599464421,
-                0.07342242818523824,
-                -0.05176979386789814,
-                0.02536191581308319,
-                0.010353958773579627,
-                -0.02536191581308319,
-                0.04461995085008539,
-                -0.0646604518165043,
-                0.08124984886574907,
-                -0.09063800094387633,
-                0.09063800094387633,
-                -0.08124984886574907,
-                0.0646604518165043,
-                -0.04461995085008539,
-                0.02536191581308319,
-                -0.010353958773579627};
-    }
-
-    case 12: {
-        return {0.007641326409130185,   -0.019481636234943346,  0.0356456775720244,    -0.05373788086563255,
-                0.07035940192950862,    -0.08205245760021009,   0.08626297667839215,   -0.08205245760021009,
-                0.07035940192950862,    -0.05373788086563255,   0.0356456775720244,    -0.019481636234943346,
-                0.007641326409130185,   -0.019481636234943346,  0.042027295250216014,  -0.06332346173655777,
-                0.07523303321188557,    -0.07181026388945431,   0.0517033900004071,    -0.01882412477623535,
-                -0.01882412477623535,   0.0517033900004071,     -0.07181026388945431,  0.07523303321188557,
-                -0.06332346173655777,   0.042027295250216014,   -0.019481636234943346, 0.0356456775720244,
-                -0.06332346173655777,   0.07458599038477072,    -0.06180400475030353,  0.02800960520681357,
-                0.0143994702606103,     -0.04902681079973495,   0.06230905222287632,   -0.04902681079973495,
-                0.0143994702606103,     0.02800960520681357,    -0.06180400475030353,  0.07458599038477072,
-                -0.06332346173655777,   0.0356456775720244,     -0.05373788086563255,  0.07523303321188557,
-                -0.06180400475030353,   0.020432242354848102,   0.02693894213312211,   -0.056185458863912296,
-                0.0534927873541926,     -0.02170319453598171,   -0.02170319453598171,  0.0534927873541926,
-                -0.056185458863912296,  0.02693894213312211,    0.020432242354848102,  -0.06180400475030353,
-                0.07523303321188557,    -0.05373788086563255,   0.07035940192950862,   -0.07181026388945431,
-                0.02800960520681357,    0.02693894213312211,    -0.057143832276973554, 0.046682675344689284,
-                -0.006028665148883808,  -0.03709886503034876,   0.055231071662635446,  -0.03709886503034876,
-                -0.006028665148883808,  0.046682675344689284,   -0.057143832276973554, 0.02693894213312211,
-                0.02800960520681357,    -0.07181026388945431,   0.07035940192950862,   -0.08205245760021009,
-                0.0517033900004071,     0.0143994702606103,     -0.056185458863912296, 0.046682675344689284,
-                -0.0011628105405198108, -0.04236208106508133,   0.05220380452638073,   -0.023012946526098102,
-                -0.023012946526098102,  0.05220380452638073,    -0.04236208106508133,  -0.0011628105405198108,
-                0.046682675344689284,   -0.056185458863912296,  0.0143994702606103,    0.0517033900004071,
-                -0.08205245760021009,   0.08626297667839215,    -0.01882412477623535,  -0.04902681079973495,
-                0.0534927873541926,     -0.006028665148883808,  -0.04236208106508133,  0.0507177740267325,
-                -0.016139152732150042,  -0.03062128569169099,   0.05172863807767612,   -0.03062128569169099,
-                -0.016139152732150042,  0.0507177740267325,     -0.04236208106508133,  -0.006028665148883808,
-                0.0534927873541926,     -0.04902681079973495,   -0.01882412477623535,  0.08626297667839215,
-                -0.08205245760021009,   -0.01882412477623535,   0.06230905222287632,   -0.02170319453598171,
-                -0.03709886503034876,   0.05220380452638073,    -0.016139152732150042, -0.032759782671637074,
-                0.05062047373912593,    -0.023705039958792577,  -0.023705039958792577, 0.05062047373912593,
-                -0.032759782671637074,  -0.016139152732150042,  0.05220380452638073,   -0.03709886503034876,
-                -0.02170319453598171,   0.06230905222287632,    -0.01882412477623535,  -0.08205245760021009,
-                0.07035940192950862,    0.0517033900004071,     -0.04902681079973495,  -0.02170319453598171,
-                0.055231071662635446,   -0.023012946526098102,  -0.03062128569169099,  0.05062047373912593,
-                -0.02145516591304974,   -0.02686301318080366,   0.0497905430180781,    -0.02686301318080366,
-                -0.02145516591304974,   0.05062047373912593,    -0.03062128569169099,  -0.023012946526098102,
-                0.055231071662635446,   -0.02170319453598171,   -0.04902681079973495,  0.0517033900004071,
-                0.07035940192950862,    -0.05373788086563255,   -0.07181026388945431,  0.0143994702606103,
-                0.0534927873541926,     -0.03709886503034876,   -0.023012946526098102, 0.05172863807767612,
-                -0.023705039958792577,  -0.02686301318080366,   0.04941507650389451,   -0.02407341777315654,
-                -0.02407341777315654,   0.04941507650389451,    -0.02686301318080366,  -0.023705039958792577,
-                0.05172863807767612,    -0.023012946526098102,  -0.03709886503034876,  0.0534927873541926,
-                0.0143994702606103,     -0.07181026388945431,   -0.05373788086563255,  0.0356456775720244,
-                0.07523303321188557,    0.02800960520681357,    -0.056185458863912296, -0.006028665148883808,
-                0.05220380452638073,    -0.03062128569169099,   -0.023705039958792577, 0.0497905430180781,
-                -0.02407341777315654,   -0.0248649111070552,    0.04878456976415475,   -0.0248649111070552,
-                -0.02407341777315654,   0.0497905430180781,     -0.023705039958792577, -0.03062128569169099,
-                0.05220380452638073,    -0.006028665148883808,  -0.056185458863912296, 0.02800960520681357,
-                0.07523303321188557,    0.0356456775720244,     -0.019481636234943346, -0.06332346173655777,
-                -0.06180400475030353,   0.02693894213312211,    0.046682675344689284,  -0.04236208106508133,
-                -0.016139152732150042,  0.05062047373912593,    -0.02686301318080366,  -0.02407341777315654,
-                0.04878456976415475,    -0.024235419686623422,  -0.024235419686623422, 0.04878456976415475,
-                -0.02407341777315654,   -0.02686301318080366,   0.05062047373912593,   -0.016139152732150042,
-                -0.04236208106508133,   0.046682675344689284,   0.02693894213312211,   -0.06180400475030353,
-                -0.06332346173655777,   -0.019481636234943346,  0.007641326409130185,  0.042027295250216014,
-                0.07458599038477072,    0.020432242354848102,   -0.057143832276973554, -0.0011628105405198108,
-                0.0507177740267325,     -0.032759782671637074,  -0.02145516591304974,  0.04941507650389451,
-                -0.0248649111070552,    -0.024235419686623422,  0.048470839373246845,  -0.024235419686623422,
-                -0.0248649111070552,    0.04941507650389451,    -0.02145516591304974,  -0.032759782671637074,
-                0.0507177740267325,     -0.0011628105405198108, -0.057143832276973554, 0.020432242354848102,
-                0.07458599038477072,    0.042027295250216014,   0.007641326409130185,  -0.019481636234943346,
-                -0.06332346173655777,   -0.06180400475030353,   0.02693894213312211,   0.046682675344689284,
-                -0.04236208106508133,   -0.016139152732150042,  0.05062047373912593,   -0.02686301318080366,
-                -0.02407341777315654,   0.04878456976415475,    -0.024235419686623422, -0.024235419686623422,
-                0.04878456976415475,    -0.02407341777315654,   -0.02686301318080366,  0.05062047373912593,
-                -0.016139152732150042,  -0.04236208106508133,   0.046682675344689284,  0.02693894213312211,
-                -0.06180400475030353,   -0.06332346173655777,   -0.019481636234943346, 0.0356456775720244,
-                0.07523303321188557,    0.02800960520681357,    -0.056185458863912296, -0.006028665148883808,
-                0.05220380452638073,    -0.03062128569169099,   -0.023705039958792577, 0.0497905430180781,
-                -0.02407341777315654,   -0.0248649111070552,    0.04878456976415475,   -0.0248649111070552,
-                -0.02407341777315654,   0.0497905430180781,     -0.023705039958792577, -0.03062128569169099,
-                0.05220380452638073,    -0.006028665148883808,  -0.056185458863912296, 0.02800960520681357,
-                0.07523303321188557,    0.0356456775720244,     -0.05373788086563255,  -0.07181026388945431,
-                0.0143994702606103,     0.0534927873541926,     -0.03709886503034876,  -0.023012946526098102,
-                0.05172863807767612,    -0.023705039958792577,  -0.02686301318080366,  0.04941507650389451,
-                -0.02407341777315654,   -0.02407341777315654,   0.04941507650389451,   -0.02686301318080366,
-                -0.023705039958792577,  0.05172863807767612,    -0.023012946526098102, -0.03709886503034876,
-                0.0534927873541926,     0.0143994702606103,     -0.07181026388945431,  -0.05373788086563255,
-                0.07035940192950862,    0.0517033900004071,     -0.04902681079973495,  -0.02170319453598171,
-                0.055231071662635446,   -0.023012946526098102,  -0.03062128569169099,  0.05062047373912593,
-                -0.02145516591304974,   -0.02686301318080366,   0.0497905430180781,    -0.02686301318080366,
-                -0.02145516591304974,   0.05062047373912593,    -0.03062128569169099,  -0.023012946526098102,
-                0.055231071662635446,   -0.02170319453598171,   -0.04902681079973495,  0.0517033900004071,
-                0.07035940192950862,    -0.08205245760021009,   -0.01882412477623535,  0.06230905222287632,
-                -0.02170319453598171,   -0.03709886503034876,   0.05220380452638073,   -0.016139152732150042,
-                -0.032759782671637074,  0.05062047373912593,    -0.023705039958792577, -0.023705039958792577,
-                0.05062047373912593,    -0.032759782671637074,  -0.016139152732150042, 0.05220380452638073,
-                -0.03709886503034876,   -0.02170319453598171,   0.06230905222287632,   -0.01882412477623535,
-                -0.08205245760021009,   0.08626297667839215,    -0.01882412477623535,  -0.04902681079973495,
-                0.0534927873541926,     -0.006028665148883808,  -0.04236208106508133,  0.0507177740267325,
-                -0.016139152732150042,  -0.03062128569169099,   0.05172863807767612,   -0.03062128569169099,
-                -0.016139152732150042,  0.0507177740267325,     -0.04236208106508133,  -0.006028665148883808,
-                0.0534927873541926,     -0.04902681079973495,   -0.01882412477623535,  0.08626297667839215,
-                -0.08205245760021009,   0.0517033900004071,     0.0143994702606103,    -0.056185458863912296,
-                0.046682675344689284,   -0.0011628105405198108, -0.04236208106508133,  0.05220380452638073,
-                -0.023012946526098102,  -0.023012946526098102,  0.05220380452638073,   -0.04236208106508133,
-                -0.0011628105405198108, 0.046682675344689284,   -0.056185458863912296, 0.0143994702606103,
-                0.0517033900004071,     -0.08205245760021009,   0.07035940192950862,   -0.07181026388945431,
-                0.02800960520681357,    0.02693894213312211,    -0.057143832276973554, 0.046682675344689284,
-                -0.006028665148883808,  -0.03709886503034876,   0.055231071662635446,  -0.03709886503034876,
-                -0.006028665148883808,  0.046682675344689284,   -0.057143832276973554, 0.02693894213312211,
-                0.02800960520681357,    -0.07181026388945431,   0.07035940192950862,   -0.05373788086563255,
-                0.07523303321188557,    -0.06180400475030353,   0.020432242354848102,  0.02693894213312211,
-                -0.056185458863912296,  0.0534927873541926,     -0.02170319453598171,  -0.02170319453598171,
-                0.0534927873541926,     -0.056185458863912296,  0.02693894213312211,   0.020432242354848102,
-                -0.06180400475030353,   0.07523303321188557,    -0.05373788086563255,  0.0356456775720244,
-                -0.06332346173655777,   0.07458599038477072,    -0.06180400475030353,  0.02800960520681357,
-                0.0143994702606103,     -0.04902681079973495,   0.06230905222287632,   -0.04902681079973495,
-                0.0143994702606103,     0.02800960520681357,    -0.06180400475030353,  0.07458599038477072,
-                -0.06332346173655777,   0.0356456775720244,     -0.019481636234943346, 0.042027295250216014,
-                -0.06332346173655777,   0.07523303321188557,    -0.07181026388945431,  0.0517033900004071,
-                -0.01882412477623535,   -0.01882412477623535,   0.0517033900004071,    -0.07181026388945431,
-                0.07523303321188557,    -0.06332346173655777,   0.042027295250216014,  -0.019481636234943346,
-                0.007641326409130185,   -0.019481636234943346,  0.0356456775720244,    -0.05373788086563255,
-                0.07035940192950862,    -0.08205245760021009,   0.08626297667839215,   -0.08205245760021009,
-                0.07035940192950862,    -0.05373788086563255,   0.0356456775720244,    -0.019481636234943346,
-                0.007641326409130185};
-    }
-
-    case 13: {
-        return {0.0056579139037989746,
-                -0.014969433128866713,
-                0.028402502381279792,
-                -0.044406514929192405,
-                0.060363892585845014,
-                -0.07325519054242073,
-                0.08045905431571458,
-                -0.08045905431571458,
-                0.07325519054242073,
-                -0.060363892585845014,
-                0.044406514929192405,
-                -0.028402502381279792,
-                0.014969433128866713,
-                -0.0056579139037989746,
-                -0.014969433128866713,
-                0.03394748342279385,
-                -0.053973058710758276,
-                0.0682711191247949,
-                -0.07082078000048107,
-                0.058694521265462804,
-                -0.033276665697944297,
-                0.0,
-                0.033276665697944297,
-                -0.058694521265462804,
-                0.07082078000048107,
-                -0.0682711191247949,
-                0.053973058710758276,
-                -0.03394748342279385,
-                0.014969433128866713,
-                0.028402502381279792,
-                -0.053973058710758276,
-                0.0690265496263475,
-                -0.06476767045290993,
-                0.04026410941057507,
-                -0.003183157342390924,
-                -0.033276665697944297,
-                0.05568251201161527,
-                -0.05568251201161527,
-                0.033276665697944297,
-                0.003183157342390924,
-                -0.04026410941057507,
-                0.06476767045290993,
-                -0.0690265496263475,
-                0.053973058710758276,
-                -0.028402502381279792,
-                -0.044406514929192405,
-                0.0682711191247949,
-                -0.06476767045290993,
-                0.03394748342279385,
-                0.009549472027172773,
-                -0.04479099409424417,
-                0.05534353782142295,
-                -0.03712167467441018,
-                0.0,
-                0.03712167467441018,
-                -0.05534353782142295,
-                0.04479099409424417,
-                -0.009549472027172773,
-                -0.03394748342279385,
-                0.06476767045290993,
-                -0.0682711191247949,
-                0.044406514929192405,
-                0.060363892585845014,
-                -0.07082078000048107,
-                0.04026410941057507,
-                0.009549472027172773,
-                -0.047378879037899245,
-                0.05220977169843273,
-                -0.02412901029070312,
-                -0.017809857162989974,
-                0.047715056307592374,
-                -0.047715056307592374,
-                0.017809857162989974,
-                0.02412901029070312,
-                -0.05220977169843273,
-                0.047378879037899245,
-                -0.009549472027172773,
-                -0.04026410941057507,
-                0.07082078000048107,
-                -0.060363892585845014,
-                -0.07325519054242073,
-                0.058694521265462804,
-                -0.003183157342390924,
-                -0.04479099409424417,
-                0.05220977169843273,
-                -0.01977809903762772,
-                -0.025012049701003517,
-                0.0497490802029598,
-                -0.03838197538275717,
-                0.0,
-                0.03838197538275717,
-                -0.0497490802029598,
-                0.025012049701003517,
-                0.01977809903762772,
-                -0.05220977169843273,
-                0.04479099409424417,
-                0.003183157342390924,
-                -0.058694521265462804,
-                0.07325519054242073,
-                0.08045905431571458,
-                -0.033276665697944297,
-                -0.033276665697944297,
-                0.05534353782142295,
-                -0.02412901029070312,
-                -0.025012049701003517,
-                0.04983884160476836,
-                -0.033096508611813985,
-                -0.00927872315042477,
-                0.043521069295790846,
-                -0.043521069295790846,
-                0.00927872315042477,
-                0.033096508611813985,
-                -0.04983884160476836,
-                0.025012049701003517,
-                0.02412901029070312,
-                -0.05534353782142295,
-                0.033276665697944297,
-                0.033276665697944297,
-                -0.08045905431571458,
-                -0.08045905431571458,
-                0.0,
-                0.05568251201161527,
-                -0.03712167467441018,
-                -0.017809857162989974,
-                0.0497490802029598,
-                -0.033096508611813985,
-                -0.012103015828996068,
-                0.04500685555710979,
-                -0.03881568378618365,
-                0.0,
-                0.03881568378618365,
-                -0.04500685555710979,
-                0.012103015828996068,
-                0.033096508611813985,
-                -0.0497490802029598,
-                0.017809857162989974,
-                0.03712167467441018,
-                -0.05568251201161527,
-                0.0,
-                0.08045905431571458,
-                0.07325519054242073,
-                0.033276665697944297,
-                -0.05568251201161527,
-                0.0,
-                0.047715056307592374,
-                -0.03838197538275717,
-                -0.00927872315042477,
-                0.04500685555710979,
-                -0.037145434759723706,
-                -0.004223978507798474,
-                0.04104969247305556,
-                -0.04104969247305556,
-                0.004223978507798474,
-                0.037145434759723706,
-                -0.04500685555710979,
-                0.00927872315042477,
-                0.03838197538275717,
-                -0.047715056307592374,
-                0.0,
-                0.05568251201161527,
-                -0.033276665697944297,
-                -0.07325519054242073,
-                -0.060363892585845014,
-                -0.058694521265462804,
-                0.033276665697944297,
-                0.03712167467441018,
-                -0.047715056307592374,
-                0.0,
-                0.043521069295790846,
-                -0.03881568378618365,
-                -0.004223978507798474,
-                0.0416225666314255,
-                -0.0389431576392977,
-                0.0,
-                0.0389431576392977,
-                -0.0416225666314255,
-                0.004223978507798474,
-                0.03881568378618365,
-                -0.043521069295790846,
-                0.0,
-                0.047715056307592374,
-                -0.03712167467441018,
-                -0.033276665697944297,
-                0.058694521265462804,
-                0.060363892585845014,
-                0.044406514929192405,
-                0.07082078000048107,
-                0.003183157342390924,
-                -0.05534353782142295,
-                0.017809857162989974,
-                0.03838197538275717,
-                -0.043521069295790846,
-                0.0,
-                0.04104969247305556,
-                -0.0389431576392977,
-                -0.0013283797861093245,
-                0.03962443072426683,
-                -0.03962443072426683,
-                0.0013283797861093245,
-                0.0389431576392977,
-                -0.04104969247305556,
-                0.0,
-                0.043521069295790846,
-                -0.03838197538275717,
-                -0.017809857162989974,
-                0.05534353782142295,
-                -0.003183157342390924,
-                -0.07082078000048107,
-                -0.044406514929192405,
-                -0.028402502381279792,
-                -0.0682711191247949,
-                -0.04026410941057507,
-                0.04479099409424417,
-                0.02412901029070312,
-                -0.0497490802029598,
-                0.00927872315042477,
-                0.03881568378618365,
-                -0.04104969247305556,
-                0.0,
-                0.03962443072426683,
-                -0.03896580705920685,
-                0.0,
-                0.03896580705920685,
-                -0.03962443072426683,
-                0.0,
-                0.04104969247305556,
-                -0.03881568378618365,
-                -0.00927872315042477,
-                0.0497490802029598,
-                -0.02412901029070312,
-                -0.04479099409424417,
-                0.04026410941057507,
-                0.0682711191247949,
-                0.028402502381279792,
-                0.014969433128866713,
-                0.053973058710758276,
-                0.06476767045290993,
-                -0.009549472027172773,
-                -0.05220977169843273,
-                0.025012049701003517,
-                0.033096508611813985,
-                -0.04500685555710979,
-                0.004223978507798474,
-                0.0389431576392977,
-                -0.03962443072426683,
-                0.0,
-                0.03896580705920685,
-                -0.03896580705920685,
-                0.0,
-                0.03962443072426683,
-                -0.0389431576392977,
-                -0.004223978507798474,
-                0.04500685555710979,
-                -0.033096508611813985,
-                -0.025012049701003517,
-                0.05220977169843273,
-                0.009549472027172773,
-                -0.06476767045290993,
-                -0.053973058710758276,
-                -0.014969433128866713,
-                -0.0056579139037989746,
-                -0.03394748342279385,
-                -0.0690265496263475,
-                -0.03394748342279385,
-                0.047378879037899245,
-                0.01977809903762772,
-                -0.04983884160476836,
-                0.012103015828996068,
-                0.037145434759723706,
-                -0.0416225666314255,
-                0.0013283797861093245,
-                0.03896580705920685,
-                -0.03896580705920685,
-                0.0,
-                0.03896580705920685,
-                -0.03896580705920685,
-                -0.0013283797861093245,
-                0.0416225666314255,
-                -0.037145434759723706,
-                -0.012103015828996068,
-                0.04983884160476836,
-                -0.01977809903762772,
-                -0.047378879037899245,
-                0.03394748342279385,
-                0.0690265496263475,
-                0.03394748342279385,
-                0.0056579139037989746,
-                0.014969433128866713,
-                0.053973058710758276,
-                0.06476767045290993,
-                -0.009549472027172773,
-                -0.05220977169843273,
-                0.025012049701003517,
-                0.033096508611813985,
-                -0.04500685555710979,
-                0.004223978507798474,
-                0.0389431576392977,
-                -0.03962443072426683,
-                0.0,
-                0.03896580705920685,
-                -0.03896580705920685,
-                0.0,
-                0.03962443072426683,
-                -0.0389431576392977,
-                -0.004223978507798474,
-                0.04500685555710979,
-                -0.033096508611813985,
-                -0.025012049701003517,
-                0.05220977169843273,
-                0.009549472027172773,
-                -0.06476767045290993,
-                -0.053973058710758276,
-                -0.014969433128866713,
-                -0.028402502381279792,
-                -0.0682711191247949,
-                -0.04026410941057507,
-                0.04479099409424417,
-                0.02412901029070312,
-                -0.0497490802029598,
-                0.00927872315042477,
-                0.03881568378618365,
-                -0.04104969247305556,
-                0.0,
-                0.03962443072426683,
-                -0.03896580705920685,
-                0.0,
-                0.03896580705920685,
-                -0.03962443072426683,
-                0.0,
-                0.04104969247305556,
-                -0.03881568378618365,
-                -0.00927872315042477,
-                0.0497490802029598,
-                -0.02412901029070312,
-                -0.04479099409424417,
-                0.04026410941057507,
-                0.0682711191247949,
-                0.028402502381279792,
-                0.044406514929192405,
-                0.07082078000048107,
-                0.003183157342390924,
-                -0.05534353782142295,
-                0.017809857162989974,
-                0.03838197538275717,
-                -0.043521069295790846,
-                0.0,
-                0.04104969247305556,
-                -0.0389431576392977,
-                -0.0013283797861093245,
-                0.03962443072426683,
-                -0.03962443072426683,
-                0.0013283797861093245,
-                0.0389431576392977,
-                -0.04104969247305556,
-                0.0,
-                0.043521069295790846,
-                -0.03838197538275717,
-                -0.017809857162989974,
-                0.05534353782142295,
-                -0.003183157342390924,
-                -0.07082078000048107,
-                -0.044406514929192405,
-                -0.060363892585845014,
-                -0.058694521265462804,
-                0.033276665697944297,
-                0.03712167467441018,
-                -0.047715056307592374,
-                0.0,
-                0.043521069295790846,
-                -0.03881568378618365,
-                -0.004223978507798474,
-                0.0416225666314255,
-                -0.0389431576392977,
-                0.0,
-                0.0389431576392977,
-                -0.0416225666314255,
-                0.004223978507798474,
-                0.03881568378618365,
-                -0.043521069295790846,
-                0.0,
-                0.047715056307592374,
-                -0.03712167467441018,
-                -0.033276665697944297,
-                0.058694521265462804,
-                0.060363892585845014,
-                0.07325519054242073,
-                0.033276665697944297,
-                -0.05568251201161527,
-                0.0,
-                0.047715056307592374,
-                -0.03838197538275717,
-                -0.00927872315042477,
-                0.04500685555710979,
-                -0.037145434759723706,
-                -0.004223978507798474,
-                0.04104969247305556,
-                -0.04104969247305556,
-                0.004223978507798474,
-                0.037145434759723706,
-                -0.04500685555710979,
-                0.00927872315042477,
-                0.03838197538275717,
-                -0.047715056307592374,
-                0.0,
-                0.05568251201161527,
-                -0.033276665697944297,
-                -0.07325519054242073,
-                -0.08045905431571458,
-                0.0,
-                0.05568251201161527,
-                -0.03712167467441018,
-                -0.017809857162989974,
-                0.0497490802029598,
-                -0.033096508611813985,
-                -0.012103015828996068,
-                0.04500685555710979,
-                -0.03881568378618365,
-                0.0,
-                0.03881568378618365,
-                -0.04500685555710979,
-                0.012103015828996068,
-                0.033096508611813985,
-                -0.0497490802029598,
-                0.017809857162989974,
-                0.03712167467441018,
-                -0.05568251201161527,
-                0.0,
-                0.08045905431571458,
-                0.08045905431571458,
-                -0.033276665697944297,
-                -0.033276665697944297,
-                0.05534353782142295,
-                -0.02412901029070312,
-                -0.025012049701003517,
-                0.04983884160476836,
-                -0.033096508611813985,
-                -0.00927872315042477,
-                0.043521069295790846,
-                -0.043521069295790846,
-                0.00927872315042477,
-                0.033096508611813985,
-                -0.04983884160476836,
-                0.025012049701003517,
-                0.02412901029070312,
-                -0.05534353782142295,
-                0.033276665697944297,
-                0.033276665697944297,
-                -0.08045905431571458,
-                -0.07325519054242073,
-                0.058694521265462804,
-                -0.003183157342390924,
-                -0.04479099409424417,
-                0.05220977169843273,
-                -0.01977809903762772,
-                -0.025012049701003517,
-                0.0497490802029598,
-                -0.03838197538275717,
-                0.0,
-                0.03838197538275717,
-                -0.0497490802029598,
-                0.025012049701003517,
-                0.01977809903762772,
-                -0.05220977169843273,
-                0.04479099409424417,
-                0.003183157342390924,
-                -0.058694521265462804,
-                0.07325519054242073,
-                0.060363892585845014,
-                -0.07082078000048107,
-                0.04026410941057507,
-                0.009549472027172773,
-                -0.047378879037899245,
-                0.05220977169843273,
-                -0.02412901029070312,
-                -0.017809857162989974,
-                0.047715056307592374,
-                -0.047715056307592374,
-                0.017809857162989974,
-                0.02412901029070312,
-                -0.05220977169843273,
-                0.047378879037899245,
-                -0.009549472027172773,
-                -0.04026410941057507,
-                0.07082078000048107,
-                -0.060363892585845014,
-                -0.044406514929192405,
-                0.0682711191247949,
-                -0.06476767045290993,
-                0.03394748342279385,
-                0.009549472027172773,
-                -0.04479099409424417,
-                0.05534353782142295,
-                -0.03712167467441018,
-                0.0,
-                0.03712167467441018,
-                -0.05534353782142295,
-                0.04479099409424417,
-                -0.009549472027172773,
-                -0.03394748342279385,
-                0.06476767045290993,
-                -0.0682711191247949,
-                0.044406514929192405,
-                0.028402502381279792,
-                -0.053973058710758276,
-                0.0690265496263475,
-                -0.06476767045290993,
-                0.04026410941057507,
-                -0.003183157342390924,
-                -0.033276665697944297,
-                0.05568251201161527,
-                -0.05568251201161527,
-                0.033276665697944297,
-                0.003183157342390924,
-                -0.04026410941057507,
-                0.06476767045290993,
-                -0.0690265496263475,
-                0.053973058710758276,
-                -0.028402502381279792,
-                -0.014969433128866713,
-                0.03394748342279385,
-                -0.053973058710758276,
-                0.0682711191247949,
-                -0.07082078000048107,
-                0.058694521265462804,
-                -0.033276665697944297,
-                0.0,
-                0.033276665697944297,
-                -0.058694521265462804,
-                0.07082078000048107,
-                -0.0682711191247949,
-                0.053973058710758276,
-                -0.03394748342279385,
-                0.014969433128866713,
-                0.0056579139037989746,
-                -0.014969433128866713,
-                0.028402502381279792,
-                -0.044406514929192405,
-                0.060363892585845014,
-                -0.07325519054242073,
-                0.08045905431571458,
-                -0.08045905431571458,
-                0.07325519054242073,
-                -0.060363892585845014,
-                0.044406514929192405,
-                -0.028402502381279792,
-                0.014969433128866713,
-                -0.0056579139037989746};
-    }
-
-    case 14: {
-        return {0.004201102820261771,  -0.011505193905279716, 0.022580249176036234,  -0.036517119480472225,
-                0.05138414181436862,   -0.06465696054949265,  0.07384345263283243,   -0.07712697085199444,
-                0.07384345263283243,   -0.06465696054949265,  0.05138414181436862,   -0.036517119480472225,
-                0.022580249176036234,  -0.011505193905279716, 0.004201102820261771,  -0.011505193905279716,
-                0.02730716833170151,   -0.045565775679734646, 0.0608797637178923,    -0.06763065171923319,
-                0.06205224648430349,   -0.04368637572353741,  0.01574347699949146,   0.01574347699949146,
-                -0.04368637572353741,  0.06205224648430349,   -0.06763065171923319,  0.0608797637178923,
-                -0.045565775679734646, 0.02730716833170151,   -0.011505193905279716, 0.022580249176036234,
-                -0.045565775679734646, 0.06254975310167525,   -0.06472020085013493,  0.04860349405838362,
-                -0.018003182691287905, -0.017251717088799627, 0.04503152242785616,   -0.055537766549493016,
-                0.04503152242785616,   -0.017251717088799627, -0.018003182691287905, 0.04860349405838362,
-                -0.06472020085013493,  0.06254975310167525,   -0.045565775679734646, 0.022580249176036234,
-                -0.036517119480472225, 0.0608797637178923,    -0.06472020085013493,  0.043644790410497285,
-                -0.00608797637178923,  -0.031170196317796602, 0.05143285630404252,   -0.046041613646013335,
-                0.018279716826986547,  0.018279716826986547,  -0.046041613646013335, 0.05143285630404252,
-                -0.031170196317796602, -0.00608797637178923,  0.043644790410497285,  -0.06472020085013493,
-                0.0608797637178923,    -0.036517119480472225, 0.05138414181436862,   -0.06763065171923319,
-                0.04860349405838362,   -0.00608797637178923,  -0.03482247448794757,  0.051623340412812635,
-                -0.03684412264500153,  0.0009597969344576107, 0.03447990108345921,   -0.04904962732150642,
-                0.03447990108345921,   0.0009597969344576107, -0.03684412264500153,  0.051623340412812635,
-                -0.03482247448794757,  -0.00608797637178923,  0.04860349405838362,   -0.06763065171923319,
-                0.05138414181436862,   -0.06465696054949265,  0.06205224648430349,   -0.018003182691287905,
-                -0.031170196317796602, 0.051623340412812635,  -0.03346878580141877,  -0.006852323642503038,
-                0.0404871854822612,    -0.04542588191860526,  0.01949034554679506,   0.01949034554679506,
-                -0.04542588191860526,  0.0404871854822612,    -0.006852323642503038, -0.03346878580141877,
-                0.051623340412812635,  -0.031170196317796602, -0.018003182691287905, 0.06205224648430349,
-                -0.06465696054949265,  0.07384345263283243,   -0.04368637572353741,  -0.017251717088799627,
-                0.05143285630404252,   -0.03684412264500153,  -0.006852323642503038, 0.041921729398708765,
-                -0.042467434126869,    0.01055877043639689,   0.028534007200298542,  -0.04573901331970019,
-                0.028534007200298542,  0.01055877043639689,   -0.042467434126869,    0.041921729398708765,
-                -0.006852323642503038, -0.03684412264500153,  0.05143285630404252,   -0.017251717088799627,
-                -0.04368637572353741,  0.07384345263283243,   -0.07712697085199444,  0.01574347699949146,
-                0.04503152242785616,   -0.046041613646013335, 0.0009597969344576107, 0.0404871854822612,
-                -0.042467434126869,    0.007669549544816055,  0.032084655560415364,  -0.04425643468117621,
-                0.020169009076232928,  0.020169009076232928,  -0.04425643468117621,  0.032084655560415364,
-                0.007669549544816055,  -0.042467434126869,    0.0404871854822612,    0.0009597969344576107,
-                -0.046041613646013335, 0.04503152242785616,   0.01574347699949146,   -0.07712697085199444,
-                0.07384345263283243,   0.01574347699949146,   -0.055537766549493016, 0.018279716826986547,
-                0.03447990108345921,   -0.04542588191860526,  0.01055877043639689,   0.032084655560415364,
-                -0.04354128497869374,  0.016033240837219163,  0.024839890888786006,  -0.04379177123430918,
-                0.024839890888786006,  0.016033240837219163,  -0.04354128497869374,  0.032084655560415364,
-                0.01055877043639689,   -0.04542588191860526,  0.03447990108345921,   0.018279716826986547,
-                -0.055537766549493016, 0.01574347699949146,   0.07384345263283243,   -0.06465696054949265,
-                -0.04368637572353741,  0.04503152242785616,   0.018279716826986547,  -0.04904962732150642,
-                0.01949034554679506,   0.028534007200298542,  -0.04425643468117621,  0.016033240837219163,
-                0.026223405575170212,  -0.043174669426322046, 0.020567603172426233,  0.020567603172426233,
-                -0.043174669426322046, 0.026223405575170212,  0.016033240837219163,  -0.04425643468117621,
-                0.028534007200298542,  0.01949034554679506,   -0.04904962732150642,  0.018279716826986547,
-                0.04503152242785616,   -0.04368637572353741,  -0.06465696054949265,  0.05138414181436862,
-                0.06205224648430349,   -0.017251717088799627, -0.046041613646013335, 0.03447990108345921,
-                0.01949034554679506,   -0.04573901331970019,  0.020169009076232928,  0.024839890888786006,
-                -0.043174669426322046, 0.019166770548092835,  0.022554422426408278,  -0.042623780180777296,
-                0.022554422426408278,  0.019166770548092835,  -0.043174669426322046, 0.024839890888786006,
-                0.020169009076232928,  -0.04573901331970019,  0.01949034554679506,   0.03447990108345921,
-                -0.046041613646013335, -0.017251717088799627, 0.06205224648430349,   0.05138414181436862,
-                -0.036517119480472225, -0.06763065171923319,  -0.018003182691287905, 0.05143285630404252,
-                0.0009597969344576107, -0.04542588191860526,  0.028534007200298542,  0.020169009076232928,
-                -0.04379177123430918,  0.020567603172426233,  0.022554422426408278,  -0.04239460715577204,
-                0.020793274907466103,  0.020793274907466103,  -0.04239460715577204,  0.022554422426408278,
-                0.020567603172426233,  -0.04379177123430918,  0.020169009076232928,  0.028534007200298542,
-                -0.04542588191860526,  0.0009597969344576107, 0.05143285630404252,   -0.018003182691287905,
-                -0.06763065171923319,  -0.036517119480472225, 0.022580249176036234,  0.0608797637178923,
-                0.04860349405838362,   -0.031170196317796602, -0.03684412264500153,  0.0404871854822612,
-                0.01055877043639689,   -0.04425643468117621,  0.024839890888786006,  0.020567603172426233,
-                -0.042623780180777296, 0.020793274907466103,  0.021297764732283585,  -0.04199228186005081,
-                0.021297764732283585,  0.020793274907466103,  -0.042623780180777296, 0.020567603172426233,
-                0.024839890888786006,  -0.04425643468117621,  0.01055877043639689,   0.0404871854822612,
-                -0.03684412264500153,  -0.031170196317796602, 0.04860349405838362,   0.0608797637178923,
-                0.022580249176036234,  -0.011505193905279716, -0.045565775679734646, -0.06472020085013493,
-                -0.00608797637178923,  0.051623340412812635,  -0.006852323642503038, -0.042467434126869,
-                0.032084655560415364,  0.016033240837219163,  -0.043174669426322046, 0.022554422426408278,
-                0.020793274907466103,  -0.04199228186005081,  0.02089592011469333,   0.02089592011469333,
-                -0.04199228186005081,  0.020793274907466103,  0.022554422426408278,  -0.043174669426322046,
-                0.016033240837219163,  0.032084655560415364,  -0.042467434126869,    -0.006852323642503038,
-                0.051623340412812635,  -0.00608797637178923,  -0.06472020085013493,  -0.045565775679734646,
-                -0.011505193905279716, 0.004201102820261771,  0.02730716833170151,   0.06254975310167525,
-                0.043644790410497285,  -0.03482247448794757,  -0.03346878580141877,  0.041921729398708765,
-                0.007669549544816055,  -0.04354128497869374,  0.026223405575170212,  0.019166770548092835,
-                -0.04239460715577204,  0.021297764732283585,  0.02089592011469333,   -0.04179184022938666,
-                0.02089592011469333,   0.021297764732283585,  -0.04239460715577204,  0.019166770548092835,
-                0.026223405575170212,  -0.04354128497869374,  0.007669549544816055,  0.041921729398708765,
-                -0.03346878580141877,  -0.03482247448794757,  0.043644790410497285,  0.06254975310167525,
-                0.02730716833170151,   0.004201102820261771,  -0.011505193905279716, -0.045565775679734646,
-                -0.06472020085013493,  -0.00608797637178923,  0.051623340412812635,  -0.006852323642503038,
-                -0.042467434126869,    0.032084655560415364,  0.016033240837219163,  -0.043174669426322046,
-                0.022554422426408278,  0.020793274907466103,  -0.04199228186005081,  0.02089592011469333,
-                0.02089592011469333,   -0.04199228186005081,  0.020793274907466103,  0.022554422426408278,
-                -0.043174669426322046, 0.016033240837219163,  0.032084655560415364,  -0.042467434126869,
-                -0.006852323642503038, 0.051623340412812635,  -0.00608797637178923,  -0.06472020085013493,
-                -0.045565775679734646, -0.011505193905279716, 0.022580249176036234,  0.0608797637178923,
-                0.04860349405838362,   -0.031170196317796602, -0.03684412264500153,  0.0404871854822612,
-                0.01055877043639689,   -0.04425643468117621,  0.024839890888786006,  0.020567603172426233,
-                -0.042623780180777296, 0.020793274907466103,  0.021297764732283585,  -0.04199228186005081,
-                0.021297764732283585,  0.020793274907466103,  -0.042623780180777296, 0.020567603172426233,
-                0.024839890888786006,  -0.04425643468117621,  0.01055877043639689,   0.0404871854822612,
-                -0.03684412264500153,  -0.031170196317796602, 0.04860349405838362,   0.0608797637178923,
-                0.022580249176036234,  -0.036517119480472225, -0.06763065171923319,  -0.018003182691287905,
-                0.05143285630404252,   0.0009597969344576107, -0.04542588191860526,  0.028534007200298542,
-                0.020169009076232928,  -0.04379177123430918,  0.020567603172426233,  0.022554422426408278,
-                -0.04239460715577204,  0.020793274907466103,  0.020793274907466103,  -0.04239460715577204,
-                0.022554422426408278,  0.020567603172426233,  -0.04379177123430918,  0.020169009076232928,
-                0.028534007200298542,  -0.04542588191860526,  0.0009597969344576107, 0.05143285630404252,
-                -0.018003182691287905, -0.06763065171923319,  -0.036517119480472225, 0.05138414181436862,
-                0.06205224648430349,   -0.017251717088799627, -0.046041613646013335, 0.03447990108345921,
-                0.01949034554679506,   -0.04573901331970019,  0.020169009076232928,  0.024839890888786006,
-                -0.043174669426322046, 0.019166770548092835,  0.022554422426408278,  -0.042623780180777296,
-                0.022554422426408278,  0.019166770548092835,  -0.043174669426322046, 0.024839890888786006,
-                0.020169009076232928,  -0.04573901331970019,  0.01949034554679506,   0.03447990108345921,
-                -0.046041613646013335, -0.017251717088799627, 0.06205224648430349,   0.05138414181436862,
-                -0.06465696054949265,  -0.04368637572353741,  0.04503152242785616,   0.018279716826986547,
-                -0.04904962732150642,  0.01949034554679506,   0.028534007200298542,  -0.04425643468117621,
-                0.016033240837219163,  0.026223405575170212,  -0.043174669426322046, 0.020567603172426233,
-                0.020567603172426233,  -0.043174669426322046, 0.026223405575170212,  0.016033240837219163,
-                -0.04425643468117621,  0.028534007200298542,  0.01949034554679506,   -0.04904962732150642,
-                0.018279716826986547,  0.04503152242785616,   -0.04368637572353741,  -0.06465696054949265,
-                0.07384345263283243,   0.01574347699949146,   -0.055537766549493016, 0.018279716826986547,
-                0.03447990108345921,   -0.04542588191860526,  0.01055877043639689,   0.032084655560415364,
-                -0.04354128497869374,  0.016033240837219163,  0.024839890888786006,  -0.04379177123430918,
-                0.024839890888786006,  0.016033240837219163,  -0.04354128497869374,  0.032084655560415364,
-                0.01055877043639689,   -0.04542588191860526,  0.03447990108345921,   0.018279716826986547,
-                -0.055537766549493016, 0.01574347699949146,   0.07384345263283243,   -0.07712697085199444,
-                0.01574347699949146,   0.04503152242785616,   -0.046041613646013335, 0.0009597969344576107,
-                0.0404871854822612,    -0.042467434126869,    0.007669549544816055,  0.032084655560415364,
-                -0.04425643468117621,  0.020169009076232928,  0.020169009076232928,  -0.04425643468117621,
-                0.032084655560415364,  0.007669549544816055,  -0.042467434126869,    0.0404871854822612,
-                0.0009597969344576107, -0.046041613646013335, 0.04503152242785616,   0.01574347699949146,
-                -0.07712697085199444,  0.07384345263283243,   -0.04368637572353741,  -0.017251717088799627,
-                0.05143285630404252,   -0.03684412264500153,  -0.006852323642503038, 0.041921729398708765,
-                -0.042467434126869,    0.01055877043639689,   0.028534007200298542,  -0.04573901331970019,
-                0.028534007200298542,  0.01055877043639689,   -0.042467434126869,    0.041921729398708765,
-                -0.006852323642503038, -0.03684412264500153,  0.05143285630404252,   -0.017251717088799627,
-                -0.04368637572353741,  0.07384345263283243,   -0.06465696054949265,  0.06205224648430349,
-                -0.018003182691287905, -0.031170196317796602, 0.051623340412812635,  -0.03346878580141877,
-                -0.006852323642503038, 0.0404871854822612,    -0.04542588191860526,  0.01949034554679506,
-                0.01949034554679506,   -0.04542588191860526,  0.0404871854822612,    -0.006852323642503038,
-                -0.03346878580141877,  0.051623340412812635,  -0.031170196317796602, -0.018003182691287905,
-                0.06205224648430349,   -0.06465696054949265,  0.05138414181436862,   -0.06763065171923319,
-                0.04860349405838362,   -0.00608797637178923,  -0.03482247448794757,  0.051623340412812635,
-                -0.03684412264500153,  0.0009597969344576107, 0.03447990108345921,   -0.04904962732150642,
-                0.03447990108345921,   0.0009597969344576107, -0.03684412264500153,  0.051623340412812635,
-                -0.03482247448794757,  -0.00608797637178923,  0.04860349405838362,   -0.06763065171923319,
-                0.05138414181436862,   -0.036517119480472225, 0.0608797637178923,    -0.06472020085013493,
-                0.043644790410497285,  -0.00608797637178923,  -0.031170196317796602, 0.05143285630404252,
-                -0.046041613646013335, 0.018279716826986547,  0.018279716826986547,  -0.046041613646013335,
-                0.05143285630404252,   -0.031170196317796602, -0.00608797637178923,  0.043644790410497285,
-                -0.06472020085013493,  0.0608797637178923,    -0.036517119480472225, 0.022580249176036234,
-                -0.045565775679734646, 0.06254975310167525,   -0.06472020085013493,  0.04860349405838362,
-                -0.018003182691287905, -0.017251717088799627, 0.04503152242785616,   -0.055537766549493016,
-                0.04503152242785616,   -0.017251717088799627, -0.018003182691287905, 0.04860349405838362,
-                -0.06472020085013493,  0.06254975310167525,   -0.045565775679734646, 0.022580249176036234,
-                -0.011505193905279716, 0.02730716833170151,   -0.045565775679734646, 0.0608797637178923,
-                -0.06763065171923319,  0.06205224648430349,   -0.04368637572353741,  0.01574347699949146,
-                0.01574347699949146,   -0.04368637572353741,  0.06205224648430349,   -0.06763065171923319,
-                0.0608797637178923,    -0.045565775679734646, 0.02730716833170151,   -0.011505193905279716,
-                0.004201102820261771,  -0.011505193905279716, 0.022580249176036234,  -0.036517119480472225,
-                0.05138414181436862,   -0.06465696054949265,  0.07384345263283243,   -0.07712697085199444,
-                0.07384345263283243,   -0.06465696054949265,  0.05138414181436862,   -0.036517119480472225,
-                0.022580249176036234,  -0.011505193905279716, 0.004201102820261771};
-    }
-
-    case 15: {
-        return {0.0031269823000042996,
-                -0.00884444155593339,
-                0.01791615859566177,
-                -0.029902891420361847,
-                0.04344789394034224,
-                -0.05652081218639529,
-                0.06687632686006072,
-                -0.07260229780692978,
-                0.07260229780692978,
-                -0.06687632686006072,
-                0.05652081218639529,
-                -0.04344789394034224,
-                0.029902891420361847,
-                -0.01791615859566177,
-                0.00884444155593339,
-                -0.0031269823000042996,
-                -0.00884444155593339,
-                0.021888876100030097,
-                -0.038165266333821155,
-                0.053534763307268154,
-                -0.06304083034203398,
-                0.06261507939047613,
-                -0.050553751276911356,
-                0.028260406093197646,
-                0.0,
-                -0.028260406093197646,
-                0.050553751276911356,
-                -0.06261507939047613,
-                0.06304083034203398,
-                -0.053534763307268154,
-                0.038165266333821155,
-                -0.021888876100030097,
-                0.00884444155593339,
-                0.01791615859566177,
-                -0.038165266333821155,
-                0.055746546520766306,
-                -0.06251547321318089,
-                0.05357167111124354,
-                -0.02976597472238238,
-                -0.002237680382813104,
-                0.03226452673976127,
-                -0.05033537552047327,
-                0.05033537552047327,
-                -0.03226452673976127,
-                0.002237680382813104,
-                0.02976597472238238,
-                -0.05357167111124354,
-                0.06251547321318089,
-                -0.055746546520766306,
-                0.038165266333821155,
-                -0.01791615859566177,
-                -0.029902891420361847,
-                0.053534763307268154,
-                -0.06251547321318089,
-                0.04992388982420658,
-                -0.019288675826891737,
-                -0.016964168332763287,
-                0.04346305529542573,
-                -0.04905064815727292,
-                0.031834886704915785,
-                0.0,
-                -0.031834886704915785,
-                0.04905064815727292,
-                -0.04346305529542573,
-                0.016964168332763287,
-                0.019288675826891737,
-                -0.04992388982420658,
-                0.06251547321318089,
-                -0.053534763307268154,
-                0.029902891420361847,
-                0.04344789394034224,
-                -0.06304083034203398,
-                0.05357167111124354,
-                -0.019288675826891737,
-                -0.02117002959428198,
-                0.04634536720004783,
-                -0.043983421039385705,
-                0.017060985511609412,
-                0.018587569265458983,
-                -0.04310464036632843,
-                0.04310464036632843,
-                -0.018587569265458983,
-                -0.017060985511609412,
-                0.043983421039385705,
-                -0.04634536720004783,
-                0.02117002959428198,
-                0.019288675826891737,
-                -0.05357167111124354,
-                0.06304083034203398,
-                -0.04344789394034224,
-                -0.05652081218639529,
-                0.06261507939047613,
-                -0.02976597472238238,
-                -0.016964168332763287,
-                0.04634536720004783,
-                -0.041800924309252876,
-                0.009729262813810318,
-                0.02711051235023537,
-                -0.04491349286240468,
-                0.03313480062523981,
-                0.0,
-                -0.03313480062523981,
-                0.04491349286240468,
-                -0.02711051235023537,
-                -0.009729262813810318,
-                0.041800924309252876,
-                -0.04634536720004783,
-                0.016964168332763287,
-                0.02976597472238238,
-                -0.06261507939047613,
-                0.05652081218639529,
-                0.06687632686006072,
-                -0.050553751276911356,
-                -0.002237680382813104,
-                0.04346305529542573,
-                -0.043983421039385705,
-                0.009729262813810318,
-                0.029494272130845153,
-                -0.04444568709275543,
-                0.026070690762106222,
-                0.010750348892621761,
-                -0.03920562481920355,
-                0.03920562481920355,
-                -0.010750348892621761,
-                -0.026070690762106222,
-                0.04444568709275543,
-                -0.029494272130845153,
-                -0.009729262813810318,
-                0.043983421039385705,
-                -0.04346305529542573,
-                0.002237680382813104,
-                0.050553751276911356,
-                -0.06687632686006072,
-                -0.07260229780692978,
-                0.028260406093197646,
-                0.03226452673976127,
-                -0.04905064815727292,
-                0.017060985511609412,
-                0.02711051235023537,
-                -0.04444568709275543,
-                0.023628484643940535,
-                0.015483693425092187,
-                -0.040990364954344646,
-                0.033653915268038584,
-                0.0,
-                -0.033653915268038584,
-                0.040990364954344646,
-                -0.015483693425092187,
-                -0.023628484643940535,
-                0.04444568709275543,
-                -0.02711051235023537,
-                -0.017060985511609412,
-                0.04905064815727292,
-                -0.03226452673976127,
-                -0.028260406093197646,
-                0.07260229780692978,
-                0.07260229780692978,
-                0.0,
-                -0.05033537552047327,
-                0.031834886704915785,
-                0.018587569265458983,
-                -0.04491349286240468,
-                0.026070690762106222,
-                0.015483693425092187,
-                -0.04131210868534416,
-                0.030556878922487145,
-                0.005838768515590004,
-                -0.03679917021387186,
-                0.03679917021387186,
-                -0.005838768515590004,
-                -0.030556878922487145,
-                0.04131210868534416,
-                -0.015483693425092187,
-                -0.026070690762106222,
-                0.04491349286240468,
-                -0.018587569265458983,
-                -0.031834886704915785,
-                0.05033537552047327,
-                0.0,
-                -0.07260229780692978,
-                -0.06687632686006072,
-                -0.028260406093197646,
-                0.05033537552047327,
-                0.0,
-                -0.04310464036632843,
-                0.03313480062523981,
-                0.010750348892621761,
-                -0.040990364954344646,
-                0.030556878922487145,
-                0.007670092216332385,
-                -0.03787065692170211,
-                0.0338503132728654,
-                0.0,
-                -0.0338503132728654,
-                0.03787065692170211,
-                -0.007670092216332385,
-                -0.030556878922487145,
-                0.040990364954344646,
-                -0.010750348892621761,
-                -0.03313480062523981,
-                0.04310464036632843,
-                0.0,
-                -0.05033537552047327,
-                0.028260406093197646,
-                0.06687632686006072,
-                0.05652081218639529,
-                0.050553751276911356,
-                -0.03226452673976127,
-                -0.031834886704915785,
-                0.04310464036632843,
-                0.0,
-                -0.03920562481920355,
-                0.033653915268038584,
-                0.005838768515590004,
-                -0.03787065692170211,
-                0.03281534298740144,
-                0.002725442798439903,
-                -0.035271218914294425,
-                0.035271218914294425,
-                -0.002725442798439903,
-                -0.03281534298740144,
-                0.03787065692170211,
-                -0.005838768515590004,
-                -0.033653915268038584,
-                0.03920562481920355,
-                0.0,
-                -0.04310464036632843,
-                0.031834886704915785,
-                0.03226452673976127,
-                -0.050553751276911356,
-                -0.05652081218639529,
-                -0.04344789394034224,
-                -0.06261507939047613,
-                0.002237680382813104,
-                0.04905064815727292,
-                -0.018587569265458983,
-                -0.03313480062523981,
-                0.03920562481920355,
-                0.0,
-                -0.03679917021387186,
-                0.0338503132728654,
-                0.002725442798439903,
-                -0.03566197515016398,
-                0.03391121343593522,
-                0.0,
-                -0.03391121343593522,
-                0.03566197515016398,
-                -0.002725442798439903,
-                -0.0338503132728654,
-                0.03679917021387186,
-                0.0,
-                -0.03920562481920355,
-                0.03313480062523981,
-                0.018587569265458983,
-                -0.04905064815727292,
-                -0.002237680382813104,
-                0.06261507939047613,
-                0.04344789394034224,
-                0.029902891420361847,
-                0.06304083034203398,
-                0.02976597472238238,
-                -0.04346305529542573,
-                -0.017060985511609412,
-                0.04491349286240468,
-                -0.010750348892621761,
-                -0.033653915268038584,
-                0.03679917021387186,
-                0.0,
-                -0.035271218914294425,
-                0.03391121343593522,
-                0.0008698042719552189,
-                -0.034354516086797314,
-                0.034354516086797314,
-                -0.0008698042719552189,
-                -0.03391121343593522,
-                0.035271218914294425,
-                0.0,
-                -0.03679917021387186,
-                0.033653915268038584,
-                0.010750348892621761,
-                -0.04491349286240468,
-                0.017060985511609412,
-                0.04346305529542573,
-                -0.02976597472238238,
-                -0.06304083034203398,
-                -0.029902891420361847,
-                -0.01791615859566177,
-                -0.053534763307268154,
-                -0.05357167111124354,
-                0.016964168332763287,
-                0.043983421039385705,
-                -0.02711051235023537,
-                -0.026070690762106222,
-                0.040990364954344646,
-                -0.005838768515590004,
-                -0.0338503132728654,
-                0.035271218914294425,
-                0.0,
-                -0.034354516086797314,
-                0.033922366606253536,
-                0.0,
-                -0.033922366606253536,
-                0.034354516086797314,
-                0.0,
-                -0.035271218914294425,
-                0.0338503132728654,
-                0.005838768515590004,
-                -0.040990364954344646,
-                0.026070690762106222,
-                0.02711051235023537,
-                -0.043983421039385705,
-                -0.016964168332763287,
-                0.05357167111124354,
-                0.053534763307268154,
-                0.01791615859566177,
-                0.00884444155593339,
-                0.038165266333821155,
-                0.06251547321318089,
-                0.019288675826891737,
-                -0.04634536720004783,
-                -0.009729262813810318,
-                0.04444568709275543,
-                -0.015483693425092187,
-                -0.030556878922487145,
-                0.03787065692170211,
-                -0.002725442798439903,
-                -0.03391121343593522,
-                0.034354516086797314,
-                0.0,
-                -0.033922366606253536,
-                0.033922366606253536,
-                0.0,
-                -0.034354516086797314,
-                0.03391121343593522,
-                0.002725442798439903,
-                -0.03787065692170211,
-                0.030556878922487145,
-                0.015483693425092187,
-                -0.04444568709275543,
-                0.009729262813810318,
-                0.04634536720004783,
-                -0.019288675826891737,
-                -0.06251547321318089,
-                -0.038165266333821155,
-                -0.00884444155593339,
-                -0.0031269823000042996,
-                -0.021888876100030097,
-                -0.055746546520766306,
-                -0.04992388982420658,
-                0.02117002959428198,
-                0.041800924309252876,
-                -0.029494272130845153,
-                -0.023628484643940535,
-                0.04131210868534416,
-                -0.007670092216332385,
-                -0.03281534298740144,
-                0.03566197515016398,
-                -0.0008698042719552189,
-                -0.033922366606253536,
-                0.033922366606253536,
-                0.0,
-                -0.033922366606253536,
-                0.033922366606253536,
-                0.0008698042719552189,
-                -0.03566197515016398,
-                0.03281534298740144,
-                0.007670092216332385,
-                -0.04131210868534416,
-                0.023628484643940535,
-                0.029494272130845153,
-                -0.041800924309252876,
-                -0.02117002959428198,
-                0.04992388982420658,
-                0.055746546520766306,
-                0.021888876100030097,
-                0.0031269823000042996,
-                0.00884444155593339,
-                0.038165266333821155,
-                0.06251547321318089,
-                0.019288675826891737,
-                -0.04634536720004783,
-                -0.009729262813810318,
-                0.04444568709275543,
-                -0.015483693425092187,
-                -0.030556878922487145,
-                0.03787065692170211,
-                -0.002725442798439903,
-                -0.03391121343593522,
-                0.034354516086797314,
-                0.0,
-                -0.033922366606253536,
-                0.033922366606253536,
-                0.0,
-                -0.034354516086797314,
-                0.03391121343593522,
-                0.002725442798439903,
-                -0.03787065692170211,
-                0.030556878922487145,
-                0.015483693425092187,
-                -0.04444568709275543,
-                0.009729262813810318,
-                0.04634536720004783,
-                -0.019288675826891737,
-                -0.06251547321318089,
-                -0.038165266333821155,
-                -0.00884444155593339,
-                -0.01791615859566177,
-                -0.053534763307268154,
-                -0.05357167111124354,
-                0.016964168332763287,
-                0.043983421039385705,
-                -0.02711051235023537,
-                -0.026070690762106222,
-                0.040990364954344646,
-                -0.005838768515590004,
-                -0.0338503132728654,
-                0.035271218914294425,
-                0.0,
-                -0.034354516086797314,
-                0.033922366606253536,
-                0.0,
-                -0.033922366606253536,
-                0.034354516086797314,
-                0.0,
-                -0.035271218914294425,
-                0.0338503132728654,
-                0.005838768515590004,
-                -0.040990364954344646,
-                0.026070690762106222,
-                0.02711051235023537,
-                -0.043983421039385705,
-                -0.016964168332763287,
-                0.05357167111124354,
-                0.053534763307268154,
-                0.01791615859566177,
-                0.029902891420361847,
-                0.06304083034203398,
-                0.02976597472238238,
-                -0.04346305529542573,
-                -0.017060985511609412,
-                0.04491349286240468,
-                -0.010750348892621761,
-                -0.033653915268038584,
-                0.03679917021387186,
-                0.0,
-                -0.035271218914294425,
-                0.03391121343593522,
-                0.0008698042719552189,
-                -0.034354516086797314,
-                0.034354516086797314,
-                -0.0008698042719552189,
-                -0.03391121343593522,
-                0.035271218914294425,
-                0.0,
-                -0.03679917021387186,
-                0.033653915268038584,
-                0.010750348892621761,
-                -0.04491349286240468,
-                0.017060985511609412,
-                0.04346305529542573,
-                -0.02976597472238238,
-                -0.06304083034203398,
-                -0.029902891420361847,
-                -0.04344789394034224,
-                -0.06261507939047613,
-                0.002237680382813104,
-                0.04905064815727292,
-                -0.018587569265458983,
-                -0.03313480062523981,
-                0.03920562481920355,
-                0.0,
-                -0.03679917021387186,
-                0.0338503132728654,
-                0.002725442798439903,
-                -0.03566197515016398,
-                0.03391121343593522,
-                0.0,
-                -0.03391121343593522,
-                0.03566197515016398,
-                -0.002725442798439903,
-                -0.0338503132728654,
-                0.03679917021387186,
-                0.0,
-                -0.03920562481920355,
-                0.03313480062523981,
-                0.018587569265458983,
-                -0.04905064815727292,
-                -0.002237680382813104,
-                0.06261507939047613,
-                0.04344789394034224,
-                0.05652081218639529,
-                0.050553751276911356,
-                -0.03226452673976127,
-                -0.031834886704915785,
-                0.04310464036632843,
-                0.0,
-                -0.03920562481920355,
-                0.033653915268038584,
-                0.005838768515590004,
-                -0.03787065692170211,
-                0.03281534298740144,
-                0.002725442798439903,
-                -0.035271218914294425,
-                0.035271218914294425,
-                -0.002725442798439903,
-                -0.03281534298740144,
-                0.03787065692170211,
-                -0.005838768515590004,
-                -0.033653915268038584,
-                0.03920562481920355,
-                0.0,
-                -0.04310464036632843,
-                0.031834886704915785,
-                0.03226452673976127,
-                -0.050553751276911356,
-                -0.05652081218639529,
-                -0.06687632686006072,
-                -0.028260406093197646,
-                0.05033537552047327,
-                0.0,
-                -0.04310464036632843,
-                0.03313480062523981,
-                0.010750348892621761,
-                -0.040990364954344646,
-                0.030556878922487145,
-                0.007670092216332385,
-                -0.03787065692170211,
-                0.0338503132728654,
-                0.0,
-                -0.0338503132728654,
-                0.03787065692170211,
-                -0.007670092216332385,
-                -0.030556878922487145,
-                0.040990364954344646,
-                -0.010750348892621761,
-                -0.03313480062523981,
-                0.04310464036632843,
-                0.0,
-                -0.05033537552047327,
-                0.028260406093197646,
-                0.06687632686006072,
-                0.07260229780692978,
-                0.0,
-                -0.05033537552047327,
-                0.031834886704915785,
-                0.018587569265458983,
-                -0.04491349286240468,
-                0.026070690762106222,
-                0.015483693425092187,
-                -0.04131210868534416,
-                0.030556878922487145,
-                0.005838768515590004,
-                -0.03679917021387186,
-                0.03679917021387186,
-                -0.005838768515590004,
-                -0.030556878922487145,
-                0.04131210868534416,
-                -0.015483693425092187,
-                -0.026070690762106222,
-                0.04491349286240468,
-                -0.018587569265458983,
-                -0.031834886704915785,
-                0.05033537552047327,
-                0.0,
-                -0.07260229780692978,
-                -0.07260229780692978,
-                0.028260406093197646,
-                0.03226452673976127,
-                -0.04905064815727292,
-                0.017060985511609412,
-                0.02711051235023537,
-                -0.04444568709275543,
-                0.023628484643940535,
-                0.015483693425092187,
-                -0.040990364954344646,
-                0.033653915268038584,
-                0.0,
-                -0.033653915268038584,
-                0.040990364954344646,
-                -0.015483693425092187,
-                -0.023628484643940535,
-                0.04444568709275543,
-                -0.02711051235023537,
-                -0.017060985511609412,
-                0.04905064815727292,
-                -0.03226452673976127,
-                -0.028260406093197646,
-                0.07260229780692978,
-                0.06687632686006072,
-                -0.050553751276911356,
-                -0.002237680382813104,
-                0.04346305529542573,
-                -0.043983421039385705,
-                0.009729262813810318,
-                0.029494272130845153,
-                -0.04444568709275543,
-                0.026070690762106222,
-                0.010750348892621761,
-                -0.03920562481920355,
-                0.03920562481920355,
-                -0.010750348892621761,
-                -0.026070690762106222,
-                0.04444568709275543,
-                -0.029494272130845153,
-                -0.009729262813810318,
-                0.043983421039385705,
-                -0.04346305529542573,
-                0.002237680382813104,
-                0.050553751276911356,
-                -0.06687632686006072,
-                -0.05652081218639529,
-                0.06261507939047613,
-                -0.02976597472238238,
-                -0.016964168332763287,
-                0.04634536720004783,
-                -0.041800924309252876,
-                0.009729262813810318,
-                0.02711051235023537,
-                -0.04491349286240468,
-                0.03313480062523981,
-                0.0,
-                -0.03313480062523981,
-                0.04491349286240468,
-                -0.02711051235023537,
-                -0.009729262813810318,
-                0.041800924309252876,
-                -0.04634536720004783,
-                0.016964168332763287,
-                0.02976597472238238,
-                -0.06261507939047613,
-                0.05652081218639529,
-                0.04344789394034224,
-                -0.06304083034203398,
-                0.05357167111124354,
-                -0.019288675826891737,
-                -0.02117002959428198,
-                0.04634536720004783,
-                -0.043983421039385705,
-                0.017060985511609412,
-                0.018587569265458983,
-                -0.04310464036632843,
-                0.04310464036632843,
-                -0.018587569265458983,
-                -0.017060985511609412,
-                0.043983421039385705,
-                -0.04634536720004783,
-                0.02117002959428198,
-                0.019288675826891737,
-                -0.05357167111124354,
-                0.06304083034203398,
-                -0.04344789394034224,
-                -0.029902891420361847,
-                0.053534763307268154,
-                -0.06251547321318089,
-                0.04992388982420658,
-                -0.019288675826891737,
-                -0.016964168332763287,
-                0.04346305529542573,
-                -0.04905064815727292,
-                0.031834886704915785,
-                0.0,
-                -0.031834886704915785,
-                0.04905064815727292,
-                -0.04346305529542573,
-                0.016964168332763287,
-                0.019288675826891737,
-                -0.04992388982420658,
-                0.06251547321318089,
-                -0.053534763307268154,
-                0.029902891420361847,
-                0.01791615859566177,
-                -0.038165266333821155,
-                0.055746546520766306,
-                -0.06251547321318089,
-                0.05357167111124354,
-                -0.02976597472238238,
-                -0.002237680382813104,
-                0.03226452673976127,
-                -0.05033537552047327,
-                0.05033537552047327,
-                -0.03226452673976127,
-                0.002237680382813104,
-                0.02976597472238238,
-                -0.05357167111124354,
-                0.06251547321318089,
-                -0.055746546520766306,
-                0.038165266333821155,
-                -0.01791615859566177,
-                -0.00884444155593339,
-                0.021888876100030097,
-                -0.038165266333821155,
-                0.053534763307268154,
-                -0.06304083034203398,
-                0.06261507939047613,
-                -0.050553751276911356,
-                0.028260406093197646,
-                0.0,
-                -0.028260406093197646,
-                0.050553751276911356,
-                -0.06261507939047613,
-                0.06304083034203398,
-                -0.053534763307268154,
-                0.038165266333821155,
-                -0.021888876100030097,
-                0.00884444155593339,
-                0.0031269823000042996,
-                -0.00884444155593339,
-                0.01791615859566177,
-                -0.029902891420361847,
-                0.04344789394034224,
-                -0.05652081218639529,
-                0.06687632686006072,
-                -0.07260229780692978,
-                0.07260229780692978,
-                -0.06687632686006072,
-                0.05652081218639529,
-                -0.04344789394034224,
-                0.029902891420361847,
-                -0.01791615859566177,
-                0.00884444155593339,
-                -0.0031269823000042996};
-    }
-
-    case 16: {
-        return {
-            0.002332434819536523,   -0.006800157615289823,  0.014190739125793207,   -0.02439633453002056,
-            0.036524330106695854,   -0.049002530970728445,  0.05989198229755699,    -0.06732818568756019,
-            0.06996950303537157,    -0.06732818568756019,   0.05989198229755699,    -0.049002530970728445,
-            0.036524330106695854,   -0.02439633453002056,   0.014190739125793207,   -0.006800157615289823,
-            0.002332434819536523,   -0.006800157615289823,  0.01749326114652392,    -0.03175495342041885,
-            0.04653947075981801,    -0.05766112191581057,   0.061116893992414975,   -0.05444725663414272,
-            0.03767031413024793,    -0.013465637137512037,  -0.013465637137512037,  0.03767031413024793,
-            -0.05444725663414272,   0.061116893992414975,   -0.05766112191581057,   0.04653947075981801,
-            -0.03175495342041885,   0.01749326114652392,    -0.006800157615289823,  0.014190739125793207,
-            -0.03175495342041885,   0.04901875112671112,    -0.05886044394387448,   0.055775788586250624,
-            -0.03850957655394699,   0.010976918204446077,   0.018862197257764036,   -0.04172236023864111,
-            0.05026757490132502,    -0.04172236023864111,   0.018862197257764036,   0.010976918204446077,
-            -0.03850957655394699,   0.055775788586250624,   -0.05886044394387448,   0.04901875112671112,
-            -0.03175495342041885,   0.014190739125793207,   -0.02439633453002056,   0.04653947075981801,
-            -0.05886044394387448,   0.05330742160134279,    -0.029782683557593614,  -0.0033600089844400306,
-            0.033008845201087066,   -0.047172204086926656,  0.04029752117966596,    -0.015722270889929855,
-            -0.015722270889929855,  0.04029752117966596,    -0.047172204086926656,  0.033008845201087066,
-            -0.0033600089844400306, -0.029782683557593614,  0.05330742160134279,    -0.05886044394387448,
-            0.04653947075981801,    -0.02439633453002056,   0.036524330106695854,   -0.05766112191581057,
-            0.055775788586250624,   -0.029782683557593614,  -0.007701704963063591,  0.03784508554399198,
-            -0.0460145657870965,    0.02927628765579554,    0.0025451765996826314,  -0.03228026116417114,
-            0.04427720455204181,    -0.03228026116417114,   0.0025451765996826314,  0.02927628765579554,
-            -0.0460145657870965,    0.03784508554399198,    -0.007701704963063591,  -0.029782683557593614,
-            0.055775788586250624,   -0.05766112191581057,   0.036524330106695854,   -0.049002530970728445,
-            0.061116893992414975,   -0.03850957655394699,   -0.0033600089844400306, 0.03784508554399198,
-            -0.04504920132260558,   0.023191638763602442,   0.012110099474284711,   -0.03846034762840496,
-            0.04014710529172678,    -0.016838621425166362,  -0.016838621425166362,  0.04014710529172678,
-            -0.03846034762840496,   0.012110099474284711,   0.023191638763602442,   -0.04504920132260558,
-            0.03784508554399198,    -0.0033600089844400306, -0.03850957655394699,   0.061116893992414975,
-            -0.049002530970728445,  0.05989198229755699,    -0.05444725663414272,   0.010976918204446077,
-            0.033008845201087066,   -0.0460145657870965,    0.023191638763602442,   0.014998239101895496,
-            -0.04021564159683018,   0.03582726352161462,    -0.006450641267776993,  -0.026835187064573413,
-            0.041161074594851105,   -0.026835187064573413,  -0.006450641267776993,  0.03582726352161462,
-            -0.04021564159683018,   0.014998239101895496,   0.023191638763602442,   -0.0460145657870965,
-            0.033008845201087066,   0.010976918204446077,   -0.05444725663414272,   0.05989198229755699,
-            -0.06732818568756019,   0.03767031413024793,    0.018862197257764036,   -0.047172204086926656,
-            0.02927628765579554,    0.012110099474284711,   -0.04021564159683018,   0.03416537032376719,
-            -0.0014800491361420564, -0.031232118321023662,  0.03932573780534777,    -0.017490093546632834,
-            -0.017490093546632834,  0.03932573780534777,    -0.031232118321023662,  -0.0014800491361420564,
-            0.03416537032376719,    -0.04021564159683018,   0.012110099474284711,   0.02927628765579554,
-            -0.047172204086926656,  0.018862197257764036,   0.03767031413024793,    -0.06732818568756019,
-            0.06996950303537157,    -0.013465637137512037,  -0.04172236023864111,   0.04029752117966596,
-            0.0025451765996826314,  -0.03846034762840496,   0.03582726352161462,    -0.0014800491361420564,
-            -0.032439351260796855,  0.03782655441812914,    -0.011859937700410775,  -0.02331653674132676,
-            0.03926516262847559,    -0.02331653674132676,   -0.011859937700410775,  0.03782655441812914,
-            -0.032439351260796855,  -0.0014800491361420564, 0.03582726352161462,    -0.03846034762840496,
-            0.0025451765996826314,  0.04029752117966596,    -0.04172236023864111,   -0.013465637137512037,
-            0.06996950303537157,    -0.06732818568756019,   -0.013465637137512037,  0.05026757490132502,
-            -0.015722270889929855,  -0.03228026116417114,   0.04014710529172678,    -0.006450641267776993,
-            -0.031232118321023662,  0.03782655441812914,    -0.010008367977771717,  -0.025773356818701038,
-            0.03842831211221362,    -0.017894419176959823,  -0.017894419176959823,  0.03842831211221362,
-            -0.025773356818701038,  -0.010008367977771717,  0.03782655441812914,    -0.031232118321023662,
-            -0.006450641267776993,  0.04014710529172678,    -0.03228026116417114,   -0.015722270889929855,
-            0.05026757490132502,    -0.013465637137512037,  -0.06732818568756019,   0.05989198229755699,
-            0.03767031413024793,    -0.04172236023864111,   -0.015722270889929855,  0.04427720455204181,
-            -0.016838621425166362,  -0.026835187064573413,  0.03932573780534777,    -0.011859937700410775,
-            -0.025773356818701038,  0.03803633000201913,    -0.015198869152750111,  -0.020980260102638197,
-            0.03805137529297539,    -0.020980260102638197,  -0.015198869152750111,  0.03803633000201913,
-            -0.025773356818701038,  -0.011859937700410775,  0.03932573780534777,    -0.026835187064573413,
-            -0.016838621425166362,  0.04427720455204181,    -0.015722270889929855,  -0.04172236023864111,
-            0.03767031413024793,    0.05989198229755699,    -0.049002530970728445,  -0.05444725663414272,
-            0.018862197257764036,   0.04029752117966596,    -0.03228026116417114,   -0.016838621425166362,
-            0.041161074594851105,   -0.017490093546632834,  -0.02331653674132676,   0.03842831211221362,
-            -0.015198869152750111,  -0.021922898204612937,  0.037670497912531554,   -0.01814709977885351,
-            -0.01814709977885351,   0.037670497912531554,   -0.021922898204612937,  -0.015198869152750111,
-            0.03842831211221362,    -0.02331653674132676,   -0.017490093546632834,  0.041161074594851105,
-            -0.016838621425166362,  -0.03228026116417114,   0.04029752117966596,    0.018862197257764036,
-            -0.05444725663414272,   -0.049002530970728445,  0.036524330106695854,   0.061116893992414975,
-            0.010976918204446077,   -0.047172204086926656,  0.0025451765996826314,  0.04014710529172678,
-            -0.026835187064573413,  -0.017490093546632834,  0.03926516262847559,    -0.017894419176959823,
-            -0.020980260102638197,  0.037670497912531554,   -0.017213922456605385,  -0.019479737758967205,
-            0.037288745330013265,   -0.019479737758967205,  -0.017213922456605385,  0.037670497912531554,
-            -0.020980260102638197,  -0.017894419176959823,  0.03926516262847559,    -0.017490093546632834,
-            -0.026835187064573413,  0.04014710529172678,    0.0025451765996826314,  -0.047172204086926656,
-            0.010976918204446077,   0.061116893992414975,   0.036524330106695854,   -0.02439633453002056,
-            -0.05766112191581057,   -0.03850957655394699,   0.033008845201087066,   0.02927628765579554,
-            -0.03846034762840496,   -0.006450641267776993,  0.03932573780534777,    -0.02331653674132676,
-            -0.017894419176959823,  0.03805137529297539,    -0.01814709977885351,   -0.019479737758967205,
-            0.03713812206595289,    -0.01829584898667091,   -0.01829584898667091,   0.03713812206595289,
-            -0.019479737758967205,  -0.01814709977885351,   0.03805137529297539,    -0.017894419176959823,
-            -0.02331653674132676,   0.03932573780534777,    -0.006450641267776993,  -0.03846034762840496,
-            0.02927628765579554,    0.033008845201087066,   -0.03850957655394699,   -0.05766112191581057,
-            -0.02439633453002056,   0.014190739125793207,   0.04653947075981801,    0.055775788586250624,
-            -0.0033600089844400306, -0.0460145657870965,    0.012110099474284711,   0.03582726352161462,
-            -0.031232118321023662,  -0.011859937700410775,  0.03842831211221362,    -0.020980260102638197,
-            -0.01814709977885351,   0.037288745330013265,   -0.01829584898667091,   -0.018637079571558777,
-            0.03686579691985189,    -0.018637079571558777,  -0.01829584898667091,   0.037288745330013265,
-            -0.01814709977885351,   -0.020980260102638197,  0.03842831211221362,    -0.011859937700410775,
-            -0.031232118321023662,  0.03582726352161462,    0.012110099474284711,   -0.0460145657870965,
-            -0.0033600089844400306, 0.055775788586250624,   0.04653947075981801,    0.014190739125793207,
-            -0.006800157615289823,  -0.03175495342041885,   -0.05886044394387448,   -0.029782683557593614,
-            0.03784508554399198,    0.023191638763602442,   -0.04021564159683018,   -0.0014800491361420564,
-            0.03782655441812914,    -0.025773356818701038,  -0.015198869152750111,  0.037670497912531554,
-            -0.019479737758967205,  -0.01829584898667091,   0.03686579691985189,    -0.018365005417229453,
-            -0.018365005417229453,  0.03686579691985189,    -0.01829584898667091,   -0.019479737758967205,
-            0.037670497912531554,   -0.015198869152750111,  -0.025773356818701038,  0.03782655441812914,
-            -0.0014800491361420564, -0.04021564159683018,   0.023191638763602442,   0.03784508554399198,
-            -0.029782683557593614,  -0.05886044394387448,   -0.03175495342041885,   -0.006800157615289823,
-            0.002332434819536523,   0.01749326114652392,    0.04901875112671112,    0.05330742160134279,
-            -0.007701704963063591,  -0.04504920132260558,   0.014998239101895496,   0.03416537032376719,
-            -0.032439351260796855,  -0.010008367977771717,  0.03803633000201913,    -0.021922898204612937,
-            -0.017213922456605385,  0.03713812206595289,    -0.018637079571558777,  -0.018365005417229453,
-            0.036730010834458905,   -0.018365005417229453,  -0.018637079571558777,  0.03713812206595289,
-            -0.017213922456605385,  -0.021922898204612937,  0.03803633000201913,    -0.010008367977771717,
-            -0.032439351260796855,  0.03416537032376719,    0.014998239101895496,   -0.04504920132260558,
-            -0.007701704963063591,  0.05330742160134279,    0.04901875112671112,    0.01749326114652392,
-            0.002332434819536523,   -0.006800157615289823,  -0.03175495342041885,   -0.05886044394387448,
-            -0.029782683557593614,  0.03784508554399198,    0.023191638763602442,   -0.04021564159683018,
-            -0.0014800491361420564, 0.03782655441812914,    -0.025773356818701038,  -0.015198869152750111,
-            0.037670497912531554,   -0.019479737758967205,  -0.01829584898667091,   0.03686579691985189,
-            -0.018365005417229453,  -0.018365005417229453,  0.03686579691985189,    -0.01829584898667091,
-            -0.019479737758967205,  0.037670497912531554,   -0.015198869152750111,  -0.025773356818701038,
-            0.03782655441812914,    -0.0014800491361420564, -0.04021564159683018,   0.023191638763602442,
-            0.03784508554399198,    -0.029782683557593614,  -0.05886044394387448,   -0.03175495342041885,
-            -0.006800157615289823,  0.014190739125793207,   0.04653947075981801,    0.055775788586250624,
-            -0.0033600089844400306, -0.0460145657870965,    0.012110099474284711,   0.03582726352161462,
-            -0.031232118321023662,  -0.011859937700410775,  0.03842831211221362,    -0.020980260102638197,
-            -0.01814709977885351,   0.037288745330013265,   -0.01829584898667091,   -0.018637079571558777,
-            0.03686579691985189,    -0.018637079571558777,  -0.01829584898667091,   0.037288745330013265,
-            -0.01814709977885351,   -0.020980260102638197,  0.03842831211221362,    -0.011859937700410775,
-            -0.031232118321023662,  0.03582726352161462,    0.012110099474284711,   -0.0460145657870965,
-            -0.0033600089844400306, 0.055775788586250624,   0.04653947075981801,    0.014190739125793207,
-            -0.02439633453002056,   -0.05766112191581057,   -0.03850957655394699,   0.033008845201087066,
-            0.02927628765579554,    -0.03846034762840496,   -0.006450641267776993,  0.03932573780534777,
-            -0.02331653674132676,   -0.017894419176959823,  0.03805137529297539,    -0.01814709977885351,
-            -0.019479737758967205,  0.03713812206595289,    -0.01829584898667091,   -0.01829584898667091,
-            0.03713812206595289,    -0.019479737758967205,  -0.01814709977885351,   0.03805137529297539,
-            -0.017894419176959823,  -0.02331653674132676,   0.03932573780534777,    -0.006450641267776993,
-            -0.03846034762840496,   0.02927628765579554,    0.033008845201087066,   -0.03850957655394699,
-            -0.05766112191581057,   -0.02439633453002056,   0.036524330106695854,   0.061116893992414975,
-            0.010976918204446077,   -0.047172204086926656,  0.0025451765996826314,  0.04014710529172678,
-            -0.026835187064573413,  -0.017490093546632834,  0.03926516262847559,    -0.017894419176959823,
-            -0.020980260102638197,  0.037670497912531554,   -0.017213922456605385,  -0.019479737758967205,
-            0.037288745330013265,   -0.019479737758967205,  -0.017213922456605385,  0.037670497912531554,
-            -0.020980260102638197,  -0.017894419176959823,  0.03926516262847559,    -0.017490093546632834,
-            -0.026835187064573413,  0.04014710529172678,    0.0025451765996826314,  -0.047172204086926656,
-            0.010976918204446077,   0.061116893992414975,   0.036524330106695854,   -0.049002530970728445,
-            -0.05444725663414272,   0.018862197257764036,   0.04029752117966596,    -0.03228026116417114,
-            -0.016838621425166362,  0.041161074594851105,   -0.017490093546632834,  -0.02331653674132676,
-            0.03842831211221362,    -0.015198869152750111,  -0.021922898204612937,  0.037670497912531554,
-            -0.01814709977885351,   -0.01814709977885351,   0.037670497912531554,   -0.021922898204612937,
-            -0.015198869152750111,  0.03842831211221362,    -0.02331653674132676,   -0.017490093546632834,
-            0.041161074594851105,   -0.016838621425166362,  -0.03228026116417114,   0.04029752117966596,
-            0.018862197257764036,   -0.05444725663414272,   -0.049002530970728445,  0.05989198229755699,
-            0.03767031413024793,    -0.04172236023864111,   -0.015722270889929855,  0.04427720455204181,
-            -0.016838621425166362,  -0.026835187064573413,  0.03932573780534777,    -0.011859937700410775,
-            -0.025773356818701038,  0.03803633000201913,    -0.015198869152750111,  -0.020980260102638197,
-            0.03805137529297539,    -0.020980260102638197,  -0.015198869152750111,  0.03803633000201913,
-            -0.025773356818701038,  -0.011859937700410775,  0.03932573780534777,    -0.026835187064573413,
-            -0.016838621425166362,  0.04427720455204181,    -0.015722270889929855,  -0.04172236023864111,
-            0.03767031413024793,    0.05989198229755699,    -0.06732818568756019,   -0.013465637137512037,
-            0.05026757490132502,    -0.015722270889929855,  -0.03228026116417114,   0.04014710529172678,
-            -0.006450641267776993,  -0.031232118321023662,  0.03782655441812914,    -0.010008367977771717,
-            -0.025773356818701038,  0.03842831211221362,    -0.017894419176959823,  -0.017894419176959823,
-            0.03842831211221362,    -0.025773356818701038,  -0.010008367977771717,  0.03782655441812914,
-            -0.031232118321023662,  -0.006450641267776993,  0.04014710529172678,    -0.03228026116417114,
-            -0.015722270889929855,  0.05026757490132502,    -0.013465637137512037,  -0.06732818568756019,
-            0.06996950303537157,    -0.013465637137512037,  -0.04172236023864111,   0.04029752117966596,
-            0.0025451765996826314,  -0.03846034762840496,   0.03582726352161462,    -0.0014800491361420564,
-            -0.032439351260796855,  0.03782655441812914,    -0.011859937700410775,  -0.02331653674132676,
-            0.03926516262847559,    -0.02331653674132676,   -0.011859937700410775,  0.03782655441812914,
-            -0.032439351260796855,  -0.0014800491361420564, 0.03582726352161462,    -0.03846034762840496,
-            0.0025451765996826314,  0.04029752117966596,    -0.04172236023864111,   -0.013465637137512037,
-            0.06996950303537157,    -0.06732818568756019,   0.03767031413024793,    0.018862197257764036,
-            -0.047172204086926656,  0.02927628765579554,    0.012110099474284711,   -0.04021564159683018,
-            0.03416537032376719,    -0.0014800491361420564, -0.031232118321023662,  0.03932573780534777,
-            -0.017490093546632834,  -0.017490093546632834,  0.03932573780534777,    -0.031232118321023662,
-            -0.0014800491361420564, 0.03416537032376719,    -0.04021564159683018,   0.012110099474284711,
-            0.02927628765579554,    -0.047172204086926656,  0.018862197257764036,   0.03767031413024793,
-            -0.06732818568756019,   0.05989198229755699,    -0.05444725663414272,   0.010976918204446077,
-            0.033008845201087066,   -0.0460145657870965,    0.023191638763602442,   0.014998239101895496,
-            -0.04021564159683018,   0.03582726352161462,    -0.006450641267776993,  -0.026835187064573413,
-            0.041161074594851105,   -0.026835187064573413,  -0.006450641267776993,  0.03582726352161462,
-            -0.04021564159683018,   0.014998239101895496,   0.023191638763602442,   -0.0460145657870965,
-            0.033008845201087066,   0.010976918204446077,   -0.05444725663414272,   0.05989198229755699,
-            -0.049002530970728445,  0.061116893992414975,   -0.03850957655394699,   -0.0033600089844400306,
-            0.03784508554399198,    -0.04504920132260558,   0.023191638763602442,   0.012110099474284711,
-            -0.03846034762840496,   0.04014710529172678,    -0.016838621425166362,  -0.016838621425166362,
-            0.04014710529172678,    -0.03846034762840496,   0.012110099474284711,   0.023191638763602442,
-            -0.04504920132260558,   0.03784508554399198,    -0.0033600089844400306, -0.03850957655394699,
-            0.061116893992414975,   -0.049002530970728445,  0.036524330106695854,   -0.05766112191581057,
-            0.055775788586250624,   -0.029782683557593614,  -0.007701704963063591,  0.03784508554399198,
-            -0.0460145657870965,    0.02927628765579554,    0.0025451765996826314,  -0.03228026116417114,
-            0.04427720455204181,    -0.03228026116417114,   0.0025451765996826314,  0.02927628765579554,
-            -0.0460145657870965,    0.03784508554399198,    -0.007701704963063591,  -0.029782683557593614,
-            0.055775788586250624,   -0.05766112191581057,   0.036524330106695854,   -0.02439633453002056,
-            0.04653947075981801,    -0.05886044394387448,   0.05330742160134279,    -0.029782683557593614,
-            -0.0033600089844400306, 0.033008845201087066,   -0.047172204086926656,  0.04029752117966596,
-            -0.015722270889929855,  -0.015722270889929855,  0.04029752117966596,    -0.047172204086926656,
-            0.033008845201087066,   -0.0033600089844400306, -0.029782683557593614,  0.05330742160134279,
-            -0.05886044394387448,   0.04653947075981801,    -0.02439633453002056,   0.014190739125793207,
-            -0.03175495342041885,   0.04901875112671112,    -0.05886044394387448,   0.055775788586250624,
-            -0.03850957655394699,   0.010976918204446077,   0.018862197257764036,   -0.04172236023864111,
-            0.05026757490132502,    -0.04172236023864111,   0.018862197257764036,   0.010976918204446077,
-            -0.03850957655394699,   0.055775788586250624,   -0.05886044394387448,   0.04901875112671112,
-            -0.03175495342041885,   0.014190739125793207,   -0.006800157615289823,  0.01749326114652392,
-            -0.03175495342041885,   0.04653947075981801,    -0.05766112191581057,   0.061116893992414975,
-            -0.05444725663414272,   0.03767031413024793,    -0.013465637137512037,  -0.013465637137512037,
-            0.03767031413024793,    -0.05444725663414272,   0.061116893992414975,   -0.05766112191581057,
-            0.04653947075981801,    -0.03175495342041885,   0.01749326114652392,    -0.006800157615289823,
-            0.002332434819536523,   -0.006800157615289823,  0.014190739125793207,   -0.02439633453002056,
-            0.036524330106695854,   -0.049002530970728445,  0.05989198229755699,    -0.06732818568756019,
-            0.06996950303537157,    -0.06732818568756019,   0.05989198229755699,    -0.049002530970728445,
-            0.036524330106695854,   -0.02439633453002056,   0.014190739125793207,   -0.006800157615289823,
-            0.002332434819536523};
-    }
-
-    case 17: {
-        return {0.0017430351706682638,
-                -0.005229105512004791,
-                0.011222567573749308,
-                -0.01983888408430599,
-                0.030547808720168414,
-                -0.042181056145679366,
-                0.053124807143824525,
-                -0.06165542478218704,
-                0.06633067594020957,
-                -0.06633067594020957,
-                0.06165542478218704,
-                -0.053124807143824525,
-                0.042181056145679366,
-                -0.030547808720168414,
-                0.01983888408430599,
-                -0.011222567573749308,
-                0.005229105512004791,
-                -0.0017430351706682638,
-                -0.005229105512004791,
-                0.01394428136534611,
-                -0.026271987923296436,
-                0.040072581556208235,
-                -0.05194166419616664,
-                0.05817466389970664,
-                -0.055937562598944036,
-                0.044252599268367825,
-                -0.024461544628521993,
-                0.0,
-                0.024461544628521993,
-                -0.044252599268367825,
-                0.055937562598944036,
-                -0.05817466389970664,
-                0.05194166419616664,
-                -0.040072581556208235,
-                0.026271987923296436,
-                -0.01394428136534611,
-                0.005229105512004791,
-                0.011222567573749308,
-                -0.026271987923296436,
-                0.04262513280997845,
-                -0.05431750219531801,
-                0.05581296007723946,
-                -0.0444772428723558,
-                0.021985802085253255,
-                0.005901803984617525,
-                -0.031132874981755262,
-                0.04605956564248058,
-                -0.04605956564248058,
-                0.031132874981755262,
-                -0.005901803984617525,
-                -0.021985802085253255,
-                0.0444772428723558,
-                -0.05581296007723946,
-                0.05431750219531801,
-                -0.04262513280997845,
-                0.026271987923296436,
-                -0.011222567573749308,
-                -0.01983888408430599,
-                0.040072581556208235,
-                -0.05431750219531801,
-                0.054351005776292226,
-                -0.037587226681516275,
-                0.008859200012260232,
-                0.021404167109452903,
-                -0.04160150009219351,
-                0.043935651885486024,
-                -0.027774963135064168,
-                0.0,
-                0.027774963135064168,
-                -0.043935651885486024,
-                0.04160150009219351,
-                -0.021404167109452903,
-                -0.008859200012260232,
-                0.037587226681516275,
-                -0.054351005776292226,
-                0.05431750219531801,
-                -0.040072581556208235,
-                0.01983888408430599,
-                0.030547808720168414,
-                -0.05194166419616664,
-                0.05581296007723946,
-                -0.037587226681516275,
-                0.004694949572606452,
-                0.027469032528210216,
-                -0.04378704734301017,
-                0.037147656387073826,
-                -0.011818442611335637,
-                -0.018917278287409266,
-                0.039437797520839125,
-                -0.039437797520839125,
-                0.018917278287409266,
-                0.011818442611335637,
-                -0.037147656387073826,
-                0.04378704734301017,
-                -0.027469032528210216,
-                -0.004694949572606452,
-                0.037587226681516275,
-                -0.05581296007723946,
-                0.05194166419616664,
-                -0.030547808720168414,
-                -0.042181056145679366,
-                0.05817466389970664,
-                -0.0444772428723558,
-                0.008859200012260232,
-                0.027469032528210216,
-                -0.0439285755329122,
-                0.03275064400283913,
-                -0.002481955250691748,
-                -0.0280313680086187,
-                0.0408826054359804,
-                -0.029073930064566367,
-                0.0,
-                0.029073930064566367,
-                -0.0408826054359804,
-                0.0280313680086187,
-                0.002481955250691748,
-                -0.03275064400283913,
-                0.0439285755329122,
-                -0.027469032528210216,
-                -0.008859200012260232,
-                0.0444772428723558,
-                -0.05817466389970664,
-                0.042181056145679366,
-                0.053124807143824525,
-                -0.055937562598944036,
-                0.021985802085253255,
-                0.021404167109452903,
-                -0.04378704734301017,
-                0.03275064400283913,
-                0.0004969650787439751,
-                -0.031478857394074876,
-                0.039572314531603744,
-                -0.020634911822652164,
-                -0.011729746062562187,
-                0.03581220655585093,
-                -0.03581220655585093,
-                0.011729746062562187,
-                0.020634911822652164,
-                -0.039572314531603744,
-                0.031478857394074876,
-                -0.0004969650787439751,
-                -0.03275064400283913,
-                0.04378704734301017,
-                -0.021404167109452903,
-                -0.021985802085253255,
-                0.055937562598944036,
-                -0.053124807143824525,
-                -0.06165542478218704,
-                0.044252599268367825,
-                0.005901803984617525,
-                -0.04160150009219351,
-                0.037147656387073826,
-                -0.002481955250691748,
-                -0.031478857394074876,
-                0.03883554274330157,
-                -0.0162374321580816,
-                -0.017709489651333135,
-                0.03767070371724776,
-                -0.0296466823298746,
-                0.0,
-                0.0296466823298746,
-                -0.03767070371724776,
-                0.017709489651333135,
-                0.0162374321580816,
-                -0.03883554274330157,
-                0.031478857394074876,
-                0.002481955250691748,
-                -0.037147656387073826,
-                0.04160150009219351,
-                -0.005901803984617525,
-                -0.044252599268367825,
-                0.06165542478218704,
-                0.06633067594020957,
-                -0.024461544628521993,
-                -0.031132874981755262,
-                0.043935651885486024,
-                -0.011818442611335637,
-                -0.0280313680086187,
-                0.039572314531603744,
-                -0.0162374321580816,
-                -0.0195091328065916,
-                0.03790996708892741,
-                -0.025342972726045895,
-                -0.007058733888065381,
-                0.03351226374434976,
-                -0.03351226374434976,
-                0.007058733888065381,
-                0.025342972726045895,
-                -0.03790996708892741,
-                0.0195091328065916,
-                0.0162374321580816,
-                -0.039572314531603744,
-                0.0280313680086187,
-                0.011818442611335637,
-                -0.043935651885486024,
-                0.031132874981755262,
-                0.024461544628521993,
-                -0.06633067594020957,
-                -0.06633067594020957,
-                0.0,
-                0.04605956564248058,
-                -0.027774963135064168,
-                -0.018917278287409266,
-                0.0408826054359804,
-                -0.020634911822652164,
-                -0.017709489651333135,
-                0.03790996708892741,
-                -0.023842573112837388,
-                -0.010298671573246517,
-                0.034910987842325304,
-                -0.02989771714360907,
-                0.0,
-                0.02989771714360907,
-                -0.034910987842325304,
-                0.010298671573246517,
-                0.023842573112837388,
-                -0.03790996708892741,
-                0.017709489651333135,
-                0.020634911822652164,
-                -0.0408826054359804,
-                0.018917278287409266,
-                0.027774963135064168,
-                -0.04605956564248058,
-                0.0,
-                0.06633067594020957,
-                0.06165542478218704,
-                0.024461544628521993,
-                -0.04605956564248058,
-                0.0,
-                0.039437797520839125,
-                -0.029073930064566367,
-                -0.011729746062562187,
-                0.03767070371724776,
-                -0.025342972726045895,
-                -0.010298671573246517,
-                0.035236460363309956,
-                -0.027914074143408192,
-                -0.003930156983391267,
-                0.03197798106536353,
-                -0.03197798106536353,
-                0.003930156983391267,
-                0.027914074143408192,
-                -0.035236460363309956,
-                0.010298671573246517,
-                0.025342972726045895,
-                -0.03767070371724776,
-                0.011729746062562187,
-                0.029073930064566367,
-                -0.039437797520839125,
-                0.0,
-                0.04605956564248058,
-                -0.024461544628521993,
-                -0.06165542478218704,
-                -0.053124807143824525,
-                -0.044252599268367825,
-                0.031132874981755262,
-                0.027774963135064168,
-                -0.039437797520839125,
-                0.0,
-                0.03581220655585093,
-                -0.0296466823298746,
-                -0.007058733888065381,
-                0.034910987842325304,
-                -0.027914074143408192,
-                -0.005183865444542137,
-                0.03275883438521618,
-                -0.029998005271263267,
-                0.0,
-                0.029998005271263267,
-                -0.03275883438521618,
-                0.005183865444542137,
-                0.027914074143408192,
-                -0.034910987842325304,
-                0.007058733888065381,
-                0.0296466823298746,
-                -0.03581220655585093,
-                0.0,
-                0.039437797520839125,
-                -0.027774963135064168,
-                -0.031132874981755262,
-                0.044252599268367825,
-                0.053124807143824525,
-                0.042181056145679366,
-                0.055937562598944036,
-                -0.005901803984617525,
-                -0.043935651885486024,
-                0.018917278287409266,
-                0.029073930064566367,
-                -0.03581220655585093,
-                0.0,
-                0.03351226374434976,
-                -0.02989771714360907,
-                -0.003930156983391267,
-                0.03275883438521618,
-                -0.029309423992358582,
-                -0.0018641186409721468,
-                0.0309607520455798,
-                -0.0309607520455798,
-                0.0018641186409721468,
-                0.029309423992358582,
-                -0.03275883438521618,
-                0.003930156983391267,
-                0.02989771714360907,
-                -0.03351226374434976,
-                0.0,
-                0.03581220655585093,
-                -0.029073930064566367,
-                -0.018917278287409266,
-                0.043935651885486024,
-                0.005901803984617525,
-                -0.055937562598944036,
-                -0.042181056145679366,
-                -0.030547808720168414,
-                -0.05817466389970664,
-                -0.021985802085253255,
-                0.04160150009219351,
-                0.011818442611335637,
-                -0.0408826054359804,
-                0.011729746062562187,
-                0.0296466823298746,
-                -0.03351226374434976,
-                0.0,
-                0.03197798106536353,
-                -0.029998005271263267,
-                -0.0018641186409721468,
-                0.03123762029628471,
-                -0.030030165526296216,
-                0.0,
-                0.030030165526296216,
-                -0.03123762029628471,
-                0.0018641186409721468,
-                0.029998005271263267,
-                -0.03197798106536353,
-                0.0,
-                0.03351226374434976,
-                -0.0296466823298746,
-                -0.011729746062562187,
-                0.0408826054359804,
-                -0.011818442611335637,
-                -0.04160150009219351,
-                0.021985802085253255,
-                0.05817466389970664,
-                0.030547808720168414,
-                0.01983888408430599,
-                0.05194166419616664,
-                0.0444772428723558,
-                -0.021404167109452903,
-                -0.037147656387073826,
-                0.0280313680086187,
-                0.020634911822652164,
-                -0.03767070371724776,
-                0.007058733888065381,
-                0.02989771714360907,
-                -0.03197798106536353,
-                0.0,
-                0.0309607520455798,
-                -0.030030165526296216,
-                -0.0006007234672362444,
-                0.030335048119712202,
-                -0.030335048119712202,
-                0.0006007234672362444,
-                0.030030165526296216,
-                -0.0309607520455798,
-                0.0,
-                0.03197798106536353,
-                -0.02989771714360907,
-                -0.007058733888065381,
-                0.03767070371724776,
-                -0.020634911822652164,
-                -0.0280313680086187,
-                0.037147656387073826,
-                0.021404167109452903,
-                -0.0444772428723558,
-                -0.05194166419616664,
-                -0.01983888408430599,
-                -0.011222567573749308,
-                -0.040072581556208235,
-                -0.05581296007723946,
-                -0.008859200012260232,
-                0.04378704734301017,
-                0.002481955250691748,
-                -0.039572314531603744,
-                0.017709489651333135,
-                0.025342972726045895,
-                -0.034910987842325304,
-                0.003930156983391267,
-                0.029998005271263267,
-                -0.0309607520455798,
-                0.0,
-                0.030335048119712202,
-                -0.030036173361812222,
-                0.0,
-                0.030036173361812222,
-                -0.030335048119712202,
-                0.0,
-                0.0309607520455798,
-                -0.029998005271263267,
-                -0.003930156983391267,
-                0.034910987842325304,
-                -0.025342972726045895,
-                -0.017709489651333135,
-                0.039572314531603744,
-                -0.002481955250691748,
-                -0.04378704734301017,
-                0.008859200012260232,
-                0.05581296007723946,
-                0.040072581556208235,
-                0.011222567573749308,
-                0.005229105512004791,
-                0.026271987923296436,
-                0.05431750219531801,
-                0.037587226681516275,
-                -0.027469032528210216,
-                -0.03275064400283913,
-                0.031478857394074876,
-                0.0162374321580816,
-                -0.03790996708892741,
-                0.010298671573246517,
-                0.027914074143408192,
-                -0.03275883438521618,
-                0.0018641186409721468,
-                0.030030165526296216,
-                -0.030335048119712202,
-                0.0,
-                0.030036173361812222,
-                -0.030036173361812222,
-                0.0,
-                0.030335048119712202,
-                -0.030030165526296216,
-                -0.0018641186409721468,
-                0.03275883438521618,
-                -0.027914074143408192,
-                -0.010298671573246517,
-                0.03790996708892741,
-                -0.0162374321580816,
-                -0.031478857394074876,
-                0.03275064400283913,
-                0.027469032528210216,
-                -0.037587226681516275,
-                -0.05431750219531801,
-                -0.026271987923296436,
-                -0.005229105512004791,
-                -0.0017430351706682638,
-                -0.01394428136534611,
-                -0.04262513280997845,
-                -0.054351005776292226,
-                -0.004694949572606452,
-                0.0439285755329122,
-                -0.0004969650787439751,
-                -0.03883554274330157,
-                0.0195091328065916,
-                0.023842573112837388,
-                -0.035236460363309956,
-                0.005183865444542137,
-                0.029309423992358582,
-                -0.03123762029628471,
-                0.0006007234672362444,
-                0.030036173361812222,
-                -0.030036173361812222,
-                0.0,
-                0.030036173361812222,
-                -0.030036173361812222,
-                -0.0006007234672362444,
-                0.03123762029628471,
-                -0.029309423992358582,
-                -0.005183865444542137,
-                0.035236460363309956,
-                -0.023842573112837388,
-                -0.0195091328065916,
-                0.03883554274330157,
-                0.0004969650787439751,
-                -0.0439285755329122,
-                0.004694949572606452,
-                0.054351005776292226,
-                0.04262513280997845,
-                0.01394428136534611,
-                0.0017430351706682638,
-                0.005229105512004791,
-                0.026271987923296436,
-                0.05431750219531801,
-                0.037587226681516275,
-                -0.027469032528210216,
-                -0.03275064400283913,
-                0.031478857394074876,
-                0.0162374321580816,
-                -0.03790996708892741,
-                0.010298671573246517,
-                0.027914074143408192,
-                -0.03275883438521618,
-                0.0018641186409721468,
-                0.030030165526296216,
-                -0.030335048119712202,
-                0.0,
-                0.030036173361812222,
-                -0.030036173361812222,
-                0.0,
-                0.030335048119712202,
-                -0.030030165526296216,
-                -0.0018641186409721468,
-                0.03275883438521618,
-                -0.027914074143408192,
-                -0.010298671573246517,
-                0.03790996708892741,
-                -0.0162374321580816,
-                -0.031478857394074876,
-                0.03275064400283913,
-                0.027469032528210216,
-                -0.037587226681516275,
-                -0.05431750219531801,
-                -0.026271987923296436,
-                -0.005229105512004791,
-                -0.011222567573749308,
-                -0.040072581556208235,
-                -0.05581296007723946,
-                -0.008859200012260232,
-                0.04378704734301017,
-                0.002481955250691748,
-                -0.039572314531603744,
-                0.017709489651333135,
-                0.025342972726045895,
-                -0.034910987842325304,
-                0.003930156983391267,
-                0.029998005271263267,
-                -0.0309607520455798,
-                0.0,
-                0.030335048119712202,
-                -0.030036173361812222,
-                0.0,
-                0.030036173361812222,
-                -0.030335048119712202,
-                0.0,
-                0.0309607520455798,
-                -0.029998005271263267,
-                -0.003930156983391267,
-                0.034910987842325304,
-                -0.025342972726045895,
-                -0.017709489651333135,
-                0.039572314531603744,
-                -0.002481955250691748,
-                -0.04378704734301017,
-                0.008859200012260232,
-                0.05581296007723946,
-                0.040072581556208235,
-                0.011222567573749308,
-                0.01983888408430599,
-                0.05194166419616664,
-                0.0444772428723558,
-                -0.021404167109452903,
-                -0.037147656387073826,
-                0.0280313680086187,
-                0.020634911822652164,
-                -0.03767070371724776,
-                0.007058733888065381,
-                0.02989771714360907,
-                -0.03197798106536353,
-                0.0,
-                0.0309607520455798,
-                -0.030030165526296216,
-                -0.0006007234672362444,
-                0.030335048119712202,
-                -0.030335048119712202,
-                0.0006007234672362444,
-                0.030030165526296216,
-                -0.0309607520455798,
-                0.0,
-                0.03197798106536353,
-                -0.02989771714360907,
-                -0.007058733888065381,
-                0.03767070371724776,
-                -0.020634911822652164,
-                -0.0280313680086187,
-                0.037147656387073826,
-                0.021404167109452903,
-                -0.0444772428723558,
-                -0.05194166419616664,
-                -0.01983888408430599,
-                -0.030547808720168414,
-                -0.05817466389970664,
-                -0.021985802085253255,
-                0.04160150009219351,
-                0.011818442611335637,
-                -0.0408826054359804,
-                0.011729746062562187,
-                0.0296466823298746,
-                -0.03351226374434976,
-                0.0,
-                0.03197798106536353,
-                -0.029998005271263267,
-                -0.0018641186409721468,
-                0.03123762029628471,
-                -0.030030165526296216,
-                0.0,
-                0.030030165526296216,
-                -0.03123762029628471,
-                0.0018641186409721468,
-                0.029998005271263267,
-                -0.03197798106536353,
-                0.0,
-                0.03351226374434976,
-                -0.0296466823298746,
-                -0.011729746062562187,
-                0.0408826054359804,
-                -0.011818442611335637,
-                -0.04160150009219351,
-                0.021985802085253255,
-                0.05817466389970664,
-                0.030547808720168414,
-                0.042181056145679366,
-                0.055937562598944036,
-                -0.005901803984617525,
-                -0.043935651885486024,
-                0.018917278287409266,
-                0.029073930064566367,
-                -0.03581220655585093,
-                0.0,
-                0.03351226374434976,
-                -0.02989771714360907,
-                -0.003930156983391267,
-                0.03275883438521618,
-                -0.029309423992358582,
-                -0.0018641186409721468,
-                0.0309607520455798,
-                -0.0309607520455798,
-                0.0018641186409721468,
-                0.029309423992358582,
-                -0.03275883438521618,
-                0.003930156983391267,
-                0.02989771714360907,
-                -0.03351226374434976,
-                0.0,
-                0.03581220655585093,
-                -0.029073930064566367,
-                -0.018917278287409266,
-                0.043935651885486024,
-                0.005901803984617525,
-                -0.055937562598944036,
-                -0.042181056145679366,
-                -0.053124807143824525,
-                -0.044252599268367825,
-                0.031132874981755262,
-                0.027774963135064168,
-                -0.039437797520839125,
-                0.0,
-                0.03581220655585093,
-                -0.0296466823298746,
-                -0.007058733888065381,
-                0.034910987842325304,
-                -0.027914074143408192,
-                -0.005183865444542137,
-                0.03275883438521618,
-                -0.029998005271263267,
-                0.0,
-                0.029998005271263267,
-                -0.03275883438521618,
-                0.005183865444542137,
-                0.027914074143408192,
-                -0.034910987842325304,
-                0.007058733888065381,
-                0.0296466823298746,
-                -0.03581220655585093,
-                0.0,
-                0.039437797520839125,
-                -0.027774963135064168,
-                -0.031132874981755262,
-                0.044252599268367825,
-                0.053124807143824525,
-                0.06165542478218704,
-                0.024461544628521993,
-                -0.04605956564248058,
-                0.0,
-                0.039437797520839125,
-                -0.029073930064566367,
-                -0.011729746062562187,
-                0.03767070371724776,
-                -0.025342972726045895,
-                -0.010298671573246517,
-                0.035236460363309956,
-                -0.027914074143408192,
-                -0.003930156983391267,
-                0.03197798106536353,
-                -0.03197798106536353,
-                0.003930156983391267,
-                0.027914074143408192,
-                -0.035236460363309956,
-                0.010298671573246517,
-                0.025342972726045895,
-                -0.03767070371724776,
-                0.011729746062562187,
-                0.029073930064566367,
-                -0.039437797520839125,
-                0.0,
-                0.04605956564248058,
-                -0.024461544628521993,
-                -0.06165542478218704,
-                -0.06633067594020957,
-                0.0,
-                0.04605956564248058,
-                -0.027774963135064168,
-                -0.018917278287409266,
-                0.0408826054359804,
-                -0.020634911822652164,
-                -0.017709489651333135,
-                0.03790996708892741,
-                -0.023842573112837388,
-                -0.010298671573246517,
-                0.034910987842325304,
-                -0.02989771714360907,
-                0.0,
-                0.02989771714360907,
-                -0.034910987842325304,
-                0.010298671573246517,
-                0.023842573112837388,
-                -0.03790996708892741,
-                0.017709489651333135,
-                0.020634911822652164,
-                -0.0408826054359804,
-                0.018917278287409266,
-                0.027774963135064168,
-                -0.04605956564248058,
-                0.0,
-                0.06633067594020957,
-                0.06633067594020957,
-                -0.024461544628521993,
-                -0.031132874981755262,
-                0.043935651885486024,
-                -0.011818442611335637,
-                -0.0280313680086187,
-                0.039572314531603744,
-                -0.0162374321580816,
-                -0.0195091328065916,
-                0.03790996708892741,
-                -0.025342972726045895,
-                -0.007058733888065381,
-                0.03351226374434976,
-                -0.03351226374434976,
-                0.007058733888065381,
-                0.025342972726045895,
-                -0.03790996708892741,
-                0.0195091328065916,
-                0.0162374321580816,
-                -0.039572314531603744,
-                0.0280313680086187,
-                0.011818442611335637,
-                -0.043935651885486024,
-                0.031132874981755262,
-                0.024461544628521993,
-                -0.06633067594020957,
-                -0.06165542478218704,
-                0.044252599268367825,
-                0.005901803984617525,
-                -0.04160150009219351,
-                0.037147656387073826,
-                -0.002481955250691748,
-                -0.031478857394074876,
-                0.03883554274330157,
-                -0.0162374321580816,
-                -0.017709489651333135,
-                0.03767070371724776,
-                -0.0296466823298746,
-                0.0,
-                0.0296466823298746,
-                -0.03767070371724776,
-                0.017709489651333135,
-                0.0162374321580816,
-                -0.03883554274330157,
-                0.031478857394074876,
-                0.002481955250691748,
-                -0.037147656387073826,
-                0.04160150009219351,
-                -0.005901803984617525,
-                -0.044252599268367825,
-                0.06165542478218704,
-                0.053124807143824525,
-                -0.055937562598944036,
-                0.021985802085253255,
-                0.021404167109452903,
-                -0.04378704734301017,
-                0.03275064400283913,
-                0.0004969650787439751,
-                -0.031478857394074876,
-                0.039572314531603744,
-                -0.020634911822652164,
-                -0.011729746062562187,
-                0.03581220655585093,
-                -0.03581220655585093,
-                0.011729746062562187,
-                0.020634911822652164,
-                -0.039572314531603744,
-                0.031478857394074876,
-                -0.0004969650787439751,
-                -0.03275064400283913,
-                0.04378704734301017,
-                -0.021404167109452903,
-                -0.021985802085253255,
-                0.055937562598944036,
-                -0.053124807143824525,
-                -0.042181056145679366,
-                0.05817466389970664,
-                -0.0444772428723558,
-                0.008859200012260232,
-                0.027469032528210216,
-                -0.0439285755329122,
-                0.03275064400283913,
-                -0.002481955250691748,
-                -0.0280313680086187,
-                0.0408826054359804,
-                -0.029073930064566367,
-                0.0,
-                0.029073930064566367,
-                -0.0408826054359804,
-                0.0280313680086187,
-                0.002481955250691748,
-                -0.03275064400283913,
-                0.0439285755329122,
-                -0.027469032528210216,
-                -0.008859200012260232,
-                0.0444772428723558,
-                -0.05817466389970664,
-                0.042181056145679366,
-                0.030547808720168414,
-                -0.05194166419616664,
-                0.05581296007723946,
-                -0.037587226681516275,
-                0.004694949572606452,
-                0.027469032528210216,
-                -0.04378704734301017,
-                0.037147656387073826,
-                -0.011818442611335637,
-                -0.018917278287409266,
-                0.039437797520839125,
-                -0.039437797520839125,
-                0.018917278287409266,
-                0.011818442611335637,
-                -0.037147656387073826,
-                0.04378704734301017,
-                -0.027469032528210216,
-                -0.004694949572606452,
-                0.037587226681516275,
-                -0.05581296007723946,
-                0.05194166419616664,
-                -0.030547808720168414,
-                -0.01983888408430599,
-                0.040072581556208235,
-                -0.05431750219531801,
-                0.054351005776292226,
-                -0.037587226681516275,
-                0.008859200012260232,
-                0.021404167109452903,
-                -0.04160150009219351,
-                0.043935651885486024,
-                -0.027774963135064168,
-                0.0,
-                0.027774963135064168,
-                -0.043935651885486024,
-                0.04160150009219351,
-                -0.021404167109452903,
-                -0.008859200012260232,
-                0.037587226681516275,
-                -0.054351005776292226,
-                0.05431750219531801,
-                -0.040072581556208235,
-                0.01983888408430599,
-                0.011222567573749308,
-                -0.026271987923296436,
-                0.04262513280997845,
-                -0.05431750219531801,
-                0.05581296007723946,
-                -0.0444772428723558,
-                0.021985802085253255,
-                0.005901803984617525,
-                -0.031132874981755262,
-                0.04605956564248058,
-                -0.04605956564248058,
-                0.031132874981755262,
-                -0.005901803984617525,
-                -0.021985802085253255,
-                0.0444772428723558,
-                -0.05581296007723946,
-                0.05431750219531801,
-                -0.04262513280997845,
-                0.026271987923296436,
-                -0.011222567573749308,
-                -0.005229105512004791,
-                0.01394428136534611,
-                -0.026271987923296436,
-                0.040072581556208235,
-                -0.05194166419616664,
-                0.05817466389970664,
-                -0.055937562598944036,
-                0.044252599268367825,
-                -0.024461544628521993,
-                0.0,
-                0.024461544628521993,
-                -0.044252599268367825,
-                0.055937562598944036,
-                -0.05817466389970664,
-                0.05194166419616664,
-                -0.040072581556208235,
-                0.026271987923296436,
-                -0.01394428136534611,
-                0.005229105512004791,
-                0.0017430351706682638,
-                -0.005229105512004791,
-                0.011222567573749308,
-                -0.01983888408430599,
-                0.030547808720168414,
-                -0.042181056145679366,
-                0.053124807143824525,
-                -0.06165542478218704,
-                0.06633067594020957,
-                -0.06633067594020957,
-                0.06165542478218704,
-                -0.053124807143824525,
-                0.042181056145679366,
-                -0.030547808720168414,
-                0.01983888408430599,
-                -0.011222567573749308,
-                0.005229105512004791,
-                -0.0017430351706682638};
-    }
-
-    case 18: {
-        return {0.0013047409207377007,  -0.004021481601021059, 0.008862913783126458,   -0.016085926404084235,
-                0.025434082855374122,   -0.036081453664199105, 0.04673097595438579,    -0.05585419940279951,
-                0.06201472972293868,    -0.0641913437305869,   0.06201472972293868,    -0.05585419940279951,
-                0.04673097595438579,    -0.036081453664199105, 0.025434082855374122,   -0.016085926404084235,
-                0.008862913783126458,   -0.004021481601021059, 0.0013047409207377007,  -0.004021481601021059,
-                0.011090297826270456,   -0.021629654376535128, 0.034224809993309374,   -0.04620330597793104,
-                0.05429000161378429,    -0.05555803139913008,  0.048371155590866,      -0.03300307057717762,
-                0.011719682319270088,   0.011719682319270088,  -0.03300307057717762,   0.048371155590866,
-                -0.05555803139913008,   0.05429000161378429,   -0.04620330597793104,   0.034224809993309374,
-                -0.021629654376535128,  0.011090297826270456,  -0.004021481601021059,  0.008862913783126458,
-                -0.021629654376535128,  0.036719137340761,     -0.04931818185098251,   0.05422841339019883,
-                -0.04802382253689016,   0.030661955327869358,  -0.005891591825620426,  -0.0197377113768079,
-                0.03892975414086468,    -0.04603399829904926,  0.03892975414086468,    -0.0197377113768079,
-                -0.005891591825620426,  0.030661955327869358,  -0.04802382253689016,   0.05422841339019883,
-                -0.04931818185098251,   0.036719137340761,     -0.021629654376535128,  0.008862913783126458,
-                -0.016085926404084235,  0.034224809993309374,  -0.04931818185098251,   0.05358757353029842,
-                -0.04290306983665025,   0.019243518181438157,  0.009699043537804111,   -0.03352769397781691,
-                0.04340564707727172,    -0.035740035642216395, 0.013745665494121932,   0.013745665494121932,
-                -0.035740035642216395,  0.04340564707727172,   -0.03352769397781691,   0.009699043537804111,
-                0.019243518181438157,   -0.04290306983665025,  0.05358757353029842,    -0.04931818185098251,
-                0.034224809993309374,   -0.016085926404084235, 0.025434082855374122,   -0.04620330597793104,
-                0.05422841339019883,    -0.04290306983665025,  0.015470499488747022,   0.01635048183559765,
-                -0.03831736454607647,   0.04077841448577397,   -0.023344498615084593,  -0.005026352155495699,
-                0.030392809958491737,   -0.040466143530873036, 0.030392809958491737,   -0.005026352155495699,
-                -0.023344498615084593,  0.04077841448577397,   -0.03831736454607647,   0.01635048183559765,
-                0.015470499488747022,   -0.04290306983665025,  0.05422841339019883,    -0.04620330597793104,
-                0.025434082855374122,   -0.036081453664199105, 0.05429000161378429,    -0.04802382253689016,
-                0.019243518181438157,   0.01635048183559765,   -0.039375217072262755,  0.038227703390916495,
-                -0.015195480876658785,  -0.015577729793770681, 0.036427627581107305,   -0.03591182640396406,
-                0.014776146418067274,   0.014776146418067274,  -0.03591182640396406,   0.036427627581107305,
-                -0.015577729793770681,  -0.015195480876658785, 0.038227703390916495,   -0.039375217072262755,
-                0.01635048183559765,    0.019243518181438157,  -0.04802382253689016,   0.05429000161378429,
-                -0.036081453664199105,  0.04673097595438579,   -0.05555803139913008,   0.030661955327869358,
-                0.009699043537804111,   -0.03831736454607647,  0.038227703390916495,   -0.012461177687690712,
-                -0.020074613689540676,  0.037907925294660534,  -0.030389089420120526,  0.0033617153771855045,
-                0.025393803691065763,   -0.03753144943335908,  0.025393803691065763,   0.0033617153771855045,
-                -0.030389089420120526,  0.037907925294660534,  -0.020074613689540676,  -0.012461177687690712,
-                0.038227703390916495,   -0.03831736454607647,  0.009699043537804111,   0.030661955327869358,
-                -0.05555803139913008,   0.04673097595438579,   -0.05585419940279951,   0.048371155590866,
-                -0.005891591825620426,  -0.03352769397781691,  0.04077841448577397,    -0.015195480876658785,
-                -0.020074613689540676,  0.038079495097981766,  -0.02713477165544653,   -0.0030865561497699394,
-                0.03024385525866823,    -0.035367742510235445, 0.015395638021716078,   0.015395638021716078,
-                -0.035367742510235445,  0.03024385525866823,   -0.0030865561497699394, -0.02713477165544653,
-                0.038079495097981766,   -0.020074613689540676, -0.015195480876658785,  0.04077841448577397,
-                -0.03352769397781691,   -0.005891591825620426, 0.048371155590866,      -0.05585419940279951,
-                0.06201472972293868,    -0.03300307057717762,  -0.0197377113768079,    0.04340564707727172,
-                -0.023344498615084593,  -0.015577729793770681, 0.037907925294660534,   -0.02713477165544653,
-                -0.005134061186996236,  0.032016738327393095,  -0.0330670126507366,    0.008601683939533786,
-                0.022080648802315684,   -0.03570762718433615,  0.022080648802315684,   0.008601683939533786,
-                -0.0330670126507366,    0.032016738327393095,  -0.005134061186996236,  -0.02713477165544653,
-                0.037907925294660534,   -0.015577729793770681, -0.023344498615084593,  0.04340564707727172,
-                -0.0197377113768079,    -0.03300307057717762,  0.06201472972293868,    -0.0641913437305869,
-                0.011719682319270088,   0.03892975414086468,   -0.035740035642216395,  -0.005026352155495699,
-                0.036427627581107305,   -0.030389089420120526, -0.0030865561497699394, 0.032016738327393095,
-                -0.03216431021499327,   0.005268628994424059,  0.025294797069790202,   -0.03465307055560398,
-                0.01579440720512491,    0.01579440720512491,   -0.03465307055560398,   0.025294797069790202,
-                0.005268628994424059,   -0.03216431021499327,  0.032016738327393095,   -0.0030865561497699394,
-                -0.030389089420120526,  0.036427627581107305,  -0.005026352155495699,  -0.035740035642216395,
-                0.03892975414086468,    0.011719682319270088,  -0.0641913437305869,    0.06201472972293868,
-                0.011719682319270088,   -0.04603399829904926,  0.013745665494121932,   0.030392809958491737,
-                -0.03591182640396406,   0.0033617153771855045, 0.03024385525866823,    -0.0330670126507366,
-                0.005268628994424059,   0.026234663917858666,  -0.03380748189477056,   0.01199406134328838,
-                0.01978955738340553,    -0.03449684521604605,  0.01978955738340553,    0.01199406134328838,
-                -0.03380748189477056,   0.026234663917858666,  0.005268628994424059,   -0.0330670126507366,
-                0.03024385525866823,    0.0033617153771855045, -0.03591182640396406,   0.030392809958491737,
-                0.013745665494121932,   -0.04603399829904926,  0.011719682319270088,   0.06201472972293868,
-                -0.05585419940279951,   -0.03300307057717762,  0.03892975414086468,    0.013745665494121932,
-                -0.040466143530873036,  0.014776146418067274,  0.025393803691065763,   -0.035367742510235445,
-                0.008601683939533786,   0.025294797069790202,  -0.03380748189477056,   0.010734775103588909,
-                0.02154761290740908,    -0.03397716162642046,  0.01605740757832031,    0.01605740757832031,
-                -0.03397716162642046,   0.02154761290740908,   0.010734775103588909,   -0.03380748189477056,
-                0.025294797069790202,   0.008601683939533786,  -0.035367742510235445,  0.025393803691065763,
-                0.014776146418067274,   -0.040466143530873036, 0.013745665494121932,   0.03892975414086468,
-                -0.03300307057717762,   -0.05585419940279951,  0.04673097595438579,    0.048371155590866,
-                -0.0197377113768079,    -0.035740035642216395, 0.030392809958491737,   0.014776146418067274,
-                -0.03753144943335908,   0.015395638021716078,  0.022080648802315684,   -0.03465307055560398,
-                0.01199406134328838,    0.02154761290740908,   -0.03374133001927757,   0.014197110982159655,
-                0.018207388779702623,   -0.03368230229363357,  0.018207388779702623,   0.014197110982159655,
-                -0.03374133001927757,   0.02154761290740908,   0.01199406134328838,    -0.03465307055560398,
-                0.022080648802315684,   0.015395638021716078,  -0.03753144943335908,   0.014776146418067274,
-                0.030392809958491737,   -0.035740035642216395, -0.0197377113768079,    0.048371155590866,
-                0.04673097595438579,    -0.036081453664199105, -0.05555803139913008,   -0.005891591825620426,
-                0.04340564707727172,    -0.005026352155495699, -0.03591182640396406,   0.025393803691065763,
-                0.015395638021716078,   -0.03570762718433615,  0.01579440720512491,    0.01978955738340553,
-                -0.03397716162642046,   0.014197110982159655,  0.018877328763231643,   -0.03342967036216636,
-                0.016228539313173543,   0.016228539313173543,  -0.03342967036216636,   0.018877328763231643,
-                0.014197110982159655,   -0.03397716162642046,  0.01978955738340553,    0.01579440720512491,
-                -0.03570762718433615,   0.015395638021716078,  0.025393803691065763,   -0.03591182640396406,
-                -0.005026352155495699,  0.04340564707727172,   -0.005891591825620426,  -0.05555803139913008,
-                -0.036081453664199105,  0.025434082855374122,  0.05429000161378429,    0.030661955327869358,
-                -0.03352769397781691,   -0.023344498615084593, 0.036427627581107305,   0.0033617153771855045,
-                -0.035367742510235445,  0.022080648802315684,  0.01579440720512491,    -0.03449684521604605,
-                0.01605740757832031,    0.018207388779702623,  -0.03342967036216636,   0.015574891202332186,
-                0.017166433754219338,   -0.033155160180033776, 0.017166433754219338,   0.015574891202332186,
-                -0.03342967036216636,   0.018207388779702623,  0.01605740757832031,    -0.03449684521604605,
-                0.01579440720512491,    0.022080648802315684,  -0.035367742510235445,  0.0033617153771855045,
-                0.036427627581107305,   -0.023344498615084593, -0.03352769397781691,   0.030661955327869358,
-                0.05429000161378429,    0.025434082855374122,  -0.016085926404084235,  -0.04620330597793104,
-                -0.04802382253689016,   0.009699043537804111,  0.04077841448577397,    -0.015577729793770681,
-                -0.030389089420120526,  0.03024385525866823,   0.008601683939533786,   -0.03465307055560398,
-                0.01978955738340553,    0.01605740757832031,   -0.03368230229363357,   0.016228539313173543,
-                0.017166433754219338,   -0.033050654952980506, 0.016331972733181002,   0.016331972733181002,
-                -0.033050654952980506,  0.017166433754219338,  0.016228539313173543,   -0.03368230229363357,
-                0.01605740757832031,    0.01978955738340553,   -0.03465307055560398,   0.008601683939533786,
-                0.03024385525866823,    -0.030389089420120526, -0.015577729793770681,  0.04077841448577397,
-                0.009699043537804111,   -0.04802382253689016,  -0.04620330597793104,   -0.016085926404084235,
-                0.008862913783126458,   0.034224809993309374,  0.05422841339019883,    0.019243518181438157,
-                -0.03831736454607647,   -0.015195480876658785, 0.037907925294660534,   -0.0030865561497699394,
-                -0.0330670126507366,    0.025294797069790202,  0.01199406134328838,    -0.03397716162642046,
-                0.018207388779702623,   0.016228539313173543,  -0.033155160180033776,  0.016331972733181002,
-                0.016573506273797802,   -0.03285779847665091,  0.016573506273797802,   0.016331972733181002,
-                -0.033155160180033776,  0.016228539313173543,  0.018207388779702623,   -0.03397716162642046,
-                0.01199406134328838,    0.025294797069790202,  -0.0330670126507366,    -0.0030865561497699394,
-                0.037907925294660534,   -0.015195480876658785, -0.03831736454607647,   0.019243518181438157,
-                0.05422841339019883,    0.034224809993309374,  0.008862913783126458,   -0.004021481601021059,
-                -0.021629654376535128,  -0.04931818185098251,  -0.04290306983665025,   0.01635048183559765,
-                0.038227703390916495,   -0.020074613689540676, -0.02713477165544653,   0.032016738327393095,
-                0.005268628994424059,   -0.03380748189477056,  0.02154761290740908,    0.014197110982159655,
-                -0.03342967036216636,   0.017166433754219338,  0.016331972733181002,   -0.03285779847665091,
-                0.016380791084567595,   0.016380791084567595,  -0.03285779847665091,   0.016331972733181002,
-                0.017166433754219338,   -0.03342967036216636,  0.014197110982159655,   0.02154761290740908,
-                -0.03380748189477056,   0.005268628994424059,  0.032016738327393095,   -0.02713477165544653,
-                -0.020074613689540676,  0.038227703390916495,  0.01635048183559765,    -0.04290306983665025,
-                -0.04931818185098251,   -0.021629654376535128, -0.004021481601021059,  0.0013047409207377007,
-                0.011090297826270456,   0.036719137340761,     0.05358757353029842,    0.015470499488747022,
-                -0.039375217072262755,  -0.012461177687690712, 0.038079495097981766,   -0.005134061186996236,
-                -0.03216431021499327,   0.026234663917858666,  0.010734775103588909,   -0.03374133001927757,
-                0.018877328763231643,   0.015574891202332186,  -0.033050654952980506,  0.016573506273797802,
-                0.016380791084567595,   -0.03276158216913519,  0.016380791084567595,   0.016573506273797802,
-                -0.033050654952980506,  0.015574891202332186,  0.018877328763231643,   -0.03374133001927757,
-                0.010734775103588909,   0.026234663917858666,  -0.03216431021499327,   -0.005134061186996236,
-                0.038079495097981766,   -0.012461177687690712, -0.039375217072262755,  0.015470499488747022,
-                0.05358757353029842,    0.036719137340761,     0.011090297826270456,   0.0013047409207377007,
-                -0.004021481601021059,  -0.021629654376535128, -0.04931818185098251,   -0.04290306983665025,
-                0.01635048183559765,    0.038227703390916495,  -0.020074613689540676,  -0.02713477165544653,
-                0.032016738327393095,   0.005268628994424059,  -0.03380748189477056,   0.02154761290740908,
-                0.014197110982159655,   -0.03342967036216636,  0.017166433754219338,   0.016331972733181002,
-                -0.03285779847665091,   0.016380791084567595,  0.016380791084567595,   -0.03285779847665091,
-                0.016331972733181002,   0.017166433754219338,  -0.03342967036216636,   0.014197110982159655,
-                0.02154761290740908,    -0.03380748189477056,  0.005268628994424059,   0.032016738327393095,
-                -0.02713477165544653,   -0.020074613689540676, 0.038227703390916495,   0.01635048183559765,
-                -0.04290306983665025,   -0.04931818185098251,  -0.021629654376535128,  -0.004021481601021059,
-                0.008862913783126458,   0.034224809993309374,  0.05422841339019883,    0.019243518181438157,
-                -0.03831736454607647,   -0.015195480876658785, 0.037907925294660534,   -0.0030865561497699394,
-                -0.0330670126507366,    0.025294797069790202,  0.01199406134328838,    -0.03397716162642046,
-                0.018207388779702623,   0.016228539313173543,  -0.033155160180033776,  0.016331972733181002,
-                0.016573506273797802,   -0.03285779847665091,  0.016573506273797802,   0.016331972733181002,
-                -0.033155160180033776,  0.016228539313173543,  0.018207388779702623,   -0.03397716162642046,
-                0.01199406134328838,    0.025294797069790202,  -0.0330670126507366,    -0.0030865561497699394,
-                0.037907925294660534,   -0.015195480876658785, -0.03831736454607647,   0.019243518181438157,
-                0.05422841339019883,    0.034224809993309374,  0.008862913783126458,   -0.016085926404084235,
-                -0.04620330597793104,   -0.04802382253689016,  0.009699043537804111,   0.04077841448577397,
-                -0.015577729793770681,  -0.030389089420120526, 0.03024385525866823,    0.008601683939533786,
-                -0.03465307055560398,   0.01978955738340553,   0.01605740757832031,    -0.03368230229363357,
-                0.016228539313173543,   0.017166433754219338,  -0.033050654952980506,  0.016331972733181002,
-                0.016331972733181002,   -0.033050654952980506, 0.017166433754219338,   0.016228539313173543,
-                -0.03368230229363357,   0.01605740757832031,   0.01978955738340553,    -0.03465307055560398,
-                0.008601683939533786,   0.03024385525866823,   -0.030389089420120526,  -0.015577729793770681,
-                0.04077841448577397,    0.009699043537804111,  -0.04802382253689016,   -0.04620330597793104,
-                -0.016085926404084235,  0.025434082855374122,  0.05429000161378429,    0.030661955327869358,
-                -0.03352769397781691,   -0.023344498615084593, 0.036427627581107305,   0.0033617153771855045,
-                -0.035367742510235445,  0.022080648802315684,  0.01579440720512491,    -0.03449684521604605,
-                0.01605740757832031,    0.018207388779702623,  -0.03342967036216636,   0.015574891202332186,
-                0.017166433754219338,   -0.033155160180033776, 0.017166433754219338,   0.015574891202332186,
-                -0.03342967036216636,   0.018207388779702623,  0.01605740757832031,    -0.03449684521604605,
-                0.01579440720512491,    0.022080648802315684,  -0.035367742510235445,  0.0033617153771855045,
-                0.036427627581107305,   -0.023344498615084593, -0.03352769397781691,   0.030661955327869358,
-                0.05429000161378429,    0.025434082855374122,  -0.036081453664199105,  -0.05555803139913008,
-                -0.005891591825620426,  0.04340564707727172,   -0.005026352155495699,  -0.03591182640396406,
-                0.025393803691065763,   0.015395638021716078,  -0.03570762718433615,   0.01579440720512491,
-                0.01978955738340553,    -0.03397716162642046,  0.014197110982159655,   0.018877328763231643,
-                -0.03342967036216636,   0.016228539313173543,  0.016228539313173543,   -0.03342967036216636,
-                0.018877328763231643,   0.014197110982159655,  -0.03397716162642046,   0.01978955738340553,
-                0.01579440720512491,    -0.03570762718433615,  0.015395638021716078,   0.025393803691065763,
-                -0.03591182640396406,   -0.005026352155495699, 0.04340564707727172,    -0.005891591825620426,
-                -0.05555803139913008,   -0.036081453664199105, 0.04673097595438579,    0.048371155590866,
-                -0.0197377113768079,    -0.035740035642216395, 0.030392809958491737,   0.014776146418067274,
-                -0.03753144943335908,   0.015395638021716078,  0.022080648802315684,   -0.03465307055560398,
-                0.01199406134328838,    0.02154761290740908,   -0.03374133001927757,   0.014197110982159655,
-                0.018207388779702623,   -0.03368230229363357,  0.018207388779702623,   0.014197110982159655,
-                -0.03374133001927757,   0.02154761290740908,   0.01199406134328838,    -0.03465307055560398,
-                0.022080648802315684,   0.015395638021716078,  -0.03753144943335908,   0.014776146418067274,
-                0.030392809958491737,   -0.035740035642216395, -0.0197377113768079,    0.048371155590866,
-                0.04673097595438579,    -0.05585419940279951,  -0.03300307057717762,   0.03892975414086468,
-                0.013745665494121932,   -0.040466143530873036, 0.014776146418067274,   0.025393803691065763,
-                -0.035367742510235445,  0.008601683939533786,  0.025294797069790202,   -0.03380748189477056,
-                0.010734775103588909,   0.02154761290740908,   -0.03397716162642046,   0.01605740757832031,
-                0.01605740757832031,    -0.03397716162642046,  0.02154761290740908,    0.010734775103588909,
-                -0.03380748189477056,   0.025294797069790202,  0.008601683939533786,   -0.035367742510235445,
-                0.025393803691065763,   0.014776146418067274,  -0.040466143530873036,  0.013745665494121932,
-                0.03892975414086468,    -0.03300307057717762,  -0.05585419940279951,   0.06201472972293868,
-                0.011719682319270088,   -0.04603399829904926,  0.013745665494121932,   0.030392809958491737,
-                -0.03591182640396406,   0.0033617153771855045, 0.03024385525866823,    -0.0330670126507366,
-                0.005268628994424059,   0.026234663917858666,  -0.03380748189477056,   0.01199406134328838,
-                0.01978955738340553,    -0.03449684521604605,  0.01978955738340553,    0.01199406134328838,
-                -0.03380748189477056,   0.026234663917858666,  0.005268628994424059,   -0.0330670126507366,
-                0.03024385525866823,    0.0033617153771855045, -0.03591182640396406,   0.030392809958491737,
-                0.013745665494121932,   -0.04603399829904926,  0.011719682319270088,   0.06201472972293868,
-                -0.0641913437305869,    0.011719682319270088,  0.03892975414086468,    -0.035740035642216395,
-                -0.005026352155495699,  0.036427627581107305,  -0.030389089420120526,  -0.0030865561497699394,
-                0.032016738327393095,   -0.03216431021499327,  0.005268628994424059,   0.025294797069790202,
-                -0.03465307055560398,   0.01579440720512491,   0.01579440720512491,    -0.03465307055560398,
-                0.025294797069790202,   0.005268628994424059,  -0.03216431021499327,   0.032016738327393095,
-                -0.0030865561497699394, -0.030389089420120526, 0.036427627581107305,   -0.005026352155495699,
-                -0.035740035642216395,  0.03892975414086468,   0.011719682319270088,   -0.0641913437305869,
-                0.06201472972293868,    -0.03300307057717762,  -0.0197377113768079,    0.04340564707727172,
-                -0.023344498615084593,  -0.015577729793770681, 0.037907925294660534,   -0.02713477165544653,
-                -0.005134061186996236,  0.032016738327393095,  -0.0330670126507366,    0.008601683939533786,
-                0.022080648802315684,   -0.03570762718433615,  0.022080648802315684,   0.008601683939533786,
-                -0.0330670126507366,    0.032016738327393095,  -0.005134061186996236,  -0.02713477165544653,
-                0.037907925294660534,   -0.015577729793770681, -0.023344498615084593,  0.04340564707727172,
-                -0.0197377113768079,    -0.03300307057717762,  0.06201472972293868,    -0.05585419940279951,
-                0.048371155590866,      -0.005891591825620426, -0.03352769397781691,   0.04077841448577397,
-                -0.015195480876658785,  -0.020074613689540676, 0.038079495097981766,   -0.02713477165544653,
-                -0.0030865561497699394, 0.03024385525866823,   -0.035367742510235445,  0.015395638021716078,
-                0.015395638021716078,   -0.035367742510235445, 0.03024385525866823,    -0.0030865561497699394,
-                -0.02713477165544653,   0.038079495097981766,  -0.020074613689540676,  -0.015195480876658785,
-                0.04077841448577397,    -0.03352769397781691,  -0.005891591825620426,  0.048371155590866,
-                -0.05585419940279951,   0.04673097595438579,   -0.05555803139913008,   0.030661955327869358,
-                0.009699043537804111,   -0.03831736454607647,  0.038227703390916495,   -0.012461177687690712,
-                -0.020074613689540676,  0.037907925294660534,  -0.030389089420120526,  0.0033617153771855045,
-                0.025393803691065763,   -0.03753144943335908,  0.025393803691065763,   0.0033617153771855045,
-                -0.030389089420120526,  0.037907925294660534,  -0.020074613689540676,  -0.012461177687690712,
-                0.038227703390916495,   -0.03831736454607647,  0.009699043537804111,   0.030661955327869358,
-                -0.05555803139913008,   0.04673097595438579,   -0.036081453664199105,  0.05429000161378429,
-                -0.04802382253689016,   0.019243518181438157,  0.01635048183559765,    -0.039375217072262755,
-                0.038227703390916495,   -0.015195480876658785, -0.015577729793770681,  0.036427627581107305,
-                -0.03591182640396406,   0.014776146418067274,  0.014776146418067274,   -0.03591182640396406,
-                0.036427627581107305,   -0.015577729793770681, -0.015195480876658785,  0.038227703390916495,
-                -0.039375217072262755,  0.01635048183559765,   0.019243518181438157,   -0.04802382253689016,
-                0.05429000161378429,    -0.036081453664199105, 0.025434082855374122,   -0.04620330597793104,
-                0.05422841339019883,    -0.04290306983665025,  0.015470499488747022,   0.01635048183559765,
-                -0.03831736454607647,   0.04077841448577397,   -0.023344498615084593,  -0.005026352155495699,
-                0.030392809958491737,   -0.040466143530873036, 0.030392809958491737,   -0.005026352155495699,
-                -0.023344498615084593,  0.04077841448577397,   -0.03831736454607647,   0.01635048183559765,
-                0.015470499488747022,   -0.04290306983665025,  0.05422841339019883,    -0.04620330597793104,
-                0.025434082855374122,   -0.016085926404084235, 0.034224809993309374,   -0.04931818185098251,
-                0.05358757353029842,    -0.04290306983665025,  0.019243518181438157,   0.009699043537804111,
-                -0.03352769397781691,   0.04340564707727172,   -0.035740035642216395,  0.013745665494121932,
-                0.013745665494121932,   -0.035740035642216395, 0.04340564707727172,    -0.03352769397781691,
-                0.009699043537804111,   0.019243518181438157,  -0.04290306983665025,   0.05358757353029842,
-                -0.04931818185098251,   0.034224809993309374,  -0.016085926404084235,  0.008862913783126458,
-                -0.021629654376535128,  0.036719137340761,     -0.04931818185098251,   0.05422841339019883,
-                -0.04802382253689016,   0.030661955327869358,  -0.005891591825620426,  -0.0197377113768079,
-                0.03892975414086468,    -0.04603399829904926,  0.03892975414086468,    -0.0197377113768079,
-                -0.005891591825620426,  0.030661955327869358,  -0.04802382253689016,   0.05422841339019883,
-                -0.04931818185098251,   0.036719137340761,     -0.021629654376535128,  0.008862913783126458,
-                -0.004021481601021059,  0.011090297826270456,  -0.021629654376535128,  0.034224809993309374,
-                -0.04620330597793104,   0.05429000161378429,   -0.05555803139913008,   0.048371155590866,
-                -0.03300307057717762,   0.011719682319270088,  0.011719682319270088,   -0.03300307057717762,
-                0.048371155590866,      -0.05555803139913008,  0.05429000161378429,    -0.04620330597793104,
-                0.034224809993309374,   -0.021629654376535128, 0.011090297826270456,   -0.004021481601021059,
-                0.0013047409207377007,  -0.004021481601021059, 0.008862913783126458,   -0.016085926404084235,
-                0.025434082855374122,   -0.036081453664199105, 0.04673097595438579,    -0.05585419940279951,
-                0.06201472972293868,    -0.0641913437305869,   0.06201472972293868,    -0.05585419940279951,
-                0.04673097595438579,    -0.036081453664199105, 0.025434082855374122,   -0.016085926404084235,
-                0.008862913783126458,   -0.004021481601021059, 0.0013047409207377007};
-    }
-
-    case 19: {
-        return {0.0009781092487714952,
-                -0.003093053026594175,
-                0.006990647531748283,
-                -0.013008922575277776,
-                0.02109119662282997,
-                -0.030692199334093572,
-                0.04080650850415323,
-                -0.05012608406688618,
-                0.05729417138265093,
-                -0.061193306306744036,
-                0.061193306306744036,
-                -0.05729417138265093,
-                0.05012608406688618,
-                -0.04080650850415323,
-                0.030692199334093572,
-                -0.02109119662282997,
-                0.013008922575277776,
-                -0.006990647531748283,
-                0.003093053026594175,
-                -0.0009781092487714952,
-                -0.003093053026594175,
-                0.008802983238943456,
-                -0.017731819057911682,
-                0.029026546394551208,
-                -0.0406649609673957,
-                0.049858425816548785,
-                -0.05378327012504151,
-                0.05042181574222642,
-                -0.03924277692885753,
-                0.021494154143078578,
-                0.0,
-                -0.021494154143078578,
-                0.03924277692885753,
-                -0.05042181574222642,
-                0.05378327012504151,
-                -0.049858425816548785,
-                0.0406649609673957,
-                -0.029026546394551208,
-                0.017731819057911682,
-                -0.008802983238943456,
-                0.003093053026594175,
-                0.006990647531748283,
-                -0.017731819057911682,
-                0.03137880211599364,
-                -0.04418178582513785,
-                0.051494935958408344,
-                -0.04954988389892809,
-                0.0370708562062046,
-                -0.01608303714920613,
-                -0.00843654133574013,
-                0.02998373599114278,
-                -0.04255038540725863,
-                0.04255038540725863,
-                -0.02998373599114278,
-                0.00843654133574013,
-                0.01608303714920613,
-                -0.0370708562062046,
-                0.04954988389892809,
-                -0.051494935958408344,
-                0.04418178582513785,
-                -0.03137880211599364,
-                0.017731819057911682,
-                -0.006990647531748283,
-                -0.013008922575277776,
-                0.029026546394551208,
-                -0.04418178582513785,
-                0.05149613017856412,
-                -0.046035027743741574,
-                0.027600934800827343,
-                -0.0013388419947011469,
-                -0.024024660654037577,
-                0.03955899720567498,
-                -0.039704162396234255,
-                0.024566476469003094,
-                0.0,
-                -0.024566476469003094,
-                0.039704162396234255,
-                -0.03955899720567498,
-                0.024024660654037577,
-                0.0013388419947011469,
-                -0.027600934800827343,
-                0.046035027743741574,
-                -0.05149613017856412,
-                0.04418178582513785,
-                -0.029026546394551208,
-                0.013008922575277776,
-                0.02109119662282997,
-                -0.0406649609673957,
-                0.051494935958408344,
-                -0.046035027743741574,
-                0.02434698967887965,
-                0.005375166079517332,
-                -0.03063579431833898,
-                0.0406443852512516,
-                -0.03145989219716722,
-                0.007841020770864357,
-                0.018972728173296805,
-                -0.03643797312453839,
-                0.03643797312453839,
-                -0.018972728173296805,
-                -0.007841020770864357,
-                0.03145989219716722,
-                -0.0406443852512516,
-                0.03063579431833898,
-                -0.005375166079517332,
-                -0.02434698967887965,
-                0.046035027743741574,
-                -0.051494935958408344,
-                0.0406649609673957,
-                -0.02109119662282997,
-                -0.030692199334093572,
-                0.049858425816548785,
-                -0.04954988389892809,
-                0.027600934800827343,
-                0.005375166079517332,
-                -0.032383346749867065,
-                0.03988161386986895,
-                -0.025118902367438783,
-                -0.00280425778002324,
-                0.02823703319891857,
-                -0.03746432342742005,
-                0.025841654858101932,
-                0.0,
-                -0.025841654858101932,
-                0.03746432342742005,
-                -0.02823703319891857,
-                0.00280425778002324,
-                0.025118902367438783,
-                -0.03988161386986895,
-                0.032383346749867065,
-                -0.005375166079517332,
-                -0.027600934800827343,
-                0.04954988389892809,
-                -0.049858425816548785,
-                0.030692199334093572,
-                0.04080650850415323,
-                -0.05378327012504151,
-                0.0370708562062046,
-                -0.0013388419947011469,
-                -0.03063579431833898,
-                0.03988161386986895,
-                -0.02286660811317144,
-                -0.007712611381153141,
-                0.031966223431724,
-                -0.03522086909726457,
-                0.01634369757191148,
-                0.012368705514061258,
-                -0.03305675596537063,
-                0.03305675596537063,
-                -0.012368705514061258,
-                -0.01634369757191148,
-                0.03522086909726457,
-                -0.031966223431724,
-                0.007712611381153141,
-                0.02286660811317144,
-                -0.03988161386986895,
-                0.03063579431833898,
-                0.0013388419947011469,
-                -0.0370708562062046,
-                0.05378327012504151,
-                -0.04080650850415323,
-                -0.05012608406688618,
-                0.05042181574222642,
-                -0.01608303714920613,
-                -0.024024660654037577,
-                0.0406443852512516,
-                -0.025118902367438783,
-                -0.007712611381153141,
-                0.03291205445190572,
-                -0.033410066604699445,
-                0.010415206791433478,
-                0.019126771796468624,
-                -0.03484488030230979,
-                0.026445404772296507,
-                0.0,
-                -0.026445404772296507,
-                0.03484488030230979,
-                -0.019126771796468624,
-                -0.010415206791433478,
-                0.033410066604699445,
-                -0.03291205445190572,
-                0.007712611381153141,
-                0.025118902367438783,
-                -0.0406443852512516,
-                0.024024660654037577,
-                0.01608303714920613,
-                -0.05042181574222642,
-                0.05012608406688618,
-                0.05729417138265093,
-                -0.03924277692885753,
-                -0.00843654133574013,
-                0.03955899720567498,
-                -0.03145989219716722,
-                -0.00280425778002324,
-                0.031966223431724,
-                -0.033410066604699445,
-                0.008444400031351116,
-                0.022002051290244063,
-                -0.034750964925543824,
-                0.02113073952454542,
-                0.007965547602659603,
-                -0.030873276923766086,
-                0.030873276923766086,
-                -0.007965547602659603,
-                -0.02113073952454542,
-                0.034750964925543824,
-                -0.022002051290244063,
-                -0.008444400031351116,
-                0.033410066604699445,
-                -0.031966223431724,
-                0.00280425778002324,
-                0.03145989219716722,
-                -0.03955899720567498,
-                0.00843654133574013,
-                0.03924277692885753,
-                -0.05729417138265093,
-                -0.061193306306744036,
-                0.021494154143078578,
-                0.02998373599114278,
-                -0.039704162396234255,
-                0.007841020770864357,
-                0.02823703319891857,
-                -0.03522086909726457,
-                0.010415206791433478,
-                0.022002051290244063,
-                -0.03454635817925582,
-                0.018315510393441824,
-                0.012246340338193544,
-                -0.03244702397283322,
-                0.026737042114053314,
-                0.0,
-                -0.026737042114053314,
-                0.03244702397283322,
-                -0.012246340338193544,
-                -0.018315510393441824,
-                0.03454635817925582,
-                -0.022002051290244063,
-                -0.010415206791433478,
-                0.03522086909726457,
-                -0.02823703319891857,
-                -0.007841020770864357,
-                0.039704162396234255,
-                -0.02998373599114278,
-                -0.021494154143078578,
-                0.061193306306744036,
-                0.061193306306744036,
-                0.0,
-                -0.04255038540725863,
-                0.024566476469003094,
-                0.018972728173296805,
-                -0.03746432342742005,
-                0.01634369757191148,
-                0.019126771796468624,
-                -0.034750964925543824,
-                0.018315510393441824,
-                0.013580539530349125,
-                -0.03285684871811529,
-                0.023903471607724002,
-                0.0049106807640345715,
-                -0.0293730052794804,
-                0.0293730052794804,
-                -0.0049106807640345715,
-                -0.023903471607724002,
-                0.03285684871811529,
-                -0.013580539530349125,
-                -0.018315510393441824,
-                0.034750964925543824,
-                -0.019126771796468624,
-                -0.01634369757191148,
-                0.03746432342742005,
-                -0.018972728173296805,
-                -0.024566476469003094,
-                0.04255038540725863,
-                0.0,
-                -0.061193306306744036,
-                -0.05729417138265093,
-                -0.021494154143078578,
-                0.04255038540725863,
-                0.0,
-                -0.03643797312453839,
-                0.025841654858101932,
-                0.012368705514061258,
-                -0.03484488030230979,
-                0.02113073952454542,
-                0.012246340338193544,
-                -0.03285684871811529,
-                0.02291521511158467,
-                0.007218643147079756,
-                -0.030451862889781918,
-                0.026871990188271102,
-                0.0,
-                -0.026871990188271102,
-                0.030451862889781918,
-                -0.007218643147079756,
-                -0.02291521511158467,
-                0.03285684871811529,
-                -0.012246340338193544,
-                -0.02113073952454542,
-                0.03484488030230979,
-                -0.012368705514061258,
-                -0.025841654858101932,
-                0.03643797312453839,
-                0.0,
-                -0.04255038540725863,
-                0.021494154143078578,
-                0.05729417138265093,
-                0.05012608406688618,
-                0.03924277692885753,
-                -0.02998373599114278,
-                -0.024566476469003094,
-                0.03643797312453839,
-                0.0,
-                -0.03305675596537063,
-                0.026445404772296507,
-                0.007965547602659603,
-                -0.03244702397283322,
-                0.023903471607724002,
-                0.007218643147079756,
-                -0.030732840689712552,
-                0.025518818999417985,
-                0.0027790350664043846,
-                -0.028325564752211194,
-                0.028325564752211194,
-                -0.0027790350664043846,
-                -0.025518818999417985,
-                0.030732840689712552,
-                -0.007218643147079756,
-                -0.023903471607724002,
-                0.03244702397283322,
-                -0.007965547602659603,
-                -0.026445404772296507,
-                0.03305675596537063,
-                0.0,
-                -0.03643797312453839,
-                0.024566476469003094,
-                0.02998373599114278,
-                -0.03924277692885753,
-                -0.05012608406688618,
-                -0.04080650850415323,
-                -0.05042181574222642,
-                0.00843654133574013,
-                0.039704162396234255,
-                -0.018972728173296805,
-                -0.025841654858101932,
-                0.03305675596537063,
-                0.0,
-                -0.030873276923766086,
-                0.026737042114053314,
-                0.0049106807640345715,
-                -0.030451862889781918,
-                0.025518818999417985,
-                0.003674944906347653,
-                -0.02890674305960421,
-                0.026927815721455334,
-                0.0,
-                -0.026927815721455334,
-                0.02890674305960421,
-                -0.003674944906347653,
-                -0.025518818999417985,
-                0.030451862889781918,
-                -0.0049106807640345715,
-                -0.026737042114053314,
-                0.030873276923766086,
-                0.0,
-                -0.03305675596537063,
-                0.025841654858101932,
-                0.018972728173296805,
-                -0.039704162396234255,
-                -0.00843654133574013,
-                0.05042181574222642,
-                0.04080650850415323,
-                0.030692199334093572,
-                0.05378327012504151,
-                0.01608303714920613,
-                -0.03955899720567498,
-                -0.007841020770864357,
-                0.03746432342742005,
-                -0.012368705514061258,
-                -0.026445404772296507,
-                0.030873276923766086,
-                0.0,
-                -0.0293730052794804,
-                0.026871990188271102,
-                0.0027790350664043846,
-                -0.02890674305960421,
-                0.02644519177705076,
-                0.0013325812847546463,
-                -0.027611564425412446,
-                0.027611564425412446,
-                -0.0013325812847546463,
-                -0.02644519177705076,
-                0.02890674305960421,
-                -0.0027790350664043846,
-                -0.026871990188271102,
-                0.0293730052794804,
-                0.0,
-                -0.030873276923766086,
-                0.026445404772296507,
-                0.012368705514061258,
-                -0.03746432342742005,
-                0.007841020770864357,
-                0.03955899720567498,
-                -0.01608303714920613,
-                -0.05378327012504151,
-                -0.030692199334093572,
-                -0.02109119662282997,
-                -0.049858425816548785,
-                -0.0370708562062046,
-                0.024024660654037577,
-                0.03145989219716722,
-                -0.02823703319891857,
-                -0.01634369757191148,
-                0.03484488030230979,
-                -0.007965547602659603,
-                -0.026737042114053314,
-                0.0293730052794804,
-                0.0,
-                -0.028325564752211194,
-                0.026927815721455334,
-                0.0013325812847546463,
-                -0.027814288899023414,
-                0.02694612773698313,
-                0.0,
-                -0.02694612773698313,
-                0.027814288899023414,
-                -0.0013325812847546463,
-                -0.026927815721455334,
-                0.028325564752211194,
-                0.0,
-                -0.0293730052794804,
-                0.026737042114053314,
-                0.007965547602659603,
-                -0.03484488030230979,
-                0.01634369757191148,
-                0.02823703319891857,
-                -0.03145989219716722,
-                -0.024024660654037577,
-                0.0370708562062046,
-                0.049858425816548785,
-                0.02109119662282997,
-                0.013008922575277776,
-                0.0406649609673957,
-                0.04954988389892809,
-                0.0013388419947011469,
-                -0.0406443852512516,
-                0.00280425778002324,
-                0.03522086909726457,
-                -0.019126771796468624,
-                -0.02113073952454542,
-                0.03244702397283322,
-                -0.0049106807640345715,
-                -0.026871990188271102,
-                0.028325564752211194,
-                0.0,
-                -0.027611564425412446,
-                0.02694612773698313,
-                0.00043234645957031215,
-                -0.02716490909036265,
-                0.02716490909036265,
-                -0.00043234645957031215,
-                -0.02694612773698313,
-                0.027611564425412446,
-                0.0,
-                -0.028325564752211194,
-                0.026871990188271102,
-                0.0049106807640345715,
-                -0.03244702397283322,
-                0.02113073952454542,
-                0.019126771796468624,
-                -0.03522086909726457,
-                -0.00280425778002324,
-                0.0406443852512516,
-                -0.0013388419947011469,
-                -0.04954988389892809,
-                -0.0406649609673957,
-                -0.013008922575277776,
-                -0.006990647531748283,
-                -0.029026546394551208,
-                -0.051494935958408344,
-                -0.027600934800827343,
-                0.03063579431833898,
-                0.025118902367438783,
-                -0.031966223431724,
-                -0.010415206791433478,
-                0.034750964925543824,
-                -0.012246340338193544,
-                -0.023903471607724002,
-                0.030451862889781918,
-                -0.0027790350664043846,
-                -0.026927815721455334,
-                0.027611564425412446,
-                0.0,
-                -0.02716490909036265,
-                0.02694959597988279,
-                0.0,
-                -0.02694959597988279,
-                0.02716490909036265,
-                0.0,
-                -0.027611564425412446,
-                0.026927815721455334,
-                0.0027790350664043846,
-                -0.030451862889781918,
-                0.023903471607724002,
-                0.012246340338193544,
-                -0.034750964925543824,
-                0.010415206791433478,
-                0.031966223431724,
-                -0.025118902367438783,
-                -0.03063579431833898,
-                0.027600934800827343,
-                0.051494935958408344,
-                0.029026546394551208,
-                0.006990647531748283,
-                0.003093053026594175,
-                0.017731819057911682,
-                0.04418178582513785,
-                0.046035027743741574,
-                -0.005375166079517332,
-                -0.03988161386986895,
-                0.007712611381153141,
-                0.033410066604699445,
-                -0.022002051290244063,
-                -0.018315510393441824,
-                0.03285684871811529,
-                -0.007218643147079756,
-                -0.025518818999417985,
-                0.02890674305960421,
-                -0.0013325812847546463,
-                -0.02694612773698313,
-                0.02716490909036265,
-                0.0,
-                -0.02694959597988279,
-                0.02694959597988279,
-                0.0,
-                -0.02716490909036265,
-                0.02694612773698313,
-                0.0013325812847546463,
-                -0.02890674305960421,
-                0.025518818999417985,
-                0.007218643147079756,
-                -0.03285684871811529,
-                0.018315510393441824,
-                0.022002051290244063,
-                -0.033410066604699445,
-                -0.007712611381153141,
-                0.03988161386986895,
-                0.005375166079517332,
-                -0.046035027743741574,
-                -0.04418178582513785,
-                -0.017731819057911682,
-                -0.003093053026594175,
-                -0.0009781092487714952,
-                -0.008802983238943456,
-                -0.03137880211599364,
-                -0.05149613017856412,
-                -0.02434698967887965,
-                0.032383346749867065,
-                0.02286660811317144,
-                -0.03291205445190572,
-                -0.008444400031351116,
-                0.03454635817925582,
-                -0.013580539530349125,
-                -0.02291521511158467,
-                0.030732840689712552,
-                -0.003674944906347653,
-                -0.02644519177705076,
-                0.027814288899023414,
-                -0.00043234645957031215,
-                -0.02694959597988279,
-                0.02694959597988279,
-                0.0,
-                -0.02694959597988279,
-                0.02694959597988279,
-                0.00043234645957031215,
-                -0.027814288899023414,
-                0.02644519177705076,
-                0.003674944906347653,
-                -0.030732840689712552,
-                0.02291521511158467,
-                0.013580539530349125,
-                -0.03454635817925582,
-                0.008444400031351116,
-                0.03291205445190572,
-                -0.02286660811317144,
-                -0.032383346749867065,
-                0.02434698967887965,
-                0.05149613017856412,
-                0.03137880211599364,
-                0.008802983238943456,
-                0.0009781092487714952,
-                0.003093053026594175,
-                0.017731819057911682,
-                0.04418178582513785,
-                0.046035027743741574,
-                -0.005375166079517332,
-                -0.03988161386986895,
-                0.007712611381153141,
-                0.033410066604699445,
-                -0.022002051290244063,
-                -0.018315510393441824,
-                0.03285684871811529,
-                -0.007218643147079756,
-                -0.025518818999417985,
-                0.02890674305960421,
-                -0.0013325812847546463,
-                -0.02694612773698313,
-                0.02716490909036265,
-                0.0,
-                -0.02694959597988279,
-                0.02694959597988279,
-                0.0,
-                -0.02716490909036265,
-                0.02694612773698313,
-                0.0013325812847546463,
-                -0.02890674305960421,
-                0.025518818999417985,
-                0.007218643147079756,
-                -0.03285684871811529,
-                0.018315510393441824,
-                0.022002051290244063,
-                -0.033410066604699445,
-                -0.007712611381153141,
-                0.03988161386986895,
-                0.005375166079517332,
-                -0.046035027743741574,
-                -0.04418178582513785,
-                -0.017731819057911682,
-                -0.003093053026594175,
-                -0.006990647531748283,
-                -0.029026546394551208,
-                -0.051494935958408344,
-                -0.027600934800827343,
-                0.03063579431833898,
-                0.025118902367438783,
-                -0.031966223431724,
-                -0.010415206791433478,
-                0.034750964925543824,
-                -0.012246340338193544,
-                -0.023903471607724002,
-                0.030451862889781918,
-                -0.0027790350664043846,
-                -0.026927815721455334,
-                0.027611564425412446,
-                0.0,
-                -0.02716490909036265,
-                0.02694959597988279,
-                0.0,
-                -0.02694959597988279,
-                0.02716490909036265,
-                0.0,
-                -0.027611564425412446,
-                0.026927815721455334,
-                0.0027790350664043846,
-                -0.030451862889781918,
-                0.023903471607724002,
-                0.012246340338193544,
-                -0.034750964925543824,
-                0.010415206791433478,
-                0.031966223431724,
-                -0.025118902367438783,
-                -0.03063579431833898,
-                0.027600934800827343,
-                0.051494935958408344,
-                0.029026546394551208,
-                0.006990647531748283,
-                0.013008922575277776,
-                0.0406649609673957,
-                0.04954988389892809,
-                0.0013388419947011469,
-                -0.0406443852512516,
-                0.00280425778002324,
-                0.03522086909726457,
-                -0.019126771796468624,
-                -0.02113073952454542,
-                0.03244702397283322,
-                -0.0049106807640345715,
-                -0.026871990188271102,
-                0.028325564752211194,
-                0.0,
-                -0.027611564425412446,
-                0.02694612773698313,
-                0.00043234645957031215,
-                -0.02716490909036265,
-                0.02716490909036265,
-                -0.00043234645957031215,
-                -0.02694612773698313,
-                0.027611564425412446,
-                0.0,
-                -0.028325564752211194,
-                0.026871990188271102,
-                0.0049106807640345715,
-                -0.03244702397283322,
-                0.02113073952454542,
-                0.019126771796468624,
-                -0.03522086909726457,
-                -0.00280425778002324,
-                0.0406443852512516,
-                -0.0013388419947011469,
-                -0.04954988389892809,
-                -0.0406649609673957,
-                -0.013008922575277776,
-                -0.02109119662282997,
-                -0.049858425816548785,
-                -0.0370708562062046,
-                0.024024660654037577,
-                0.03145989219716722,
-                -0.02823703319891857,
-                -0.01634369757191148,
-                0.03484488030230979,
-                -0.007965547602659603,
-                -0.026737042114053314,
-                0.0293730052794804,
-                0.0,
-                -0.028325564752211194,
-                0.026927815721455334,
-                0.0013325812847546463,
-                -0.027814288899023414,
-                0.02694612773698313,
-                0.0,
-                -0.02694612773698313,
-                0.027814288899023414,
-                -0.0013325812847546463,
-                -0.026927815721455334,
-                0.028325564752211194,
-                0.0,
-                -0.0293730052794804,
-                0.026737042114053314,
-                0.007965547602659603,
-                -0.03484488030230979,
-                0.01634369757191148,
-                0.02823703319891857,
-                -0.03145989219716722,
-                -0.024024660654037577,
-                0.0370708562062046,
-                0.049858425816548785,
-                0.02109119662282997,
-                0.030692199334093572,
-                0.05378327012504151,
-                0.01608303714920613,
-                -0.03955899720567498,
-                -0.007841020770864357,
-                0.03746432342742005,
-                -0.012368705514061258,
-                -0.026445404772296507,
-                0.030873276923766086,
-                0.0,
-                -0.0293730052794804,
-                0.026871990188271102,
-                0.0027790350664043846,
-                -0.02890674305960421,
-                0.02644519177705076,
-                0.0013325812847546463,
-                -0.027611564425412446,
-                0.027611564425412446,
-                -0.0013325812847546463,
-                -0.02644519177705076,
-                0.02890674305960421,
-                -0.0027790350664043846,
-                -0.026871990188271102,
-                0.0293730052794804,
-                0.0,
-                -0.030873276923766086,
-                0.026445404772296507,
-                0.012368705514061258,
-                -0.03746432342742005,
-                0.007841020770864357,
-                0.03955899720567498,
-                -0.01608303714920613,
-                -0.05378327012504151,
-                -0.030692199334093572,
-                -0.04080650850415323,
-                -0.05042181574222642,
-                0.00843654133574013,
-                0.039704162396234255,
-                -0.018972728173296805,
-                -0.025841654858101932,
-                0.03305675596537063,
-                0.0,
-                -0.030873276923766086,
-                0.026737042114053314,
-                0.0049106807640345715,
-                -0.030451862889781918,
-                0.025518818999417985,
-                0.003674944906347653,
-                -0.02890674305960421,
-                0.026927815721455334,
-                0.0,
-                -0.026927815721455334,
-                0.02890674305960421,
-                -0.003674944906347653,
-                -0.025518818999417985,
-                0.030451862889781918,
-                -0.0049106807640345715,
-                -0.026737042114053314,
-                0.030873276923766086,
-                0.0,
-                -0.03305675596537063,
-                0.025841654858101932,
-                0.018972728173296805,
-                -0.039704162396234255,
-                -0.00843654133574013,
-                0.05042181574222642,
-                0.04080650850415323,
-                0.05012608406688618,
-                0.03924277692885753,
-                -0.02998373599114278,
-                -0.024566476469003094,
-                0.03643797312453839,
-                0.0,
-                -0.03305675596537063,
-                0.026445404772296507,
-                0.007965547602659603,
-                -0.03244702397283322,
-                0.023903471607724002,
-                0.007218643147079756,
-                -0.030732840689712552,
-                0.025518818999417985,
-                0.0027790350664043846,
-                -0.028325564752211194,
-                0.028325564752211194,
-                -0.0027790350664043846,
-                -0.025518818999417985,
-                0.030732840689712552,
-                -0.007218643147079756,
-                -0.023903471607724002,
-                0.03244702397283322,
-                -0.007965547602659603,
-                -0.026445404772296507,
-                0.03305675596537063,
-                0.0,
-                -0.03643797312453839,
-                0.024566476469003094,
-                0.02998373599114278,
-                -0.03924277692885753,
-                -0.05012608406688618,
-                -0.05729417138265093,
-                -0.021494154143078578,
-                0.04255038540725863,
-                0.0,
-                -0.03643797312453839,
-                0.025841654858101932,
-                0.012368705514061258,
-                -0.03484488030230979,
-                0.02113073952454542,
-                0.012246340338193544,
-                -0.03285684871811529,
-                0.02291521511158467,
-                0.007218643147079756,
-                -0.030451862889781918,
-                0.026871990188271102,
-                0.0,
-                -0.026871990188271102,
-                0.030451862889781918,
-                -0.007218643147079756,
-                -0.02291521511158467,
-                0.03285684871811529,
-                -0.012246340338193544,
-                -0.02113073952454542,
-                0.03484488030230979,
-                -0.012368705514061258,
-                -0.025841654858101932,
-                0.03643797312453839,
-                0.0,
-                -0.04255038540725863,
-                0.021494154143078578,
-                0.05729417138265093,
-                0.061193306306744036,
-                0.0,
-                -0.04255038540725863,
-                0.024566476469003094,
-                0.018972728173296805,
-                -0.03746432342742005,
-                0.01634369757191148,
-                0.019126771796468624,
-                -0.034750964925543824,
-                0.018315510393441824,
-                0.013580539530349125,
-                -0.03285684871811529,
-                0.023903471607724002,
-                0.0049106807640345715,
-                -0.0293730052794804,
-                0.0293730052794804,
-                -0.0049106807640345715,
-                -0.023903471607724002,
-                0.03285684871811529,
-                -0.013580539530349125,
-                -0.018315510393441824,
-                0.034750964925543824,
-                -0.019126771796468624,
-                -0.01634369757191148,
-                0.03746432342742005,
-                -0.018972728173296805,
-                -0.024566476469003094,
-                0.04255038540725863,
-                0.0,
-                -0.061193306306744036,
-                -0.061193306306744036,
-                0.021494154143078578,
-                0.02998373599114278,
-                -0.039704162396234255,
-                0.007841020770864357,
-                0.02823703319891857,
-                -0.03522086909726457,
-                0.010415206791433478,
-                0.022002051290244063,
-                -0.03454635817925582,
-                0.018315510393441824,
-                0.012246340338193544,
-                -0.03244702397283322,
-                0.026737042114053314,
-                0.0,
-                -0.026737042114053314,
-                0.03244702397283322,
-                -0.012246340338193544,
-                -0.018315510393441824,
-                0.03454635817925582,
-                -0.022002051290244063,
-                -0.010415206791433478,
-                0.03522086909726457,
-                -0.02823703319891857,
-                -0.007841020770864357,
-                0.039704162396234255,
-                -0.02998373599114278,
-                -0.021494154143078578,
-                0.061193306306744036,
-                0.05729417138265093,
-                -0.03924277692885753,
-                -0.00843654133574013,
-                0.03955899720567498,
-                -0.03145989219716722,
-                -0.00280425778002324,
-                0.031966223431724,
-                -0.033410066604699445,
-                0.008444400031351116,
-                0.022002051290244063,
-                -0.034750964925543824,
-                0.02113073952454542,
-                0.007965547602659603,
-                -0.030873276923766086,
-                0.030873276923766086,
-                -0.007965547602659603,
-                -0.02113073952454542,
-                0.034750964925543824,
-                -0.022002051290244063,
-                -0.008444400031351116,
-                0.033410066604699445,
-                -0.031966223431724,
-                0.00280425778002324,
-                0.03145989219716722,
-                -0.03955899720567498,
-                0.00843654133574013,
-                0.03924277692885753,
-                -0.05729417138265093,
-                -0.05012608406688618,
-                0.05042181574222642,
-                -0.01608303714920613,
-                -0.024024660654037577,
-                0.0406443852512516,
-                -0.025118902367438783,
-                -0.007712611381153141,
-                0.03291205445190572,
-                -0.033410066604699445,
-                0.010415206791433478,
-                0.019126771796468624,
-                -0.03484488030230979,
-                0.026445404772296507,
-                0.0,
-                -0.026445404772296507,
-                0.03484488030230979,
-                -0.019126771796468624,
-                -0.010415206791433478,
-                0.033410066604699445,
-                -0.03291205445190572,
-                0.007712611381153141,
-                0.025118902367438783,
-                -0.0406443852512516,
-                0.024024660654037577,
-                0.01608303714920613,
-                -0.05042181574222642,
-                0.05012608406688618,
-                0.04080650850415323,
-                -0.05378327012504151,
-                0.0370708562062046,
-                -0.0013388419947011469,
-                -0.03063579431833898,
-                0.03988161386986895,
-                -0.02286660811317144,
-                -0.007712611381153141,
-                0.031966223431724,
-                -0.03522086909726457,
-                0.01634369757191148,
-                0.012368705514061258,
-                -0.03305675596537063,
-                0.03305675596537063,
-                -0.012368705514061258,
-                -0.01634369757191148,
-                0.03522086909726457,
-                -0.031966223431724,
-                0.007712611381153141,
-                0.02286660811317144,
-                -0.03988161386986895,
-                0.03063579431833898,
-                0.0013388419947011469,
-                -0.0370708562062046,
-                0.05378327012504151,
-                -0.04080650850415323,
-                -0.030692199334093572,
-                0.049858425816548785,
-                -0.04954988389892809,
-                0.027600934800827343,
-                0.005375166079517332,
-                -0.032383346749867065,
-                0.03988161386986895,
-                -0.025118902367438783,
-                -0.00280425778002324,
-                0.02823703319891857,
-                -0.03746432342742005,
-                0.025841654858101932,
-                0.0,
-                -0.025841654858101932,
-                0.03746432342742005,
-                -0.02823703319891857,
-                0.00280425778002324,
-                0.025118902367438783,
-                -0.03988161386986895,
-                0.032383346749867065,
-                -0.005375166079517332,
-                -0.027600934800827343,
-                0.04954988389892809,
-                -0.049858425816548785,
-                0.030692199334093572,
-                0.02109119662282997,
-                -0.0406649609673957,
-                0.051494935958408344,
-                -0.046035027743741574,
-                0.02434698967887965,
-                0.005375166079517332,
-                -0.03063579431833898,
-                0.0406443852512516,
-                -0.03145989219716722,
-                0.007841020770864357,
-                0.018972728173296805,
-                -0.03643797312453839,
-                0.03643797312453839,
-                -0.018972728173296805,
-                -0.007841020770864357,
-                0.03145989219716722,
-                -0.0406443852512516,
-                0.03063579431833898,
-                -0.005375166079517332,
-                -0.02434698967887965,
-                0.046035027743741574,
-                -0.051494935958408344,
-                0.0406649609673957,
-                -0.02109119662282997,
-                -0.013008922575277776,
-                0.029026546394551208,
-                -0.04418178582513785,
-                0.05149613017856412,
-                -0.046035027743741574,
-                0.027600934800827343,
-                -0.0013388419947011469,
-                -0.024024660654037577,
-                0.03955899720567498,
-                -0.039704162396234255,
-                0.024566476469003094,
-                0.0,
-                -0.024566476469003094,
-                0.039704162396234255,
-                -0.03955899720567498,
-                0.024024660654037577,
-                0.0013388419947011469,
-                -0.027600934800827343,
-                0.046035027743741574,
-                -0.05149613017856412,
-                0.04418178582513785,
-                -0.029026546394551208,
-                0.013008922575277776,
-                0.006990647531748283,
-                -0.017731819057911682,
-                0.03137880211599364,
-                -0.04418178582513785,
-                0.051494935958408344,
-                -0.04954988389892809,
-                0.0370708562062046,
-                -0.01608303714920613,
-                -0.00843654133574013,
-                0.02998373599114278,
-                -0.04255038540725863,
-                0.04255038540725863,
-                -0.02998373599114278,
-                0.00843654133574013,
-                0.01608303714920613,
-                -0.0370708562062046,
-                0.04954988389892809,
-                -0.051494935958408344,
-                0.04418178582513785,
-                -0.03137880211599364,
-                0.017731819057911682,
-                -0.006990647531748283,
-                -0.003093053026594175,
-                0.008802983238943456,
-                -0.017731819057911682,
-                0.029026546394551208,
-                -0.0406649609673957,
-                0.049858425816548785,
-                -0.05378327012504151,
-                0.05042181574222642,
-                -0.03924277692885753,
-                0.021494154143078578,
-                0.0,
-                -0.021494154143078578,
-                0.03924277692885753,
-                -0.05042181574222642,
-                0.05378327012504151,
-                -0.049858425816548785,
-                0.0406649609673957,
-                -0.029026546394551208,
-                0.017731819057911682,
-                -0.008802983238943456,
-                0.003093053026594175,
-                0.0009781092487714952,
-                -0.003093053026594175,
-                0.006990647531748283,
-                -0.013008922575277776,
-                0.02109119662282997,
-                -0.030692199334093572,
-                0.04080650850415323,
-                -0.05012608406688618,
-                0.05729417138265093,
-                -0.061193306306744036,
-                0.061193306306744036,
-                -0.05729417138265093,
-                0.05012608406688618,
-                -0.04080650850415323,
-                0.030692199334093572,
-                -0.02109119662282997,
-                0.013008922575277776,
-                -0.006990647531748283,
-                0.003093053026594175,
-                -0.0009781092487714952};
+        const std::complex<float> s12 = source[term.m1_index] * source[term.m2_index];
+        const std::complex<float>& s3 = source[term.m3_index];
+        result += term.coefficient * (s12.real() * s3.real() - s12.imag() * s3.imag());
     }
+    return result;
+}
 
-    case 20: {
-        return {
-            0.0007342271125681172,  -0.0023791677651473432, 0.005507644580631185,   -0.010495754201812346,
-            0.017426608529437587,   -0.025978054192733392,  0.03540212038711747,    -0.04461559569939831,
-            0.05238843492903513,    -0.05758757653750022,   0.059416207210648615,   -0.05758757653750022,
-            0.05238843492903513,    -0.04461559569939831,   0.03540212038711747,    -0.025978054192733392,
-            0.017426608529437587,   -0.010495754201812346,  0.005507644580631185,   -0.0023791677651473432,
-            0.0007342271125681172,  -0.0023791677651473432, 0.006975157569397114,   -0.014481938107885934,
-            0.024468353148246223,   -0.035467138110187785,  0.045182401235578366,   -0.05101988560537101,
-            0.05079709028063259,    -0.043416492681398716,  0.029286025434036734,   -0.010343034077007743,
-            -0.010343034077007743,  0.029286025434036734,   -0.043416492681398716,  0.05079709028063259,
-            -0.05101988560537101,   0.045182401235578366,   -0.035467138110187785,  0.024468353148246223,
-            -0.014481938107885934,  0.006975157569397114,   -0.0023791677651473432, 0.005507644580631185,
-            -0.014481938107885934,  0.02662985258275902,    -0.03913510349250114,   0.048006184232305564,
-            -0.049457654564265555,  0.04140086207487967,    -0.024464622414979025,  0.0021239330439393926,
-            0.020161388171516914,   -0.03653709520858106,   0.04254882974255448,    -0.03653709520858106,
-            0.020161388171516914,   0.0021239330439393926,  -0.024464622414979025,  0.04140086207487967,
-            -0.049457654564265555,  0.048006184232305564,   -0.03913510349250114,   0.02662985258275902,
-            -0.014481938107885934,  0.005507644580631185,   -0.010495754201812346,  0.024468353148246223,
-            -0.03913510349250114,   0.048487228933825274,   -0.047334079710196104,  0.03392724527115009,
-            -0.011196594598243893,  -0.013993429710596266,  0.033301127788507884,   -0.04008835708335762,
-            0.03204111379717317,    -0.01217644265628854,   -0.01217644265628854,   0.03204111379717317,
-            -0.04008835708335762,   0.033301127788507884,   -0.013993429710596266,  -0.011196594598243893,
-            0.03392724527115009,    -0.047334079710196104,  0.048487228933825274,   -0.03913510349250114,
-            0.024468353148246223,   -0.010495754201812346,  0.017426608529437587,   -0.035467138110187785,
-            0.048006184232305564,   -0.047334079710196104,  0.03125120930479639,    -0.004816138116954908,
-            -0.021687144131695292,  0.03743250465851851,    -0.03605732040518568,   0.018621698533530052,
-            0.006812522305094141,   -0.028748781148966444,  0.03734299854965229,    -0.028748781148966444,
-            0.006812522305094141,   0.018621698533530052,   -0.03605732040518568,   0.03743250465851851,
-            -0.021687144131695292,  -0.004816138116954908,  0.03125120930479639,    -0.047334079710196104,
-            0.048006184232305564,   -0.035467138110187785,  0.017426608529437587,   -0.025978054192733392,
-            0.045182401235578366,   -0.049457654564265555,  0.03392724527115009,    -0.004816138116954908,
-            -0.023894436812027072,  0.03825071407679321,    -0.031831607683290866,  0.008952915068337971,
-            0.017849714336153292,   -0.03446566146260097,   0.032436743055838185,   -0.013130000808752056,
-            -0.013130000808752056,  0.032436743055838185,   -0.03446566146260097,   0.017849714336153292,
-            0.008952915068337971,   -0.031831607683290866,  0.03825071407679321,    -0.023894436812027072,
-            -0.004816138116954908,  0.03392724527115009,    -0.049457654564265555,  0.045182401235578366,
-            -0.025978054192733392,  0.03540212038711747,    -0.05101988560537101,   0.04140086207487967,
-            -0.011196594598243893,  -0.021687144131695292,  0.03825071407679321,    -0.030200241805829343,
-            0.00418838607586827,    0.023119786308483888,   -0.03536465665737663,   0.0258799825904089,
-            -0.0009988365357561043, -0.024140094468019603,  0.03457289864304533,    -0.024140094468019603,
-            -0.0009988365357561043, 0.0258799825904089,     -0.03536465665737663,   0.023119786308483888,
-            0.00418838607586827,    -0.030200241805829343,  0.03825071407679321,    -0.021687144131695292,
-            -0.011196594598243893,  0.04140086207487967,    -0.05101988560537101,   0.03540212038711747,
-            -0.04461559569939831,   0.05079709028063259,    -0.024464622414979025,  -0.013993429710596266,
-            0.03743250465851851,    -0.031831607683290866,  0.00418838607586827,    0.024636296223062636,
-            -0.035050862259149565,  0.02120977870646221,    0.006476139177256272,   -0.02917931194865307,
-            0.032109531259110265,   -0.013716660068143025,  -0.013716660068143025,  0.032109531259110265,
-            -0.02917931194865307,   0.006476139177256272,   0.02120977870646221,    -0.035050862259149565,
-            0.024636296223062636,   0.00418838607586827,    -0.031831607683290866,  0.03743250465851851,
-            -0.013993429710596266,  -0.024464622414979025,  0.05079709028063259,    -0.04461559569939831,
-            0.05238843492903513,    -0.043416492681398716,  0.0021239330439393926,  0.033301127788507884,
-            -0.03605732040518568,   0.008952915068337971,   0.023119786308483888,   -0.035050862259149565,
-            0.019573792649607,      0.009921045374039305,   -0.03109331855343597,   0.02903410079514328,
-            -0.006022720117838283,  -0.021031934071634412,  0.032826328257795995,   -0.021031934071634412,
-            -0.006022720117838283,  0.02903410079514328,    -0.03109331855343597,   0.009921045374039305,
-            0.019573792649607,      -0.035050862259149565,  0.023119786308483888,   0.008952915068337971,
-            -0.03605732040518568,   0.033301127788507884,   0.0021239330439393926,  -0.043416492681398716,
-            0.05238843492903513,    -0.05758757653750022,   0.029286025434036734,   0.020161388171516914,
-            -0.04008835708335762,   0.018621698533530052,   0.017849714336153292,   -0.03536465665737663,
-            0.02120977870646221,    0.009921045374039305,   -0.03155459316887729,   0.02716623941683059,
-            -0.0015272549226460431, -0.024747036986531457,  0.031557283383081336,   -0.014104453155305192,
-            -0.014104453155305192,  0.031557283383081336,   -0.024747036986531457,  -0.0015272549226460431,
-            0.02716623941683059,    -0.03155459316887729,   0.009921045374039305,   0.02120977870646221,
-            -0.03536465665737663,   0.017849714336153292,   0.018621698533530052,   -0.04008835708335762,
-            0.020161388171516914,   0.029286025434036734,   -0.05758757653750022,   0.059416207210648615,
-            -0.010343034077007743,  -0.03653709520858106,   0.03204111379717317,    0.006812522305094141,
-            -0.03446566146260097,   0.0258799825904089,     0.006476139177256272,   -0.03109331855343597,
-            0.02716623941683059,    -6.624096460212324e-05, -0.026255424209331992,  0.030216608042805994,
-            -0.009387415455545348,  -0.018825359050076502,  0.03164008962427204,    -0.018825359050076502,
-            -0.009387415455545348,  0.030216608042805994,   -0.026255424209331992,  -6.624096460212324e-05,
-            0.02716623941683059,    -0.03109331855343597,   0.006476139177256272,   0.0258799825904089,
-            -0.03446566146260097,   0.006812522305094141,   0.03204111379717317,    -0.03653709520858106,
-            -0.010343034077007743,  0.059416207210648615,   -0.05758757653750022,   -0.010343034077007743,
-            0.04254882974255448,    -0.01217644265628854,   -0.028748781148966444,  0.032436743055838185,
-            -0.0009988365357561043, -0.02917931194865307,   0.02903410079514328,    -0.0015272549226460431,
-            -0.026255424209331992,  0.02968635422595281,    -0.007045695965290556,  -0.02122055311920687,
-            0.030979239330514604,   -0.014369269283190541,  -0.014369269283190541,  0.030979239330514604,
-            -0.02122055311920687,   -0.007045695965290556,  0.02968635422595281,    -0.026255424209331992,
-            -0.0015272549226460431, 0.02903410079514328,    -0.02917931194865307,   -0.0009988365357561043,
-            0.032436743055838185,   -0.028748781148966444,  -0.01217644265628854,   0.04254882974255448,
-            -0.010343034077007743,  -0.05758757653750022,   0.05238843492903513,    0.029286025434036734,
-            -0.03653709520858106,   -0.01217644265628854,   0.03734299854965229,    -0.013130000808752056,
-            -0.024140094468019603,  0.032109531259110265,   -0.006022720117838283,  -0.024747036986531457,
-            0.030216608042805994,   -0.007045695965290556,  -0.021946034114876792,  0.03046292757574619,
-            -0.011673137937825442,  -0.01723667190041236,   0.030810947429936546,   -0.01723667190041236,
-            -0.011673137937825442,  0.03046292757574619,    -0.021946034114876792,  -0.007045695965290556,
-            0.030216608042805994,   -0.024747036986531457,  -0.006022720117838283,  0.032109531259110265,
-            -0.024140094468019603,  -0.013130000808752056,  0.03734299854965229,    -0.01217644265628854,
-            -0.03653709520858106,   0.029286025434036734,   0.05238843492903513,    -0.04461559569939831,
-            -0.043416492681398716,  0.020161388171516914,   0.03204111379717317,    -0.028748781148966444,
-            -0.013130000808752056,  0.03457289864304533,    -0.013716660068143025,  -0.021031934071634412,
-            0.031557283383081336,   -0.009387415455545348,  -0.02122055311920687,   0.03046292757574619,
-            -0.010776399200789983,  -0.018534154698679004,  0.03046527453909969,    -0.014551094714836526,
-            -0.014551094714836526,  0.03046527453909969,    -0.018534154698679004,  -0.010776399200789983,
-            0.03046292757574619,    -0.02122055311920687,   -0.009387415455545348,  0.031557283383081336,
-            -0.021031934071634412,  -0.013716660068143025,  0.03457289864304533,    -0.013130000808752056,
-            -0.028748781148966444,  0.03204111379717317,    0.020161388171516914,   -0.043416492681398716,
-            -0.04461559569939831,   0.03540212038711747,    0.05079709028063259,    0.0021239330439393926,
-            -0.04008835708335762,   0.006812522305094141,   0.032436743055838185,   -0.024140094468019603,
-            -0.013716660068143025,  0.032826328257795995,   -0.014104453155305192,  -0.018825359050076502,
-            0.030979239330514604,   -0.011673137937825442,  -0.018534154698679004,  0.030313113652035786,
-            -0.013210618634264398,  -0.01611104488636372,   0.03023499108513313,    -0.01611104488636372,
-            -0.013210618634264398,  0.030313113652035786,   -0.018534154698679004,  -0.011673137937825442,
-            0.030979239330514604,   -0.018825359050076502,  -0.014104453155305192,  0.032826328257795995,
-            -0.013716660068143025,  -0.024140094468019603,  0.032436743055838185,   0.006812522305094141,
-            -0.04008835708335762,   0.0021239330439393926,  0.05079709028063259,    0.03540212038711747,
-            -0.025978054192733392,  -0.05101988560537101,   -0.024464622414979025,  0.033301127788507884,
-            0.018621698533530052,   -0.03446566146260097,   -0.0009988365357561043, 0.032109531259110265,
-            -0.021031934071634412,  -0.014104453155305192,  0.03164008962427204,    -0.014369269283190541,
-            -0.01723667190041236,   0.03046527453909969,    -0.013210618634264398,  -0.016603806802589334,
-            0.0300582797989512,     -0.014672765684867526,  -0.014672765684867526,  0.0300582797989512,
-            -0.016603806802589334,  -0.013210618634264398,  0.03046527453909969,    -0.01723667190041236,
-            -0.014369269283190541,  0.03164008962427204,    -0.014104453155305192,  -0.021031934071634412,
-            0.032109531259110265,   -0.0009988365357561043, -0.03446566146260097,   0.018621698533530052,
-            0.033301127788507884,   -0.024464622414979025,  -0.05101988560537101,   -0.025978054192733392,
-            0.017426608529437587,   0.045182401235578366,   0.04140086207487967,    -0.013993429710596266,
-            -0.03605732040518568,   0.017849714336153292,   0.0258799825904089,     -0.02917931194865307,
-            -0.006022720117838283,  0.031557283383081336,   -0.018825359050076502,  -0.014369269283190541,
-            0.030810947429936546,   -0.014551094714836526,  -0.01611104488636372,   0.0300582797989512,
-            -0.014196764518339759,  -0.01535810437054133,   0.029854661591954577,   -0.01535810437054133,
-            -0.014196764518339759,  0.0300582797989512,     -0.01611104488636372,   -0.014551094714836526,
-            0.030810947429936546,   -0.014369269283190541,  -0.018825359050076502,  0.031557283383081336,
-            -0.006022720117838283,  -0.02917931194865307,   0.0258799825904089,     0.017849714336153292,
-            -0.03605732040518568,   -0.013993429710596266,  0.04140086207487967,    0.045182401235578366,
-            0.017426608529437587,   -0.010495754201812346,  -0.035467138110187785,  -0.049457654564265555,
-            -0.011196594598243893,  0.03743250465851851,    0.008952915068337971,   -0.03536465665737663,
-            0.006476139177256272,   0.02903410079514328,    -0.024747036986531457,  -0.009387415455545348,
-            0.030979239330514604,   -0.01723667190041236,   -0.014551094714836526,  0.03023499108513313,
-            -0.014672765684867526,  -0.01535810437054133,   0.029779086652332254,   -0.01474769331688136,
-            -0.01474769331688136,   0.029779086652332254,   -0.01535810437054133,   -0.014672765684867526,
-            0.03023499108513313,    -0.014551094714836526,  -0.01723667190041236,   0.030979239330514604,
-            -0.009387415455545348,  -0.024747036986531457,  0.02903410079514328,    0.006476139177256272,
-            -0.03536465665737663,   0.008952915068337971,   0.03743250465851851,    -0.011196594598243893,
-            -0.049457654564265555,  -0.035467138110187785,  -0.010495754201812346,  0.005507644580631185,
-            0.024468353148246223,   0.048006184232305564,   0.03392724527115009,    -0.021687144131695292,
-            -0.031831607683290866,  0.023119786308483888,   0.02120977870646221,    -0.03109331855343597,
-            -0.0015272549226460431, 0.030216608042805994,   -0.02122055311920687,   -0.011673137937825442,
-            0.03046527453909969,    -0.01611104488636372,   -0.014672765684867526,  0.029854661591954577,
-            -0.01474769331688136,   -0.014924910412451557,  0.029637533898749846,   -0.014924910412451557,
-            -0.01474769331688136,   0.029854661591954577,   -0.014672765684867526,  -0.01611104488636372,
-            0.03046527453909969,    -0.011673137937825442,  -0.02122055311920687,   0.030216608042805994,
-            -0.0015272549226460431, -0.03109331855343597,   0.02120977870646221,    0.023119786308483888,
-            -0.031831607683290866,  -0.021687144131695292,  0.03392724527115009,    0.048006184232305564,
-            0.024468353148246223,   0.005507644580631185,   -0.0023791677651473432, -0.014481938107885934,
-            -0.03913510349250114,   -0.047334079710196104,  -0.004816138116954908,  0.03825071407679321,
-            0.00418838607586827,    -0.035050862259149565,  0.009921045374039305,   0.02716623941683059,
-            -0.026255424209331992,  -0.007045695965290556,  0.03046292757574619,    -0.018534154698679004,
-            -0.013210618634264398,  0.0300582797989512,     -0.01535810437054133,   -0.01474769331688136,
-            0.029637533898749846,   -0.014783442067309836,  -0.014783442067309836,  0.029637533898749846,
-            -0.01474769331688136,   -0.01535810437054133,   0.0300582797989512,     -0.013210618634264398,
-            -0.018534154698679004,  0.03046292757574619,    -0.007045695965290556,  -0.026255424209331992,
-            0.02716623941683059,    0.009921045374039305,   -0.035050862259149565,  0.00418838607586827,
-            0.03825071407679321,    -0.004816138116954908,  -0.047334079710196104,  -0.03913510349250114,
-            -0.014481938107885934,  -0.0023791677651473432, 0.0007342271125681172,  0.006975157569397114,
-            0.02662985258275902,    0.048487228933825274,   0.03125120930479639,    -0.023894436812027072,
-            -0.030200241805829343,  0.024636296223062636,   0.019573792649607,      -0.03155459316887729,
-            -6.624096460212324e-05, 0.02968635422595281,    -0.021946034114876792,  -0.010776399200789983,
-            0.030313113652035786,   -0.016603806802589334,  -0.014196764518339759,  0.029779086652332254,
-            -0.014924910412451557,  -0.014783442067309836,  0.02956688413461967,    -0.014783442067309836,
-            -0.014924910412451557,  0.029779086652332254,   -0.014196764518339759,  -0.016603806802589334,
-            0.030313113652035786,   -0.010776399200789983,  -0.021946034114876792,  0.02968635422595281,
-            -6.624096460212324e-05, -0.03155459316887729,   0.019573792649607,      0.024636296223062636,
-            -0.030200241805829343,  -0.023894436812027072,  0.03125120930479639,    0.048487228933825274,
-            0.02662985258275902,    0.006975157569397114,   0.0007342271125681172,  -0.0023791677651473432,
-            -0.014481938107885934,  -0.03913510349250114,   -0.047334079710196104,  -0.004816138116954908,
-            0.03825071407679321,    0.00418838607586827,    -0.035050862259149565,  0.009921045374039305,
-            0.02716623941683059,    -0.026255424209331992,  -0.007045695965290556,  0.03046292757574619,
-            -0.018534154698679004,  -0.013210618634264398,  0.0300582797989512,     -0.01535810437054133,
-            -0.01474769331688136,   0.029637533898749846,   -0.014783442067309836,  -0.014783442067309836,
-            0.029637533898749846,   -0.01474769331688136,   -0.01535810437054133,   0.0300582797989512,
-            -0.013210618634264398,  -0.018534154698679004,  0.03046292757574619,    -0.007045695965290556,
-            -0.026255424209331992,  0.02716623941683059,    0.009921045374039305,   -0.035050862259149565,
-            0.00418838607586827,    0.03825071407679321,    -0.004816138116954908,  -0.047334079710196104,
-            -0.03913510349250114,   -0.014481938107885934,  -0.0023791677651473432, 0.005507644580631185,
-            0.024468353148246223,   0.048006184232305564,   0.03392724527115009,    -0.021687144131695292,
-            -0.031831607683290866,  0.023119786308483888,   0.02120977870646221,    -0.03109331855343597,
-            -0.0015272549226460431, 0.030216608042805994,   -0.02122055311920687,   -0.011673137937825442,
-            0.03046527453909969,    -0.01611104488636372,   -0.014672765684867526,  0.029854661591954577,
-            -0.01474769331688136,   -0.014924910412451557,  0.029637533898749846,   -0.014924910412451557,
-            -0.01474769331688136,   0.029854661591954577,   -0.014672765684867526,  -0.01611104488636372,
-            0.03046527453909969,    -0.011673137937825442,  -0.02122055311920687,   0.030216608042805994,
-            -0.0015272549226460431, -0.03109331855343597,   0.02120977870646221,    0.023119786308483888,
-            -0.031831607683290866,  -0.021687144131695292,  0.03392724527115009,    0.048006184232305564,
-            0.024468353148246223,   0.005507644580631185,   -0.010495754201812346,  -0.035467138110187785,
-            -0.049457654564265555,  -0.011196594598243893,  0.03743250465851851,    0.008952915068337971,
-            -0.03536465665737663,   0.006476139177256272,   0.02903410079514328,    -0.024747036986531457,
-            -0.009387415455545348,  0.030979239330514604,   -0.01723667190041236,   -0.014551094714836526,
-            0.03023499108513313,    -0.014672765684867526,  -0.01535810437054133,   0.029779086652332254,
-            -0.01474769331688136,   -0.01474769331688136,   0.029779086652332254,   -0.01535810437054133,
-            -0.014672765684867526,  0.03023499108513313,    -0.014551094714836526,  -0.01723667190041236,
-            0.030979239330514604,   -0.009387415455545348,  -0.024747036986531457,  0.02903410079514328,
-            0.006476139177256272,   -0.03536465665737663,   0.008952915068337971,   0.03743250465851851,
-            -0.011196594598243893,  -0.049457654564265555,  -0.035467138110187785,  -0.010495754201812346,
-            0.017426608529437587,   0.045182401235578366,   0.04140086207487967,    -0.013993429710596266,
-            -0.03605732040518568,   0.017849714336153292,   0.0258799825904089,     -0.02917931194865307,
-            -0.006022720117838283,  0.031557283383081336,   -0.018825359050076502,  -0.014369269283190541,
-            0.030810947429936546,   -0.014551094714836526,  -0.01611104488636372,   0.0300582797989512,
-            -0.014196764518339759,  -0.01535810437054133,   0.029854661591954577,   -0.01535810437054133,
-            -0.014196764518339759,  0.0300582797989512,     -0.01611104488636372,   -0.014551094714836526,
-            0.030810947429936546,   -0.014369269283190541,  -0.018825359050076502,  0.031557283383081336,
-            -0.006022720117838283,  -0.02917931194865307,   0.0258799825904089,     0.017849714336153292,
-            -0.03605732040518568,   -0.013993429710596266,  0.04140086207487967,    0.045182401235578366,
-            0.017426608529437587,   -0.025978054192733392,  -0.05101988560537101,   -0.024464622414979025,
-            0.033301127788507884,   0.018621698533530052,   -0.03446566146260097,   -0.0009988365357561043,
-            0.032109531259110265,   -0.021031934071634412,  -0.014104453155305192,  0.03164008962427204,
-            -0.014369269283190541,  -0.01723667190041236,   0.03046527453909969,    -0.013210618634264398,
-            -0.016603806802589334,  0.0300582797989512,     -0.014672765684867526,  -0.014672765684867526,
-            0.0300582797989512,     -0.016603806802589334,  -0.013210618634264398,  0.03046527453909969,
-            -0.01723667190041236,   -0.014369269283190541,  0.03164008962427204,    -0.014104453155305192,
-            -0.021031934071634412,  0.032109531259110265,   -0.0009988365357561043, -0.03446566146260097,
-            0.018621698533530052,   0.033301127788507884,   -0.024464622414979025,  -0.05101988560537101,
-            -0.025978054192733392,  0.03540212038711747,    0.05079709028063259,    0.0021239330439393926,
-            -0.04008835708335762,   0.006812522305094141,   0.032436743055838185,   -0.024140094468019603,
-            -0.013716660068143025,  0.032826328257795995,   -0.014104453155305192,  -0.018825359050076502,
-            0.030979239330514604,   -0.011673137937825442,  -0.018534154698679004,  0.030313113652035786,
-            -0.013210618634264398,  -0.01611104488636372,   0.03023499108513313,    -0.01611104488636372,
-            -0.013210618634264398,  0.030313113652035786,   -0.018534154698679004,  -0.011673137937825442,
-            0.030979239330514604,   -0.018825359050076502,  -0.014104453155305192,  0.032826328257795995,
-            -0.013716660068143025,  -0.024140094468019603,  0.032436743055838185,   0.006812522305094141,
-            -0.04008835708335762,   0.0021239330439393926,  0.05079709028063259,    0.03540212038711747,
-            -0.04461559569939831,   -0.043416492681398716,  0.020161388171516914,   0.03204111379717317,
-            -0.028748781148966444,  -0.013130000808752056,  0.03457289864304533,    -0.013716660068143025,
-            -0.021031934071634412,  0.031557283383081336,   -0.009387415455545348,  -0.02122055311920687,
-            0.03046292757574619,    -0.010776399200789983,  -0.018534154698679004,  0.03046527453909969,
-            -0.014551094714836526,  -0.014551094714836526,  0.03046527453909969,    -0.018534154698679004,
-            -0.010776399200789983,  0.03046292757574619,    -0.02122055311920687,   -0.009387415455545348,
-            0.031557283383081336,   -0.021031934071634412,  -0.013716660068143025,  0.03457289864304533,
-            -0.013130000808752056,  -0.028748781148966444,  0.03204111379717317,    0.020161388171516914,
-            -0.043416492681398716,  -0.04461559569939831,   0.05238843492903513,    0.029286025434036734,
-            -0.03653709520858106,   -0.01217644265628854,   0.03734299854965229,    -0.013130000808752056,
-            -0.024140094468019603,  0.032109531259110265,   -0.006022720117838283,  -0.024747036986531457,
-            0.030216608042805994,   -0.007045695965290556,  -0.021946034114876792,  0.03046292757574619,
-            -0.011673137937825442,  -0.01723667190041236,   0.030810947429936546,   -0.01723667190041236,
-            -0.011673137937825442,  0.03046292757574619,    -0.021946034114876792,  -0.007045695965290556,
-            0.030216608042805994,   -0.024747036986531457,  -0.006022720117838283,  0.032109531259110265,
-            -0.024140094468019603,  -0.013130000808752056,  0.03734299854965229,    -0.01217644265628854,
-            -0.03653709520858106,   0.029286025434036734,   0.05238843492903513,    -0.05758757653750022,
-            -0.010343034077007743,  0.04254882974255448,    -0.01217644265628854,   -0.028748781148966444,
-            0.032436743055838185,   -0.0009988365357561043, -0.02917931194865307,   0.02903410079514328,
-            -0.0015272549226460431, -0.026255424209331992,  0.02968635422595281,    -0.007045695965290556,
-            -0.02122055311920687,   0.030979239330514604,   -0.014369269283190541,  -0.014369269283190541,
-            0.030979239330514604,   -0.02122055311920687,   -0.007045695965290556,  0.02968635422595281,
-            -0.026255424209331992,  -0.0015272549226460431, 0.02903410079514328,    -0.02917931194865307,
-            -0.0009988365357561043, 0.032436743055838185,   -0.028748781148966444,  -0.01217644265628854,
-            0.04254882974255448,    -0.010343034077007743,  -0.05758757653750022,   0.059416207210648615,
-            -0.010343034077007743,  -0.03653709520858106,   0.03204111379717317,    0.006812522305094141,
-            -0.03446566146260097,   0.0258799825904089,     0.006476139177256272,   -0.03109331855343597,
-            0.02716623941683059,    -6.624096460212324e-05, -0.026255424209331992,  0.030216608042805994,
-            -0.009387415455545348,  -0.018825359050076502,  0.03164008962427204,    -0.018825359050076502,
-            -0.009387415455545348,  0.030216608042805994,   -0.026255424209331992,  -6.624096460212324e-05,
-            0.02716623941683059,    -0.03109331855343597,   0.006476139177256272,   0.0258799825904089,
-            -0.03446566146260097,   0.006812522305094141,   0.03204111379717317,    -0.03653709520858106,
-            -0.010343034077007743,  0.059416207210648615,   -0.05758757653750022,   0.029286025434036734,
-            0.020161388171516914,   -0.04008835708335762,   0.018621698533530052,   0.017849714336153292,
-            -0.03536465665737663,   0.02120977870646221,    0.009921045374039305,   -0.03155459316887729,
-            0.02716623941683059,    -0.0015272549226460431, -0.024747036986531457,  0.031557283383081336,
-            -0.014104453155305192,  -0.014104453155305192,  0.031557283383081336,   -0.024747036986531457,
-            -0.0015272549226460431, 0.02716623941683059,    -0.03155459316887729,   0.009921045374039305,
-            0.02120977870646221,    -0.03536465665737663,   0.017849714336153292,   0.018621698533530052,
-            -0.04008835708335762,   0.020161388171516914,   0.029286025434036734,   -0.05758757653750022,
-            0.05238843492903513,    -0.043416492681398716,  0.0021239330439393926,  0.033301127788507884,
-            -0.03605732040518568,   0.008952915068337971,   0.023119786308483888,   -0.035050862259149565,
-            0.019573792649607,      0.009921045374039305,   -0.03109331855343597,   0.02903410079514328,
-            -0.006022720117838283,  -0.021031934071634412,  0.032826328257795995,   -0.021031934071634412,
-            -0.006022720117838283,  0.02903410079514328,    -0.03109331855343597,   0.009921045374039305,
-            0.019573792649607,      -0.035050862259149565,  0.023119786308483888,   0.008952915068337971,
-            -0.03605732040518568,   0.033301127788507884,   0.0021239330439393926,  -0.043416492681398716,
-            0.05238843492903513,    -0.04461559569939831,   0.05079709028063259,    -0.024464622414979025,
-            -0.013993429710596266,  0.03743250465851851,    -0.031831607683290866,  0.00418838607586827,
-            0.024636296223062636,   -0.035050862259149565,  0.02120977870646221,    0.006476139177256272,
-            -0.02917931194865307,   0.032109531259110265,   -0.013716660068143025,  -0.013716660068143025,
-            0.032109531259110265,   -0.02917931194865307,   0.006476139177256272,   0.02120977870646221,
-            -0.035050862259149565,  0.024636296223062636,   0.00418838607586827,    -0.031831607683290866,
-            0.03743250465851851,    -0.013993429710596266,  -0.024464622414979025,  0.05079709028063259,
-            -0.04461559569939831,   0.03540212038711747,    -0.05101988560537101,   0.04140086207487967,
-            -0.011196594598243893,  -0.021687144131695292,  0.03825071407679321,    -0.030200241805829343,
-            0.00418838607586827,    0.023119786308483888,   -0.03536465665737663,   0.0258799825904089,
-            -0.0009988365357561043, -0.024140094468019603,  0.03457289864304533,    -0.024140094468019603,
-            -0.0009988365357561043, 0.0258799825904089,     -0.03536465665737663,   0.023119786308483888,
-            0.00418838607586827,    -0.030200241805829343,  0.03825071407679321,    -0.021687144131695292,
-            -0.011196594598243893,  0.04140086207487967,    -0.05101988560537101,   0.03540212038711747,
-            -0.025978054192733392,  0.045182401235578366,   -0.049457654564265555,  0.03392724527115009,
-            -0.004816138116954908,  -0.023894436812027072,  0.03825071407679321,    -0.031831607683290866,
-            0.008952915068337971,   0.017849714336153292,   -0.03446566146260097,   0.032436743055838185,
-            -0.013130000808752056,  -0.013130000808752056,  0.032436743055838185,   -0.03446566146260097,
-            0.017849714336153292,   0.008952915068337971,   -0.031831607683290866,  0.03825071407679321,
-            -0.023894436812027072,  -0.004816138116954908,  0.03392724527115009,    -0.049457654564265555,
-            0.045182401235578366,   -0.025978054192733392,  0.017426608529437587,   -0.035467138110187785,
-            0.048006184232305564,   -0.047334079710196104,  0.03125120930479639,    -0.004816138116954908,
-            -0.021687144131695292,  0.03743250465851851,    -0.03605732040518568,   0.018621698533530052,
-            0.006812522305094141,   -0.028748781148966444,  0.03734299854965229,    -0.028748781148966444,
-            0.006812522305094141,   0.018621698533530052,   -0.03605732040518568,   0.03743250465851851,
-            -0.021687144131695292,  -0.004816138116954908,  0.03125120930479639,    -0.047334079710196104,
-            0.048006184232305564,   -0.035467138110187785,  0.017426608529437587,   -0.010495754201812346,
-            0.024468353148246223,   -0.03913510349250114,   0.048487228933825274,   -0.047334079710196104,
-            0.03392724527115009,    -0.011196594598243893,  -0.013993429710596266,  0.033301127788507884,
-            -0.04008835708335762,   0.03204111379717317,    -0.01217644265628854,   -0.01217644265628854,
-            0.03204111379717317,    -0.04008835708335762,   0.033301127788507884,   -0.013993429710596266,
-            -0.011196594598243893,  0.03392724527115009,    -0.047334079710196104,  0.048487228933825274,
-            -0.03913510349250114,   0.024468353148246223,   -0.010495754201812346,  0.005507644580631185,
-            -0.014481938107885934,  0.02662985258275902,    -0.03913510349250114,   0.048006184232305564,
-            -0.049457654564265555,  0.04140086207487967,    -0.024464622414979025,  0.0021239330439393926,
-            0.020161388171516914,   -0.03653709520858106,   0.04254882974255448,    -0.03653709520858106,
-            0.020161388171516914,   0.0021239330439393926,  -0.024464622414979025,  0.04140086207487967,
-            -0.049457654564265555,  0.048006184232305564,   -0.03913510349250114,   0.02662985258275902,
-            -0.014481938107885934,  0.005507644580631185,   -0.0023791677651473432, 0.006975157569397114,
-            -0.014481938107885934,  0.024468353148246223,   -0.035467138110187785,  0.045182401235578366,
-            -0.05101988560537101,   0.05079709028063259,    -0.043416492681398716,  0.029286025434036734,
-            -0.010343034077007743,  -0.010343034077007743,  0.029286025434036734,   -0.043416492681398716,
-            0.05079709028063259,    -0.05101988560537101,   0.045182401235578366,   -0.035467138110187785,
-            0.024468353148246223,   -0.014481938107885934,  0.006975157569397114,   -0.0023791677651473432,
-            0.0007342271125681172,  -0.0023791677651473432, 0.005507644580631185,   -0.010495754201812346,
-            0.017426608529437587,   -0.025978054192733392,  0.03540212038711747,    -0.04461559569939831,
-            0.05238843492903513,    -0.05758757653750022,   0.059416207210648615,   -0.05758757653750022,
-            0.05238843492903513,    -0.04461559569939831,   0.03540212038711747,    -0.025978054192733392,
-            0.017426608529437587,   -0.010495754201812346,  0.005507644580631185,   -0.0023791677651473432,
-            0.0007342271125681172};
-    }
+const double* getWigner3j(unsigned int l)
+{
+    if (l >= 21)
+    {
+        throw std::out_of_range("Wigner 3j coefficients are implemented for l <= 20.");
     }
-    throw std::out_of_range("Wigner 3j coefficients are implemented for l <= 20.");
+    return &WIGNER3J_TABLE[WIGNER3J_OFFSETS[l]];
 }
 
 }; }; // end namespace freud::order
@@ -17,12 +17,35 @@ namespace freud { namespace order {
 //  [0, 1, ..., l, -1, -2, ..., -l]
 int lmIndex(int l, int m);
 
+//! One term of the wl third-order invariant.
+/*! The (m1, m2, m3) triple of a Wigner 3j coefficient is resolved into the
+ *  three source-array indices it reads from, so reductions over many
+ *  particles can stream the table with multiply-adds instead of recomputing
+ *  the m-index arithmetic per particle.
+ */
+struct Wigner3jTerm
+{
+    unsigned int m1_index;
+    unsigned int m2_index;
+    unsigned int m3_index;
+    float coefficient;
+};
+
+//! Get the flat term table for a given l.
+//  The tables for all l are built once on first use and cached for the life
+//  of the program; the returned reference stays valid.
+const std::vector<Wigner3jTerm>& getWigner3jTerms(unsigned int l);
+
 //! Reduce an array using Wigner 3j coefficients to construct a
 //  third-order rotational invariant quantity.
-//  source array must be indexed by m, like [0, 1, ..., l, -1, -2, ..., -l].
-float reduceWigner3j(const std::complex<float>* source, unsigned int l_, const std::vector<double>& wigner3j);
+//  source array must be indexed by m, like [0, 1, ..., l, -1, -2, ..., -l];
+//  terms is the table returned by getWigner3jTerms for the same l.
+float reduceWigner3j(const std::complex<float>* source, const std::vector<Wigner3jTerm>& terms);
 
-std::vector<double> getWigner3j(unsigned int l);
+//! Get a pointer to the 3*l*l + 3*l + 1 coefficients for a given l.
+//  The coefficients live in a compile-time table, so no allocation or
+//  copying occurs; the pointer remains valid for the life of the program.
+const double* getWigner3j(unsigned int l);
 // All Wigner 3j coefficients created using sympy
 /*
 
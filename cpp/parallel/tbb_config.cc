@@ -5,6 +5,9 @@
 
 #include <thread>
 
+#include "ManagedArray.h"
+#include "utils.h"
+
 /*! \file tbb_config.cc
     \brief Helper functions to configure tbb
 */
@@ -32,4 +35,31 @@ void setNumThreads(unsigned int N)
         = std::make_unique<tbb::global_control>(tbb::global_control::parameter::max_allowed_parallelism, N);
 }
 
+/*! \param grain Grain size to use for all parallel loops
+
+    You do not need to call setLoopGrainSize. The default of \a grain=0
+    selects the adaptive per-call-site policy of util::forLoopWrapper, which
+    tunes each loop's grain from its measured per-iteration cost. A nonzero
+    value bypasses the adaptation and is used directly by every loop.
+*/
+void setLoopGrainSize(unsigned int grain)
+{
+    util::forLoopGrainOverride() = grain;
+}
+
+/*! \param bytes Minimum allocation size backed by huge pages
+
+    You do not need to call setHugePageThreshold. The default of \a bytes=0
+    keeps every allocation on regular pages. A nonzero value makes array
+    buffers of at least that size (2 MB, the x86-64 huge page size, is a
+    sensible choice) anonymous mappings advised with MADV_HUGEPAGE, which
+    substantially reduces TLB misses for scattered writes into multi-GB
+    histograms and neighbor lists. Platforms without the interfaces, and
+    allocations the kernel declines to map, silently fall back to the heap.
+*/
+void setHugePageThreshold(size_t bytes)
+{
+    util::hugePageThresholdBytes() = bytes;
+}
+
 }; }; // end namespace freud::parallel
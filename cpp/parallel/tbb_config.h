@@ -16,6 +16,12 @@ namespace freud { namespace parallel {
 //! Set the number of TBB threads
 void setNumThreads(unsigned int N);
 
+//! Override the adaptive grain size of freud's parallel loops
+void setLoopGrainSize(unsigned int grain);
+
+//! Back large array allocations with huge pages
+void setHugePageThreshold(size_t bytes);
+
 }; }; // end namespace freud::parallel
 
 #endif // TBB_CONFIG_H
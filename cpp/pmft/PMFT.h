@@ -30,7 +30,15 @@ class PMFT : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    PMFT() : BondHistogramCompute() {}
+    /*! \param sparse If true, thread-local histogram storage is paged on
+     *      first touch instead of dense (see BondHistogramCompute).
+     *  \param async_reduce If true, each frame's thread-local counts are
+     *      drained in the background while the next frame accumulates (see
+     *      BondHistogramCompute).
+     */
+    explicit PMFT(bool sparse = false, bool async_reduce = false)
+        : BondHistogramCompute(sparse, async_reduce)
+    {}
 
     //! Destructor
     ~PMFT() override = default;
@@ -1,9 +1,11 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
 #include <stdexcept>
 
 #include "PMFTR12.h"
+#include "fastmath.h"
 #include "utils.h"
 
 /*! \file PMFTR12.cc
@@ -12,7 +14,10 @@
 
 namespace freud { namespace pmft {
 
-PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2) : PMFT()
+PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2, bool fast_math,
+                 bool sparse, bool async_reduce)
+    : PMFT(sparse, async_reduce), m_fast_math(fast_math), m_n_t1(n_t1), m_n_t2(n_t2),
+      m_inv_dt1(float(n_t1) / constants::TWO_PI), m_inv_dt2(float(n_t2) / constants::TWO_PI)
 {
     if (n_r < 1)
     {
@@ -32,12 +37,14 @@ PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int
     }
 
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
+    // The radial axis is kept around for the direct binning of the fast-math path.
+    m_r_axis = std::make_shared<util::RegularAxis>(n_r, 0, r_max);
     BHAxes axes;
-    axes.push_back(std::make_shared<util::RegularAxis>(n_r, 0, r_max));
+    axes.push_back(m_r_axis);
     axes.push_back(std::make_shared<util::RegularAxis>(n_t1, 0, constants::TWO_PI));
     axes.push_back(std::make_shared<util::RegularAxis>(n_t2, 0, constants::TWO_PI));
     m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, m_sparse);
 
     // Note: There is an additional implicit volume factor of 2*pi
     // corresponding to the rotational degree of freedom of the second particle
@@ -81,6 +88,34 @@ void PMFTR12::accumulate(const locality::NeighborQuery* neighbor_query, const fl
                          freud::locality::QueryArgs qargs)
 {
     neighbor_query->getBox().enforce2D();
+
+    if (m_fast_math)
+    {
+        accumulateGeneral(
+            neighbor_query, query_points, n_query_points, nlist, qargs,
+            [=](const freud::locality::NeighborBond& neighbor_bond) {
+                vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                // the two bond angles differ by exactly pi, so one
+                // polynomial arctangent evaluation serves both.
+                const float d_theta1 = util::fastAtan2(delta.y, delta.x);
+                const float d_theta2
+                    = (d_theta1 > 0) ? d_theta1 - float(M_PI) : d_theta1 + float(M_PI);
+                const size_t bin_r = m_r_axis->bin(neighbor_bond.distance);
+                if (bin_r == util::Axis::OVERFLOW_BIN)
+                {
+                    return;
+                }
+                // fold the 2*pi wrap of the angles into the bin indices
+                // instead of wrapping the floats.
+                const size_t bin_t1 = util::foldedAngularBin(
+                    orientations[neighbor_bond.point_idx] - d_theta1, m_inv_dt1, m_n_t1);
+                const size_t bin_t2 = util::foldedAngularBin(
+                    query_orientations[neighbor_bond.query_point_idx] - d_theta2, m_inv_dt2, m_n_t2);
+                m_local_histograms.increment((bin_r * m_n_t1 + bin_t1) * m_n_t2 + bin_t2);
+            });
+        return;
+    }
+
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
                       [=](const freud::locality::NeighborBond& neighbor_bond) {
                           vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
@@ -16,7 +16,20 @@ class PMFTR12 : public PMFT
 {
 public:
     //! Constructor
-    PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2);
+    /*! \param fast_math If true, bin the bond angles with a polynomial
+     *                   approximation of atan2 (accurate to ~1e-6 radians, a
+     *                   small fraction of a bin width for typical bin counts)
+     *                   and fold the 2*pi wrap of the angular coordinates
+     *                   into integer bin arithmetic, instead of the exact
+     *                   library calls.
+     *  \param sparse If true, thread-local histogram storage is paged on
+     *                first touch instead of dense (see BondHistogramCompute).
+     *  \param async_reduce If true, each frame's counts are drained in the
+     *                background while the next frame accumulates (see
+     *                BondHistogramCompute).
+     */
+    PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2, bool fast_math = false,
+            bool sparse = false, bool async_reduce = false);
 
     /*! Compute the PCF for the passed in set of points. The function will be added to previous values
         of the PCF
@@ -26,12 +39,24 @@ public:
                     unsigned int n_query_points, const locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    //!< Whether bond angles are binned with polynomial approximations
+    bool isFastMath() const
+    {
+        return m_fast_math;
+    }
+
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     void reduce() override;
 
     util::ManagedArray<float> m_inv_jacobian_array; //!< Array of inverse jacobians for each bin
+    bool m_fast_math;                               //!< Whether to bin with approximate trig (default false).
+    std::shared_ptr<util::RegularAxis> m_r_axis;    //!< The radial axis, used for direct binning.
+    size_t m_n_t1;                                  //!< Number of bins in T1.
+    size_t m_n_t2;                                  //!< Number of bins in T2.
+    float m_inv_dt1;                                //!< Inverse T1 bin width.
+    float m_inv_dt2;                                //!< Inverse T2 bin width.
 };
 
 }; }; // end namespace freud::pmft
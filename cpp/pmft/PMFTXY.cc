@@ -11,7 +11,9 @@
 
 namespace freud { namespace pmft {
 
-PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y) : PMFT()
+PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y, bool sparse,
+               bool async_reduce)
+    : PMFT(sparse, async_reduce)
 {
     if (n_x < 1)
     {
@@ -47,7 +49,7 @@ PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y) : P
     axes.push_back(std::make_shared<util::RegularAxis>(n_x, -x_max, x_max));
     axes.push_back(std::make_shared<util::RegularAxis>(n_y, -y_max, y_max));
     m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, m_sparse);
 }
 
 void PMFTXY::reduce()
@@ -16,7 +16,15 @@ class PMFTXY : public PMFT
 {
 public:
     //! Constructor
-    PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y);
+    /*! \param sparse If true, thread-local histogram storage is paged on
+     *                first touch instead of dense, making very fine binnings
+     *                feasible at high thread counts (see BondHistogramCompute).
+     *  \param async_reduce If true, each frame's counts are drained in the
+     *                background while the next frame accumulates (see
+     *                BondHistogramCompute).
+     */
+    PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y, bool sparse = false,
+           bool async_reduce = false);
 
     /*! Compute the PCF for the passed in set of points. The result will
      *  be added to previous values of the PCF.
@@ -1,9 +1,12 @@
 // Copyright (c) 2010-2020 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
 #include <stdexcept>
+#include <vector>
 
 #include "PMFTXYT.h"
+#include "fastmath.h"
 #include "utils.h"
 
 /*! \file PMFTXYT.cc
@@ -12,7 +15,10 @@
 
 namespace freud { namespace pmft {
 
-PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, unsigned int n_t) : PMFT()
+PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, unsigned int n_t,
+                 bool fast_math, bool sparse, bool async_reduce)
+    : PMFT(sparse, async_reduce), m_fast_math(fast_math), m_n_y(n_y), m_n_t(n_t),
+      m_inv_dt(float(n_t) / constants::TWO_PI)
 {
     if (n_x < 1)
     {
@@ -49,12 +55,15 @@ PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, u
     m_pcf_array.prepare({n_x, n_y, n_t});
 
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
+    // The spatial axes are kept around for the direct binning of the fast-math path.
+    m_x_axis = std::make_shared<util::RegularAxis>(n_x, -x_max, x_max);
+    m_y_axis = std::make_shared<util::RegularAxis>(n_y, -y_max, y_max);
     BondHistogram::Axes axes;
-    axes.push_back(std::make_shared<util::RegularAxis>(n_x, -x_max, x_max));
-    axes.push_back(std::make_shared<util::RegularAxis>(n_y, -y_max, y_max));
+    axes.push_back(m_x_axis);
+    axes.push_back(m_y_axis);
     axes.push_back(std::make_shared<util::RegularAxis>(n_t, 0, constants::TWO_PI));
     m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, m_sparse);
 }
 
 void PMFTXYT::reduce()
@@ -69,15 +78,53 @@ void PMFTXYT::accumulate(const locality::NeighborQuery* neighbor_query, const fl
                          freud::locality::QueryArgs qargs)
 {
     neighbor_query->getBox().enforce2D();
+
+    // The rotation matrix only depends on the query point, so the per-bond
+    // sine/cosine evaluations are hoisted into one pass over the query
+    // points. The matrices are identical to the ones previously built per
+    // bond, so the binning is unchanged.
+    std::vector<rotmat2<float>> rotation_matrices(n_query_points);
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            rotation_matrices[i] = rotmat2<float>::fromAngle(-query_orientations[i]);
+        }
+    });
+    const rotmat2<float>* rot_mats = rotation_matrices.data();
+
+    if (m_fast_math)
+    {
+        accumulateGeneral(
+            neighbor_query, query_points, n_query_points, nlist, qargs,
+            [=](const freud::locality::NeighborBond& neighbor_bond) {
+                vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+
+                // rotate interparticle vector
+                vec2<float> myVec(delta.x, delta.y);
+                vec2<float> rotVec = rot_mats[neighbor_bond.query_point_idx] * myVec;
+                const size_t bin_x = m_x_axis->bin(rotVec.x);
+                const size_t bin_y = m_y_axis->bin(rotVec.y);
+                if (bin_x == util::Axis::OVERFLOW_BIN || bin_y == util::Axis::OVERFLOW_BIN)
+                {
+                    return;
+                }
+                // calculate angle, folding the 2*pi wrap of the T coordinate
+                // into the bin index instead of wrapping the float.
+                const float d_theta = util::fastAtan2(-delta.y, -delta.x);
+                const size_t bin_t = util::foldedAngularBin(
+                    orientations[neighbor_bond.point_idx] - d_theta, m_inv_dt, m_n_t);
+                m_local_histograms.increment((bin_x * m_n_y + bin_y) * m_n_t + bin_t);
+            });
+        return;
+    }
+
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
                       [=](const freud::locality::NeighborBond& neighbor_bond) {
                           vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
 
                           // rotate interparticle vector
                           vec2<float> myVec(delta.x, delta.y);
-                          rotmat2<float> myMat
-                              = rotmat2<float>::fromAngle(-query_orientations[neighbor_bond.query_point_idx]);
-                          vec2<float> rotVec = myMat * myVec;
+                          vec2<float> rotVec = rot_mats[neighbor_bond.query_point_idx] * myVec;
                           // calculate angle
                           float d_theta = std::atan2(-delta.y, -delta.x);
                           float t = orientations[neighbor_bond.point_idx] - d_theta;
@@ -16,7 +16,20 @@ class PMFTXYT : public PMFT
 {
 public:
     //! Constructor
-    PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, unsigned int n_t);
+    /*! \param fast_math If true, bin the bond angle with a polynomial
+     *                   approximation of atan2 (accurate to ~1e-6 radians, a
+     *                   small fraction of a bin width for typical bin counts)
+     *                   and fold the 2*pi wrap of the T coordinate into
+     *                   integer bin arithmetic, instead of the exact library
+     *                   calls.
+     *  \param sparse If true, thread-local histogram storage is paged on
+     *                first touch instead of dense (see BondHistogramCompute).
+     *  \param async_reduce If true, each frame's counts are drained in the
+     *                background while the next frame accumulates (see
+     *                BondHistogramCompute).
+     */
+    PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, unsigned int n_t,
+            bool fast_math = false, bool sparse = false, bool async_reduce = false);
 
     /*! Compute the PCF for the passed in set of points. The function will be added to previous values
         of the PCF
@@ -26,12 +39,24 @@ public:
                     unsigned int n_query_points, const locality::NeighborList* nlist,
                     freud::locality::QueryArgs qargs);
 
+    //!< Whether the bond angle is binned with a polynomial approximation
+    bool isFastMath() const
+    {
+        return m_fast_math;
+    }
+
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     void reduce() override;
 
     float m_jacobian;
+    bool m_fast_math;                            //!< Whether to bin with approximate trig (default false).
+    std::shared_ptr<util::RegularAxis> m_x_axis; //!< The x axis, used for direct binning.
+    std::shared_ptr<util::RegularAxis> m_y_axis; //!< The y axis, used for direct binning.
+    size_t m_n_y;                                //!< Number of bins in Y.
+    size_t m_n_t;                                //!< Number of bins in T.
+    float m_inv_dt;                              //!< Inverse T bin width.
 };
 
 }; }; // end namespace freud::pmft
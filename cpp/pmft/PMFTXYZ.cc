@@ -2,7 +2,10 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include "PMFTXYZ.h"
+#include <algorithm>
 #include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+#include <vector>
 
 /*! \file PMFTXYZ.cc
     \brief Routines for computing 3D potential of mean force in XYZ coordinates
@@ -10,9 +13,12 @@
 
 namespace freud { namespace pmft {
 
+constexpr size_t PMFTXYZ::m_tile_size;
+
 PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsigned int n_y, unsigned int n_z,
-                 const vec3<float>& shiftvec)
-    : PMFT(), m_shiftvec(shiftvec), m_num_equiv_orientations(0xffffffff)
+                 const vec3<float>& shiftvec, bool tiled, bool sparse, bool async_reduce)
+    : PMFT(sparse, async_reduce), m_shiftvec(shiftvec), m_num_equiv_orientations(0xffffffff),
+      m_tiled(tiled)
 {
     if (n_x < 1)
     {
@@ -70,7 +76,7 @@ PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsign
     axes.push_back(std::make_shared<util::RegularAxis>(n_y, -y_max, y_max));
     axes.push_back(std::make_shared<util::RegularAxis>(n_z, -z_max, z_max));
     m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, m_sparse);
 }
 
 // Almost identical to the parent method, except that the normalization factor
@@ -78,7 +84,6 @@ PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsign
 void PMFTXYZ::reduce()
 {
     m_pcf_array.prepare(m_histogram.shape());
-    m_histogram.prepare(m_histogram.shape());
 
     float inv_num_dens = m_box.getVolume() / (float) m_n_query_points;
     float norm_factor
@@ -86,6 +91,22 @@ void PMFTXYZ::reduce()
     float prefactor = inv_num_dens * norm_factor;
 
     float jacobian_factor = (float) 1.0 / m_jacobian;
+
+    // The tiled accumulation path maintains the master histogram directly, so
+    // there are no thread-local copies to reduce; only the per-bin
+    // normalization remains.
+    if (m_tiled)
+    {
+        util::forLoopWrapper(0, m_histogram.size(), [=](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_pcf_array[i] = static_cast<float>(m_histogram[i]) * prefactor * jacobian_factor;
+            }
+        });
+        return;
+    }
+
+    m_histogram.prepare(m_histogram.shape());
     m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jacobian_factor](size_t i) {
         m_pcf_array[i] = static_cast<float>(m_histogram[i]) * prefactor * jacobian_factor;
     });
@@ -94,6 +115,12 @@ void PMFTXYZ::reduce()
 void PMFTXYZ::reset()
 {
     BondHistogramCompute::reset();
+    // the tiled path accumulates into the master histogram across frames, so
+    // it has to be cleared here as well.
+    if (m_tiled)
+    {
+        m_histogram.reset();
+    }
     m_num_equiv_orientations = 0xffffffff;
 }
 
@@ -114,22 +141,133 @@ void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, const qu
             "The number of equivalent orientations must be constant while accumulating data into PMFTXYZ.");
     }
     neighbor_query->getBox().enforce3D();
+
+    // Precompute the rotation matrix of every equivalent orientation once per
+    // call, stored component-major (structure-of-arrays across k). The
+    // per-bond expansion below then applies the whole symmetry group with
+    // matrix-vector lane loops that the compiler vectorizes across k, instead
+    // of one scalar quaternion rotation per equivalent orientation; only the
+    // per-bond frame rotation (which varies with the query point) remains a
+    // quaternion rotate.
+    const unsigned int n_equiv = num_equiv_orientations;
+    std::vector<float> equiv_rotations(9 * size_t(n_equiv));
+    for (unsigned int k = 0; k < n_equiv; k++)
+    {
+        const quat<float>& q = equiv_orientations[k];
+        const float w = q.s;
+        const float x = q.v.x;
+        const float y = q.v.y;
+        const float z = q.v.z;
+        equiv_rotations[0 * n_equiv + k] = w * w + x * x - y * y - z * z;
+        equiv_rotations[1 * n_equiv + k] = float(2.0) * (x * y - w * z);
+        equiv_rotations[2 * n_equiv + k] = float(2.0) * (x * z + w * y);
+        equiv_rotations[3 * n_equiv + k] = float(2.0) * (x * y + w * z);
+        equiv_rotations[4 * n_equiv + k] = w * w - x * x + y * y - z * z;
+        equiv_rotations[5 * n_equiv + k] = float(2.0) * (y * z - w * x);
+        equiv_rotations[6 * n_equiv + k] = float(2.0) * (x * z - w * y);
+        equiv_rotations[7 * n_equiv + k] = float(2.0) * (y * z + w * x);
+        equiv_rotations[8 * n_equiv + k] = w * w - x * x - y * y + z * z;
+    }
+    const float* const rot = equiv_rotations.data();
+
+    if (m_tiled)
+    {
+        // Tiled accumulation: bonds are first staged as flat bin indices
+        // partitioned into contiguous tiles of the histogram (in parallel),
+        // and each tile is then drained into the shared master histogram by
+        // a single owner task. Every thread only ever touches its own
+        // staging buffers and every bin belongs to exactly one tile, so no
+        // private full-size histogram copies and no atomics are needed.
+        const size_t n_tiles = (m_histogram.size() + m_tile_size - 1) / m_tile_size;
+        tbb::enumerable_thread_specific<std::vector<std::vector<unsigned int>>> tile_buffers(
+            [n_tiles]() { return std::vector<std::vector<unsigned int>>(n_tiles); });
+
+        accumulateGeneral(
+            neighbor_query, query_points, n_query_points, nlist, qargs,
+            [=, &tile_buffers](const freud::locality::NeighborBond& neighbor_bond) {
+                // create the reference point quaternion
+                quat<float> query_orientation(query_orientations[neighbor_bond.query_point_idx]);
+                // make sure that the particles are wrapped into the box
+                vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                // rotate into the query particle's frame once per bond
+                const vec3<float> v0 = rotate(conj(query_orientation), delta);
+
+                auto& buffers = tile_buffers.local();
+                constexpr unsigned int batch_width = 8;
+                float vx[batch_width];
+                float vy[batch_width];
+                float vz[batch_width];
+                for (unsigned int base = 0; base < n_equiv; base += batch_width)
+                {
+                    const unsigned int count = std::min(batch_width, n_equiv - base);
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        const unsigned int k = base + lane;
+                        vx[lane] = rot[0 * n_equiv + k] * v0.x + rot[1 * n_equiv + k] * v0.y
+                            + rot[2 * n_equiv + k] * v0.z;
+                        vy[lane] = rot[3 * n_equiv + k] * v0.x + rot[4 * n_equiv + k] * v0.y
+                            + rot[5 * n_equiv + k] * v0.z;
+                        vz[lane] = rot[6 * n_equiv + k] * v0.x + rot[7 * n_equiv + k] * v0.y
+                            + rot[8 * n_equiv + k] * v0.z;
+                    }
+                    for (unsigned int lane = 0; lane < count; lane++)
+                    {
+                        const size_t bin = m_histogram.bin({vx[lane], vy[lane], vz[lane]});
+                        if (bin != util::Axis::OVERFLOW_BIN)
+                        {
+                            buffers[bin / m_tile_size].push_back(static_cast<unsigned int>(bin));
+                        }
+                    }
+                }
+            });
+
+        // Drain the tiles into the master histogram. Each tile is owned by
+        // exactly one loop index, so the increments never race.
+        util::forLoopWrapper(0, n_tiles, [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t)
+            {
+                for (auto& buffers : tile_buffers)
+                {
+                    for (const unsigned int bin : buffers[t])
+                    {
+                        m_histogram[bin]++;
+                    }
+                }
+            }
+        });
+        return;
+    }
+
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
                       [=](const freud::locality::NeighborBond& neighbor_bond) {
                           // create the reference point quaternion
                           quat<float> query_orientation(query_orientations[neighbor_bond.query_point_idx]);
                           // make sure that the particles are wrapped into the box
                           vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+                          // rotate into the query particle's frame once per bond
+                          const vec3<float> v0 = rotate(conj(query_orientation), delta);
 
-                          for (unsigned int k = 0; k < num_equiv_orientations; k++)
+                          constexpr unsigned int batch_width = 8;
+                          float vx[batch_width];
+                          float vy[batch_width];
+                          float vz[batch_width];
+                          for (unsigned int base = 0; base < n_equiv; base += batch_width)
                           {
-                              // create point vector
-                              vec3<float> v(delta);
-                              // rotate the vector
-                              v = rotate(conj(query_orientation), v);
-                              v = rotate(equiv_orientations[k], v);
-
-                              m_local_histograms(v.x, v.y, v.z);
+                              const unsigned int count = std::min(batch_width, n_equiv - base);
+                              for (unsigned int lane = 0; lane < count; lane++)
+                              {
+                                  const unsigned int k = base + lane;
+                                  vx[lane] = rot[0 * n_equiv + k] * v0.x + rot[1 * n_equiv + k] * v0.y
+                                      + rot[2 * n_equiv + k] * v0.z;
+                                  vy[lane] = rot[3 * n_equiv + k] * v0.x + rot[4 * n_equiv + k] * v0.y
+                                      + rot[5 * n_equiv + k] * v0.z;
+                                  vz[lane] = rot[6 * n_equiv + k] * v0.x + rot[7 * n_equiv + k] * v0.y
+                                      + rot[8 * n_equiv + k] * v0.z;
+                              }
+                              for (unsigned int lane = 0; lane < count; lane++)
+                              {
+                                  m_local_histograms(vx[lane], vy[lane], vz[lane]);
+                              }
                           }
                       });
 }
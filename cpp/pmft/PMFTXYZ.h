@@ -16,8 +16,25 @@ class PMFTXYZ : public PMFT
 {
 public:
     //! Constructor
+    /*! \param tiled If true, accumulate with the tiled path: bonds are staged
+     *               as bin indices partitioned into contiguous tiles of the
+     *               histogram, and each tile is drained into the shared
+     *               histogram by a single owner task. This avoids the
+     *               thread-count x histogram-size memory cost of the default
+     *               thread-local histograms, which dominates at high
+     *               resolutions (e.g. 250^3 bins). The counts are identical
+     *               to the default path.
+     *  \param sparse If true (and tiled is false), thread-local histogram
+     *                storage is paged on first touch instead of dense, which
+     *                also avoids the dense per-thread allocation while keeping
+     *                the accumulation thread-local (see BondHistogramCompute).
+     *  \param async_reduce If true, each frame's counts are drained in the
+     *                background while the next frame accumulates (see
+     *                BondHistogramCompute).
+     */
     PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsigned int n_y, unsigned int n_z,
-            const vec3<float>& shiftvec);
+            const vec3<float>& shiftvec, bool tiled = false, bool sparse = false,
+            bool async_reduce = false);
 
     /*! Compute the PCF for the passed in set of points. The function will be added to previous values
         of the pcf
@@ -32,6 +49,12 @@ public:
      */
     void reset() override;
 
+    //!< Whether the tiled accumulation path is used
+    bool isTiled() const
+    {
+        return m_tiled;
+    }
+
 protected:
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
@@ -41,6 +64,9 @@ protected:
     vec3<float> m_shiftvec;                //!< vector that points from [0,0,0] to the origin of the pmft
     unsigned int m_num_equiv_orientations; //!< The number of equivalent orientations used in the current
                                            //!< calls to compute.
+    bool m_tiled;                          //!< Whether to accumulate via tiles (default false).
+
+    static constexpr size_t m_tile_size {4096}; //!< Number of histogram bins owned by one tile.
 };
 
 }; }; // end namespace freud::pmft
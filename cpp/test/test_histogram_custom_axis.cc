@@ -0,0 +1,172 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Histogram.h"
+#include "test_util.h"
+
+/*! \file test_histogram_custom_axis.cc
+    \brief Validate the Eytzinger bin search of CustomAxis.
+
+    CustomAxis resolves most values with an interpolation guess and falls
+    back to a branch-free Eytzinger descent, so bin() is compared against a
+    plain std::upper_bound reference over many random edge sets, hitting
+    every edge exactly as well as values just inside and outside each
+    boundary. Bins are left-closed and a value equal to the final edge
+    returns OVERFLOW_BIN, the same convention RegularAxis uses at its max.
+*/
+
+using freud::util::Axis;
+using freud::util::CustomAxis;
+using freud::util::RegularAxis;
+
+namespace {
+
+//! Reference binning by binary search over the edge array.
+size_t referenceBin(const std::vector<float>& edges, float value)
+{
+    if (value < edges.front() || value >= edges.back())
+    {
+        return Axis::OVERFLOW_BIN;
+    }
+    return static_cast<size_t>(std::upper_bound(edges.begin(), edges.end(), value) - edges.begin())
+        - 1;
+}
+
+void checkAxisAgainstReference(const std::vector<float>& edges, std::mt19937& rng)
+{
+    const CustomAxis axis(edges);
+    TEST_CHECK(axis.size() == edges.size() - 1);
+
+    std::vector<float> values;
+    // Every edge exactly, and the closest representable values on either
+    // side of it; these exercise the left-closed convention and the
+    // OVERFLOW_BIN boundaries at min and max.
+    for (const float edge : edges)
+    {
+        values.push_back(edge);
+        values.push_back(std::nextafter(edge, -std::numeric_limits<float>::infinity()));
+        values.push_back(std::nextafter(edge, std::numeric_limits<float>::infinity()));
+    }
+    // Random values covering the range and a margin beyond both ends.
+    const float span = edges.back() - edges.front();
+    std::uniform_real_distribution<float> dist(edges.front() - span / 4,
+                                               edges.back() + span / 4);
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        values.push_back(dist(rng));
+    }
+
+    for (const float value : values)
+    {
+        TEST_CHECK(axis.bin(value) == referenceBin(edges, value));
+    }
+}
+
+void testRandomEdgeSets()
+{
+    std::mt19937 rng(23);
+    std::uniform_real_distribution<float> edge_dist(-50.0F, 50.0F);
+    std::uniform_int_distribution<size_t> nbins_dist(1, 100);
+    for (unsigned int trial = 0; trial < 50; trial++)
+    {
+        const size_t nbins = nbins_dist(rng);
+        std::vector<float> edges(nbins + 1);
+        for (auto& edge : edges)
+        {
+            edge = edge_dist(rng);
+        }
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+        if (edges.size() < 2)
+        {
+            continue;
+        }
+        checkAxisAgainstReference(edges, rng);
+    }
+    std::printf("random edge sets match std::upper_bound\n");
+}
+
+void testLogSpacedEdges()
+{
+    // The intended consumer: strongly skewed spacing, where the
+    // interpolation guess misses often and the Eytzinger descent does the
+    // work.
+    std::mt19937 rng(29);
+    std::vector<float> edges;
+    for (unsigned int i = 0; i <= 64; i++)
+    {
+        edges.push_back(std::pow(10.0F, -2.0F + 5.0F * float(i) / 64.0F));
+    }
+    checkAxisAgainstReference(edges, rng);
+    std::printf("log-spaced edges match std::upper_bound\n");
+}
+
+void testRegularAxisConsistency()
+{
+    // At the max boundary CustomAxis must behave like RegularAxis: the last
+    // representable value below max lands in the last bin and max itself
+    // overflows.
+    const size_t nbins = 10;
+    const float min = 0.0F;
+    const float max = 5.0F;
+    const RegularAxis regular(nbins, min, max);
+    const CustomAxis custom(regular.getBinEdges());
+
+    const float below_max = std::nextafter(max, -std::numeric_limits<float>::infinity());
+    TEST_CHECK(regular.bin(below_max) == nbins - 1);
+    TEST_CHECK(custom.bin(below_max) == nbins - 1);
+    TEST_CHECK(regular.bin(max) == Axis::OVERFLOW_BIN);
+    TEST_CHECK(custom.bin(max) == Axis::OVERFLOW_BIN);
+    TEST_CHECK(regular.bin(min) == 0);
+    TEST_CHECK(custom.bin(min) == 0);
+    const float below_min = std::nextafter(min, -std::numeric_limits<float>::infinity());
+    TEST_CHECK(regular.bin(below_min) == Axis::OVERFLOW_BIN);
+    TEST_CHECK(custom.bin(below_min) == Axis::OVERFLOW_BIN);
+    std::printf("boundary handling matches RegularAxis\n");
+}
+
+void testInvalidEdges()
+{
+    bool threw = false;
+    try
+    {
+        CustomAxis bad(std::vector<float> {1.0F});
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    threw = false;
+    try
+    {
+        CustomAxis bad(std::vector<float> {0.0F, 1.0F, 1.0F, 2.0F});
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+    std::printf("degenerate edge arrays throw\n");
+}
+
+}; // namespace
+
+int main()
+{
+    testRandomEdgeSets();
+    testLogSpacedEdges();
+    testRegularAxisConsistency();
+    testInvalidEdges();
+    std::printf("test_histogram_custom_axis passed\n");
+    return 0;
+}
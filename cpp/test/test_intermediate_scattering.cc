@@ -0,0 +1,244 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "IntermediateScattering.h"
+#include "VectorMath.h"
+#include "test_util.h"
+
+/*! \file test_intermediate_scattering.cc
+    \brief Validate the multi-tau intermediate scattering engine.
+
+    A short trajectory is streamed through the engine and every reported
+    (lag, k) entry of F(k, t) and F_s(k, t) is compared against a
+    double-precision brute-force average over exactly the time origins the
+    multi-tau scheme is supposed to use: correlator level l samples every
+    2^l-th frame and pairs each new sample with its buffered history.
+*/
+
+using freud::diffraction::IntermediateScattering;
+
+namespace {
+
+//! Trajectory stored frame-major: positions[frame][particle].
+using Trajectory = std::vector<std::vector<vec3<float>>>;
+
+Trajectory makeRandomWalkFrames(unsigned int num_frames, unsigned int num_particles, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> step(0.0F, 0.3F);
+    Trajectory frames(num_frames, std::vector<vec3<float>>(num_particles));
+    for (unsigned int n = 0; n < num_particles; n++)
+    {
+        vec3<float> r(step(rng), step(rng), step(rng));
+        for (unsigned int m = 0; m < num_frames; m++)
+        {
+            frames[m][n] = r;
+            r += vec3<float>(step(rng), step(rng), step(rng));
+        }
+    }
+    return frames;
+}
+
+std::vector<vec3<float>> makeKPoints(unsigned int num_k_points, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-4.0F, 4.0F);
+    std::vector<vec3<float>> k_points(num_k_points);
+    for (auto& k : k_points)
+    {
+        k = vec3<float>(dist(rng), dist(rng), dist(rng));
+    }
+    return k_points;
+}
+
+std::complex<double> rhoOfK(const vec3<float>& k, const std::vector<vec3<float>>& frame)
+{
+    std::complex<double> rho(0.0, 0.0);
+    for (const auto& point : frame)
+    {
+        const double theta = dot(vec3<double>(k.x, k.y, k.z), vec3<double>(point.x, point.y, point.z));
+        rho += std::complex<double>(std::cos(theta), std::sin(theta));
+    }
+    return rho;
+}
+
+double selfCorrelation(const vec3<float>& k, const std::vector<vec3<float>>& now,
+                       const std::vector<vec3<float>>& origin)
+{
+    const vec3<double> kd(k.x, k.y, k.z);
+    double total = 0.0;
+    for (size_t j = 0; j < now.size(); j++)
+    {
+        const double theta_now = dot(kd, vec3<double>(now[j].x, now[j].y, now[j].z));
+        const double theta_origin = dot(kd, vec3<double>(origin[j].x, origin[j].y, origin[j].z));
+        total += std::cos(theta_now - theta_origin);
+    }
+    return total;
+}
+
+void testAgainstBruteForce()
+{
+    const unsigned int num_frames = 40;
+    const unsigned int num_particles = 20;
+    const unsigned int num_k_points = 10;
+    const unsigned int block_size = 8;
+    const unsigned int num_levels = 3;
+    const auto frames = makeRandomWalkFrames(num_frames, num_particles, 11);
+    const auto k_points = makeKPoints(num_k_points, 12);
+
+    IntermediateScattering isf(block_size, num_levels);
+    for (unsigned int m = 0; m < num_frames; m++)
+    {
+        isf.accumulate(k_points.data(), num_k_points, frames[m].data(), num_particles);
+    }
+    TEST_CHECK(isf.getFrameCounter() == num_frames);
+
+    const auto& lag_times = isf.getLagTimes();
+    const auto& fkt = isf.getFkt();
+    const auto& self_fkt = isf.getSelfFkt();
+
+    // Replicate the multi-tau enumeration: level l holds lags
+    // block_size / 2 to block_size - 1 (all reachable lags for level 0) in
+    // units of 2^l frames, and sees samples at frames j * 2^l.
+    unsigned int row = 0;
+    unsigned int previous_lag_time = 0;
+    for (unsigned int level = 0; level < num_levels; level++)
+    {
+        const unsigned int period = 1U << level;
+        const unsigned int num_samples = (num_frames - 1) / period + 1;
+        const unsigned int lag_begin = (level == 0) ? 0 : block_size / 2;
+        for (unsigned int lag = lag_begin; lag < block_size && lag < num_samples; lag++)
+        {
+            TEST_CHECK(row < lag_times.size());
+            TEST_CHECK(lag_times[row] == lag * period);
+            if (row > 0)
+            {
+                TEST_CHECK(lag_times[row] > previous_lag_time);
+            }
+            previous_lag_time = lag_times[row];
+
+            const unsigned int num_origins = num_samples - lag;
+            const double norm = 1.0 / (double(num_origins) * double(num_particles));
+            for (unsigned int k_idx = 0; k_idx < num_k_points; k_idx++)
+            {
+                double coherent = 0.0;
+                double self_part = 0.0;
+                for (unsigned int j = lag; j < num_samples; j++)
+                {
+                    const auto& now = frames[j * period];
+                    const auto& origin = frames[(j - lag) * period];
+                    coherent
+                        += (rhoOfK(k_points[k_idx], now) * std::conj(rhoOfK(k_points[k_idx], origin)))
+                               .real();
+                    self_part += selfCorrelation(k_points[k_idx], now, origin);
+                }
+                TEST_CHECK_CLOSE(fkt(row, k_idx), coherent * norm, 1e-3, 1e-3);
+                TEST_CHECK_CLOSE(self_fkt(row, k_idx), self_part * norm, 1e-3, 1e-3);
+            }
+            row++;
+        }
+    }
+    TEST_CHECK(row == lag_times.size());
+
+    // The t = 0 self part is exactly the particle count over N.
+    for (unsigned int k_idx = 0; k_idx < num_k_points; k_idx++)
+    {
+        TEST_CHECK_CLOSE(self_fkt(0, k_idx), 1.0, 1e-4, 1e-4);
+    }
+    std::printf("multi-tau output matches brute force over %u lag rows\n", row);
+}
+
+void testStaticPoints()
+{
+    // For a frozen configuration F(k, t) = S(k) and F_s(k, t) = 1 at all lags.
+    const unsigned int num_frames = 20;
+    const unsigned int num_particles = 30;
+    const unsigned int num_k_points = 6;
+    const auto frames = makeRandomWalkFrames(1, num_particles, 13);
+    const auto k_points = makeKPoints(num_k_points, 14);
+
+    IntermediateScattering isf(4, 2);
+    for (unsigned int m = 0; m < num_frames; m++)
+    {
+        isf.accumulate(k_points.data(), num_k_points, frames[0].data(), num_particles);
+    }
+    const auto& lag_times = isf.getLagTimes();
+    const auto& fkt = isf.getFkt();
+    const auto& self_fkt = isf.getSelfFkt();
+    for (unsigned int k_idx = 0; k_idx < num_k_points; k_idx++)
+    {
+        const double sk = std::norm(rhoOfK(k_points[k_idx], frames[0])) / num_particles;
+        for (unsigned int row = 0; row < lag_times.size(); row++)
+        {
+            TEST_CHECK_CLOSE(fkt(row, k_idx), sk, 1e-4, 1e-4);
+            TEST_CHECK_CLOSE(self_fkt(row, k_idx), 1.0, 1e-4, 1e-4);
+        }
+    }
+    std::printf("frozen configuration gives flat F(k, t) = S(k)\n");
+}
+
+void testInvalidInput()
+{
+    bool threw = false;
+    try
+    {
+        IntermediateScattering bad(3, 2); // odd block size
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    threw = false;
+    try
+    {
+        IntermediateScattering bad(4, 0); // no levels
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    // Changing the particle count between frames must throw.
+    const auto frames = makeRandomWalkFrames(2, 8, 15);
+    const auto k_points = makeKPoints(4, 16);
+    IntermediateScattering isf(4, 2);
+    isf.accumulate(k_points.data(), 4, frames[0].data(), 8);
+    threw = false;
+    try
+    {
+        isf.accumulate(k_points.data(), 4, frames[1].data(), 7);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    // reset() allows a fresh shape.
+    isf.reset();
+    TEST_CHECK(isf.getFrameCounter() == 0);
+    isf.accumulate(k_points.data(), 4, frames[1].data(), 7);
+    TEST_CHECK(isf.getFrameCounter() == 1);
+    std::printf("invalid parameters and shape changes throw\n");
+}
+
+}; // namespace
+
+int main()
+{
+    testAgainstBruteForce();
+    testStaticPoints();
+    testInvalidInput();
+    std::printf("test_intermediate_scattering passed\n");
+    return 0;
+}
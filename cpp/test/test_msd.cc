@@ -0,0 +1,182 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "MSD.h"
+#include "VectorMath.h"
+#include "test_util.h"
+
+/*! \file test_msd.cc
+    \brief Validate the FFT-based MSD engine against brute-force references.
+
+    The windowed mode uses the Calandrini FFT autocorrelation algorithm, so
+    it is compared lag by lag against a direct O(num_frames^2) evaluation of
+    the windowed average on random walks. The comparison is tolerance-based:
+    the FFT reorders the floating-point accumulation, so bit-exact agreement
+    is not expected.
+*/
+
+using freud::msd::MSD;
+
+namespace {
+
+//! Generate an unwrapped random-walk trajectory in frame-major order.
+std::vector<vec3<double>> makeRandomWalk(unsigned int num_frames, unsigned int num_particles,
+                                         unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::vector<vec3<double>> positions(size_t(num_frames) * num_particles);
+    for (unsigned int n = 0; n < num_particles; n++)
+    {
+        vec3<double> r(step(rng), step(rng), step(rng));
+        for (unsigned int m = 0; m < num_frames; m++)
+        {
+            positions[size_t(m) * num_particles + n] = r;
+            r += vec3<double>(step(rng), step(rng), step(rng));
+        }
+    }
+    return positions;
+}
+
+//! Brute-force windowed MSD for one particle at one lag time.
+double bruteForceWindowedMSD(const std::vector<vec3<double>>& positions, unsigned int num_frames,
+                             unsigned int num_particles, unsigned int particle, unsigned int lag)
+{
+    double total = 0.0;
+    for (unsigned int k = 0; k + lag < num_frames; k++)
+    {
+        const vec3<double> delta = positions[size_t(k + lag) * num_particles + particle]
+            - positions[size_t(k) * num_particles + particle];
+        total += dot(delta, delta);
+    }
+    return total / double(num_frames - lag);
+}
+
+void testWindowedAgainstBruteForce()
+{
+    const unsigned int num_frames = 100;
+    const unsigned int num_particles = 17;
+    const auto positions = makeRandomWalk(num_frames, num_particles, 42);
+
+    MSD msd(MSD::Mode::window);
+    msd.compute(positions.data(), num_frames, num_particles);
+    const auto& particle_msd = msd.getParticleMSD();
+    const auto& mean_msd = msd.getMSD();
+
+    TEST_CHECK(mean_msd.size() == num_frames);
+    TEST_CHECK(particle_msd.size() == size_t(num_frames) * num_particles);
+    // Lag 0 is zero up to FFT roundoff, not bit-exact zero.
+    TEST_CHECK_CLOSE(mean_msd[0], 0.0, 0.0, 1e-6);
+
+    for (unsigned int m = 0; m < num_frames; m++)
+    {
+        double mean_reference = 0.0;
+        for (unsigned int n = 0; n < num_particles; n++)
+        {
+            const double reference
+                = bruteForceWindowedMSD(positions, num_frames, num_particles, n, m);
+            TEST_CHECK_CLOSE(particle_msd[size_t(m) * num_particles + n], reference, 1e-4, 1e-4);
+            mean_reference += reference;
+        }
+        TEST_CHECK_CLOSE(mean_msd[m], mean_reference / num_particles, 1e-4, 1e-4);
+    }
+    std::printf("windowed mode matches brute force over %u lags\n", num_frames);
+}
+
+void testDirectMode()
+{
+    const unsigned int num_frames = 64;
+    const unsigned int num_particles = 9;
+    const auto positions = makeRandomWalk(num_frames, num_particles, 7);
+
+    MSD msd(MSD::Mode::direct);
+    msd.compute(positions.data(), num_frames, num_particles);
+    const auto& particle_msd = msd.getParticleMSD();
+    const auto& mean_msd = msd.getMSD();
+
+    for (unsigned int m = 0; m < num_frames; m++)
+    {
+        double mean_reference = 0.0;
+        for (unsigned int n = 0; n < num_particles; n++)
+        {
+            const vec3<double> delta
+                = positions[size_t(m) * num_particles + n] - positions[size_t(0) * num_particles + n];
+            const double reference = dot(delta, delta);
+            TEST_CHECK_CLOSE(particle_msd[size_t(m) * num_particles + n], reference, 1e-6, 1e-6);
+            mean_reference += reference;
+        }
+        TEST_CHECK_CLOSE(mean_msd[m], mean_reference / num_particles, 1e-6, 1e-6);
+    }
+    std::printf("direct mode matches r(m) - r(0) over %u frames\n", num_frames);
+}
+
+void testFloatDoubleAgreement()
+{
+    const unsigned int num_frames = 48;
+    const unsigned int num_particles = 5;
+    const auto positions = makeRandomWalk(num_frames, num_particles, 3);
+    std::vector<vec3<float>> positions_float(positions.size());
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        positions_float[i] = vec3<float>(float(positions[i].x), float(positions[i].y),
+                                         float(positions[i].z));
+    }
+
+    for (const auto mode : {MSD::Mode::window, MSD::Mode::direct})
+    {
+        MSD msd_double(mode);
+        msd_double.compute(positions.data(), num_frames, num_particles);
+        MSD msd_float(mode);
+        msd_float.compute(positions_float.data(), num_frames, num_particles);
+        for (unsigned int m = 0; m < num_frames; m++)
+        {
+            TEST_CHECK_CLOSE(msd_double.getMSD()[m], msd_float.getMSD()[m], 1e-4, 1e-4);
+        }
+    }
+    std::printf("float and double overloads agree in both modes\n");
+}
+
+void testInvalidInput()
+{
+    MSD msd;
+    const vec3<float> point(0.0F, 0.0F, 0.0F);
+    bool threw = false;
+    try
+    {
+        msd.compute(&point, 0, 1);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+
+    threw = false;
+    try
+    {
+        msd.compute(&point, 1, 0);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+    std::printf("empty trajectories throw\n");
+}
+
+}; // namespace
+
+int main()
+{
+    testWindowedAgainstBruteForce();
+    testDirectMode();
+    testFloatDoubleAgreement();
+    testInvalidInput();
+    std::printf("test_msd passed\n");
+    return 0;
+}
@@ -0,0 +1,192 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "Box.h"
+#include "StaticStructureFactor.h"
+#include "VectorMath.h"
+#include "test_util.h"
+
+/*! \file test_static_structure_factor.cc
+    \brief Validate the S(k) engines against brute-force summation.
+
+    The direct engine is compared against a double-precision reference
+    evaluation of |sum_j exp(i k.r_j)|^2 / N at random k-vectors. The grid
+    engine uses nearest-grid-point assignment, so it is tested with points
+    placed exactly on mesh sites, where the assignment is lossless and every
+    grid cell must match the direct sum at its reciprocal lattice vector.
+*/
+
+using freud::diffraction::StaticStructureFactorDirect;
+using freud::diffraction::StaticStructureFactorGrid;
+
+namespace {
+
+//! Double-precision reference S(k) for one k-vector.
+double bruteForceSk(const vec3<float>& k, const std::vector<vec3<float>>& points)
+{
+    std::complex<double> rho(0.0, 0.0);
+    for (const auto& point : points)
+    {
+        const double theta = dot(vec3<double>(k.x, k.y, k.z), vec3<double>(point.x, point.y, point.z));
+        rho += std::complex<double>(std::cos(theta), std::sin(theta));
+    }
+    return std::norm(rho) / static_cast<double>(points.size());
+}
+
+std::vector<vec3<float>> makeRandomPoints(unsigned int num_points, float extent, unsigned int seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> dist(-extent / 2, extent / 2);
+    std::vector<vec3<float>> points(num_points);
+    for (auto& point : points)
+    {
+        point = vec3<float>(dist(rng), dist(rng), dist(rng));
+    }
+    return points;
+}
+
+void testDirectAgainstBruteForce()
+{
+    const unsigned int num_points = 300;
+    const unsigned int num_k_points = 150;
+    const auto points = makeRandomPoints(num_points, 10.0F, 1);
+    const auto k_points = makeRandomPoints(num_k_points, 8.0F, 2);
+
+    StaticStructureFactorDirect sf;
+    sf.accumulate(k_points.data(), num_k_points, points.data(), num_points);
+    const auto& sk = sf.getStructureFactor();
+    TEST_CHECK(sk.size() == num_k_points);
+
+    for (unsigned int k_idx = 0; k_idx < num_k_points; k_idx++)
+    {
+        TEST_CHECK_CLOSE(sk[k_idx], bruteForceSk(k_points[k_idx], points), 1e-4, 1e-4);
+    }
+
+    // k = 0 must give exactly N, and a single particle gives S(k) = 1.
+    const vec3<float> k_zero(0.0F, 0.0F, 0.0F);
+    StaticStructureFactorDirect sf_zero;
+    sf_zero.accumulate(&k_zero, 1, points.data(), num_points);
+    TEST_CHECK_CLOSE(sf_zero.getStructureFactor()[0], double(num_points), 1e-6, 0.0);
+
+    StaticStructureFactorDirect sf_single;
+    sf_single.accumulate(k_points.data(), num_k_points, points.data(), 1);
+    for (unsigned int k_idx = 0; k_idx < num_k_points; k_idx++)
+    {
+        TEST_CHECK_CLOSE(sf_single.getStructureFactor()[k_idx], 1.0, 1e-6, 1e-6);
+    }
+    std::printf("direct engine matches brute force at %u k-vectors\n", num_k_points);
+}
+
+void testDirectFrameAveraging()
+{
+    const unsigned int num_points = 100;
+    const unsigned int num_k_points = 40;
+    const auto frame_a = makeRandomPoints(num_points, 10.0F, 3);
+    const auto frame_b = makeRandomPoints(num_points, 10.0F, 4);
+    const auto k_points = makeRandomPoints(num_k_points, 8.0F, 5);
+
+    StaticStructureFactorDirect sf;
+    sf.accumulate(k_points.data(), num_k_points, frame_a.data(), num_points);
+    sf.accumulate(k_points.data(), num_k_points, frame_b.data(), num_points);
+    TEST_CHECK(sf.getFrameCounter() == 2);
+
+    for (unsigned int k_idx = 0; k_idx < num_k_points; k_idx++)
+    {
+        const double mean
+            = 0.5 * (bruteForceSk(k_points[k_idx], frame_a) + bruteForceSk(k_points[k_idx], frame_b));
+        TEST_CHECK_CLOSE(sf.getStructureFactor()[k_idx], mean, 1e-4, 1e-4);
+    }
+
+    // Changing the k-set between frames must throw; reset() allows it again.
+    bool threw = false;
+    try
+    {
+        sf.accumulate(k_points.data(), num_k_points - 1, frame_a.data(), num_points);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+    sf.reset();
+    TEST_CHECK(sf.getFrameCounter() == 0);
+    sf.accumulate(k_points.data(), num_k_points - 1, frame_a.data(), num_points);
+    TEST_CHECK(sf.getFrameCounter() == 1);
+    std::printf("direct engine averages frames and guards the k-set\n");
+}
+
+void testGridAgainstBruteForce()
+{
+    const unsigned int g = 4;
+    const unsigned int num_points = 50;
+    const float box_length = 12.0F;
+    const freud::box::Box box(box_length, box_length, box_length, 0, 0, 0, false);
+
+    // Snap random points to mesh sites so nearest-grid-point assignment is
+    // exact and the grid output is comparable to direct summation.
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<unsigned int> site(0, g - 1);
+    std::vector<vec3<float>> points(num_points);
+    for (auto& point : points)
+    {
+        point = vec3<float>((float(site(rng)) / g - 0.5F) * box_length,
+                            (float(site(rng)) / g - 0.5F) * box_length,
+                            (float(site(rng)) / g - 0.5F) * box_length);
+    }
+
+    StaticStructureFactorGrid sf(g);
+    sf.accumulate(box, points.data(), num_points);
+    const auto& sk = sf.getStructureFactor();
+    TEST_CHECK(sf.getGridSize() == g);
+    TEST_CHECK(sk.size() == size_t(g) * g * g);
+
+    // Grid index n maps to the reciprocal lattice vector 2*pi*n/L per
+    // dimension in FFT frequency ordering.
+    const auto frequency = [&](unsigned int n) {
+        const int signed_n = (n <= g / 2) ? int(n) : int(n) - int(g);
+        return 2.0F * float(M_PI) * float(signed_n) / box_length;
+    };
+    for (unsigned int nx = 0; nx < g; nx++)
+    {
+        for (unsigned int ny = 0; ny < g; ny++)
+        {
+            for (unsigned int nz = 0; nz < g; nz++)
+            {
+                const vec3<float> k(frequency(nx), frequency(ny), frequency(nz));
+                TEST_CHECK_CLOSE(sk[(size_t(nx) * g + ny) * g + nz], bruteForceSk(k, points), 1e-4,
+                                 1e-4);
+            }
+        }
+    }
+
+    // A non-power-of-two grid size is rejected up front.
+    bool threw = false;
+    try
+    {
+        StaticStructureFactorGrid bad(12);
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_CHECK(threw);
+    std::printf("grid engine matches brute force on all %u^3 cells\n", g);
+}
+
+}; // namespace
+
+int main()
+{
+    testDirectAgainstBruteForce();
+    testDirectFrameAveraging();
+    testGridAgainstBruteForce();
+    std::printf("test_static_structure_factor passed\n");
+    return 0;
+}
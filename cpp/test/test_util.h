@@ -0,0 +1,46 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef FREUD_TEST_UTIL_H
+#define FREUD_TEST_UTIL_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+/*! \file test_util.h
+    \brief Minimal checks for the native C++ test executables.
+
+    The tests are plain executables registered with ctest, so a failed check
+    prints its location and exits nonzero instead of relying on assert(),
+    which would disappear in release builds.
+*/
+
+//! Fail the test with a message if the condition does not hold.
+#define TEST_CHECK(cond)                                                                                  \
+    do                                                                                                    \
+    {                                                                                                     \
+        if (!(cond))                                                                                      \
+        {                                                                                                 \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);                 \
+            std::exit(1);                                                                                 \
+        }                                                                                                 \
+    } while (0)
+
+//! Fail the test if two values differ by more than a combined tolerance.
+#define TEST_CHECK_CLOSE(a, b, rel_tol, abs_tol)                                                          \
+    do                                                                                                    \
+    {                                                                                                     \
+        const double test_a_ = (a);                                                                       \
+        const double test_b_ = (b);                                                                       \
+        const double test_tol_ = (abs_tol) + (rel_tol) *std::fmax(std::fabs(test_a_), std::fabs(test_b_)); \
+        if (std::fabs(test_a_ - test_b_) > test_tol_)                                                     \
+        {                                                                                                 \
+            std::fprintf(stderr, "%s:%d: %s = %.9g differs from %s = %.9g by %.3g (tolerance %.3g)\n",    \
+                         __FILE__, __LINE__, #a, test_a_, #b, test_b_, std::fabs(test_a_ - test_b_),      \
+                         test_tol_);                                                                      \
+            std::exit(1);                                                                                 \
+        }                                                                                                 \
+    } while (0)
+
+#endif // FREUD_TEST_UTIL_H
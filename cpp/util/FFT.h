@@ -0,0 +1,75 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+/*! \file FFT.h
+    \brief Small self-contained FFT routines shared across modules.
+*/
+
+namespace freud { namespace util {
+
+//! In-place iterative radix-2 FFT.
+/*! The transform length must be a power of two; callers zero-pad to one.
+ *  The inverse transform includes the 1/n normalization.
+ */
+inline void fftRadix2(std::vector<std::complex<double>>& a, bool inverse)
+{
+    const size_t n = a.size();
+
+    // Bit-reversal permutation.
+    for (size_t i = 1, j = 0; i < n; ++i)
+    {
+        size_t bit = n >> 1;
+        for (; (j & bit) != 0; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j)
+        {
+            std::swap(a[i], a[j]);
+        }
+    }
+
+    for (size_t len = 2; len <= n; len <<= 1)
+    {
+        const double angle = (inverse ? 2.0 : -2.0) * M_PI / static_cast<double>(len);
+        const std::complex<double> w_len(std::cos(angle), std::sin(angle));
+        for (size_t i = 0; i < n; i += len)
+        {
+            std::complex<double> w(1);
+            for (size_t k = 0; k < len / 2; ++k)
+            {
+                const std::complex<double> u = a[i + k];
+                const std::complex<double> v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= w_len;
+            }
+        }
+    }
+
+    if (inverse)
+    {
+        for (auto& value : a)
+        {
+            value /= static_cast<double>(n);
+        }
+    }
+}
+
+//! Check whether a transform length is a power of two.
+inline bool isPowerOfTwo(size_t n)
+{
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+}; }; // end namespace freud::util
+
+#endif // FFT_H
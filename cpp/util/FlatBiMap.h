@@ -0,0 +1,374 @@
+#ifndef FLAT_BIMAP_H
+#define FLAT_BIMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+/* Flat open-addressing replacement for BiMap for integral key types.
+ *
+ * FlatBiMap represents the same bidirectional relation as BiMap (cpp/util/BiMap.h),
+ * but stores the pairs contiguously in one vector and indexes both sides with
+ * robin-hood hash tables held in flat arrays. BiMap allocates a node per pair
+ * and walks red-black trees on every lookup, which makes building or querying
+ * maps with many entries allocation- and cache-bound; FlatBiMap performs one
+ * amortized allocation per side and probes linearly, with robin-hood
+ * displacement keeping probe sequences short.
+ *
+ * The supported interface mirrors the parts of BiMap the code base uses:
+ *
+ *     bool emplace(T, U)   - insert, rejecting duplicates on either side
+ *     void insert(Pair)
+ *     left.at / left[] / left.has / left.count
+ *     right.at / right[] / right.has / right.count
+ *     size() / empty() / clear() / asMap()
+ *     begin() / end()      - iterate pairs in insertion order
+ *
+ * Iteration yields const references to std::pair<T, U> rather than the
+ * pointers BiMap hands out. In addition, buildFromSorted() bulk-builds the
+ * map from an array of unique keys (e.g. sorted disjoint-set roots), mapping
+ * the i-th key to value i without per-pair duplicate checks.
+ */
+
+template<typename T, typename U> class FlatBiMap
+{
+public:
+    using Pair = std::pair<T, U>;
+    using const_iterator = typename std::vector<Pair>::const_iterator;
+
+private:
+    //! One side's key -> pair index table.
+    /*! Open addressing over a power-of-two capacity with robin-hood insertion:
+     *  when a probing key is further from its ideal slot than the resident
+     *  key, the two swap and probing continues with the evicted entry.
+     */
+    template<typename K> class HashIndex
+    {
+    public:
+        static const uint32_t EMPTY = 0xffffffff;
+
+        void clear()
+        {
+            m_values.clear();
+            m_keys.clear();
+            m_mask = 0;
+            m_count = 0;
+        }
+
+        void reserve(size_t n)
+        {
+            size_t capacity = 16;
+            // max load factor 7/8
+            while (capacity - capacity / 8 < n)
+            {
+                capacity *= 2;
+            }
+            if (m_mask + 1 < capacity)
+            {
+                rehash(capacity);
+            }
+        }
+
+        //! Find the pair index stored for a key, or EMPTY.
+        uint32_t find(const K& key) const
+        {
+            if (m_count == 0)
+            {
+                return EMPTY;
+            }
+            size_t slot = hash(key) & m_mask;
+            size_t dist = 0;
+            while (true)
+            {
+                if (m_values[slot] == EMPTY)
+                {
+                    return EMPTY;
+                }
+                if (m_keys[slot] == key)
+                {
+                    return m_values[slot];
+                }
+                // Robin-hood invariant: once we have probed further than the
+                // resident entry, the key cannot be in the table.
+                if (dist > probeDistance(slot))
+                {
+                    return EMPTY;
+                }
+                slot = (slot + 1) & m_mask;
+                ++dist;
+            }
+        }
+
+        //! Insert a key assuming it is not present.
+        void insert(K key, uint32_t value)
+        {
+            if (m_values.empty() || m_count + 1 > (m_mask + 1) - (m_mask + 1) / 8)
+            {
+                rehash(m_values.empty() ? 16 : 2 * (m_mask + 1));
+            }
+            size_t slot = hash(key) & m_mask;
+            size_t dist = 0;
+            while (m_values[slot] != EMPTY)
+            {
+                const size_t resident_dist = probeDistance(slot);
+                if (resident_dist < dist)
+                {
+                    std::swap(key, m_keys[slot]);
+                    std::swap(value, m_values[slot]);
+                    dist = resident_dist;
+                }
+                slot = (slot + 1) & m_mask;
+                ++dist;
+            }
+            m_keys[slot] = key;
+            m_values[slot] = value;
+            ++m_count;
+        }
+
+    private:
+        static size_t hash(const K& key)
+        {
+            // Fibonacci multiplicative hashing; the high bits end up
+            // well-mixed, and the mask keeps the low ones.
+            return size_t((uint64_t(key) * uint64_t(0x9E3779B97F4A7C15ULL)) >> 32U);
+        }
+
+        size_t probeDistance(size_t slot) const
+        {
+            return (slot - (hash(m_keys[slot]) & m_mask)) & m_mask;
+        }
+
+        void rehash(size_t capacity)
+        {
+            std::vector<K> old_keys;
+            std::vector<uint32_t> old_values;
+            std::swap(old_keys, m_keys);
+            std::swap(old_values, m_values);
+            m_keys.resize(capacity);
+            m_values.assign(capacity, EMPTY);
+            m_mask = capacity - 1;
+            m_count = 0;
+            for (size_t slot = 0; slot < old_values.size(); ++slot)
+            {
+                if (old_values[slot] != EMPTY)
+                {
+                    insert(old_keys[slot], old_values[slot]);
+                }
+            }
+        }
+
+        std::vector<K> m_keys;
+        std::vector<uint32_t> m_values; //!< Pair index per slot, EMPTY when unoccupied
+        size_t m_mask {0};
+        size_t m_count {0};
+    };
+
+    std::vector<Pair> m_pairs;
+    HashIndex<T> m_index_A;
+    HashIndex<U> m_index_B;
+
+public:
+    FlatBiMap() : left(*this), right(*this) {}
+
+    FlatBiMap(const FlatBiMap& other)
+        : m_pairs(other.m_pairs), m_index_A(other.m_index_A), m_index_B(other.m_index_B), left(*this),
+          right(*this)
+    {}
+
+    FlatBiMap& operator=(const FlatBiMap& rhs)
+    {
+        m_pairs = rhs.m_pairs;
+        m_index_A = rhs.m_index_A;
+        m_index_B = rhs.m_index_B;
+        return *this;
+    }
+
+    // Return a std::map equivalent to this object.
+    std::map<T, U> asMap() const
+    {
+        std::map<T, U> ret;
+        for (const Pair& pair : m_pairs)
+        {
+            ret[pair.first] = pair.second;
+        }
+        return ret;
+    }
+
+    //! Reserve space for n pairs on both sides.
+    void reserve(size_t n)
+    {
+        m_pairs.reserve(n);
+        m_index_A.reserve(n);
+        m_index_B.reserve(n);
+    }
+
+    bool emplace(const T& a, const U& b)
+    {
+        if (m_index_A.find(a) != HashIndex<T>::EMPTY || m_index_B.find(b) != HashIndex<U>::EMPTY)
+        {
+            return false;
+        }
+        const auto index = uint32_t(m_pairs.size());
+        m_pairs.emplace_back(a, b);
+        m_index_A.insert(a, index);
+        m_index_B.insert(b, index);
+        return true;
+    }
+
+    void insert(const Pair& pair)
+    {
+        this->emplace(pair.first, pair.second);
+    }
+
+    //! Bulk-build the map from an array of unique keys.
+    /*! The i-th key maps to value U(i). The keys must be pairwise distinct
+     *  (e.g. a sorted, deduplicated array of disjoint-set roots); no
+     *  duplicate checks are performed, so the build is a single pass with the
+     *  tables sized up front.
+     */
+    void buildFromSorted(const T* keys, size_t n)
+    {
+        clear();
+        reserve(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            m_pairs.emplace_back(keys[i], U(i));
+            m_index_A.insert(keys[i], uint32_t(i));
+            m_index_B.insert(U(i), uint32_t(i));
+        }
+    }
+
+    class left_view
+    {
+        friend FlatBiMap;
+
+    public:
+        const U& at(const T& key) const
+        {
+            const uint32_t index = m_map.m_index_A.find(key);
+            if (index == HashIndex<T>::EMPTY)
+            {
+                throw std::out_of_range {"Key not found"};
+            }
+            return m_map.m_pairs[index].second;
+        }
+
+        U& operator[](const T& key)
+        {
+            uint32_t index = m_map.m_index_A.find(key);
+            if (index == HashIndex<T>::EMPTY)
+            {
+                // Add a new item, initializing U to the default.
+                m_map.emplace(key, U());
+                index = m_map.m_index_A.find(key);
+                if (index == HashIndex<T>::EMPTY)
+                {
+                    // The default U is already taken on the right side, so
+                    // the relation cannot hold this key.
+                    throw std::out_of_range {"Key not found"};
+                }
+            }
+            return m_map.m_pairs[index].second;
+        }
+
+        int count(const T& key) const
+        {
+            return has(key) ? 1 : 0;
+        }
+
+        bool has(const T& key) const
+        {
+            return m_map.m_index_A.find(key) != HashIndex<T>::EMPTY;
+        }
+
+    private:
+        explicit left_view(FlatBiMap& map) : m_map(map) {}
+        FlatBiMap& m_map;
+    } left;
+
+    class right_view
+    {
+        friend FlatBiMap;
+
+    public:
+        const T& at(const U& key) const
+        {
+            const uint32_t index = m_map.m_index_B.find(key);
+            if (index == HashIndex<U>::EMPTY)
+            {
+                throw std::out_of_range {"Key not found"};
+            }
+            return m_map.m_pairs[index].first;
+        }
+
+        T& operator[](const U& key)
+        {
+            uint32_t index = m_map.m_index_B.find(key);
+            if (index == HashIndex<U>::EMPTY)
+            {
+                // Add a new item, initializing T to the default.
+                m_map.emplace(T(), key);
+                index = m_map.m_index_B.find(key);
+                if (index == HashIndex<U>::EMPTY)
+                {
+                    // The default T is already taken on the left side, so
+                    // the relation cannot hold this key.
+                    throw std::out_of_range {"Key not found"};
+                }
+            }
+            return m_map.m_pairs[index].first;
+        }
+
+        int count(const U& key) const
+        {
+            return has(key) ? 1 : 0;
+        }
+
+        bool has(const U& key) const
+        {
+            return m_map.m_index_B.find(key) != HashIndex<U>::EMPTY;
+        }
+
+    private:
+        explicit right_view(FlatBiMap& map) : m_map(map) {}
+        FlatBiMap& m_map;
+    } right;
+
+    friend class left_view;
+    friend class right_view;
+
+    void clear()
+    {
+        m_pairs.clear();
+        m_index_A.clear();
+        m_index_B.clear();
+    }
+
+    bool empty() const
+    {
+        return m_pairs.empty();
+    }
+
+    size_t size() const
+    {
+        return m_pairs.size();
+    }
+
+    const_iterator begin() const
+    {
+        return m_pairs.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_pairs.end();
+    }
+};
+
+template<typename T, typename U>
+template<typename K>
+const uint32_t FlatBiMap<T, U>::HashIndex<K>::EMPTY;
+
+#endif // FLAT_BIMAP_H
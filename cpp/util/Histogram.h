@@ -167,11 +167,206 @@ public:
         return bin;
     }
 
+    //! Return the inverse of the bin width.
+    float getInverseBinWidth() const
+    {
+        return m_inverse_bin_width;
+    }
+
 protected:
     float m_bin_width;         //!< Bin width
     float m_inverse_bin_width; //!< Inverse of bin width
 };
 
+//! An axis with arbitrary monotonically increasing bin edges.
+/*! Supports nonuniform binnings such as the log-spaced r bins used for
+ *  long-ranged RDFs, where RegularAxis cannot be used. A naive
+ *  implementation would binary search the edge array per value, whose
+ *  unpredictable branches and scattered loads make it several times slower
+ *  per bond than the regular path. bin() instead proceeds in two stages.
+ *  First a monotone interpolation guess: one multiply by the inverse mean
+ *  bin width proposes a bin, and two edge loads verify it, which resolves
+ *  most values immediately when the spacing is not too skewed. When the
+ *  guess misses, the interior edges are searched in an Eytzinger (BFS)
+ *  layout: each comparison's children sit together in the next level, so
+ *  the descent is branch-free (the comparison result indexes the next node
+ *  arithmetically) and cache-friendly, and a parallel rank table maps the
+ *  located edge back to its bin index.
+ */
+class CustomAxis : public Axis
+{
+public:
+    //! Construct from an ascending edge array of size nbins + 1.
+    explicit CustomAxis(const std::vector<float>& bin_edges)
+        : Axis(bin_edges.empty() ? 0 : bin_edges.size() - 1, bin_edges.empty() ? 0.0F : bin_edges.front(),
+               bin_edges.empty() ? 0.0F : bin_edges.back())
+    {
+        if (bin_edges.size() < 2)
+        {
+            throw std::invalid_argument("CustomAxis requires at least two bin edges.");
+        }
+        for (size_t i = 1; i < bin_edges.size(); ++i)
+        {
+            if (bin_edges[i] <= bin_edges[i - 1])
+            {
+                throw std::invalid_argument("CustomAxis bin edges must be strictly increasing.");
+            }
+        }
+        m_bin_edges = bin_edges;
+        m_inverse_mean_width = static_cast<float>(m_nbins) / (m_max - m_min);
+
+        // Eytzinger layout of the interior edges (all except the first and
+        // last), with the sorted position of each stored alongside. An
+        // in-order traversal of the implicit tree visits the nodes in
+        // ascending order, which is how both arrays are filled.
+        const size_t num_interior = m_nbins - 1;
+        m_eytzinger.assign(num_interior + 1, 0.0F);
+        m_rank.assign(num_interior + 1, 0);
+        size_t next = 0;
+        fillEytzinger(1, num_interior, next);
+    }
+
+    ~CustomAxis() override = default;
+
+    //! Find the bin of a value along this axis.
+    /*! Bins are left-closed, so a value equal to an interior edge falls in
+     *  the bin above it, and a value equal to the final edge returns
+     *  OVERFLOW_BIN, exactly as RegularAxis treats its max.
+     */
+    size_t bin(const float& value) const override
+    {
+        if (value < m_min || value >= m_max)
+        {
+            return OVERFLOW_BIN;
+        }
+        // Stage one: interpolation guess assuming mean bin width.
+        float val = (value - m_min) * m_inverse_mean_width;
+        // fast float to int conversion with truncation
+#ifdef __SSE2__
+        size_t guess = _mm_cvtt_ss2si(_mm_load_ss(&val));
+#else
+        size_t guess = (size_t) (val);
+#endif
+        if (guess >= m_nbins)
+        {
+            guess = m_nbins - 1;
+        }
+        if (m_bin_edges[guess] <= value && value < m_bin_edges[guess + 1])
+        {
+            return guess;
+        }
+        // Stage two: branch-free descent to the first interior edge greater
+        // than the value; the bin is that edge's sorted position (the count
+        // of interior edges at or below the value).
+        const size_t num_interior = m_nbins - 1;
+        size_t k = 1;
+        while (k <= num_interior)
+        {
+            k = 2 * k + static_cast<size_t>(m_eytzinger[k] <= value);
+        }
+        // Undo the trailing right turns of the descent to recover the node
+        // where the last left turn happened (ffs(~k) strips the trailing one
+        // bits and the terminating zero); k == 0 means every edge was below
+        // the value.
+        k >>= static_cast<unsigned int>(__builtin_ffsll(static_cast<long long>(~k)));
+        return (k == 0) ? num_interior : m_rank[k];
+    }
+
+protected:
+    //! Fill the Eytzinger and rank arrays by in-order traversal.
+    void fillEytzinger(size_t k, size_t num_interior, size_t& next)
+    {
+        if (k > num_interior)
+        {
+            return;
+        }
+        fillEytzinger(2 * k, num_interior, next);
+        m_eytzinger[k] = m_bin_edges[next + 1];
+        m_rank[k] = next;
+        ++next;
+        fillEytzinger(2 * k + 1, num_interior, next);
+    }
+
+    float m_inverse_mean_width;     //!< Inverse of the mean bin width.
+    std::vector<float> m_eytzinger; //!< Interior edges in BFS layout (1-based).
+    std::vector<size_t> m_rank;     //!< Sorted position of each BFS-layout edge.
+};
+
+//! Devirtualized binning over a set of regular axes.
+/*! Binning a value funnels through a virtual Axis::bin call per value per
+ *  dimension, which is pure overhead on the hottest loops in the library when
+ *  every axis is a RegularAxis (the common case by far). A RegularBinner is
+ *  built once at histogram construction: if all axes are regular, it captures
+ *  their bounds, inverse bin widths and bin counts in flat vectors and bins
+ *  all dimensions in one non-virtual pass, combining the per-axis bins into
+ *  the flattened row-major index directly. The per-axis arithmetic is
+ *  identical to RegularAxis::bin, so the resulting bins match the virtual
+ *  path exactly.
+ */
+class RegularBinner
+{
+public:
+    RegularBinner() = default;
+
+    explicit RegularBinner(const std::vector<std::shared_ptr<Axis>>& axes)
+    {
+        for (const auto& ax : axes)
+        {
+            const auto* regular = dynamic_cast<const RegularAxis*>(ax.get());
+            if (regular == nullptr)
+            {
+                return;
+            }
+            m_min.push_back(regular->getMin());
+            m_max.push_back(regular->getMax());
+            m_inverse_bin_width.push_back(regular->getInverseBinWidth());
+            m_nbins.push_back(regular->size());
+        }
+        m_valid = !axes.empty();
+    }
+
+    //! Whether all axes were regular, making bin() usable.
+    bool valid() const
+    {
+        return m_valid;
+    }
+
+    //! Bin one value per axis, returning the flattened row-major index.
+    inline size_t bin(const std::vector<float>& values) const
+    {
+        size_t idx = 0;
+        for (size_t d = 0; d < m_nbins.size(); ++d)
+        {
+            const float value = values[d];
+            if (value < m_min[d] || value >= m_max[d])
+            {
+                return Axis::OVERFLOW_BIN;
+            }
+            float val = (value - m_min[d]) * m_inverse_bin_width[d];
+            // fast float to int conversion with truncation
+#ifdef __SSE2__
+            size_t axis_bin = _mm_cvtt_ss2si(_mm_load_ss(&val));
+#else
+            size_t axis_bin = (size_t) (val);
+#endif
+            // Avoid rounding leading to overflow.
+            if (axis_bin == m_nbins[d])
+            {
+                --axis_bin;
+            }
+            idx = idx * m_nbins[d] + axis_bin;
+        }
+        return idx;
+    }
+
+private:
+    bool m_valid {false};                    //!< Whether every axis was a RegularAxis.
+    std::vector<float> m_min;                //!< Lower bound per axis.
+    std::vector<float> m_max;                //!< Upper bound per axis.
+    std::vector<float> m_inverse_bin_width;  //!< Inverse bin width per axis.
+    std::vector<size_t> m_nbins;             //!< Number of bins per axis.
+};
+
 //! An n-dimensional histogram class.
 /*! The Histogram is designed to simplify the most common use of histograms in
  * C++ code, which is looping over a series of values and then binning them. To
@@ -195,14 +390,29 @@ public:
      * local copies all share the same axes (because the axes are stored as
      * arrays of shared_ptrs in the Histogram class). This should cause no
      * problems, but can be refactored if needed.
+     *
+     * When constructed with sparse storage, each thread stores its counts in
+     * fixed-size pages allocated the first time a bin in the page is hit
+     * instead of in a dense copy of the histogram. At fine binnings most bins
+     * are empty in any one frame, so this reduces the per-thread memory from
+     * the full histogram size to the touched fraction of it, and the
+     * reduction only has to visit allocated pages. The counts are identical
+     * to the dense storage.
      */
     class ThreadLocalHistogram
     {
     public:
         ThreadLocalHistogram() = default;
 
-        explicit ThreadLocalHistogram(const Histogram& histogram)
-            : m_local_histograms([histogram]() { return Histogram(histogram.m_axes); })
+        explicit ThreadLocalHistogram(const Histogram& histogram, bool sparse = false)
+            : m_sparse(sparse), m_axes(histogram.m_axes), m_binner(histogram.m_binner),
+              m_shape(histogram.shape()),
+              m_n_pages((histogram.size() + m_page_size - 1) / m_page_size),
+              m_local_histograms(
+                  [histogram, sparse]() { return sparse ? Histogram() : Histogram(histogram.m_axes); }),
+              m_local_pages([histogram]() {
+                  return std::vector<std::vector<T>>((histogram.size() + m_page_size - 1) / m_page_size);
+              })
         {}
 
         using const_iterator = typename tbb::enumerable_thread_specific<Histogram<T>>::const_iterator;
@@ -240,38 +450,232 @@ public:
             {
                 hist->reset();
             }
+            for (auto pages = m_local_pages.begin(); pages != m_local_pages.end(); ++pages)
+            {
+                for (auto& page : *pages)
+                {
+                    // Release the memory so the next frame starts from an
+                    // empty footprint again.
+                    std::vector<T>().swap(page);
+                }
+            }
         }
 
         //! Dispatch to thread local histogram.
         template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
         {
+            if (m_sparse)
+            {
+                std::pair<std::vector<float>, Weight<T>> value_vector
+                    = Histogram::getValueVector(values...);
+                incrementPage(binSparse(value_vector.first), value_vector.second.value);
+                return;
+            }
             m_local_histograms.local()(values...);
         }
 
         //! Dispatch to thread local histogram.
         void increment(size_t value_bin, T weight = 1)
         {
+            if (m_sparse)
+            {
+                incrementPage(value_bin, weight);
+                return;
+            }
             m_local_histograms.local().increment(value_bin, weight);
         }
 
         // Reduce over histograms into the result array.
         void reduceInto(ManagedArray<T>& result)
         {
-            result.reset();
-            util::forLoopWrapper(0, result.size(), [=, &result](size_t begin, size_t end) {
-                for (size_t i = begin; i < end; ++i)
+            // prepare rather than reset: if an outstanding view (e.g. a
+            // zero-copy numpy array) still references the buffer, this
+            // reallocates so the view keeps the previous generation's data
+            // instead of mutating underneath the reader; otherwise it only
+            // zeroes in place.
+            result.prepare(result.shape());
+            accumulateInto(result);
+        }
+
+        //! Add the thread-local counts into the result array without clearing it.
+        /*! This allows counts to be drained into a persistent array
+         *  incrementally (e.g. once per frame) rather than re-reduced from
+         *  scratch on every access.
+         */
+        void accumulateInto(ManagedArray<T>& result)
+        {
+            if (m_sparse)
+            {
+                // Each page covers a contiguous range of bins owned by
+                // exactly one loop iteration, so the writes are race-free.
+                util::forLoopWrapper(0, m_n_pages, [=, &result](size_t begin, size_t end) {
+                    for (size_t p = begin; p < end; ++p)
+                    {
+                        const size_t offset = p * m_page_size;
+                        size_t page_len = m_page_size;
+                        if (offset + page_len > result.size())
+                        {
+                            page_len = result.size() - offset;
+                        }
+                        for (auto pages = m_local_pages.begin(); pages != m_local_pages.end(); ++pages)
+                        {
+                            const std::vector<T>& page = (*pages)[p];
+                            if (page.empty())
+                            {
+                                continue;
+                            }
+                            for (size_t i = 0; i < page_len; ++i)
+                            {
+                                result[offset + i] += page[i];
+                            }
+                        }
+                    }
+                });
+                return;
+            }
+            // Collect the thread copies that were actually written to;
+            // threads that never touched the histogram cost nothing.
+            std::vector<const Histogram*> dirty;
+            for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
+            {
+                if (hist->m_dirty)
+                {
+                    dirty.push_back(&(*hist));
+                }
+            }
+            if (dirty.empty())
+            {
+                return;
+            }
+            const size_t size = result.size();
+            if (dirty.size() == 1)
+            {
+                const ManagedArray<T>& counts = dirty[0]->m_bin_counts;
+                util::forLoopWrapper(0, size, [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        result[i] += counts[i];
+                    }
+                });
+                return;
+            }
+            // Tree reduction: combine the copies pairwise in parallel until
+            // one array remains, rather than walking all T copies per bin.
+            // The copies themselves must stay intact (they keep accumulating
+            // across frames), so the first level pairs them into scratch
+            // arrays and later levels fold the scratch arrays onto each
+            // other.
+            size_t n = dirty.size();
+            std::vector<ManagedArray<T>> scratch((n + 1) / 2);
+            util::forLoopWrapper(0, scratch.size(), [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k)
                 {
-                    for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
+                    const ManagedArray<T>& first = dirty[2 * k]->m_bin_counts;
+                    // Every element is assigned below, so skip the zero fill.
+                    scratch[k].prepare({size}, false, false);
+                    if (2 * k + 1 < n)
                     {
-                        result[i] += hist->m_bin_counts[i];
+                        const ManagedArray<T>& second = dirty[2 * k + 1]->m_bin_counts;
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            scratch[k][i] = first[i] + second[i];
+                        }
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            scratch[k][i] = first[i];
+                        }
                     }
                 }
             });
+            n = scratch.size();
+            while (n > 1)
+            {
+                const size_t half = (n + 1) / 2;
+                util::forLoopWrapper(0, n - half, [&](size_t begin, size_t end) {
+                    for (size_t k = begin; k < end; ++k)
+                    {
+                        const ManagedArray<T>& other = scratch[k + half];
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            scratch[k][i] += other[i];
+                        }
+                    }
+                });
+                n = half;
+            }
+            util::forLoopWrapper(0, size, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    result[i] += scratch[0][i];
+                }
+            });
         }
 
     protected:
+        //! Find the linear bin of a value without a bin counts array.
+        /*! This mirrors Histogram::bin, but indexes through the shared axes
+         *  and the stored shape so the sparse mode never has to instantiate a
+         *  dense copy of the histogram.
+         */
+        size_t binSparse(const std::vector<float>& values) const
+        {
+            if (values.size() != m_axes.size())
+            {
+                std::ostringstream msg;
+                msg << "This Histogram is " << m_axes.size() << "-dimensional, but " << values.size()
+                    << " values were provided in bin" << std::endl;
+                throw std::invalid_argument(msg.str());
+            }
+            // Take the devirtualized path when every axis is regular.
+            if (m_binner.valid())
+            {
+                return m_binner.bin(values);
+            }
+            std::vector<size_t> ax_bins;
+            for (unsigned int ax_idx = 0; ax_idx < m_axes.size(); ++ax_idx)
+            {
+                size_t bin_i = m_axes[ax_idx]->bin(values[ax_idx]);
+                // Immediately return sentinel if any bin is out of bounds.
+                if (bin_i == Axis::OVERFLOW_BIN)
+                {
+                    return Axis::OVERFLOW_BIN;
+                }
+                ax_bins.push_back(bin_i);
+            }
+            return ManagedArray<T>::getIndex(m_shape, ax_bins);
+        }
+
+        //! Add weight to a bin of the local pages, allocating on first touch.
+        void incrementPage(size_t value_bin, T weight)
+        {
+            // Check for sentinel to avoid overflow.
+            if (value_bin == Axis::OVERFLOW_BIN)
+            {
+                return;
+            }
+            std::vector<std::vector<T>>& pages = m_local_pages.local();
+            std::vector<T>& page = pages[value_bin / m_page_size];
+            if (page.empty())
+            {
+                page.resize(m_page_size);
+            }
+            page[value_bin % m_page_size] += weight;
+        }
+
+        bool m_sparse {false}; //!< Whether per-thread storage is paged on first touch (default dense).
+        std::vector<std::shared_ptr<Axis>> m_axes; //!< Axes shared with the source histogram.
+        RegularBinner m_binner; //!< Devirtualized binner copied from the source histogram.
+        std::vector<size_t> m_shape;               //!< Shape of the source histogram.
+        size_t m_n_pages {0}; //!< Number of pages spanning the histogram in sparse mode.
         tbb::enumerable_thread_specific<Histogram<T>>
             m_local_histograms; //!< The thread-local copies of m_histogram.
+        tbb::enumerable_thread_specific<std::vector<std::vector<T>>>
+            m_local_pages; //!< The thread-local pages of counts in sparse mode.
+
+        static constexpr size_t m_page_size {4096}; //!< Number of histogram bins covered by one page.
     };
 
     using Axes = std::vector<std::shared_ptr<Axis>>;
@@ -281,7 +685,7 @@ public:
     Histogram() = default;
 
     //! Constructor
-    explicit Histogram(std::vector<std::shared_ptr<Axis>> axes) : m_axes(std::move(axes))
+    explicit Histogram(std::vector<std::shared_ptr<Axis>> axes) : m_axes(std::move(axes)), m_binner(m_axes)
     {
         std::vector<size_t> sizes(m_axes.size());
         std::transform(m_axes.begin(), m_axes.end(), sizes.begin(),
@@ -319,6 +723,7 @@ public:
         if (value_bin != Axis::OVERFLOW_BIN)
         {
             m_bin_counts[value_bin] += value_vector.second.value;
+            m_dirty = true;
         }
     }
 
@@ -329,6 +734,7 @@ public:
         if (value_bin != Axis::OVERFLOW_BIN)
         {
             m_bin_counts[value_bin] += weight;
+            m_dirty = true;
         }
     }
 
@@ -346,6 +752,11 @@ public:
                 << " values were provided in bin" << std::endl;
             throw std::invalid_argument(msg.str());
         }
+        // Take the devirtualized path when every axis is regular.
+        if (m_binner.valid())
+        {
+            return m_binner.bin(values);
+        }
         // First bin the values along each axis.
         std::vector<size_t> ax_bins;
         for (unsigned int ax_idx = 0; ax_idx < m_axes.size(); ++ax_idx)
@@ -378,6 +789,7 @@ public:
     void reset()
     {
         m_bin_counts.reset();
+        m_dirty = false;
     }
 
     //! Return the edges of bins.
@@ -482,14 +894,16 @@ public:
 
 protected:
     std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes.
+    RegularBinner m_binner;                    //!< Devirtualized binner when all axes are regular.
     ManagedArray<T> m_bin_counts;              //!< Counts for each bin
+    bool m_dirty {false}; //!< Whether any bin was written since construction or the last reset.
 
     //! The base case for type float when constructing a vector of values provided to operator().
     /*! This function and the accompanying recursive function below employ
      * variadic templating to accept an arbitrary set of float values and
      * construct a vector out of them.
      */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value) const
+    static std::pair<std::vector<float>, Weight<T>> getValueVector(float value)
     {
         return {{value}, Weight<T>()};
     }
@@ -499,14 +913,14 @@ protected:
      * variadic templating to accept an arbitrary set of float values and
      * construct a vector out of them.
      */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight) const
+    static std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight)
     {
         return {{}, weight};
     }
 
     //! The recursive case for constructing a vector of values (see base-case function docs).
     template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value, FloatsOrWeight... values) const
+    static std::pair<std::vector<float>, Weight<T>> getValueVector(float value, FloatsOrWeight... values)
     {
         std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
         tmp.first.insert(tmp.first.begin(), value);
@@ -515,7 +929,7 @@ protected:
 
     //! The recursive case for constructing a vector of values (see base-case function docs).
     template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight, FloatsOrWeight... values) const
+    static std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight, FloatsOrWeight... values)
     {
         std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
         tmp.second = weight;
@@ -0,0 +1,81 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+/*! \file Instrumentation.h
+    \brief Opt-in lightweight counters for freud's hot paths.
+
+    Setting the FREUD_INSTRUMENT environment variable (to any value) before
+    the process starts enables phase timers and throughput counters on the
+    compute classes as well as a process-wide tally of bytes allocated
+    through ManagedArray. When the variable is unset, every instrumentation
+    point reduces to a single cached boolean test, so the default overhead
+    is negligible. The counters are surfaced per compute object through
+    BondHistogramCompute::getInstrumentation().
+*/
+
+namespace freud { namespace util {
+
+//! Whether hot-path instrumentation is enabled for this process.
+/*! Read once from the FREUD_INSTRUMENT environment variable; the result is
+ *  cached for the lifetime of the process.
+ */
+inline bool instrumentationEnabled()
+{
+    static const bool enabled = (std::getenv("FREUD_INSTRUMENT") != nullptr);
+    return enabled;
+}
+
+//! Process-wide count of bytes allocated through ManagedArray.
+/*! Counts logical bytes requested by ManagedArray::prepare, including
+ *  buffers satisfied from the recycling pool. Only advanced when
+ *  instrumentation is enabled.
+ */
+inline std::atomic<unsigned long long>& managedArrayBytesAllocated()
+{
+    static std::atomic<unsigned long long> bytes {0};
+    return bytes;
+}
+
+//! Scope timer accumulating elapsed nanoseconds into a counter.
+/*! Does nothing (beyond the cached enabled test) when instrumentation is
+ *  off. The counter reference must outlive the timer.
+ */
+class PhaseTimer
+{
+public:
+    explicit PhaseTimer(unsigned long long& counter) : m_counter(counter)
+    {
+        if (instrumentationEnabled())
+        {
+            m_start = std::chrono::steady_clock::now();
+            m_active = true;
+        }
+    }
+
+    ~PhaseTimer()
+    {
+        if (m_active)
+        {
+            m_counter += static_cast<unsigned long long>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()
+                                                                     - m_start)
+                    .count());
+        }
+    }
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    unsigned long long& m_counter;               //!< Destination for the elapsed time.
+    std::chrono::steady_clock::time_point m_start; //!< Start of the timed scope.
+    bool m_active {false};                       //!< Whether instrumentation was on at construction.
+};
+
+}; }; // namespace freud::util
+
+#endif // INSTRUMENTATION_H
@@ -3,17 +3,44 @@
 
 #include <cstring>
 #include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include "Instrumentation.h"
+
 /*! \file ManagedArray.h
     \brief Defines the standard array class to be used throughout freud.
 */
 
 namespace freud { namespace util {
 
+//! Size threshold above which array buffers are backed by huge pages.
+/*! The default of 0 disables huge-page-backed allocation. When set to a
+ *  nonzero byte count (through freud::parallel::setHugePageThreshold),
+ *  buffers of at least that size are allocated as anonymous mappings advised
+ *  with MADV_HUGEPAGE, so the kernel can back the scattered accesses of
+ *  multi-GB histograms and neighbor lists with 2 MB pages and cut TLB
+ *  misses. Allocation falls back to the heap wherever the mapping or the
+ *  platform does not cooperate, so enabling this is always safe. Buffers
+ *  already retired to the recycling pool keep the policy they were
+ *  allocated under; call ManagedArray::clearPool to drop them after
+ *  changing the threshold.
+ */
+inline size_t& hugePageThresholdBytes()
+{
+    static size_t threshold = 0;
+    return threshold;
+}
+
 //! Class to handle the storage of all arrays of numerical data used in freud.
 /*! The purpose of this class is to handle standard memory management, and to
  *  provide an abstraction around the implementation-specific choice of
@@ -64,6 +91,25 @@ public:
      */
     explicit ManagedArray(size_t size) : ManagedArray(std::vector<size_t> {size}) {}
 
+    //! Construct an array viewing externally managed memory.
+    /*! The array does not copy the provided data; the shared pointer (which
+     *  may alias a larger allocation, e.g. a file mapping) keeps the
+     *  underlying memory alive for as long as any ManagedArray references it.
+     *
+     *  \param shape Shape of the viewed array.
+     *  \param data Pointer to existing data of the given shape.
+     */
+    ManagedArray(const std::vector<size_t>& shape, std::shared_ptr<T> data)
+    {
+        m_shape = std::make_shared<std::vector<size_t>>(shape);
+        m_size = std::make_shared<size_t>(1);
+        for (unsigned int i = m_shape->size() - 1; i != static_cast<unsigned int>(-1); --i)
+        {
+            (*m_size) *= (*m_shape)[i];
+        }
+        m_data = std::shared_ptr<std::shared_ptr<T>>(new std::shared_ptr<T>(std::move(data)));
+    }
+
     //! Destructor (currently empty because data is managed by shared pointer).
     ~ManagedArray() = default;
 
@@ -76,18 +122,28 @@ public:
     }
 
     //! Prepare for writing new data.
-    /*! This function always resets the array to contain zeros, but it will
-     * also reallocate if there are other ManagedArrays pointing to the data in
-     * order to ensure that those array references are not invalidated when
-     * this function clears the data.
+    /*! This function by default resets the array to contain zeros, but it
+     * will also reallocate if there are other ManagedArrays pointing to the
+     * data in order to ensure that those array references are not invalidated
+     * when this function clears the data.
+     *
+     * Large allocations are recycled through a pool shared by all arrays of
+     * this element type: retiring a buffer (when the last reference to it
+     * dies) returns it to the pool, and subsequent prepare calls of a
+     * matching size class reuse it instead of allocating. This keeps compute
+     * sessions whose array shapes alternate from frame to frame at their
+     * high-watermark memory use instead of reallocating every frame.
      *
      *  \param new_shape Shape of the array to allocate.
      *  \param force Reallocate regardless of whether anything changed or needs to be persisted.
+     *  \param zero Reset the contents to zeros (default). Callers that
+     *              overwrite every element before reading may pass false to
+     *              skip the memset; recycled buffers hold stale values, so
+     *              this is only safe for fully written arrays.
      */
-    void prepare(const std::vector<size_t>& new_shape, bool force = false)
+    void prepare(const std::vector<size_t>& new_shape, bool force = false, bool zero = true)
     {
-        // If we resized, or if there are outstanding references, we create a new array. No matter what,
-        // reset.
+        // If we resized, or if there are outstanding references, we create a new array.
         if (force || (m_data.use_count() > 1) || (new_shape != shape()))
         {
             m_shape = std::make_shared<std::vector<size_t>>(new_shape);
@@ -104,10 +160,35 @@ public:
             // with a different data structure like std::vector, but it would
             // require writing additional gymnastics to ensure proper reference
             // management and should be carefully considered before any rewrite.
-            m_data = std::shared_ptr<std::shared_ptr<T>>(new std::shared_ptr<T>(
-                new T[size()], std::default_delete<T[]>())); // NOLINT(modernize-avoid-c-arrays)
+            if (sizeof(T) * size() >= m_pool_threshold_bytes)
+            {
+                // Drop our reference first: if nothing else holds the old
+                // buffer it retires to the pool now, so an acquire of the
+                // same size class below reuses it immediately.
+                m_data.reset();
+                m_data = std::shared_ptr<std::shared_ptr<T>>(
+                    new std::shared_ptr<T>(BufferPool::get().acquire(size())));
+            }
+            else
+            {
+                m_data = std::shared_ptr<std::shared_ptr<T>>(new std::shared_ptr<T>(
+                    new T[size()], std::default_delete<T[]>())); // NOLINT(modernize-avoid-c-arrays)
+            }
+            if (instrumentationEnabled())
+            {
+                managedArrayBytesAllocated() += sizeof(T) * size();
+            }
+        }
+        if (zero)
+        {
+            reset();
         }
-        reset();
+    }
+
+    //! Release all pooled buffers for this element type.
+    static void clearPool()
+    {
+        BufferPool::get().clear();
     }
 
     //! Reset the contents of array to be 0.
@@ -344,6 +425,136 @@ public:
     }
 
 private:
+    //! Pool of retired buffers, shared by all arrays of this element type.
+    /*! Buffers are bucketed by power-of-two size class; acquire hands out a
+     *  buffer of at least the requested capacity and wires its deleter to
+     *  return the buffer here once the last reference (including any numpy
+     *  views on the Python side) is gone. The singleton is intentionally
+     *  leaked so deleters running during static destruction stay valid.
+     */
+    class BufferPool
+    {
+    public:
+        static BufferPool& get()
+        {
+            static BufferPool* pool = new BufferPool(); // NOLINT(cppcoreguidelines-owning-memory)
+            return *pool;
+        }
+
+        //! Get a buffer of at least n elements, reusing a pooled one if possible.
+        std::shared_ptr<T> acquire(size_t n)
+        {
+            const size_t capacity = sizeClass(n);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto& bucket = m_buckets[capacity];
+                if (!bucket.empty())
+                {
+                    const Buffer buffer = bucket.back();
+                    bucket.pop_back();
+                    return wrap(buffer, capacity);
+                }
+            }
+            return wrap(allocateBuffer(capacity), capacity);
+        }
+
+        //! Free every pooled buffer.
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& bucket : m_buckets)
+            {
+                for (const Buffer& buffer : bucket.second)
+                {
+                    freeBuffer(buffer, bucket.first);
+                }
+            }
+            m_buckets.clear();
+        }
+
+    private:
+        //! A pooled allocation and how it was obtained.
+        struct Buffer
+        {
+            T* pointer;
+            bool huge; //!< Whether the buffer is an anonymous mapping rather than heap memory.
+        };
+
+        //! Allocate a buffer, using a huge-page-advised mapping when configured.
+        /*! The mapping path is restricted to trivially copyable element types
+         *  (all-zero pages are a valid initial state for them, matching what
+         *  reset() produces) and falls back to the heap whenever the mapping
+         *  fails or the platform lacks the interfaces.
+         */
+        static Buffer allocateBuffer(size_t capacity)
+        {
+#if !defined(_WIN32) && defined(MADV_HUGEPAGE)
+            const size_t threshold = hugePageThresholdBytes();
+            const size_t bytes = capacity * sizeof(T);
+            if (threshold != 0 && bytes >= threshold && std::is_trivially_copyable<T>::value)
+            {
+                void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (map != MAP_FAILED)
+                {
+                    // Advisory only: if transparent huge pages are unavailable
+                    // the mapping simply stays on base pages.
+                    madvise(map, bytes, MADV_HUGEPAGE);
+                    return {static_cast<T*>(map), true};
+                }
+            }
+#endif
+            return {new T[capacity], false}; // NOLINT(modernize-avoid-c-arrays)
+        }
+
+        //! Free a buffer through the mechanism it was allocated with.
+        static void freeBuffer(const Buffer& buffer, size_t capacity)
+        {
+#ifndef _WIN32
+            if (buffer.huge)
+            {
+                munmap(buffer.pointer, capacity * sizeof(T));
+                return;
+            }
+#endif
+            (void) capacity;
+            delete[] buffer.pointer;
+        }
+        //! Round a capacity up to its bucket's size.
+        static size_t sizeClass(size_t n)
+        {
+            size_t capacity = m_pool_threshold_bytes / sizeof(T);
+            if (capacity == 0)
+            {
+                capacity = 1;
+            }
+            while (capacity < n)
+            {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+
+        std::shared_ptr<T> wrap(const Buffer& buffer, size_t capacity)
+        {
+            const bool huge = buffer.huge;
+            return std::shared_ptr<T>(buffer.pointer,
+                                      [capacity, huge](T* buf) { get().release({buf, huge}, capacity); });
+        }
+
+        void release(const Buffer& buffer, size_t capacity)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_buckets[capacity].push_back(buffer);
+        }
+
+        std::mutex m_mutex;
+        std::map<size_t, std::vector<Buffer>> m_buckets; //!< Retired buffers per size class
+    };
+
+    //! Minimum allocation size drawn from the pool; smaller arrays are cheap
+    //! to allocate directly and would only bloat the buckets.
+    static constexpr size_t m_pool_threshold_bytes {4096};
+
     //! The base case for building up the index.
     /*! These argument building functions are templated on two types, one that
      *  encapsulates the current object being operated on and the other being
@@ -371,6 +582,8 @@ private:
     std::shared_ptr<size_t> m_size;               //!< Size of array.
 };
 
+template<typename T> constexpr size_t ManagedArray<T>::m_pool_threshold_bytes;
+
 }; }; // end namespace freud::util
 
 #endif
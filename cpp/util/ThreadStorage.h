@@ -3,6 +3,9 @@
 
 #include "ManagedArray.h"
 #include "utils.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <tbb/enumerable_thread_specific.h>
 #include <vector>
 
@@ -10,6 +13,12 @@ namespace freud { namespace util {
 
 //! Wrapper class for enumerable_thread_specific<T*>
 /*! It is expected that default value for T is 0.
+ *
+ *  The thread-local arrays are allocated by the first touching thread, from
+ *  fresh (never recycled) memory, and are padded out to whole cache lines:
+ *  on NUMA machines the first touch places each thread's pages on that
+ *  thread's own node, and the padding keeps two threads' small arrays (e.g.
+ *  per-thread scalar accumulators) from ever sharing a cache line.
  */
 template<typename T> class ThreadStorage
 {
@@ -28,8 +37,8 @@ public:
     /*! \param shape Vector of sizes in each dimension of the thread local arrays
      */
     explicit ThreadStorage(const std::vector<size_t>& shape)
-        : arrays(
-            tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); }))
+        : arrays(tbb::enumerable_thread_specific<ManagedArray<T>>(
+            [shape]() { return makeFirstTouch(shape); }))
     {}
 
     //! Destructor
@@ -48,8 +57,8 @@ public:
      */
     void resize(std::vector<size_t> shape)
     {
-        arrays
-            = tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); });
+        arrays = tbb::enumerable_thread_specific<ManagedArray<T>>(
+            [shape]() { return makeFirstTouch(shape); });
     }
 
     //! Reset the contents of thread local arrays to be 0
@@ -101,11 +110,13 @@ public:
         }
         else
         {
-            // Reduce over arrays into the result array.
+            // Reduce over arrays into the result array. Each thread array is
+            // streamed over the whole block before the next one so the inner
+            // loop is a plain contiguous accumulation.
             util::forLoopWrapper(0, result.size(), [=, &result](size_t begin, size_t end) {
-                for (size_t i = begin; i < end; ++i)
+                for (auto arr = arrays.begin(); arr != arrays.end(); ++arr)
                 {
-                    for (auto arr = arrays.begin(); arr != arrays.end(); ++arr)
+                    for (size_t i = begin; i < end; ++i)
                     {
                         result[i] += (*arr)[i];
                     }
@@ -115,6 +126,40 @@ public:
     }
 
 private:
+    //! Build one thread's array from fresh, cache-line padded memory.
+    /*! The enumerable_thread_specific initializer runs on the owning thread
+     *  at its first local() call, so the zero fill here is that thread's
+     *  first touch of the pages and places them on its own NUMA node. The
+     *  allocation deliberately bypasses the ManagedArray buffer pool, whose
+     *  recycled buffers would carry another thread's placement, and both the
+     *  start and the length are aligned to whole cache lines so neighboring
+     *  threads' arrays never false-share.
+     */
+    static ManagedArray<T> makeFirstTouch(const std::vector<size_t>& shape)
+    {
+        size_t n = 1;
+        for (const size_t dim : shape)
+        {
+            n *= dim;
+        }
+        if (n == 0)
+        {
+            return ManagedArray<T>(shape);
+        }
+        const size_t cache_line = 64;
+        const size_t bytes = ((n * sizeof(T) + cache_line - 1) / cache_line) * cache_line;
+        std::shared_ptr<char> block(new char[bytes + cache_line], // NOLINT(modernize-avoid-c-arrays)
+                                    std::default_delete<char[]>());
+        char* aligned = reinterpret_cast<char*>(
+            (reinterpret_cast<uintptr_t>(block.get()) + (cache_line - 1)) & ~uintptr_t(cache_line - 1));
+        // First touch: zero the padded block on the calling thread.
+        memset(aligned, 0, bytes);
+        // The aliasing constructor keeps the whole block alive while exposing
+        // the aligned start.
+        std::shared_ptr<T> data(block, reinterpret_cast<T*>(aligned));
+        return ManagedArray<T>(shape, std::move(data));
+    }
+
     tbb::enumerable_thread_specific<ManagedArray<T>> arrays; //!< thread local arrays
 };
 
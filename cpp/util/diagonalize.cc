@@ -1,7 +1,102 @@
+#include <algorithm>
+#include <cmath>
+
 #include "diagonalize.h"
+#include "utils.h"
 
 namespace freud { namespace util {
 
+namespace {
+
+//! Cross product of two rows of (A - lambda * I), used to find eigenvectors.
+inline void crossRows(const double r0[3], const double r1[3], double out[3])
+{
+    out[0] = r0[1] * r1[2] - r0[2] * r1[1];
+    out[1] = r0[2] * r1[0] - r0[0] * r1[2];
+    out[2] = r0[0] * r1[1] - r0[1] * r1[0];
+}
+
+inline double norm3(const double v[3])
+{
+    return std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+}
+
+//! Find a unit eigenvector of the symmetric matrix a for eigenvalue lambda.
+/*! The eigenvector is orthogonal to every row of (A - lambda * I), so for a
+ * simple eigenvalue it can be read off as the largest cross product of two
+ * rows. Returns false when all cross products vanish, i.e. when the
+ * eigenvalue is (numerically) repeated and the caller must pick a direction
+ * within the eigenspace itself.
+ */
+inline bool eigenvectorFromCrossProducts(const double a[6], double lambda, double tolerance, double out[3])
+{
+    const double r0[3] = {a[0] - lambda, a[1], a[2]};
+    const double r1[3] = {a[1], a[3] - lambda, a[4]};
+    const double r2[3] = {a[2], a[4], a[5] - lambda};
+
+    double c01[3];
+    double c02[3];
+    double c12[3];
+    crossRows(r0, r1, c01);
+    crossRows(r0, r2, c02);
+    crossRows(r1, r2, c12);
+
+    const double n01 = norm3(c01);
+    const double n02 = norm3(c02);
+    const double n12 = norm3(c12);
+
+    const double* best = c01;
+    double best_norm = n01;
+    if (n02 > best_norm)
+    {
+        best = c02;
+        best_norm = n02;
+    }
+    if (n12 > best_norm)
+    {
+        best = c12;
+        best_norm = n12;
+    }
+    if (best_norm <= tolerance)
+    {
+        return false;
+    }
+    out[0] = best[0] / best_norm;
+    out[1] = best[1] / best_norm;
+    out[2] = best[2] / best_norm;
+    return true;
+}
+
+//! Pick any unit vector orthogonal to v.
+inline void anyOrthogonal(const double v[3], double out[3])
+{
+    // Cross v with the coordinate axis it is least aligned with.
+    if (std::abs(v[0]) <= std::abs(v[1]) && std::abs(v[0]) <= std::abs(v[2]))
+    {
+        out[0] = 0;
+        out[1] = -v[2];
+        out[2] = v[1];
+    }
+    else if (std::abs(v[1]) <= std::abs(v[2]))
+    {
+        out[0] = v[2];
+        out[1] = 0;
+        out[2] = -v[0];
+    }
+    else
+    {
+        out[0] = -v[1];
+        out[1] = v[0];
+        out[2] = 0;
+    }
+    const double n = norm3(out);
+    out[0] /= n;
+    out[1] /= n;
+    out[2] /= n;
+}
+
+} // namespace
+
 void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::ManagedArray<float>& eigen_vals,
                                   util::ManagedArray<float>& eigen_vecs)
 {
@@ -32,4 +127,138 @@ void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::Ma
     }
 }
 
+void diagonalize33SymmetricMatrices(const util::ManagedArray<float>& mats,
+                                    util::ManagedArray<float>& eigen_vals,
+                                    util::ManagedArray<float>& eigen_vecs)
+{
+    const unsigned int num_matrices = mats.shape()[0];
+
+    util::forLoopWrapper(0, num_matrices, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float* mat = mats.get() + i * 9;
+            float* vals = eigen_vals.get() + i * 3;
+            float* vecs = eigen_vecs.get() + i * 9;
+
+            // Work on a normalized copy of the six unique entries so the
+            // degeneracy tolerances below are scale-invariant.
+            double a[6] = {mat[0], mat[1], mat[2], mat[4], mat[5], mat[8]};
+            double scale = 0;
+            for (double entry : a)
+            {
+                scale = std::max(scale, std::abs(entry));
+            }
+            if (scale == 0)
+            {
+                // The zero matrix: mirror the failure convention of the
+                // single-matrix solver (zero eigenvalues, identity vectors).
+                std::fill(vals, vals + 3, 0.0F);
+                std::fill(vecs, vecs + 9, 0.0F);
+                vecs[0] = vecs[4] = vecs[8] = 1.0F;
+                continue;
+            }
+            for (double& entry : a)
+            {
+                entry /= scale;
+            }
+
+            // Eigenvalues by the trigonometric (Cardano) solution of the
+            // characteristic polynomial of the deviatoric part.
+            const double q = (a[0] + a[3] + a[5]) / 3.0;
+            const double off_norm_sq = a[1] * a[1] + a[2] * a[2] + a[4] * a[4];
+            const double p2 = (a[0] - q) * (a[0] - q) + (a[3] - q) * (a[3] - q) + (a[5] - q) * (a[5] - q)
+                + 2.0 * off_norm_sq;
+            double lambda[3];
+            if (p2 <= 0)
+            {
+                // Isotropic matrix.
+                lambda[0] = lambda[1] = lambda[2] = q;
+            }
+            else
+            {
+                const double p = std::sqrt(p2 / 6.0);
+                const double b00 = (a[0] - q) / p;
+                const double b11 = (a[3] - q) / p;
+                const double b22 = (a[5] - q) / p;
+                const double b01 = a[1] / p;
+                const double b02 = a[2] / p;
+                const double b12 = a[4] / p;
+                const double half_det = 0.5
+                    * (b00 * (b11 * b22 - b12 * b12) - b01 * (b01 * b22 - b12 * b02)
+                       + b02 * (b01 * b12 - b11 * b02));
+                const double phi = std::acos(std::min(1.0, std::max(-1.0, half_det))) / 3.0;
+                lambda[2] = q + 2.0 * p * std::cos(phi);
+                lambda[0] = q + 2.0 * p * std::cos(phi + 2.0 * M_PI / 3.0);
+                lambda[1] = 3.0 * q - lambda[0] - lambda[2];
+            }
+
+            // Eigenvectors from cross products of rows of (A - lambda * I),
+            // falling back to an explicit orthogonal frame when an eigenvalue
+            // is numerically repeated.
+            const double tolerance = 1e-12;
+            double v0[3];
+            double v1[3];
+            double v2[3];
+            if (eigenvectorFromCrossProducts(a, lambda[0], tolerance, v0))
+            {
+                if (!eigenvectorFromCrossProducts(a, lambda[1], tolerance, v1))
+                {
+                    anyOrthogonal(v0, v1);
+                }
+                else
+                {
+                    // Remove any component along v0 picked up through
+                    // round-off so the returned frame is orthonormal.
+                    const double proj = v1[0] * v0[0] + v1[1] * v0[1] + v1[2] * v0[2];
+                    v1[0] -= proj * v0[0];
+                    v1[1] -= proj * v0[1];
+                    v1[2] -= proj * v0[2];
+                    const double n = norm3(v1);
+                    if (n <= tolerance)
+                    {
+                        anyOrthogonal(v0, v1);
+                    }
+                    else
+                    {
+                        v1[0] /= n;
+                        v1[1] /= n;
+                        v1[2] /= n;
+                    }
+                }
+                crossRows(v0, v1, v2);
+            }
+            else if (eigenvectorFromCrossProducts(a, lambda[2], tolerance, v2))
+            {
+                // lambda[0] is repeated; any frame spanning its plane works.
+                anyOrthogonal(v2, v0);
+                crossRows(v2, v0, v1);
+            }
+            else
+            {
+                // Fully degenerate (isotropic) matrix.
+                v0[0] = 1;
+                v0[1] = 0;
+                v0[2] = 0;
+                v1[0] = 0;
+                v1[1] = 1;
+                v1[2] = 0;
+                v2[0] = 0;
+                v2[1] = 0;
+                v2[2] = 1;
+            }
+
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                vals[k] = static_cast<float>(lambda[k] * scale);
+            }
+            for (unsigned int k = 0; k < 3; ++k)
+            {
+                vecs[k] = static_cast<float>(v0[k]);
+                vecs[3 + k] = static_cast<float>(v1[k]);
+                vecs[6 + k] = static_cast<float>(v2[k]);
+            }
+        }
+    });
+}
+
 }; }; // namespace freud::util
@@ -23,5 +23,27 @@ namespace freud { namespace util {
 void diagonalize33SymmetricMatrix(const util::ManagedArray<float>& mat, util::ManagedArray<float>& eigen_vals,
                                   util::ManagedArray<float>& eigen_vecs);
 
+//! Compute eigenvalues and eigenvectors for a batch of self-adjoint 3x3 matrices.
+/*! Batched counterpart of diagonalize33SymmetricMatrix for callers that
+ * diagonalize many small matrices at once (e.g. per-cluster inertia tensors).
+ * Rather than constructing an iterative solver per matrix, this uses the
+ * analytic Cardano solution for the eigenvalues with a cross-product scheme
+ * for the eigenvectors, evaluated as straight-line arithmetic so the compiler
+ * can vectorize it, and parallelized over the batch. The intermediate
+ * arithmetic is performed in double precision to keep the analytic formulas
+ * well-conditioned.
+ *
+ * The output conventions match diagonalize33SymmetricMatrix: for matrix i,
+ * eigenvalues are stored in increasing order in eigen_vals(i, ...) and the
+ * corresponding eigenvectors are the rows of eigen_vecs(i, ..., ...).
+ *
+ *  \param mats The matrices to diagonalize, shape {N, 3, 3}.
+ *  \param eigen_vals The eigenvalues, shape {N, 3}.
+ *  \param eigen_vecs The eigenvectors as rows, shape {N, 3, 3}.
+ */
+void diagonalize33SymmetricMatrices(const util::ManagedArray<float>& mats,
+                                    util::ManagedArray<float>& eigen_vals,
+                                    util::ManagedArray<float>& eigen_vecs);
+
 }; }; // namespace freud::util
 #endif
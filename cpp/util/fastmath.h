@@ -0,0 +1,85 @@
+// Copyright (c) 2010-2020 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <algorithm>
+#include <cmath>
+
+/*! \file fastmath.h
+    \brief Polynomial approximations of transcendental functions.
+
+    These are used by computes that are transcendental-bound in their inner
+    loops and offer an opt-in fast-math path. The approximations are accurate
+    to a small fraction of a histogram bin width for typical bin counts, so
+    only bonds lying essentially on a bin edge can be binned differently from
+    the exact library calls.
+*/
+
+namespace freud { namespace util {
+
+//! Polynomial approximation of atan2, accurate to ~1e-6 radians.
+/*! Evaluates a minimax arctangent polynomial on the argument reduced to
+ *  [0, 1], with octant corrections. Returns angles in (-pi, pi] like
+ *  std::atan2.
+ */
+inline float fastAtan2(float y, float x)
+{
+    const float abs_y = std::abs(y);
+    const float abs_x = std::abs(x);
+    const float max_coord = std::max(abs_x, abs_y);
+    if (max_coord == 0)
+    {
+        return 0;
+    }
+    const float a = std::min(abs_x, abs_y) / max_coord;
+    const float s = a * a;
+    float r = a
+        * (0.99997726F
+           + s * (-0.33262347F + s * (0.19354346F + s * (-0.11643287F + s * (0.05265332F - s * 0.01172120F)))));
+    if (abs_y > abs_x)
+    {
+        r = float(M_PI / 2.0) - r;
+    }
+    if (x < 0)
+    {
+        r = float(M_PI) - r;
+    }
+    return (y < 0) ? -r : r;
+}
+
+//! Polynomial approximation of acos, accurate to ~7e-5 radians.
+/*! Abramowitz & Stegun (4.4.45), reflected onto [-1, 0] for negative
+ *  arguments. The input is clamped to [-1, 1] so that rounding in the
+ *  normalization of a unit vector cannot produce NaN.
+ */
+inline float fastAcos(float x)
+{
+    x = std::min(1.0F, std::max(-1.0F, x));
+    const float a = std::abs(x);
+    const float r
+        = std::sqrt(1.0F - a) * (1.5707288F + a * (-0.2121144F + a * (0.0742610F - a * 0.0187293F)));
+    return (x < 0) ? float(M_PI) - r : r;
+}
+
+//! Bin an unwrapped angle on a full-circle axis.
+/*! Folds the periodic wrap of the angle into the integer bin index, so
+ *  neither the float modulus nor the axis range checks have to run per
+ *  value. The angle may be any real number; inv_bin_width must be
+ *  n_bins / (2*pi) for an axis spanning [0, 2*pi).
+ */
+inline size_t foldedAngularBin(float angle, float inv_bin_width, size_t n_bins)
+{
+    long bin = long(std::floor(angle * inv_bin_width));
+    bin %= long(n_bins);
+    if (bin < 0)
+    {
+        bin += long(n_bins);
+    }
+    return size_t(bin);
+}
+
+}; }; // end namespace freud::util
+
+#endif // FAST_MATH_H
@@ -2,10 +2,13 @@
 #define UTILS_H
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 #include <tbb/blocked_range.h>
 #include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 namespace freud { namespace util {
 
@@ -26,24 +29,151 @@ template<class Scalar> inline Scalar modulusPositive(Scalar a, Scalar b)
     return std::fmod(std::fmod(a, b) + b, b);
 }
 
+//! Global override for the adaptive grain size of forLoopWrapper.
+/*! A value of 0 (the default) enables the per-call-site adaptive policy
+ *  below; any other value is used directly as the grain size of every
+ *  parallel loop. Exposed to users through freud.parallel.
+ */
+inline size_t& forLoopGrainOverride()
+{
+    static size_t grain {0};
+    return grain;
+}
+
+//! Ambient task arena for this thread's parallel loops (null = global arena).
+/*! Installed by ComputeArenaScope; consulted by forLoopWrapper and
+ *  forLoopWrapper2D through runInComputeArena().
+ */
+inline tbb::task_arena*& currentComputeArena()
+{
+    static thread_local tbb::task_arena* arena {nullptr};
+    return arena;
+}
+
+//! Install a task arena as the ambient arena of this thread's parallel loops.
+/*! While a scope is active, every parallel loop executed on this thread
+ *  submits its work inside the given arena, so the work is bounded by the
+ *  arena's concurrency limit and scheduled at the arena's priority instead
+ *  of competing freely in the global arena. Scopes restore the previous
+ *  ambient arena on destruction and may nest; a null arena runs loops in
+ *  the global arena as usual.
+ */
+class ComputeArenaScope
+{
+public:
+    explicit ComputeArenaScope(tbb::task_arena* arena) : m_previous(currentComputeArena())
+    {
+        currentComputeArena() = arena;
+    }
+
+    ~ComputeArenaScope()
+    {
+        currentComputeArena() = m_previous;
+    }
+
+    ComputeArenaScope(const ComputeArenaScope&) = delete;
+    ComputeArenaScope& operator=(const ComputeArenaScope&) = delete;
+
+private:
+    tbb::task_arena* m_previous; //!< The ambient arena to restore on destruction.
+};
+
+//! Run a parallel region inside the ambient arena, if one is installed.
+/*! The ambient pointer is cleared for the duration of the region so loops
+ *  nested inside the arena run directly in it rather than re-entering
+ *  execute().
+ */
+template<typename F> inline void runInComputeArena(const F& f)
+{
+    tbb::task_arena* arena = currentComputeArena();
+    if (arena == nullptr)
+    {
+        f();
+        return;
+    }
+    ComputeArenaScope inner(nullptr);
+    arena->execute(f);
+}
+
 //! Wrapper for for-loop to allow the execution in parallel or not.
 /*! \param begin Beginning index.
  *  \param end Ending index.
  *  \param body An object with operator(size_t begin, size_t end).
  *  \param parallel If true, run body in parallel.
+ *
+ *  Parallel loops use an adaptive grain size. The default TBB grain of 1
+ *  lets the auto-partitioner split tiny per-frame loops into far more tasks
+ *  than the work warrants, so scheduling overhead dominates small systems,
+ *  while very cheap iterations in huge loops end up under-chunked. On the
+ *  first execution of each call site the loop runs with the default grain
+ *  and is timed; from the estimated per-iteration cost a grain is chosen so
+ *  that each task carries enough work to amortize its scheduling, and that
+ *  grain persists for every later execution of the same site (e.g. across
+ *  the frames of a trajectory loop). Loops whose whole range is cheaper
+ *  than a single task dispatch simply run serially. Each call site passes
+ *  its own lambda and therefore instantiates its own copy of this template,
+ *  so the static tuning state is naturally per site.
  */
 template<typename Body>
 inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool parallel = true)
 {
-    if (parallel)
+    if (!parallel)
     {
-        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
-                          [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        body(begin, end);
+        return;
     }
-    else
+    const size_t override_grain = forLoopGrainOverride();
+    if (override_grain != 0)
+    {
+        runInComputeArena([&]() {
+            tbb::parallel_for(tbb::blocked_range<size_t>(begin, end, override_grain),
+                              [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        });
+        return;
+    }
+    // One tuned grain per call site (see above); 0 means not yet tuned.
+    static std::atomic<size_t> tuned_grain {0};
+    size_t grain = tuned_grain.load(std::memory_order_relaxed);
+    if (grain == 0)
+    {
+        // The concurrency is queried inside the region so it reflects the
+        // arena the timed run actually executed in.
+        size_t threads = 1;
+        const auto start = std::chrono::steady_clock::now();
+        runInComputeArena([&]() {
+            tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
+                              [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+            threads = static_cast<size_t>(tbb::this_task_arena::max_concurrency());
+        });
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - start)
+                                 .count();
+        const size_t n = end - begin;
+        if (n == 0 || elapsed <= 0)
+        {
+            // Nothing to learn from an empty or unmeasurably fast range;
+            // leave the site untuned and try again next time.
+            return;
+        }
+        // The timed run used all threads, so the serial cost of one
+        // iteration is roughly elapsed * threads / n. Size the grain so
+        // each task carries about target_task_ns of work.
+        const size_t target_task_ns = 50000;
+        const auto total_ns = static_cast<size_t>(elapsed) * std::max<size_t>(threads, 1);
+        grain = std::max<size_t>(1, std::min(n, (target_task_ns * n) / total_ns));
+        tuned_grain.store(grain, std::memory_order_relaxed);
+        return;
+    }
+    if (grain >= end - begin)
     {
+        // The whole range is cheaper than one task dispatch.
         body(begin, end);
+        return;
     }
+    runInComputeArena([&]() {
+        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end, grain),
+                          [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+    });
 }
 
 //! Wrapper for 2D nested for loops to allow the execution in parallel or not.
@@ -60,10 +190,13 @@ inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col,
 {
     if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
-                          [&body](const tbb::blocked_range2d<size_t>& r) {
-                              body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-                          });
+        runInComputeArena([&]() {
+            tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
+                              [&body](const tbb::blocked_range2d<size_t>& r) {
+                                  body(r.rows().begin(), r.rows().end(), r.cols().begin(),
+                                       r.cols().end());
+                              });
+        });
     }
     else
     {
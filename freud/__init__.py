@@ -17,7 +17,7 @@ from . import (
 )
 from .box import Box
 from .locality import AABBQuery, LinkCell, NeighborList
-from .parallel import NumThreads, get_num_threads, set_num_threads
+from .parallel import NumThreads, get_num_threads, set_loop_grain_size, set_num_threads
 
 # Override TBB's default autoselection. This is necessary because once the
 # automatic selection runs, the user cannot change it.
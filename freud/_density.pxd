@@ -42,6 +42,9 @@ cdef extern from "LocalDensity.h" namespace "freud::density":
             const vec3[float]*,
             unsigned int, const freud._locality.NeighborList *,
             freud._locality.QueryArgs) except +
+        void computeFromNlist(
+            const freud._box.Box &,
+            const freud._locality.NeighborList *) except +
         const freud.util.ManagedArray[float] &getDensity() const
         const freud.util.ManagedArray[float] &getNumNeighbors() const
         float getRMax() const
@@ -56,6 +59,11 @@ cdef extern from "RDF.h" namespace "freud::density":
                         unsigned int,
                         const freud._locality.NeighborList*,
                         freud._locality.QueryArgs) except +
+        void accumulateFrames(const freud._box.Box*,
+                              const vec3[float]*,
+                              unsigned int,
+                              unsigned int,
+                              freud._locality.QueryArgs) except +
         const freud.util.ManagedArray[float] &getRDF()
         const freud.util.ManagedArray[float] &getNr()
 
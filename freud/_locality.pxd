@@ -4,6 +4,7 @@
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr
 from libcpp.pair cimport pair
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 
 cimport freud._box
@@ -93,6 +94,8 @@ cdef extern from "NeighborList.h" namespace "freud::locality":
         void resize(unsigned int)
         void copy(const NeighborList &)
         void validate(unsigned int, unsigned int) except +
+        void save(const string &) except +
+        void load(const string &) except +
 
 cdef extern from "LinkCell.h" namespace "freud::locality":
     cdef cppclass LinkCell(NeighborQuery):
@@ -3,3 +3,4 @@
 
 cdef extern from "tbb_config.h" namespace "freud::parallel":
     void setNumThreads(unsigned int)
+    void setLoopGrainSize(unsigned int)
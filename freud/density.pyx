@@ -11,9 +11,11 @@ import warnings
 
 import numpy as np
 
+import freud.box
 import freud.locality
 
 from cython.operator cimport dereference
+from libcpp.vector cimport vector
 
 from freud.locality cimport _PairCompute, _SpatialHistogram1D
 from freud.util cimport _Compute, vec3
@@ -22,6 +24,7 @@ from collections.abc import Sequence
 
 cimport numpy as np
 
+cimport freud._box
 cimport freud._density
 cimport freud.box
 cimport freud.locality
@@ -532,6 +535,29 @@ cdef class LocalDensity(_PairCompute):
             dereference(qargs.thisptr))
         return self
 
+    def compute_from_nlist(self, box, nlist):
+        r"""Calculates the local density from an existing neighbor list.
+
+        Reuses a :class:`NeighborList <freud.locality.NeighborList>` built by
+        another analysis (such as an RDF over the same frame) instead of
+        running a redundant ball query. The list may have been built with a
+        larger ``r_max`` than this object's query radius; bonds beyond
+        ``r_max + 0.5 * diameter`` are ignored, so the results match
+        :meth:`~.compute` over the same frame.
+
+        Args:
+            box (:class:`freud.box.Box`):
+                The box of the frame the neighbor list was built from.
+            nlist (:class:`freud.locality.NeighborList`):
+                Neighbor pairs with distances to consume.
+        """
+        cdef freud.box.Box b = freud.box.Box.from_box(box)
+        cdef freud.locality.NeighborList l_nlist = nlist
+        self.thisptr.computeFromNlist(
+            dereference(b.thisptr), l_nlist.get_ptr())
+        self._called_compute = True
+        return self
+
     @property
     def default_query_args(self):
         """The default query arguments are
@@ -666,6 +692,59 @@ cdef class RDF(_SpatialHistogram1D):
             dereference(qargs.thisptr))
         return self
 
+    def compute_frames(self, boxes, points, neighbors=None, reset=True):
+        r"""Accumulate a whole block of frames in one call.
+
+        Equivalent to calling :meth:`~.compute` once per frame with
+        ``reset=False``, but the build/query/bin pipeline for every frame
+        runs inside a single C++ call with the frames distributed over
+        threads, avoiding the per-frame Python and
+        :class:`freud.locality.NeighborQuery` construction overhead that
+        dominates trajectory averaging for small systems.
+
+        Args:
+            boxes (sequence of :class:`freud.box.Box`):
+                One box per frame.
+            points ((:math:`N_{frames}`, :math:`N_{points}`, 3) :class:`numpy.ndarray`):
+                Positions for every frame; each frame's points are used as
+                their own query points.
+            neighbors (dict, optional):
+                A dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        if reset:
+            self._reset()
+
+        points = freud.util._convert_array(points, shape=(None, None, 3))
+        if len(boxes) != points.shape[0]:
+            raise ValueError(
+                "One box must be provided for each frame of points.")
+
+        cdef vector[freud._box.Box] l_boxes
+        for b in boxes:
+            l_boxes.push_back(
+                dereference((<freud.box.Box> freud.box.Box.from_box(b)).thisptr))
+
+        query_args = self.default_query_args if neighbors is None \
+            else neighbors.copy()
+        query_args.setdefault('exclude_ii', True)
+        cdef freud.locality._QueryArgs qargs = \
+            freud.locality._QueryArgs.from_dict(query_args)
+
+        cdef const float[:, :, ::1] l_points = points
+        self.thisptr.accumulateFrames(
+            l_boxes.data(),
+            <vec3[float]*> &l_points[0, 0, 0],
+            points.shape[0], points.shape[1],
+            dereference(qargs.thisptr))
+        self._called_compute = True
+        return self
+
     @_Compute._computed_property
     def rdf(self):
         """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Histogram of RDF
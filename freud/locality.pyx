@@ -702,6 +702,29 @@ cdef class NeighborList:
         self.thisptr.filter_r(r_max, r_min)
         return self
 
+    def save(self, filename):
+        r"""Save the bonds to a binary file.
+
+        The file stores the bond arrays together with the segment and
+        neighbor count arrays, so it can be reloaded with :meth:`load`
+        without any recomputation. Where the platform allows, loading
+        memory-maps the file instead of reading it into memory.
+
+        Args:
+            filename (str): Name of the file to write.
+        """
+        self.thisptr.save(filename.encode('utf-8'))
+
+    def load(self, filename):
+        r"""Replace the contents of this object with bonds loaded from a file
+        written by :meth:`save`.
+
+        Args:
+            filename (str): Name of the file to read.
+        """
+        self.thisptr.load(filename.encode('utf-8'))
+        return self
+
 
 cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     """Create a Python NeighborList object that points to an existing C++
@@ -40,6 +40,28 @@ def set_num_threads(nthreads=None):
     freud._parallel.setNumThreads(cNthreads)
 
 
+def set_loop_grain_size(grain=None):
+    r"""Override the grain size of freud's parallel loops.
+
+    By default freud tunes the grain size of each parallel loop adaptively
+    from its measured per-iteration cost, so that scheduling overhead stays
+    small for both tiny and huge loops. This function replaces the adaptive
+    policy with a fixed grain size for all loops, which can help when
+    benchmarking or when the adaptive choice is unsuitable for a workload.
+
+    Args:
+        grain (int, optional):
+            Grain size to use for all parallel loops. If :code:`None` or 0,
+            restore the default adaptive behavior.
+            (Default value = :code:`None`).
+    """
+    if grain is None or grain < 0:
+        grain = 0
+
+    cdef unsigned int cGrain = grain
+    freud._parallel.setLoopGrainSize(cGrain)
+
+
 class NumThreads:
     r"""Context manager for managing the number of threads to use.
 
@@ -70,6 +70,42 @@ class TestLocalDensity:
         neighbors = self.ld.num_neighbors
         npt.assert_array_less(np.fabs(neighbors - 1130.973355292), 200)
 
+    def test_compute_from_nlist(self):
+        """Test that reusing a neighbor list reproduces compute()."""
+        r_query = self.r_max + 0.5 * self.diameter
+        nq = freud.locality.AABBQuery(self.box, self.pos)
+        neighbors = {"mode": "ball", "r_max": r_query, "exclude_ii": True}
+        nlist = nq.query(self.pos, neighbors).toNeighborList()
+
+        # Computing from the same bonds must be bit-identical to feeding the
+        # list through compute().
+        self.ld.compute(nq, neighbors=nlist)
+        density = self.ld.density.copy()
+        num_neighbors = self.ld.num_neighbors.copy()
+
+        ld_nlist = freud.density.LocalDensity(self.r_max, self.diameter)
+        ld_nlist.compute_from_nlist(self.box, nlist)
+        assert ld_nlist.box == self.box
+        npt.assert_array_equal(ld_nlist.density, density)
+        npt.assert_array_equal(ld_nlist.num_neighbors, num_neighbors)
+
+        # The query-based path visits bonds in a different order, so only the
+        # floating-point summation order may differ.
+        self.ld.compute(nq)
+        npt.assert_allclose(ld_nlist.density, self.ld.density, rtol=1e-5)
+        npt.assert_allclose(
+            ld_nlist.num_neighbors, self.ld.num_neighbors, rtol=1e-5
+        )
+
+        # A list built with a larger cutoff gives the same answer; the extra
+        # bonds carry zero weight.
+        wide_neighbors = {"mode": "ball", "r_max": r_query + 1, "exclude_ii": True}
+        wide_nlist = nq.query(self.pos, wide_neighbors).toNeighborList()
+        ld_wide = freud.density.LocalDensity(self.r_max, self.diameter)
+        ld_wide.compute_from_nlist(self.box, wide_nlist)
+        npt.assert_array_equal(ld_wide.density, density)
+        npt.assert_array_equal(ld_wide.num_neighbors, num_neighbors)
+
     def test_repr(self):
         assert str(self.ld) == str(eval(repr(self.ld)))
 
@@ -111,6 +111,51 @@ class TestRDF:
             avg_counts = rdf.rdf * ndens * bin_volumes
             npt.assert_allclose(rdf.n_r, np.cumsum(avg_counts), rtol=tolerance)
 
+    def test_compute_frames(self):
+        # compute_frames must be exactly equivalent to accumulating the same
+        # frames one at a time with compute(..., reset=False).
+        r_max = 3.0
+        bins = 30
+        num_frames = 4
+        num_points = 100
+
+        boxes = []
+        points = []
+        for frame in range(num_frames):
+            box, frame_points = freud.data.make_random_system(
+                10 + frame, num_points, seed=frame
+            )
+            boxes.append(box)
+            points.append(frame_points)
+        points = np.asarray(points)
+
+        for neighbors in (None, {"mode": "ball", "r_max": r_max, "exclude_ii": True}):
+            rdf_frames = freud.density.RDF(bins, r_max)
+            rdf_frames.compute_frames(boxes, points, neighbors=neighbors)
+
+            rdf_loop = freud.density.RDF(bins, r_max)
+            for box, frame_points in zip(boxes, points):
+                rdf_loop.compute(
+                    (box, frame_points), neighbors=neighbors, reset=False
+                )
+
+            npt.assert_array_equal(rdf_frames.bin_counts, rdf_loop.bin_counts)
+            npt.assert_array_equal(rdf_frames.rdf, rdf_loop.rdf)
+            npt.assert_array_equal(rdf_frames.n_r, rdf_loop.n_r)
+
+        # The default reset=True must discard previous data, and reset=False
+        # must accumulate on top of it.
+        rdf_frames = freud.density.RDF(bins, r_max)
+        rdf_frames.compute_frames(boxes, points)
+        rdf_frames.compute_frames(boxes, points)
+        npt.assert_array_equal(rdf_frames.bin_counts, rdf_loop.bin_counts)
+        rdf_frames.compute_frames(boxes, points, reset=False)
+        npt.assert_array_equal(rdf_frames.bin_counts, 2 * rdf_loop.bin_counts)
+
+        # One box is required per frame.
+        with pytest.raises(ValueError):
+            rdf_frames.compute_frames(boxes[:-1], points)
+
     def test_repr(self):
         rdf = freud.density.RDF(r_max=10, bins=100, r_min=0.5)
         assert str(rdf) == str(eval(repr(rdf)))
@@ -286,3 +286,73 @@ class TestNeighborList:
         nlist = self.nq.query(self.nq.points[:-1], self.query_args).toNeighborList()
         assert nlist.num_query_points == len(self.nq.points) - 1
         assert nlist.num_points == len(self.nq.points)
+
+    def test_save_load_round_trip(self, tmp_path):
+        filename = str(tmp_path / "nlist.bin")
+        self.nlist.save(filename)
+
+        loaded = freud.locality.NeighborList()
+        loaded.load(filename)
+
+        npt.assert_array_equal(
+            loaded.query_point_indices, self.nlist.query_point_indices
+        )
+        npt.assert_array_equal(loaded.point_indices, self.nlist.point_indices)
+        npt.assert_array_equal(loaded.distances, self.nlist.distances)
+        npt.assert_array_equal(loaded.weights, self.nlist.weights)
+        assert loaded.num_query_points == self.nlist.num_query_points
+        assert loaded.num_points == self.nlist.num_points
+        npt.assert_array_equal(loaded.segments, self.nlist.segments)
+        npt.assert_array_equal(
+            loaded.neighbor_counts, self.nlist.neighbor_counts
+        )
+
+    def test_save_load_empty(self, tmp_path):
+        filename = str(tmp_path / "empty.bin")
+        nlist = self.nq.query(np.empty((0, 3)), self.query_args).toNeighborList()
+        nlist.save(filename)
+
+        loaded = freud.locality.NeighborList()
+        loaded.load(filename)
+        assert len(loaded) == 0
+        assert loaded.num_query_points == nlist.num_query_points
+        assert loaded.num_points == nlist.num_points
+
+    def test_load_missing_file(self, tmp_path):
+        loaded = freud.locality.NeighborList()
+        with pytest.raises(RuntimeError):
+            loaded.load(str(tmp_path / "does_not_exist.bin"))
+
+    def test_load_truncated_file(self, tmp_path):
+        filename = str(tmp_path / "truncated.bin")
+        self.nlist.save(filename)
+        data = open(filename, "rb").read()
+
+        # Truncating anywhere, including inside the header, must raise
+        # instead of producing a partially initialized list.
+        for size in (0, 10, len(data) // 2, len(data) - 1):
+            with open(filename, "wb") as truncated:
+                truncated.write(data[:size])
+            loaded = freud.locality.NeighborList()
+            with pytest.raises(RuntimeError):
+                loaded.load(filename)
+
+    def test_load_corrupt_header(self, tmp_path):
+        filename = str(tmp_path / "corrupt.bin")
+        self.nlist.save(filename)
+        data = bytearray(open(filename, "rb").read())
+
+        # Invalid magic.
+        with open(filename, "wb") as corrupt:
+            corrupt.write(b"NOTFREUD" + bytes(data[8:]))
+        loaded = freud.locality.NeighborList()
+        with pytest.raises(RuntimeError):
+            loaded.load(filename)
+
+        # A bond count inconsistent with the file size.
+        data[16:24] = (2 ** 32).to_bytes(8, "little")
+        with open(filename, "wb") as corrupt:
+            corrupt.write(bytes(data))
+        loaded = freud.locality.NeighborList()
+        with pytest.raises(RuntimeError):
+            loaded.load(filename)
@@ -1,3 +1,5 @@
+import numpy.testing as npt
+
 import freud
 
 
@@ -30,3 +32,32 @@ class TestParallel:
         # After the context manager, the number of threads should revert
         # to its previous value.
         assert freud.parallel.get_num_threads() == 1
+
+
+class TestLoopGrainSize:
+    """Ensure the grain size override does not change any results."""
+
+    # The setup and teardown ensure that these tests don't affect others.
+    def setup_method(self):
+        freud.parallel.set_loop_grain_size(None)
+
+    def teardown_method(self):
+        freud.parallel.set_loop_grain_size(None)
+
+    def test_results_unchanged(self):
+        """A fixed grain size only repartitions loops; results must match."""
+        box, points = freud.data.make_random_system(10, 100)
+
+        def compute_rdf():
+            rdf = freud.density.RDF(bins=50, r_max=3)
+            rdf.compute((box, points))
+            return rdf.rdf
+
+        reference = compute_rdf()
+        for grain in (1, 7, 10000):
+            freud.parallel.set_loop_grain_size(grain)
+            npt.assert_array_equal(compute_rdf(), reference)
+
+        # Restoring the adaptive default must also leave results unchanged.
+        freud.parallel.set_loop_grain_size(None)
+        npt.assert_array_equal(compute_rdf(), reference)